@@ -5,12 +5,17 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 14:40 adl  a lost beacon goes through the sensor's own ring
+ 10/18/26 10:55 adl  each sensor's variables in a BeaconSensor_t, which also
+                     has the rear ISR measure from the last rear edge
+ 10/17/26 16:05 adl  ISRs post through their ISR rings
 ****************************************************************************/
 
 // Includes ****************************************************************/
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "ES_PostList.h"
+#include "ES_ISRRing.h"
 
 #include <stdio.h>
 #include <mc9s12e128.h>     /* derivative information */
@@ -28,13 +33,33 @@
 #define PERIOD_NOBEACON (22L * (unsigned long)(1 _MS_))
 #define PERIOD_OC_CHECKBEACON (20 _MS_) 
 
+// Module Types ************************************************************/
+// What each beacon sensor's ISRs keep: the beacon in view (0 for none), the
+// time of the last edge, the last period acted on (ms), and where its
+// events go
+typedef struct
+{
+   unsigned char BeaconSeen;
+   unsigned long LastTime;
+   unsigned long LastPeriod;
+   ES_EventTyp_t EventType;
+   unsigned char Ring;
+} BeaconSensor_t;
+
 // Module Private Functions ************************************************/
+static void BeaconEdge(BeaconSensor_t *pSensor, unsigned long CurrentTime,
+                       boolean Wanted);
+static void BeaconLost(BeaconSensor_t *pSensor, unsigned long CurrentTime);
+
 // Module Variables ********************************************************/
-// Vaiables local to this module: BeaconSeen_Front, BeaconSeen_Rear, LastTime_Rear, LastTime_Front
-static unsigned char BeaconSeen_Front = 0;
-static unsigned char BeaconSeen_Rear = 0;
-static unsigned long LastTime_Rear = 0;
-static unsigned long LastTime_Front = 0;
+// The front and rear sensors
+static BeaconSensor_t Front = { 0, 0, 0, ES_BEACON_FRONT, FRONT_BEACON_RING };
+static BeaconSensor_t Rear = { 0, 0, 0, ES_BEACON_REAR, REAR_BEACON_RING };
+
+// The period (ms) of each beacon, from 1 to 4. A period 1 ms short counts
+// too (adjusted from tests)
+static const unsigned char BeaconPeriod[4] = { PERIOD_1, PERIOD_2, PERIOD_3,
+                                               PERIOD_4 };
 
 // Module Code *************************************************************/
 /****************************************************************************
@@ -105,14 +130,10 @@ void BeaconDetection_Init( void )
 ****************************************************************************/
 void interrupt _Vec_tim1ch5 ResponseToIC5( void )
 {
-    // Local variables in the function : CurrentTime, LastFrontPeriod, FrontPeriod, uOverFlows, CurrentRegister
-    // Initialize LastFrontPeriod to 0
-    static unsigned long CurrentTime;
-    static unsigned long LastFrontPeriod = 0;
-    unsigned long FrontPeriod;
+    // Local variables in the function : CurrentTime, uOverFlows, CurrentRegister
+    unsigned long CurrentTime;
     unsigned int uOverFlows;
     unsigned int CurrentRegister;
-    ES_Event ThisEvent;
     
    // Clear flag
    TIM1_TFLG1 = _S12_C5F;
@@ -124,59 +145,13 @@ void interrupt _Vec_tim1ch5 ResponseToIC5( void )
    // Calculate CurrentTime
    CurrentTime = ((unsigned long) uOverFlows << 16) + CurrentRegister;
 
-   // Set FrontPeriod (ms) to CurrentTime - LastTime_Front
-   FrontPeriod = (CurrentTime - LastTime_Front) /((unsigned long)(1 _MS_));
-   // Set LastTime_Front to CurrentTime
-   LastTime_Front = CurrentTime;
-
-   // If the FrontPeriod is different than LastFrontPeriod and if we are in one of the following modes:
+   // Look for a new beacon if we are in one of the following modes:
    // AligningFrontBeacon, FindingLeftBeacon, FindingRightBeacon, PreGame   
-   if ((FrontPeriod != LastFrontPeriod) && ((QueryScoringSM() == AligningFrontBeacon) || (QueryScoringSM() == FindingLeftBeacon) || (QueryScoringSM() == FindingRightBeacon) || (QueryMasterMachine() == PreGame)))
-   {  
-      // If the Period is 20 or 19 (adjusted from tests), and the last beacon seen was not Beacon 1
-      if (BeaconSeen_Front != 1 && (FrontPeriod == PERIOD_1 || FrontPeriod == PERIOD_1 - 1))
-      {
-            // Post Event ES_BEACON_FRONT with parameter 1
-            ThisEvent.EventType = ES_BEACON_FRONT;
-            ThisEvent.EventParam = 1;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Front to 1
-            BeaconSeen_Front = 1;
-      } 
-      // Else if the Period is 18 or 17 (adjusted from tests), and the last beacon seen was not Beacon 2
-      else if (BeaconSeen_Front != 2 && (FrontPeriod == PERIOD_2 || FrontPeriod == PERIOD_2 - 1))
-      {
-            // Post Event ES_BEACON_FRONT with parameter 2
-            ThisEvent.EventType = ES_BEACON_FRONT;
-            ThisEvent.EventParam = 2;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Front to 2
-            BeaconSeen_Front = 2;
-     } 
-      // Else if the Period is 16 or 15 (adjusted from tests), and the last beacon seen was not Beacon 3
-      else if (BeaconSeen_Front != 3 && (FrontPeriod == PERIOD_3 || FrontPeriod == PERIOD_3 - 1))
-      {
-            // Post Event ES_BEACON_FRONT with parameter 3
-	    ThisEvent.EventType = ES_BEACON_FRONT;
-            ThisEvent.EventParam = 3;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Front to 3
-            BeaconSeen_Front = 3;
-      } 	
-      // Else if the Period is 14 or 13 (adjusted from tests), and the last beacon seen was not Beacon 4
-      else if (BeaconSeen_Front != 4 && (FrontPeriod == PERIOD_4 || FrontPeriod == PERIOD_4 - 1))
-      {
-            // Post Event ES_BEACON_FRONT with parameter 4
-            ThisEvent.EventType = ES_BEACON_FRONT;
-            ThisEvent.EventParam = 4;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Front to 4
-           BeaconSeen_Front = 4;
-      }  //Endif
-      // Set LastFrontPeriod to FrontPeriod
-      LastFrontPeriod = FrontPeriod;
-   }  //Endif
-
+   BeaconEdge(&Front, CurrentTime,
+              ((QueryScoringSM() == AligningFrontBeacon) ||
+               (QueryScoringSM() == FindingLeftBeacon) ||
+               (QueryScoringSM() == FindingRightBeacon) ||
+               (QueryMasterMachine() == PreGame)) ? True : False);
 }  //End of ResponseToIC5
 
 /****************************************************************************
@@ -200,14 +175,10 @@ void interrupt _Vec_tim1ch5 ResponseToIC5( void )
 ****************************************************************************/
 void interrupt _Vec_tim1ch6 ResponseToIC6( void )
 {
-    // Local variables in the function : CurrentTime, LastRearPeriod, RearPeriod, uOverFlows, CurrentRegister
-    // Initialize LastRearPeriod to 0
-    static unsigned long CurrentTime;
-    static unsigned long LastRearPeriod = 0;
-    unsigned long RearPeriod;
+    // Local variables in the function : CurrentTime, uOverFlows, CurrentRegister
+    unsigned long CurrentTime;
     unsigned int uOverFlows;
     unsigned int CurrentRegister;
-    ES_Event ThisEvent;
     
    // Clear flag
    TIM1_TFLG1 = _S12_C6F;
@@ -219,59 +190,12 @@ void interrupt _Vec_tim1ch6 ResponseToIC6( void )
   // Calculate CurrentTime
    CurrentTime = ((unsigned long) uOverFlows << 16) + CurrentRegister;
 
-   // Set FrontPeriod (ms) to CurrentTime - LastTime_Front
-   RearPeriod = (CurrentTime - LastTime_Front) /((unsigned long)(1 _MS_));
-   // Set LastTime_Rear to CurrentTime
-   LastTime_Rear = CurrentTime;
-
-   // If the FrontPeriod is different than LastFrontPeriod and if we are in one of the following modes:
+   // Look for a new beacon if we are in one of the following modes:
    // AligningRearBeacon, PreGame, Realigning   
-   if ((RearPeriod != LastRearPeriod) && ((QueryScoringSM() == AligningRearBeacon) || (QueryMasterMachine() == PreGame) || (QueryDefendingSM() == Realigning))) 
-   {  
-      // If the Period is 20 or 19 (adjusted from tests), and the last beacon seen was not Beacon 1
-      if (BeaconSeen_Rear != 1 && (RearPeriod == PERIOD_1 || RearPeriod == PERIOD_1 - 1))
-      {
-            // Post Event ES_BEACON_REAR with parameter 1
-            ThisEvent.EventType = ES_BEACON_REAR;
-            ThisEvent.EventParam = 1;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Rear to 1
-            BeaconSeen_Rear = 1;
-      } 
-      // Else if the Period is 18 or 17 (adjusted from tests), and the last beacon seen was not Beacon 2
-      else if (BeaconSeen_Rear != 2 && (RearPeriod == PERIOD_2 || RearPeriod == PERIOD_2 - 1))
-      {
-            // Post Event ES_BEACON_REAR with parameter 2
-            ThisEvent.EventType = ES_BEACON_REAR;
-            ThisEvent.EventParam = 2;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Rear to 2
-            BeaconSeen_Rear = 2;
-     } 
-      // Else if the Period is 16 or 15 (adjusted from tests), and the last beacon seen was not Beacon 3
-      else if (BeaconSeen_Rear != 3 && (RearPeriod == PERIOD_3 || RearPeriod == PERIOD_3 - 1))
-      {
-            // Post Event ES_BEACON_REAR with parameter 3
-	    ThisEvent.EventType = ES_BEACON_REAR;
-            ThisEvent.EventParam = 3;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Rear to 3
-            BeaconSeen_Rear = 3;
-      } 	
-      // Else if the Period is 14 or 13 (adjusted from tests), and the last beacon seen was not Beacon 4
-      else if (BeaconSeen_Rear != 4 && (RearPeriod == PERIOD_4 || RearPeriod == PERIOD_4 - 1))
-      {
-            // Post Event ES_BEACON_REAR with parameter 4
-            ThisEvent.EventType = ES_BEACON_REAR;
-            ThisEvent.EventParam = 4;
-            PostMasterMachine(ThisEvent);
-	    // Update BeaconSeen_Rear to 4
-           BeaconSeen_Rear = 4;
-      }  //Endif
-      // Set LastRearPeriod to RearPeriod
-      LastRearPeriod = RearPeriod;
-   }  //Endif 
-
+   BeaconEdge(&Rear, CurrentTime,
+              ((QueryScoringSM() == AligningRearBeacon) ||
+               (QueryMasterMachine() == PreGame) ||
+               (QueryDefendingSM() == Realigning)) ? True : False);
 }  //End of ResponseToIC6
 
 
@@ -297,7 +221,6 @@ void interrupt _Vec_tim1ch6 ResponseToIC6( void )
 void interrupt _Vec_tim1ch7 CheckNoBeacon(void)
 {
     // Local variables in the function : CurrentTime, uOverFlows, CurrentRegister
-   ES_Event ThisEvent;
    unsigned long CurrentTime;
    unsigned int uOverFlows;
    unsigned int CurrentRegister;
@@ -312,35 +235,9 @@ void interrupt _Vec_tim1ch7 CheckNoBeacon(void)
    // Clear OC7 flag
    TIM1_TFLG1 = _S12_C7F;
    
-   // If BeaconSeen_Front is not 0 
-   if (BeaconSeen_Front != 0)
-   {
-      // If the time elapsed since the last time we were seen a beacon in the front is more than PERIOD_NOBEACON
-      if ((CurrentTime - LastTime_Front) > PERIOD_NOBEACON)
-      {
-         // Post Event ES_BEACON_FRONT with parameter 0 (No Beacon in front)
-         ThisEvent.EventType = ES_BEACON_FRONT;
-         ThisEvent.EventParam = 0;
-         PostMasterMachine(ThisEvent);
-         // Set BeaconSeen_Front to 0
-         BeaconSeen_Front = 0;
-      }  //Endif
-   }  //Endif
-   
-   // If BeaconSeen_Rear is not 0
-   if (BeaconSeen_Rear != 0)
-   {
-      // If the time elapsed since the last time we were seen a beacon in the rear is more than PERIOD_NOBEACON
-      if ((CurrentTime - LastTime_Rear) > PERIOD_NOBEACON)
-      {
-         // Post Event ES_BEACON_REAR with parameter 0 (No Beacon in rear)
-        ThisEvent.EventType = ES_BEACON_REAR;
-        ThisEvent.EventParam = 0;
-        PostMasterMachine(ThisEvent);
-        // Set BeaconSeen_Rear to 0
-        BeaconSeen_Rear = 0;
-      } //Endif  
-   }  //Endif
+   // Check whether the front and rear sensors have lost their beacons
+   BeaconLost(&Front, CurrentTime);
+   BeaconLost(&Rear, CurrentTime);
 
    // Schedule next output compare to check for no beacon
    TIM1_TC7 = TIM1_TCNT + PERIOD_OC_CHECKBEACON;
@@ -364,7 +261,7 @@ void interrupt _Vec_tim1ch7 CheckNoBeacon(void)
 unsigned char GetBeaconRear( void )
 {
    //Return BeaconSeen_Rear
-   return BeaconSeen_Rear;
+   return Rear.BeaconSeen;
 }  //End of GetBeaconRear
 
 /****************************************************************************
@@ -385,5 +282,103 @@ unsigned char GetBeaconRear( void )
 unsigned char GetBeaconFront( void )
 {
    //Return BeaconSeen_Front
-   return BeaconSeen_Front;
-}  //End of GetBeaconFront
\ No newline at end of file
+   return Front.BeaconSeen;
+}  //End of GetBeaconFront
+
+// Private Functions *******************************************************/
+/****************************************************************************
+ Function
+     BeaconEdge
+
+ Parameters
+     BeaconSensor_t *pSensor : the sensor that saw a rising edge
+     unsigned long CurrentTime : when, in timer 1 counts
+     boolean Wanted : True if the machines are looking for this sensor's
+                      beacons
+
+ Returns
+     None
+
+ Description
+     Measures the period since the sensor's last edge and, when it is
+     wanted and has changed, posts the beacon it belongs to if that is not
+     the beacon already in view
+ Notes
+     Called from the input capture ISRs
+ Author
+     Alex Loo, 10/18/26, 10:55
+****************************************************************************/
+static void BeaconEdge(BeaconSensor_t *pSensor, unsigned long CurrentTime,
+                       boolean Wanted)
+{
+   unsigned long Period;
+   unsigned char Beacon;
+   ES_Event ThisEvent;
+
+   // Set Period (ms) to CurrentTime - LastTime, and LastTime to CurrentTime
+   Period = (CurrentTime - pSensor->LastTime) /((unsigned long)(1 _MS_));
+   pSensor->LastTime = CurrentTime;
+
+   // If the Period is different than LastPeriod and the machines want it
+   if ((Period != pSensor->LastPeriod) && (Wanted == True))
+   {
+      // Find the beacon with this period
+      for (Beacon = 1; Beacon <= 4; Beacon++)
+      {
+         if ((Period == BeaconPeriod[Beacon-1]) ||
+             (Period == (unsigned long)(BeaconPeriod[Beacon-1] - 1)))
+         {
+            // If it was not the last beacon seen, post it and update
+            // BeaconSeen
+            if (pSensor->BeaconSeen != Beacon)
+            {
+               ThisEvent.EventType = pSensor->EventType;
+               ThisEvent.EventParam = Beacon;
+               ES_ISRRing_Post(pSensor->Ring, ThisEvent);
+               pSensor->BeaconSeen = Beacon;
+            }
+            break;
+         }
+      }
+      // Set LastPeriod to Period
+      pSensor->LastPeriod = Period;
+   }  //Endif
+}  //End of BeaconEdge
+
+/****************************************************************************
+ Function
+     BeaconLost
+
+ Parameters
+     BeaconSensor_t *pSensor : the sensor to check
+     unsigned long CurrentTime : the time now, in timer 1 counts
+
+ Returns
+     None
+
+ Description
+     Posts the sensor's event with parameter 0 (no beacon) if it had a
+     beacon in view and has seen no edge for PERIOD_NOBEACON
+ Notes
+     Called from CheckNoBeacon. Posts into the sensor's ring, after any
+     beacon its input capture ISR found, so the two keep their order
+ Author
+     Alex Loo, 10/18/26, 10:55
+****************************************************************************/
+static void BeaconLost(BeaconSensor_t *pSensor, unsigned long CurrentTime)
+{
+   ES_Event ThisEvent;
+
+   // If the time elapsed since the last time we saw a beacon is more than
+   // PERIOD_NOBEACON
+   if ((pSensor->BeaconSeen != 0) &&
+       ((CurrentTime - pSensor->LastTime) > PERIOD_NOBEACON))
+   {
+      // Post the event with parameter 0 (No Beacon)
+      ThisEvent.EventType = pSensor->EventType;
+      ThisEvent.EventParam = 0;
+      ES_ISRRing_Post(pSensor->Ring, ThisEvent);
+      // Set BeaconSeen to 0
+      pSensor->BeaconSeen = 0;
+   }  //Endif
+}  //End of BeaconLost
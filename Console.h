@@ -0,0 +1,29 @@
+/****************************************************************************
+ Module
+     Console.h
+ Description
+     header file for the parts of termio.c beyond the <termio.h> that
+     printf and getchar use: writing without waiting, and the SCI0 ISR
+ Notes
+     TERMIO_PutChar, TERMIO_GetChar, TERMIO_Init and kbhit are declared in
+     <termio.h>
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 02:15 adl      started coding
+*****************************************************************************/
+#ifndef Console_H
+#define Console_H
+
+#include "ES_Types.h"
+
+uint8_t  TERMIO_Write( const char *pData, uint8_t Length );
+uint8_t  TERMIO_TxRoom( void );
+uint16_t TERMIO_QueryRxDrops( void );
+
+// the SCI0 interrupt response, public only for the host's SCISim to run
+#ifdef ES_HOST_BUILD
+void TERMIO_SCI0ISR( void );
+#endif
+
+#endif /* Console_H */
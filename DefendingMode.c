@@ -5,9 +5,8 @@
 #include "ES_Timers.h"
 #include "MasterMachine.h"
 #include <stdio.h>
-#include "FSR.h"
+#include "FieldState.h"
 #include "BeaconDetection.h"
-#include "ScoringSM.h" // so we can query the scoring bin
 #include "DefendingSM.h"
 #include "SideID.h"
 
@@ -19,20 +18,21 @@
 #define ANGLES {315, 45, 135, 225}
 #define ZONE_DANGER 0
 #define ZONE_SAFE 1
+// a wall angle older than this (in timer ticks) is not acted on
+#define WALL_ANGLE_MAX_AGE (2*FIELD_STATE_REFRESH)
 
-// Static variables
-static unsigned char MyBin;
-static unsigned int LastWallAngle;
-static unsigned int DangerAngle_Right;
-static unsigned int DangerAngle_Left;
-static unsigned int SafeAngle_Right;
-static unsigned int SafeAngle_Left;
+// Static variables, in a DefendingMode_t. With ES_INSTANCES each defending
+// machine has its own, without it this is the only one
+#if !ES_INSTANCES
+static DefendingMode_t TheDefendingMode = DEFENDING_MODE_INIT;
+#define Me (&TheDefendingMode)
+#endif
 
 /****************************************************************************
  Function
    DefendingMode_Init
  Parameters
-   None
+   unsigned char TargetBin : the bin we are defending
  Returns
    None
  Description
@@ -42,39 +42,43 @@ static unsigned int SafeAngle_Left;
  Author
    Hannah Droesbeke
 ****************************************************************************/
- void DefendingMode_Init(void)
+ void DefendingMode_Init( ES_ME_(DefendingMode_t) unsigned char TargetBin )
  {
-   static unsigned char Side;
+   unsigned char Side;
    static unsigned int Angles_Array[4] = ANGLES;
 
-   // Query the bin we are defending
-   MyBin = QueryTargetBin();
+   // Keep the bin we are defending
+   Me->MyBin = TargetBin;
    
-   // Initialize the angle of the wall
-   LastWallAngle = Get_WallAngle();
+   // Initialize the angle of the wall, from the FSR's last report
+   if (QueryFieldState(FSR_WALL_ANGLE, &Me->LastWallAngle, NULL) != True)
+   {
+      // The FSR has not reported it yet
+      Me->LastWallAngle = NO_WALL_ANGLE;
+   }
    
    // Query the side we are on
    Side = ID_QuerySide();
    // Depending on the side, set the limit angles for the defending mode
    if (Side == RED_TEAM)
    {
-      DangerAngle_Right = (Angles_Array[MyBin-1] - DANGER_ANGLE + 180)%360;
-      DangerAngle_Left = (Angles_Array[MyBin-1] + DANGER_ANGLE)%360;
-      SafeAngle_Right = (Angles_Array[MyBin-1] - SAFE_ANGLE + 180)%360;
-      SafeAngle_Left = (Angles_Array[MyBin-1] + SAFE_ANGLE)%360;      
+      Me->DangerAngle_Right = (Angles_Array[Me->MyBin-1] - DANGER_ANGLE + 180)%360;
+      Me->DangerAngle_Left = (Angles_Array[Me->MyBin-1] + DANGER_ANGLE)%360;
+      Me->SafeAngle_Right = (Angles_Array[Me->MyBin-1] - SAFE_ANGLE + 180)%360;
+      Me->SafeAngle_Left = (Angles_Array[Me->MyBin-1] + SAFE_ANGLE)%360;      
    }
    else
    {
-      DangerAngle_Right = (Angles_Array[MyBin-1] - DANGER_ANGLE)%360;
-      DangerAngle_Left = (Angles_Array[MyBin-1] + DANGER_ANGLE + 180)%360;
-      SafeAngle_Right = (Angles_Array[MyBin-1] - SAFE_ANGLE )%360;
-      SafeAngle_Left = (Angles_Array[MyBin-1] + SAFE_ANGLE + 180)%360;
+      Me->DangerAngle_Right = (Angles_Array[Me->MyBin-1] - DANGER_ANGLE)%360;
+      Me->DangerAngle_Left = (Angles_Array[Me->MyBin-1] + DANGER_ANGLE + 180)%360;
+      Me->SafeAngle_Right = (Angles_Array[Me->MyBin-1] - SAFE_ANGLE )%360;
+      Me->SafeAngle_Left = (Angles_Array[Me->MyBin-1] + SAFE_ANGLE + 180)%360;
    }
    
    // Prevent from zero-360 crossing
-   if (DangerAngle_Right > DangerAngle_Left)
+   if (Me->DangerAngle_Right > Me->DangerAngle_Left)
    {
-      DangerAngle_Left += 360; 
+      Me->DangerAngle_Left += 360; 
    }
  }
 
@@ -82,7 +86,7 @@ static unsigned int SafeAngle_Left;
  Function
    Wall_CheckEvents
  Parameters
-   None
+   None (with ES_INSTANCES, the DefendingSM_t whose wall to check)
  Returns
    Boolean True if event detected 
  Description
@@ -93,78 +97,81 @@ static unsigned int SafeAngle_Left;
  Author
    Hannah Droesbeke
 ****************************************************************************/
-boolean Wall_CheckEvents( void )
+boolean Wall_CheckEvents( ES_ME(struct DefendingSM_s) )
 {
-   // Static variables to this function: WallAngle, CurrentZone, Angles_Array, 
-   // LastTime, CurrentTime, ReturnVal
+   // Static variables to this function: WallAngle, Angles_Array, ReturnVal,
+   // and the machine's DefendingMode_t, Wall
    unsigned int WallAngle = 1000;
-   static unsigned char CurrentZone = 2;
+   uint16_t WallAngleAge;
    static unsigned int Angles_Array[4] = ANGLES;
    ES_Event ThisEvent;
-   static uint16_t LastTime = 0;
-   uint16_t CurrentTime = 0;
    boolean ReturnVal = False;
+#if ES_INSTANCES
+   DefendingMode_t *Wall = &Me->Wall;
+#else
+   DefendingMode_t *Wall = Me;
+#endif
    
-   // Set CurrentTime to the current time
-   CurrentTime = ES_Timer_GetTime();
-   
-   // If we are in Defending mode and Waiting/Reseting/PushingForward/PushingBackward, and enough time has elapsed since we last queried the wall position
-   if ((QueryMasterMachine() == Defending) && (QueryDefendingSM() == Waiting || QueryDefendingSM() == Reseting || QueryDefendingSM() == PushingForward || QueryDefendingSM() == PushingBackward) && ((CurrentTime-LastTime) > 50))
+   // ES_CheckEvents only calls this in Defending mode, and no more often than
+   // every 50 ticks (EVENT_CHECK_PERIODS/_STATES)
+   // If we are Waiting/Reseting/PushingForward/PushingBackward
+   if (QueryDefendingSM(ES_WITH(Me)) == Waiting ||
+       QueryDefendingSM(ES_WITH(Me)) == Reseting ||
+       QueryDefendingSM(ES_WITH(Me)) == PushingForward ||
+       QueryDefendingSM(ES_WITH(Me)) == PushingBackward)
    {
-      // Query the angle of the wall
-      WallAngle = Get_WallAngle();
-
-      if (WallAngle == 999)
+      // Read the angle of the wall, as the FSR last reported it
+      if ((QueryFieldState(FSR_WALL_ANGLE, &WallAngle, &WallAngleAge) != True) ||
+          (WallAngleAge > WALL_ANGLE_MAX_AGE))
       {
-         // We got a bad command from SPI
+         // No recent answer from the FSR
          return False; // immediately quit the event checker
       }
       // Else
       else
       {
          // If the wall entered the danger zone from the right
-         if (WallAngle > DangerAngle_Right && WallAngle <= Angles_Array[MyBin - 1])
+         if (WallAngle > Wall->DangerAngle_Right && WallAngle <= Angles_Array[Wall->MyBin - 1])
          {
             // If the CurrentZone was not ZONE_DANGER already
-            if (CurrentZone != ZONE_DANGER)
+            if (Wall->CurrentZone != ZONE_DANGER)
             {
                 // Post Event DANGERWALL_RIGHT
                ThisEvent.EventType = ES_DANGERWALL_RIGHT; // adl: added ES_
                PostMasterMachine(ThisEvent);
                // Set CurrentZone to ZONE_DANGER
-               CurrentZone = ZONE_DANGER;
+               Wall->CurrentZone = ZONE_DANGER;
                // Set ReturnVal to True
                ReturnVal = True;
             }
          }
          // Else if the wall entered the danger zone from the left
-         else if (WallAngle < DangerAngle_Left && WallAngle >= Angles_Array[MyBin - 1])
+         else if (WallAngle < Wall->DangerAngle_Left && WallAngle >= Angles_Array[Wall->MyBin - 1])
          {
             // If the CurrentZone was not ZONE_DANGER already
-            if (CurrentZone != ZONE_DANGER)
+            if (Wall->CurrentZone != ZONE_DANGER)
             {
                 // PostEvent DANGERWALL_LEFT
                ThisEvent.EventType = ES_DANGERWALL_LEFT; // adl: added ES_
                PostMasterMachine(ThisEvent);
                // Set CurrentZone to ZONE_DANGER
-               CurrentZone = ZONE_DANGER;
+               Wall->CurrentZone = ZONE_DANGER;
                // Set ReturnVal to True
                ReturnVal = True;
             }
          }
          // Else if the Wall entered in the safe zone and the CurrentZone was not ZONE_SAFE already
-         else if ((WallAngle < SafeAngle_Right || WallAngle > SafeAngle_Left) && CurrentZone != ZONE_SAFE)
+         else if ((WallAngle < Wall->SafeAngle_Right || WallAngle > Wall->SafeAngle_Left) && Wall->CurrentZone != ZONE_SAFE)
          {
             // Post Event NODANGERWALL
             ThisEvent.EventType = ES_NO_DANGERWALL; // adl: added ES_
             PostMasterMachine(ThisEvent);
             // Set CurrentZone to ZONE_SAFE
-            CurrentZone = ZONE_SAFE;
+            Wall->CurrentZone = ZONE_SAFE;
             // Set ReturnVal to True
             ReturnVal = True; 
          }
       }
-      LastTime = CurrentTime; // update the last time
    }
    // Return ReturnVal
    return ReturnVal;
@@ -5,13 +5,40 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 14:35 adl  NO_WALL_ANGLE
+ 10/18/26 10:45 adl  variables in a DefendingMode_t, see ES_Instance.h
  02/07/12 19:13 adl  First pass
 ****************************************************************************/
 #ifndef DEFENDINGMODE_H
 #define DEFENDINGMODE_H
 
+#include "ES_Types.h"
+#include "ES_Instance.h"
+
+// the bin that one defending machine defends and the wall angles that
+// matter to it
+typedef struct
+{
+   unsigned char MyBin;
+   unsigned int LastWallAngle;   // NO_WALL_ANGLE until the FSR reports it
+   unsigned int DangerAngle_Right;
+   unsigned int DangerAngle_Left;
+   unsigned int SafeAngle_Right;
+   unsigned int SafeAngle_Left;
+   unsigned char CurrentZone;    // the zone the wall was last seen in
+} DefendingMode_t;
+
+// LastWallAngle when the FSR has not reported the angle yet
+#define NO_WALL_ANGLE 0xFFFF
+
+#define DEFENDING_MODE_INIT { 0, NO_WALL_ANGLE, 0, 0, 0, 0, 2 }
+
+// Wall_CheckEvents is passed the DefendingSM_t that holds its
+// DefendingMode_t, to ask that machine's state
+struct DefendingSM_s;
+
 // functions
-void DefendingMode_Init( void );
-boolean Wall_CheckEvents( void );
+void DefendingMode_Init( ES_ME_(DefendingMode_t) unsigned char TargetBin );
+boolean Wall_CheckEvents( ES_ME(struct DefendingSM_s) );
 
 #endif 
\ No newline at end of file
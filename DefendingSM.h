@@ -11,18 +11,41 @@
 // Event Definitions
 #include "ES_Configure.h"
 #include "ES_Types.h"
+#include "ES_Instance.h"
+#include "TimingConstants.h"
+#include "DefendingMode.h"
+#include "ScoringSM.h"
 
 // typedefs for the states
 // State definitions for use with the query function
 typedef enum { DrivingAwayFromWall, AligningPerpendicular, 
                Waiting, Reseting, Realigning,
                PushingForward, PushingBackward} DefendingState_t ;
+
+// the variables of one Defending machine, see ES_Instance.h
+typedef struct DefendingSM_s
+{
+   uint8_t CurrentState;   // a DefendingState_t, run by ES_StateTable_Run
+   unsigned char TargetBin;         // the bin that we scored on
+   TurnDirection_t TurnDirection;   // the current turn direction
+#if ES_INSTANCES
+   const ScoringSM_t *Scoring;      // the machine that picked TargetBin
+   DefendingMode_t Wall;            // what Wall_CheckEvents watches
+#endif
+} DefendingSM_t;
+
+#if ES_INSTANCES
+#define DEFENDING_SM_INIT { DrivingAwayFromWall, 0, Left, NULL, \
+                            DEFENDING_MODE_INIT }
+#else
+#define DEFENDING_SM_INIT { DrivingAwayFromWall, 0, Left }
+#endif
               
 // Public Function Prototypes
 // boolean InitGatheringSM ( uint8_t);
 //boolean PostScoringSM( ES_Event);
-void StartDefendingSM(ES_Event);
-ES_Event RunDefendingSM( ES_Event);
-DefendingState_t QueryDefendingSM ( void );
+void StartDefendingSM( ES_ME_(DefendingSM_t) ES_Event);
+ES_Event RunDefendingSM( ES_ME_(DefendingSM_t) ES_Event);
+DefendingState_t QueryDefendingSM ( ES_ME(const DefendingSM_t) );
 
 #endif /* DEFENDINGSM_H */
\ No newline at end of file
@@ -0,0 +1,64 @@
+/****************************************************************************
+ Module
+     DefendingSM_Spec.h
+ Description
+     the Defending machine's states and transitions, from which Host/TableGen
+     writes DefendingSM_Table.h
+ Notes
+     Only Host/TableGen includes this, see ScoringSM_Spec.h for the form.
+     After changing it, run make -C Host tables (any host build does).
+     The functions are in DefendingSM.c.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 13:07 adl      started coding, from the switches in DefendingSM.c
+*****************************************************************************/
+#ifndef DefendingSM_Spec_H
+#define DefendingSM_Spec_H
+
+#define DEFENDING_SM_MACHINE(MACHINE) \
+   MACHINE( LOG_DEFENDING, DrivingAwayFromWall )
+
+#define DEFENDING_SM_STATES(STATE) \
+   STATE( DrivingAwayFromWall, EnterDrivingAwayFromWall, Stop ) \
+   STATE( AligningPerpendicular, EnterAligningPerpendicular, Stop ) \
+   STATE( Waiting, Stop, NULL ) \
+   STATE( Reseting, EnterReseting, Stop ) \
+   STATE( Realigning, EnterRealigning, Stop ) \
+   STATE( PushingForward, DriveForward, DriveBackward ) \
+   STATE( PushingBackward, DriveBackward, DriveForward )
+
+#define DEFENDING_SM_ROWS(ON) \
+   ON( DrivingAwayFromWall, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, Waiting, \
+       ES_NO_EVENT ) \
+   /* turn to face the wall coming in, and push it back */ \
+   ON( Waiting, ES_DANGERWALL_RIGHT, ES_ANY_PARAM, NULL, FaceRight, \
+       AligningPerpendicular, ES_NO_EVENT ) \
+   ON( Waiting, ES_DANGERWALL_LEFT, ES_ANY_PARAM, NULL, FaceLeft, \
+       AligningPerpendicular, ES_NO_EVENT ) \
+   ON( AligningPerpendicular, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, \
+       PushingForward, ES_NO_EVENT ) \
+   ON( PushingForward, ES_NO_DANGERWALL, ES_ANY_PARAM, NULL, NULL, Reseting, \
+       ES_NO_EVENT ) \
+   ON( PushingBackward, ES_NO_DANGERWALL, ES_ANY_PARAM, NULL, NULL, \
+       Reseting, ES_NO_EVENT ) \
+   /* push again, forward if the wall comes from the side we face, or */ \
+   /* go back to the bin */ \
+   ON( Reseting, ES_DANGERWALL_RIGHT, ES_ANY_PARAM, IsTurnRight, NULL, \
+       PushingForward, ES_NO_EVENT ) \
+   ON( Reseting, ES_DANGERWALL_RIGHT, ES_ANY_PARAM, NULL, NULL, \
+       PushingBackward, ES_NO_EVENT ) \
+   ON( Reseting, ES_DANGERWALL_LEFT, ES_ANY_PARAM, IsTurnLeft, NULL, \
+       PushingForward, ES_NO_EVENT ) \
+   ON( Reseting, ES_DANGERWALL_LEFT, ES_ANY_PARAM, NULL, NULL, \
+       PushingBackward, ES_NO_EVENT ) \
+   ON( Reseting, ES_LEFT_TAPE_DETECTED, ES_ANY_PARAM, NULL, NULL, Realigning, \
+       ES_NO_EVENT ) \
+   ON( Reseting, ES_RIGHT_TAPE_DETECTED, ES_ANY_PARAM, NULL, NULL, \
+       Realigning, ES_NO_EVENT ) \
+   ON( Reseting, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, Realigning, \
+       ES_NO_EVENT ) \
+   ON( Realigning, ES_BEACON_REAR, ES_ANY_PARAM, IsTargetBin, NULL, Waiting, \
+       ES_NO_EVENT )
+
+#endif /* DefendingSM_Spec_H */
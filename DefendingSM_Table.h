@@ -0,0 +1,135 @@
+/****************************************************************************
+ Module
+     DefendingSM_Table.h
+ Description
+     DefendingSM's transition table, for ES_StateTable_Run
+ Notes
+     Written by Host/TableGen from DefendingSM_Spec.h, do not edit. Change the
+     spec and run make -C Host tables.
+
+     Passed up, to the machine above, by each state: the events it does
+     not take that the machine takes in another state
+       DrivingAwayFromWall:
+         ES_DANGERWALL_RIGHT
+         ES_DANGERWALL_LEFT
+         ES_NO_DANGERWALL
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_BEACON_REAR
+       AligningPerpendicular:
+         ES_DANGERWALL_RIGHT
+         ES_DANGERWALL_LEFT
+         ES_NO_DANGERWALL
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_BEACON_REAR
+       Waiting:
+         ES_TIMEOUT MOTION_TIMER
+         ES_NO_DANGERWALL
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_BEACON_REAR
+       Reseting:
+         ES_NO_DANGERWALL
+         ES_BEACON_REAR
+       Realigning:
+         ES_TIMEOUT MOTION_TIMER
+         ES_DANGERWALL_RIGHT
+         ES_DANGERWALL_LEFT
+         ES_NO_DANGERWALL
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+       PushingForward:
+         ES_TIMEOUT MOTION_TIMER
+         ES_DANGERWALL_RIGHT
+         ES_DANGERWALL_LEFT
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_BEACON_REAR
+       PushingBackward:
+         ES_TIMEOUT MOTION_TIMER
+         ES_DANGERWALL_RIGHT
+         ES_DANGERWALL_LEFT
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_BEACON_REAR
+*****************************************************************************/
+
+// the guards, actions, entries and exits, in DefendingSM.c
+static ES_StateTableGuard_t IsTurnRight;
+static ES_StateTableGuard_t IsTurnLeft;
+static ES_StateTableGuard_t IsTargetBin;
+static ES_StateTableAction_t FaceRight;
+static ES_StateTableAction_t FaceLeft;
+static ES_StateTableAction_t EnterDrivingAwayFromWall;
+static ES_StateTableAction_t Stop;
+static ES_StateTableAction_t EnterAligningPerpendicular;
+static ES_StateTableAction_t EnterReseting;
+static ES_StateTableAction_t EnterRealigning;
+static ES_StateTableAction_t DriveForward;
+static ES_StateTableAction_t DriveBackward;
+
+// the rows, by state and event, in the order they are tried
+static const ES_StateTableRow_t DefendingSM_Rows[14] = {
+   /*  0 DrivingAwayFromWall ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, Waiting, ES_NO_EVENT, 1 },
+   /*  1 AligningPerpendicular ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, PushingForward, ES_NO_EVENT, 1 },
+   /*  2 Waiting ES_DANGERWALL_RIGHT ES_ANY_PARAM */
+   { NULL, FaceRight, ES_ANY_PARAM, AligningPerpendicular, ES_NO_EVENT, 1 },
+   /*  3 Waiting ES_DANGERWALL_LEFT ES_ANY_PARAM */
+   { NULL, FaceLeft, ES_ANY_PARAM, AligningPerpendicular, ES_NO_EVENT, 1 },
+   /*  4 Reseting ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, Realigning, ES_NO_EVENT, 1 },
+   /*  5 Reseting ES_LEFT_TAPE_DETECTED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, Realigning, ES_NO_EVENT, 1 },
+   /*  6 Reseting ES_RIGHT_TAPE_DETECTED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, Realigning, ES_NO_EVENT, 1 },
+   /*  7 Reseting ES_DANGERWALL_RIGHT ES_ANY_PARAM */
+   { IsTurnRight, NULL, ES_ANY_PARAM, PushingForward, ES_NO_EVENT, 0 },
+   /*  8 Reseting ES_DANGERWALL_RIGHT ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, PushingBackward, ES_NO_EVENT, 1 },
+   /*  9 Reseting ES_DANGERWALL_LEFT ES_ANY_PARAM */
+   { IsTurnLeft, NULL, ES_ANY_PARAM, PushingForward, ES_NO_EVENT, 0 },
+   /* 10 Reseting ES_DANGERWALL_LEFT ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, PushingBackward, ES_NO_EVENT, 1 },
+   /* 11 Realigning ES_BEACON_REAR ES_ANY_PARAM */
+   { IsTargetBin, NULL, ES_ANY_PARAM, Waiting, ES_NO_EVENT, 1 },
+   /* 12 PushingForward ES_NO_DANGERWALL ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, Reseting, ES_NO_EVENT, 1 },
+   /* 13 PushingBackward ES_NO_DANGERWALL ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, Reseting, ES_NO_EVENT, 1 }
+};
+
+// for each state, 1 + the index of its first row for each event type
+static const uint8_t DefendingSM_Dispatch[7][18] = {
+   /* DrivingAwayFromWall */
+   { 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+   /* AligningPerpendicular */
+   { 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+   /* Waiting */
+   { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 4, 0 },
+   /* Reseting */
+   { 0, 0, 0, 0, 5, 0, 0, 6, 7, 0, 0, 0, 0, 0, 0, 8, 10, 0 },
+   /* Realigning */
+   { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0 },
+   /* PushingForward */
+   { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 13 },
+   /* PushingBackward */
+   { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 14 }
+};
+
+// each state's entry and exit
+static const ES_StateTableState_t DefendingSM_States[7] = {
+   { EnterDrivingAwayFromWall, Stop }, /* DrivingAwayFromWall */
+   { EnterAligningPerpendicular, Stop }, /* AligningPerpendicular */
+   { Stop, NULL }, /* Waiting */
+   { EnterReseting, Stop }, /* Reseting */
+   { EnterRealigning, Stop }, /* Realigning */
+   { DriveForward, DriveBackward }, /* PushingForward */
+   { DriveBackward, DriveForward }  /* PushingBackward */
+};
+
+static const ES_StateTable_t DefendingSM_Table = {
+   &DefendingSM_Dispatch[0][0], DefendingSM_Rows, DefendingSM_States, 18, LOG_DEFENDING
+};
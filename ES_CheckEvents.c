@@ -5,9 +5,24 @@
      source file for the module to call the User event checking routines
  Notes
      Users should only modify the contents of the EF_EventList array.
+
+     With EVENT_CHECK_PERIODS or EVENT_CHECK_STATES (see ES_CheckEvents.h)
+     each checker has a time when it is next due. A pass calls only the
+     checkers that are due and wanted in the current state, and notes the
+     earliest time that one of the wanted checkers is due; until then, and
+     while the state stays the same, a pass calls none of them.
+
+     With ES_CHECK_ROUND_ROBIN a pass starts at the checker after the last
+     one that found an event, rather than at the top of the list, so a
+     checker that finds events often can't keep the ones after it from
+     being called. ES_CHECK_STATS counts the calls of each checker and the
+     events each found.
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 14:55 adl      NEXT_CHECKER compares unsigned with unsigned
+ 10/18/26 07:40 adl      round robin, call and event counts per checker
+ 10/18/26 07:10 adl      periods and state masks for the checkers
  02/08/11 15:24 jec      modified CheckUserEvents to account for the possibilty
                          that there are NO user events (as in the case of the
                          micro-wave oven example)
@@ -18,6 +33,10 @@
 #include "ES_Events.h"
 #include "ES_General.h"
 #include "ES_CheckEvents.h"
+#include "ES_Timers.h"
+#if ES_CHECK_STATS
+#include <stdio.h>
+#endif
 
 // Include the header files for the module(s) with your event checkers. 
 // This gets you the prototypes for the event checking functions.
@@ -28,6 +47,75 @@
 
 static CheckFunc * const ES_EventList[]={EVENT_CHECK_LIST };
 
+#if defined(EVENT_CHECK_PERIODS) || defined(EVENT_CHECK_STATES)
+#define SCHEDULED_CHECKS
+
+#ifdef EVENT_CHECK_PERIODS
+// the least time, in ticks, between 2 calls of each checker
+static uint16_t const CheckPeriods[] = { EVENT_CHECK_PERIODS };
+#define CHECK_PERIOD(i) CheckPeriods[i]
+#else
+#define CHECK_PERIOD(i) 0
+#endif
+
+#ifdef EVENT_CHECK_STATES
+#ifndef EVENT_CHECK_STATE_FUNC
+#error EVENT_CHECK_STATES needs EVENT_CHECK_STATE_FUNC
+#endif
+// the states that each checker is wanted in
+static uint32_t const CheckStates[] = { EVENT_CHECK_STATES };
+#define CHECK_WANTED(i, State) \
+   (((State) < 32) && ((CheckStates[i] & ES_CHECK_IN(State)) != 0))
+#define CURRENT_STATE() ((uint8_t)EVENT_CHECK_STATE_FUNC())
+#else
+#define CHECK_WANTED(i, State) True
+#define CURRENT_STATE() 0
+#endif
+
+// so that the lists can't get out of step with EVENT_CHECK_LIST
+// (a negative array size if they do)
+#ifdef EVENT_CHECK_PERIODS
+typedef char CheckPeriodsMatch[(ARRAY_SIZE(CheckPeriods) ==
+                                ARRAY_SIZE(ES_EventList)) ? 1 : -1];
+#endif
+#ifdef EVENT_CHECK_STATES
+typedef char CheckStatesMatch[(ARRAY_SIZE(CheckStates) ==
+                               ARRAY_SIZE(ES_EventList)) ? 1 : -1];
+#endif
+
+// furthest ahead that EarliestDue is put when no checker is wanted
+#define NEVER_DUE 0x7FFFFFFFUL
+
+// when each checker is next due, in ticks from ES_Timer_GetTime32
+static uint32_t NextDue[ARRAY_SIZE(ES_EventList)];
+// the earliest of these for the checkers wanted in LastState, and whether
+// there has been a pass to work them out yet
+static uint32_t EarliestDue;
+static uint8_t LastState;
+static boolean Scheduled = False;
+#endif /* EVENT_CHECK_PERIODS || EVENT_CHECK_STATES */
+
+#if ES_CHECK_ROUND_ROBIN
+// where the next pass starts: the checker after the last to find an event
+static unsigned char FirstChecker = 0;
+#define FIRST_CHECKER FirstChecker
+#define NEXT_CHECKER(i) \
+          (((unsigned)(i) + 1u < ARRAY_SIZE(ES_EventList)) ? (i) + 1 : 0)
+#else
+#define FIRST_CHECKER 0
+#define NEXT_CHECKER(i) ((i) + 1)
+#endif
+
+#if ES_CHECK_STATS
+static ES_CheckStats_t CheckStats[ARRAY_SIZE(ES_EventList)];
+#endif
+
+#if ES_CHECK_ROUND_ROBIN || ES_CHECK_STATS
+static boolean CallChecker( unsigned char Which );
+#else
+#define CallChecker(Which) ES_EventList[Which]()
+#endif
+
 
 // Implementation for public functions
 
@@ -41,23 +129,174 @@ static CheckFunc * const ES_EventList[]={EVENT_CHECK_LIST };
  Description
    loop through the EF_EventList array executing the event checking functions
  Notes
-   
+   With periods or state masks, only the checkers that are due and wanted
+   in the current state are called, and the pass returns at once when none
+   can be. A checker that is not wanted stays due, so it is called on the
+   first pass after its state comes round. With ES_CHECK_ROUND_ROBIN the
+   walk starts after the last checker to find an event, and wraps.
  Author
    J. Edward Carryer, 10/25/11, 08:55
 ****************************************************************************/
+#ifdef SCHEDULED_CHECKS
+boolean ES_CheckUserEvents( void )
+{
+  uint32_t Now = ES_Timer_GetTime32();
+  uint8_t State = CURRENT_STATE();
+  uint32_t Earliest;
+  boolean Found = False;
+  unsigned char i = FIRST_CHECKER;
+  unsigned char n;
+
+  // nothing can be due before EarliestDue, unless the state has changed
+  if ( (Scheduled == True) && (State == LastState) &&
+       ((int32_t)(Now - EarliestDue) < 0) )
+    return (False);
+
+  Earliest = Now + NEVER_DUE;
+  for ( n=0; n< ARRAY_SIZE(ES_EventList); n++, i = NEXT_CHECKER(i)) {
+    if ( (ES_EventList[i] == NO_EVENT_CHECKERS) ||
+         !CHECK_WANTED(i, State) )
+      continue; // not wanted now, so it does not count toward Earliest
+    // once one has found a new event, process it first, leaving the rest
+    // due for the next pass
+    if ( (Found == False) && ((int32_t)(Now - NextDue[i]) >= 0) ) {
+      NextDue[i] = Now + CHECK_PERIOD(i);
+      Found = CallChecker(i);
+    }
+    if ( (int32_t)(NextDue[i] - Earliest) < 0 )
+      Earliest = NextDue[i];
+  }
+  EarliestDue = Earliest;
+  LastState = State;
+  Scheduled = True;
+  return (Found);
+}
+#else
 boolean ES_CheckUserEvents( void ) 
 {
-  unsigned char i;
+  unsigned char i = FIRST_CHECKER;
+  unsigned char n;
   // loop through the array executing the event checking functions
-  for ( i=0; i< ARRAY_SIZE(ES_EventList); i++) {
+  for ( n=0; n< ARRAY_SIZE(ES_EventList); n++, i = NEXT_CHECKER(i)) {
     if ( (ES_EventList[i] != NO_EVENT_CHECKERS) && 
-         (ES_EventList[i]() == True) )
-      break; // found a new event, so process it first
+         (CallChecker(i) == True) )
+      return(True); // found a new event, so process it first
   }
-  if ( i == ARRAY_SIZE(ES_EventList) ) // if no new events
+  return (False); // no new events
+}
+#endif
+
+#if ES_CHECK_STATS
+/****************************************************************************
+ Function
+   ES_QueryCheckStats
+ Parameters
+   uint8_t Which : the checker, by its place in EVENT_CHECK_LIST
+   ES_CheckStats_t * : used to return its counts
+ Returns
+   boolean, False if there is no such checker
+ Description
+   reads how many times a checker has been called, and how many of those
+   found an event
+ Notes
+   the counts wrap at 2^32
+ Author
+   Alex Loo, 10/18/26, 07:35
+****************************************************************************/
+boolean ES_QueryCheckStats( uint8_t Which, ES_CheckStats_t *pStats )
+{
+  if ( Which >= ARRAY_SIZE(ES_EventList) )
     return (False);
-  else
-    return(True);
+  *pStats = CheckStats[Which];
+  return (True);
+}
+
+/****************************************************************************
+ Function
+   ES_ClearCheckStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   zeros the counts of every checker
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 07:36
+****************************************************************************/
+void ES_ClearCheckStats( void )
+{
+  unsigned char i;
+
+  for ( i=0; i< ARRAY_SIZE(ES_EventList); i++) {
+    CheckStats[i].Calls = 0;
+    CheckStats[i].Fires = 0;
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_PrintCheckStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   prints the counts of every checker, 1 line each
+ Notes
+   ES_Run calls this when asked by ES_RequestCheckStats
+ Author
+   Alex Loo, 10/18/26, 07:37
+****************************************************************************/
+void ES_PrintCheckStats( void )
+{
+  unsigned char i;
+
+  printf("\r\nCheck      Calls     Events");
+  for ( i=0; i< ARRAY_SIZE(ES_EventList); i++)
+    printf("\r\n%5u %10lu %10lu", i, (unsigned long)CheckStats[i].Calls,
+           (unsigned long)CheckStats[i].Fires);
+}
+#endif
+
+#if ES_CHECK_ROUND_ROBIN || ES_CHECK_STATS
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   CallChecker
+ Parameters
+   unsigned char Which : the checker to call
+ Returns
+   boolean, what the checker returned
+ Description
+   calls a checker, counting the call and the event if it found one, and
+   has the next pass start after it if it did
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 07:32
+****************************************************************************/
+static boolean CallChecker( unsigned char Which )
+{
+  boolean Found;
+
+#if ES_CHECK_STATS
+  CheckStats[Which].Calls++;
+#endif
+  Found = ES_EventList[Which]();
+  if ( Found == True ) {
+#if ES_CHECK_STATS
+    CheckStats[Which].Fires++;
+#endif
+#if ES_CHECK_ROUND_ROBIN
+    FirstChecker = NEXT_CHECKER(Which);
+#endif
+  }
+  return (Found);
 }
+#endif
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
@@ -5,10 +5,27 @@
      header file for use with the data structures to define the event checking
      functions and the function to loop through the array calling the checkers
  Notes
+     ES_Configure.h may give each checker in EVENT_CHECK_LIST a period and
+     the states it is wanted in:
+       EVENT_CHECK_PERIODS     a list of periods in timer ticks, 1 for each
+                               checker: the least time between 2 calls
+       EVENT_CHECK_STATE_FUNC  the query function of the state machine that
+                               says which checkers are wanted
+       EVENT_CHECK_STATES      a list of masks, 1 for each checker, of
+                               ES_CHECK_IN(State) or'd together, or
+                               ES_CHECK_ANY_STATE
+     without them every checker is called on every pass, as before.
+
+     ES_CHECK_ROUND_ROBIN set to 1 has each pass start after the checker
+     that last found an event, so that every checker is reached within as
+     many passes as there are checkers. ES_CHECK_STATS set to 1 counts the
+     calls of each checker and the events it found. Both default to 0.
 
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 07:30 adl      ES_CHECK_ROUND_ROBIN and ES_CHECK_STATS
+ 10/18/26 07:10 adl      periods and state masks for the checkers
  02/08/12 15:27 jec      added #define for the case of no user event checkers
  01/15/12 12:00 jec      new header for local types
  10/16/11 17:17 jec      started coding
@@ -17,14 +34,38 @@
 #ifndef ES_CheckEvents_H
 #define ES_CheckEvents_H
 
+#include "ES_Configure.h"
 #include "ES_Types.h"
 
+#ifndef ES_CHECK_ROUND_ROBIN
+#define ES_CHECK_ROUND_ROBIN 0
+#endif
+
+#ifndef ES_CHECK_STATS
+#define ES_CHECK_STATS 0
+#endif
+
+// how many times a checker has been called, and how many found an event
+typedef struct {
+  uint32_t Calls;
+  uint32_t Fires;
+} ES_CheckStats_t;
+
 typedef boolean CheckFunc( void );
 
 typedef CheckFunc (*pCheckFunc);
 
 boolean ES_CheckUserEvents( void );
+#if ES_CHECK_STATS
+boolean ES_QueryCheckStats( uint8_t Which, ES_CheckStats_t *pStats );
+void ES_ClearCheckStats( void );
+void ES_PrintCheckStats( void );
+#endif
 
 #define NO_EVENT_CHECKERS ((pCheckFunc)0)
 
+// the masks for EVENT_CHECK_STATES, for states 0 to 31
+#define ES_CHECK_IN(State) ((uint32_t)1 << (State))
+#define ES_CHECK_ANY_STATE 0xFFFFFFFFUL
+
 #endif  // ES_CheckEvents_H
\ No newline at end of file
@@ -9,22 +9,71 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 16:30 adl      FSR_RING, the FSR's answers to FieldState
+ 10/18/26 16:00 adl      the sensor rings name MasterMachine's service
+ 10/18/26 14:53 adl      ES_CHECK_STATS off by default
+ 10/18/26 14:51 adl      ES_QUEUE_STATS off by default
+ 10/18/26 14:49 adl      ES_RECORD off by default
+ 10/18/26 14:47 adl      ES_PROFILE off by default
+ 10/18/26 14:45 adl      ES_TRACE off by default
+ 10/18/26 14:40 adl      a beacon sensor's found and lost share its ring
+ 10/18/26 11:30 adl      ES_RECORD, the log at ES_LOG_STATES
+ 10/18/26 07:50 adl      ES_CHECK_ROUND_ROBIN and ES_CHECK_STATS
+ 10/18/26 07:10 adl      event checker periods and states
+ 10/18/26 06:30 adl      dispatch profile
+ 10/18/26 04:30 adl      event trace
+ 10/18/26 02:10 adl      KEY_RING, keys posted from the SCI0 ISR
+ 10/18/26 01:30 adl      deferred log level, size and sources
+ 10/18/26 00:30 adl      ES_FSR_ERROR
+ 10/17/26 23:40 adl      FieldState is service 1
+ 10/17/26 22:55 adl      ES_FSR_RESULT
+ 10/17/26 21:45 adl      timers come from the pool, TIMERn_RESP_FUNC optional
+ 10/17/26 20:40 adl      ES_NUM_TIMERS
+ 10/17/26 19:25 adl      COALESCE_EVENT_LIST
+ 10/17/26 18:35 adl      ES_QUEUE_STATS
+ 10/17/26 17:25 adl      ES_RUN_BATCH_SIZE
+ 10/17/26 15:50 adl      ISR rings
+ 10/17/26 14:25 adl      SERV_n_QUEUE_POW2
  01/15/12 10:03 jec      started coding
 *****************************************************************************/
 
 #ifndef CONFIGURE_H
 #define CONFIGURE_H
 
+/****************************************************************************/
+// Host programs (benchmarks and the like, see Host/) bring their own services,
+// event checkers and timer routing. They name the header that defines them
+// with ES_HOST_CONFIG, and the application definitions below are skipped.
+#ifdef ES_HOST_CONFIG
+#include ES_HOST_CONFIG
+#else
+
 /****************************************************************************/
 // The maximum number of services sets an upper bound on the number of 
-// services that the framework will handle. Reasonable values are 8 and 16
-// HOWEVER: at this time only a value of 8 is supported.
+// services that the framework will handle. Supported values are 8, 16, 32
+// and 64. Keep it at 8 unless you need more: 8 services use a single byte
+// to track the ready queues, larger values add a second level to it.
 #define MAX_NUM_SERVICES 8
 
 /****************************************************************************/
 // This macro determines that nuber of services that are *actually* used in
 // a particular application. It will vary in value from 1 to MAX_NUM_SERVICES
-#define NUM_SERVICES 1
+#define NUM_SERVICES 2
+
+/****************************************************************************/
+// ES_Run normally takes 1 event at a time from a service's queue. Set this
+// above 1 to have it take up to that many events in a single critical region
+// and run them back to back (a higher priority service that becomes ready
+// still runs between them). Interrupts stay off while the batch is copied,
+// so keep it small; it only pays off when events arrive in bunches
+#define ES_RUN_BATCH_SIZE 1
+
+/****************************************************************************/
+// Set to 1 to have every service's queue keep its high water mark, posts,
+// drops and longest wait (in timer ticks). Use ES_QueryServiceQueue to read
+// them, or press 's' to have ES_Run print them. Costs a few bytes of RAM per
+// queue entry and a little time on every post
+#define ES_QUEUE_STATS 0
 
 /****************************************************************************/
 // These are the definitions for Service 0, the lowest priority service
@@ -39,6 +88,10 @@
 #define SERV_0_RUN RunMasterMachine
 // How big should this services Queue be?
 #define SERV_0_QUEUE_SIZE 4
+// Set to 1 if the queue size is a power of 2 (2,4,8,...) and you want it
+// indexed with a mask rather than a modulo, which shortens the time that
+// interrupts are off for each post. Any service may set SERV_n_QUEUE_POW2
+#define SERV_0_QUEUE_POW2 1
 
 /****************************************************************************/
 // The following sections are used to define the parameters for each of the
@@ -48,13 +101,14 @@
 // These are the definitions for Service 1
 #if NUM_SERVICES > 1
 // the header file with the public fuction prototypes
-#define SERV_1_HEADER "TemplateFSM.h"
+#define SERV_1_HEADER "FieldState.h"
 // the name of the Init function
-#define SERV_1_INIT InitTemplateFSM
+#define SERV_1_INIT InitFieldState
 // the name of the run function
-#define SERV_1_RUN RunTemplateFSM
+#define SERV_1_RUN RunFieldState
 // How big should this services Queue be?
-#define SERV_1_QUEUE_SIZE 3
+#define SERV_1_QUEUE_SIZE 4
+#define SERV_1_QUEUE_POW2 1
 #endif
 
 /****************************************************************************/
@@ -135,12 +189,19 @@
 #define SERV_7_QUEUE_SIZE 3
 #endif
 
+/****************************************************************************/
+// Services 8 through 63 follow the same pattern (SERV_n_HEADER, SERV_n_INIT,
+// SERV_n_RUN, SERV_n_QUEUE_SIZE and optionally SERV_n_QUEUE_POW2) and need MAX_NUM_SERVICES raised to 16,
+// 32 or 64 to match
+
 /****************************************************************************/
 // the name of the posting function that you want executed when a new 
 // keystroke is detected.
 // The default initialization distributes keystrokes to all state machines
 #define POST_KEY_FUNC ES_PostAll
 
+#endif /* ES_HOST_CONFIG */
+
 /****************************************************************************/
 // Name/define the events of interest
 // Universal events occupy the lowest entries, followed by user-defined events
@@ -162,8 +223,14 @@ typedef enum {  ES_NO_EVENT = 0,
                 ES_BALL_BIN_EMPTY,
                 ES_DANGERWALL_RIGHT,
                 ES_DANGERWALL_LEFT,
-                ES_NO_DANGERWALL} ES_EventTyp_t ;
+                ES_NO_DANGERWALL,
+                ES_FSR_RESULT, /* answer to FSR_Query, see FSR.h */
+                ES_FSR_ERROR /* FSR_Query got no answer, see FSR.h */} ES_EventTyp_t ;
+
+// use this to mark timers that are not routed to any service
+#define TIMER_UNUSED ((pPostFunc)0)
 
+#ifndef ES_HOST_CONFIG
 /****************************************************************************/
 // These are the definitions for the Distribution lists. Each definition
 // should be a comma seperated list of post functions to indicate which
@@ -202,27 +269,131 @@ typedef enum {  ES_NO_EVENT = 0,
 // This is the list of event checking functions 
 #define EVENT_CHECK_LIST Check4Start, Wall_CheckEvents
 
+// The least time, in timer ticks, between 2 calls of each checker above,
+// and the MasterMachine states that each is wanted in (see ES_CheckEvents.h).
+// Leave these out to have every checker called on every pass.
+#define EVENT_CHECK_PERIODS 30, 50
+#define EVENT_CHECK_STATE_FUNC QueryMasterMachine
+#define EVENT_CHECK_STATES ES_CHECK_IN(PreGame), ES_CHECK_IN(Defending)
+
+// Set ES_CHECK_ROUND_ROBIN to 1 to start each pass after the checker that
+// last found an event, so that one early in the list can't starve the rest,
+// and ES_CHECK_STATS to 1 to count each checker's calls and events ('c' on
+// the terminal prints them). See ES_CheckEvents.h.
+#define ES_CHECK_ROUND_ROBIN 1
+#define ES_CHECK_STATS 0
+
+/****************************************************************************/
+// The number of timers, from 8 to 64. Running timers are kept sorted by when
+// they expire, so the RTI costs the same however many are running.
+// MasterMachine takes its timers from the pool (see TimingConstants.h), as do
+// FSR.c and FieldState.c 1 each
+#define ES_NUM_TIMERS 16
+
 /****************************************************************************/
 // These are the definitions for the post functions to be executed when the
-// correspnding timer expires. All 8 must be defined. If you are not using
-// a timers, then you can use TIMER_UNUSED
-#define TIMER_UNUSED ((pPostFunc)0)
-#define TIMER0_RESP_FUNC PostMasterMachine
-#define TIMER1_RESP_FUNC PostMasterMachine
-#define TIMER2_RESP_FUNC PostMasterMachine
-#define TIMER3_RESP_FUNC PostMasterMachine
-#define TIMER4_RESP_FUNC PostMasterMachine
-#define TIMER5_RESP_FUNC PostMasterMachine
-#define TIMER6_RESP_FUNC PostMasterMachine
-#define TIMER7_RESP_FUNC PostMasterMachine
+// correspnding timer expires, for timers with a fixed number. Any timer
+// without one (or with TIMER_UNUSED) goes into the pool, and a service gets
+// it with ES_Timer_Alloc, naming the post function and event there instead.
+// This application takes all of its timers from the pool.
+//#define TIMER0_RESP_FUNC PostMasterMachine
 
 /****************************************************************************/
-// Give the timer numbers symbolc names to make it easier to move them
+// Give any fixed timer numbers symbolc names to make it easier to move them
 // to different timers if the need arises. Keep these definitons close to the
 // definitions for the response functions to make it easier to check that
 // the timer number matches where the timer event will be routed 
 
-#define KEY_DOWN_TIMER 0
-#define MULTI_PRESS_TIMER 1
+/****************************************************************************/
+// These are the definitions for the ISR rings. Each ISR that posts events
+// gets a ring of its own (up to 8) and posts with ES_ISRRing_Post rather than
+// the service's post function, so that it never turns interrupts off. ES_Run
+// hands the events on to the service given for the ring (its number, as in
+// SERV_n_ above) or, for a ring that does not go to 1 service, with the
+// post function given for it. A post to a service that does not fit stays
+// in the ring to be tried again, and is not logged as dropped; one through
+// a post function is logged as dropped each time it is tried. The ring
+// size must be a power of 2, no larger than 128. Set NUM_ISR_RINGS to 0 if
+// no ISR posts events.
+#define NUM_ISR_RINGS 8
+#define ISR_RING_SIZE 4
+#define ISR_RING0_SERVICE 0 // MasterMachine
+#define ISR_RING1_SERVICE 0
+#define ISR_RING2_SERVICE 0
+#define ISR_RING3_SERVICE 0
+#define ISR_RING4_SERVICE 0
+#define ISR_RING5_SERVICE 0
+#define ISR_RING6_POST_FUNC ES_PostKey
+#define ISR_RING7_SERVICE 1 // FieldState
+
+// Give the rings symbolic names, as for the timers, and keep them next to the
+// services above. Rings are emptied in number order, so events only
+// keep their order within a ring. Each beacon sensor posts the beacon found
+// (from its input capture ISR) and lost (from the output compare ISR) into
+// its one ring, so a beacon found and lost between 2 passes of ES_Run
+// arrives in that order
+#define LEFT_TAPE_RING 0
+#define RIGHT_TAPE_RING 1
+#define FRONT_BUMPER_RING 2
+#define REAR_BUMPER_RING 3
+#define FRONT_BEACON_RING 4
+#define REAR_BEACON_RING 5
+// the SCI0 ISR (termio.c) posts each key as ES_NEW_KEY, which ES_PostKey
+// turns into a test event. With KEY_RING defined ES_Run no longer polls kbhit
+#define KEY_RING 6
+// the FSR's answers, posted from the SPI ISR (FSR.c) to the service that
+// asks, FieldState. With no rings FSR.c posts to FSR_POST_FUNC instead
+#define FSR_RING 7
+
+/****************************************************************************/
+// These event types are posted "latest value wins": if a service's queue
+// already holds an event of the same type, the new one replaces it (and goes
+// to the back of the queue) rather than taking another entry. Use it only for
+// events that report a reading, where an older reading is of no use once a
+// newer one has arrived. Leave it undefined to post every event as usual.
+#define COALESCE_EVENT_LIST ES_BEACON_FRONT, ES_BEACON_REAR, \
+                            ES_DANGERWALL_RIGHT, ES_DANGERWALL_LEFT, \
+                            ES_NO_DANGERWALL
+
+/****************************************************************************/
+// The deferred log (ES_Log.h). ES_LOG_LEVEL picks what the machines log:
+// ES_LOG_OFF, ES_LOG_NOTES, ES_LOG_STATES (and entries and exits) or
+// ES_LOG_EVENTS (and every event that each machine runs). The log is a ring
+// of ES_LOG_SIZE bytes (a power of 2, 16 to 128), 10 bytes a record.
+#define ES_LOG_LEVEL ES_LOG_STATES
+#define ES_LOG_SIZE 128
+
+// Set ES_RECORD to 1 to log every post as well, for Host/Replay to play a
+// console capture of the match back through the machines. It needs
+// ES_LOG_STATES or above; ES_LOG_EVENTS only repeats the posts
+#define ES_RECORD 0
+
+// the source of each record, which machine wrote it
+#define LOG_MASTER 0
+#define LOG_GATHERING 1
+#define LOG_SCORING 2
+#define LOG_DEFENDING 3
+
+/****************************************************************************/
+// The event trace (ES_Trace.h). Set ES_TRACE to 1 to record every post,
+// dequeue, dispatch, timer expiry and state transition, with the fine
+// timebase, in a ring of the latest ES_TRACE_SIZE records (a power of 2, 8
+// bytes each). Press 'd' to dump it, MasterMachine dumps it at game over;
+// Host/TraceDecode turns a dump into a timeline. The machines use the LOG_
+// sources above to say which machine changed state
+#define ES_TRACE 0
+#define ES_TRACE_SIZE 256
+
+/****************************************************************************/
+// The dispatch profile (ES_Profile.h). Set ES_PROFILE to 1 to time every run
+// function and every event's wait in its queue, with the fine timebase, per
+// service and per event type (the types below ES_PROFILE_NUM_EVENTS), with
+// a log2 histogram per service. Press 'm' to print it, or read it with
+// ES_Profile_QueryService and ES_Profile_QueryEvent. Costs 4 bytes of RAM
+// per queue entry, 96 per service and 32 per event type
+#define ES_PROFILE 0
+#define ES_PROFILE_NUM_EVENTS 24
+
+#endif /* ES_HOST_CONFIG */
 
 #endif /* CONFIGURE_H */
\ No newline at end of file
@@ -17,7 +17,7 @@
 #ifndef ES_Events_H
 #define ES_Events_H
 
-#include "stdint.h"
+#include "ES_Types.h"
 
 typedef struct ES_Event_t {
     ES_EventTyp_t EventType;    // what kind of event?
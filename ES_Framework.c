@@ -8,6 +8,28 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 16:40 adl      every queue a power of 2 in a masks only build
+ 10/18/26 16:00 adl      ES_PostFromRing: a ring says itself that its post is
+                         tried again, any other post that does not fit is
+                         logged as dropped
+ 10/18/26 15:00 adl      a coalesced post is known from ES_EnQueue; a post
+                         an ISR ring will try again is not logged as dropped
+ 10/18/26 11:25 adl      every post goes into the log with ES_RECORD
+ 10/18/26 07:45 adl      event checker counts, printed on request
+ 10/18/26 06:25 adl      dispatch profile: run time and queue wait of each
+                         dispatch, printed on request
+ 10/18/26 04:15 adl      event trace: posts, dequeues and each dispatch go into
+                         the trace, ES_Run dumps it on request
+ 10/18/26 02:10 adl      keys come from the SCI0 ISR through KEY_RING, no poll;
+                         ES_PostKey maps them to test events
+ 10/18/26 01:25 adl      ES_Initialize empties the deferred log
+ 10/17/26 19:20 adl      coalesced posts in the statistics table
+ 10/17/26 18:20 adl      queue statistics, query and print on request
+ 10/17/26 17:10 adl      optional batch dequeue in ES_Run (ES_RUN_BATCH_SIZE)
+ 10/17/26 15:55 adl      ES_Run empties the ISR rings into the service queues
+ 10/17/26 14:20 adl      SERV_n_QUEUE_POW2 selects a power of 2 queue
+ 10/17/26 13:05 adl      support for 16, 32 and 64 services with a 2 level
+                         Ready set
  01/30/12 19:31 jec      moved call to ES_InitTimers into the ES_Initialize
                          this rewuired adding a parameter to ES_Initialize.
  01/15/12 12:15 jec      major revision for Gen2
@@ -23,6 +45,11 @@
 #include "ES_LookupTables.h"
 #include "ES_Timers.h"
 #include "ES_Framework.h"
+#include "ES_Port.h"
+#include "ES_ISRRing.h"
+#include "ES_Log.h"
+#include "ES_Trace.h"
+#include "ES_Profile.h"
 #include <stdio.h>
 #include <termio.h>
 
@@ -37,10 +64,51 @@ typedef boolean InitFunc_t( uint8_t Priority );
 typedef ES_Event RunFunc_t( ES_Event ThisEvent );
 
 typedef InitFunc_t * pInitFunc;
+
 typedef RunFunc_t * pRunFunc;
 
 #define NULL_INIT_FUNC ((pInitFunc)0)
 
+// runs a service's run function, between a start and an end record when
+// the trace is on, timed when the profile is on. Posted is when the event
+// was posted, only looked at by the profile
+#if ES_PROFILE
+#define RunService(Serv, Event, Posted)  MeasuredRun(Serv, Event, Posted)
+#elif ES_TRACE
+#define RunService(Serv, Event, Posted)  MeasuredRun(Serv, Event, 0)
+#else
+#define RunService(Serv, Event, Posted)  ServDescList[Serv].RunFunc(Event)
+#endif
+
+#if (MAX_NUM_SERVICES != 8) && (MAX_NUM_SERVICES != 16) && \
+    (MAX_NUM_SERVICES != 32) && (MAX_NUM_SERVICES != 64)
+#error MAX_NUM_SERVICES must be 8, 16, 32 or 64
+#endif
+#if NUM_SERVICES > MAX_NUM_SERVICES
+#error NUM_SERVICES is larger than MAX_NUM_SERVICES
+#endif
+
+/*
+  The Ready set has 1 bit per service, set while that service's queue holds
+  events. With 8 services it is a single byte and the highest priority
+  service with events is 1 lookup in Byte2MSBitNum, exactly as before.
+  Beyond 8 it is 1 byte per group of 8 services plus ReadyGroups, with 1 bit
+  per group that has any services ready. Finding the highest priority service
+  is then 2 lookups, however many services there are.
+*/
+#if MAX_NUM_SERVICES == 8
+#define AnyReady()          (Ready != 0)
+#define HighestReady()      Byte2MSBitNum[Ready-1]
+#define MarkReady(Serv)     Ready |= BitNum2SetMask[Serv]
+#define MarkNotReady(Serv)  Ready &= BitNum2ClrMask[Serv]
+#else
+#define NUM_READY_GROUPS    (MAX_NUM_SERVICES/8)
+#define AnyReady()          (ReadyGroups != 0)
+#define HighestReady()      HighestReadyService()
+#define MarkReady(Serv)     MarkServiceReady(Serv)
+#define MarkNotReady(Serv)  MarkServiceNotReady(Serv)
+#endif
+
 typedef struct {
     InitFunc_t *InitFunc;    // Service Initialization function
     RunFunc_t *RunFunc;      // Service Run function
@@ -49,10 +117,30 @@ typedef struct {
 typedef struct {
     ES_Event *pMem;       // pointer to the memory
     uint8_t Size;      // how big is it
+    boolean Pow2;      // power of 2 size, index it with a mask
 }ES_QueueDesc_t;
 
 /*---------------------------- Module Functions ---------------------------*/
+#ifndef KEY_RING
 static boolean CheckSystemEvents( void );
+#endif
+static boolean PostToService( uint8_t WhichService, ES_Event TheEvent,
+                              boolean FromRing );
+#if ES_QUEUE_STATS
+static void PrintQueueStats( void );
+#endif
+#if ES_RUN_BATCH_SIZE > 1
+static boolean RunHigherServices( uint8_t Priority );
+#endif
+#if ES_TRACE || ES_PROFILE
+static ES_Event MeasuredRun( uint8_t WhichService, ES_Event ThisEvent,
+                             uint32_t Posted );
+#endif
+#if MAX_NUM_SERVICES > 8
+static uint8_t HighestReadyService( void );
+static void MarkServiceReady( uint8_t WhichService );
+static void MarkServiceNotReady( uint8_t WhichService );
+#endif
 
 /*---------------------------- Module Variables ---------------------------*/
 /****************************************************************************/
@@ -85,6 +173,174 @@ static ES_ServDesc_t const ServDescList[] =
 #if NUM_SERVICES > 7
   ,{SERV_7_INIT, SERV_7_RUN }
 #endif
+#if NUM_SERVICES > 8
+  ,{SERV_8_INIT, SERV_8_RUN }
+#endif
+#if NUM_SERVICES > 9
+  ,{SERV_9_INIT, SERV_9_RUN }
+#endif
+#if NUM_SERVICES > 10
+  ,{SERV_10_INIT, SERV_10_RUN }
+#endif
+#if NUM_SERVICES > 11
+  ,{SERV_11_INIT, SERV_11_RUN }
+#endif
+#if NUM_SERVICES > 12
+  ,{SERV_12_INIT, SERV_12_RUN }
+#endif
+#if NUM_SERVICES > 13
+  ,{SERV_13_INIT, SERV_13_RUN }
+#endif
+#if NUM_SERVICES > 14
+  ,{SERV_14_INIT, SERV_14_RUN }
+#endif
+#if NUM_SERVICES > 15
+  ,{SERV_15_INIT, SERV_15_RUN }
+#endif
+#if NUM_SERVICES > 16
+  ,{SERV_16_INIT, SERV_16_RUN }
+#endif
+#if NUM_SERVICES > 17
+  ,{SERV_17_INIT, SERV_17_RUN }
+#endif
+#if NUM_SERVICES > 18
+  ,{SERV_18_INIT, SERV_18_RUN }
+#endif
+#if NUM_SERVICES > 19
+  ,{SERV_19_INIT, SERV_19_RUN }
+#endif
+#if NUM_SERVICES > 20
+  ,{SERV_20_INIT, SERV_20_RUN }
+#endif
+#if NUM_SERVICES > 21
+  ,{SERV_21_INIT, SERV_21_RUN }
+#endif
+#if NUM_SERVICES > 22
+  ,{SERV_22_INIT, SERV_22_RUN }
+#endif
+#if NUM_SERVICES > 23
+  ,{SERV_23_INIT, SERV_23_RUN }
+#endif
+#if NUM_SERVICES > 24
+  ,{SERV_24_INIT, SERV_24_RUN }
+#endif
+#if NUM_SERVICES > 25
+  ,{SERV_25_INIT, SERV_25_RUN }
+#endif
+#if NUM_SERVICES > 26
+  ,{SERV_26_INIT, SERV_26_RUN }
+#endif
+#if NUM_SERVICES > 27
+  ,{SERV_27_INIT, SERV_27_RUN }
+#endif
+#if NUM_SERVICES > 28
+  ,{SERV_28_INIT, SERV_28_RUN }
+#endif
+#if NUM_SERVICES > 29
+  ,{SERV_29_INIT, SERV_29_RUN }
+#endif
+#if NUM_SERVICES > 30
+  ,{SERV_30_INIT, SERV_30_RUN }
+#endif
+#if NUM_SERVICES > 31
+  ,{SERV_31_INIT, SERV_31_RUN }
+#endif
+#if NUM_SERVICES > 32
+  ,{SERV_32_INIT, SERV_32_RUN }
+#endif
+#if NUM_SERVICES > 33
+  ,{SERV_33_INIT, SERV_33_RUN }
+#endif
+#if NUM_SERVICES > 34
+  ,{SERV_34_INIT, SERV_34_RUN }
+#endif
+#if NUM_SERVICES > 35
+  ,{SERV_35_INIT, SERV_35_RUN }
+#endif
+#if NUM_SERVICES > 36
+  ,{SERV_36_INIT, SERV_36_RUN }
+#endif
+#if NUM_SERVICES > 37
+  ,{SERV_37_INIT, SERV_37_RUN }
+#endif
+#if NUM_SERVICES > 38
+  ,{SERV_38_INIT, SERV_38_RUN }
+#endif
+#if NUM_SERVICES > 39
+  ,{SERV_39_INIT, SERV_39_RUN }
+#endif
+#if NUM_SERVICES > 40
+  ,{SERV_40_INIT, SERV_40_RUN }
+#endif
+#if NUM_SERVICES > 41
+  ,{SERV_41_INIT, SERV_41_RUN }
+#endif
+#if NUM_SERVICES > 42
+  ,{SERV_42_INIT, SERV_42_RUN }
+#endif
+#if NUM_SERVICES > 43
+  ,{SERV_43_INIT, SERV_43_RUN }
+#endif
+#if NUM_SERVICES > 44
+  ,{SERV_44_INIT, SERV_44_RUN }
+#endif
+#if NUM_SERVICES > 45
+  ,{SERV_45_INIT, SERV_45_RUN }
+#endif
+#if NUM_SERVICES > 46
+  ,{SERV_46_INIT, SERV_46_RUN }
+#endif
+#if NUM_SERVICES > 47
+  ,{SERV_47_INIT, SERV_47_RUN }
+#endif
+#if NUM_SERVICES > 48
+  ,{SERV_48_INIT, SERV_48_RUN }
+#endif
+#if NUM_SERVICES > 49
+  ,{SERV_49_INIT, SERV_49_RUN }
+#endif
+#if NUM_SERVICES > 50
+  ,{SERV_50_INIT, SERV_50_RUN }
+#endif
+#if NUM_SERVICES > 51
+  ,{SERV_51_INIT, SERV_51_RUN }
+#endif
+#if NUM_SERVICES > 52
+  ,{SERV_52_INIT, SERV_52_RUN }
+#endif
+#if NUM_SERVICES > 53
+  ,{SERV_53_INIT, SERV_53_RUN }
+#endif
+#if NUM_SERVICES > 54
+  ,{SERV_54_INIT, SERV_54_RUN }
+#endif
+#if NUM_SERVICES > 55
+  ,{SERV_55_INIT, SERV_55_RUN }
+#endif
+#if NUM_SERVICES > 56
+  ,{SERV_56_INIT, SERV_56_RUN }
+#endif
+#if NUM_SERVICES > 57
+  ,{SERV_57_INIT, SERV_57_RUN }
+#endif
+#if NUM_SERVICES > 58
+  ,{SERV_58_INIT, SERV_58_RUN }
+#endif
+#if NUM_SERVICES > 59
+  ,{SERV_59_INIT, SERV_59_RUN }
+#endif
+#if NUM_SERVICES > 60
+  ,{SERV_60_INIT, SERV_60_RUN }
+#endif
+#if NUM_SERVICES > 61
+  ,{SERV_61_INIT, SERV_61_RUN }
+#endif
+#if NUM_SERVICES > 62
+  ,{SERV_62_INIT, SERV_62_RUN }
+#endif
+#if NUM_SERVICES > 63
+  ,{SERV_63_INIT, SERV_63_RUN }
+#endif
 
 };
 
@@ -95,111 +351,1012 @@ static ES_ServDesc_t const ServDescList[] =
 static pPostFunc const pPostKeyFunc = POST_KEY_FUNC;
 
 /****************************************************************************/
-// The queues for the services
+// The queues for the services. A service that asks for a power of 2 queue
+// (SERV_n_QUEUE_POW2) must also give it a power of 2 size, and so must every
+// service in a build that indexes its queues with masks only (see
+// ES_QUEUE_INDEXING in ES_Queue.h), which has no way to index any other
+#define MASKS_ONLY (ES_QUEUE_INDEXING == ES_QUEUE_MASK)
 
-static ES_Event Queue0[SERV_0_QUEUE_SIZE+1];
+static ES_Event Queue0[ES_QUEUE_BLOCK_SIZE(SERV_0_QUEUE_SIZE)];
+#if (SERV_0_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_0_QUEUE_SIZE & (SERV_0_QUEUE_SIZE-1))
+#error SERV_0_QUEUE_SIZE must be a power of 2 (SERV_0_QUEUE_POW2 or masks only)
+#endif
 #if NUM_SERVICES > 1
-static ES_Event Queue1[SERV_1_QUEUE_SIZE+1];
+static ES_Event Queue1[ES_QUEUE_BLOCK_SIZE(SERV_1_QUEUE_SIZE)];
+#if (SERV_1_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_1_QUEUE_SIZE & (SERV_1_QUEUE_SIZE-1))
+#error SERV_1_QUEUE_SIZE must be a power of 2 (SERV_1_QUEUE_POW2 or masks only)
+#endif
 #endif
 #if NUM_SERVICES > 2
-static ES_Event Queue2[SERV_2_QUEUE_SIZE+1];
+static ES_Event Queue2[ES_QUEUE_BLOCK_SIZE(SERV_2_QUEUE_SIZE)];
+#if (SERV_2_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_2_QUEUE_SIZE & (SERV_2_QUEUE_SIZE-1))
+#error SERV_2_QUEUE_SIZE must be a power of 2 (SERV_2_QUEUE_POW2 or masks only)
+#endif
 #endif
 #if NUM_SERVICES > 3
-static ES_Event Queue3[SERV_3_QUEUE_SIZE+1];
+static ES_Event Queue3[ES_QUEUE_BLOCK_SIZE(SERV_3_QUEUE_SIZE)];
+#if (SERV_3_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_3_QUEUE_SIZE & (SERV_3_QUEUE_SIZE-1))
+#error SERV_3_QUEUE_SIZE must be a power of 2 (SERV_3_QUEUE_POW2 or masks only)
+#endif
 #endif
 #if NUM_SERVICES > 4
-static ES_Event Queue4[SERV_4_QUEUE_SIZE+1];
+static ES_Event Queue4[ES_QUEUE_BLOCK_SIZE(SERV_4_QUEUE_SIZE)];
+#if (SERV_4_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_4_QUEUE_SIZE & (SERV_4_QUEUE_SIZE-1))
+#error SERV_4_QUEUE_SIZE must be a power of 2 (SERV_4_QUEUE_POW2 or masks only)
+#endif
 #endif
 #if NUM_SERVICES > 5
-static ES_Event Queue5[SERV_5_QUEUE_SIZE+1];
+static ES_Event Queue5[ES_QUEUE_BLOCK_SIZE(SERV_5_QUEUE_SIZE)];
+#if (SERV_5_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_5_QUEUE_SIZE & (SERV_5_QUEUE_SIZE-1))
+#error SERV_5_QUEUE_SIZE must be a power of 2 (SERV_5_QUEUE_POW2 or masks only)
+#endif
 #endif
 #if NUM_SERVICES > 6
-static ES_Event Queue6[SERV_6_QUEUE_SIZE+1];
+static ES_Event Queue6[ES_QUEUE_BLOCK_SIZE(SERV_6_QUEUE_SIZE)];
+#if (SERV_6_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_6_QUEUE_SIZE & (SERV_6_QUEUE_SIZE-1))
+#error SERV_6_QUEUE_SIZE must be a power of 2 (SERV_6_QUEUE_POW2 or masks only)
+#endif
 #endif
 #if NUM_SERVICES > 7
-static ES_Event Queue7[SERV_7_QUEUE_SIZE+1];
+static ES_Event Queue7[ES_QUEUE_BLOCK_SIZE(SERV_7_QUEUE_SIZE)];
+#if (SERV_7_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_7_QUEUE_SIZE & (SERV_7_QUEUE_SIZE-1))
+#error SERV_7_QUEUE_SIZE must be a power of 2 (SERV_7_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 8
+static ES_Event Queue8[ES_QUEUE_BLOCK_SIZE(SERV_8_QUEUE_SIZE)];
+#if (SERV_8_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_8_QUEUE_SIZE & (SERV_8_QUEUE_SIZE-1))
+#error SERV_8_QUEUE_SIZE must be a power of 2 (SERV_8_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 9
+static ES_Event Queue9[ES_QUEUE_BLOCK_SIZE(SERV_9_QUEUE_SIZE)];
+#if (SERV_9_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_9_QUEUE_SIZE & (SERV_9_QUEUE_SIZE-1))
+#error SERV_9_QUEUE_SIZE must be a power of 2 (SERV_9_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 10
+static ES_Event Queue10[ES_QUEUE_BLOCK_SIZE(SERV_10_QUEUE_SIZE)];
+#if (SERV_10_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_10_QUEUE_SIZE & (SERV_10_QUEUE_SIZE-1))
+#error SERV_10_QUEUE_SIZE must be a power of 2 (SERV_10_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 11
+static ES_Event Queue11[ES_QUEUE_BLOCK_SIZE(SERV_11_QUEUE_SIZE)];
+#if (SERV_11_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_11_QUEUE_SIZE & (SERV_11_QUEUE_SIZE-1))
+#error SERV_11_QUEUE_SIZE must be a power of 2 (SERV_11_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 12
+static ES_Event Queue12[ES_QUEUE_BLOCK_SIZE(SERV_12_QUEUE_SIZE)];
+#if (SERV_12_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_12_QUEUE_SIZE & (SERV_12_QUEUE_SIZE-1))
+#error SERV_12_QUEUE_SIZE must be a power of 2 (SERV_12_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 13
+static ES_Event Queue13[ES_QUEUE_BLOCK_SIZE(SERV_13_QUEUE_SIZE)];
+#if (SERV_13_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_13_QUEUE_SIZE & (SERV_13_QUEUE_SIZE-1))
+#error SERV_13_QUEUE_SIZE must be a power of 2 (SERV_13_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 14
+static ES_Event Queue14[ES_QUEUE_BLOCK_SIZE(SERV_14_QUEUE_SIZE)];
+#if (SERV_14_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_14_QUEUE_SIZE & (SERV_14_QUEUE_SIZE-1))
+#error SERV_14_QUEUE_SIZE must be a power of 2 (SERV_14_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 15
+static ES_Event Queue15[ES_QUEUE_BLOCK_SIZE(SERV_15_QUEUE_SIZE)];
+#if (SERV_15_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_15_QUEUE_SIZE & (SERV_15_QUEUE_SIZE-1))
+#error SERV_15_QUEUE_SIZE must be a power of 2 (SERV_15_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 16
+static ES_Event Queue16[ES_QUEUE_BLOCK_SIZE(SERV_16_QUEUE_SIZE)];
+#if (SERV_16_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_16_QUEUE_SIZE & (SERV_16_QUEUE_SIZE-1))
+#error SERV_16_QUEUE_SIZE must be a power of 2 (SERV_16_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 17
+static ES_Event Queue17[ES_QUEUE_BLOCK_SIZE(SERV_17_QUEUE_SIZE)];
+#if (SERV_17_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_17_QUEUE_SIZE & (SERV_17_QUEUE_SIZE-1))
+#error SERV_17_QUEUE_SIZE must be a power of 2 (SERV_17_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 18
+static ES_Event Queue18[ES_QUEUE_BLOCK_SIZE(SERV_18_QUEUE_SIZE)];
+#if (SERV_18_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_18_QUEUE_SIZE & (SERV_18_QUEUE_SIZE-1))
+#error SERV_18_QUEUE_SIZE must be a power of 2 (SERV_18_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 19
+static ES_Event Queue19[ES_QUEUE_BLOCK_SIZE(SERV_19_QUEUE_SIZE)];
+#if (SERV_19_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_19_QUEUE_SIZE & (SERV_19_QUEUE_SIZE-1))
+#error SERV_19_QUEUE_SIZE must be a power of 2 (SERV_19_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 20
+static ES_Event Queue20[ES_QUEUE_BLOCK_SIZE(SERV_20_QUEUE_SIZE)];
+#if (SERV_20_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_20_QUEUE_SIZE & (SERV_20_QUEUE_SIZE-1))
+#error SERV_20_QUEUE_SIZE must be a power of 2 (SERV_20_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 21
+static ES_Event Queue21[ES_QUEUE_BLOCK_SIZE(SERV_21_QUEUE_SIZE)];
+#if (SERV_21_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_21_QUEUE_SIZE & (SERV_21_QUEUE_SIZE-1))
+#error SERV_21_QUEUE_SIZE must be a power of 2 (SERV_21_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 22
+static ES_Event Queue22[ES_QUEUE_BLOCK_SIZE(SERV_22_QUEUE_SIZE)];
+#if (SERV_22_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_22_QUEUE_SIZE & (SERV_22_QUEUE_SIZE-1))
+#error SERV_22_QUEUE_SIZE must be a power of 2 (SERV_22_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 23
+static ES_Event Queue23[ES_QUEUE_BLOCK_SIZE(SERV_23_QUEUE_SIZE)];
+#if (SERV_23_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_23_QUEUE_SIZE & (SERV_23_QUEUE_SIZE-1))
+#error SERV_23_QUEUE_SIZE must be a power of 2 (SERV_23_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 24
+static ES_Event Queue24[ES_QUEUE_BLOCK_SIZE(SERV_24_QUEUE_SIZE)];
+#if (SERV_24_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_24_QUEUE_SIZE & (SERV_24_QUEUE_SIZE-1))
+#error SERV_24_QUEUE_SIZE must be a power of 2 (SERV_24_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 25
+static ES_Event Queue25[ES_QUEUE_BLOCK_SIZE(SERV_25_QUEUE_SIZE)];
+#if (SERV_25_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_25_QUEUE_SIZE & (SERV_25_QUEUE_SIZE-1))
+#error SERV_25_QUEUE_SIZE must be a power of 2 (SERV_25_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 26
+static ES_Event Queue26[ES_QUEUE_BLOCK_SIZE(SERV_26_QUEUE_SIZE)];
+#if (SERV_26_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_26_QUEUE_SIZE & (SERV_26_QUEUE_SIZE-1))
+#error SERV_26_QUEUE_SIZE must be a power of 2 (SERV_26_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 27
+static ES_Event Queue27[ES_QUEUE_BLOCK_SIZE(SERV_27_QUEUE_SIZE)];
+#if (SERV_27_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_27_QUEUE_SIZE & (SERV_27_QUEUE_SIZE-1))
+#error SERV_27_QUEUE_SIZE must be a power of 2 (SERV_27_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 28
+static ES_Event Queue28[ES_QUEUE_BLOCK_SIZE(SERV_28_QUEUE_SIZE)];
+#if (SERV_28_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_28_QUEUE_SIZE & (SERV_28_QUEUE_SIZE-1))
+#error SERV_28_QUEUE_SIZE must be a power of 2 (SERV_28_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 29
+static ES_Event Queue29[ES_QUEUE_BLOCK_SIZE(SERV_29_QUEUE_SIZE)];
+#if (SERV_29_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_29_QUEUE_SIZE & (SERV_29_QUEUE_SIZE-1))
+#error SERV_29_QUEUE_SIZE must be a power of 2 (SERV_29_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 30
+static ES_Event Queue30[ES_QUEUE_BLOCK_SIZE(SERV_30_QUEUE_SIZE)];
+#if (SERV_30_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_30_QUEUE_SIZE & (SERV_30_QUEUE_SIZE-1))
+#error SERV_30_QUEUE_SIZE must be a power of 2 (SERV_30_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 31
+static ES_Event Queue31[ES_QUEUE_BLOCK_SIZE(SERV_31_QUEUE_SIZE)];
+#if (SERV_31_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_31_QUEUE_SIZE & (SERV_31_QUEUE_SIZE-1))
+#error SERV_31_QUEUE_SIZE must be a power of 2 (SERV_31_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 32
+static ES_Event Queue32[ES_QUEUE_BLOCK_SIZE(SERV_32_QUEUE_SIZE)];
+#if (SERV_32_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_32_QUEUE_SIZE & (SERV_32_QUEUE_SIZE-1))
+#error SERV_32_QUEUE_SIZE must be a power of 2 (SERV_32_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 33
+static ES_Event Queue33[ES_QUEUE_BLOCK_SIZE(SERV_33_QUEUE_SIZE)];
+#if (SERV_33_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_33_QUEUE_SIZE & (SERV_33_QUEUE_SIZE-1))
+#error SERV_33_QUEUE_SIZE must be a power of 2 (SERV_33_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 34
+static ES_Event Queue34[ES_QUEUE_BLOCK_SIZE(SERV_34_QUEUE_SIZE)];
+#if (SERV_34_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_34_QUEUE_SIZE & (SERV_34_QUEUE_SIZE-1))
+#error SERV_34_QUEUE_SIZE must be a power of 2 (SERV_34_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 35
+static ES_Event Queue35[ES_QUEUE_BLOCK_SIZE(SERV_35_QUEUE_SIZE)];
+#if (SERV_35_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_35_QUEUE_SIZE & (SERV_35_QUEUE_SIZE-1))
+#error SERV_35_QUEUE_SIZE must be a power of 2 (SERV_35_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 36
+static ES_Event Queue36[ES_QUEUE_BLOCK_SIZE(SERV_36_QUEUE_SIZE)];
+#if (SERV_36_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_36_QUEUE_SIZE & (SERV_36_QUEUE_SIZE-1))
+#error SERV_36_QUEUE_SIZE must be a power of 2 (SERV_36_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 37
+static ES_Event Queue37[ES_QUEUE_BLOCK_SIZE(SERV_37_QUEUE_SIZE)];
+#if (SERV_37_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_37_QUEUE_SIZE & (SERV_37_QUEUE_SIZE-1))
+#error SERV_37_QUEUE_SIZE must be a power of 2 (SERV_37_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 38
+static ES_Event Queue38[ES_QUEUE_BLOCK_SIZE(SERV_38_QUEUE_SIZE)];
+#if (SERV_38_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_38_QUEUE_SIZE & (SERV_38_QUEUE_SIZE-1))
+#error SERV_38_QUEUE_SIZE must be a power of 2 (SERV_38_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 39
+static ES_Event Queue39[ES_QUEUE_BLOCK_SIZE(SERV_39_QUEUE_SIZE)];
+#if (SERV_39_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_39_QUEUE_SIZE & (SERV_39_QUEUE_SIZE-1))
+#error SERV_39_QUEUE_SIZE must be a power of 2 (SERV_39_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 40
+static ES_Event Queue40[ES_QUEUE_BLOCK_SIZE(SERV_40_QUEUE_SIZE)];
+#if (SERV_40_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_40_QUEUE_SIZE & (SERV_40_QUEUE_SIZE-1))
+#error SERV_40_QUEUE_SIZE must be a power of 2 (SERV_40_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 41
+static ES_Event Queue41[ES_QUEUE_BLOCK_SIZE(SERV_41_QUEUE_SIZE)];
+#if (SERV_41_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_41_QUEUE_SIZE & (SERV_41_QUEUE_SIZE-1))
+#error SERV_41_QUEUE_SIZE must be a power of 2 (SERV_41_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 42
+static ES_Event Queue42[ES_QUEUE_BLOCK_SIZE(SERV_42_QUEUE_SIZE)];
+#if (SERV_42_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_42_QUEUE_SIZE & (SERV_42_QUEUE_SIZE-1))
+#error SERV_42_QUEUE_SIZE must be a power of 2 (SERV_42_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 43
+static ES_Event Queue43[ES_QUEUE_BLOCK_SIZE(SERV_43_QUEUE_SIZE)];
+#if (SERV_43_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_43_QUEUE_SIZE & (SERV_43_QUEUE_SIZE-1))
+#error SERV_43_QUEUE_SIZE must be a power of 2 (SERV_43_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 44
+static ES_Event Queue44[ES_QUEUE_BLOCK_SIZE(SERV_44_QUEUE_SIZE)];
+#if (SERV_44_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_44_QUEUE_SIZE & (SERV_44_QUEUE_SIZE-1))
+#error SERV_44_QUEUE_SIZE must be a power of 2 (SERV_44_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 45
+static ES_Event Queue45[ES_QUEUE_BLOCK_SIZE(SERV_45_QUEUE_SIZE)];
+#if (SERV_45_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_45_QUEUE_SIZE & (SERV_45_QUEUE_SIZE-1))
+#error SERV_45_QUEUE_SIZE must be a power of 2 (SERV_45_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 46
+static ES_Event Queue46[ES_QUEUE_BLOCK_SIZE(SERV_46_QUEUE_SIZE)];
+#if (SERV_46_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_46_QUEUE_SIZE & (SERV_46_QUEUE_SIZE-1))
+#error SERV_46_QUEUE_SIZE must be a power of 2 (SERV_46_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 47
+static ES_Event Queue47[ES_QUEUE_BLOCK_SIZE(SERV_47_QUEUE_SIZE)];
+#if (SERV_47_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_47_QUEUE_SIZE & (SERV_47_QUEUE_SIZE-1))
+#error SERV_47_QUEUE_SIZE must be a power of 2 (SERV_47_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 48
+static ES_Event Queue48[ES_QUEUE_BLOCK_SIZE(SERV_48_QUEUE_SIZE)];
+#if (SERV_48_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_48_QUEUE_SIZE & (SERV_48_QUEUE_SIZE-1))
+#error SERV_48_QUEUE_SIZE must be a power of 2 (SERV_48_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 49
+static ES_Event Queue49[ES_QUEUE_BLOCK_SIZE(SERV_49_QUEUE_SIZE)];
+#if (SERV_49_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_49_QUEUE_SIZE & (SERV_49_QUEUE_SIZE-1))
+#error SERV_49_QUEUE_SIZE must be a power of 2 (SERV_49_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 50
+static ES_Event Queue50[ES_QUEUE_BLOCK_SIZE(SERV_50_QUEUE_SIZE)];
+#if (SERV_50_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_50_QUEUE_SIZE & (SERV_50_QUEUE_SIZE-1))
+#error SERV_50_QUEUE_SIZE must be a power of 2 (SERV_50_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 51
+static ES_Event Queue51[ES_QUEUE_BLOCK_SIZE(SERV_51_QUEUE_SIZE)];
+#if (SERV_51_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_51_QUEUE_SIZE & (SERV_51_QUEUE_SIZE-1))
+#error SERV_51_QUEUE_SIZE must be a power of 2 (SERV_51_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 52
+static ES_Event Queue52[ES_QUEUE_BLOCK_SIZE(SERV_52_QUEUE_SIZE)];
+#if (SERV_52_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_52_QUEUE_SIZE & (SERV_52_QUEUE_SIZE-1))
+#error SERV_52_QUEUE_SIZE must be a power of 2 (SERV_52_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 53
+static ES_Event Queue53[ES_QUEUE_BLOCK_SIZE(SERV_53_QUEUE_SIZE)];
+#if (SERV_53_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_53_QUEUE_SIZE & (SERV_53_QUEUE_SIZE-1))
+#error SERV_53_QUEUE_SIZE must be a power of 2 (SERV_53_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 54
+static ES_Event Queue54[ES_QUEUE_BLOCK_SIZE(SERV_54_QUEUE_SIZE)];
+#if (SERV_54_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_54_QUEUE_SIZE & (SERV_54_QUEUE_SIZE-1))
+#error SERV_54_QUEUE_SIZE must be a power of 2 (SERV_54_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 55
+static ES_Event Queue55[ES_QUEUE_BLOCK_SIZE(SERV_55_QUEUE_SIZE)];
+#if (SERV_55_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_55_QUEUE_SIZE & (SERV_55_QUEUE_SIZE-1))
+#error SERV_55_QUEUE_SIZE must be a power of 2 (SERV_55_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 56
+static ES_Event Queue56[ES_QUEUE_BLOCK_SIZE(SERV_56_QUEUE_SIZE)];
+#if (SERV_56_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_56_QUEUE_SIZE & (SERV_56_QUEUE_SIZE-1))
+#error SERV_56_QUEUE_SIZE must be a power of 2 (SERV_56_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 57
+static ES_Event Queue57[ES_QUEUE_BLOCK_SIZE(SERV_57_QUEUE_SIZE)];
+#if (SERV_57_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_57_QUEUE_SIZE & (SERV_57_QUEUE_SIZE-1))
+#error SERV_57_QUEUE_SIZE must be a power of 2 (SERV_57_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 58
+static ES_Event Queue58[ES_QUEUE_BLOCK_SIZE(SERV_58_QUEUE_SIZE)];
+#if (SERV_58_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_58_QUEUE_SIZE & (SERV_58_QUEUE_SIZE-1))
+#error SERV_58_QUEUE_SIZE must be a power of 2 (SERV_58_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 59
+static ES_Event Queue59[ES_QUEUE_BLOCK_SIZE(SERV_59_QUEUE_SIZE)];
+#if (SERV_59_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_59_QUEUE_SIZE & (SERV_59_QUEUE_SIZE-1))
+#error SERV_59_QUEUE_SIZE must be a power of 2 (SERV_59_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 60
+static ES_Event Queue60[ES_QUEUE_BLOCK_SIZE(SERV_60_QUEUE_SIZE)];
+#if (SERV_60_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_60_QUEUE_SIZE & (SERV_60_QUEUE_SIZE-1))
+#error SERV_60_QUEUE_SIZE must be a power of 2 (SERV_60_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 61
+static ES_Event Queue61[ES_QUEUE_BLOCK_SIZE(SERV_61_QUEUE_SIZE)];
+#if (SERV_61_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_61_QUEUE_SIZE & (SERV_61_QUEUE_SIZE-1))
+#error SERV_61_QUEUE_SIZE must be a power of 2 (SERV_61_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 62
+static ES_Event Queue62[ES_QUEUE_BLOCK_SIZE(SERV_62_QUEUE_SIZE)];
+#if (SERV_62_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_62_QUEUE_SIZE & (SERV_62_QUEUE_SIZE-1))
+#error SERV_62_QUEUE_SIZE must be a power of 2 (SERV_62_QUEUE_POW2 or masks only)
+#endif
+#endif
+#if NUM_SERVICES > 63
+static ES_Event Queue63[ES_QUEUE_BLOCK_SIZE(SERV_63_QUEUE_SIZE)];
+#if (SERV_63_QUEUE_POW2 || MASKS_ONLY) && \
+    (SERV_63_QUEUE_SIZE & (SERV_63_QUEUE_SIZE-1))
+#error SERV_63_QUEUE_SIZE must be a power of 2 (SERV_63_QUEUE_POW2 or masks only)
+#endif
+#endif
+
+#if ES_QUEUE_STATS
+// set by ES_RequestQueueStats, ES_Run prints the stats when it is next idle
+static volatile boolean QueueStatsRequested = False;
+#endif
+
+#if ES_TRACE
+// set by ES_RequestTraceDump, ES_Run dumps the trace when it is next idle
+static volatile boolean TraceDumpRequested = False;
+#endif
+
+#if ES_PROFILE
+// set by ES_RequestProfile, ES_Run prints the profile when it is next idle
+static volatile boolean ProfileRequested = False;
+#endif
+
+#if ES_CHECK_STATS
+// set by ES_RequestCheckStats, ES_Run prints the counts when it is next idle
+static volatile boolean CheckStatsRequested = False;
 #endif
 
 /****************************************************************************/
 // array of queue descriptors for posting by priority level
 
 static ES_QueueDesc_t const EventQueues[NUM_SERVICES] = { 
-  { Queue0, ARRAY_SIZE(Queue0) } 
+#if SERV_0_QUEUE_POW2
+  { Queue0, ARRAY_SIZE(Queue0), True }
+#else
+  { Queue0, ARRAY_SIZE(Queue0), False }
+#endif
 #if NUM_SERVICES > 1
-, { Queue1, ARRAY_SIZE(Queue1) }
+#if SERV_1_QUEUE_POW2
+, { Queue1, ARRAY_SIZE(Queue1), True }
+#else
+, { Queue1, ARRAY_SIZE(Queue1), False }
+#endif
 #endif
 #if NUM_SERVICES > 2
-, { Queue2, ARRAY_SIZE(Queue2) }
+#if SERV_2_QUEUE_POW2
+, { Queue2, ARRAY_SIZE(Queue2), True }
+#else
+, { Queue2, ARRAY_SIZE(Queue2), False }
+#endif
 #endif
 #if NUM_SERVICES > 3
-, { Queue3, ARRAY_SIZE(Queue3) }
+#if SERV_3_QUEUE_POW2
+, { Queue3, ARRAY_SIZE(Queue3), True }
+#else
+, { Queue3, ARRAY_SIZE(Queue3), False }
+#endif
 #endif
 #if NUM_SERVICES > 4
-, { Queue4, ARRAY_SIZE(Queue4) }
+#if SERV_4_QUEUE_POW2
+, { Queue4, ARRAY_SIZE(Queue4), True }
+#else
+, { Queue4, ARRAY_SIZE(Queue4), False }
+#endif
 #endif
 #if NUM_SERVICES > 5
-, { Queue5, ARRAY_SIZE(Queue5) }
+#if SERV_5_QUEUE_POW2
+, { Queue5, ARRAY_SIZE(Queue5), True }
+#else
+, { Queue5, ARRAY_SIZE(Queue5), False }
+#endif
 #endif
 #if NUM_SERVICES > 6
-, { Queue6, ARRAY_SIZE(Queue6) }
+#if SERV_6_QUEUE_POW2
+, { Queue6, ARRAY_SIZE(Queue6), True }
+#else
+, { Queue6, ARRAY_SIZE(Queue6), False }
+#endif
 #endif
 #if NUM_SERVICES > 7
-, { Queue7, ARRAY_SIZE(Queue7) }
+#if SERV_7_QUEUE_POW2
+, { Queue7, ARRAY_SIZE(Queue7), True }
+#else
+, { Queue7, ARRAY_SIZE(Queue7), False }
 #endif
-};
-
-/****************************************************************************/
-// Variable used to keep track of which queues have events in them
-
-uint8_t Ready;
-
-/*------------------------------ Module Code ------------------------------*/
-/****************************************************************************
- Function
-   ES_Initialize
- Parameters
-   TimerRate_t the rate at which to initialize the framework timer subsystem
- Returns
-   ES_Return_t : FailedPointer if any of the function pointers are NULL
-                 FailedInit if any of the initialization functions failed
- Description
-   Initialize all the services and tests for NULL pointers in the array
- Notes
-
- Author
-   J. Edward Carryer, 10/23/11,
-****************************************************************************/
-ES_Return_t ES_Initialize( TimerRate_t NewRate ){
-  unsigned char i;
-  ES_Timer_Init( NewRate); // start up the timer subsystem
-  // loop through the list testing for NULL pointers and
-  for ( i=0; i< ARRAY_SIZE(ServDescList); i++) {
-    if ( (ServDescList[i].InitFunc == (pInitFunc)0) ||
-         (ServDescList[i].RunFunc == (pRunFunc)0) )
-      return FailedPointer; // protect against NULL pointers
-    // and initializing the event queues (must happen before running inits)  
-    ES_InitQueue( EventQueues[i].pMem, EventQueues[i].Size );
-   // executing the init functions
-    if ( ServDescList[i].InitFunc(i) != True )
-      return FailedInit; // this is a failed initialization
-  }
-  return Success;
-}
-
-/****************************************************************************
- Function
-   ES_Run
- Parameters
-   None
- Returns
-   ES_Return_t : FailedRun is any of the run functions failed during execution
- Description
-   This is the main framework function. It searches through the state
-   machines to find one with a non-empty queue and then executes the
-   state machine to process the event in its queue.
-   while all the queues are empty, it searches for system generated or
-   user generated events.
- Notes
+#endif
+#if NUM_SERVICES > 8
+#if SERV_8_QUEUE_POW2
+, { Queue8, ARRAY_SIZE(Queue8), True }
+#else
+, { Queue8, ARRAY_SIZE(Queue8), False }
+#endif
+#endif
+#if NUM_SERVICES > 9
+#if SERV_9_QUEUE_POW2
+, { Queue9, ARRAY_SIZE(Queue9), True }
+#else
+, { Queue9, ARRAY_SIZE(Queue9), False }
+#endif
+#endif
+#if NUM_SERVICES > 10
+#if SERV_10_QUEUE_POW2
+, { Queue10, ARRAY_SIZE(Queue10), True }
+#else
+, { Queue10, ARRAY_SIZE(Queue10), False }
+#endif
+#endif
+#if NUM_SERVICES > 11
+#if SERV_11_QUEUE_POW2
+, { Queue11, ARRAY_SIZE(Queue11), True }
+#else
+, { Queue11, ARRAY_SIZE(Queue11), False }
+#endif
+#endif
+#if NUM_SERVICES > 12
+#if SERV_12_QUEUE_POW2
+, { Queue12, ARRAY_SIZE(Queue12), True }
+#else
+, { Queue12, ARRAY_SIZE(Queue12), False }
+#endif
+#endif
+#if NUM_SERVICES > 13
+#if SERV_13_QUEUE_POW2
+, { Queue13, ARRAY_SIZE(Queue13), True }
+#else
+, { Queue13, ARRAY_SIZE(Queue13), False }
+#endif
+#endif
+#if NUM_SERVICES > 14
+#if SERV_14_QUEUE_POW2
+, { Queue14, ARRAY_SIZE(Queue14), True }
+#else
+, { Queue14, ARRAY_SIZE(Queue14), False }
+#endif
+#endif
+#if NUM_SERVICES > 15
+#if SERV_15_QUEUE_POW2
+, { Queue15, ARRAY_SIZE(Queue15), True }
+#else
+, { Queue15, ARRAY_SIZE(Queue15), False }
+#endif
+#endif
+#if NUM_SERVICES > 16
+#if SERV_16_QUEUE_POW2
+, { Queue16, ARRAY_SIZE(Queue16), True }
+#else
+, { Queue16, ARRAY_SIZE(Queue16), False }
+#endif
+#endif
+#if NUM_SERVICES > 17
+#if SERV_17_QUEUE_POW2
+, { Queue17, ARRAY_SIZE(Queue17), True }
+#else
+, { Queue17, ARRAY_SIZE(Queue17), False }
+#endif
+#endif
+#if NUM_SERVICES > 18
+#if SERV_18_QUEUE_POW2
+, { Queue18, ARRAY_SIZE(Queue18), True }
+#else
+, { Queue18, ARRAY_SIZE(Queue18), False }
+#endif
+#endif
+#if NUM_SERVICES > 19
+#if SERV_19_QUEUE_POW2
+, { Queue19, ARRAY_SIZE(Queue19), True }
+#else
+, { Queue19, ARRAY_SIZE(Queue19), False }
+#endif
+#endif
+#if NUM_SERVICES > 20
+#if SERV_20_QUEUE_POW2
+, { Queue20, ARRAY_SIZE(Queue20), True }
+#else
+, { Queue20, ARRAY_SIZE(Queue20), False }
+#endif
+#endif
+#if NUM_SERVICES > 21
+#if SERV_21_QUEUE_POW2
+, { Queue21, ARRAY_SIZE(Queue21), True }
+#else
+, { Queue21, ARRAY_SIZE(Queue21), False }
+#endif
+#endif
+#if NUM_SERVICES > 22
+#if SERV_22_QUEUE_POW2
+, { Queue22, ARRAY_SIZE(Queue22), True }
+#else
+, { Queue22, ARRAY_SIZE(Queue22), False }
+#endif
+#endif
+#if NUM_SERVICES > 23
+#if SERV_23_QUEUE_POW2
+, { Queue23, ARRAY_SIZE(Queue23), True }
+#else
+, { Queue23, ARRAY_SIZE(Queue23), False }
+#endif
+#endif
+#if NUM_SERVICES > 24
+#if SERV_24_QUEUE_POW2
+, { Queue24, ARRAY_SIZE(Queue24), True }
+#else
+, { Queue24, ARRAY_SIZE(Queue24), False }
+#endif
+#endif
+#if NUM_SERVICES > 25
+#if SERV_25_QUEUE_POW2
+, { Queue25, ARRAY_SIZE(Queue25), True }
+#else
+, { Queue25, ARRAY_SIZE(Queue25), False }
+#endif
+#endif
+#if NUM_SERVICES > 26
+#if SERV_26_QUEUE_POW2
+, { Queue26, ARRAY_SIZE(Queue26), True }
+#else
+, { Queue26, ARRAY_SIZE(Queue26), False }
+#endif
+#endif
+#if NUM_SERVICES > 27
+#if SERV_27_QUEUE_POW2
+, { Queue27, ARRAY_SIZE(Queue27), True }
+#else
+, { Queue27, ARRAY_SIZE(Queue27), False }
+#endif
+#endif
+#if NUM_SERVICES > 28
+#if SERV_28_QUEUE_POW2
+, { Queue28, ARRAY_SIZE(Queue28), True }
+#else
+, { Queue28, ARRAY_SIZE(Queue28), False }
+#endif
+#endif
+#if NUM_SERVICES > 29
+#if SERV_29_QUEUE_POW2
+, { Queue29, ARRAY_SIZE(Queue29), True }
+#else
+, { Queue29, ARRAY_SIZE(Queue29), False }
+#endif
+#endif
+#if NUM_SERVICES > 30
+#if SERV_30_QUEUE_POW2
+, { Queue30, ARRAY_SIZE(Queue30), True }
+#else
+, { Queue30, ARRAY_SIZE(Queue30), False }
+#endif
+#endif
+#if NUM_SERVICES > 31
+#if SERV_31_QUEUE_POW2
+, { Queue31, ARRAY_SIZE(Queue31), True }
+#else
+, { Queue31, ARRAY_SIZE(Queue31), False }
+#endif
+#endif
+#if NUM_SERVICES > 32
+#if SERV_32_QUEUE_POW2
+, { Queue32, ARRAY_SIZE(Queue32), True }
+#else
+, { Queue32, ARRAY_SIZE(Queue32), False }
+#endif
+#endif
+#if NUM_SERVICES > 33
+#if SERV_33_QUEUE_POW2
+, { Queue33, ARRAY_SIZE(Queue33), True }
+#else
+, { Queue33, ARRAY_SIZE(Queue33), False }
+#endif
+#endif
+#if NUM_SERVICES > 34
+#if SERV_34_QUEUE_POW2
+, { Queue34, ARRAY_SIZE(Queue34), True }
+#else
+, { Queue34, ARRAY_SIZE(Queue34), False }
+#endif
+#endif
+#if NUM_SERVICES > 35
+#if SERV_35_QUEUE_POW2
+, { Queue35, ARRAY_SIZE(Queue35), True }
+#else
+, { Queue35, ARRAY_SIZE(Queue35), False }
+#endif
+#endif
+#if NUM_SERVICES > 36
+#if SERV_36_QUEUE_POW2
+, { Queue36, ARRAY_SIZE(Queue36), True }
+#else
+, { Queue36, ARRAY_SIZE(Queue36), False }
+#endif
+#endif
+#if NUM_SERVICES > 37
+#if SERV_37_QUEUE_POW2
+, { Queue37, ARRAY_SIZE(Queue37), True }
+#else
+, { Queue37, ARRAY_SIZE(Queue37), False }
+#endif
+#endif
+#if NUM_SERVICES > 38
+#if SERV_38_QUEUE_POW2
+, { Queue38, ARRAY_SIZE(Queue38), True }
+#else
+, { Queue38, ARRAY_SIZE(Queue38), False }
+#endif
+#endif
+#if NUM_SERVICES > 39
+#if SERV_39_QUEUE_POW2
+, { Queue39, ARRAY_SIZE(Queue39), True }
+#else
+, { Queue39, ARRAY_SIZE(Queue39), False }
+#endif
+#endif
+#if NUM_SERVICES > 40
+#if SERV_40_QUEUE_POW2
+, { Queue40, ARRAY_SIZE(Queue40), True }
+#else
+, { Queue40, ARRAY_SIZE(Queue40), False }
+#endif
+#endif
+#if NUM_SERVICES > 41
+#if SERV_41_QUEUE_POW2
+, { Queue41, ARRAY_SIZE(Queue41), True }
+#else
+, { Queue41, ARRAY_SIZE(Queue41), False }
+#endif
+#endif
+#if NUM_SERVICES > 42
+#if SERV_42_QUEUE_POW2
+, { Queue42, ARRAY_SIZE(Queue42), True }
+#else
+, { Queue42, ARRAY_SIZE(Queue42), False }
+#endif
+#endif
+#if NUM_SERVICES > 43
+#if SERV_43_QUEUE_POW2
+, { Queue43, ARRAY_SIZE(Queue43), True }
+#else
+, { Queue43, ARRAY_SIZE(Queue43), False }
+#endif
+#endif
+#if NUM_SERVICES > 44
+#if SERV_44_QUEUE_POW2
+, { Queue44, ARRAY_SIZE(Queue44), True }
+#else
+, { Queue44, ARRAY_SIZE(Queue44), False }
+#endif
+#endif
+#if NUM_SERVICES > 45
+#if SERV_45_QUEUE_POW2
+, { Queue45, ARRAY_SIZE(Queue45), True }
+#else
+, { Queue45, ARRAY_SIZE(Queue45), False }
+#endif
+#endif
+#if NUM_SERVICES > 46
+#if SERV_46_QUEUE_POW2
+, { Queue46, ARRAY_SIZE(Queue46), True }
+#else
+, { Queue46, ARRAY_SIZE(Queue46), False }
+#endif
+#endif
+#if NUM_SERVICES > 47
+#if SERV_47_QUEUE_POW2
+, { Queue47, ARRAY_SIZE(Queue47), True }
+#else
+, { Queue47, ARRAY_SIZE(Queue47), False }
+#endif
+#endif
+#if NUM_SERVICES > 48
+#if SERV_48_QUEUE_POW2
+, { Queue48, ARRAY_SIZE(Queue48), True }
+#else
+, { Queue48, ARRAY_SIZE(Queue48), False }
+#endif
+#endif
+#if NUM_SERVICES > 49
+#if SERV_49_QUEUE_POW2
+, { Queue49, ARRAY_SIZE(Queue49), True }
+#else
+, { Queue49, ARRAY_SIZE(Queue49), False }
+#endif
+#endif
+#if NUM_SERVICES > 50
+#if SERV_50_QUEUE_POW2
+, { Queue50, ARRAY_SIZE(Queue50), True }
+#else
+, { Queue50, ARRAY_SIZE(Queue50), False }
+#endif
+#endif
+#if NUM_SERVICES > 51
+#if SERV_51_QUEUE_POW2
+, { Queue51, ARRAY_SIZE(Queue51), True }
+#else
+, { Queue51, ARRAY_SIZE(Queue51), False }
+#endif
+#endif
+#if NUM_SERVICES > 52
+#if SERV_52_QUEUE_POW2
+, { Queue52, ARRAY_SIZE(Queue52), True }
+#else
+, { Queue52, ARRAY_SIZE(Queue52), False }
+#endif
+#endif
+#if NUM_SERVICES > 53
+#if SERV_53_QUEUE_POW2
+, { Queue53, ARRAY_SIZE(Queue53), True }
+#else
+, { Queue53, ARRAY_SIZE(Queue53), False }
+#endif
+#endif
+#if NUM_SERVICES > 54
+#if SERV_54_QUEUE_POW2
+, { Queue54, ARRAY_SIZE(Queue54), True }
+#else
+, { Queue54, ARRAY_SIZE(Queue54), False }
+#endif
+#endif
+#if NUM_SERVICES > 55
+#if SERV_55_QUEUE_POW2
+, { Queue55, ARRAY_SIZE(Queue55), True }
+#else
+, { Queue55, ARRAY_SIZE(Queue55), False }
+#endif
+#endif
+#if NUM_SERVICES > 56
+#if SERV_56_QUEUE_POW2
+, { Queue56, ARRAY_SIZE(Queue56), True }
+#else
+, { Queue56, ARRAY_SIZE(Queue56), False }
+#endif
+#endif
+#if NUM_SERVICES > 57
+#if SERV_57_QUEUE_POW2
+, { Queue57, ARRAY_SIZE(Queue57), True }
+#else
+, { Queue57, ARRAY_SIZE(Queue57), False }
+#endif
+#endif
+#if NUM_SERVICES > 58
+#if SERV_58_QUEUE_POW2
+, { Queue58, ARRAY_SIZE(Queue58), True }
+#else
+, { Queue58, ARRAY_SIZE(Queue58), False }
+#endif
+#endif
+#if NUM_SERVICES > 59
+#if SERV_59_QUEUE_POW2
+, { Queue59, ARRAY_SIZE(Queue59), True }
+#else
+, { Queue59, ARRAY_SIZE(Queue59), False }
+#endif
+#endif
+#if NUM_SERVICES > 60
+#if SERV_60_QUEUE_POW2
+, { Queue60, ARRAY_SIZE(Queue60), True }
+#else
+, { Queue60, ARRAY_SIZE(Queue60), False }
+#endif
+#endif
+#if NUM_SERVICES > 61
+#if SERV_61_QUEUE_POW2
+, { Queue61, ARRAY_SIZE(Queue61), True }
+#else
+, { Queue61, ARRAY_SIZE(Queue61), False }
+#endif
+#endif
+#if NUM_SERVICES > 62
+#if SERV_62_QUEUE_POW2
+, { Queue62, ARRAY_SIZE(Queue62), True }
+#else
+, { Queue62, ARRAY_SIZE(Queue62), False }
+#endif
+#endif
+#if NUM_SERVICES > 63
+#if SERV_63_QUEUE_POW2
+, { Queue63, ARRAY_SIZE(Queue63), True }
+#else
+, { Queue63, ARRAY_SIZE(Queue63), False }
+#endif
+#endif
+};
+
+/****************************************************************************/
+// Variables used to keep track of which queues have events in them
+
+#if MAX_NUM_SERVICES == 8
+uint8_t Ready;
+#else
+static uint8_t Ready[NUM_READY_GROUPS];
+static uint8_t ReadyGroups;
+#endif
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_Initialize
+ Parameters
+   TimerRate_t the rate at which to initialize the framework timer subsystem
+ Returns
+   ES_Return_t : FailedPointer if any of the function pointers are NULL
+                 FailedInit if any of the initialization functions failed
+ Description
+   Initialize all the services and tests for NULL pointers in the array
+ Notes
+
+ Author
+   J. Edward Carryer, 10/23/11,
+****************************************************************************/
+ES_Return_t ES_Initialize( TimerRate_t NewRate ){
+  unsigned char i;
+  ES_Timer_Init( NewRate); // start up the timer subsystem
+#if NUM_ISR_RINGS > 0
+  ES_ISRRing_Init(); // empty rings, before any ISR can post to them
+#endif
+  ES_Log_Init(); // empty the log, before anything writes to it
+#if ES_TRACE
+  ES_Trace_Init(); // and the trace
+#endif
+#if ES_PROFILE
+  ES_Profile_Clear();
+#endif
+#if ES_CHECK_STATS
+  ES_ClearCheckStats();
+#endif
+  // loop through the list testing for NULL pointers and
+  for ( i=0; i< ARRAY_SIZE(ServDescList); i++) {
+    if ( (ServDescList[i].InitFunc == (pInitFunc)0) ||
+         (ServDescList[i].RunFunc == (pRunFunc)0) )
+      return FailedPointer; // protect against NULL pointers
+    // and initializing the event queues (must happen before running inits)  
+    if ( EventQueues[i].Pow2 == True )
+      ES_InitQueuePow2( EventQueues[i].pMem, EventQueues[i].Size );
+    else
+      ES_InitQueue( EventQueues[i].pMem, EventQueues[i].Size );
+   // executing the init functions
+    if ( ServDescList[i].InitFunc(i) != True )
+      return FailedInit; // this is a failed initialization
+  }
+  return Success;
+}
+
+/****************************************************************************
+ Function
+   ES_Run
+ Parameters
+   None
+ Returns
+   ES_Return_t : FailedRun is any of the run functions failed during execution
+ Description
+   This is the main framework function. It searches through the state
+   machines to find one with a non-empty queue and then executes the
+   state machine to process the event in its queue.
+   while all the queues are empty, it searches for system generated or
+   user generated events.
+   Events that ISRs have posted to their rings (ES_ISRRing.c) are moved into
+   the queues before each search for the next service to run.
+   With ES_RUN_BATCH_SIZE above 1, it takes up to that many events from the
+   service's queue at once and runs them back to back, still letting any
+   higher priority service that becomes ready run between them.
+   With ES_TRACE, each dequeue and each run goes into the event trace.
+   With ES_PROFILE, each run is timed, as is the wait since its post, for
+   the dispatch profile.
+ Notes
    this function only returns in case of an error
  Author
    J. Edward Carryer, 10/23/11,
@@ -207,25 +1364,107 @@ ES_Return_t ES_Initialize( TimerRate_t NewRate ){
 ES_Return_t ES_Run( void ){
   // make these static to improve speed
   uint8_t HighestPrior;
+  uint8_t NumLeft;
+#if ES_RUN_BATCH_SIZE > 1
+  static ES_Event Batch[ES_RUN_BATCH_SIZE];
+  uint8_t NumInBatch;
+  uint8_t i;
+#if ES_PROFILE
+  static uint32_t Posted[ES_RUN_BATCH_SIZE];
+#endif
+#else
   static ES_Event ThisEvent;
+#endif
   
   while(1){ // stay here unless we detect an error condition
+#if NUM_ISR_RINGS > 0
+    ES_ISRRing_Drain(); // move anything the ISRs posted into the queues
+#endif
 
     // loop through the list executing the run functions for services
     // with a non-empty queue
-    while( Ready != 0){
-      HighestPrior =  Byte2MSBitNum[Ready-1];
-      if ( ES_DeQueue( EventQueues[HighestPrior].pMem, &ThisEvent ) == 0 ){
-        Ready &= BitNum2ClrMask[HighestPrior]; // mark queue as now empty
+    while( AnyReady() ){
+      HighestPrior = HighestReady();
+#if ES_RUN_BATCH_SIZE > 1
+      // take up to a batch of events in 1 critical region
+      NumInBatch = ES_DeQueueBatch( EventQueues[HighestPrior].pMem, Batch,
+                                    ES_RUN_BATCH_SIZE, &NumLeft );
+#if ES_TRACE
+      for ( i = 0; i < NumInBatch; i++ )
+        ES_TraceDeQueue( HighestPrior, Batch[i],
+                         (uint8_t)(NumLeft + NumInBatch - 1 - i) );
+#endif
+#if ES_PROFILE
+      // before RunHigherServices takes events of its own
+      for ( i = 0; i < NumInBatch; i++ )
+        Posted[i] = ES_QueryPostTime( i );
+#endif
+      if ( NumLeft == 0 ){
+        MarkNotReady(HighestPrior); // mark queue as now empty
+        // an ISR may have posted since the DeQueue, don't strand its event
+        if ( ES_IsQueueEmpty( EventQueues[HighestPrior].pMem ) == False )
+          MarkReady(HighestPrior);
       }
-      if( ServDescList[HighestPrior].RunFunc(ThisEvent).EventType != 
-                                                              ES_NO_EVENT) {
+      for ( i = 0; i < NumInBatch; i++ ){
+        // let any higher priority service that became ready run first
+        if ( (i != 0) && (RunHigherServices( HighestPrior ) == False) )
+          return FailedRun;
+        if( RunService(HighestPrior, Batch[i], Posted[i]).EventType !=
+            ES_NO_EVENT) {
               return FailedRun;
+        }
+#if NUM_ISR_RINGS > 0
+        ES_ISRRing_Drain(); // so the next pick sees what the ISRs posted
+#endif
       }
+#else
+      NumLeft = ES_DeQueue( EventQueues[HighestPrior].pMem, &ThisEvent );
+      ES_TraceDeQueue( HighestPrior, ThisEvent, NumLeft );
+      if ( NumLeft == 0 ){
+        MarkNotReady(HighestPrior); // mark queue as now empty
+        // an ISR may have posted since the DeQueue, don't strand its event
+        if ( ES_IsQueueEmpty( EventQueues[HighestPrior].pMem ) == False )
+          MarkReady(HighestPrior);
+      }
+      if( RunService(HighestPrior, ThisEvent,
+                     ES_QueryPostTime(0)).EventType != ES_NO_EVENT) {
+              return FailedRun;
+      }
+#if NUM_ISR_RINGS > 0
+      ES_ISRRing_Drain(); // so the next pick sees what the ISRs posted
+#endif
+#endif /* ES_RUN_BATCH_SIZE > 1 */
     }
 
+#if ES_QUEUE_STATS
+    if ( QueueStatsRequested == True ){ // print while nothing else is waiting
+      QueueStatsRequested = False;
+      PrintQueueStats();
+    }
+#endif
+#if ES_TRACE
+    if ( TraceDumpRequested == True ){ // likewise, the dump takes a while
+      TraceDumpRequested = False;
+      ES_Trace_Dump();
+    }
+#endif
+#if ES_PROFILE
+    if ( ProfileRequested == True ){ // and so does the profile
+      ProfileRequested = False;
+      ES_Profile_Print();
+    }
+#endif
+#if ES_CHECK_STATS
+    if ( CheckStatsRequested == True ){ // and the event checker counts
+      CheckStatsRequested = False;
+      ES_PrintCheckStats();
+    }
+#endif
+
     // all the queues are empty, so look for new system or user detected events
+#ifndef KEY_RING
     if (CheckSystemEvents() == False)
+#endif
       ES_CheckUserEvents();
   }
 }
@@ -250,9 +1489,11 @@ boolean ES_PostAll( ES_Event ThisEvent){
   // loop through the list executing the post functions
   for ( i=0; i< ARRAY_SIZE(EventQueues); i++) {
     if ( ES_EnQueueFIFO( EventQueues[i].pMem, ThisEvent ) != True ){
+      ES_TraceDrop( i, ThisEvent, ES_QueueCount( EventQueues[i].pMem ) );
       break; // this is a failed post
     }else{
-      Ready |= BitNum2SetMask[i]; // show queue as non-empty
+      MarkReady(i); // show queue as non-empty
+      ES_TracePost( i, ThisEvent, ES_QueueCount( EventQueues[i].pMem ) );
     }
   }
   if ( i == ARRAY_SIZE(EventQueues) ){ // if no failures
@@ -273,24 +1514,348 @@ boolean ES_PostAll( ES_Event ThisEvent){
  Description
    posts to one of the services' queues
  Notes
-   used by the timer library to associate a timer with a state machine
+   used by the timer library to associate a timer with a state machine.
+   With ES_RECORD every post that is taken or lost goes into the log for
+   Host/Replay
  Author
    J. Edward Carryer, 01/16/12,
 ****************************************************************************/
 boolean ES_PostToService( uint8_t WhichService, ES_Event TheEvent){
-  if ((WhichService < ARRAY_SIZE(EventQueues)) &&
-      (ES_EnQueueFIFO( EventQueues[WhichService].pMem, TheEvent) == 
-                                                                True )){
-    Ready |= BitNum2SetMask[WhichService]; // show queue as non-empty
-    return True;
-  } else
+  return PostToService( WhichService, TheEvent, False );
+}
+
+/****************************************************************************
+ Function
+   ES_PostFromRing
+ Parameters
+   uint8_t : Which service to post to (index into ServDescList)
+   ES_Event : The Event to be posted
+ Returns
+   boolean : False if the service's queue was full
+ Description
+   posts to one of the services' queues for ES_ISRRing_Drain
+ Notes
+   a post that does not fit is neither traced nor logged as dropped: the
+   ring keeps the event and tries it again, and it is logged once it fits
+ Author
+   Alex Loo, 10/18/26, 16:00
+****************************************************************************/
+boolean ES_PostFromRing( uint8_t WhichService, ES_Event TheEvent){
+  return PostToService( WhichService, TheEvent, True );
+}
+
+#if ES_QUEUE_STATS
+/****************************************************************************
+ Function
+   ES_QueryServiceQueue
+ Parameters
+   uint8_t : which service's queue to ask about
+   ES_QueueStats_t * : used to return the queue's statistics
+ Returns
+   boolean : False if there is no such service
+ Description
+   high water mark, posts, drops and longest wait for a service's queue
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 18:24
+****************************************************************************/
+boolean ES_QueryServiceQueue( uint8_t WhichService, ES_QueueStats_t *pStats ){
+  if ( WhichService >= ARRAY_SIZE(EventQueues) )
     return False;
+  ES_QueryQueueStats( EventQueues[WhichService].pMem, pStats );
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_ClearAllQueueStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   starts the statistics of every service's queue over
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 18:26
+****************************************************************************/
+void ES_ClearAllQueueStats( void ){
+  unsigned char i;
+  for ( i=0; i< ARRAY_SIZE(EventQueues); i++)
+    ES_ClearQueueStats( EventQueues[i].pMem );
+}
+
+/****************************************************************************
+ Function
+   ES_RequestQueueStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   asks ES_Run to print the statistics of every queue the next time that
+   it finds all of the queues empty
+ Notes
+   safe to call from an ISR, it only sets a flag
+ Author
+   Alex Loo, 10/17/26, 18:28
+****************************************************************************/
+void ES_RequestQueueStats( void ){
+  QueueStatsRequested = True;
+}
+#endif
+
+#if ES_TRACE
+/****************************************************************************
+ Function
+   ES_RequestTraceDump
+ Parameters
+   None
+ Returns
+   None
+ Description
+   asks ES_Run to dump the event trace (ES_Trace_Dump) the next time that
+   it finds all of the queues empty
+ Notes
+   safe to call from an ISR, it only sets a flag
+ Author
+   Alex Loo, 10/18/26, 04:20
+****************************************************************************/
+void ES_RequestTraceDump( void ){
+  TraceDumpRequested = True;
+}
+#endif
+
+#if ES_PROFILE
+/****************************************************************************
+ Function
+   ES_RequestProfile
+ Parameters
+   None
+ Returns
+   None
+ Description
+   asks ES_Run to print the dispatch profile (ES_Profile_Print) the next
+   time that it finds all of the queues empty
+ Notes
+   safe to call from an ISR, it only sets a flag
+ Author
+   Alex Loo, 10/18/26, 06:28
+****************************************************************************/
+void ES_RequestProfile( void ){
+  ProfileRequested = True;
+}
+#endif
+
+#if ES_CHECK_STATS
+/****************************************************************************
+ Function
+   ES_RequestCheckStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   asks ES_Run to print the event checker counts (ES_PrintCheckStats) the
+   next time that it finds all of the queues empty
+ Notes
+   safe to call from an ISR, it only sets a flag
+ Author
+   Alex Loo, 10/18/26, 07:45
+****************************************************************************/
+void ES_RequestCheckStats( void ){
+  CheckStatsRequested = True;
 }
+#endif
+
+
+/****************************************************************************
+ Function
+   ES_PostKey
+ Parameters
+   ES_Event : ES_NEW_KEY, with the key in EventParam
+ Returns
+   boolean : False if the post failed
+ Description
+   turns the test keys into the events they stand for and posts the result
+   with pPostKeyFunc; any other key goes on as ES_NEW_KEY
+ Notes
+   the post function for KEY_RING, which the SCI0 ISR in termio.c posts
+   each key to. Without KEY_RING, CheckSystemEvents polls for keys
+ Author
+   Alex Loo, 10/18/26, 02:10
+****************************************************************************/
+boolean ES_PostKey( ES_Event ThisEvent ){
+   switch (ThisEvent.EventParam)
+   {
+      /*
+      case '1':
+         ThisEvent.EventType = ES_TIMEOUT;
+         ThisEvent.EventParam = 1;
+      break;
+      
+      case '2':
+         ThisEvent.EventType = ES_TIMEOUT;
+         ThisEvent.EventParam = 2;
+      break;
+      
+      case '3':
+         ThisEvent.EventType = ES_TIMEOUT;
+         ThisEvent.EventParam = 3;
+      break;
+      
+      case '4':
+         ThisEvent.EventType = ES_TIMEOUT;
+         ThisEvent.EventParam = 4;
+      break;
+      
+      case '5':
+         ThisEvent.EventType = ES_TIMEOUT;
+         ThisEvent.EventParam = 5;
+      break;
+      */
+      
+      case 'q':
+         ThisEvent.EventType = ES_LEFT_TAPE_DETECTED;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_LEFT_TAPE_DETECTED event.");
+      break;
+      
+      case 'w':
+         ThisEvent.EventType = ES_RIGHT_TAPE_DETECTED;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_RIGHT_TAPE_DETECTED event.");
+      break;
+      
+      case 'e':
+         ThisEvent.EventType = ES_FRONT_BUMPED;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_FRONT_BUMPED event.");
+      break;
+      
+      case 'r':
+         ThisEvent.EventType = ES_REAR_BUMPED;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_REAR_BUMPED event.");
+      break;
+      
+      case 't':
+         ThisEvent.EventType = ES_GAME_START;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_GAME_START event.");
+      break;
+      
+      case 'y':
+         ThisEvent.EventType = ES_BEACON_FRONT;
+         ThisEvent.EventParam = 3;
+         printf("\r\nPosting ES_BEACON_FRONT event.");
+      break;
+      
+      case 'u':
+         ThisEvent.EventType = ES_BEACON_REAR;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_BEACON_REAR event.");
+      break;
+      
+      case 'i':
+         ThisEvent.EventType = ES_BALL_BIN_EMPTY;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_BALL_BIN_EMPTY event.");
+      break;
+      
+      case 'p':
+         ThisEvent.EventType = ES_DANGERWALL_RIGHT;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_DANGERWALL_RIGHT event.");
+      break;
+      
+      case 'o':
+         ThisEvent.EventType = ES_DANGERWALL_LEFT;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_DANGERWALL_LEFT event.");
+      break;
+      
+      case 'l':
+         ThisEvent.EventType = ES_NO_DANGERWALL;
+         ThisEvent.EventParam = 1;
+         printf("\r\nPosting ES_NO_DANGERWALL event.");
+      break;
+#if ES_QUEUE_STATS
+      
+      case 's': // queue statistics, nothing to post
+         ES_RequestQueueStats();
+      return True;
+#endif
+#if ES_TRACE
 
+      case 'd': // dump the event trace, nothing to post
+         ES_RequestTraceDump();
+      return True;
+#endif
+#if ES_PROFILE
+
+      case 'm': // print the dispatch profile, nothing to post
+         ES_RequestProfile();
+      return True;
+#endif
+#if ES_CHECK_STATS
+
+      case 'c': // print the event checker counts, nothing to post
+         ES_RequestCheckStats();
+      return True;
+#endif
+   }
+   return (*pPostKeyFunc)( ThisEvent );
+}
 
 //*********************************
 // private functions
 //*********************************
+/****************************************************************************
+ Function
+   PostToService
+ Parameters
+   uint8_t : Which service to post to (index into ServDescList)
+   ES_Event : The Event to be posted
+   boolean FromRing : True for a post from ES_ISRRing_Drain
+ Returns
+   boolean : False if the service's queue was full
+ Description
+   ES_PostToService and ES_PostFromRing
+ Notes
+   the caller says whether the post comes from a ring, rather than this
+   asking whether a ring is being drained: an ISR may post while one is,
+   and its post is lost if it does not fit
+ Author
+   Alex Loo, 10/18/26, 16:00
+****************************************************************************/
+static boolean PostToService( uint8_t WhichService, ES_Event TheEvent,
+                              boolean FromRing ){
+  ES_EnQueueResult_t Result;
+
+  if ( WhichService >= ARRAY_SIZE(EventQueues) )
+    return False;
+  Result = ES_EnQueue( EventQueues[WhichService].pMem, TheEvent );
+  if ( Result != ES_QUEUE_FULL ){
+    MarkReady(WhichService); // show queue as non-empty
+    ES_TracePost( WhichService, TheEvent,
+                  ES_QueueCount( EventQueues[WhichService].pMem ) );
+    ES_LogPost( WhichService, TheEvent,
+                (Result == ES_QUEUE_REPLACED) ? ES_LOG_POST_REPLACED : 0 );
+    return True;
+  } else {
+    if ( FromRing == False ) {
+      ES_TraceDrop( WhichService, TheEvent,
+                    ES_QueueCount( EventQueues[WhichService].pMem ) );
+      ES_LogPost( WhichService, TheEvent, ES_LOG_POST_DROPPED );
+    }
+    return False;
+  }
+}
+
+#ifndef KEY_RING
 /****************************************************************************
  Function
    CheckSystemEvents
@@ -299,130 +1864,209 @@ boolean ES_PostToService( uint8_t WhichService, ES_Event TheEvent){
  Returns
    boolean : True if a system event was detected
  Description
-   check for system generated events and uses pPostKeyFunc to post to one
+   check for system generated events and uses ES_PostKey to post to one
    of the state machine's queues
  Notes
-   currently only tests for incoming keystrokes
+   currently only tests for incoming keystrokes. Only used without
+   KEY_RING, where nothing else brings the keys in
  Author
    J. Edward Carryer, 10/23/11, 
 ****************************************************************************/
 static boolean CheckSystemEvents( void ){
-  /*
   if ( kbhit() != 0 ) // new key waiting?
   {
     ES_Event ThisEvent;
     ThisEvent.EventType = ES_NEW_KEY;
     ThisEvent.EventParam = getchar();
-    (*pPostKeyFunc)( ThisEvent );
+    ES_PostKey( ThisEvent );
     return True;
-  } */
-  
-  if (kbhit() != 0) // new key waiting?
-   {
-      ES_Event ThisEvent; //create an event
-      uint16_t KeyboardInput = getchar(); // store keystroke
-      
-      // switch on the keyboard input
-      switch (KeyboardInput)
-      {
-         /*
-         case '1':
-            ThisEvent.EventType = ES_TIMEOUT;
-            ThisEvent.EventParam = 1;
-         break;
-         
-         case '2':
-            ThisEvent.EventType = ES_TIMEOUT;
-            ThisEvent.EventParam = 2;
-         break;
-         
-         case '3':
-            ThisEvent.EventType = ES_TIMEOUT;
-            ThisEvent.EventParam = 3;
-         break;
-         
-         case '4':
-            ThisEvent.EventType = ES_TIMEOUT;
-            ThisEvent.EventParam = 4;
-         break;
-         
-         case '5':
-            ThisEvent.EventType = ES_TIMEOUT;
-            ThisEvent.EventParam = 5;
-         break;
-         */
-         
-         case 'q':
-            ThisEvent.EventType = ES_LEFT_TAPE_DETECTED;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_LEFT_TAPE_DETECTED event.");
-         break;
-         
-         case 'w':
-            ThisEvent.EventType = ES_RIGHT_TAPE_DETECTED;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_RIGHT_TAPE_DETECTED event.");
-         break;
-         
-         case 'e':
-            ThisEvent.EventType = ES_FRONT_BUMPED;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_FRONT_BUMPED event.");
-         break;
-         
-         case 'r':
-            ThisEvent.EventType = ES_REAR_BUMPED;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_REAR_BUMPED event.");
-         break;
-         
-         case 't':
-            ThisEvent.EventType = ES_GAME_START;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_GAME_START event.");
-         break;
-         
-         case 'y':
-            ThisEvent.EventType = ES_BEACON_FRONT;
-            ThisEvent.EventParam = 3;
-            printf("\r\nPosting ES_BEACON_FRONT event.");
-         break;
-         
-         case 'u':
-            ThisEvent.EventType = ES_BEACON_REAR;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_BEACON_REAR event.");
-         break;
-         
-         case 'i':
-            ThisEvent.EventType = ES_BALL_BIN_EMPTY;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_BALL_BIN_EMPTY event.");
-         break;
-         
-         case 'p':
-            ThisEvent.EventType = ES_DANGERWALL_RIGHT;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_DANGERWALL_RIGHT event.");
-         break;
-         
-         case 'o':
-            ThisEvent.EventType = ES_DANGERWALL_LEFT;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_DANGERWALL_LEFT event.");
-         break;
-         
-         case 'l':
-            ThisEvent.EventType = ES_NO_DANGERWALL;
-            ThisEvent.EventParam = 1;
-            printf("\r\nPosting ES_NO_DANGERWALL event.");
-         break;
-      }
-      (*pPostKeyFunc)( ThisEvent );
-      return True;
-   }
+  }
   return False;
 }
+#endif
+
+#if ES_QUEUE_STATS
+/****************************************************************************
+ Function
+   PrintQueueStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   prints the statistics of every service's queue, and the drops from
+   every ISR ring, 1 line each
+ Notes
+   waits are in timer ticks
+ Author
+   Alex Loo, 10/17/26, 18:31
+****************************************************************************/
+static void PrintQueueStats( void ){
+  ES_QueueStats_t Stats;
+  unsigned char i;
+
+  printf("\r\nServ Size High      Posts Drops Coalesced MaxWait");
+  for ( i=0; i< ARRAY_SIZE(EventQueues); i++) {
+    ES_QueryQueueStats( EventQueues[i].pMem, &Stats );
+    printf("\r\n%4u %4u %4u %10lu %5u %9u %7u", i, Stats.QueueSize,
+           Stats.HighWater, (unsigned long)Stats.Posts, Stats.Drops,
+           Stats.Coalesced, Stats.MaxTicksQueued);
+  }
+#if NUM_ISR_RINGS > 0
+  for ( i=0; i< NUM_ISR_RINGS; i++)
+    printf("\r\nISR ring %u drops %u", i, ES_ISRRing_QueryDrops(i));
+#endif
+}
+#endif
+
+#if ES_RUN_BATCH_SIZE > 1
+/****************************************************************************
+ Function
+   RunHigherServices
+ Parameters
+   uint8_t : the priority of the service whose batch is being run
+ Returns
+   boolean : False if a run function returned an error
+ Description
+   runs the services above Priority, 1 event at a time, until none of them
+   has an event waiting
+ Notes
+   ES_Run calls this between the events of a batch, so that a batch never
+   holds up a higher priority service for longer than 1 event
+ Author
+   Alex Loo, 10/17/26, 17:18
+****************************************************************************/
+static boolean RunHigherServices( uint8_t Priority ){
+  uint8_t HighestPrior;
+  uint8_t NumLeft;
+  static ES_Event ThisEvent;
+
+  while ( AnyReady() && ((HighestPrior = HighestReady()) > Priority) ){
+    NumLeft = ES_DeQueue( EventQueues[HighestPrior].pMem, &ThisEvent );
+    ES_TraceDeQueue( HighestPrior, ThisEvent, NumLeft );
+    if ( NumLeft == 0 ){
+      MarkNotReady(HighestPrior);
+      if ( ES_IsQueueEmpty( EventQueues[HighestPrior].pMem ) == False )
+        MarkReady(HighestPrior);
+    }
+    if( RunService(HighestPrior, ThisEvent,
+                   ES_QueryPostTime(0)).EventType != ES_NO_EVENT)
+      return False;
+#if NUM_ISR_RINGS > 0
+    ES_ISRRing_Drain();
+#endif
+  }
+  return True;
+}
+#endif
+
+#if ES_TRACE || ES_PROFILE
+/****************************************************************************
+ Function
+   MeasuredRun
+ Parameters
+   uint8_t : the service to run
+   ES_Event : the event to run it on
+   uint32_t : the fine time that the event was posted
+ Returns
+   ES_Event : what the service's run function returned
+ Description
+   runs the service, with a trace record as it starts and as it ends, and
+   adds the run time and the wait since the post to the profile
+ Notes
+   RunService, when ES_TRACE or ES_PROFILE is set
+ Author
+   Alex Loo, 10/18/26, 04:25
+****************************************************************************/
+static ES_Event MeasuredRun( uint8_t WhichService, ES_Event ThisEvent,
+                             uint32_t Posted ){
+  ES_Event ReturnEvent;
+#if ES_PROFILE
+  uint32_t Started;
+#endif
+
+  ES_TraceStart( WhichService, ThisEvent );
+#if ES_PROFILE
+  Started = ES_Timer_GetFineTime();
+#else
+  (void)Posted;
+#endif
+  ReturnEvent = ServDescList[WhichService].RunFunc( ThisEvent );
+#if ES_PROFILE
+  ES_Profile_Record( WhichService, ThisEvent.EventType, Posted, Started,
+                     ES_Timer_GetFineTime() );
+#endif
+  ES_TraceEnd( WhichService, ThisEvent );
+  return ReturnEvent;
+}
+#endif
+
+#if MAX_NUM_SERVICES > 8
+/****************************************************************************
+ Function
+   HighestReadyService
+ Parameters
+   None
+ Returns
+   uint8_t : the highest priority service with a non-empty queue
+ Description
+   finds the highest priority group with a service ready, then the highest
+   priority service within that group
+ Notes
+   only call this when AnyReady() is True
+ Author
+   Alex Loo, 10/17/26, 13:20
+****************************************************************************/
+static uint8_t HighestReadyService( void ){
+  uint8_t Group;
+  Group = Byte2MSBitNum[ReadyGroups-1];
+  return (uint8_t)((Group << 3) + Byte2MSBitNum[Ready[Group]-1]);
+}
+
+/****************************************************************************
+ Function
+   MarkServiceReady
+ Parameters
+   uint8_t : the service whose queue is now non-empty
+ Returns
+   None
+ Description
+   sets the service's bit in its group and the group's bit in ReadyGroups
+ Notes
+   the two bytes are updated with ints off, since posts come from ISRs too
+ Author
+   Alex Loo, 10/17/26, 13:24
+****************************************************************************/
+static void MarkServiceReady( uint8_t WhichService ){
+  EnterCritical();
+  Ready[WhichService >> 3] |= BitNum2SetMask[WhichService & 0x07];
+  ReadyGroups |= BitNum2SetMask[WhichService >> 3];
+  ExitCritical();
+}
+
+/****************************************************************************
+ Function
+   MarkServiceNotReady
+ Parameters
+   uint8_t : the service whose queue is now empty
+ Returns
+   None
+ Description
+   clears the service's bit in its group, and the group's bit in ReadyGroups
+   if that was the last service ready in the group
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 13:27
+****************************************************************************/
+static void MarkServiceNotReady( uint8_t WhichService ){
+  EnterCritical();
+  Ready[WhichService >> 3] &= BitNum2ClrMask[WhichService & 0x07];
+  if ( Ready[WhichService >> 3] == 0 )
+    ReadyGroups &= BitNum2ClrMask[WhichService >> 3];
+  ExitCritical();
+}
+#endif
 
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
@@ -8,6 +8,12 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 16:00 adl      ES_PostFromRing
+ 10/18/26 07:45 adl      ES_RequestCheckStats
+ 10/18/26 06:28 adl      ES_RequestProfile
+ 10/18/26 04:20 adl      ES_RequestTraceDump
+ 10/18/26 02:10 adl      ES_PostKey
+ 10/17/26 18:20 adl      queue statistics
  10/17/06 07:41 jec      started coding
 *****************************************************************************/
 
@@ -18,6 +24,8 @@
 #include "ES_General.h"
 #include "ES_Events.h"
 #include "ES_Timers.h"
+#include "ES_Queue.h"
+#include "ES_CheckEvents.h"
 
 typedef enum {
               Success = 0,
@@ -32,5 +40,22 @@ ES_Return_t ES_Initialize( TimerRate_t NewRate  );
 ES_Return_t ES_Run( void );
 boolean ES_PostAll( ES_Event ThisEvent );
 boolean ES_PostToService( uint8_t WhichService, ES_Event ThisEvent);
+// for ES_ISRRing_Drain only: a post that does not fit is not a drop
+boolean ES_PostFromRing( uint8_t WhichService, ES_Event ThisEvent );
+boolean ES_PostKey( ES_Event ThisEvent );
+#if ES_QUEUE_STATS
+boolean ES_QueryServiceQueue( uint8_t WhichService, ES_QueueStats_t *pStats );
+void ES_ClearAllQueueStats( void );
+void ES_RequestQueueStats( void );
+#endif
+#if ES_TRACE
+void ES_RequestTraceDump( void );
+#endif
+#if ES_PROFILE
+void ES_RequestProfile( void );
+#endif
+#if ES_CHECK_STATS
+void ES_RequestCheckStats( void );
+#endif
 
 #endif   // ES_Framework_H
@@ -0,0 +1,298 @@
+/****************************************************************************
+ Module
+     ES_ISRRing.c
+ Description
+     Single producer, single consumer rings that carry events from ISRs to
+     the services. Each ISR that posts events owns 1 ring and fills it with
+     ES_ISRRing_Post. ES_Run empties the rings through ES_ISRRing_Drain,
+     handing each event to the service or the post function named for that
+     ring in ES_Configure.h.
+ Notes
+     The ISR only writes Head and the ring entries, ES_Run only writes Tail,
+     so neither end needs interrupts off. Head and Tail run freely from 0 to
+     255, their difference is the number of entries in the ring, and the
+     ring size (a power of 2) picks the entry with a mask.
+
+     A ring has a single producer: only ISRs that cannot interrupt one
+     another may post to it. On the S12 that is any ISRs, since it does not
+     nest interrupts, so one sensor's ISRs can share a ring to keep their
+     events in order. On the host, only 1 thread may post to a ring.
+
+     Events keep their order within a ring. Events from different rings are
+     handed on ring by ring, ring 0 first, not in the order that they arrived.
+
+     A ring with a service (ISR_RINGn_SERVICE) posts through ES_PostFromRing,
+     which does not log a post that does not fit as dropped, since the ring
+     keeps the event and tries it again. A ring with a post function
+     (ISR_RINGn_POST_FUNC) posts through it like anyone else, so a post
+     that does not fit is logged as dropped each time it is tried.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:00 adl      a ring may name its service, to post through
+                         ES_PostFromRing; no more ES_ISRRing_IsDraining
+ 10/18/26 15:00 adl      ES_ISRRing_IsDraining, so a post the ring will try
+                         again is not taken as lost
+ 10/18/26 14:40 adl      ISRs that cannot interrupt each other may share a ring
+ 10/18/26 02:10 adl      rings may post to the framework's own post functions
+ 10/17/26 15:20 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_PostList.h"
+#include "ES_Framework.h"    // ES_PostKey, ES_PostAll
+#include "ES_ServiceHeaders.h"
+#include "ES_ISRRing.h"
+
+#if NUM_ISR_RINGS > 0
+// the endif for NUM_ISR_RINGS > 0 is at the end of the file
+
+/*----------------------------- Module Defines ----------------------------*/
+#if NUM_ISR_RINGS > 8
+#error NUM_ISR_RINGS must be 8 or less
+#endif
+#if (ISR_RING_SIZE > 128) || (ISR_RING_SIZE & (ISR_RING_SIZE-1))
+#error ISR_RING_SIZE must be a power of 2 no larger than 128
+#endif
+
+#define ISR_RING_MASK (ISR_RING_SIZE-1)
+
+// a ring's Service when it posts with its post function
+#define NO_RING_SERVICE 0xFF
+
+#ifdef ISR_RING0_SERVICE
+#define RING0_DEST { (pPostFunc)0, ISR_RING0_SERVICE }
+#else
+#define RING0_DEST { ISR_RING0_POST_FUNC, NO_RING_SERVICE }
+#endif
+#ifdef ISR_RING1_SERVICE
+#define RING1_DEST { (pPostFunc)0, ISR_RING1_SERVICE }
+#else
+#define RING1_DEST { ISR_RING1_POST_FUNC, NO_RING_SERVICE }
+#endif
+#ifdef ISR_RING2_SERVICE
+#define RING2_DEST { (pPostFunc)0, ISR_RING2_SERVICE }
+#else
+#define RING2_DEST { ISR_RING2_POST_FUNC, NO_RING_SERVICE }
+#endif
+#ifdef ISR_RING3_SERVICE
+#define RING3_DEST { (pPostFunc)0, ISR_RING3_SERVICE }
+#else
+#define RING3_DEST { ISR_RING3_POST_FUNC, NO_RING_SERVICE }
+#endif
+#ifdef ISR_RING4_SERVICE
+#define RING4_DEST { (pPostFunc)0, ISR_RING4_SERVICE }
+#else
+#define RING4_DEST { ISR_RING4_POST_FUNC, NO_RING_SERVICE }
+#endif
+#ifdef ISR_RING5_SERVICE
+#define RING5_DEST { (pPostFunc)0, ISR_RING5_SERVICE }
+#else
+#define RING5_DEST { ISR_RING5_POST_FUNC, NO_RING_SERVICE }
+#endif
+#ifdef ISR_RING6_SERVICE
+#define RING6_DEST { (pPostFunc)0, ISR_RING6_SERVICE }
+#else
+#define RING6_DEST { ISR_RING6_POST_FUNC, NO_RING_SERVICE }
+#endif
+#ifdef ISR_RING7_SERVICE
+#define RING7_DEST { (pPostFunc)0, ISR_RING7_SERVICE }
+#else
+#define RING7_DEST { ISR_RING7_POST_FUNC, NO_RING_SERVICE }
+#endif
+
+/*------------------------------ Module Types -----------------------------*/
+typedef struct {
+    volatile uint8_t Head;   // next entry to fill, written only by the ISR
+    volatile uint8_t Tail;   // next entry to empty, written only by ES_Run
+    volatile uint16_t Drops; // posts lost to a full ring, written by the ISR
+    ES_Event Entries[ISR_RING_SIZE];
+} ISRRing_t;
+
+// where a ring's events go: to Service through ES_PostFromRing, or if it
+// is NO_RING_SERVICE, to PostFunc
+typedef struct {
+    pPostFunc PostFunc;
+    uint8_t Service;
+} RingDest_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static boolean HandOn( const RingDest_t *pDest, ES_Event ThisEvent );
+
+/*---------------------------- Module Variables ---------------------------*/
+static ISRRing_t Rings[NUM_ISR_RINGS];
+
+static RingDest_t const Ring2Dest[NUM_ISR_RINGS] = {
+  RING0_DEST
+#if NUM_ISR_RINGS > 1
+, RING1_DEST
+#endif
+#if NUM_ISR_RINGS > 2
+, RING2_DEST
+#endif
+#if NUM_ISR_RINGS > 3
+, RING3_DEST
+#endif
+#if NUM_ISR_RINGS > 4
+, RING4_DEST
+#endif
+#if NUM_ISR_RINGS > 5
+, RING5_DEST
+#endif
+#if NUM_ISR_RINGS > 6
+, RING6_DEST
+#endif
+#if NUM_ISR_RINGS > 7
+, RING7_DEST
+#endif
+};
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_ISRRing_Init
+ Parameters
+   None
+ Returns
+   None
+ Description
+   empties all of the rings and clears their drop counts
+ Notes
+   called from ES_Initialize, before any of the ISRs are enabled
+ Author
+   Alex Loo, 10/17/26, 15:28
+****************************************************************************/
+void ES_ISRRing_Init( void )
+{
+  uint8_t i;
+
+  for ( i = 0; i < ARRAY_SIZE(Rings); i++ ) {
+    Rings[i].Head = 0;
+    Rings[i].Tail = 0;
+    Rings[i].Drops = 0;
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_ISRRing_Post
+ Parameters
+   uint8_t WhichRing : the ring that belongs to the calling ISR
+   ES_Event ThisEvent : the event to post
+ Returns
+   boolean : False if the ring was full (or there is no such ring)
+ Description
+   adds ThisEvent to the ring, for ES_Run to hand on to the ring's service
+ Notes
+   for use from the ring's ISR only, see the module notes
+ Author
+   Alex Loo, 10/17/26, 15:34
+****************************************************************************/
+boolean ES_ISRRing_Post( uint8_t WhichRing, ES_Event ThisEvent )
+{
+  ISRRing_t *pRing;
+  uint8_t Head;
+
+  if ( WhichRing >= ARRAY_SIZE(Rings) )
+    return False;
+  pRing = &Rings[WhichRing];
+  Head = pRing->Head; // only we write Head, no need to order this read
+  if ( (uint8_t)(Head - ES_Port_LoadAcquire(pRing->Tail)) >= ISR_RING_SIZE ) {
+    pRing->Drops++;
+    return False;
+  }
+  pRing->Entries[Head & ISR_RING_MASK] = ThisEvent;
+  // the entry must be in place before ES_Run can see the new Head
+  ES_Port_StoreRelease( pRing->Head, (uint8_t)(Head + 1) );
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_ISRRing_Drain
+ Parameters
+   None
+ Returns
+   None
+ Description
+   hands every event waiting in the rings to the rings' services or post
+   functions
+ Notes
+   called from ES_Run. If a post fails (the service's queue is full), the
+   event stays at the front of its ring and is tried again on the next call,
+   once the service has had a chance to empty its queue.
+ Author
+   Alex Loo, 10/17/26, 15:41
+****************************************************************************/
+void ES_ISRRing_Drain( void )
+{
+  ISRRing_t *pRing;
+  uint8_t Head;
+  uint8_t Tail;
+  uint8_t i;
+
+  for ( i = 0; i < ARRAY_SIZE(Rings); i++ ) {
+    pRing = &Rings[i];
+    Tail = pRing->Tail; // only we write Tail
+    Head = ES_Port_LoadAcquire( pRing->Head );
+    if ( Head == Tail )
+      continue; // nothing waiting, the usual case
+    while ( (Tail != Head) &&
+            (HandOn( &Ring2Dest[i], pRing->Entries[Tail & ISR_RING_MASK] )
+                                                                   == True) )
+      Tail++;
+    // the entries must be read out before the ISR can see them freed
+    ES_Port_StoreRelease( pRing->Tail, Tail );
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_ISRRing_QueryDrops
+ Parameters
+   uint8_t WhichRing : the ring to ask about
+ Returns
+   uint16_t : the number of posts lost because the ring was full
+ Description
+   for sizing ISR_RING_SIZE
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 15:47
+****************************************************************************/
+uint16_t ES_ISRRing_QueryDrops( uint8_t WhichRing )
+{
+  if ( WhichRing >= ARRAY_SIZE(Rings) )
+    return 0;
+  return Rings[WhichRing].Drops;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   HandOn
+ Parameters
+   const RingDest_t * pDest : where the ring's events go
+   ES_Event ThisEvent : the event at the front of the ring
+ Returns
+   boolean : False if it did not fit, and stays in the ring
+ Description
+   posts the event to the ring's service or with its post function
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 16:00
+****************************************************************************/
+static boolean HandOn( const RingDest_t *pDest, ES_Event ThisEvent )
+{
+  if ( pDest->Service != NO_RING_SERVICE )
+    return ES_PostFromRing( pDest->Service, ThisEvent );
+  return pDest->PostFunc( ThisEvent );
+}
+
+#endif /* NUM_ISR_RINGS > 0 */
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,27 @@
+/****************************************************************************
+ Module
+     ES_ISRRing.h
+ Description
+     header file for the rings that carry events from ISRs to ES_Run
+     without turning interrupts off
+ Notes
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:00 adl      ES_ISRRing_IsDraining gone, see ES_PostFromRing
+ 10/18/26 15:00 adl      added ES_ISRRing_IsDraining
+ 10/17/26 15:20 adl      started coding
+*****************************************************************************/
+#ifndef ES_ISRRing_H
+#define ES_ISRRing_H
+
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+void    ES_ISRRing_Init( void );
+boolean ES_ISRRing_Post( uint8_t WhichRing, ES_Event ThisEvent );
+void    ES_ISRRing_Drain( void );
+uint16_t ES_ISRRing_QueryDrops( uint8_t WhichRing );
+
+#endif /* ES_ISRRing_H */
@@ -0,0 +1,53 @@
+/****************************************************************************
+ Module
+     ES_Instance.h
+ Description
+     the macros that let a state machine keep its variables in a context
+     struct, one per instance, and still build as a single instance with
+     no pointer passed around
+ Notes
+     A machine puts its variables in a struct (GatheringSM_t, say), and
+     every function that uses them names the instance Me:
+        ES_Event RunGatheringSM( ES_ME_(GatheringSM_t) ES_Event ThisEvent )
+        {
+           ... Me->CurrentState ...
+        }
+     and calls them with
+        RunGatheringSM( ES_WITH_(pGathering) ThisEvent );
+     With ES_INSTANCES 0 (the default, and the firmware) ES_ME_ and
+     ES_WITH_ come to nothing, so the functions are the ones they always
+     were, and the machine defines Me as the address of its only instance:
+        static GatheringSM_t TheGatheringSM = GATHERING_SM_INIT;
+        #define Me (&TheGatheringSM)
+     Me->CurrentState is then a fixed address, as a file-scope static was.
+     With ES_INSTANCES 1 Me is the first parameter, and any number of
+     instances can run side by side in one program.
+
+     ES_ME and ES_WITH are for a function with no other parameters.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 10:30 adl      started coding
+*****************************************************************************/
+#ifndef ES_Instance_H
+#define ES_Instance_H
+
+#include "ES_Configure.h"
+
+#ifndef ES_INSTANCES
+#define ES_INSTANCES 0
+#endif
+
+#if ES_INSTANCES
+#define ES_ME(Type)    Type *Me
+#define ES_ME_(Type)   Type *Me,
+#define ES_WITH(p)     p
+#define ES_WITH_(p)    p,
+#else
+#define ES_ME(Type)    void
+#define ES_ME_(Type)
+#define ES_WITH(p)
+#define ES_WITH_(p)
+#endif
+
+#endif /* ES_Instance_H */
@@ -0,0 +1,239 @@
+/****************************************************************************
+ Module
+     ES_Log.c
+ Description
+     The deferred log. The state machines write small binary records (see
+     ES_Log.h) into a RAM ring with the ES_Log* macros, which costs a few
+     byte copies, and the SCI transmit interrupt sends them out a byte at a
+     time in the background. So a busy machine no longer waits on the
+     serial port the way it did on printf, at about 87 uS a character.
+     The SCI0 ISR in termio.c takes the bytes with ES_Log_NextByte.
+ Notes
+     Records are written only from ES_Run's side, never from an ISR, and
+     only the transmit ISR reads them: Head is written only by
+     ES_Log_Write, Tail only by ES_Log_NextByte, so neither needs interrupts
+     off, as for the ISR rings. A record that does not fit is dropped whole
+     and counted, so the stream never holds part of a record.
+
+     The ISR turns its interrupt off when it has nothing to send,
+     ES_Log_Write turns it back on (ES_Port_StartSCI0Tx) once the record is
+     in place. printf text shares the port: the ISR sends it only between
+     records (ES_Log_InRecord False), so text never splits a record.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 11:20 adl      ES_Log_Post, and writes from ISRs with ES_RECORD
+ 10/18/26 02:00 adl      ES_Log_NextByte in place of ES_Log_TxISR, the SCI0 ISR
+                         in termio.c shares the port with printf
+ 10/18/26 01:00 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "ES_Log.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#ifndef ES_LOG_SIZE
+#define ES_LOG_SIZE 128
+#endif
+#if (ES_LOG_SIZE > 128) || (ES_LOG_SIZE & (ES_LOG_SIZE-1)) || \
+    (ES_LOG_SIZE < ES_LOG_RECORD_SIZE)
+#error ES_LOG_SIZE must be a power of 2, from 16 to 128
+#endif
+
+#define ES_LOG_MASK (ES_LOG_SIZE-1)
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint8_t Ring[ES_LOG_SIZE];
+static volatile uint8_t Head;   // next byte to fill, written by ES_Log_Write
+static volatile uint8_t Tail;   // next byte to send, written by the ISR
+static uint16_t Drops;          // records lost to a full ring
+#if ES_RECORD
+static uint8_t Posts;           // POST records written, and lost
+#endif
+// bytes of the current record already sent, 0 between records
+static volatile uint8_t TxPlace;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_Log_Init
+ Parameters
+   None
+ Returns
+   None
+ Description
+   empties the log and clears its drop count
+ Notes
+   called from ES_Initialize, before the transmit interrupt is on
+ Author
+   Alex Loo, 10/18/26, 01:05
+****************************************************************************/
+void ES_Log_Init( void )
+{
+  Head = 0;
+  Tail = 0;
+  TxPlace = 0;
+  Drops = 0;
+#if ES_RECORD
+  Posts = 0;
+#endif
+}
+
+/****************************************************************************
+ Function
+   ES_Log_Write
+ Parameters
+   ES_LogKind_t Kind : what the record says
+   uint8_t Source : which machine wrote it
+   uint8_t State : the state it was in
+   uint8_t Code : the event type, or for a note what it is about
+   uint16_t Param : the event parameter, or the note's value
+ Returns
+   None
+ Description
+   adds a record, stamped with ES_Timer_GetTime, to the log and makes sure
+   the transmit interrupt is on to send it
+ Notes
+   use the ES_Log* macros, which compile out below their ES_LOG_LEVEL. Not
+   for use from an ISR unless ES_RECORD is set, see the module notes
+ Author
+   Alex Loo, 10/18/26, 01:08
+****************************************************************************/
+void ES_Log_Write( ES_LogKind_t Kind, uint8_t Source, uint8_t State,
+                   uint8_t Code, uint16_t Param )
+{
+  uint8_t Record[ES_LOG_RECORD_SIZE];
+  uint16_t Now;
+  uint8_t Place;
+  uint8_t Check = 0;
+  uint8_t i;
+
+#if ES_RECORD
+  EnterCritical(); // an ISR's post may write a record too
+  // a post's count is taken here, so that the counts go out in order
+  if ( Kind == ES_LOG_KIND_POST )
+    State = Posts++;
+#endif
+  Now = ES_Timer_GetTime();
+  Place = Head; // only we write Head
+  if ( (uint8_t)(Place - ES_Port_LoadAcquire(Tail)) >
+       ES_LOG_SIZE - ES_LOG_RECORD_SIZE ) {
+    Drops++;
+  } else {
+    Record[0] = ES_LOG_SYNC;
+    Record[1] = (uint8_t)(Now >> 8);
+    Record[2] = (uint8_t)Now;
+    Record[3] = (uint8_t)Kind;
+    Record[4] = Source;
+    Record[5] = State;
+    Record[6] = Code;
+    Record[7] = (uint8_t)(Param >> 8);
+    Record[8] = (uint8_t)Param;
+    for ( i = 1; i < ES_LOG_RECORD_SIZE - 1; i++ )
+      Check += Record[i];
+    Record[ES_LOG_RECORD_SIZE - 1] = (uint8_t)(0 - Check);
+
+    for ( i = 0; i < ES_LOG_RECORD_SIZE; i++ )
+      Ring[(uint8_t)(Place + i) & ES_LOG_MASK] = Record[i];
+    // the record must be in place before the ISR can see the new Head
+    ES_Port_StoreRelease( Head, (uint8_t)(Place + ES_LOG_RECORD_SIZE) );
+    ES_Port_StartSCI0Tx();
+  }
+#if ES_RECORD
+  ExitCritical();
+#endif
+}
+
+#if ES_RECORD
+/****************************************************************************
+ Function
+   ES_Log_Post
+ Parameters
+   uint8_t Source : the service posted to, with its ES_LOG_POST_ flags
+   ES_Event ThisEvent : the event posted
+ Returns
+   None
+ Description
+   adds a POST record, with the count of posts before it in its state byte
+ Notes
+   use ES_LogPost, from ES_PostToService. A post that does not fit in the
+   ring is still counted, so the replay sees the gap
+ Author
+   Alex Loo, 10/18/26, 11:22
+****************************************************************************/
+void ES_Log_Post( uint8_t Source, ES_Event ThisEvent )
+{
+  // ES_Log_Write puts in the count
+  ES_Log_Write( ES_LOG_KIND_POST, Source, 0, (uint8_t)ThisEvent.EventType,
+                ThisEvent.EventParam );
+}
+#endif
+
+/****************************************************************************
+ Function
+   ES_Log_NextByte
+ Parameters
+   uint8_t * pByte : where to put the byte
+ Returns
+   boolean : False if the log is empty
+ Description
+   takes the next byte of the log to send
+ Notes
+   called from the SCI0 ISR when the transmit data register is empty
+ Author
+   Alex Loo, 10/18/26, 01:12
+****************************************************************************/
+boolean ES_Log_NextByte( uint8_t *pByte )
+{
+  uint8_t Next = Tail; // only we write Tail
+
+  if ( Next == ES_Port_LoadAcquire(Head) )
+    return False;
+  *pByte = Ring[Next & ES_LOG_MASK];
+  TxPlace = (TxPlace == ES_LOG_RECORD_SIZE - 1) ? 0 : (uint8_t)(TxPlace + 1);
+  // the byte must be read out before ES_Log_Write can see it freed
+  ES_Port_StoreRelease( Tail, (uint8_t)(Next + 1) );
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_Log_InRecord
+ Parameters
+   None
+ Returns
+   boolean : True if part of a record has gone out and the rest has not
+ Description
+   lets the SCI0 ISR keep other bytes out of a record
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 01:15
+****************************************************************************/
+boolean ES_Log_InRecord( void )
+{
+  return (TxPlace != 0) ? True : False;
+}
+
+/****************************************************************************
+ Function
+   ES_Log_QueryDrops
+ Parameters
+   None
+ Returns
+   uint16_t : the number of records lost because the log was full
+ Description
+   for sizing ES_LOG_SIZE, or choosing a lower ES_LOG_LEVEL
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 01:16
+****************************************************************************/
+uint16_t ES_Log_QueryDrops( void )
+{
+  return Drops;
+}
+/*------------------------------ End of file ------------------------------*/
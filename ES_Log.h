@@ -0,0 +1,109 @@
+/****************************************************************************
+ Module
+     ES_Log.h
+ Description
+     header file for the deferred log: compact binary records kept in a RAM
+     ring and sent out on the SCI by its transmit interrupt
+ Notes
+     ES_LOG_LEVEL in ES_Configure.h picks which of the ES_Log* macros write
+     records; the rest compile to nothing.
+
+     A record is ES_LOG_RECORD_SIZE bytes:
+       ES_LOG_SYNC, time (ticks, high byte first), kind, source, state,
+       event type or note code, param (high byte first), check
+     where the check makes the bytes after ES_LOG_SYNC sum to 0.
+
+     With ES_RECORD set to 1, ES_PostToService also writes a POST record for
+     every event posted to a service, so that a capture of the log, with the
+     ENTRY and EXIT records, can be replayed on the host (Host/Replay.c).
+     Its source is the service with the ES_LOG_POST_ flags, its state counts
+     the posts, so that a lost record shows, and the rest is the event.
+     Posts come from ISRs too, so with ES_RECORD every record is written
+     with interrupts off.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 11:20 adl      POST records, for record and replay (ES_RECORD)
+ 10/18/26 02:00 adl      ES_Log_NextByte, termio.c's SCI0 ISR does the sending
+ 10/18/26 01:00 adl      started coding
+*****************************************************************************/
+#ifndef ES_Log_H
+#define ES_Log_H
+
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+// the log levels, each keeps what the ones below it keep
+#define ES_LOG_OFF    0
+#define ES_LOG_NOTES  1   // ES_LogNote
+#define ES_LOG_STATES 2   // and ES_LogEntry, ES_LogExit
+#define ES_LOG_EVENTS 3   // and ES_LogEvent, every event a machine runs
+
+#ifndef ES_LOG_LEVEL
+#define ES_LOG_LEVEL ES_LOG_OFF
+#endif
+
+#ifndef ES_RECORD
+#define ES_RECORD 0
+#endif
+#if ES_RECORD && (ES_LOG_LEVEL < ES_LOG_STATES)
+#error ES_RECORD needs ES_LOG_LEVEL ES_LOG_STATES or above, for the replay
+#endif
+
+#define ES_LOG_SYNC 0xA5
+#define ES_LOG_RECORD_SIZE 10
+
+// what a record says
+typedef enum { ES_LOG_KIND_NOTE,
+               ES_LOG_KIND_ENTRY,
+               ES_LOG_KIND_EXIT,
+               ES_LOG_KIND_EVENT,
+               ES_LOG_KIND_POST } ES_LogKind_t;
+
+// a POST record's source is the service, with these flags
+#define ES_LOG_POST_DROPPED  0x80  // the queue was full, the event is lost
+#define ES_LOG_POST_REPLACED 0x40  // it took a pending event's place
+#define ES_LOG_POST_SERVICE(Source) ((Source) & 0x3F)
+
+#if ES_LOG_LEVEL >= ES_LOG_NOTES
+#define ES_LogNote(Source, Code, Value) \
+   ES_Log_Write(ES_LOG_KIND_NOTE, (Source), 0, (Code), (Value))
+#else
+#define ES_LogNote(Source, Code, Value) ((void)0)
+#endif
+
+#if ES_LOG_LEVEL >= ES_LOG_STATES
+#define ES_LogEntry(Source, State) \
+   ES_Log_Write(ES_LOG_KIND_ENTRY, (Source), (State), ES_ENTRY, 0)
+#define ES_LogExit(Source, State) \
+   ES_Log_Write(ES_LOG_KIND_EXIT, (Source), (State), ES_EXIT, 0)
+#else
+#define ES_LogEntry(Source, State) ((void)0)
+#define ES_LogExit(Source, State) ((void)0)
+#endif
+
+#if ES_LOG_LEVEL >= ES_LOG_EVENTS
+#define ES_LogEvent(Source, State, ThisEvent) \
+   ES_Log_Write(ES_LOG_KIND_EVENT, (Source), (State), \
+                (ThisEvent).EventType, (ThisEvent).EventParam)
+#else
+#define ES_LogEvent(Source, State, ThisEvent) ((void)(ThisEvent))
+#endif
+
+#if ES_RECORD
+#define ES_LogPost(Service, ThisEvent, Flags) \
+   ES_Log_Post((uint8_t)((Service) | (Flags)), (ThisEvent))
+#else
+#define ES_LogPost(Service, ThisEvent, Flags) ((void)0)
+#endif
+
+void     ES_Log_Init( void );
+void     ES_Log_Write( ES_LogKind_t Kind, uint8_t Source, uint8_t State,
+                       uint8_t Code, uint16_t Param );
+void     ES_Log_Post( uint8_t Source, ES_Event ThisEvent );
+boolean  ES_Log_NextByte( uint8_t *pByte );
+boolean  ES_Log_InRecord( void );
+uint16_t ES_Log_QueryDrops( void );
+
+#endif /* ES_Log_H */
@@ -1,6 +1,14 @@
 #ifndef PORT_H
 #define PORT_H
 
+#ifndef ES_HOST_BUILD
+/****************************************************************************/
+// MC9S12E128 target
+
+#include <hidef.h>         /* common defines and macros */
+#include <mc9s12e128.h>     /* derivative information */
+#include <S12E128bits.h>    /* bit definitions  */
+
 // these macros provide the wrappers for critical regions, where ints will be off
 // but the state of the interrupt enable prior to entry will be restored.
 extern unsigned char _CCR_temp;
@@ -8,5 +16,91 @@ extern unsigned char _CCR_temp;
 #define EnterCritical()     { __asm pshc; __asm sei; __asm movb 1,SP+,_CCR_temp; } /* This macro saves CCR register and disables global interrupts. */
 #define ExitCritical()  { __asm movb _CCR_temp, 1,-SP ; __asm pulc; } /* This macro restores CCR register saved EnterCritical(). */
 
+// the RTI that drives the timer subsystem is interrupt vector 7
+#define ES_RTI_VECTOR interrupt 7
+
+// set the RTI rate, clear any pending int, enable the RTI int and make sure
+// that interrupts are enabled
+#define ES_Port_InitRTI(Rate) { RTICTL = (unsigned char)(Rate); \
+                                CRGFLG = _S12_RTIF;             \
+                                CRGINT |= _S12_RTIE;            \
+                                EnableInterrupts; }
+
+// clear the source of the RTI int
+#define ES_Port_ClearRTI()  { CRGFLG = _S12_RTIF; }
+
+// the indices of the ISR rings are shared by 1 ISR and ES_Run. On the S12 a
+// byte load or store cannot be interrupted, and the indices are volatile, so
+// plain accesses are enough
+#define ES_Port_LoadAcquire(Var)          (Var)
+#define ES_Port_StoreRelease(Var, Value)  { (Var) = (Value); }
+
+// the fine timebase (ES_Timer_GetFineTime) counts the free running TIM0
+// counter. QS_Initialize sets its prescale to 8, so off the 24 MHz bus clock
+// it runs at 3 counts per us and wraps every 21.8 ms. The TIM0 overflow ISR
+// must call ES_Timer_FineOverflow before it clears TOF
+#define ES_PORT_FINE_PER_US 3
+#define ES_Port_ReadFreeRunning()     (TIM0_TCNT)
+#define ES_Port_FreeRunningWrapped()  ((TIM0_TFLG2 & _S12_TOF) != 0)
+
+// the deferred log (ES_Log.c) and printf share SCI0. Whoever adds bytes to
+// send turns on the transmit empty interrupt, and the SCI0 ISR in termio.c
+// turns it off again once it has nothing left to send
+#define ES_Port_StartSCI0Tx()  { SCI0CR2 |= _S12_TIE; }
+#define ES_Port_StopSCI0Tx()   { SCI0CR2 &= ~_S12_TIE; }
+
+// copy the CCR into a byte variable. Out of reset, and in a critical
+// region, its I bit is set and no ISR can run
+#define ES_PORT_CCR_I  0x10
+#define ES_Port_ReadCCR(Var)   { __asm tfr ccr,b; __asm stab Var; }
+
+#else
+/****************************************************************************/
+// Linux host build, the functions live in Host/ES_HostPort.c
+
+// There are no interrupts on the host. The RTI is simulated by calling
+// ES_Port_Tick from the same thread that runs ES_Run, so a critical region
+// has nothing to mask. We count the entries so the benchmarks can report them.
+extern unsigned long ES_Port_CriticalCount;
+
+#define EnterCritical()  { ES_Port_CriticalCount++; }
+#define ExitCritical()
+
+#define ES_RTI_VECTOR
+
+void ES_Port_InitRTI( unsigned char Rate );
+#define ES_Port_ClearRTI()
+
+// run the RTI response once, as if 1 RTI period had elapsed
+void ES_Port_Tick( void );
+
+// host programs may stand in for an ISR with a thread, so the ISR ring
+// indices need the ordering that the S12 gives for free
+#define ES_Port_LoadAcquire(Var)  __atomic_load_n( &(Var), __ATOMIC_ACQUIRE )
+#define ES_Port_StoreRelease(Var, Value) \
+                     { __atomic_store_n( &(Var), (Value), __ATOMIC_RELEASE ); }
+
+// a simulated free running counter at the target's 3 counts per us.
+// ES_Port_Tick moves it on by 1 RTI period and runs its overflow "ISR" if it
+// wrapped. ES_Port_AdvanceFreeRunning moves it on without running the ISR,
+// to leave a wrap pending the way an ISR held off by a critical region would
+#define ES_PORT_FINE_PER_US 3
+unsigned int ES_Port_ReadFreeRunning( void );
+int ES_Port_FreeRunningWrapped( void );
+void ES_Port_AdvanceFreeRunning( unsigned int Counts );
+void ES_Port_FreeRunningISR( void );
+
+// the SCI0 transmit interrupt enable. Host/SCISim.c runs termio.c's SCI0
+// ISR, from a thread, while it is set; host programs without SCISim look at
+// it themselves
+extern volatile int ES_Port_SCI0TxOn;
+void ES_Port_StartSCI0Tx( void );
+void ES_Port_StopSCI0Tx( void );
+
+// the host has no I bit: the ISRs that threads stand in for always run
+#define ES_PORT_CCR_I  0x10
+#define ES_Port_ReadCCR(Var)   { (Var) = 0; }
+
+#endif /* ES_HOST_BUILD */
 
 #endif
@@ -20,7 +20,9 @@
 #include "ES_ServiceHeaders.h"
 
 /*---------------------------- Module Functions ---------------------------*/
+#if NUM_DIST_LISTS > 0
 static boolean PostToList(  PostFunc_t *const*FuncList, unsigned char ListSize, ES_Event NewEvent);
+#endif
 
 /*---------------------------- Module Variables ---------------------------*/
 // Fill in these arrays with the lists of posting funcitons for the state
@@ -0,0 +1,326 @@
+/****************************************************************************
+ Module
+     ES_Profile.c
+ Description
+     The dispatch profile. ES_Run hands it, for every event it dispatches,
+     the fine time the event was posted (ES_QueryPostTime), the time the
+     run function was called and the time it returned. It keeps the count,
+     min, max and total of the run time and of the wait for each service and
+     each event type, and a log2 histogram of each for each service, so that
+     the handlers that blow the latency budget stand out.
+ Notes
+     Only ES_Run records and only it, or code it runs, should query or
+     clear, so nothing here turns interrupts off.
+
+     The run time of a service includes everything its run function calls:
+     the MasterMachine's includes the sub-machine that it passes the event
+     to, and the per event type figures split that up.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 06:02 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_LookupTables.h"
+#include "ES_Profile.h"
+
+#if ES_PROFILE
+// the endif for ES_PROFILE is at the end of the file
+
+/*---------------------------- Module Functions ---------------------------*/
+static void Add( ES_ProfileStat_t *pStat, uint32_t Time );
+static void Count( uint16_t *pBins, uint32_t Time );
+static void PrintStat( const ES_ProfileStat_t *pStat );
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_ServiceProfile_t Services[NUM_SERVICES];
+static ES_EventProfile_t Events[ES_PROFILE_NUM_EVENTS];
+// all 0, for clearing
+static ES_ServiceProfile_t const NoService;
+static ES_EventProfile_t const NoEvent;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_Profile_Clear
+ Parameters
+   None
+ Returns
+   None
+ Description
+   starts the profile over, for instance at the start of a match
+ Notes
+   ES_Initialize calls it
+ Author
+   Alex Loo, 10/18/26, 06:04
+****************************************************************************/
+void ES_Profile_Clear( void )
+{
+  uint8_t i;
+
+  for ( i = 0; i < ARRAY_SIZE(Services); i++ )
+    Services[i] = NoService;
+  for ( i = 0; i < ARRAY_SIZE(Events); i++ )
+    Events[i] = NoEvent;
+}
+
+/****************************************************************************
+ Function
+   ES_Profile_Record
+ Parameters
+   uint8_t WhichService : the service that ran
+   ES_EventTyp_t EventType : the event it ran
+   uint32_t Posted : when the event was posted
+   uint32_t Started : when the run function was called
+   uint32_t Ended : when it returned
+ Returns
+   None
+ Description
+   adds 1 dispatch to the profile of the service and of the event type
+ Notes
+   times are ES_Timer_GetFineTime counts; the differences are right
+   across its wrap
+ Author
+   Alex Loo, 10/18/26, 06:06
+****************************************************************************/
+void ES_Profile_Record( uint8_t WhichService, ES_EventTyp_t EventType,
+                        uint32_t Posted, uint32_t Started, uint32_t Ended )
+{
+  ES_ServiceProfile_t *pServ = &Services[WhichService];
+  uint32_t Run = Ended - Started;
+  uint32_t Wait = Started - Posted;
+
+  Add( &pServ->Run, Run );
+  Add( &pServ->Wait, Wait );
+  Count( pServ->RunBins, Run );
+  Count( pServ->WaitBins, Wait );
+  if ( (unsigned)EventType < ES_PROFILE_NUM_EVENTS ) {
+    Add( &Events[EventType].Run, Run );
+    Add( &Events[EventType].Wait, Wait );
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_Profile_QueryService
+ Parameters
+   uint8_t WhichService : the service to ask about
+   ES_ServiceProfile_t * pProfile : used to return a copy of its profile
+ Returns
+   boolean : False if there is no such service
+ Description
+   see above
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:08
+****************************************************************************/
+boolean ES_Profile_QueryService( uint8_t WhichService,
+                                 ES_ServiceProfile_t *pProfile )
+{
+  if ( WhichService >= ARRAY_SIZE(Services) )
+    return False;
+  *pProfile = Services[WhichService];
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_Profile_QueryEvent
+ Parameters
+   ES_EventTyp_t EventType : the event type to ask about
+   ES_EventProfile_t * pProfile : used to return a copy of its profile
+ Returns
+   boolean : False if the type is not profiled (ES_PROFILE_NUM_EVENTS)
+ Description
+   see above
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:09
+****************************************************************************/
+boolean ES_Profile_QueryEvent( ES_EventTyp_t EventType,
+                               ES_EventProfile_t *pProfile )
+{
+  if ( (unsigned)EventType >= ES_PROFILE_NUM_EVENTS )
+    return False;
+  *pProfile = Events[EventType];
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_Profile_BinStart
+ Parameters
+   uint8_t Bin : a histogram bin
+ Returns
+   uint32_t : the shortest time, in fine counts, that goes in that bin
+ Description
+   for labelling the histograms
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:10
+****************************************************************************/
+uint32_t ES_Profile_BinStart( uint8_t Bin )
+{
+  if ( Bin == 0 )
+    return 0;
+  return (uint32_t)1 << (Bin + ES_PROFILE_BIN0_LOG2 - 1);
+}
+
+/****************************************************************************
+ Function
+   ES_Profile_Print
+ Parameters
+   None
+ Returns
+   None
+ Description
+   prints, in uS, the run time and wait of each service and of each event
+   type that has run, then each service's histograms
+ Notes
+   takes a while on the S12, so ES_Run calls it when all of the queues are
+   empty, after ES_RequestProfile
+ Author
+   Alex Loo, 10/18/26, 06:14
+****************************************************************************/
+void ES_Profile_Print( void )
+{
+  uint8_t i;
+  uint8_t Bin;
+
+  printf("\r\n           Count  Run uS: min    mean     max"
+         " Wait uS: min    mean     max");
+  for ( i = 0; i < ARRAY_SIZE(Services); i++ ) {
+    printf("\r\nServ  %2u %7lu", i, (unsigned long)Services[i].Run.Count);
+    PrintStat( &Services[i].Run );
+    PrintStat( &Services[i].Wait );
+  }
+  for ( i = 0; i < ARRAY_SIZE(Events); i++ ) {
+    if ( Events[i].Run.Count == 0 )
+      continue;
+    printf("\r\nEvent %2u %7lu", i, (unsigned long)Events[i].Run.Count);
+    PrintStat( &Events[i].Run );
+    PrintStat( &Events[i].Wait );
+  }
+  printf("\r\nuS from   ");
+  for ( Bin = 0; Bin < ES_PROFILE_BINS; Bin++ )
+    printf(" %5lu", (unsigned long)(ES_Profile_BinStart( Bin ) /
+                                    ES_PORT_FINE_PER_US));
+  for ( i = 0; i < ARRAY_SIZE(Services); i++ ) {
+    printf("\r\nRun   %2u ", i);
+    for ( Bin = 0; Bin < ES_PROFILE_BINS; Bin++ )
+      printf(" %5u", Services[i].RunBins[Bin]);
+    printf("\r\nWait  %2u ", i);
+    for ( Bin = 0; Bin < ES_PROFILE_BINS; Bin++ )
+      printf(" %5u", Services[i].WaitBins[Bin]);
+  }
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   Add
+ Parameters
+   ES_ProfileStat_t * pStat : the figures to add to
+   uint32_t Time : a run time or a wait
+ Returns
+   None
+ Description
+   counts it, keeps the min and max, and adds it to the total
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:16
+****************************************************************************/
+static void Add( ES_ProfileStat_t *pStat, uint32_t Time )
+{
+  if ( (pStat->Count == 0) || (Time < pStat->Min) )
+    pStat->Min = Time;
+  if ( Time > pStat->Max )
+    pStat->Max = Time;
+  pStat->Count++;
+  if ( pStat->Total > 0xFFFFFFFFUL - Time )
+    pStat->Total = 0xFFFFFFFFUL;
+  else
+    pStat->Total += Time;
+}
+
+/****************************************************************************
+ Function
+   Count
+ Parameters
+   uint16_t * pBins : the histogram
+   uint32_t Time : a run time or a wait
+ Returns
+   None
+ Description
+   counts it in its log2 bin
+ Notes
+   the log2 is the highest bit set, found a byte at a time with
+   Byte2MSBitNum
+ Author
+   Alex Loo, 10/18/26, 06:18
+****************************************************************************/
+static void Count( uint16_t *pBins, uint32_t Time )
+{
+  uint8_t Log2;
+  uint8_t Bin;
+
+  if ( (Time >> 24) != 0 )
+    Log2 = (uint8_t)(24 + Byte2MSBitNum[(uint8_t)(Time >> 24) - 1]);
+  else if ( (Time >> 16) != 0 )
+    Log2 = (uint8_t)(16 + Byte2MSBitNum[(uint8_t)(Time >> 16) - 1]);
+  else if ( (Time >> 8) != 0 )
+    Log2 = (uint8_t)(8 + Byte2MSBitNum[(uint8_t)(Time >> 8) - 1]);
+  else if ( Time != 0 )
+    Log2 = Byte2MSBitNum[(uint8_t)Time - 1];
+  else
+    Log2 = 0;
+
+  if ( Log2 < ES_PROFILE_BIN0_LOG2 )
+    Bin = 0;
+  else if ( Log2 - ES_PROFILE_BIN0_LOG2 + 1 >= ES_PROFILE_BINS )
+    Bin = ES_PROFILE_BINS - 1;
+  else
+    Bin = (uint8_t)(Log2 - ES_PROFILE_BIN0_LOG2 + 1);
+  if ( pBins[Bin] != 0xFFFF )
+    pBins[Bin]++;
+}
+
+/****************************************************************************
+ Function
+   PrintStat
+ Parameters
+   const ES_ProfileStat_t * pStat : the figures to print
+ Returns
+   None
+ Description
+   min, mean and max in uS
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:20
+****************************************************************************/
+static void PrintStat( const ES_ProfileStat_t *pStat )
+{
+  uint32_t Mean = 0;
+
+  if ( pStat->Count != 0 )
+    Mean = pStat->Total / pStat->Count;
+  printf("     %7lu %7lu %7lu",
+         (unsigned long)(pStat->Min / ES_PORT_FINE_PER_US),
+         (unsigned long)(Mean / ES_PORT_FINE_PER_US),
+         (unsigned long)(pStat->Max / ES_PORT_FINE_PER_US));
+}
+
+#endif /* ES_PROFILE */
+/*------------------------------ End of file ------------------------------*/
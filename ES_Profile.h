@@ -0,0 +1,74 @@
+/****************************************************************************
+ Module
+     ES_Profile.h
+ Description
+     header file for the dispatch profile: how long each service's run
+     function takes on each event, and how long the event waited in the
+     queue before it, per service and per event type
+ Notes
+     ES_PROFILE in ES_Configure.h turns the profile on; with it 0 (the
+     default) none of this is compiled in.
+
+     Times are ES_Timer_GetFineTime counts, ES_PORT_FINE_PER_US to a
+     microsecond. Each service also keeps a log2 histogram of each: bin 0
+     counts times under 2^ES_PROFILE_BIN0_LOG2, each bin after it covers
+     twice the range of the one before, and the last bin counts everything
+     longer.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 06:00 adl      started coding
+*****************************************************************************/
+#ifndef ES_Profile_H
+#define ES_Profile_H
+
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+#ifndef ES_PROFILE
+#define ES_PROFILE 0
+#endif
+
+// event types below this are profiled by type as well as by service
+#ifndef ES_PROFILE_NUM_EVENTS
+#define ES_PROFILE_NUM_EVENTS 32
+#endif
+
+// 16 bins from under 16 counts (5 uS) to 2^18 counts (87 mS) and over
+#define ES_PROFILE_BINS 16
+#define ES_PROFILE_BIN0_LOG2 4
+
+typedef struct {
+   uint32_t Count;
+   uint32_t Min;
+   uint32_t Max;
+   uint32_t Total;   // stops at 0xFFFFFFFF, 23.8 minutes at 3 counts a uS
+} ES_ProfileStat_t;
+
+typedef struct {
+   ES_ProfileStat_t Run;    // time in the run function
+   ES_ProfileStat_t Wait;   // time in the queue, from the post to the run
+} ES_EventProfile_t;
+
+typedef struct {
+   ES_ProfileStat_t Run;
+   ES_ProfileStat_t Wait;
+   uint16_t RunBins[ES_PROFILE_BINS];   // each stops at 0xFFFF
+   uint16_t WaitBins[ES_PROFILE_BINS];
+} ES_ServiceProfile_t;
+
+#if ES_PROFILE
+void    ES_Profile_Clear( void );
+void    ES_Profile_Record( uint8_t WhichService, ES_EventTyp_t EventType,
+                           uint32_t Posted, uint32_t Started,
+                           uint32_t Ended );
+boolean ES_Profile_QueryService( uint8_t WhichService,
+                                 ES_ServiceProfile_t *pProfile );
+boolean ES_Profile_QueryEvent( ES_EventTyp_t EventType,
+                               ES_EventProfile_t *pProfile );
+uint32_t ES_Profile_BinStart( uint8_t Bin );
+void    ES_Profile_Print( void );
+#endif
+
+#endif /* ES_Profile_H */
@@ -8,6 +8,19 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 16:40 adl      a masks only build no longer shrinks a queue to a
+                         power of 2, ES_Framework.c refuses the size
+ 10/18/26 15:15 adl      mask or modulo indexing picked at compile time
+                         (ES_QUEUE_INDEXING)
+ 10/18/26 15:00 adl      added ES_EnQueue, the room check moved into the
+                         critical region
+ 10/18/26 05:55 adl      entries stamped with the fine time of their post, for
+                         the dispatch profile (ES_PROFILE)
+ 10/18/26 04:10 adl      added ES_QueueCount, for the event trace
+ 10/17/26 19:10 adl      latest value wins posting (COALESCE_EVENT_LIST)
+ 10/17/26 18:00 adl      added the queue statistics (ES_QUEUE_STATS)
+ 10/17/26 17:00 adl      added ES_DeQueueBatch
+ 10/17/26 14:10 adl      added power of 2 queues indexed with a mask
  01/15/12 09:34 jec      converted to use the new C99 types from types.h
  08/09/11 18:16 jec      started coding
 *****************************************************************************/
@@ -15,22 +28,83 @@
 #include "ES_Configure.h"
 #include "ES_Queue.h"
 #include "ES_Port.h"
+#include "ES_Timers.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 // QueueSize is max number of entries in the queue
 // CurrentIndex is the 'read-from' index,
 // actually CurrentIndex + sizeof(EF_Queue_t)
 // entries are made to CurrentIndex + NumEntries + sizeof(ES_Queue_t)
+// IndexMask is QueueSize-1 for a power of 2 queue, 0 for any other queue.
+// The struct must still fit in 1 ES_Event (4 bytes on the S12)
 typedef struct {  unsigned char QueueSize;
                   unsigned char CurrentIndex;
                   unsigned char NumEntries;
+                  unsigned char IndexMask;
 } ES_Queue_t;
 
 typedef ES_Queue_t * pQueue_t;
 
+// wrap an index that may have run up to 2*QueueSize-1 back into the queue,
+// and step one on by 1 entry. A build with only 1 kind of queue (see
+// ES_QUEUE_INDEXING in ES_Queue.h) wraps them the one way with no test;
+// the modulo kind steps with a compare, not a divide
+#if ES_QUEUE_INDEXING == ES_QUEUE_MASK
+#define WRAP(pQ, Index)  ((uint8_t)((Index) & (pQ)->IndexMask))
+#define NEXT(pQ, Index)  ((uint8_t)(((Index) + 1) & (pQ)->IndexMask))
+#elif ES_QUEUE_INDEXING == ES_QUEUE_MODULO
+#define WRAP(pQ, Index)  ((uint8_t)((Index) % (pQ)->QueueSize))
+#define NEXT(pQ, Index)  \
+        ((uint8_t)(((Index) + 1 < (pQ)->QueueSize) ? (Index) + 1 : 0))
+#else
+#define WRAP(pQ, Index)  (((pQ)->IndexMask != 0) ? \
+        (uint8_t)((Index) & (pQ)->IndexMask) :   \
+        (uint8_t)((Index) % (pQ)->QueueSize))
+#define NEXT(pQ, Index)  (((pQ)->IndexMask != 0) ?     \
+        (uint8_t)(((Index) + 1) & (pQ)->IndexMask) :    \
+        (uint8_t)(((Index) + 1 < (pQ)->QueueSize) ? (Index) + 1 : 0))
+#endif
+
+#if ES_QUEUE_STATS
+// with statistics the block is laid out as: the queue header, the
+// ES_QueueStats_t, the entries, then 1 time stamp for each entry
+#define FIRST_ENTRY (1 + ES_QUEUE_STATS_EVENTS)
+#define STATS(pBlock) ((ES_QueueStats_t *)((pBlock) + 1))
+#define STAMPS(pBlock) ((uint16_t *)((pBlock) + FIRST_ENTRY + \
+                                     ((pQueue_t)(pBlock))->QueueSize))
+#else
+// the entries follow the queue header
+#define FIRST_ENTRY 1
+#endif
+
+#if ES_PROFILE
+// the post time of each entry comes after everything else in the block
+#define POSTED(pBlock) ((uint32_t *)((pBlock) + 1 + \
+             ((pQueue_t)(pBlock))->QueueSize + \
+             ES_QUEUE_STATS_ROOM(((pQueue_t)(pBlock))->QueueSize)))
+#endif
+
 /*---------------------------- Module Functions ---------------------------*/
+#if ES_QUEUE_STATS
+static void RecordPost( ES_Event * pBlock, uint8_t Index );
+static void RecordDeQueue( ES_Event * pBlock, uint8_t Index );
+#endif
+#ifdef COALESCE_EVENT_LIST
+static boolean IsLatestWins( ES_EventTyp_t EventType );
+static boolean ReplacePending( ES_Event * pBlock, ES_Event Event2Add,
+                               uint32_t Posted );
+#endif
 
 /*---------------------------- Module Variables ---------------------------*/
+#ifdef COALESCE_EVENT_LIST
+// the event types for which only the latest posting matters
+static ES_EventTyp_t const LatestWinsList[] = { COALESCE_EVENT_LIST };
+#endif
+
+#if ES_PROFILE
+// when the events that the latest DeQueue took were posted
+static uint32_t TakenPosted[ES_QUEUE_MAX_TAKEN];
+#endif
 
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
@@ -49,6 +123,11 @@ typedef ES_Queue_t * pQueue_t;
    ES_Event (at 4 bytes; 2 enum, 2 param) is greater than the 
    sizeof(ES_Queue_t), you only need to declare an array of ES_Event
    with 1 more element than you need for the actual queue.
+   With ES_QUEUE_STATS or ES_PROFILE the block needs more room, declare it with
+   ES_QUEUE_BLOCK_SIZE(entries) elements to be sure.
+   In a build whose queues are all power of 2 queues (ES_QUEUE_INDEXING is
+   ES_QUEUE_MASK) the queue must be a power of 2, as ES_Framework.c checks
+   for the services' queues.
  Author
    J. Edward Carryer, 08/09/11, 18:40
 ****************************************************************************/
@@ -59,8 +138,53 @@ uint8_t ES_InitQueue( ES_Event * pBlock, unsigned char BlockSize )
    pThisQueue = (pQueue_t)pBlock;
    // use all but the structure overhead as the Queue
    pThisQueue->QueueSize = BlockSize - 1;
+#if ES_QUEUE_STATS || ES_PROFILE
+   // less the statistics, and as many entries as fit with their time stamps
+   while ( ES_QUEUE_BLOCK_SIZE(pThisQueue->QueueSize) > BlockSize )
+      pThisQueue->QueueSize--;
+#endif
    pThisQueue->CurrentIndex = 0;
    pThisQueue->NumEntries = 0;
+#if ES_QUEUE_INDEXING == ES_QUEUE_MASK
+   pThisQueue->IndexMask = pThisQueue->QueueSize - 1;
+#else
+   pThisQueue->IndexMask = 0;
+#endif
+#if ES_QUEUE_STATS
+   ES_ClearQueueStats( pBlock );
+#endif
+   return(pThisQueue->QueueSize);
+}
+
+/****************************************************************************
+ Function
+   ES_InitQueuePow2
+ Parameters
+   EF_Event * pBlock : pointer to the block of memory to use for the Queue
+   unsigned char BlockSize: size of the block pointed to by pBlock
+ Returns
+   max number of entries in the created queue
+ Description
+   Initializes a queue whose size is a power of 2. EnQueue and DeQueue wrap
+   its indices with a mask rather than a modulo, which keeps the time spent
+   with interrupts off shorter.
+ Notes
+   the block must be 1 ES_Event larger than the (power of 2) queue, just as
+   for ES_InitQueue. If the queue size is not a power of 2, this sets up an
+   ordinary queue. A build with no power of 2 service queue indexes every
+   queue with a modulo (ES_QUEUE_INDEXING), this one too.
+ Author
+   Alex Loo, 10/17/26, 14:15
+****************************************************************************/
+uint8_t ES_InitQueuePow2( ES_Event * pBlock, unsigned char BlockSize )
+{
+   pQueue_t pThisQueue;
+
+   ES_InitQueue( pBlock, BlockSize );
+   pThisQueue = (pQueue_t)pBlock;
+   // a power of 2 has only 1 bit set, so ANDing with 1 less than it gives 0
+   if ( (pThisQueue->QueueSize & (pThisQueue->QueueSize - 1)) == 0 )
+      pThisQueue->IndexMask = pThisQueue->QueueSize - 1;
    return(pThisQueue->QueueSize);
 }
 
@@ -75,28 +199,78 @@ uint8_t ES_InitQueue( ES_Event * pBlock, unsigned char BlockSize )
  Description
    if it will fit, adds Event2Add to the Queue
  Notes
-
+   see ES_EnQueue
   Author
    J. Edward Carryer, 08/09/11, 18:59
 ****************************************************************************/
 boolean ES_EnQueueFIFO( ES_Event * pBlock, ES_Event Event2Add )
+{
+   return (boolean)(ES_EnQueue( pBlock, Event2Add ) != ES_QUEUE_FULL);
+}
+
+/****************************************************************************
+ Function
+   ES_EnQueue
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   ES_Event Event2Add : event to be added to the Queue
+ Returns
+   ES_EnQueueResult_t : ES_QUEUE_ADDED, ES_QUEUE_REPLACED if it took the
+   place of a pending event, or ES_QUEUE_FULL if it did not fit
+ Description
+   if it will fit, adds Event2Add to the Queue
+ Notes
+   an event whose type is in COALESCE_EVENT_LIST replaces the pending event
+   of the same type, if there is one, so it fits even in a full queue.
+   Whether it did is decided with ints off, so an ISR posting at the same
+   time cannot make the answer wrong.
+   With ES_PROFILE the entry is stamped with the fine time of the post
+  Author
+   Alex Loo, 10/18/26, 15:00
+****************************************************************************/
+ES_EnQueueResult_t ES_EnQueue( ES_Event * pBlock, ES_Event Event2Add )
 {
    pQueue_t pThisQueue;
+   uint8_t Index;
+#if ES_PROFILE
+   // read before the critical region, ES_Timer_GetFineTime has its own
+   uint32_t Posted = ES_Timer_GetFineTime();
+#elif defined(COALESCE_EVENT_LIST)
+   uint32_t Posted = 0;
+#endif
    pThisQueue = (pQueue_t)pBlock;
+#ifdef COALESCE_EVENT_LIST
+   if ( (IsLatestWins( Event2Add.EventType ) == True) &&
+        (ReplacePending( pBlock, Event2Add, Posted ) == True) )
+      return(ES_QUEUE_REPLACED);
+#endif
+   EnterCritical();   // save interrupt state, turn ints off
    // index will go from 0 to QueueSize-1 so use '<'
    if ( pThisQueue->NumEntries < pThisQueue->QueueSize)
-   {  // save the new event, use % to create circular buffer in block
-      // 1+ to step past the Queue struct at the beginning of the
+   {  // save the new event, WRAP the index to go round the block
+      // FIRST_ENTRY to step past the Queue struct at the beginning of the
       // block
-      EnterCritical();   // save interrupt state, turn ints off
-      pBlock[ 1 + ((pThisQueue->CurrentIndex + pThisQueue->NumEntries)
-               % pThisQueue->QueueSize)] = Event2Add;
+      Index = WRAP( pThisQueue,
+                    pThisQueue->CurrentIndex + pThisQueue->NumEntries );
+      pBlock[ FIRST_ENTRY + Index ] = Event2Add;
       pThisQueue->NumEntries++;          // inc number of entries
+#if ES_QUEUE_STATS
+      RecordPost( pBlock, Index );
+#endif
+#if ES_PROFILE
+      POSTED(pBlock)[Index] = Posted;
+#endif
       ExitCritical();  // restore saved interrupt state
       
-      return(True);
-   }else
-      return(False);
+      return(ES_QUEUE_ADDED);
+   }else {
+#if ES_QUEUE_STATS
+      STATS(pBlock)->Posts++;
+      STATS(pBlock)->Drops++;
+#endif
+      ExitCritical();
+      return(ES_QUEUE_FULL);
+   }
 }
 
 
@@ -125,12 +299,15 @@ uint8_t ES_DeQueue( ES_Event * pBlock, ES_Event * pReturnEvent )
    if ( pThisQueue->NumEntries > 0)
    {
       EnterCritical();   // save interrupt state, turn ints off
-      *pReturnEvent = pBlock[ 1 + pThisQueue->CurrentIndex ];
+      *pReturnEvent = pBlock[ FIRST_ENTRY + pThisQueue->CurrentIndex ];
+#if ES_QUEUE_STATS
+      RecordDeQueue( pBlock, pThisQueue->CurrentIndex );
+#endif
+#if ES_PROFILE
+      TakenPosted[0] = POSTED(pBlock)[pThisQueue->CurrentIndex];
+#endif
       // inc the index
-      pThisQueue->CurrentIndex++;
-      // this way we only do the modulo operation when we really need to
-      if (pThisQueue->CurrentIndex >=  pThisQueue->QueueSize)
-         pThisQueue->CurrentIndex = (unsigned char)(pThisQueue->CurrentIndex % pThisQueue->QueueSize);
+      pThisQueue->CurrentIndex = NEXT( pThisQueue, pThisQueue->CurrentIndex );
       //dec number of elements since we took 1 out
       NumLeft = --pThisQueue->NumEntries; 
       ExitCritical();  // restore saved interrupt state
@@ -142,6 +319,52 @@ uint8_t ES_DeQueue( ES_Event * pBlock, ES_Event * pReturnEvent )
    return NumLeft;
 }
 
+/****************************************************************************
+ Function
+   ES_DeQueueBatch
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   ES_Event * pReturnEvents : array to copy the events pulled from the queue
+   uint8_t MaxEvents : the most events to pull (size of pReturnEvents)
+   uint8_t * pNumLeft : used to return the entries remaining in the Queue
+ Returns
+   uint8_t : the number of events copied to pReturnEvents
+ Description
+   pulls up to MaxEvents entries from the Queue, oldest first, with a single
+   trip into a critical region
+ Notes
+   interrupts stay off while all of the events are copied, so keep
+   MaxEvents small
+ Author
+   Alex Loo, 10/17/26, 17:02
+****************************************************************************/
+uint8_t ES_DeQueueBatch( ES_Event * pBlock, ES_Event * pReturnEvents,
+                         uint8_t MaxEvents, uint8_t * pNumLeft )
+{
+   pQueue_t pThisQueue;
+   uint8_t NumTaken = 0;
+
+   pThisQueue = (pQueue_t)pBlock;
+   EnterCritical();   // save interrupt state, turn ints off
+   while ( (NumTaken < MaxEvents) && (pThisQueue->NumEntries > 0) )
+   {
+#if ES_PROFILE
+      if ( NumTaken < ES_QUEUE_MAX_TAKEN )
+         TakenPosted[NumTaken] = POSTED(pBlock)[pThisQueue->CurrentIndex];
+#endif
+      pReturnEvents[NumTaken++] = pBlock[ FIRST_ENTRY + pThisQueue->CurrentIndex ];
+#if ES_QUEUE_STATS
+      RecordDeQueue( pBlock, pThisQueue->CurrentIndex );
+#endif
+      // inc the index, wrapping with no divide in either kind of queue
+      pThisQueue->CurrentIndex = NEXT( pThisQueue, pThisQueue->CurrentIndex );
+      pThisQueue->NumEntries--;
+   }
+   *pNumLeft = pThisQueue->NumEntries;
+   ExitCritical();  // restore saved interrupt state
+   return NumTaken;
+}
+
 /****************************************************************************
  Function
    ES_IsQueueEmpty
@@ -164,6 +387,100 @@ boolean ES_IsQueueEmpty( ES_Event * pBlock )
    return(pThisQueue->NumEntries == 0);
 }
 
+/****************************************************************************
+ Function
+   ES_QueueCount
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+ Returns
+   uint8_t : the number of entries in the Queue
+ Description
+   see above
+ Notes
+   an ISR may post between this and anything the caller does with it
+ Author
+   Alex Loo, 10/18/26, 04:10
+****************************************************************************/
+uint8_t ES_QueueCount( ES_Event * pBlock )
+{
+   return ((pQueue_t)pBlock)->NumEntries;
+}
+
+#if ES_PROFILE
+/****************************************************************************
+ Function
+   ES_QueryPostTime
+ Parameters
+   uint8_t Which : which of the events the latest DeQueue took, 0 first
+ Returns
+   uint32_t : the fine time (ES_Timer_GetFineTime) that it was posted
+ Description
+   how long an event waited in its queue, for the dispatch profile
+ Notes
+   for the events taken by the latest ES_DeQueue or ES_DeQueueBatch from
+   any queue, up to ES_QUEUE_MAX_TAKEN of them, so read it straight after.
+   Only ES_Run takes events out of the queues
+ Author
+   Alex Loo, 10/18/26, 05:58
+****************************************************************************/
+uint32_t ES_QueryPostTime( uint8_t Which )
+{
+   return TakenPosted[Which];
+}
+#endif
+
+#if ES_QUEUE_STATS
+/****************************************************************************
+ Function
+   ES_QueryQueueStats
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   ES_QueueStats_t * pStats : used to return a copy of the statistics
+ Returns
+   nothing
+ Description
+   copies out the queue's statistics, all taken at the same moment
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 18:10
+****************************************************************************/
+void ES_QueryQueueStats( ES_Event * pBlock, ES_QueueStats_t * pStats )
+{
+   EnterCritical();
+   *pStats = *STATS(pBlock);
+   ExitCritical();
+}
+
+/****************************************************************************
+ Function
+   ES_ClearQueueStats
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+ Returns
+   nothing
+ Description
+   starts the queue's statistics over, for instance at the start of a match
+ Notes
+   the high water mark starts over from the entries in the queue right now
+ Author
+   Alex Loo, 10/17/26, 18:12
+****************************************************************************/
+void ES_ClearQueueStats( ES_Event * pBlock )
+{
+   ES_QueueStats_t *pStats = STATS(pBlock);
+
+   EnterCritical();
+   pStats->Posts = 0;
+   pStats->Drops = 0;
+   pStats->Coalesced = 0;
+   pStats->MaxTicksQueued = 0;
+   pStats->HighWater = ((pQueue_t)pBlock)->NumEntries;
+   pStats->QueueSize = ((pQueue_t)pBlock)->QueueSize;
+   ExitCritical();
+}
+#endif
+
 #if 0
 /****************************************************************************
  Function
@@ -195,6 +512,158 @@ void QueueFlushQueue( unsigned char * pBlock )
 /***************************************************************************
  private functions
  ***************************************************************************/
+#if ES_QUEUE_STATS
+/****************************************************************************
+ Function
+   RecordPost
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint8_t Index : the entry the new event went into
+ Returns
+   nothing
+ Description
+   counts the post, stamps the entry with the time and updates the high
+   water mark
+ Notes
+   called from ES_EnQueueFIFO with ints off
+ Author
+   Alex Loo, 10/17/26, 18:04
+****************************************************************************/
+static void RecordPost( ES_Event * pBlock, uint8_t Index )
+{
+   ES_QueueStats_t *pStats = STATS(pBlock);
+
+   pStats->Posts++;
+   STAMPS(pBlock)[Index] = ES_Timer_GetTime();
+   if ( ((pQueue_t)pBlock)->NumEntries > pStats->HighWater )
+      pStats->HighWater = ((pQueue_t)pBlock)->NumEntries;
+}
+
+/****************************************************************************
+ Function
+   RecordDeQueue
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   uint8_t Index : the entry being taken out
+ Returns
+   nothing
+ Description
+   keeps the longest time that any event has spent in the queue
+ Notes
+   called from the DeQueue functions with ints off
+ Author
+   Alex Loo, 10/17/26, 18:06
+****************************************************************************/
+static void RecordDeQueue( ES_Event * pBlock, uint8_t Index )
+{
+   uint16_t TicksQueued;
+
+   TicksQueued = (uint16_t)(ES_Timer_GetTime() - STAMPS(pBlock)[Index]);
+   if ( TicksQueued > STATS(pBlock)->MaxTicksQueued )
+      STATS(pBlock)->MaxTicksQueued = TicksQueued;
+}
+#endif
+
+#ifdef COALESCE_EVENT_LIST
+/****************************************************************************
+ Function
+   IsLatestWins
+ Parameters
+   ES_EventTyp_t EventType : the type of the event being posted
+ Returns
+   boolean : True if the type is in COALESCE_EVENT_LIST
+ Description
+   tells whether a new event of this type should replace a pending one
+ Notes
+   the list is short, so a search is quicker than it looks
+ Author
+   Alex Loo, 10/17/26, 19:12
+****************************************************************************/
+static boolean IsLatestWins( ES_EventTyp_t EventType )
+{
+   uint8_t i;
+
+   for ( i = 0; i < sizeof(LatestWinsList)/sizeof(LatestWinsList[0]); i++ )
+   {
+      if ( LatestWinsList[i] == EventType )
+         return(True);
+   }
+   return(False);
+}
+
+/****************************************************************************
+ Function
+   ReplacePending
+ Parameters
+   ES_Event * pBlock : pointer to the block of memory in use as the Queue
+   ES_Event Event2Add : event to be added to the Queue
+   uint32_t Posted : the fine time of the post, for ES_PROFILE
+ Returns
+   boolean : True if Event2Add replaced a pending event, False if there was
+             no pending event of its type
+ Description
+   takes the pending event of the same type out of the queue, moves the
+   events behind it up 1 entry and puts Event2Add at the end
+ Notes
+   The new event goes to the end, not into the old event's place, so that
+   the service sees it after every event that was posted before it (a lost
+   beacon after a bump that came earlier, say). The order of the other
+   events does not change.
+   EnQueueFIFO adds Event2Add the usual way when this returns False. An ISR
+   posting the same type between the two leaves 2 of them in the queue,
+   never 0.
+ Author
+   Alex Loo, 10/17/26, 19:15
+****************************************************************************/
+static boolean ReplacePending( ES_Event * pBlock, ES_Event Event2Add,
+                               uint32_t Posted )
+{
+   pQueue_t pThisQueue;
+   uint8_t Index;
+   uint8_t Next;
+   uint8_t i;
+
+   pThisQueue = (pQueue_t)pBlock;
+   EnterCritical();   // save interrupt state, turn ints off
+   Index = pThisQueue->CurrentIndex;
+   for ( i = 0; i < pThisQueue->NumEntries; i++ )
+   {
+      if ( pBlock[ FIRST_ENTRY + Index ].EventType == Event2Add.EventType )
+         break;
+      Index = NEXT( pThisQueue, Index );
+   }
+   if ( i == pThisQueue->NumEntries ) // none pending
+   {
+      ExitCritical();
+      return(False);
+   }
+   // close the gap, the entries behind the old event move up 1
+   for ( i++; i < pThisQueue->NumEntries; i++ )
+   {
+      Next = NEXT( pThisQueue, Index );
+      pBlock[ FIRST_ENTRY + Index ] = pBlock[ FIRST_ENTRY + Next ];
+#if ES_QUEUE_STATS
+      STAMPS(pBlock)[Index] = STAMPS(pBlock)[Next];
+#endif
+#if ES_PROFILE
+      POSTED(pBlock)[Index] = POSTED(pBlock)[Next];
+#endif
+      Index = Next;
+   }
+   pBlock[ FIRST_ENTRY + Index ] = Event2Add;
+#if ES_QUEUE_STATS
+   RecordPost( pBlock, Index );
+   STATS(pBlock)->Coalesced++;
+#endif
+#if ES_PROFILE
+   POSTED(pBlock)[Index] = Posted;
+#else
+   (void)Posted;
+#endif
+   ExitCritical();  // restore saved interrupt state
+   return(True);
+}
+#endif
 
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
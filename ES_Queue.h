@@ -9,6 +9,15 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 15:15 adl      ES_QUEUE_INDEXING, mask or modulo picked at compile
+                         time
+ 10/18/26 15:00 adl      added ES_EnQueue, which says whether it replaced
+ 10/18/26 05:55 adl      post time stamps for the dispatch profile (ES_PROFILE)
+ 10/18/26 04:10 adl      added ES_QueueCount
+ 10/17/26 19:10 adl      Coalesced count in the statistics
+ 10/17/26 18:00 adl      added the queue statistics (ES_QUEUE_STATS)
+ 10/17/26 17:00 adl      added ES_DeQueueBatch
+ 10/17/26 14:10 adl      added ES_InitQueuePow2
  01/15/12 09:36 jec      converted to use new types from ES_Types.h
  10/17/11 07:49 jec      new header to match the rest of the framework
  08/09/11 09:30 jec      started coding
@@ -16,16 +25,138 @@
 #ifndef ES_Queue_H
 #define ES_Queue_H
 
+#include "ES_Configure.h"
 #include "ES_Types.h"
 #include "ES_Events.h"
+#include "ES_Profile.h"
+
+#if ES_QUEUE_STATS
+/* what each queue records about its use when ES_QUEUE_STATS is set */
+typedef struct {
+   uint32_t Posts;          // posts tried, including the dropped ones
+   uint16_t Drops;          // posts lost because the queue was full
+   uint16_t Coalesced;      // posts that replaced a pending event
+   uint16_t MaxTicksQueued; // longest an event waited, in timer ticks
+   uint8_t  HighWater;      // most entries ever in the queue at once
+   uint8_t  QueueSize;      // entries the queue can hold
+} ES_QueueStats_t;
+
+/* the statistics live in the queue's block, after the queue header, and
+   each entry also needs a time stamp, so the block has to be bigger */
+#define ES_QUEUE_STATS_EVENTS \
+        ((sizeof(ES_QueueStats_t) + sizeof(ES_Event) - 1) / sizeof(ES_Event))
+#define ES_QUEUE_STAMP_EVENTS(Size) \
+        (((Size) * sizeof(uint16_t) + sizeof(ES_Event) - 1) / sizeof(ES_Event))
+#define ES_QUEUE_STATS_ROOM(Size) \
+        (ES_QUEUE_STATS_EVENTS + ES_QUEUE_STAMP_EVENTS(Size))
+#else
+#define ES_QUEUE_STATS_ROOM(Size) 0
+#endif
+
+#if ES_PROFILE
+/* for the dispatch profile each entry is stamped with the fine time of its
+   post, after anything else in the block */
+#define ES_QUEUE_POSTED_EVENTS(Size) \
+        (((Size) * sizeof(uint32_t) + sizeof(ES_Event) - 1) / sizeof(ES_Event))
+/* the post times of the events the latest DeQueue took are kept for this
+   many of them */
+#define ES_QUEUE_MAX_TAKEN ES_RUN_BATCH_SIZE
+#else
+#define ES_QUEUE_POSTED_EVENTS(Size) 0
+#endif
+
+/* how the queues wrap their indices: ES_QUEUE_MODULO works for a queue of
+   any size, ES_QUEUE_MASK only for a power of 2 queue (ES_InitQueuePow2).
+   Unless a program sets ES_QUEUE_INDEXING itself, it is worked out from the
+   services' SERV_n_QUEUE_POW2, so a build whose queues are all of 1 kind
+   has no test of which kind on each post. Only a build with both pays for
+   the choice at run time */
+#define ES_QUEUE_MODULO 1
+#define ES_QUEUE_MASK   2
+#ifndef ES_QUEUE_INDEXING
+#define ES_QUEUE_POW2_(n)  ((NUM_SERVICES > (n)) && SERV_##n##_QUEUE_POW2)
+#define ES_QUEUE_PLAIN_(n) ((NUM_SERVICES > (n)) && !SERV_##n##_QUEUE_POW2)
+#if ES_QUEUE_POW2_(0) || ES_QUEUE_POW2_(1) || ES_QUEUE_POW2_(2) || \
+    ES_QUEUE_POW2_(3) || ES_QUEUE_POW2_(4) || ES_QUEUE_POW2_(5) || \
+    ES_QUEUE_POW2_(6) || ES_QUEUE_POW2_(7) || ES_QUEUE_POW2_(8) || \
+    ES_QUEUE_POW2_(9) || ES_QUEUE_POW2_(10) || ES_QUEUE_POW2_(11) || \
+    ES_QUEUE_POW2_(12) || ES_QUEUE_POW2_(13) || ES_QUEUE_POW2_(14) || \
+    ES_QUEUE_POW2_(15) || ES_QUEUE_POW2_(16) || ES_QUEUE_POW2_(17) || \
+    ES_QUEUE_POW2_(18) || ES_QUEUE_POW2_(19) || ES_QUEUE_POW2_(20) || \
+    ES_QUEUE_POW2_(21) || ES_QUEUE_POW2_(22) || ES_QUEUE_POW2_(23) || \
+    ES_QUEUE_POW2_(24) || ES_QUEUE_POW2_(25) || ES_QUEUE_POW2_(26) || \
+    ES_QUEUE_POW2_(27) || ES_QUEUE_POW2_(28) || ES_QUEUE_POW2_(29) || \
+    ES_QUEUE_POW2_(30) || ES_QUEUE_POW2_(31) || ES_QUEUE_POW2_(32) || \
+    ES_QUEUE_POW2_(33) || ES_QUEUE_POW2_(34) || ES_QUEUE_POW2_(35) || \
+    ES_QUEUE_POW2_(36) || ES_QUEUE_POW2_(37) || ES_QUEUE_POW2_(38) || \
+    ES_QUEUE_POW2_(39) || ES_QUEUE_POW2_(40) || ES_QUEUE_POW2_(41) || \
+    ES_QUEUE_POW2_(42) || ES_QUEUE_POW2_(43) || ES_QUEUE_POW2_(44) || \
+    ES_QUEUE_POW2_(45) || ES_QUEUE_POW2_(46) || ES_QUEUE_POW2_(47) || \
+    ES_QUEUE_POW2_(48) || ES_QUEUE_POW2_(49) || ES_QUEUE_POW2_(50) || \
+    ES_QUEUE_POW2_(51) || ES_QUEUE_POW2_(52) || ES_QUEUE_POW2_(53) || \
+    ES_QUEUE_POW2_(54) || ES_QUEUE_POW2_(55) || ES_QUEUE_POW2_(56) || \
+    ES_QUEUE_POW2_(57) || ES_QUEUE_POW2_(58) || ES_QUEUE_POW2_(59) || \
+    ES_QUEUE_POW2_(60) || ES_QUEUE_POW2_(61) || ES_QUEUE_POW2_(62) || \
+    ES_QUEUE_POW2_(63)
+#define ES_QUEUE_USES_MASK ES_QUEUE_MASK
+#else
+#define ES_QUEUE_USES_MASK 0
+#endif
+#if ES_QUEUE_PLAIN_(0) || ES_QUEUE_PLAIN_(1) || ES_QUEUE_PLAIN_(2) || \
+    ES_QUEUE_PLAIN_(3) || ES_QUEUE_PLAIN_(4) || ES_QUEUE_PLAIN_(5) || \
+    ES_QUEUE_PLAIN_(6) || ES_QUEUE_PLAIN_(7) || ES_QUEUE_PLAIN_(8) || \
+    ES_QUEUE_PLAIN_(9) || ES_QUEUE_PLAIN_(10) || ES_QUEUE_PLAIN_(11) || \
+    ES_QUEUE_PLAIN_(12) || ES_QUEUE_PLAIN_(13) || ES_QUEUE_PLAIN_(14) || \
+    ES_QUEUE_PLAIN_(15) || ES_QUEUE_PLAIN_(16) || ES_QUEUE_PLAIN_(17) || \
+    ES_QUEUE_PLAIN_(18) || ES_QUEUE_PLAIN_(19) || ES_QUEUE_PLAIN_(20) || \
+    ES_QUEUE_PLAIN_(21) || ES_QUEUE_PLAIN_(22) || ES_QUEUE_PLAIN_(23) || \
+    ES_QUEUE_PLAIN_(24) || ES_QUEUE_PLAIN_(25) || ES_QUEUE_PLAIN_(26) || \
+    ES_QUEUE_PLAIN_(27) || ES_QUEUE_PLAIN_(28) || ES_QUEUE_PLAIN_(29) || \
+    ES_QUEUE_PLAIN_(30) || ES_QUEUE_PLAIN_(31) || ES_QUEUE_PLAIN_(32) || \
+    ES_QUEUE_PLAIN_(33) || ES_QUEUE_PLAIN_(34) || ES_QUEUE_PLAIN_(35) || \
+    ES_QUEUE_PLAIN_(36) || ES_QUEUE_PLAIN_(37) || ES_QUEUE_PLAIN_(38) || \
+    ES_QUEUE_PLAIN_(39) || ES_QUEUE_PLAIN_(40) || ES_QUEUE_PLAIN_(41) || \
+    ES_QUEUE_PLAIN_(42) || ES_QUEUE_PLAIN_(43) || ES_QUEUE_PLAIN_(44) || \
+    ES_QUEUE_PLAIN_(45) || ES_QUEUE_PLAIN_(46) || ES_QUEUE_PLAIN_(47) || \
+    ES_QUEUE_PLAIN_(48) || ES_QUEUE_PLAIN_(49) || ES_QUEUE_PLAIN_(50) || \
+    ES_QUEUE_PLAIN_(51) || ES_QUEUE_PLAIN_(52) || ES_QUEUE_PLAIN_(53) || \
+    ES_QUEUE_PLAIN_(54) || ES_QUEUE_PLAIN_(55) || ES_QUEUE_PLAIN_(56) || \
+    ES_QUEUE_PLAIN_(57) || ES_QUEUE_PLAIN_(58) || ES_QUEUE_PLAIN_(59) || \
+    ES_QUEUE_PLAIN_(60) || ES_QUEUE_PLAIN_(61) || ES_QUEUE_PLAIN_(62) || \
+    ES_QUEUE_PLAIN_(63)
+#define ES_QUEUE_USES_MODULO ES_QUEUE_MODULO
+#else
+#define ES_QUEUE_USES_MODULO 0
+#endif
+#define ES_QUEUE_INDEXING (ES_QUEUE_USES_MASK | ES_QUEUE_USES_MODULO)
+#endif
+
+/* what ES_EnQueue did with the event */
+typedef enum { ES_QUEUE_FULL, ES_QUEUE_ADDED, ES_QUEUE_REPLACED } ES_EnQueueResult_t;
+
+/* the number of ES_Event to declare for a queue of Size entries */
+#define ES_QUEUE_BLOCK_SIZE(Size) \
+        ((Size) + 1 + ES_QUEUE_STATS_ROOM(Size) + ES_QUEUE_POSTED_EVENTS(Size))
 
 /* prototypes for public functions */
 
 uint8_t ES_InitQueue( ES_Event * pBlock, unsigned char BlockSize );
+uint8_t ES_InitQueuePow2( ES_Event * pBlock, unsigned char BlockSize );
 boolean ES_EnQueueFIFO( ES_Event * pBlock, ES_Event Event2Add );
+ES_EnQueueResult_t ES_EnQueue( ES_Event * pBlock, ES_Event Event2Add );
 uint8_t ES_DeQueue( ES_Event * pBlock, ES_Event * pReturnEvent );
+uint8_t ES_DeQueueBatch( ES_Event * pBlock, ES_Event * pReturnEvents,
+                         uint8_t MaxEvents, uint8_t * pNumLeft );
 //void EF_FlushQueue( unsigned char * pBlock );
 boolean ES_IsQueueEmpty( ES_Event * pBlock );
+uint8_t ES_QueueCount( ES_Event * pBlock );
+#if ES_QUEUE_STATS
+void ES_QueryQueueStats( ES_Event * pBlock, ES_QueueStats_t * pStats );
+void ES_ClearQueueStats( ES_Event * pBlock );
+#endif
+#if ES_PROFILE
+uint32_t ES_QueryPostTime( uint8_t Which );
+#endif
 
 #endif /*ES_Queue_H */
 
@@ -0,0 +1,118 @@
+/****************************************************************************
+ Module
+     ES_StateTable.c
+ Description
+     runs a flat state machine, one of the sub-machines of a hierarchy, from
+     its transition table rather than from a switch on its state and
+     another on the event
+ Notes
+     The machine's table comes from its _Spec.h, through Host/TableGen, as
+     <Machine>_Table.h (see ES_StateTable.h for what is in it). The machine's
+     Run function passes each event here with the state it keeps, and this
+     does what the switches did:
+       ES_ENTRY and ES_EXIT run the state's entry or exit function, and
+       are logged with ES_LogEntry and ES_LogExit
+       any other event finds its rows for the state in the dispatch
+       array, in 1 step whatever the state and event, and takes the first
+       whose Param and Guard match: it runs the row's action, then, if the
+       row leaves the state, the exit of the old state and the entry of the
+       new one, and returns what the row says to.
+     An event that the state has no row for, or that no row's guard takes,
+     is returned as it came, for the machine above to deal with.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 15:50 adl      entries and exits in line, ES_ENTRY and ES_EXIT
+                         looked for only when the event has no rows
+ 10/18/26 12:45 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Log.h"
+#include "ES_Trace.h"
+#include "ES_StateTable.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// logs the entry to or exit from State and runs its entry or exit function,
+// in line, as the switches did it in line
+#define RUN_ENTRY(State) \
+  ES_LogEvent( pTable->Source, (State), ThisEvent ); \
+  ES_LogEntry( pTable->Source, (State) ); \
+  if ( pTable->pStates[State].Entry != NULL ) \
+    pTable->pStates[State].Entry( pThis, ThisEvent )
+#define RUN_EXIT(State) \
+  ES_LogEvent( pTable->Source, (State), ThisEvent ); \
+  ES_LogExit( pTable->Source, (State) ); \
+  if ( pTable->pStates[State].Exit != NULL ) \
+    pTable->pStates[State].Exit( pThis, ThisEvent )
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_StateTable_Run
+ Parameters
+   const ES_StateTable_t * pTable : the machine's table
+   uint8_t * pState : where the machine keeps its state
+   void * pThis : the machine's instance, passed to its functions
+   ES_Event ThisEvent : the event to process
+ Returns
+   ES_Event, ES_NO_EVENT if the machine consumed the event, else the event
+   it passes up
+ Description
+   runs the event through the machine, see the module notes
+ Notes
+   the state changes between the exit and the entry, as the switches did,
+   so that the entry function and anything it calls see the new state.
+   ES_ENTRY and ES_EXIT have no rows (TableGen refuses them), so they are
+   only looked for once the dispatch array has none, off the path of the
+   events that have rows
+ Author
+   Alex Loo, 10/18/26, 12:50
+****************************************************************************/
+ES_Event ES_StateTable_Run( const ES_StateTable_t *pTable, uint8_t *pState,
+                            void *pThis, ES_Event ThisEvent )
+{
+  const ES_StateTableRow_t *pRow;
+  ES_Event ReturnEvent = ThisEvent;
+  uint8_t State = *pState;
+  uint8_t Row = 0;
+
+  if ( (uint8_t)ThisEvent.EventType < pTable->NumEvents )
+    Row = pTable->pDispatch[State * pTable->NumEvents + ThisEvent.EventType];
+  if ( Row == 0 ) {
+    if ( ThisEvent.EventType == ES_ENTRY ) {
+      RUN_ENTRY( State );
+    } else if ( ThisEvent.EventType == ES_EXIT ) {
+      RUN_EXIT( State );
+    } else {
+      ES_LogEvent( pTable->Source, State, ThisEvent );
+    }
+    return ReturnEvent;
+  }
+  ES_LogEvent( pTable->Source, State, ThisEvent );
+  for ( pRow = &pTable->pRows[Row - 1]; ; pRow++ ) {
+    if ( ((pRow->Param == ES_ANY_PARAM) ||
+          (pRow->Param == ThisEvent.EventParam)) &&
+         ((pRow->Guard == NULL) || pRow->Guard( pThis, ThisEvent )) )
+      break;
+    if ( pRow->Last )
+      return ReturnEvent;
+  }
+
+  if ( pRow->Action != NULL )
+    pRow->Action( pThis, ThisEvent );
+  if ( pRow->Next != ES_SAME_STATE ) {
+    ThisEvent.EventType = ES_EXIT;
+    RUN_EXIT( State );
+    ES_TraceState( pTable->Source, State, pRow->Next );
+    State = pRow->Next;
+    *pState = State;
+    ThisEvent.EventType = ES_ENTRY;
+    RUN_ENTRY( State );
+  }
+  if ( pRow->Returns != ES_PASS_EVENT )
+    ReturnEvent.EventType = (ES_EventTyp_t)pRow->Returns;
+  return ReturnEvent;
+}
+/*------------------------------ End of file ------------------------------*/
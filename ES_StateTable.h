@@ -0,0 +1,81 @@
+/****************************************************************************
+ Module
+     ES_StateTable.h
+ Description
+     header file for the table driven state machines: the types of the
+     tables that Host/TableGen writes from a machine's _Spec.h, and the
+     function that runs a machine from its table
+ Notes
+     A machine's functions (its guards, actions, entries and exits) all take
+     the machine's instance as pThis, then the event. With ES_INSTANCES a
+     function that uses the instance starts with
+        ES_TABLE_ME(ScoringSM_t)
+     which makes Me the instance, as ES_ME_ does for the machine's other
+     functions (see ES_Instance.h). Without ES_INSTANCES pThis is NULL,
+     ES_TABLE_ME comes to nothing, and Me is the machine's only instance.
+     ES_TABLE_ME must come after the function's declarations, and any
+     declaration that needs Me must leave setting it until after.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 12:40 adl      started coding
+*****************************************************************************/
+#ifndef ES_StateTable_H
+#define ES_StateTable_H
+
+#include <stddef.h>
+#include "ES_Types.h"
+#include "ES_Events.h"
+#include "ES_Instance.h"
+
+#if ES_INSTANCES
+#define ES_TABLE_ME(Type) Type *Me = (Type *)pThis;
+#define ES_TABLE_WITH(p) (p)
+#else
+#define ES_TABLE_ME(Type)
+#define ES_TABLE_WITH(p) NULL
+#endif
+
+// a row's Param when it takes the event whatever its parameter
+#define ES_ANY_PARAM 0xFFFF
+// a row's Next when it does not leave the state (no exit, no entry)
+#define ES_SAME_STATE 0xFF
+// a row's Returns when the machine passes the event up as it came
+#define ES_PASS_EVENT 0xFF
+
+typedef boolean ES_StateTableGuard_t( void *pThis, ES_Event ThisEvent );
+typedef void ES_StateTableAction_t( void *pThis, ES_Event ThisEvent );
+
+// what a state does on an event, if Param matches and Guard (if any)
+// returns True. The rows for 1 state and event follow each other, in the
+// order they are tried; the last has Last set
+typedef struct {
+  ES_StateTableGuard_t *Guard;    // NULL to take every event that Param does
+  ES_StateTableAction_t *Action;  // NULL for none
+  uint16_t Param;                 // the EventParam to take, or ES_ANY_PARAM
+  uint8_t Next;                   // the state to go to, or ES_SAME_STATE
+  uint8_t Returns;                // the event type returned, ES_NO_EVENT to
+                                  // consume the event, or ES_PASS_EVENT
+  uint8_t Last;
+} ES_StateTableRow_t;
+
+typedef struct {
+  ES_StateTableAction_t *Entry;   // NULL for none
+  ES_StateTableAction_t *Exit;    // NULL for none
+} ES_StateTableState_t;
+
+typedef struct {
+  // for each state, a row of NumEvents entries, 1 for each event type: 0 if
+  // the state takes no events of that type, else 1 + the index of its first
+  // row in pRows
+  const uint8_t *pDispatch;
+  const ES_StateTableRow_t *pRows;
+  const ES_StateTableState_t *pStates;  // indexed by state
+  uint8_t NumEvents;
+  uint8_t Source;                       // the machine's LOG_ source
+} ES_StateTable_t;
+
+ES_Event ES_StateTable_Run( const ES_StateTable_t *pTable, uint8_t *pState,
+                            void *pThis, ES_Event ThisEvent );
+
+#endif /* ES_StateTable_H */
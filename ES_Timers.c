@@ -4,16 +4,41 @@
      ES_Timers.c
 
  Description
-     This is a module implementing  8 16 bit timers all using the RTI
-     timebase
+     This is a module implementing ES_NUM_TIMERS (8 unless set otherwise
+     in ES_Configure.h, up to 64) 16 bit timers all using the RTI timebase
 
  Notes
      Everything is done in terms of RTI Ticks, which can change from
      application to application.
+     A timer either has its post function fixed by TIMERn_RESP_FUNC in
+     ES_Configure.h and posts ES_TIMEOUT with its number as the parameter,
+     or has none and belongs to the pool, where ES_Timer_Alloc hands it out
+     as a handle with the post function and event given by the caller.
+     The running timers are kept in a list sorted by the tick on which they
+     expire, so the RTI only ever looks at the head of the list. A tick
+     costs the same with 1 timer running as with 64; starting a timer walks
+     the list to find its place instead. That walk is done with interrupts
+     off, since the RTI and the ISRs that start timers change the list too,
+     so the time an interrupt can be held off by a start grows with the
+     number of running timers. Host/BenchTimers (arm last) measures it; with
+     the robot's handful of timers it is shorter than the old RTI's walk
+     over every timer on every tick.
 
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 16:50 adl      noted what LinkTimer costs with interrupts off
+ 10/18/26 04:12 adl      each expiry goes into the event trace
+ 10/17/26 22:10 adl      32 bit tick count and the fine timebase, which
+                         counts the free running TIM counter
+ 10/17/26 21:30 adl      timer pool: ES_Timer_Alloc/ES_Timer_Free hand out
+                         the timers that have no TIMERn_RESP_FUNC, with
+                         a post function and event of the caller's choosing
+ 10/17/26 20:10 adl      running timers kept in a list sorted by expiry, so
+                         a tick no longer touches every running timer, and
+                         up to 64 timers (ES_NUM_TIMERS)
+ 10/17/26 09:12 adl      moved the RTI register access and vector into ES_Port.h
+                         so the module also builds on the Linux host
  02/02/12 10:01 jec      changed headers to E128 versions
  01/16/12 09:42 jec      added some more error checking to start & init
                          funcs to prevent starting a timer with no
@@ -38,10 +63,8 @@
 ****************************************************************************/
 
 /*----------------------------- Include Files -----------------------------*/
-#include <hidef.h>         /* common defines and macros */
-#include <mc9s12e128.h>     /* derivative information */
-#include <S12E128bits.h>    /* bit definitions  */
 #include <bitdefs.h>
+#include "ES_Port.h"        /* RTI registers and vector, critical regions */
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "ES_ServiceHeaders.h"
@@ -50,53 +73,262 @@
 #include "ES_PostList.h"
 #include "ES_LookupTables.h"
 #include "ES_Timers.h"
+#include "ES_Trace.h"
 /*--------------------------- External Variables --------------------------*/
 
 /*----------------------------- Module Defines ----------------------------*/
 #define BITS_PER_BYTE 8
 
-/*------------------------------ Module Types -----------------------------*/
+#ifndef ES_NUM_TIMERS
+#define ES_NUM_TIMERS 8
+#endif
+#if (ES_NUM_TIMERS < 8) || (ES_NUM_TIMERS > 64)
+#error ES_NUM_TIMERS must be from 8 to 64
+#endif
 
-/*
-   the size of Tflag sets the number of timers, char = 8, int =16 ...)
-   to add more timers, you will need to change the data type and modify
-   the initializaiton of TMR_TimerArray and TMR_MaskArray
-*/
+// a timer with no TIMERn_RESP_FUNC goes to the pool
+#ifndef TIMER0_RESP_FUNC
+#define TIMER0_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER1_RESP_FUNC
+#define TIMER1_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER2_RESP_FUNC
+#define TIMER2_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER3_RESP_FUNC
+#define TIMER3_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER4_RESP_FUNC
+#define TIMER4_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER5_RESP_FUNC
+#define TIMER5_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER6_RESP_FUNC
+#define TIMER6_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER7_RESP_FUNC
+#define TIMER7_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER8_RESP_FUNC
+#define TIMER8_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER9_RESP_FUNC
+#define TIMER9_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER10_RESP_FUNC
+#define TIMER10_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER11_RESP_FUNC
+#define TIMER11_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER12_RESP_FUNC
+#define TIMER12_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER13_RESP_FUNC
+#define TIMER13_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER14_RESP_FUNC
+#define TIMER14_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER15_RESP_FUNC
+#define TIMER15_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER16_RESP_FUNC
+#define TIMER16_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER17_RESP_FUNC
+#define TIMER17_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER18_RESP_FUNC
+#define TIMER18_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER19_RESP_FUNC
+#define TIMER19_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER20_RESP_FUNC
+#define TIMER20_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER21_RESP_FUNC
+#define TIMER21_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER22_RESP_FUNC
+#define TIMER22_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER23_RESP_FUNC
+#define TIMER23_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER24_RESP_FUNC
+#define TIMER24_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER25_RESP_FUNC
+#define TIMER25_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER26_RESP_FUNC
+#define TIMER26_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER27_RESP_FUNC
+#define TIMER27_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER28_RESP_FUNC
+#define TIMER28_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER29_RESP_FUNC
+#define TIMER29_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER30_RESP_FUNC
+#define TIMER30_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER31_RESP_FUNC
+#define TIMER31_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER32_RESP_FUNC
+#define TIMER32_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER33_RESP_FUNC
+#define TIMER33_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER34_RESP_FUNC
+#define TIMER34_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER35_RESP_FUNC
+#define TIMER35_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER36_RESP_FUNC
+#define TIMER36_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER37_RESP_FUNC
+#define TIMER37_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER38_RESP_FUNC
+#define TIMER38_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER39_RESP_FUNC
+#define TIMER39_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER40_RESP_FUNC
+#define TIMER40_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER41_RESP_FUNC
+#define TIMER41_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER42_RESP_FUNC
+#define TIMER42_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER43_RESP_FUNC
+#define TIMER43_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER44_RESP_FUNC
+#define TIMER44_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER45_RESP_FUNC
+#define TIMER45_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER46_RESP_FUNC
+#define TIMER46_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER47_RESP_FUNC
+#define TIMER47_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER48_RESP_FUNC
+#define TIMER48_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER49_RESP_FUNC
+#define TIMER49_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER50_RESP_FUNC
+#define TIMER50_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER51_RESP_FUNC
+#define TIMER51_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER52_RESP_FUNC
+#define TIMER52_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER53_RESP_FUNC
+#define TIMER53_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER54_RESP_FUNC
+#define TIMER54_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER55_RESP_FUNC
+#define TIMER55_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER56_RESP_FUNC
+#define TIMER56_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER57_RESP_FUNC
+#define TIMER57_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER58_RESP_FUNC
+#define TIMER58_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER59_RESP_FUNC
+#define TIMER59_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER60_RESP_FUNC
+#define TIMER60_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER61_RESP_FUNC
+#define TIMER61_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER62_RESP_FUNC
+#define TIMER62_RESP_FUNC TIMER_UNUSED
+#endif
+#ifndef TIMER63_RESP_FUNC
+#define TIMER63_RESP_FUNC TIMER_UNUSED
+#endif
+
+// marks the end of the list of running timers
+#define NO_TIMER 0xFF
 
-typedef uint8_t Tflag_t;
+// the running flag for each timer
+#define IS_ACTIVE(Num) \
+   ((TMR_ActiveFlags[(Num)/BITS_PER_BYTE] & BitNum2SetMask[(Num)%BITS_PER_BYTE]) != 0)
+#define SET_ACTIVE(Num) \
+   (TMR_ActiveFlags[(Num)/BITS_PER_BYTE] |= BitNum2SetMask[(Num)%BITS_PER_BYTE])
+#define CLEAR_ACTIVE(Num) \
+   (TMR_ActiveFlags[(Num)/BITS_PER_BYTE] &= BitNum2ClrMask[(Num)%BITS_PER_BYTE])
+
+/*------------------------------ Module Types -----------------------------*/
 
 typedef uint16_t Timer_t;
 
 
 /*---------------------------- Module Functions ---------------------------*/
 void EF_Timer_RTI_Resp(void);
+static void LinkTimer(uint8_t Num);
+static void UnlinkTimer(uint8_t Num);
 
 /*---------------------------- Module Variables ---------------------------*/
-static Timer_t TMR_TimerArray[sizeof(Tflag_t)*BITS_PER_BYTE]=
-                                            { 0x0,
-                                              0x0,
-                                              0x0,
-                                              0x0,
-                                              0x0,
-                                              0x0,
-                                              0x0,
-                                              0x0 };
-
-// make this one const to get it put into flash, since it will never change
-static Tflag_t const TMR_MaskArray[sizeof(Tflag_t)*BITS_PER_BYTE]=
-                                            { BIT0HI,
-                                              BIT1HI,
-                                              BIT2HI,
-                                              BIT3HI,
-                                              BIT4HI,
-                                              BIT5HI,
-                                              BIT6HI,
-                                              BIT7HI };
-
-static Tflag_t TMR_ActiveFlags;
+/*
+   a stopped timer holds the ticks it has left to run, a running timer holds
+   the value of 'time' on which it will expire
+*/
+static Timer_t TMR_TimerArray[ES_NUM_TIMERS];
+
+// the list of running timers, soonest to expire first, linked both ways so
+// that a timer can be stopped without a search
+static uint8_t TMR_NextTimer[ES_NUM_TIMERS];
+static uint8_t TMR_PrevTimer[ES_NUM_TIMERS];
+static uint8_t TMR_FirstTimer = NO_TIMER;
+
+// 1 bit per timer, set while it is running
+static uint8_t TMR_ActiveFlags[(ES_NUM_TIMERS + BITS_PER_BYTE - 1)/BITS_PER_BYTE];
+
+// 1 bit per timer, set while it is in the pool and not handed out
+static uint8_t TMR_PoolFlags[(ES_NUM_TIMERS + BITS_PER_BYTE - 1)/BITS_PER_BYTE];
+
+// where each timer posts and what, filled in from Timer2PostFunc for the
+// fixed timers and by ES_Timer_Alloc for the pool timers
+static pPostFunc TMR_PostFunc[ES_NUM_TIMERS];
+static ES_Event TMR_Event[ES_NUM_TIMERS];
 static uint16_t time;  /* this is used by the default RTI routine */
+static uint16_t timeHigh; /* times 'time' has wrapped, for GetTime32 */
+static uint16_t FineOverflows; /* wraps of the free running counter */
 
-static pPostFunc const Timer2PostFunc[sizeof(Tflag_t)*BITS_PER_BYTE] = 
+static pPostFunc const Timer2PostFunc[ES_NUM_TIMERS] = 
                                             { TIMER0_RESP_FUNC,
                                               TIMER1_RESP_FUNC,
                                               TIMER2_RESP_FUNC,
@@ -104,7 +336,177 @@ static pPostFunc const Timer2PostFunc[sizeof(Tflag_t)*BITS_PER_BYTE] =
                                               TIMER4_RESP_FUNC,
                                               TIMER5_RESP_FUNC,
                                               TIMER6_RESP_FUNC,
-                                              TIMER7_RESP_FUNC };
+                                              TIMER7_RESP_FUNC
+#if ES_NUM_TIMERS > 8
+                                              ,TIMER8_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 9
+                                              ,TIMER9_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 10
+                                              ,TIMER10_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 11
+                                              ,TIMER11_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 12
+                                              ,TIMER12_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 13
+                                              ,TIMER13_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 14
+                                              ,TIMER14_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 15
+                                              ,TIMER15_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 16
+                                              ,TIMER16_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 17
+                                              ,TIMER17_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 18
+                                              ,TIMER18_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 19
+                                              ,TIMER19_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 20
+                                              ,TIMER20_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 21
+                                              ,TIMER21_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 22
+                                              ,TIMER22_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 23
+                                              ,TIMER23_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 24
+                                              ,TIMER24_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 25
+                                              ,TIMER25_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 26
+                                              ,TIMER26_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 27
+                                              ,TIMER27_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 28
+                                              ,TIMER28_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 29
+                                              ,TIMER29_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 30
+                                              ,TIMER30_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 31
+                                              ,TIMER31_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 32
+                                              ,TIMER32_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 33
+                                              ,TIMER33_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 34
+                                              ,TIMER34_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 35
+                                              ,TIMER35_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 36
+                                              ,TIMER36_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 37
+                                              ,TIMER37_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 38
+                                              ,TIMER38_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 39
+                                              ,TIMER39_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 40
+                                              ,TIMER40_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 41
+                                              ,TIMER41_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 42
+                                              ,TIMER42_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 43
+                                              ,TIMER43_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 44
+                                              ,TIMER44_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 45
+                                              ,TIMER45_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 46
+                                              ,TIMER46_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 47
+                                              ,TIMER47_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 48
+                                              ,TIMER48_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 49
+                                              ,TIMER49_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 50
+                                              ,TIMER50_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 51
+                                              ,TIMER51_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 52
+                                              ,TIMER52_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 53
+                                              ,TIMER53_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 54
+                                              ,TIMER54_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 55
+                                              ,TIMER55_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 56
+                                              ,TIMER56_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 57
+                                              ,TIMER57_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 58
+                                              ,TIMER58_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 59
+                                              ,TIMER59_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 60
+                                              ,TIMER60_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 61
+                                              ,TIMER61_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 62
+                                              ,TIMER62_RESP_FUNC
+#endif
+#if ES_NUM_TIMERS > 63
+                                              ,TIMER63_RESP_FUNC
+#endif
+                                            };
+
   
 
 /*------------------------------ Module Code ------------------------------*/
@@ -120,16 +522,24 @@ static pPostFunc const Timer2PostFunc[sizeof(Tflag_t)*BITS_PER_BYTE] =
      Initializes the timer module by setting up the RTI with the requested
     rate
  Notes
-     None.
+     Also routes the fixed timers and fills the pool with the others, so it
+     must come before any ES_Timer_Alloc.
  Author
      J. Edward Carryer, 02/24/97 14:23
 ****************************************************************************/
 void ES_Timer_Init(TimerRate_t Rate)
 {
-   RTICTL = (unsigned char)Rate;     /* set RTI Rate */
-   CRGFLG = _S12_RTIF;              /* clear any pending int */
-   CRGINT |= _S12_RTIE;             /* enable the RTI int */
-   EnableInterrupts;                /* make sure that interrupts are enabled*/
+   uint8_t Num;
+
+   for( Num = 0; Num < ARRAY_SIZE(TMR_TimerArray); Num++ )
+   {
+      TMR_PostFunc[Num] = Timer2PostFunc[Num];
+      TMR_Event[Num].EventType = ES_TIMEOUT;
+      TMR_Event[Num].EventParam = Num;
+      if( Timer2PostFunc[Num] == TIMER_UNUSED )
+         TMR_PoolFlags[Num/BITS_PER_BYTE] |= BitNum2SetMask[Num%BITS_PER_BYTE];
+   }
+   ES_Port_InitRTI(Rate);   /* set RTI Rate, clear & enable the RTI int */
 }
 
 /****************************************************************************
@@ -144,7 +554,7 @@ void ES_Timer_Init(TimerRate_t Rate)
  Description
      sets the time for a timer, but does not make it active.
  Notes
-     None.
+     A running timer starts over with the new time, as it always has.
  Author
      J. Edward Carryer, 02/24/97 17:11
 ****************************************************************************/
@@ -153,10 +563,18 @@ ES_TimerReturn_t ES_Timer_SetTimer(uint8_t Num, uint16_t NewTime)
    /* tried to set a timer that doesn't exist */
    if( (Num >= ARRAY_SIZE(TMR_TimerArray)) ||
    /* tried to set a timer without a service */
-       (Timer2PostFunc[Num] == TIMER_UNUSED) ||
+       (TMR_PostFunc[Num] == TIMER_UNUSED) ||
        (NewTime == 0) ) /* no time being set */
       return ES_Timer_ERR;  
-   TMR_TimerArray[Num] = NewTime;
+   EnterCritical();
+   if( IS_ACTIVE(Num) )
+   {
+      UnlinkTimer(Num);
+      TMR_TimerArray[Num] = NewTime;
+      LinkTimer(Num);
+   }else
+      TMR_TimerArray[Num] = NewTime;
+   ExitCritical();
    return ES_Timer_OK;
 }
 
@@ -168,8 +586,8 @@ ES_TimerReturn_t ES_Timer_SetTimer(uint8_t Num, uint16_t NewTime)
  Returns
      ES_Timer_ERR for error ES_Timer_OK for success
  Description
-     simply sets the active flag in TMR_ActiveFlags to (re)start a
-     stopped timer.
+     (re)starts a stopped timer with the time that it has left. A timer
+     that is already running carries on.
  Notes
      None.
  Author
@@ -178,11 +596,20 @@ ES_TimerReturn_t ES_Timer_SetTimer(uint8_t Num, uint16_t NewTime)
 ES_TimerReturn_t ES_Timer_StartTimer(unsigned char Num)
 {
    /* tried to set a timer that doesn't exist */
-   if( (Num >= ARRAY_SIZE(TMR_TimerArray)) ||
-       /* tried to set a timer with no time on it */
-       (TMR_TimerArray[Num] == 0) )
+   if( Num >= ARRAY_SIZE(TMR_TimerArray) )
       return ES_Timer_ERR;  
-   TMR_ActiveFlags |= TMR_MaskArray[Num]; /* set timer as active */
+   EnterCritical();
+   if( ! IS_ACTIVE(Num) )
+   {
+      /* tried to start a timer with no time on it */
+      if( TMR_TimerArray[Num] == 0 )
+      {
+         ExitCritical();
+         return ES_Timer_ERR;
+      }
+      LinkTimer(Num);  /* set timer as active */
+   }
+   ExitCritical();
    return ES_Timer_OK;
 }
 
@@ -194,8 +621,8 @@ ES_TimerReturn_t ES_Timer_StartTimer(unsigned char Num)
  Returns
      ES_Timer_ERR for error (timer doesn't exist) ES_Timer_OK for success.
  Description
-     simply clears the bit in TMR_ActiveFlags associated with this
-     timer. This will cause it to stop counting.
+     takes the timer out of the running list and keeps the time it has left,
+     for ES_Timer_StartTimer. This will cause it to stop counting.
  Notes
      None.
  Author
@@ -205,7 +632,13 @@ ES_TimerReturn_t ES_Timer_StopTimer(unsigned char Num)
 {
    if( Num >= ARRAY_SIZE(TMR_TimerArray) )
       return ES_Timer_ERR;  /* tried to set a timer that doesn't exist */
-   TMR_ActiveFlags &= ~(TMR_MaskArray[Num]); /* set timer as inactive */
+   EnterCritical();
+   if( IS_ACTIVE(Num) )
+   {
+      UnlinkTimer(Num);  /* set timer as inactive */
+      TMR_TimerArray[Num] = (Timer_t)(TMR_TimerArray[Num] - time);
+   }
+   ExitCritical();
    return ES_Timer_OK;
 }
 
@@ -221,7 +654,8 @@ ES_TimerReturn_t ES_Timer_StopTimer(unsigned char Num)
      sets the NewTime into the chosen timer and sets the timer actice to 
      begin counting.
  Notes
-     None.
+     A running timer starts over with NewTime, so this one call does what
+     StopTimer, SetTimer and StartTimer do together.
  Author
      J. Edward Carryer, 02/24/97 14:51
 ****************************************************************************/
@@ -230,15 +664,114 @@ ES_TimerReturn_t ES_Timer_InitTimer(unsigned char Num, unsigned int NewTime)
    /* tried to set a timer that doesn't exist */
    if( (Num >= ARRAY_SIZE(TMR_TimerArray)) ||
    /* tried to set a timer without a service */
-       (Timer2PostFunc[Num] == TIMER_UNUSED) ||
+       (TMR_PostFunc[Num] == TIMER_UNUSED) ||
        /* tried to set a timer without putting any time on it */
        (NewTime == 0) )
       return ES_Timer_ERR;  
-   TMR_TimerArray[Num] = NewTime;
-   TMR_ActiveFlags |= TMR_MaskArray[Num]; /* set timer as active */
+   EnterCritical();
+   if( IS_ACTIVE(Num) )
+      UnlinkTimer(Num);
+   TMR_TimerArray[Num] = (Timer_t)NewTime;
+   LinkTimer(Num);  /* set timer as active */
+   ExitCritical();
    return ES_Timer_OK;
 }
 
+/****************************************************************************
+ Function
+     ES_Timer_IsTimerActive
+ Parameters
+     unsigned char Num the number of the timer to check
+ Returns
+     ES_Timer_ERR if the timer doesn't exist, ES_Timer_ACTIVE if it is
+     running, ES_Timer_NOT_ACTIVE if not
+ Description
+     tells whether a timer is still counting
+ Notes
+     None.
+ Author
+     Alex Loo, 10/17/26, 20:25
+****************************************************************************/
+ES_TimerReturn_t ES_Timer_IsTimerActive(unsigned char Num)
+{
+   if( Num >= ARRAY_SIZE(TMR_TimerArray) )
+      return ES_Timer_ERR;
+   return IS_ACTIVE(Num) ? ES_Timer_ACTIVE : ES_Timer_NOT_ACTIVE;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_Alloc
+ Parameters
+     pPostFunc PostFunc, the post function of the service to be told
+     ES_Event Event2Post, the event to post to it when the timer expires
+ Returns
+     ES_TimerHandle_t, the handle of the timer or ES_TIMER_NO_HANDLE if the
+     pool is empty (or PostFunc is TIMER_UNUSED)
+ Description
+     takes a timer from the pool. The handle works with every other
+     ES_Timer function in place of a timer number.
+ Notes
+     The pool is the timers with no TIMERn_RESP_FUNC, so ES_NUM_TIMERS sets
+     its size. Services run to completion, so no 2 can be in here at once.
+ Author
+     Alex Loo, 10/17/26, 21:35
+****************************************************************************/
+ES_TimerHandle_t ES_Timer_Alloc(pPostFunc PostFunc, ES_Event Event2Post)
+{
+   uint8_t Byte;
+   uint8_t Num;
+
+   if( PostFunc == TIMER_UNUSED )
+      return ES_TIMER_NO_HANDLE;
+   for( Byte = 0; Byte < ARRAY_SIZE(TMR_PoolFlags); Byte++ )
+   {
+      if( TMR_PoolFlags[Byte] != 0 )
+      {
+         Num = Byte2MSBitNum[TMR_PoolFlags[Byte]-1];
+         TMR_PoolFlags[Byte] &= BitNum2ClrMask[Num];
+         Num += Byte*BITS_PER_BYTE;
+         TMR_TimerArray[Num] = 0;
+         TMR_Event[Num] = Event2Post;
+         TMR_PostFunc[Num] = PostFunc;
+         return Num;
+      }
+   }
+   return ES_TIMER_NO_HANDLE;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_Free
+ Parameters
+     ES_TimerHandle_t Handle, a handle from ES_Timer_Alloc
+ Returns
+     ES_Timer_ERR if Handle is not a timer handed out by ES_Timer_Alloc,
+     ES_Timer_OK otherwise
+ Description
+     stops the timer and gives it back to the pool
+ Notes
+     a timeout already posted by the timer may still be in the queue
+ Author
+     Alex Loo, 10/17/26, 21:38
+****************************************************************************/
+ES_TimerReturn_t ES_Timer_Free(ES_TimerHandle_t Handle)
+{
+   if( (Handle >= ARRAY_SIZE(TMR_TimerArray)) ||
+       /* not a pool timer */
+       (Timer2PostFunc[Handle] != TIMER_UNUSED) ||
+       /* or not handed out */
+       (TMR_PostFunc[Handle] == TIMER_UNUSED) )
+      return ES_Timer_ERR;
+   EnterCritical();
+   if( IS_ACTIVE(Handle) )
+      UnlinkTimer(Handle);
+   TMR_PostFunc[Handle] = TIMER_UNUSED;
+   ExitCritical();
+   TMR_TimerArray[Handle] = 0;
+   TMR_PoolFlags[Handle/BITS_PER_BYTE] |= BitNum2SetMask[Handle%BITS_PER_BYTE];
+   return ES_Timer_OK;
+}
 
 /****************************************************************************
  Function
@@ -261,6 +794,87 @@ uint16_t ES_Timer_GetTime(void)
    return (time);
 }
 
+/****************************************************************************
+ Function
+     ES_Timer_GetTime32
+ Parameters
+     None.
+ Returns
+     uint32_t, the number of RTI ticks since the timers started
+ Description
+     as ES_Timer_GetTime, but does not wrap for 100 days at 2.048mS, so
+     it can time anything in a match
+ Notes
+     the 2 halves are read with interrupts off, so that the RTI cannot
+     carry into the top half between the reads
+ Author
+     Alex Loo, 10/17/26, 22:05
+****************************************************************************/
+uint32_t ES_Timer_GetTime32(void)
+{
+   uint16_t High;
+   uint16_t Low;
+
+   EnterCritical();
+   High = timeHigh;
+   Low = time;
+   ExitCritical();
+   return ((uint32_t)High << 16) | Low;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_GetFineTime
+ Parameters
+     None.
+ Returns
+     uint32_t, the free running counter, extended to 32 bits by counting
+     its wraps
+ Description
+     a monotonic clock with ES_PORT_FINE_PER_US counts per microsecond (3 on
+     the S12), for timing that needs better than an RTI tick. It wraps
+     after 2^32 counts, 23.8 minutes at 3 per us.
+ Notes
+     The wrap count and the counter are read with interrupts off. A wrap
+     whose ISR has not run yet shows as the overflow flag set; if the
+     counter was read after that wrap (it is still small) it is counted
+     here, so the result never goes backwards.
+ Author
+     Alex Loo, 10/17/26, 22:08
+****************************************************************************/
+uint32_t ES_Timer_GetFineTime(void)
+{
+   uint16_t High;
+   uint16_t Low;
+
+   EnterCritical();
+   High = FineOverflows;
+   Low = (uint16_t)ES_Port_ReadFreeRunning();
+   if( ES_Port_FreeRunningWrapped() && (Low < 0x8000) )
+      High++;
+   ExitCritical();
+   return ((uint32_t)High << 16) | Low;
+}
+
+/****************************************************************************
+ Function
+     ES_Timer_FineOverflow
+ Parameters
+     None.
+ Returns
+     None.
+ Description
+     counts a wrap of the free running counter for ES_Timer_GetFineTime
+ Notes
+     call it from the counter's overflow ISR, before it clears the flag
+ Author
+     Alex Loo, 10/17/26, 22:09
+****************************************************************************/
+void ES_Timer_FineOverflow(void)
+{
+   FineOverflows++;
+}
+
 /****************************************************************************
  Function
      ES_Timer_RTI_Resp
@@ -280,36 +894,100 @@ uint16_t ES_Timer_GetTime(void)
  Author
      J. Edward Carryer, 02/24/97 15:06
 ****************************************************************************/
-void interrupt 7 ES_Timer_RTI_Resp(void)
+void ES_RTI_VECTOR ES_Timer_RTI_Resp(void)
 {
-static Tflag_t NeedsProcessing;
 static uint8_t NextTimer2Process;
-static ES_Event NewEvent;
 
-   CRGFLG = _S12_RTIF;   /* clear the source of the int */
-   ++time;             /* keep the GetTime() timer running */
-   if (TMR_ActiveFlags != 0) /* if !=0 , then at least 1 timer is active */
+   ES_Port_ClearRTI();   /* clear the source of the int */
+   if (++time == 0)    /* keep the GetTime() timer running */
+      ++timeHigh;      /* and GetTime32() */
+   /* the list is sorted, so only the timers at its head can be due now */
+   while ((TMR_FirstTimer != NO_TIMER) &&
+          (TMR_TimerArray[TMR_FirstTimer] == time))
+   {
+      NextTimer2Process = TMR_FirstTimer;
+      /* stop counting, with no time left on it */
+      UnlinkTimer(NextTimer2Process);
+      TMR_TimerArray[NextTimer2Process] = 0;
+      ES_TraceTimer(NextTimer2Process);
+      /* post the timeout event to the right Service */
+      TMR_PostFunc[NextTimer2Process](TMR_Event[NextTimer2Process]); 
+   }
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+     LinkTimer
+ Parameters
+     uint8_t Num, a stopped timer with its ticks to run in TMR_TimerArray
+ Returns
+     None.
+ Description
+     turns the ticks to run into the tick to expire on and puts the timer
+     into the running list, behind every timer that expires no later
+ Notes
+     Walks the list, so the time it takes grows with the number of running
+     timers. Call it with interrupts off; all of that time counts against
+     interrupt latency.
+ Author
+     Alex Loo, 10/17/26, 20:15
+****************************************************************************/
+static void LinkTimer(uint8_t Num)
+{
+   Timer_t Ticks = TMR_TimerArray[Num];
+   uint8_t Prev = NO_TIMER;
+   uint8_t Next = TMR_FirstTimer;
+
+   /* every running timer is due within 65535 ticks of now, so comparing
+      the ticks left works across the wrap of 'time' */
+   while ((Next != NO_TIMER) &&
+          ((Timer_t)(TMR_TimerArray[Next] - time) <= Ticks))
    {
-      // start by getting a list of all the active timers
-      NeedsProcessing = TMR_ActiveFlags;
-      do{
-        // find the MSB that is set
-        NextTimer2Process = Byte2MSBitNum[NeedsProcessing-1];
-        /* decrement that timer, check if timed out */
-        if(--TMR_TimerArray[NextTimer2Process] == 0) 
-        {
-            NewEvent.EventType = ES_TIMEOUT;
-            NewEvent.EventParam = NextTimer2Process;
-            /* post the timeout event to the right Service */
-            Timer2PostFunc[NextTimer2Process](NewEvent); 
-            /* and stop counting */
-            TMR_ActiveFlags &= ~(TMR_MaskArray[NextTimer2Process]); 
-        }
-        // mark off the active timer that we just processed
-        NeedsProcessing &= BitNum2ClrMask[NextTimer2Process];
-      }while(NeedsProcessing != 0);
-      
+      Prev = Next;
+      Next = TMR_NextTimer[Next];
    }
+   TMR_TimerArray[Num] = (Timer_t)(time + Ticks);
+   TMR_PrevTimer[Num] = Prev;
+   TMR_NextTimer[Num] = Next;
+   if (Prev == NO_TIMER)
+      TMR_FirstTimer = Num;
+   else
+      TMR_NextTimer[Prev] = Num;
+   if (Next != NO_TIMER)
+      TMR_PrevTimer[Next] = Num;
+   SET_ACTIVE(Num);
+}
+
+/****************************************************************************
+ Function
+     UnlinkTimer
+ Parameters
+     uint8_t Num, a running timer
+ Returns
+     None.
+ Description
+     takes the timer out of the running list, TMR_TimerArray still holds
+     the tick it would have expired on
+ Notes
+     Call it with interrupts off.
+ Author
+     Alex Loo, 10/17/26, 20:18
+****************************************************************************/
+static void UnlinkTimer(uint8_t Num)
+{
+   uint8_t Prev = TMR_PrevTimer[Num];
+   uint8_t Next = TMR_NextTimer[Num];
+
+   if (Prev == NO_TIMER)
+      TMR_FirstTimer = Next;
+   else
+      TMR_NextTimer[Prev] = Next;
+   if (Next != NO_TIMER)
+      TMR_PrevTimer[Next] = Prev;
+   CLEAR_ACTIVE(Num);
 }
 /*------------------------------- Footnotes -------------------------------*/
 #ifdef TEST
@@ -14,6 +14,8 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/17/26 22:10 adl  ES_Timer_GetTime32 and the fine timebase
+ 10/17/26 21:30 adl  timer pool, ES_Timer_Alloc and ES_Timer_Free
  01/15/12 16:43 jec  converted for Gen2 of the Events & Services Framework
  10/21/11 18:33 jec  Begin conversion for use with the new Event Framework
  09/01/05 12:29 jec  Converted rates and return values to enumerated constants
@@ -29,6 +31,8 @@
 
 #include "Bin_Const.h"
 #include "ES_Types.h"
+#include "ES_Events.h"
+#include "ES_PostList.h"
 
 /* these assume an 8MHz OSCCLK, they are the values to be used to program
     the RTICTL regiser
@@ -48,13 +52,22 @@ typedef enum { ES_Timer_ERR           = -1,
                ES_Timer_NOT_ACTIVE    =  0
 } ES_TimerReturn_t;
 
+/* a timer from the pool, it is the timer's number */
+typedef uint8_t ES_TimerHandle_t;
+#define ES_TIMER_NO_HANDLE 0xFF
+
 void             ES_Timer_Init(TimerRate_t Rate);
+ES_TimerHandle_t ES_Timer_Alloc(pPostFunc PostFunc, ES_Event Event2Post);
+ES_TimerReturn_t ES_Timer_Free(ES_TimerHandle_t Handle);
 ES_TimerReturn_t ES_Timer_InitTimer(unsigned char Num, unsigned int NewTime);
-ES_TimerReturn_t ES_Timer_SetTimer(unsigned char Num, unsigned int NewTime);
+ES_TimerReturn_t ES_Timer_SetTimer(unsigned char Num, uint16_t NewTime);
 ES_TimerReturn_t ES_Timer_StartTimer(unsigned char Num);
 ES_TimerReturn_t ES_Timer_StopTimer(unsigned char Num);
 ES_TimerReturn_t ES_Timer_IsTimerActive(unsigned char Num);
 uint16_t     ES_Timer_GetTime(void);
+uint32_t     ES_Timer_GetTime32(void);
+uint32_t     ES_Timer_GetFineTime(void);
+void         ES_Timer_FineOverflow(void);
 
 #endif   /* ES_Timers_H */
 /*------------------------------ End of file ------------------------------*/
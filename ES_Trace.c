@@ -0,0 +1,216 @@
+/****************************************************************************
+ Module
+     ES_Trace.c
+ Description
+     The event trace. The framework writes a record (ES_Trace.h) for every
+     post, dequeue, dispatch start and end, timer expiry, and each state
+     transition that a machine reports, into a RAM ring of ES_TRACE_SIZE
+     records. The ring keeps the latest records, overwriting the oldest, like
+     a flight recorder. ES_Trace_Dump prints it, as text, for
+     Host/TraceDecode to turn into a Chrome trace / Perfetto timeline.
+ Notes
+     Records are written from ES_Run's side and from ISRs (the RTI posts
+     timeouts), so a record is claimed and filled with interrupts off. The
+     time is read first, outside the critical region (ES_Timer_GetFineTime
+     has its own), so a record written by an ISR between the 2 can carry a
+     later time than the one after it; TraceDecode allows for that.
+
+     A dump is:
+       #TRACE <version> <fine counts per uS> <records> <written>
+       #T <time, 8 hex digits><kind><who><what><extra, 2 hex digits each>
+       ...
+       #END
+     oldest record first. <written> counts the records written since the
+     last dump, so <written> - <records> were overwritten. Recording stops
+     while the dump prints, and the ring is emptied after it, so dumps
+     taken one after another join up.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 03:50 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "ES_Trace.h"
+
+#if ES_TRACE
+// the endif for ES_TRACE is at the end of the file
+
+/*----------------------------- Module Defines ----------------------------*/
+#ifndef ES_TRACE_SIZE
+#define ES_TRACE_SIZE 128
+#endif
+#if (ES_TRACE_SIZE > 32768) || (ES_TRACE_SIZE & (ES_TRACE_SIZE-1))
+#error ES_TRACE_SIZE must be a power of 2 no larger than 32768
+#endif
+
+#define ES_TRACE_MASK (ES_TRACE_SIZE-1)
+#define ES_TRACE_VERSION 1
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_TraceRecord_t Ring[ES_TRACE_SIZE];
+static uint16_t Next;           // next record to fill
+static uint32_t Total;          // records written since the last dump
+static volatile boolean Paused; // True while the dump prints
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_Trace_Init
+ Parameters
+   None
+ Returns
+   None
+ Description
+   empties the trace
+ Notes
+   called from ES_Initialize, before any of the ISRs are enabled
+ Author
+   Alex Loo, 10/18/26, 03:55
+****************************************************************************/
+void ES_Trace_Init( void )
+{
+  Next = 0;
+  Total = 0;
+  Paused = False;
+}
+
+/****************************************************************************
+ Function
+   ES_Trace_Write
+ Parameters
+   ES_TraceKind_t Kind : what the record says
+   uint8_t Who : the service, machine or timer
+   uint8_t What : the event type or state
+   uint8_t Extra : depends on Kind, see ES_Trace.h
+ Returns
+   None
+ Description
+   adds a record, stamped with ES_Timer_GetFineTime, overwriting the oldest
+   if the ring is full
+ Notes
+   use the ES_Trace* macros, which compile out without ES_TRACE. Safe from
+   an ISR, but not from inside a critical region (EnterCritical does not
+   nest on the S12)
+ Author
+   Alex Loo, 10/18/26, 03:58
+****************************************************************************/
+void ES_Trace_Write( ES_TraceKind_t Kind, uint8_t Who, uint8_t What,
+                     uint8_t Extra )
+{
+  ES_TraceRecord_t *pRecord;
+  uint32_t Now;
+
+  if ( Paused == True )
+    return;
+  Now = ES_Timer_GetFineTime();
+  EnterCritical();
+  pRecord = &Ring[Next & ES_TRACE_MASK];
+  Next++;
+  Total++;
+  pRecord->Time = Now;
+  pRecord->Kind = (uint8_t)Kind;
+  pRecord->Who = Who;
+  pRecord->What = What;
+  pRecord->Extra = Extra;
+  ExitCritical();
+}
+
+/****************************************************************************
+ Function
+   ES_Trace_Copy
+ Parameters
+   ES_TraceRecord_t * pTo : where to copy the records
+   uint16_t MaxRecords : the most to copy
+ Returns
+   uint16_t : the number copied
+ Description
+   copies out the records in the ring, oldest first; if there are more than
+   MaxRecords, the latest MaxRecords
+ Notes
+   for tests and for sending the trace some other way than ES_Trace_Dump.
+   Records written meanwhile may overwrite ones being copied
+ Author
+   Alex Loo, 10/18/26, 04:02
+****************************************************************************/
+uint16_t ES_Trace_Copy( ES_TraceRecord_t *pTo, uint16_t MaxRecords )
+{
+  uint16_t Held = (Total < ES_TRACE_SIZE) ? (uint16_t)Total : ES_TRACE_SIZE;
+  uint16_t From;
+  uint16_t i;
+
+  if ( Held > MaxRecords )
+    Held = MaxRecords;
+  From = (uint16_t)(Next - Held);
+  for ( i = 0; i < Held; i++ )
+    pTo[i] = Ring[(uint16_t)(From + i) & ES_TRACE_MASK];
+  return Held;
+}
+
+/****************************************************************************
+ Function
+   ES_Trace_QueryTotal
+ Parameters
+   None
+ Returns
+   uint32_t : the records written since the last dump, kept or not
+ Description
+   with ES_TRACE_SIZE, how many were overwritten
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 04:04
+****************************************************************************/
+uint32_t ES_Trace_QueryTotal( void )
+{
+  return Total;
+}
+
+/****************************************************************************
+ Function
+   ES_Trace_Dump
+ Parameters
+   None
+ Returns
+   None
+ Description
+   prints the ring, oldest record first, in the format given in the module
+   notes, then empties it
+ Notes
+   takes a while on the S12 (21 characters a record), so ES_Run calls it
+   when all of the queues are empty, after ES_RequestTraceDump. Nothing is
+   recorded while it prints
+ Author
+   Alex Loo, 10/18/26, 04:06
+****************************************************************************/
+void ES_Trace_Dump( void )
+{
+  ES_TraceRecord_t Record;
+  uint16_t Held;
+  uint16_t From;
+  uint16_t i;
+
+  Paused = True;
+  Held = (Total < ES_TRACE_SIZE) ? (uint16_t)Total : ES_TRACE_SIZE;
+  From = (uint16_t)(Next - Held);
+  printf( "\r\n#TRACE %d %d %u %lu\r\n", ES_TRACE_VERSION,
+          ES_PORT_FINE_PER_US, Held, (unsigned long)Total );
+  for ( i = 0; i < Held; i++ ) {
+    Record = Ring[(uint16_t)(From + i) & ES_TRACE_MASK];
+    printf( "#T %08lX%02X%02X%02X%02X\r\n", (unsigned long)Record.Time,
+            Record.Kind, Record.Who, Record.What, Record.Extra );
+  }
+  printf( "#END\r\n" );
+  EnterCritical();
+  Next = 0;
+  Total = 0;
+  Paused = False;
+  ExitCritical();
+}
+
+#endif /* ES_TRACE */
+/*------------------------------ End of file ------------------------------*/
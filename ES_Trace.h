@@ -0,0 +1,92 @@
+/****************************************************************************
+ Module
+     ES_Trace.h
+ Description
+     header file for the event trace: fixed size binary records of what the
+     framework does with each event, kept in a RAM ring and dumped on
+     request for Host/TraceDecode to turn into a timeline
+ Notes
+     ES_TRACE in ES_Configure.h turns the trace on; with it 0 (the default)
+     the ES_Trace* macros compile to nothing.
+
+     Each record is stamped with ES_Timer_GetFineTime, ES_PORT_FINE_PER_US
+     counts a microsecond. Who, What and Extra depend on the kind:
+       kind     Who       What          Extra
+       POST     service   event type    events in the queue after the post
+       DROP     service   event type    events in the queue (it was full)
+       DEQUEUE  service   event type    events left in the queue
+       START    service   event type    low byte of the event parameter
+       END      service   event type    0
+       STATE    machine   new state     old state
+       TIMER    timer     0             0
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 03:50 adl      started coding
+*****************************************************************************/
+#ifndef ES_Trace_H
+#define ES_Trace_H
+
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+#ifndef ES_TRACE
+#define ES_TRACE 0
+#endif
+
+// what a record says
+typedef enum { ES_TRACE_POST,
+               ES_TRACE_DROP,
+               ES_TRACE_DEQUEUE,
+               ES_TRACE_START,
+               ES_TRACE_END,
+               ES_TRACE_STATE,
+               ES_TRACE_TIMER } ES_TraceKind_t;
+
+typedef struct {
+   uint32_t Time;   // ES_Timer_GetFineTime
+   uint8_t Kind;    // ES_TraceKind_t
+   uint8_t Who;
+   uint8_t What;
+   uint8_t Extra;
+} ES_TraceRecord_t;
+
+#if ES_TRACE
+#define ES_TracePost(Service, ThisEvent, Depth) \
+   ES_Trace_Write(ES_TRACE_POST, (Service), (uint8_t)(ThisEvent).EventType, \
+                  (Depth))
+#define ES_TraceDrop(Service, ThisEvent, Depth) \
+   ES_Trace_Write(ES_TRACE_DROP, (Service), (uint8_t)(ThisEvent).EventType, \
+                  (Depth))
+#define ES_TraceDeQueue(Service, ThisEvent, Left) \
+   ES_Trace_Write(ES_TRACE_DEQUEUE, (Service), \
+                  (uint8_t)(ThisEvent).EventType, (Left))
+#define ES_TraceStart(Service, ThisEvent) \
+   ES_Trace_Write(ES_TRACE_START, (Service), (uint8_t)(ThisEvent).EventType, \
+                  (uint8_t)(ThisEvent).EventParam)
+#define ES_TraceEnd(Service, ThisEvent) \
+   ES_Trace_Write(ES_TRACE_END, (Service), (uint8_t)(ThisEvent).EventType, 0)
+#define ES_TraceState(Machine, OldState, NewState) \
+   ES_Trace_Write(ES_TRACE_STATE, (Machine), (uint8_t)(NewState), \
+                  (uint8_t)(OldState))
+#define ES_TraceTimer(Timer) \
+   ES_Trace_Write(ES_TRACE_TIMER, (Timer), 0, 0)
+#else
+#define ES_TracePost(Service, ThisEvent, Depth) ((void)0)
+#define ES_TraceDrop(Service, ThisEvent, Depth) ((void)0)
+#define ES_TraceDeQueue(Service, ThisEvent, Left) ((void)0)
+#define ES_TraceStart(Service, ThisEvent) ((void)0)
+#define ES_TraceEnd(Service, ThisEvent) ((void)0)
+#define ES_TraceState(Machine, OldState, NewState) ((void)0)
+#define ES_TraceTimer(Timer) ((void)0)
+#endif
+
+void     ES_Trace_Init( void );
+void     ES_Trace_Write( ES_TraceKind_t Kind, uint8_t Who, uint8_t What,
+                         uint8_t Extra );
+uint16_t ES_Trace_Copy( ES_TraceRecord_t *pTo, uint16_t MaxRecords );
+uint32_t ES_Trace_QueryTotal( void );
+void     ES_Trace_Dump( void );
+
+#endif /* ES_Trace_H */
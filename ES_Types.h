@@ -6,6 +6,11 @@ typedef unsigned char boolean;
 #define False ((boolean) 0)
 #define True  ((boolean) !False)
 
+#ifdef ES_HOST_BUILD
+/* host builds take the C99 types from the compiler so that the widths match
+   the S12 (an int is 32 bits on the host) */
+#include <stdint.h>
+#else
 /* Standard ANSI  99 C types */
 #ifndef int8_t
 typedef signed char int8_t;
@@ -27,4 +32,6 @@ typedef unsigned int  uint16_t;
 typedef unsigned long int   uint32_t;
 #endif
 
+#endif /* ES_HOST_BUILD */
+
 #endif /* TYPES_H */
\ No newline at end of file
@@ -5,10 +5,10 @@
 #include "ES_Events.h"
 #include "MasterMachine.h"
 #include "EventCheckers.h"
-#include "FSR.h"
-#include "MasterMachine.h"
-#include <stdio.h>
+#include "FieldState.h"
 #include "ES_Timers.h"
+#include "ES_Log.h"
+#include <stddef.h>
 
 
 // This include will pull in all of the headers from the service modules
@@ -17,42 +17,32 @@
 
 boolean Check4Start(void)
 {
-   static uint16_t LastTime = 0;
-   uint16_t CurrentTime;
    boolean ReturnVal = False;
    static unsigned char LastBallsInPlay = 1;
+   unsigned int BallsInPlay = 0;
    
-   CurrentTime = ES_Timer_GetTime();
+   // ES_CheckEvents only calls this in the pregame state, and no more often
+   // than the debounce interval of ~ 60 ms (EVENT_CHECK_PERIODS/_STATES)
    
-   // Only care how many balls are in play if we are in pregame state
-   // and wait for debounce interval of ~ 60 ms
-   //if ((CurrentTime - LastTime) > 30) 
-   if ((QueryMasterMachine() == PreGame) && ((CurrentTime - LastTime) > 30)) 
-   {      
-      unsigned char BallsInPlay = 0;
+   // Read how many balls are in play, as the FSR last reported it
+   if (QueryFieldState(FSR_BALLS_IN_PLAY, &BallsInPlay, NULL) != True)
+   {
+      return False; // the FSR has not answered yet
+   }
    
-      // Query the FSR to find how many balls are in play
-      BallsInPlay = Get_BallsInPlay();
-      
-      // printf for debugging
-      printf("\r\n\nLast BallsInPlay = %u", LastBallsInPlay);
-      printf("\r\nCurrent BallsInPlay = %u", BallsInPlay);  
+   if ((BallsInPlay != 0) && (LastBallsInPlay == 0))
+   {
+      // Check if FSR has transitioned from 0 to non-zero balls in play
+      // Game has started since FSR is reporting that there are balls in play
+      ES_Event ThisEvent;
+      ThisEvent.EventType = ES_GAME_START;
+      ThisEvent.EventParam = 1;
+      PostMasterMachine(ThisEvent); // this could be any SM post function or EF_PostAll
+      ReturnVal = True;
       
-      if ((BallsInPlay != 0) && (LastBallsInPlay == 0))
-      {
-         // Check if FSR has transitioned from 0 to non-zero balls in play
-         // Game has started since FSR is reporting that there are balls in play
-         ES_Event ThisEvent;
-         ThisEvent.EventType = ES_GAME_START;
-         ThisEvent.EventParam = 1;
-         PostMasterMachine(ThisEvent); // this could be any SM post function or EF_PostAll
-         ReturnVal = True;
-         
-         printf("\r\nBalls are now in play. Start the game.")         ;
-      }
-      
-      LastBallsInPlay = BallsInPlay; // update the last read value of balls in play
-      LastTime = CurrentTime; // update the last time that the FSR was queried
+      ES_LogNote(LOG_MASTER, NOTE_GAME_START, BallsInPlay);
    }
+   
+   LastBallsInPlay = (unsigned char)BallsInPlay; // update the last read value of balls in play
    return ReturnVal;
 }
\ No newline at end of file
@@ -3,5 +3,7 @@
 
 #include "EventCheckers.h"
 #include "DefendingMode.h"
+// for EVENT_CHECK_STATE_FUNC and the states in EVENT_CHECK_STATES
+#include "MasterMachine.h"
 
 #endif
\ No newline at end of file
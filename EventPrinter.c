@@ -149,6 +149,14 @@ void EventPrinter (ES_Event CurrentEvent)
          printf("\r\nThe current event is ES_NO_DANGERWALL");
       break;
       
+      case ES_FSR_RESULT:
+         printf("\r\nThe current event is ES_FSR_RESULT");
+      break;
+      
+      case ES_FSR_ERROR:
+         printf("\r\nThe current event is ES_FSR_ERROR");
+      break;
+      
       
    } // end switch
 }
\ No newline at end of file
@@ -1,21 +1,61 @@
 /****************************************************************************
    Description
          FSR.c is the source file for the custom made communication firmware.
+         Queries to the FSR are queued with FSR_Query and run in the
+         background: a pool timer sends each byte once the gap before it has
+         passed, and the SPI interrupt takes in the byte that comes back.
+         When a query has a valid answer, ES_FSR_RESULT goes into FSR_RING,
+         and ES_Run hands it on to the service that ES_Configure.h names for
+         the ring, so ES_Run never waits on the FSR and a full queue only
+         holds the answer back. A build with no rings gives FSR_POST_FUNC.
+
+         The next query to run is picked when its command goes out: any
+         query past its deadline first (earliest deadline first), then by
+         class (wall angle, then bin counts, then balls in play), then by
+         deadline.
+
+         A query gets FSR_MAX_TRIES commands. Each one that does not sync,
+         gets an answer out of range, or gets no byte back at all counts
+         against it; after the last, ES_FSR_ERROR is posted in place of the
+         answer. So however the FSR misbehaves, a query ends in bounded
+         time, and FSR_QueryStats counts what went wrong.
 
  History
  When           Who	What/Why
  -------------- ---	--------
- 02/07/12 19:13 adl  First pass
+ 10/18/26 16:30 adl  answers go through FSR_RING, FSR_Query takes no
+                     PostFunc
+ 10/18/26 16:20 adl  Get_* and WaitForQuery gone, nothing may wait on the FSR
+ 10/18/26 00:30 adl  bounded tries, a timeout on every byte, ES_FSR_ERROR and
+                     the counts in FSR_QueryStats
+ 10/17/26 23:55 adl  queries picked by deadline and class, FSR_PIPELINE,
+                     host build against Host/FSRSim.c
+ 10/17/26 22:55 adl  queries queued and run from the SPI interrupt and a
+                     timer, the result posted as ES_FSR_RESULT. Get_* now
+                     wait on a queued query
  03/11/12 11:34 kfn  Removal of ifndef DEBUG_SYNC code (only final code)
+ 02/07/12 19:13 adl  First pass
 ****************************************************************************/
 
 // Includes ****************************************************************/
+#ifndef ES_HOST_BUILD
 #include <hidef.h>          /* common defines and macros */
 #include <mc9s12e128.h>     /* derivative information */
 #include <S12e128bits.h>    /* bit definitions  */
-#include <Bin_Const.h>       
+#include <Bin_Const.h>
+#include "S12eVec.h"
+#else
+#include "FSRSim.h"         /* the SPI and the FSR behind it */
+#endif
+#include "ES_Configure.h"
+#include "ES_Port.h"        /* critical regions */
 #include "FSR.h"
 #include "ES_Timers.h"
+#ifdef FSR_RING
+#include "ES_ISRRing.h"
+#else
+#include "ES_ServiceHeaders.h" /* FSR_POST_FUNC */
+#endif
 #include <stdio.h>
 
 // Module Defines **********************************************************/
@@ -32,32 +72,114 @@
 #define _52MS 26  // Debounce for query commands
 #define _4MS 2    // Debounce for between query commands
 
+// time from a byte coming back to sending the next one: the command again,
+// more than 52 mS on, when the FSR did not sync, otherwise 4 mS
+#define SYNC_INTERVAL (_52MS + 1)
+#define BYTE_GAP _4MS
+// a byte takes under 1 mS, so one not back in 4 to 6 mS never will be
+#define BYTE_TIMEOUT 3
+
+// the answers go through an ISR ring, or with none, to a post function
+#if !defined(FSR_RING) && !defined(FSR_POST_FUNC)
+#error FSR.c needs FSR_RING or FSR_POST_FUNC in ES_Configure.h
+#endif
+
+// how many queries can wait for the FSR
+#define FSR_QUEUE_SIZE 8
+#define NO_REQUEST 0xFF
+
+// Set to 1 to send the next query's command in place of SEND_DATA when a
+// query is waiting, which saves a byte (and its gap) per query. The FSR must
+// take a command in the data slot for this: the answer to the last command
+// comes back as the next command goes out.
+#ifndef FSR_PIPELINE
+#define FSR_PIPELINE 0
+#endif
+
+// the SPI interrupt; on the host FSRSim runs it when a transfer is done
+#ifndef ES_HOST_BUILD
+#define FSR_SPI_VECTOR interrupt _Vec_spi
+#else
+#define FSR_SPI_VECTOR
+#endif
+
+// Module Types ************************************************************/
+typedef enum { FSR_IDLE,        // no query to run
+               FSR_COMMAND_DUE, // the timer will send the next command
+               FSR_AWAIT_SYNC,  // command sent, waiting on the sync byte
+               FSR_DATA_DUE,    // synced, the timer will ask for the data
+               FSR_AWAIT_DATA   // waiting on the answer
+             } FSRState_t;
+
+typedef enum { REQUEST_FREE, REQUEST_WAITING, REQUEST_RUNNING } RequestStatus_t;
+
+typedef struct {
+   FSR_Query_t Query;
+   uint16_t Deadline;           // in ES_Timer_GetTime ticks
+   uint16_t AskTime;            // when FSR_Query was called
+   unsigned char Tries;         // commands sent for it
+   RequestStatus_t Status;
+} FSRRequest_t;
+
 // Module Private Functions ************************************************/
-static unsigned char PingSPI(unsigned char Command);
-static void SyncFirstByte(unsigned char Command);  //Syncs first byte to read FSR correctly
+static boolean GapTimerPost(ES_Event ThisEvent);
+static void ByteReceived(unsigned char Response);
+static void QueryDone(ES_EventTyp_t EventType, unsigned int Value);
+static void TryFailed(FSR_Error_t Error);
+static void NextCommand(void);
+static unsigned char PickNext(void);
+static boolean RunsBefore(unsigned char This, unsigned char That,
+                          uint16_t Now);
+static void Requeue(unsigned char *pRequest);
+static void SendByte(unsigned char Byte);
 
 // Module Variables ********************************************************/
-// unsigned int counter = 0; /* used for debugging */
-static uint16_t LastTime = 0; // uint16 LastTime for last query time
-static uint16_t LastSecondByte = 0; //uint16_t LastSecondByte for last time of second byte command
+// the command byte, the range of good answers, and the class (0 runs
+// first) of each query
+static const unsigned char QueryCommand[FSR_NUM_QUERIES] =
+   { QUERY_BALL, QUERY_BIN1, QUERY_BIN2, QUERY_BIN3, QUERY_BIN4, QUERY_WALL };
+static const unsigned char MinResponse[FSR_NUM_QUERIES] =
+   { 0x80, 0x01, 0x01, 0x01, 0x01, 0x01 };
+static const unsigned char MaxResponse[FSR_NUM_QUERIES] =
+   { 0xF8, 0xF1, 0xF1, 0xF1, 0xF1, 0xB4 };
+static const unsigned char QueryClass[FSR_NUM_QUERIES] =
+   { 2, 1, 1, 1, 1, 0 };
+
+static FSRState_t CurrentState = FSR_IDLE;
+static ES_TimerHandle_t GapTimer = ES_TIMER_NO_HANDLE;
+
+// the queries, in no order. Current is the one the FSR is answering and,
+// with FSR_PIPELINE, Chained the one whose command went out in its data slot
+static FSRRequest_t Requests[FSR_QUEUE_SIZE];
+static unsigned char Current = NO_REQUEST;
+#if FSR_PIPELINE
+static unsigned char Chained = NO_REQUEST;
+#endif
+
+// what has gone wrong, see FSR_QueryStats
+static FSR_Stats_t Stats;
 
 // Module Code *************************************************************/
 /***************************************************************************
 Function
    SPI_Init
-   
+
 Parameters
    None
-   
+
 Returns
    None
-   
+
 Description
-   This function initializes the spi communication module
+   This function initializes the spi communication module, and takes the
+   timer that spaces the bytes from the timer pool
 
 ****************************************************************************/
 void SPI_Init(void)
 {
+   ES_Event ThisEvent;
+
+#ifndef ES_HOST_BUILD
    // Set the baud rate.
    SPIBR = _S12_SPPR2|_S12_SPPR1|_S12_SPPR0|_S12_SPR2|_S12_SPR1|_S12_SPR0;
    // Initialize the clock. Want mode 3 control:
@@ -67,237 +189,561 @@ void SPI_Init(void)
    // SS Control:
    SPICR1 |= _S12_SSOE; // Enable slave select line
    SPICR2 |= _S12_MODFEN; // Enable mode fault
+   // Interrupt when a byte has come back
+   SPICR1 |= _S12_SPIE;
    // Enable SPI.
    SPICR1 |= _S12_SPE;
+#endif
+
+   // The timer's event only reaches GapTimerPost, so what is in it is unused
+   ThisEvent.EventType = ES_TIMEOUT;
+   ThisEvent.EventParam = 0;
+   GapTimer = ES_Timer_Alloc(GapTimerPost, ThisEvent);
+   if (GapTimer == ES_TIMER_NO_HANDLE)
+   {
+      printf("\r\nNo timer for the FSR, raise ES_NUM_TIMERS.");
+   }
 }
 
-// Module Code ***************************************************
 /****************************************************************************
 Function
-   Get_BallsInPlay 
-     
+   FSR_Query
+
 Parameters
-   none 
-   
+   FSR_Query_t Query : what to ask the FSR
+   uint16_t Deadline : timer ticks from now by which the answer is wanted
+
 Returns
-   unsigned char   
-   
+   boolean : False if too many queries are already waiting
+
 Description
-   This function queries the FSR via SPI to return number of balls in play
-   
+   Queues a query to the FSR. Once it has a valid answer, ES_FSR_RESULT is
+   posted through FSR_RING (or to FSR_POST_FUNC), with the query and the answer in EventParam (see
+   FSR_RESULT_QUERY and FSR_RESULT_VALUE). If FSR_MAX_TRIES commands bring
+   no answer, ES_FSR_ERROR is posted instead, with the query and what went
+   wrong last (FSR_ERROR_CODE).
+
+Notes
+   The answer is posted from an interrupt, so it goes to the service of
+   FSR_RING whoever asked; FieldState is the one that asks. A query past its deadline still
+   runs, ahead of those that are not.
+
 ****************************************************************************/
-unsigned char Get_BallsInPlay(void)
+boolean FSR_Query(FSR_Query_t Query, uint16_t Deadline)
 {
-   //Local Variables: Time, Response
-   unsigned int Time;
-   unsigned char Response;
+   boolean Start = False;
+   unsigned char i;
+
+   EnterCritical();
+   //Find a free request
+   for (i = 0; i < FSR_QUEUE_SIZE; i++)
+   {
+      if (Requests[i].Status == REQUEST_FREE)
+      {
+         break;
+      }
+   }
+   //If there is no room for the query
+   if (i == FSR_QUEUE_SIZE)
+   {
+      ExitCritical();
+      return False;
+   } //Endif
+   Requests[i].Query = Query;
+   Requests[i].AskTime = ES_Timer_GetTime();
+   Requests[i].Deadline = Requests[i].AskTime + Deadline;
+   Requests[i].Tries = 0;
+   Requests[i].Status = REQUEST_WAITING;
+   //If nothing was running, a command is next
+   if (CurrentState == FSR_IDLE)
+   {
+      CurrentState = FSR_COMMAND_DUE;
+      Start = True;
+   } //Endif
+   ExitCritical();
 
-   //Do
-   do 
+   // nothing else starts the timer while the FSR is idle, and the timer
+   // functions turn interrupts off themselves
+   if (Start == True)
    {
-   	//Call SyncFirstByte to keep querying until sync'd the command (first) byte
-		SyncFirstByte(QUERY_BALL);
-		//Set Time to current time
-		Time = ES_Timer_GetTime();
-		//Debounce 2 mS
-		while(ES_Timer_GetTime()-Time < 2)
-		{}	
-		//Set Response to second command byte from PingSPI with parameter SEND_DATA
-		Response = PingSPI(SEND_DATA);
-		//Update LastTime to current time
-		LastTime = ES_Timer_GetTime();
-   } //While get a non-valid response 
-   while ((Response < 0x80) || (Response > 0xF8));
-    
-   //Return Response - 0x80
-	return (Response - 0x80);
-}  //End of Get_BallsInPlay
+      ES_Timer_InitTimer(GapTimer, BYTE_GAP);
+   }
+   return True;
+}
 
 /****************************************************************************
 Function
-   Get_BallsInBin 
-     
+   FSR_QueryStats
+
 Parameters
-   char BinNumber 
-   
+   FSR_Stats_t * pStats : where to copy the counts
+
 Returns
-   unsigned char  
-   
+   None
+
 Description
-   This function queries the FSR via SPI to return number of balls in a bin
-   
+   Copies out the counts of answers, failures, retries and the longest
+   time a query took, since the start or FSR_ClearStats
+
 ****************************************************************************/
-unsigned char Get_BallsInBin(char BinNumber)
+void FSR_QueryStats(FSR_Stats_t *pStats)
 {
-   //Local Variables: Time, BinCommand = QUERY_BIN1, Response
-   unsigned int Time;
-   unsigned char BinCommand = QUERY_BIN1;
-   unsigned char Response;
+   EnterCritical();
+   *pStats = Stats;
+   ExitCritical();
+}
+
+/****************************************************************************
+Function
+   FSR_ClearStats
+
+Parameters
+   None
+
+Returns
+   None
+
+Description
+   Sets the counts back to 0
 
-   //Choose one of the following cases based on BinNumber
-   switch (BinNumber)
+****************************************************************************/
+void FSR_ClearStats(void)
+{
+   EnterCritical();
+   Stats.Answered = 0;
+   Stats.Failed = 0;
+   Stats.Retries = 0;
+   Stats.SyncFailures = 0;
+   Stats.OutOfRange = 0;
+   Stats.NoReply = 0;
+   Stats.LongestTicks = 0;
+   ExitCritical();
+}
+
+/****************************************************************************
+Interrupt Service Routine
+   FSR_SPIResp
+
+Description
+   Takes in the byte that came back from the FSR when a transfer finishes
+****************************************************************************/
+void FSR_SPI_VECTOR FSR_SPIResp(void)
+{
+#ifndef ES_HOST_BUILD
+   //If a transfer has finished
+   if ((SPISR & _S12_SPIF) != 0)
+   {
+      //Reading SPIDR clears SPIF
+      ByteReceived(SPIDR);
+   } //Endif
+#else
+   ByteReceived(FSRSim_Read());
+#endif
+}
+
+// Private Functions *******************************************************/
+/****************************************************************************
+Function
+   GapTimerPost
+
+Parameters
+   ES_Event ThisEvent : the gap timer's timeout, unused
+
+Returns
+   boolean, always True
+
+Description
+   The gap before the next byte has passed, so send it; or a byte sent has
+   not come back in time
+
+Notes
+   Runs from the timer interrupt. Every byte is sent with the timer set to
+   BYTE_TIMEOUT, which the byte coming back replaces with the next gap
+
+****************************************************************************/
+static boolean GapTimerPost(ES_Event ThisEvent)
+{
+   (void)ThisEvent;
+
+   switch (CurrentState)
    {
-      // 1
-      case 1:
-         //Set BinCommand to QUERY_BIN1
-         BinCommand = QUERY_BIN1;
+      case FSR_COMMAND_DUE:
+         //Pick the query to run and send its command, the FSR answers
+         //with SYNC_BYTE
+         Current = PickNext();
+         if (Current != NO_REQUEST)
+         {
+            Requests[Current].Status = REQUEST_RUNNING;
+            Requests[Current].Tries++;
+            CurrentState = FSR_AWAIT_SYNC;
+            SendByte(QueryCommand[Requests[Current].Query]);
+         }
+         else
+         {
+            CurrentState = FSR_IDLE;
+         }
       break;
-      // 2
-      case 2:
-         //Set BinCommand to QUERY_BIN2
-         BinCommand = QUERY_BIN2;
+
+      case FSR_DATA_DUE:
+         CurrentState = FSR_AWAIT_DATA;
+#if FSR_PIPELINE
+         //If another query is waiting, its command clocks out the answer
+         Chained = PickNext();
+         if (Chained != NO_REQUEST)
+         {
+            Requests[Chained].Status = REQUEST_RUNNING;
+            Requests[Chained].Tries++;
+            SendByte(QueryCommand[Requests[Chained].Query]);
+            break;
+         }
+#endif
+         //Ask for the answer
+         SendByte(SEND_DATA);
       break;
-      // 3
-      case 3:
-         //Set BinCommand to QUERY_BIN3
-         BinCommand = QUERY_BIN3;
+
+      case FSR_AWAIT_SYNC:
+      case FSR_AWAIT_DATA:
+         //The byte never came back
+         Stats.NoReply++;
+         TryFailed(FSR_ERR_NO_REPLY);
       break;
-      // 4
-      case 4:
-         //Set BinCommand to QUERY_BIN4
-         BinCommand = QUERY_BIN4;
-      break;   
-   } //End of case structure on BinNumber
-   
-   //Do
-   do 
-   {
-   	//Call SyncFirstByte to keep querying until sync'd the command (first) byte
-		SyncFirstByte(BinCommand);
-		//Set Time to current time
-		Time = ES_Timer_GetTime();
-		//Debounce 2 mS
-		while(ES_Timer_GetTime()-Time < 2)
-		{}	
-		//Set Response to second command byte from PingSPI with parameter SEND_DATA
-		Response = PingSPI(SEND_DATA);
-		//Update LastTime to current time
-		LastTime = ES_Timer_GetTime();
-   } //While get a non-valid response
-   while ((Response < 0x01) || (Response > 0xF1));
-   //Return Response - 1, the actual number of balls in bin
-   return (Response - 1);
-}  //End of Get_BallsInBin
+
+      default:
+         // nothing is due
+      break;
+   }
+   return True;
+}
 
 /****************************************************************************
 Function
-   Get_WallAngle  
-    
+   ByteReceived
+
 Parameters
+   unsigned char Response : the byte that came back from the FSR
+
+Returns
    None
-   
+
+Description
+   Moves the running query on, from the byte that came back: on to the data
+   once the FSR has synced, done once it sends a valid answer, and back to
+   syncing if it does not
+
+Notes
+   Runs from the SPI interrupt, or the timer's when a try fails. If FSR_RING
+   is full the answer is lost, and the asker must ask again
+
+****************************************************************************/
+static void ByteReceived(unsigned char Response)
+{
+   FSR_Query_t Query;
+
+   switch (CurrentState)
+   {
+      case FSR_AWAIT_SYNC:
+         //If the FSR has synced, ask for the data next
+         if (Response == SYNC_BYTE)
+         {
+            CurrentState = FSR_DATA_DUE;
+            ES_Timer_InitTimer(GapTimer, BYTE_GAP);
+         }
+         //Else that try failed
+         else
+         {
+            Stats.SyncFailures++;
+            TryFailed(FSR_ERR_SYNC);
+         } //Endif
+      break;
+
+      case FSR_AWAIT_DATA:
+         Query = Requests[Current].Query;
+         //If the answer is in range, convert it and hand it back
+         if ((Response >= MinResponse[Query]) &&
+             (Response <= MaxResponse[Query]))
+         {
+            Stats.Answered++;
+            if (Query == FSR_BALLS_IN_PLAY)
+            {
+               QueryDone(ES_FSR_RESULT, Response - 0x80);
+            }
+            else if (Query == FSR_WALL_ANGLE)
+            {
+               QueryDone(ES_FSR_RESULT, 2*((unsigned int)Response - 1));
+            }
+            else
+            {
+               // the actual number of balls in bin
+               QueryDone(ES_FSR_RESULT, Response - 1);
+            } //Endif
+         }
+         //Else that try failed
+         else
+         {
+            Stats.OutOfRange++;
+            TryFailed(FSR_ERR_RANGE);
+         } //Endif
+      break;
+
+      default:
+         // a byte we did not ask for
+      break;
+   }
+}
+
+/****************************************************************************
+Function
+   QueryDone
+
+Parameters
+   ES_EventTyp_t EventType : ES_FSR_RESULT, or ES_FSR_ERROR
+   unsigned int Value : the answer to the running query, or the error
+
 Returns
-   unsigned int  
-    
+   None
+
 Description
-   This function queries the FSR via SPI to return the current wall angle
-   
+   Posts the answer, frees the query and moves on to the next one
+
+Notes
+   Runs from the SPI interrupt
+
 ****************************************************************************/
-unsigned int Get_WallAngle(void)
+static void QueryDone(ES_EventTyp_t EventType, unsigned int Value)
 {
-   //Local Variables: Time, Response
-   unsigned int Time;
-   unsigned char Response;
-   
-   //Do
-   do 
+   ES_Event ThisEvent;
+   FSRRequest_t Done = Requests[Current];
+   uint16_t Ticks = ES_Timer_GetTime() - Done.AskTime;
+
+   if (Ticks > Stats.LongestTicks)
+   {
+      Stats.LongestTicks = Ticks;
+   }
+   Requests[Current].Status = REQUEST_FREE;
+   Current = NO_REQUEST;
+#if FSR_PIPELINE
+   //If the next query's command is already in, its answer is next
+   if (Chained != NO_REQUEST)
    {
-   	//Call SyncFirstByte to keep querying until sync'd the command (first) byte
-		SyncFirstByte(QUERY_WALL);
-		//Set Time to current time
-		Time = ES_Timer_GetTime();
-		//Debounce 2 mS
-		while(ES_Timer_GetTime()-Time < 2)
-		{}	
-		//Set Response to second command byte from PingSPI with parameter SEND_DATA
-		Response = PingSPI(SEND_DATA);
-		//Update LastTime to current time
-		LastTime = ES_Timer_GetTime();
-   } //While get a non-valid response
-   while ((Response < 0x01) || (Response > 0xB4));
-
-   //Return wall angle conversion
-   return 2*((unsigned int)Response-1);
-}  //End of Get_WallAngle
+      Current = Chained;
+      Chained = NO_REQUEST;
+      CurrentState = FSR_DATA_DUE;
+      ES_Timer_InitTimer(GapTimer, BYTE_GAP);
+   }
+   else
+#endif
+   {
+      NextCommand();
+   }
+
+   ThisEvent.EventType = EventType;
+   ThisEvent.EventParam = FSR_RESULT_PARAM(Done.Query, Value);
+#ifdef FSR_RING
+   ES_ISRRing_Post(FSR_RING, ThisEvent);
+#else
+   FSR_POST_FUNC(ThisEvent);
+#endif
+}
 
 /****************************************************************************
 Function
-   PingSPI
-      
+   TryFailed
+
 Parameters
-   unsigned char Command  
-   
+   FSR_Error_t Error : what went wrong
+
 Returns
-   unsigned char Response  
-    
+   None
+
 Description
-   This function queries the FSR via SPI
-   
+   Gives up on the running query if that was its last try, otherwise puts
+   it back to be picked again, and starts over with a command. After no
+   sync the FSR needs a while to get ready for one; otherwise it already
+   is (SEND_DATA or the timeout has put it back to sync)
+
+Notes
+   Runs from an interrupt. With FSR_PIPELINE, a query whose command went
+   out in the data slot goes back too, without losing a try
+
 ****************************************************************************/
-static unsigned char PingSPI(unsigned char Command)
+static void TryFailed(FSR_Error_t Error)
 {
-   //Local variable: Response, Time
-   unsigned char Response = 0xFE;
-   unsigned int Time;  
-     
-   //If Slave has an empty transmit register
-   if ((SPISR & _S12_SPTEF) != 1)
+#if FSR_PIPELINE
+   if (Chained != NO_REQUEST)
    {
-      // Write Query_Command to the SPIDR to transmit new data
-      SPIDR = Command;
-   }  //Endif           
-   
-   //Set Time to current time
-   Time = ES_Timer_GetTime();
-   //Debounce for 2 mS
-   while(ES_Timer_GetTime()-Time<2)
-   {}  
-   
-   //If there is currently a command waiting to be read
-   if ((SPISR & _S12_SPIF) != 0)
+      Requests[Chained].Tries--;
+      Requeue(&Chained);
+   }
+#endif
+   if (Requests[Current].Tries >= FSR_MAX_TRIES)
    {
-      //Store what is in the SPIDR register to Response
-      Response = SPIDR;
-   } //Endif         
-   
-   // Return Response
-   return Response;
-}  //End of PingSPI
+      Stats.Failed++;
+      QueryDone(ES_FSR_ERROR, Error);
+      //Still give the FSR time to get ready after no sync
+      if ((Error == FSR_ERR_SYNC) && (CurrentState == FSR_COMMAND_DUE))
+      {
+         ES_Timer_InitTimer(GapTimer, SYNC_INTERVAL);
+      }
+      return;
+   }
+   Stats.Retries++;
+   Requeue(&Current);
+   CurrentState = FSR_COMMAND_DUE;
+   ES_Timer_InitTimer(GapTimer, (Error == FSR_ERR_SYNC) ? SYNC_INTERVAL
+                                                         : BYTE_GAP);
+}
 
 /****************************************************************************
 Function
-   SyncFirstByte 
-     
+   NextCommand
+
+Parameters
+   None
+
+Returns
+   None
+
+Description
+   Sends the next command after the gap if a query is waiting, otherwise
+   leaves the FSR idle
+
+****************************************************************************/
+static void NextCommand(void)
+{
+   unsigned char i;
+
+   for (i = 0; i < FSR_QUEUE_SIZE; i++)
+   {
+      if (Requests[i].Status == REQUEST_WAITING)
+      {
+         CurrentState = FSR_COMMAND_DUE;
+         ES_Timer_InitTimer(GapTimer, BYTE_GAP);
+         return;
+      }
+   }
+   CurrentState = FSR_IDLE;
+}
+
+/****************************************************************************
+Function
+   PickNext
+
 Parameters
-   unsigned char Command 
-    
+   None
+
 Returns
-   unsigned char Response 
-    
+   unsigned char : the waiting query to run next, NO_REQUEST if none
+
 Description
-   This sends the first command query byte to the FSR until it is sync'd. 
-                                                                               
+   Picks the waiting query that RunsBefore all the others
+
 ****************************************************************************/
-static void SyncFirstByte(unsigned char Command)
+static unsigned char PickNext(void)
 {
-   //Local Variables: CurrentTime, LastTimeSync, Response
-   uint16_t CurrentTime = 0; 
-   uint16_t LastTimeSync = 0;
-   unsigned char Response = 0xFE;
-   
-   //Do
-   do
+   unsigned char Best = NO_REQUEST;
+   uint16_t Now = ES_Timer_GetTime();
+   unsigned char i;
+
+   for (i = 0; i < FSR_QUEUE_SIZE; i++)
    {
-      //Set CurrentTime to current time
-      CurrentTime = ES_Timer_GetTime();
-      //If at least 50 ms have elapsed since the last time the FSR has been queried
-      if((CurrentTime - LastTimeSync) > 26)
+      if ((Requests[i].Status == REQUEST_WAITING) &&
+          ((Best == NO_REQUEST) || (RunsBefore(i, Best, Now) == True)))
       {
-         //Set Response to value of function PingSPI with parameter Command
-         Response = PingSPI(Command);
-         //Update LastTimeSync to the current time
-         LastTimeSync = ES_Timer_GetTime();  
-      } //Endif
-   } //While not synced
-   while (Response != SYNC_BYTE);
-}  //End of SyncFirstByte
\ No newline at end of file
+         Best = i;
+      }
+   }
+   return Best;
+}
+
+/****************************************************************************
+Function
+   RunsBefore
+
+Parameters
+   unsigned char This, That : 2 waiting queries
+   uint16_t Now : the time now
+
+Returns
+   boolean : True if This should run before That
+
+Description
+   A query past its deadline runs before one that is not; otherwise the
+   lower class runs first; otherwise the earlier deadline does
+
+Notes
+   Deadlines are compared as differences, so they may wrap
+
+****************************************************************************/
+static boolean RunsBefore(unsigned char This, unsigned char That,
+                          uint16_t Now)
+{
+   boolean ThisLate = ((int16_t)(Requests[This].Deadline - Now) < 0);
+   boolean ThatLate = ((int16_t)(Requests[That].Deadline - Now) < 0);
+   unsigned char ThisClass = QueryClass[Requests[This].Query];
+   unsigned char ThatClass = QueryClass[Requests[That].Query];
+
+   if (ThisLate != ThatLate)
+   {
+      return ThisLate;
+   }
+   if ((ThisLate == False) && (ThisClass != ThatClass))
+   {
+      return (ThisClass < ThatClass) ? True : False;
+   }
+   return ((int16_t)(Requests[This].Deadline - Requests[That].Deadline) < 0)
+          ? True : False;
+}
+
+/****************************************************************************
+Function
+   Requeue
+
+Parameters
+   unsigned char * pRequest : Current or Chained
+
+Returns
+   None
+
+Description
+   Puts a running query back to wait, to be picked again
+
+****************************************************************************/
+static void Requeue(unsigned char *pRequest)
+{
+   if (*pRequest != NO_REQUEST)
+   {
+      Requests[*pRequest].Status = REQUEST_WAITING;
+      *pRequest = NO_REQUEST;
+   }
+}
+
+/****************************************************************************
+Function
+   SendByte
+
+Parameters
+   unsigned char Byte : the byte to send
+
+Returns
+   None
+
+Description
+   Starts a transfer, SPIF interrupts when the FSR's byte has come back.
+   Sets the timer to catch a byte that does not.
+
+****************************************************************************/
+static void SendByte(unsigned char Byte)
+{
+   ES_Timer_InitTimer(GapTimer, BYTE_TIMEOUT);
+#ifndef ES_HOST_BUILD
+   //If the transmit register is empty (and the status has been read)
+   if ((SPISR & _S12_SPTEF) != 0)
+   {
+      // Write the byte to the SPIDR to transmit it
+      SPIDR = Byte;
+   } //Endif
+#else
+   FSRSim_Write(Byte);
+   FSR_SPIResp(); // the transfer is over at once
+#endif
+}
@@ -5,16 +5,65 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 16:30 adl  FSR_Query takes no PostFunc, see FSR_RING
+ 10/18/26 16:20 adl  no more Get_*, ask with FSR_Query
+ 10/18/26 00:30 adl  ES_FSR_ERROR, FSR_MAX_TRIES and FSR_QueryStats
+ 10/17/26 23:55 adl  FSR_Query takes a deadline
+ 10/17/26 22:55 adl  FSR_Query and the ES_FSR_RESULT parameter
  02/07/12 19:13 adl  First pass
 ****************************************************************************/
 
 #ifndef FSR_H
 #define FSR_H
 
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "ES_PostList.h"
+
+// the queries that the FSR answers
+typedef enum { FSR_BALLS_IN_PLAY,
+               FSR_BALLS_IN_BIN1,
+               FSR_BALLS_IN_BIN2,
+               FSR_BALLS_IN_BIN3,
+               FSR_BALLS_IN_BIN4,
+               FSR_WALL_ANGLE,
+               FSR_NUM_QUERIES } FSR_Query_t;
+
+// ES_FSR_RESULT carries the query in the top 4 bits of its EventParam and
+// the answer (balls, or the wall angle in degrees) in the other 12
+#define FSR_RESULT_PARAM(Query, Value) \
+                            ((uint16_t)(((uint16_t)(Query) << 12) | (Value)))
+#define FSR_RESULT_QUERY(Param) ((FSR_Query_t)((Param) >> 12))
+#define FSR_RESULT_VALUE(Param) ((Param) & 0x0FFF)
+
+// the commands sent for a query before it fails with ES_FSR_ERROR
+#ifndef FSR_MAX_TRIES
+#define FSR_MAX_TRIES 4
+#endif
+
+// ES_FSR_ERROR carries the query as ES_FSR_RESULT does, and in place of the
+// answer, what went wrong on the last try
+typedef enum { FSR_ERR_SYNC = 1,     // the FSR did not sync to the command
+               FSR_ERR_RANGE,        // its answer was out of range
+               FSR_ERR_NO_REPLY      // no byte came back at all
+             } FSR_Error_t;
+#define FSR_ERROR_CODE(Param) ((FSR_Error_t)((Param) & 0x0FFF))
+
+// counts kept since the start or FSR_ClearStats
+typedef struct {
+   uint16_t Answered;      // queries answered
+   uint16_t Failed;        // queries given up, ES_FSR_ERROR posted
+   uint16_t Retries;       // tries failed and tried again
+   uint16_t SyncFailures;  // commands the FSR did not sync to
+   uint16_t OutOfRange;    // answers out of range
+   uint16_t NoReply;       // bytes that never came back
+   uint16_t LongestTicks;  // longest from FSR_Query to its answer or error
+} FSR_Stats_t;
+
 // function prototypes
 void SPI_Init(void);
-unsigned char Get_BallsInPlay(void);   
-unsigned char Get_BallsInBin(char BinNumber);   
-unsigned int Get_WallAngle(void);   
+boolean FSR_Query(FSR_Query_t Query, uint16_t Deadline);
+void FSR_QueryStats(FSR_Stats_t *pStats);
+void FSR_ClearStats(void);
 
-#endif 
\ No newline at end of file
+#endif 
@@ -0,0 +1,318 @@
+/****************************************************************************
+ Module
+   FieldState.c
+
+ Revision
+   1.0.1
+
+ Description
+   The field state service. It asks the FSR each of its queries in turn and
+   keeps the latest answer to each, with the time it came in, so that the
+   rest of the robot reads the wall angle, the bin counts and the balls in
+   play from here without waiting on the FSR.
+
+ Notes
+   Every query that is due goes to the FSR at once, each due back within
+   FIELD_STATE_REFRESH ticks, and FSR.c orders them. An answer younger than
+   FIELD_STATE_REFRESH ticks is not asked for again; the service waits, on
+   its timer, for the next to age. A query the FSR gives up on
+   (ES_FSR_ERROR) leaves the old answer in place, aging, and is asked again.
+   So does one with no word back within ASK_TIMEOUT ticks: the answers wait
+   in FSR_RING while this queue is full, but one that finds the ring full
+   too is lost, and the query must not then count as being asked for ever.
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:30 adl      answers come through FSR_RING
+ 10/18/26 14:30 adl      a query with no answer in ASK_TIMEOUT is asked again
+ 10/18/26 00:45 adl      ES_FSR_ERROR
+ 10/17/26 23:58 adl      all due queries asked at once, FSR.c picks the order
+ 10/17/26 23:20 adl      started coding
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "FieldState.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// how often to try the FSR again when it has no room for a query
+#define RETRY_INTERVAL 1
+
+// how long to wait for the FSR's word on a query before taking it as lost,
+// well past the FSR's own deadline of FIELD_STATE_REFRESH
+#define ASK_TIMEOUT (2*FIELD_STATE_REFRESH)
+
+/*---------------------------- Module Functions ---------------------------*/
+static void AskDue( void );
+static uint16_t AgeOf( FSR_Query_t Query, uint32_t Now );
+
+/*---------------------------- Module Variables ---------------------------*/
+// with the introduction of Gen2, we need a module level Priority var as well
+static uint8_t MyPriority;
+
+// the timer that says when to ask the FSR again
+static ES_TimerHandle_t PollTimer;
+
+// the snapshot: the latest answer to each query, when it came in, and
+// which queries have been answered at all
+static unsigned int Value[FSR_NUM_QUERIES];
+static uint32_t AnswerTime[FSR_NUM_QUERIES];
+static uint8_t Answered;
+
+// the queries that the FSR is working on, and when each was asked
+static uint8_t Asking;
+static uint32_t AskTime[FSR_NUM_QUERIES];
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     InitFieldState
+
+ Parameters
+     uint8_t : the priorty of this service
+
+ Returns
+     boolean, False if error in initialization, True otherwise
+
+ Description
+     Saves away the priority, takes a timer from the pool and starts it, so
+     that the first query goes out once every service has been initialized
+ Notes
+
+ Author
+     Alex Loo, 10/17/26, 23:25
+****************************************************************************/
+boolean InitFieldState ( uint8_t Priority )
+{
+  ES_Event ThisEvent;
+
+  MyPriority = Priority;
+
+  ThisEvent.EventType = ES_TIMEOUT;
+  ThisEvent.EventParam = 0;
+  PollTimer = ES_Timer_Alloc(PostFieldState, ThisEvent);
+  if (PollTimer == ES_TIMER_NO_HANDLE)
+  {
+     printf("\r\nOut of timers, raise ES_NUM_TIMERS.");
+     return False;
+  }
+  ES_Timer_InitTimer(PollTimer, RETRY_INTERVAL);
+  return True;
+}
+
+/****************************************************************************
+ Function
+     PostFieldState
+
+ Parameters
+     EF_Event ThisEvent , the event to post to the queue
+
+ Returns
+     boolean False if the Enqueue operation failed, True otherwise
+
+ Description
+     Posts an event to this service's queue
+ Notes
+
+ Author
+     Alex Loo, 10/17/26, 23:26
+****************************************************************************/
+boolean PostFieldState( ES_Event ThisEvent )
+{
+  return ES_PostToService( MyPriority, ThisEvent);
+}
+
+/****************************************************************************
+ Function
+    RunFieldState
+
+ Parameters
+   ES_Event : the event to process
+
+ Returns
+   ES_Event, ES_NO_EVENT
+
+ Description
+   Keeps each answer from the FSR, then asks any query that is due, which
+   includes one the FSR has just given up on
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 23:28
+****************************************************************************/
+ES_Event RunFieldState( ES_Event ThisEvent )
+{
+   ES_Event ReturnEvent;
+   FSR_Query_t Query;
+
+   ReturnEvent.EventType = ES_NO_EVENT;
+
+   switch (ThisEvent.EventType)
+   {
+      case ES_FSR_RESULT:
+         // Keep the answer and when it came in
+         Query = FSR_RESULT_QUERY(ThisEvent.EventParam);
+         Value[Query] = FSR_RESULT_VALUE(ThisEvent.EventParam);
+         AnswerTime[Query] = ES_Timer_GetTime32();
+         Answered |= (uint8_t)(1 << Query);
+         Asking &= (uint8_t)~(1 << Query);
+         AskDue();
+      break;
+
+      case ES_FSR_ERROR:
+         // No answer this time; the old one, if any, stays and gets older
+         Query = FSR_RESULT_QUERY(ThisEvent.EventParam);
+         Asking &= (uint8_t)~(1 << Query);
+         AskDue();
+      break;
+
+      case ES_TIMEOUT:
+         // Time to look again for queries that are due
+         AskDue();
+      break;
+
+      default:
+      break;
+   }
+   return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+    QueryFieldState
+
+ Parameters
+   FSR_Query_t Query : the answer wanted
+   unsigned int * pValue : where to put the answer
+   uint16_t * pAge : where to put its age in timer ticks, or NULL
+
+ Returns
+   boolean, False if the FSR has not answered that query yet
+
+ Description
+   Reads the latest answer from the snapshot, without waiting on the FSR
+ Notes
+   The age saturates at 0xFFFF
+ Author
+   Alex Loo, 10/17/26, 23:32
+****************************************************************************/
+boolean QueryFieldState( FSR_Query_t Query, unsigned int *pValue,
+                         uint16_t *pAge )
+{
+   if ((Query >= FSR_NUM_QUERIES) || ((Answered & (1 << Query)) == 0))
+   {
+      return False;
+   }
+   *pValue = Value[Query];
+   if (pAge != NULL)
+   {
+      *pAge = AgeOf(Query, ES_Timer_GetTime32());
+   }
+   return True;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+ Function
+    AskDue
+
+ Parameters
+   None
+
+ Returns
+   None
+
+ Description
+   Asks the FSR every query that it is not already working on and that has
+   no answer or an answer at least FIELD_STATE_REFRESH ticks old, then sets
+   the timer for when the next will be
+ Notes
+   A query asked ASK_TIMEOUT ticks ago with no word back is taken as lost
+   and is asked again, so the timer runs even while every query is out
+
+ Author
+   Alex Loo, 10/17/26, 23:35
+****************************************************************************/
+static void AskDue( void )
+{
+   uint32_t Now = ES_Timer_GetTime32();
+   uint16_t Age;
+   uint32_t Asked;
+   uint16_t Wait = FIELD_STATE_REFRESH;
+   unsigned char Query;
+
+   for (Query = 0; Query < FSR_NUM_QUERIES; Query++)
+   {
+      if ((Asking & (1 << Query)) != 0)
+      {
+         Asked = Now - AskTime[Query];
+         if (Asked < ASK_TIMEOUT)
+         {
+            if (ASK_TIMEOUT - Asked < Wait)
+            {
+               Wait = (uint16_t)(ASK_TIMEOUT - Asked);
+            }
+            continue;
+         }
+         // The answer went astray, ask again
+         Asking &= (uint8_t)~(1 << Query);
+      }
+      Age = AgeOf((FSR_Query_t)Query, Now);
+      if (Age >= FIELD_STATE_REFRESH)
+      {
+         // This one is due, ask for it
+         if (FSR_Query((FSR_Query_t)Query, FIELD_STATE_REFRESH) == True)
+         {
+            Asking |= (uint8_t)(1 << Query);
+            AskTime[Query] = Now;
+         }
+         else
+         {
+            // The FSR's queue is full of other queries, try again shortly
+            Wait = RETRY_INTERVAL;
+         }
+      }
+      else if (FIELD_STATE_REFRESH - Age < Wait)
+      {
+         Wait = FIELD_STATE_REFRESH - Age;
+      }
+   }
+   // An answer will normally bring us back for the queries being asked,
+   // the timer for the rest and for an answer that never comes
+   ES_Timer_InitTimer(PollTimer, Wait);
+}
+
+/****************************************************************************
+ Function
+    AgeOf
+
+ Parameters
+   FSR_Query_t Query : the answer to look at
+   uint32_t Now : the time now, from ES_Timer_GetTime32
+
+ Returns
+   uint16_t, the ticks since the answer came in, 0xFFFF if it never has
+
+ Description
+   how old an answer in the snapshot is
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 23:38
+****************************************************************************/
+static uint16_t AgeOf( FSR_Query_t Query, uint32_t Now )
+{
+   uint32_t Age;
+
+   if ((Answered & (1 << Query)) == 0)
+   {
+      return 0xFFFF;
+   }
+   Age = Now - AnswerTime[Query];
+   return (Age > 0xFFFF) ? 0xFFFF : (uint16_t)Age;
+}
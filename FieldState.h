@@ -0,0 +1,34 @@
+/****************************************************************************
+
+  Header file for the field state service, which keeps the latest answer
+  to each FSR query, based on the Gen2 Events and Services Framework
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 23:58 adl      FIELD_STATE_REFRESH is also the deadline for an answer
+ 10/17/26 23:20 adl      started coding
+ ****************************************************************************/
+
+#ifndef FieldState_H
+#define FieldState_H
+
+// Event Definitions
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "FSR.h"
+
+// an answer is refreshed once it is this many timer ticks (100 mS) old, and
+// the FSR is given as long again to answer (the deadline for FSR_Query)
+#define FIELD_STATE_REFRESH 50
+
+// Public Function Prototypes
+
+boolean InitFieldState ( uint8_t Priority );
+boolean PostFieldState( ES_Event ThisEvent );
+ES_Event RunFieldState( ES_Event ThisEvent );
+boolean QueryFieldState( FSR_Query_t Query, unsigned int *pValue,
+                         uint16_t *pAge );
+
+
+#endif /* FieldState_H */
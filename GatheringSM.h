@@ -11,6 +11,8 @@
 // Event Definitions
 #include "ES_Configure.h"
 #include "ES_Types.h"
+#include "ES_Instance.h"
+#include "TimingConstants.h"
 
 // typedefs for the states
 // State definitions for use with the query function
@@ -18,13 +20,23 @@ typedef enum { FullSpeedAhead, HalfSpeedAhead,
                TurningLeft, TurningRight,
                FullReverse, HalfReverse} GatheringState_t ;
 
+// the variables of one Gathering machine, see ES_Instance.h
+typedef struct
+{
+   uint8_t CurrentState;   // a GatheringState_t, run by ES_StateTable_Run
+   TurnDirection_t TurnDirection;   // the way to turn after backing up
+   unsigned char TurnCounter;       // where QueryNextTurnDirection is
+} GatheringSM_t;
+
+#define GATHERING_SM_INIT { FullSpeedAhead, Right, 0 }
+
 // Public Function Prototypes
 
 // boolean InitGatheringSM ( uint8_t);
 //boolean PostGatheringSM( ES_Event);
-void StartGatheringSM(ES_Event);
-ES_Event RunGatheringSM( ES_Event);
-GatheringState_t QueryGatheringSM ( void );
+void StartGatheringSM( ES_ME_(GatheringSM_t) ES_Event);
+ES_Event RunGatheringSM( ES_ME_(GatheringSM_t) ES_Event);
+GatheringState_t QueryGatheringSM ( ES_ME(const GatheringSM_t) );
 
 
 #endif /* GatheringSM_H */
\ No newline at end of file
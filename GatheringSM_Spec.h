@@ -0,0 +1,61 @@
+/****************************************************************************
+ Module
+     GatheringSM_Spec.h
+ Description
+     the Gathering machine's states and transitions, from which Host/TableGen
+     writes GatheringSM_Table.h
+ Notes
+     Only Host/TableGen includes this, see ScoringSM_Spec.h for the form.
+     After changing it, run make -C Host tables (any host build does).
+     The functions are in GatheringSM.c.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 13:05 adl      started coding, from the switches in GatheringSM.c
+*****************************************************************************/
+#ifndef GatheringSM_Spec_H
+#define GatheringSM_Spec_H
+
+#define GATHERING_SM_MACHINE(MACHINE) \
+   MACHINE( LOG_GATHERING, FullSpeedAhead )
+
+#define GATHERING_SM_STATES(STATE) \
+   STATE( FullSpeedAhead, DriveForward, Stop ) \
+   STATE( HalfSpeedAhead, EnterHalfSpeedAhead, Stop ) \
+   STATE( TurningLeft, EnterTurningLeft, Stop ) \
+   STATE( TurningRight, EnterTurningRight, Stop ) \
+   STATE( FullReverse, EnterFullReverse, Stop ) \
+   STATE( HalfReverse, EnterHalfReverse, Stop )
+
+#define GATHERING_SM_ROWS(ON) \
+   /* slow down over the tape, back off whatever the front hits */ \
+   ON( FullSpeedAhead, ES_LEFT_TAPE_DETECTED, ES_ANY_PARAM, NULL, NULL, \
+       HalfSpeedAhead, ES_NO_EVENT ) \
+   ON( FullSpeedAhead, ES_RIGHT_TAPE_DETECTED, ES_ANY_PARAM, NULL, NULL, \
+       HalfSpeedAhead, ES_NO_EVENT ) \
+   ON( FullSpeedAhead, ES_FRONT_BUMPED, ES_ANY_PARAM, NULL, NULL, \
+       FullReverse, ES_NO_EVENT ) \
+   ON( HalfSpeedAhead, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, FullSpeedAhead, \
+       ES_NO_EVENT ) \
+   ON( HalfSpeedAhead, ES_FRONT_BUMPED, ES_ANY_PARAM, NULL, NULL, \
+       FullReverse, ES_NO_EVENT ) \
+   /* turn to a new heading, then go on */ \
+   ON( TurningLeft, ES_FRONT_BUMPED, ES_ANY_PARAM, NULL, NULL, HalfReverse, \
+       ES_NO_EVENT ) \
+   ON( TurningLeft, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, FullSpeedAhead, \
+       ES_NO_EVENT ) \
+   ON( TurningRight, ES_FRONT_BUMPED, ES_ANY_PARAM, NULL, NULL, HalfReverse, \
+       ES_NO_EVENT ) \
+   ON( TurningRight, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, FullSpeedAhead, \
+       ES_NO_EVENT ) \
+   /* backed up far enough: turn the way TurnDirection says */ \
+   ON( FullReverse, ES_TIMEOUT, MOTION_TIMER, IsTurnRight, NextTurn, \
+       TurningRight, ES_NO_EVENT ) \
+   ON( FullReverse, ES_TIMEOUT, MOTION_TIMER, NULL, NextTurn, TurningLeft, \
+       ES_NO_EVENT ) \
+   ON( HalfReverse, ES_TIMEOUT, MOTION_TIMER, IsTurnRight, NextTurn, \
+       TurningRight, ES_NO_EVENT ) \
+   ON( HalfReverse, ES_TIMEOUT, MOTION_TIMER, NULL, NextTurn, TurningLeft, \
+       ES_NO_EVENT )
+
+#endif /* GatheringSM_Spec_H */
@@ -0,0 +1,102 @@
+/****************************************************************************
+ Module
+     GatheringSM_Table.h
+ Description
+     GatheringSM's transition table, for ES_StateTable_Run
+ Notes
+     Written by Host/TableGen from GatheringSM_Spec.h, do not edit. Change the
+     spec and run make -C Host tables.
+
+     Passed up, to the machine above, by each state: the events it does
+     not take that the machine takes in another state
+       FullSpeedAhead:
+         ES_TIMEOUT MOTION_TIMER
+       HalfSpeedAhead:
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+       TurningLeft:
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+       TurningRight:
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+       FullReverse:
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_FRONT_BUMPED
+       HalfReverse:
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_FRONT_BUMPED
+*****************************************************************************/
+
+// the guards, actions, entries and exits, in GatheringSM.c
+static ES_StateTableGuard_t IsTurnRight;
+static ES_StateTableAction_t NextTurn;
+static ES_StateTableAction_t DriveForward;
+static ES_StateTableAction_t Stop;
+static ES_StateTableAction_t EnterHalfSpeedAhead;
+static ES_StateTableAction_t EnterTurningLeft;
+static ES_StateTableAction_t EnterTurningRight;
+static ES_StateTableAction_t EnterFullReverse;
+static ES_StateTableAction_t EnterHalfReverse;
+
+// the rows, by state and event, in the order they are tried
+static const ES_StateTableRow_t GatheringSM_Rows[13] = {
+   /*  0 FullSpeedAhead ES_LEFT_TAPE_DETECTED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, HalfSpeedAhead, ES_NO_EVENT, 1 },
+   /*  1 FullSpeedAhead ES_RIGHT_TAPE_DETECTED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, HalfSpeedAhead, ES_NO_EVENT, 1 },
+   /*  2 FullSpeedAhead ES_FRONT_BUMPED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, FullReverse, ES_NO_EVENT, 1 },
+   /*  3 HalfSpeedAhead ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, FullSpeedAhead, ES_NO_EVENT, 1 },
+   /*  4 HalfSpeedAhead ES_FRONT_BUMPED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, FullReverse, ES_NO_EVENT, 1 },
+   /*  5 TurningLeft ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, FullSpeedAhead, ES_NO_EVENT, 1 },
+   /*  6 TurningLeft ES_FRONT_BUMPED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, HalfReverse, ES_NO_EVENT, 1 },
+   /*  7 TurningRight ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, FullSpeedAhead, ES_NO_EVENT, 1 },
+   /*  8 TurningRight ES_FRONT_BUMPED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, HalfReverse, ES_NO_EVENT, 1 },
+   /*  9 FullReverse ES_TIMEOUT MOTION_TIMER */
+   { IsTurnRight, NextTurn, MOTION_TIMER, TurningRight, ES_NO_EVENT, 0 },
+   /* 10 FullReverse ES_TIMEOUT MOTION_TIMER */
+   { NULL, NextTurn, MOTION_TIMER, TurningLeft, ES_NO_EVENT, 1 },
+   /* 11 HalfReverse ES_TIMEOUT MOTION_TIMER */
+   { IsTurnRight, NextTurn, MOTION_TIMER, TurningRight, ES_NO_EVENT, 0 },
+   /* 12 HalfReverse ES_TIMEOUT MOTION_TIMER */
+   { NULL, NextTurn, MOTION_TIMER, TurningLeft, ES_NO_EVENT, 1 }
+};
+
+// for each state, 1 + the index of its first row for each event type
+static const uint8_t GatheringSM_Dispatch[6][10] = {
+   /* FullSpeedAhead */
+   { 0, 0, 0, 0, 0, 0, 0, 1, 2, 3 },
+   /* HalfSpeedAhead */
+   { 0, 0, 0, 0, 4, 0, 0, 0, 0, 5 },
+   /* TurningLeft */
+   { 0, 0, 0, 0, 6, 0, 0, 0, 0, 7 },
+   /* TurningRight */
+   { 0, 0, 0, 0, 8, 0, 0, 0, 0, 9 },
+   /* FullReverse */
+   { 0, 0, 0, 0, 10, 0, 0, 0, 0, 0 },
+   /* HalfReverse */
+   { 0, 0, 0, 0, 12, 0, 0, 0, 0, 0 }
+};
+
+// each state's entry and exit
+static const ES_StateTableState_t GatheringSM_States[6] = {
+   { DriveForward, Stop }, /* FullSpeedAhead */
+   { EnterHalfSpeedAhead, Stop }, /* HalfSpeedAhead */
+   { EnterTurningLeft, Stop }, /* TurningLeft */
+   { EnterTurningRight, Stop }, /* TurningRight */
+   { EnterFullReverse, Stop }, /* FullReverse */
+   { EnterHalfReverse, Stop }  /* HalfReverse */
+};
+
+static const ES_StateTable_t GatheringSM_Table = {
+   &GatheringSM_Dispatch[0][0], GatheringSM_Rows, GatheringSM_States, 10, LOG_GATHERING
+};
@@ -0,0 +1,180 @@
+/****************************************************************************
+ Module
+     AppNames.c
+ Description
+     The names of the application's events, machines (their LOG_ sources)
+     and states, for the host tools that decode what the robot sends:
+     TraceDecode and Replay
+ Notes
+     Anything not named here gets its number, so a tool built against an
+     older header still decodes.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 11:50 adl      moved out of TraceDecode.c
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include "ES_Configure.h"
+#include "ES_Events.h"
+#include "MasterMachine.h"
+#include "GatheringSM.h"
+#include "ScoringSM.h"
+#include "DefendingSM.h"
+#include "AppNames.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define NUM_NAMES 256
+
+/*---------------------------- Module Variables ---------------------------*/
+static const char * const EventNames[NUM_NAMES] = {
+  [ES_NO_EVENT] = "ES_NO_EVENT", [ES_ERROR] = "ES_ERROR",
+  [ES_INIT] = "ES_INIT", [ES_NEW_KEY] = "ES_NEW_KEY",
+  [ES_TIMEOUT] = "ES_TIMEOUT", [ES_ENTRY] = "ES_ENTRY",
+  [ES_EXIT] = "ES_EXIT",
+  [ES_LEFT_TAPE_DETECTED] = "ES_LEFT_TAPE_DETECTED",
+  [ES_RIGHT_TAPE_DETECTED] = "ES_RIGHT_TAPE_DETECTED",
+  [ES_FRONT_BUMPED] = "ES_FRONT_BUMPED", [ES_REAR_BUMPED] = "ES_REAR_BUMPED",
+  [ES_GAME_START] = "ES_GAME_START", [ES_BEACON_FRONT] = "ES_BEACON_FRONT",
+  [ES_BEACON_REAR] = "ES_BEACON_REAR",
+  [ES_BALL_BIN_EMPTY] = "ES_BALL_BIN_EMPTY",
+  [ES_DANGERWALL_RIGHT] = "ES_DANGERWALL_RIGHT",
+  [ES_DANGERWALL_LEFT] = "ES_DANGERWALL_LEFT",
+  [ES_NO_DANGERWALL] = "ES_NO_DANGERWALL",
+  [ES_FSR_RESULT] = "ES_FSR_RESULT", [ES_FSR_ERROR] = "ES_FSR_ERROR"
+};
+
+static const char * const MachineNames[] = {
+  [LOG_MASTER] = "MasterMachine", [LOG_GATHERING] = "GatheringSM",
+  [LOG_SCORING] = "ScoringSM", [LOG_DEFENDING] = "DefendingSM"
+};
+
+static const char * const MasterStates[] = {
+  [InitPState] = "InitPState", [UnlockWaiting] = "UnlockWaiting",
+  [_1UnlockPress] = "_1UnlockPress", [_2UnlockPresses] = "_2UnlockPresses",
+  [Locked] = "Locked", [PreGame] = "PreGame",
+  [SideIdentification] = "SideIdentification", [Gathering] = "Gathering",
+  [Scoring] = "Scoring", [Defending] = "Defending", [GameOver] = "GameOver"
+};
+
+static const char * const GatheringStates[] = {
+  [FullSpeedAhead] = "FullSpeedAhead", [HalfSpeedAhead] = "HalfSpeedAhead",
+  [TurningLeft] = "TurningLeft", [TurningRight] = "TurningRight",
+  [FullReverse] = "FullReverse", [HalfReverse] = "HalfReverse"
+};
+
+static const char * const ScoringStates[] = {
+  [AligningFrontBeacon] = "AligningFrontBeacon",
+  [AligningRearBeacon] = "AligningRearBeacon", [BackingUp] = "BackingUp",
+  [DrivingForward_Clearance] = "DrivingForward_Clearance",
+  [DrivingForward_Alignment] = "DrivingForward_Alignment",
+  [Unloading] = "Unloading", [Shuffling] = "Shuffling",
+  [BisectingAngle] = "BisectingAngle",
+  [FindingLeftBeacon] = "FindingLeftBeacon",
+  [FindingRightBeacon] = "FindingRightBeacon"
+};
+
+static const char * const DefendingStates[] = {
+  [DrivingAwayFromWall] = "DrivingAwayFromWall",
+  [AligningPerpendicular] = "AligningPerpendicular", [Waiting] = "Waiting",
+  [Reseting] = "Reseting", [Realigning] = "Realigning",
+  [PushingForward] = "PushingForward", [PushingBackward] = "PushingBackward"
+};
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   AppNames_Event
+ Parameters
+   uint8_t Event : the event type
+ Returns
+   const char * : its name
+ Description
+   from the application's ES_EventTyp_t
+ Notes
+   one not in ES_Configure.h gets its number
+ Author
+   Alex Loo, 10/18/26, 05:35
+****************************************************************************/
+const char *AppNames_Event( uint8_t Event )
+{
+  static char Number[16];
+
+  if ( EventNames[Event] != NULL )
+    return EventNames[Event];
+  sprintf( Number, "event %u", Event );
+  return Number;
+}
+
+/****************************************************************************
+ Function
+   AppNames_Machine
+ Parameters
+   uint8_t Machine : the machine, its LOG_ source
+ Returns
+   const char * : its name
+ Description
+   from the LOG_ sources in ES_Configure.h
+ Notes
+   one it does not know gets its number
+ Author
+   Alex Loo, 10/18/26, 11:52
+****************************************************************************/
+const char *AppNames_Machine( uint8_t Machine )
+{
+  static char Number[16];
+
+  if ( (Machine < sizeof(MachineNames) / sizeof(MachineNames[0])) &&
+       (MachineNames[Machine] != NULL) )
+    return MachineNames[Machine];
+  sprintf( Number, "machine %u", Machine );
+  return Number;
+}
+
+/****************************************************************************
+ Function
+   AppNames_State
+ Parameters
+   uint8_t Machine : the machine, its LOG_ source
+   uint8_t State : the state
+ Returns
+   const char * : the state's name
+ Description
+   from the machine's state enum
+ Notes
+   a machine or state it does not know gets its number
+ Author
+   Alex Loo, 10/18/26, 05:37
+****************************************************************************/
+const char *AppNames_State( uint8_t Machine, uint8_t State )
+{
+  static char Number[16];
+  const char * const *pNames = NULL;
+  size_t NumStates = 0;
+
+  switch ( Machine ) {
+    case LOG_MASTER:
+      pNames = MasterStates;
+      NumStates = sizeof(MasterStates) / sizeof(MasterStates[0]);
+      break;
+    case LOG_GATHERING:
+      pNames = GatheringStates;
+      NumStates = sizeof(GatheringStates) / sizeof(GatheringStates[0]);
+      break;
+    case LOG_SCORING:
+      pNames = ScoringStates;
+      NumStates = sizeof(ScoringStates) / sizeof(ScoringStates[0]);
+      break;
+    case LOG_DEFENDING:
+      pNames = DefendingStates;
+      NumStates = sizeof(DefendingStates) / sizeof(DefendingStates[0]);
+      break;
+    default:
+      break;
+  }
+  if ( (State < NumStates) && (pNames[State] != NULL) )
+    return pNames[State];
+  sprintf( Number, "state %u", State );
+  return Number;
+}
+/*------------------------------ End of file ------------------------------*/
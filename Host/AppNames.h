@@ -0,0 +1,24 @@
+/****************************************************************************
+ Module
+     AppNames.h
+ Description
+     header file for the names of the application's events, machines and
+     states, for the host tools that decode what the robot sends
+ Notes
+     The names come from the application's ES_Configure.h and the machines'
+     headers.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 11:50 adl      moved out of TraceDecode.c
+*****************************************************************************/
+#ifndef AppNames_H
+#define AppNames_H
+
+#include "ES_Types.h"
+
+const char *AppNames_Event( uint8_t Event );
+const char *AppNames_Machine( uint8_t Machine );
+const char *AppNames_State( uint8_t Machine, uint8_t State );
+
+#endif /* AppNames_H */
@@ -0,0 +1,1077 @@
+/****************************************************************************
+ Module
+     ArenaSim.c
+ Description
+     The model of the field for SimMatch. RobotSim.c drives it through the
+     wheel and fan commands, and reads the bumpers, tape sensors, beacon
+     sensors and ball counter back from it; FSRSim_Value carries the ball
+     counts and the wall angle to FSR.c.
+ Notes
+     World coordinates are in metres from the centre of the field, x to
+     the right and y up, angles counter-clockwise, except the wall angle,
+     which is in degrees clockwise as the FSR reports it. At wall angle 0
+     the wall runs along the x axis and red (beacons 1 and 4) has the top
+     half: red is always on the left of the wall's direction. Bins and
+     beacons sit in the corners, 1 top right, 2 bottom right, 3 bottom left
+     and 4 top left, which are the bins of DefendingMode.c's ANGLES.
+
+     The robot is a disc on 2 wheels, each taking its commanded speed with
+     a lag, and each a little faster or slower than its nominal speed from
+     match to match. The bumpers close on any contact within 60 degrees of
+     straight ahead or behind. The tape is an arc round each bin, and the
+     beacon sensors look along the robot's axis, each seeing the beacon
+     nearest the middle of its cone, if the wall is not in the way.
+
+     The wall turns about the centre. The robot turns it by driving into
+     it, though it gives only part of the way; the opposing robot pushes it
+     at a rate that changes every few seconds. The opposing robot is
+     otherwise a rate of picking up balls and 2 loads put in its bins; it
+     takes up no room on the field.
+
+     Balls come onto the field at the start signal, a random 1 to 2 s in,
+     and lie evenly over it. With its fan on and moving forward, the robot
+     picks up those in the path of its intake, up to a full hopper. With
+     its fan off and its rear against a bin, the hopper empties into it.
+     The score is the balls in the bins on our side of the wall.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 08:20 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <math.h>
+#include "ArenaSim.h"
+#include "FSRSim.h"
+#include "SideID.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define PI 3.14159265358979
+
+// the field, a square 2.44 m on a side, with a bin of radius 0.25 m and
+// a tape arc of radius 0.6 m round each corner
+#define HALF_FIELD 1.22
+#define BIN_RADIUS 0.25
+#define TAPE_RADIUS 0.6
+#define TAPE_HALF_WIDTH 0.01
+// the wall, 2 m long, turning about the centre of the field
+#define WALL_HALF_LENGTH 1.0
+// of the speed the robot drives into the wall, how much the wall gives
+#define WALL_GIVE 0.6
+// the opposing robot pushes the wall at up to this many degrees a second,
+// changing its rate every 1 to 5 s
+#define OPP_PUSH_MAX 4.0
+#define OPP_PUSH_MIN_TIME 1.0
+#define OPP_PUSH_MAX_TIME 5.0
+// the wall starts up to this angle either side of 0 (ANGLE_A), so that each
+// team starts with its own 2 bins
+#define START_WALL_MAX 32.0
+
+// the robot: its radius, wheel base, top speed at 100% (so that a turn of
+// DEGREE90_INTERVAL is 90 degrees), the lag of its motors and how far
+// apart 2 motors may be
+#define ROBOT_RADIUS 0.15
+#define WHEEL_BASE 0.35
+#define TOP_SPEED 0.45
+#define MOTOR_LAG 0.08
+#define MOTOR_MISMATCH 0.04
+// a contact this close to straight ahead (or behind) closes the bumper,
+// as the cosine of the angle
+#define BUMPER_HALF_ANGLE_COS 0.5
+// a contact counts while the gap is under this
+#define CONTACT_GAP 0.002
+// the tape sensors, forward of the centre and either side of the axis
+#define TAPE_SENSOR_X 0.12
+#define TAPE_SENSOR_Y 0.08
+// half the beacon sensors' field of view, 8 degrees, as its cosine
+#define BEACON_HALF_ANGLE_COS 0.990268
+// how far off a beacon the robot may start, either way
+#define START_AIM_JITTER (5.0 * PI / 180.0)
+
+// the balls, the hopper, the intake's width, and how fast a hopper empties
+#define NUM_BALLS 30
+#define HOPPER_SIZE 15
+#define INTAKE_WIDTH 0.2
+#define UNLOAD_RATE 8.0
+// the opposing robot picks balls up at this rate (with all of them on the
+// field) and puts its load in one of its bins at each of these times
+#define OPP_PICKUP_RATE 0.25
+#define OPP_UNLOADS { 55.0, 105.0 }
+
+// the start signal comes this long into the match
+#define START_MIN_TIME 1.0
+#define START_MAX_TIME 2.0
+
+/*---------------------------- Module Types -------------------------------*/
+typedef struct {
+  double x;
+  double y;
+} Vec_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void DriveWheels( void );
+static void MoveRobot( void );
+static void PushWall( double Rate );
+static void Collide( void );
+static void FindContacts( void );
+static void Contact( Vec_t Point, unsigned char Bin );
+static void MoveBalls( void );
+static void UpdateFSR( void );
+static void PlaceRobot( void );
+static unsigned char BeaconInView( Vec_t Looking );
+static boolean WallBlocks( Vec_t From, Vec_t To );
+static boolean OnTape( Vec_t Point );
+static boolean OnOurSide( Vec_t Point );
+static void Turn( double NewHeading );
+static void TurnWall( double NewAngle );
+static Vec_t ClosestOnWall( Vec_t Point );
+static Vec_t Corner( unsigned char Bin );
+static double Length( double dx, double dy );
+static double WrapAngle( double Angle );
+static double Uniform( double Min, double Max );
+
+/*---------------------------- Module Variables ---------------------------*/
+// world time in seconds, and when the start signal comes
+static double Now;
+static double StartTime;
+
+// the robot: where it is, which way it faces, its wheels and its fan
+static Vec_t Robot;
+static double Heading;
+// and as a unit vector
+static Vec_t Facing;
+static double Velocity;
+static double WheelSpeed[2];
+static double WheelCommand[2];
+static double WheelGain[2];
+static boolean FanOn;
+static unsigned char Team;
+
+// the wall's angle (clockwise, in degrees) and the opposing robot's push
+static double WallAngle;
+// a unit vector along the wall, the wall angle clockwise from x
+static Vec_t WallDirection;
+static double OppRate;
+static double OppRateUntil;
+
+// what touches the robot
+static boolean FrontContact;
+static boolean RearContact;
+static unsigned char RearBin;
+
+// the balls: on the field, in our hopper, in the bins, and the opposing
+// robot's load
+static double BallsInPlay;
+static unsigned char Hopper;
+static unsigned char Bins[4];
+static double OppLoad;
+static unsigned char OppUnloadsDone;
+static unsigned char Collected;
+static unsigned char Unloaded;
+static double UnloadDue;
+
+// when each beacon's first edge comes, in counts of the fine timebase
+static uint32_t BeaconPhase[4];
+
+// the state of the xorshift generator, so that a match depends only on its
+// seed
+static uint32_t RandomState;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   Arena_Init
+ Parameters
+   uint32_t Seed : the match to set up, the same seed gives the same match
+ Returns
+   None
+ Description
+   sets up a match: the team, the wall angle, the robot's pose facing one
+   of our beacons front or rear, its motors, the beacons' phases, the time
+   of the start signal, and the balls
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:25
+****************************************************************************/
+void Arena_Init( uint32_t Seed )
+{
+  unsigned char i;
+
+  RandomState = (Seed * 2654435761UL) ^ 0x5EED5EEDUL;
+  if ( RandomState == 0 )
+    RandomState = 1;
+  Now = 0;
+  StartTime = Uniform( START_MIN_TIME, START_MAX_TIME );
+  Team = (Arena_Random() & 1) ? BLUE_TEAM : RED_TEAM;
+  TurnWall( Uniform( -START_WALL_MAX, START_WALL_MAX ) );
+  OppRate = 0;
+  OppRateUntil = StartTime;
+  for ( i = 0; i < 2; i++ ) {
+    WheelSpeed[i] = 0;
+    WheelCommand[i] = 0;
+    WheelGain[i] = 1.0 + Uniform( -MOTOR_MISMATCH, MOTOR_MISMATCH ) / 2;
+  }
+  Velocity = 0;
+  FanOn = False;
+  for ( i = 0; i < 4; i++ ) {
+    Bins[i] = 0;
+    BeaconPhase[i] = Arena_Random() % 60000UL;
+  }
+  BallsInPlay = NUM_BALLS;
+  Hopper = 0;
+  OppLoad = 0;
+  OppUnloadsDone = 0;
+  Collected = 0;
+  Unloaded = 0;
+  UnloadDue = 0;
+  PlaceRobot();
+  FindContacts();
+  UpdateFSR();
+}
+
+/****************************************************************************
+ Function
+   Arena_SetWheels
+ Parameters
+   int Left, int Right : the speed asked of each wheel, -100 to 100 %
+ Returns
+   None
+ Description
+   what the motor driver asks of the motors; they follow with a lag
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:28
+****************************************************************************/
+void Arena_SetWheels( int Left, int Right )
+{
+  WheelCommand[0] = Left / 100.0;
+  WheelCommand[1] = Right / 100.0;
+}
+
+/****************************************************************************
+ Function
+   Arena_SetFan
+ Parameters
+   boolean On : True to run the intake fan
+ Returns
+   None
+ Description
+   the fan picks balls up while it runs, and lets the hopper empty while
+   it does not
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:29
+****************************************************************************/
+void Arena_SetFan( boolean On )
+{
+  FanOn = On;
+}
+
+/****************************************************************************
+ Function
+   Arena_Step
+ Parameters
+   None
+ Returns
+   None
+ Description
+   moves the world on 1 RTI tick: the wheels, the robot, the wall, the
+   contacts, the balls, and the FSR's answers
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:30
+****************************************************************************/
+void Arena_Step( void )
+{
+  Now += ARENA_STEP_TIME;
+  if ( Now >= OppRateUntil ) {
+    // the opposing robot changes how it pushes on the wall
+    OppRate = Uniform( -OPP_PUSH_MAX, OPP_PUSH_MAX );
+    OppRateUntil = Now + Uniform( OPP_PUSH_MIN_TIME, OPP_PUSH_MAX_TIME );
+  }
+  DriveWheels();
+  MoveRobot();
+  PushWall( (Now >= StartTime) ? OppRate : 0 );
+  Collide();
+  FindContacts();
+  MoveBalls();
+  UpdateFSR();
+}
+
+/****************************************************************************
+ Function
+   Arena_Sense
+ Parameters
+   ArenaSensors_t * pSensors : where to put what the sensors see
+ Returns
+   None
+ Description
+   reads the robot's sensors as they are after the last Arena_Step
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:32
+****************************************************************************/
+void Arena_Sense( ArenaSensors_t *pSensors )
+{
+  double c = Facing.x;
+  double s = Facing.y;
+  Vec_t Back;
+  Vec_t Left;
+  Vec_t Right;
+
+  pSensors->FrontBump = FrontContact;
+  pSensors->RearBump = RearContact;
+  Left.x = Robot.x + TAPE_SENSOR_X * c - TAPE_SENSOR_Y * s;
+  Left.y = Robot.y + TAPE_SENSOR_X * s + TAPE_SENSOR_Y * c;
+  Right.x = Robot.x + TAPE_SENSOR_X * c + TAPE_SENSOR_Y * s;
+  Right.y = Robot.y + TAPE_SENSOR_X * s - TAPE_SENSOR_Y * c;
+  pSensors->LeftTape = OnTape( Left );
+  pSensors->RightTape = OnTape( Right );
+  Back.x = -c;
+  Back.y = -s;
+  pSensors->FrontBeacon = BeaconInView( Facing );
+  pSensors->RearBeacon = BeaconInView( Back );
+  pSensors->Collected = Collected;
+}
+
+/****************************************************************************
+ Function
+   Arena_BeaconPhase
+ Parameters
+   unsigned char Beacon : 1 to 4
+ Returns
+   uint32_t : the time of the beacon's first edge, in fine counts
+ Description
+   the beacons run from power up, each from its own random phase
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:33
+****************************************************************************/
+uint32_t Arena_BeaconPhase( unsigned char Beacon )
+{
+  return BeaconPhase[Beacon - 1];
+}
+
+/****************************************************************************
+ Function
+   Arena_Random
+ Parameters
+   None
+ Returns
+   uint32_t : the next number from the match's generator
+ Description
+   xorshift32, seeded by Arena_Init, so that RobotSim's noise depends only
+   on the match's seed too
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:34
+****************************************************************************/
+uint32_t Arena_Random( void )
+{
+  RandomState ^= RandomState << 13;
+  RandomState ^= RandomState >> 17;
+  RandomState ^= RandomState << 5;
+  return RandomState;
+}
+
+/****************************************************************************
+ Function
+   Arena_Over
+ Parameters
+   None
+ Returns
+   boolean, True once the match is over
+ Description
+   the match ends ARENA_MATCH_TIME after the start signal
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:35
+****************************************************************************/
+boolean Arena_Over( void )
+{
+  return (Now >= StartTime + ARENA_MATCH_TIME) ? True : False;
+}
+
+/****************************************************************************
+ Function
+   Arena_Result
+ Parameters
+   ArenaResult_t * pResult : where to put the result
+ Returns
+   None
+ Description
+   scores the match as it stands: the balls in every bin on our side of
+   the wall
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:36
+****************************************************************************/
+void Arena_Result( ArenaResult_t *pResult )
+{
+  unsigned char Bin;
+
+  pResult->Team = Team;
+  pResult->Score = 0;
+  pResult->OurBins = 0;
+  for ( Bin = 1; Bin <= 4; Bin++ ) {
+    if ( OnOurSide( Corner( Bin ) ) == True ) {
+      pResult->Score += Bins[Bin - 1];
+      pResult->OurBins |= (unsigned char)(1 << (Bin - 1));
+    }
+  }
+  pResult->Collected = Collected;
+  pResult->Unloaded = Unloaded;
+  pResult->WallAngle = (unsigned int)WallAngle;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   DriveWheels
+ Parameters
+   None
+ Returns
+   None
+ Description
+   each wheel closes on its commanded speed with the motor's lag
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:38
+****************************************************************************/
+static void DriveWheels( void )
+{
+  unsigned char i;
+
+  for ( i = 0; i < 2; i++ )
+    WheelSpeed[i] += (WheelCommand[i] * TOP_SPEED * WheelGain[i] -
+                      WheelSpeed[i]) * (ARENA_STEP_TIME / MOTOR_LAG);
+}
+
+/****************************************************************************
+ Function
+   MoveRobot
+ Parameters
+   None
+ Returns
+   None
+ Description
+   moves the robot on by its wheel speeds, before anything stops it
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:39
+****************************************************************************/
+static void MoveRobot( void )
+{
+  Velocity = (WheelSpeed[0] + WheelSpeed[1]) / 2;
+  Robot.x += Velocity * Facing.x * ARENA_STEP_TIME;
+  Robot.y += Velocity * Facing.y * ARENA_STEP_TIME;
+  if ( WheelSpeed[1] != WheelSpeed[0] )
+    Turn( Heading + (WheelSpeed[1] - WheelSpeed[0]) / WHEEL_BASE *
+                    ARENA_STEP_TIME );
+}
+
+/****************************************************************************
+ Function
+   PushWall
+ Parameters
+   double Rate : how fast the opposing robot turns the wall, in degrees
+                 clockwise a second
+ Returns
+   None
+ Description
+   turns the wall by the opposing robot's push, and by the robot's where
+   the robot has driven into it
+ Notes
+   the point of contact moves away from the robot at WALL_GIVE of the
+   speed at which the robot drives into it; its cross product with the
+   point gives the wall's rate
+ Author
+   Alex Loo, 10/18/26, 08:41
+****************************************************************************/
+static void PushWall( double Rate )
+{
+  Vec_t Touch = ClosestOnWall( Robot );
+  double dx = Robot.x - Touch.x;
+  double dy = Robot.y - Touch.y;
+  double Gap = Length( dx, dy );
+  double Arm = Length( Touch.x, Touch.y );
+  double Into;
+  double Ccw;
+
+  if ( (Gap < ROBOT_RADIUS) && (Gap > 0) && (Arm > 0.05) ) {
+    // the robot's speed toward the wall, along the line through the contact
+    Into = -Velocity * (Facing.x * dx + Facing.y * dy) / Gap;
+    if ( Into > 0 ) {
+      Ccw = WALL_GIVE * Into * (Touch.y * dx - Touch.x * dy) /
+            (Gap * Arm * Arm);
+      Rate -= Ccw * 180.0 / PI;
+    }
+  }
+  if ( Rate != 0 )
+    TurnWall( WallAngle + Rate * ARENA_STEP_TIME );
+}
+
+/****************************************************************************
+ Function
+   Collide
+ Parameters
+   None
+ Returns
+   None
+ Description
+   moves the robot out of the field's sides, the bins and the wall
+ Notes
+   twice over, for a robot wedged between 2 of them
+ Author
+   Alex Loo, 10/18/26, 08:44
+****************************************************************************/
+static void Collide( void )
+{
+  double Limit = HALF_FIELD - ROBOT_RADIUS;
+  unsigned char Pass;
+  unsigned char Bin;
+  Vec_t Point;
+  double Dist;
+
+  for ( Pass = 0; Pass < 2; Pass++ ) {
+    Robot.x = fmax( -Limit, fmin( Limit, Robot.x ) );
+    Robot.y = fmax( -Limit, fmin( Limit, Robot.y ) );
+    for ( Bin = 1; Bin <= 4; Bin++ ) {
+      Point = Corner( Bin );
+      Dist = Length( Robot.x - Point.x, Robot.y - Point.y );
+      if ( (Dist < BIN_RADIUS + ROBOT_RADIUS) && (Dist > 0) ) {
+        Robot.x = Point.x + (Robot.x - Point.x) / Dist *
+                            (BIN_RADIUS + ROBOT_RADIUS);
+        Robot.y = Point.y + (Robot.y - Point.y) / Dist *
+                            (BIN_RADIUS + ROBOT_RADIUS);
+      }
+    }
+    Point = ClosestOnWall( Robot );
+    Dist = Length( Robot.x - Point.x, Robot.y - Point.y );
+    if ( (Dist < ROBOT_RADIUS) && (Dist > 0) ) {
+      Robot.x = Point.x + (Robot.x - Point.x) / Dist * ROBOT_RADIUS;
+      Robot.y = Point.y + (Robot.y - Point.y) / Dist * ROBOT_RADIUS;
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   FindContacts
+ Parameters
+   None
+ Returns
+   None
+ Description
+   finds what touches the robot, for the bumpers, and which bin, if any,
+   its rear is against
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:46
+****************************************************************************/
+static void FindContacts( void )
+{
+  double Reach = HALF_FIELD - ROBOT_RADIUS - CONTACT_GAP;
+  unsigned char Bin;
+  Vec_t Point;
+
+  FrontContact = False;
+  RearContact = False;
+  RearBin = 0;
+  // the sides of the field
+  Point = Robot;
+  if ( fabs( Robot.x ) > Reach ) {
+    Point.x = (Robot.x > 0) ? HALF_FIELD : -HALF_FIELD;
+    Contact( Point, 0 );
+  }
+  Point = Robot;
+  if ( fabs( Robot.y ) > Reach ) {
+    Point.y = (Robot.y > 0) ? HALF_FIELD : -HALF_FIELD;
+    Contact( Point, 0 );
+  }
+  // the bins
+  for ( Bin = 1; Bin <= 4; Bin++ ) {
+    Point = Corner( Bin );
+    if ( Length( Robot.x - Point.x, Robot.y - Point.y ) <
+         BIN_RADIUS + ROBOT_RADIUS + CONTACT_GAP )
+      Contact( Point, Bin );
+  }
+  // the wall
+  Point = ClosestOnWall( Robot );
+  if ( Length( Robot.x - Point.x, Robot.y - Point.y ) <
+       ROBOT_RADIUS + CONTACT_GAP )
+    Contact( Point, 0 );
+}
+
+/****************************************************************************
+ Function
+   Contact
+ Parameters
+   Vec_t Point : a point in the direction of the contact
+   unsigned char Bin : the bin touched, 0 for anything else
+ Returns
+   None
+ Description
+   closes the front or rear bumper for a contact in that direction
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:48
+****************************************************************************/
+static void Contact( Vec_t Point, unsigned char Bin )
+{
+  double dx = Point.x - Robot.x;
+  double dy = Point.y - Robot.y;
+  // the cosine of the contact's bearing from straight ahead
+  double Ahead = (Facing.x * dx + Facing.y * dy) / Length( dx, dy );
+
+  if ( Ahead > BUMPER_HALF_ANGLE_COS ) {
+    FrontContact = True;
+  } else if ( Ahead < -BUMPER_HALF_ANGLE_COS ) {
+    RearContact = True;
+    if ( Bin != 0 )
+      RearBin = Bin;
+  }
+}
+
+/****************************************************************************
+ Function
+   MoveBalls
+ Parameters
+   None
+ Returns
+   None
+ Description
+   picks balls up into our hopper and the opposing robot's, empties our
+   hopper into the bin at our rear, and the opposing robot's at its times
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:50
+****************************************************************************/
+static void MoveBalls( void )
+{
+  static const double OppUnloads[] = OPP_UNLOADS;
+  double Area = 4 * HALF_FIELD * HALF_FIELD;
+  double Took;
+  unsigned char Bin;
+  unsigned char Choice;
+
+  if ( Now < StartTime )
+    return;
+  // our intake sweeps its width along the robot's path
+  if ( (FanOn == True) && (Velocity > 0) && (Hopper < HOPPER_SIZE) &&
+       (BallsInPlay >= 1) &&
+       (Uniform( 0, 1 ) < Velocity * ARENA_STEP_TIME * INTAKE_WIDTH *
+                          BallsInPlay / Area) ) {
+    BallsInPlay -= 1;
+    Hopper++;
+    Collected++;
+  }
+  // the opposing robot's, as a rate
+  Took = OPP_PICKUP_RATE * ARENA_STEP_TIME * BallsInPlay / NUM_BALLS;
+  BallsInPlay -= Took;
+  OppLoad += Took;
+  // with the fan off, our hopper empties into the bin we are backed onto
+  if ( (FanOn == False) && (RearBin != 0) && (Hopper > 0) ) {
+    UnloadDue += UNLOAD_RATE * ARENA_STEP_TIME;
+    for ( ; (UnloadDue >= 1) && (Hopper > 0); UnloadDue -= 1 ) {
+      Hopper--;
+      Bins[RearBin - 1]++;
+      Unloaded++;
+    }
+  } else {
+    UnloadDue = 0;
+  }
+  // the opposing robot puts its load in one of the bins on its side
+  if ( (OppUnloadsDone < sizeof(OppUnloads) / sizeof(OppUnloads[0])) &&
+       (Now >= StartTime + OppUnloads[OppUnloadsDone]) ) {
+    OppUnloadsDone++;
+    Choice = (unsigned char)(Arena_Random() & 1);
+    for ( Bin = 1; Bin <= 4; Bin++ ) {
+      if ( (OnOurSide( Corner( Bin ) ) == False) && (Choice-- == 0) ) {
+        Bins[Bin - 1] += (unsigned char)OppLoad;
+        OppLoad -= (unsigned char)OppLoad;
+        break;
+      }
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   UpdateFSR
+ Parameters
+   None
+ Returns
+   None
+ Description
+   gives FSRSim the answers the field controller would: no balls in play
+   until the start signal, the bins, and the wall angle to 2 degrees
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:52
+****************************************************************************/
+static void UpdateFSR( void )
+{
+  unsigned char Bin;
+
+  FSRSim_Value[FSR_BALLS_IN_PLAY] =
+      (Now < StartTime) ? 0 : (unsigned int)ceil( BallsInPlay );
+  for ( Bin = 0; Bin < 4; Bin++ )
+    FSRSim_Value[FSR_BALLS_IN_BIN1 + Bin] = Bins[Bin];
+  FSRSim_Value[FSR_WALL_ANGLE] = ((unsigned int)WallAngle / 2) * 2;
+}
+
+/****************************************************************************
+ Function
+   PlaceRobot
+ Parameters
+   None
+ Returns
+   None
+ Description
+   puts the robot somewhere in our half, clear of the wall and the bins,
+   facing one of our beacons with its front or its rear
+ Notes
+   tries again until the beacon is in view
+ Author
+   Alex Loo, 10/18/26, 08:55
+****************************************************************************/
+static void PlaceRobot( void )
+{
+  double Limit = HALF_FIELD - ROBOT_RADIUS - 0.05;
+  double Side = (Team == RED_TEAM) ? 1.0 : -1.0;
+  Vec_t Wall = WallDirection;
+  Vec_t Looking;
+  Vec_t Beacon;
+  unsigned char Target;
+  unsigned char Bin;
+  boolean Rear;
+  boolean Clear;
+
+  for ( ;; ) {
+    Robot.x = Uniform( -Limit, Limit );
+    Robot.y = Uniform( -Limit, Limit );
+    // well clear of the wall, on our side of it, and of the bins
+    Clear = (Side * (Wall.x * Robot.y - Wall.y * Robot.x) >
+             ROBOT_RADIUS + 0.1) ? True : False;
+    for ( Bin = 1; Bin <= 4; Bin++ ) {
+      Beacon = Corner( Bin );
+      if ( Length( Robot.x - Beacon.x, Robot.y - Beacon.y ) <
+           BIN_RADIUS + ROBOT_RADIUS + 0.05 )
+        Clear = False;
+    }
+    if ( Clear == False )
+      continue;
+    // red's beacons are 1 and 4, blue's 2 and 3
+    Target = (Arena_Random() & 1) ? 4 : 1;
+    if ( Team != RED_TEAM )
+      Target = (Target == 1) ? 2 : 3;
+    Rear = (Arena_Random() & 1) ? True : False;
+    Beacon = Corner( Target );
+    Turn( atan2( Beacon.y - Robot.y, Beacon.x - Robot.x ) +
+          Uniform( -START_AIM_JITTER, START_AIM_JITTER ) +
+          ((Rear == True) ? PI : 0) );
+    Looking.x = (Rear == True) ? -Facing.x : Facing.x;
+    Looking.y = (Rear == True) ? -Facing.y : Facing.y;
+    if ( BeaconInView( Looking ) == Target )
+      return;
+  }
+}
+
+/****************************************************************************
+ Function
+   BeaconInView
+ Parameters
+   Vec_t Looking : the way the sensor looks, a unit vector
+ Returns
+   unsigned char : the beacon nearest the middle of the sensor's cone, 0 if
+                   none is in it
+ Description
+   a beacon is in view if it is within 8 degrees of the sensor's axis and
+   the wall is not between them
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:58
+****************************************************************************/
+static unsigned char BeaconInView( Vec_t Looking )
+{
+  double BestOn = BEACON_HALF_ANGLE_COS;
+  unsigned char Best = 0;
+  unsigned char Bin;
+  double dx;
+  double dy;
+  double On;
+  Vec_t Beacon;
+
+  for ( Bin = 1; Bin <= 4; Bin++ ) {
+    Beacon = Corner( Bin );
+    dx = Beacon.x - Robot.x;
+    dy = Beacon.y - Robot.y;
+    // the cosine of the angle off the axis
+    On = (Looking.x * dx + Looking.y * dy) / Length( dx, dy );
+    if ( (On > BestOn) && (WallBlocks( Robot, Beacon ) == False) ) {
+      Best = Bin;
+      BestOn = On;
+    }
+  }
+  return Best;
+}
+
+/****************************************************************************
+ Function
+   WallBlocks
+ Parameters
+   Vec_t From, Vec_t To : the ends of a line of sight
+ Returns
+   boolean, True if the wall crosses it
+ Description
+   segment against segment: the ends of each are either side of the other
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:00
+****************************************************************************/
+static boolean WallBlocks( Vec_t From, Vec_t To )
+{
+  Vec_t d = WallDirection;
+  double cf;
+  double ct;
+  double ca;
+  double cb;
+
+  // From and To either side of the wall's line, through the centre
+  cf = d.x * From.y - d.y * From.x;
+  ct = d.x * To.y - d.y * To.x;
+  // and the wall's ends either side of the line of sight
+  ca = (To.x - From.x) * (WALL_HALF_LENGTH * d.y - From.y) -
+       (To.y - From.y) * (WALL_HALF_LENGTH * d.x - From.x);
+  cb = (To.x - From.x) * (-WALL_HALF_LENGTH * d.y - From.y) -
+       (To.y - From.y) * (-WALL_HALF_LENGTH * d.x - From.x);
+  return ((cf * ct < 0) && (ca * cb < 0)) ? True : False;
+}
+
+/****************************************************************************
+ Function
+   OnTape
+ Parameters
+   Vec_t Point : where a tape sensor is
+ Returns
+   boolean, True if it is over the tape round any bin
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:01
+****************************************************************************/
+static boolean OnTape( Vec_t Point )
+{
+  unsigned char Bin;
+  Vec_t c;
+
+  for ( Bin = 1; Bin <= 4; Bin++ ) {
+    c = Corner( Bin );
+    if ( fabs( Length( Point.x - c.x, Point.y - c.y ) - TAPE_RADIUS ) <
+         TAPE_HALF_WIDTH )
+      return True;
+  }
+  return False;
+}
+
+/****************************************************************************
+ Function
+   OnOurSide
+ Parameters
+   Vec_t Point : a point on the field
+ Returns
+   boolean, True if it is on our side of the wall's line
+ Description
+   red is on the left of the wall's direction, blue on its right
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:02
+****************************************************************************/
+static boolean OnOurSide( Vec_t Point )
+{
+  Vec_t d = WallDirection;
+  double Cross = d.x * Point.y - d.y * Point.x;
+
+  if ( Team == RED_TEAM )
+    return (Cross > 0) ? True : False;
+  return (Cross < 0) ? True : False;
+}
+
+/****************************************************************************
+ Function
+   Turn
+ Parameters
+   double NewHeading : radians counter-clockwise from x
+ Returns
+   None
+ Description
+   points the robot a new way, and keeps the unit vector that way
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:03
+****************************************************************************/
+static void Turn( double NewHeading )
+{
+  Heading = WrapAngle( NewHeading );
+  Facing.x = cos( Heading );
+  Facing.y = sin( Heading );
+}
+
+/****************************************************************************
+ Function
+   TurnWall
+ Parameters
+   double NewAngle : degrees clockwise
+ Returns
+   None
+ Description
+   moves the wall to a new angle, from 0 to 360, and keeps the unit vector
+   along it
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:04
+****************************************************************************/
+static void TurnWall( double NewAngle )
+{
+  WallAngle = fmod( NewAngle, 360.0 );
+  if ( WallAngle < 0 )
+    WallAngle += 360.0;
+  WallDirection.x = cos( WallAngle * PI / 180.0 );
+  WallDirection.y = -sin( WallAngle * PI / 180.0 );
+}
+
+/****************************************************************************
+ Function
+   ClosestOnWall
+ Parameters
+   Vec_t Point : a point on the field
+ Returns
+   Vec_t : the point of the wall nearest it
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:05
+****************************************************************************/
+static Vec_t ClosestOnWall( Vec_t Point )
+{
+  Vec_t d = WallDirection;
+  double Along = fmax( -WALL_HALF_LENGTH,
+                       fmin( WALL_HALF_LENGTH, d.x * Point.x + d.y * Point.y ) );
+
+  d.x *= Along;
+  d.y *= Along;
+  return d;
+}
+
+/****************************************************************************
+ Function
+   Corner
+ Parameters
+   unsigned char Bin : 1 to 4
+ Returns
+   Vec_t : the corner the bin and its beacon are in
+ Description
+   1 top right, 2 bottom right, 3 bottom left, 4 top left
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:05
+****************************************************************************/
+static Vec_t Corner( unsigned char Bin )
+{
+  Vec_t c;
+
+  c.x = ((Bin == 1) || (Bin == 2)) ? HALF_FIELD : -HALF_FIELD;
+  c.y = ((Bin == 1) || (Bin == 4)) ? HALF_FIELD : -HALF_FIELD;
+  return c;
+}
+
+/****************************************************************************
+ Function
+   Length
+ Parameters
+   double dx, double dy : a vector
+ Returns
+   double : its length
+ Description
+   what hypot gives, without the care over overflow that the field's
+   distances have no need of, and that costs the simulator a third of its
+   time
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:06
+****************************************************************************/
+static double Length( double dx, double dy )
+{
+  return sqrt( dx * dx + dy * dy );
+}
+
+/****************************************************************************
+ Function
+   WrapAngle
+ Parameters
+   double Angle : radians
+ Returns
+   double : the same angle, from -PI to PI
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:06
+****************************************************************************/
+static double WrapAngle( double Angle )
+{
+  while ( Angle > PI )
+    Angle -= 2 * PI;
+  while ( Angle < -PI )
+    Angle += 2 * PI;
+  return Angle;
+}
+
+/****************************************************************************
+ Function
+   Uniform
+ Parameters
+   double Min, double Max : the range
+ Returns
+   double : a number drawn evenly from the range
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:07
+****************************************************************************/
+static double Uniform( double Min, double Max )
+{
+  return Min + (Max - Min) * (Arena_Random() / 4294967296.0);
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,58 @@
+/****************************************************************************
+ Module
+     ArenaSim.h
+ Description
+     the model of the field for SimMatch: the robot's chassis and wheels,
+     the 4 beacons and bins, the tape, the rotating wall, the balls and the
+     opposing robot's pushing of the wall
+ Notes
+     the world runs 1 RTI tick (2.048 mS) at a time, from Arena_Step
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 08:20 adl      started coding
+*****************************************************************************/
+#ifndef ArenaSim_H
+#define ArenaSim_H
+
+#include "ES_Types.h"
+
+// seconds of world time per Arena_Step, 1 RTI tick
+#define ARENA_STEP_TIME 2.048e-3
+
+// the match runs this long from the start signal, plus a margin for the
+// robot's END_GAME_TIMER, which starts when it sees the balls come out
+#define ARENA_MATCH_TIME (120.0 + 0.25)
+
+// what the robot's sensors see after an Arena_Step
+typedef struct {
+   boolean FrontBump;         // the front bumper is pressed
+   boolean RearBump;          // and the rear
+   boolean LeftTape;          // the left tape sensor is over tape
+   boolean RightTape;         // and the right
+   unsigned char FrontBeacon; // beacon 1 to 4 in the front sensor's cone, 0
+   unsigned char RearBeacon;  // for none; and the rear
+   unsigned char Collected;   // balls through the ball counter so far
+} ArenaSensors_t;
+
+// how the match went, for Arena_Result
+typedef struct {
+   unsigned char Team;        // RED_TEAM or BLUE_TEAM, from where we started
+   unsigned char Score;       // balls in the bins on our side of the wall
+   unsigned char Collected;   // balls we picked up
+   unsigned char Unloaded;    // balls we put in a bin
+   unsigned char OurBins;     // bit k-1 set for each bin k on our side
+   unsigned int WallAngle;    // the wall angle at the end, in degrees
+} ArenaResult_t;
+
+void Arena_Init( uint32_t Seed );
+void Arena_SetWheels( int Left, int Right );
+void Arena_SetFan( boolean On );
+void Arena_Step( void );
+void Arena_Sense( ArenaSensors_t *pSensors );
+uint32_t Arena_BeaconPhase( unsigned char Beacon );
+uint32_t Arena_Random( void );
+boolean Arena_Over( void );
+void Arena_Result( ArenaResult_t *pResult );
+
+#endif /* ArenaSim_H */
@@ -0,0 +1,556 @@
+/****************************************************************************
+ Module
+     BenchConfig.h
+ Description
+     ES_HOST_CONFIG for the host benchmarks. Stands in for the application
+     part of ES_Configure.h: every service is a BenchServices.h dummy and the
+     only event checker is the benchmark's event generator.
+ Notes
+     BENCH_NUM_SERVICES (1 to 64), BENCH_MAX_SERVICES, BENCH_QUEUE_SIZE,
+     BENCH_QUEUE_POW2, BENCH_BATCH_SIZE, BENCH_QUEUE_STATS, BENCH_PROFILE,
+     BENCH_NUM_TIMERS, BENCH_TIMER_POST and BENCH_KEY_POST may be set from
+     the command line
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:30 adl      FSR_POST_FUNC
+ 10/18/26 06:34 adl      BENCH_PROFILE
+ 10/18/26 02:40 adl      BENCH_KEY_POST
+ 10/17/26 20:35 adl      BENCH_NUM_TIMERS and BENCH_TIMER_POST
+ 10/17/26 18:40 adl      BENCH_QUEUE_STATS
+ 10/17/26 17:30 adl      BENCH_BATCH_SIZE
+ 10/17/26 15:58 adl      no ISR rings
+ 10/17/26 14:30 adl      BENCH_QUEUE_POW2
+ 10/17/26 13:05 adl      services 8 to 63 and BENCH_MAX_SERVICES
+ 10/17/26 10:24 adl      started coding
+*****************************************************************************/
+#ifndef BenchConfig_H
+#define BenchConfig_H
+
+#ifndef BENCH_NUM_SERVICES
+#define BENCH_NUM_SERVICES 4
+#endif
+
+// same depth as the MasterMachine queue
+#ifndef BENCH_QUEUE_SIZE
+#define BENCH_QUEUE_SIZE 4
+#endif
+
+// 1 to index every queue with a mask (BENCH_QUEUE_SIZE must be a power of 2)
+#ifndef BENCH_QUEUE_POW2
+#define BENCH_QUEUE_POW2 0
+#endif
+
+// the smallest ready set that holds them, unless asked for a bigger one
+#ifndef BENCH_MAX_SERVICES
+#if BENCH_NUM_SERVICES <= 8
+#define BENCH_MAX_SERVICES 8
+#elif BENCH_NUM_SERVICES <= 16
+#define BENCH_MAX_SERVICES 16
+#elif BENCH_NUM_SERVICES <= 32
+#define BENCH_MAX_SERVICES 32
+#else
+#define BENCH_MAX_SERVICES 64
+#endif
+#endif
+
+#define MAX_NUM_SERVICES BENCH_MAX_SERVICES
+#define NUM_SERVICES BENCH_NUM_SERVICES
+
+// events ES_Run takes from a queue at once, 1 is the usual 1 at a time
+#ifndef BENCH_BATCH_SIZE
+#define BENCH_BATCH_SIZE 1
+#endif
+#define ES_RUN_BATCH_SIZE BENCH_BATCH_SIZE
+
+// 1 to keep the queue statistics
+#ifndef BENCH_QUEUE_STATS
+#define BENCH_QUEUE_STATS 0
+#endif
+#define ES_QUEUE_STATS BENCH_QUEUE_STATS
+
+// 1 to keep the dispatch profile
+#ifndef BENCH_PROFILE
+#define BENCH_PROFILE 0
+#endif
+#define ES_PROFILE BENCH_PROFILE
+
+#define SERV_0_HEADER "BenchServices.h"
+#define SERV_0_INIT BenchServiceInit
+#define SERV_0_RUN BenchServiceRun
+#define SERV_0_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_0_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_1_HEADER "BenchServices.h"
+#define SERV_1_INIT BenchServiceInit
+#define SERV_1_RUN BenchServiceRun
+#define SERV_1_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_1_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_2_HEADER "BenchServices.h"
+#define SERV_2_INIT BenchServiceInit
+#define SERV_2_RUN BenchServiceRun
+#define SERV_2_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_2_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_3_HEADER "BenchServices.h"
+#define SERV_3_INIT BenchServiceInit
+#define SERV_3_RUN BenchServiceRun
+#define SERV_3_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_3_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_4_HEADER "BenchServices.h"
+#define SERV_4_INIT BenchServiceInit
+#define SERV_4_RUN BenchServiceRun
+#define SERV_4_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_4_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_5_HEADER "BenchServices.h"
+#define SERV_5_INIT BenchServiceInit
+#define SERV_5_RUN BenchServiceRun
+#define SERV_5_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_5_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_6_HEADER "BenchServices.h"
+#define SERV_6_INIT BenchServiceInit
+#define SERV_6_RUN BenchServiceRun
+#define SERV_6_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_6_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_7_HEADER "BenchServices.h"
+#define SERV_7_INIT BenchServiceInit
+#define SERV_7_RUN BenchServiceRun
+#define SERV_7_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_7_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_8_HEADER "BenchServices.h"
+#define SERV_8_INIT BenchServiceInit
+#define SERV_8_RUN BenchServiceRun
+#define SERV_8_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_8_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_9_HEADER "BenchServices.h"
+#define SERV_9_INIT BenchServiceInit
+#define SERV_9_RUN BenchServiceRun
+#define SERV_9_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_9_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_10_HEADER "BenchServices.h"
+#define SERV_10_INIT BenchServiceInit
+#define SERV_10_RUN BenchServiceRun
+#define SERV_10_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_10_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_11_HEADER "BenchServices.h"
+#define SERV_11_INIT BenchServiceInit
+#define SERV_11_RUN BenchServiceRun
+#define SERV_11_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_11_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_12_HEADER "BenchServices.h"
+#define SERV_12_INIT BenchServiceInit
+#define SERV_12_RUN BenchServiceRun
+#define SERV_12_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_12_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_13_HEADER "BenchServices.h"
+#define SERV_13_INIT BenchServiceInit
+#define SERV_13_RUN BenchServiceRun
+#define SERV_13_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_13_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_14_HEADER "BenchServices.h"
+#define SERV_14_INIT BenchServiceInit
+#define SERV_14_RUN BenchServiceRun
+#define SERV_14_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_14_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_15_HEADER "BenchServices.h"
+#define SERV_15_INIT BenchServiceInit
+#define SERV_15_RUN BenchServiceRun
+#define SERV_15_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_15_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_16_HEADER "BenchServices.h"
+#define SERV_16_INIT BenchServiceInit
+#define SERV_16_RUN BenchServiceRun
+#define SERV_16_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_16_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_17_HEADER "BenchServices.h"
+#define SERV_17_INIT BenchServiceInit
+#define SERV_17_RUN BenchServiceRun
+#define SERV_17_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_17_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_18_HEADER "BenchServices.h"
+#define SERV_18_INIT BenchServiceInit
+#define SERV_18_RUN BenchServiceRun
+#define SERV_18_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_18_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_19_HEADER "BenchServices.h"
+#define SERV_19_INIT BenchServiceInit
+#define SERV_19_RUN BenchServiceRun
+#define SERV_19_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_19_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_20_HEADER "BenchServices.h"
+#define SERV_20_INIT BenchServiceInit
+#define SERV_20_RUN BenchServiceRun
+#define SERV_20_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_20_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_21_HEADER "BenchServices.h"
+#define SERV_21_INIT BenchServiceInit
+#define SERV_21_RUN BenchServiceRun
+#define SERV_21_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_21_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_22_HEADER "BenchServices.h"
+#define SERV_22_INIT BenchServiceInit
+#define SERV_22_RUN BenchServiceRun
+#define SERV_22_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_22_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_23_HEADER "BenchServices.h"
+#define SERV_23_INIT BenchServiceInit
+#define SERV_23_RUN BenchServiceRun
+#define SERV_23_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_23_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_24_HEADER "BenchServices.h"
+#define SERV_24_INIT BenchServiceInit
+#define SERV_24_RUN BenchServiceRun
+#define SERV_24_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_24_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_25_HEADER "BenchServices.h"
+#define SERV_25_INIT BenchServiceInit
+#define SERV_25_RUN BenchServiceRun
+#define SERV_25_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_25_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_26_HEADER "BenchServices.h"
+#define SERV_26_INIT BenchServiceInit
+#define SERV_26_RUN BenchServiceRun
+#define SERV_26_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_26_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_27_HEADER "BenchServices.h"
+#define SERV_27_INIT BenchServiceInit
+#define SERV_27_RUN BenchServiceRun
+#define SERV_27_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_27_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_28_HEADER "BenchServices.h"
+#define SERV_28_INIT BenchServiceInit
+#define SERV_28_RUN BenchServiceRun
+#define SERV_28_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_28_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_29_HEADER "BenchServices.h"
+#define SERV_29_INIT BenchServiceInit
+#define SERV_29_RUN BenchServiceRun
+#define SERV_29_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_29_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_30_HEADER "BenchServices.h"
+#define SERV_30_INIT BenchServiceInit
+#define SERV_30_RUN BenchServiceRun
+#define SERV_30_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_30_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_31_HEADER "BenchServices.h"
+#define SERV_31_INIT BenchServiceInit
+#define SERV_31_RUN BenchServiceRun
+#define SERV_31_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_31_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_32_HEADER "BenchServices.h"
+#define SERV_32_INIT BenchServiceInit
+#define SERV_32_RUN BenchServiceRun
+#define SERV_32_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_32_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_33_HEADER "BenchServices.h"
+#define SERV_33_INIT BenchServiceInit
+#define SERV_33_RUN BenchServiceRun
+#define SERV_33_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_33_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_34_HEADER "BenchServices.h"
+#define SERV_34_INIT BenchServiceInit
+#define SERV_34_RUN BenchServiceRun
+#define SERV_34_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_34_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_35_HEADER "BenchServices.h"
+#define SERV_35_INIT BenchServiceInit
+#define SERV_35_RUN BenchServiceRun
+#define SERV_35_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_35_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_36_HEADER "BenchServices.h"
+#define SERV_36_INIT BenchServiceInit
+#define SERV_36_RUN BenchServiceRun
+#define SERV_36_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_36_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_37_HEADER "BenchServices.h"
+#define SERV_37_INIT BenchServiceInit
+#define SERV_37_RUN BenchServiceRun
+#define SERV_37_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_37_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_38_HEADER "BenchServices.h"
+#define SERV_38_INIT BenchServiceInit
+#define SERV_38_RUN BenchServiceRun
+#define SERV_38_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_38_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_39_HEADER "BenchServices.h"
+#define SERV_39_INIT BenchServiceInit
+#define SERV_39_RUN BenchServiceRun
+#define SERV_39_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_39_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_40_HEADER "BenchServices.h"
+#define SERV_40_INIT BenchServiceInit
+#define SERV_40_RUN BenchServiceRun
+#define SERV_40_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_40_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_41_HEADER "BenchServices.h"
+#define SERV_41_INIT BenchServiceInit
+#define SERV_41_RUN BenchServiceRun
+#define SERV_41_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_41_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_42_HEADER "BenchServices.h"
+#define SERV_42_INIT BenchServiceInit
+#define SERV_42_RUN BenchServiceRun
+#define SERV_42_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_42_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_43_HEADER "BenchServices.h"
+#define SERV_43_INIT BenchServiceInit
+#define SERV_43_RUN BenchServiceRun
+#define SERV_43_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_43_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_44_HEADER "BenchServices.h"
+#define SERV_44_INIT BenchServiceInit
+#define SERV_44_RUN BenchServiceRun
+#define SERV_44_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_44_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_45_HEADER "BenchServices.h"
+#define SERV_45_INIT BenchServiceInit
+#define SERV_45_RUN BenchServiceRun
+#define SERV_45_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_45_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_46_HEADER "BenchServices.h"
+#define SERV_46_INIT BenchServiceInit
+#define SERV_46_RUN BenchServiceRun
+#define SERV_46_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_46_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_47_HEADER "BenchServices.h"
+#define SERV_47_INIT BenchServiceInit
+#define SERV_47_RUN BenchServiceRun
+#define SERV_47_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_47_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_48_HEADER "BenchServices.h"
+#define SERV_48_INIT BenchServiceInit
+#define SERV_48_RUN BenchServiceRun
+#define SERV_48_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_48_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_49_HEADER "BenchServices.h"
+#define SERV_49_INIT BenchServiceInit
+#define SERV_49_RUN BenchServiceRun
+#define SERV_49_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_49_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_50_HEADER "BenchServices.h"
+#define SERV_50_INIT BenchServiceInit
+#define SERV_50_RUN BenchServiceRun
+#define SERV_50_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_50_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_51_HEADER "BenchServices.h"
+#define SERV_51_INIT BenchServiceInit
+#define SERV_51_RUN BenchServiceRun
+#define SERV_51_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_51_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_52_HEADER "BenchServices.h"
+#define SERV_52_INIT BenchServiceInit
+#define SERV_52_RUN BenchServiceRun
+#define SERV_52_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_52_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_53_HEADER "BenchServices.h"
+#define SERV_53_INIT BenchServiceInit
+#define SERV_53_RUN BenchServiceRun
+#define SERV_53_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_53_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_54_HEADER "BenchServices.h"
+#define SERV_54_INIT BenchServiceInit
+#define SERV_54_RUN BenchServiceRun
+#define SERV_54_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_54_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_55_HEADER "BenchServices.h"
+#define SERV_55_INIT BenchServiceInit
+#define SERV_55_RUN BenchServiceRun
+#define SERV_55_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_55_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_56_HEADER "BenchServices.h"
+#define SERV_56_INIT BenchServiceInit
+#define SERV_56_RUN BenchServiceRun
+#define SERV_56_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_56_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_57_HEADER "BenchServices.h"
+#define SERV_57_INIT BenchServiceInit
+#define SERV_57_RUN BenchServiceRun
+#define SERV_57_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_57_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_58_HEADER "BenchServices.h"
+#define SERV_58_INIT BenchServiceInit
+#define SERV_58_RUN BenchServiceRun
+#define SERV_58_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_58_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_59_HEADER "BenchServices.h"
+#define SERV_59_INIT BenchServiceInit
+#define SERV_59_RUN BenchServiceRun
+#define SERV_59_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_59_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_60_HEADER "BenchServices.h"
+#define SERV_60_INIT BenchServiceInit
+#define SERV_60_RUN BenchServiceRun
+#define SERV_60_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_60_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_61_HEADER "BenchServices.h"
+#define SERV_61_INIT BenchServiceInit
+#define SERV_61_RUN BenchServiceRun
+#define SERV_61_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_61_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_62_HEADER "BenchServices.h"
+#define SERV_62_INIT BenchServiceInit
+#define SERV_62_RUN BenchServiceRun
+#define SERV_62_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_62_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define SERV_63_HEADER "BenchServices.h"
+#define SERV_63_INIT BenchServiceInit
+#define SERV_63_RUN BenchServiceRun
+#define SERV_63_QUEUE_SIZE BENCH_QUEUE_SIZE
+#define SERV_63_QUEUE_POW2 BENCH_QUEUE_POW2
+
+#define POST_KEY_FUNC ES_PostAll
+
+#define NUM_DIST_LISTS 0
+
+// BenchTermio sets this to take keys through an ISR ring, the rest have none
+#ifdef BENCH_KEY_POST
+#define NUM_ISR_RINGS 1
+#define ISR_RING_SIZE 16
+#define ISR_RING0_POST_FUNC BENCH_KEY_POST
+#define KEY_RING 0
+#else
+#define NUM_ISR_RINGS 0
+#endif
+
+// with no rings, BenchFSR takes the FSR's answers itself
+#define FSR_POST_FUNC BenchFSRResult
+
+#define EVENT_CHECK_HEADER "BenchServices.h"
+#define EVENT_CHECK_LIST BenchCheckEvents
+
+// BenchTimers sets these to run its timers, the rest have none
+#ifndef BENCH_NUM_TIMERS
+#define BENCH_NUM_TIMERS 8
+#endif
+#ifndef BENCH_TIMER_POST
+#define BENCH_TIMER_POST TIMER_UNUSED
+#endif
+#define ES_NUM_TIMERS BENCH_NUM_TIMERS
+
+#define TIMER0_RESP_FUNC BENCH_TIMER_POST
+#define TIMER1_RESP_FUNC BENCH_TIMER_POST
+#define TIMER2_RESP_FUNC BENCH_TIMER_POST
+#define TIMER3_RESP_FUNC BENCH_TIMER_POST
+#define TIMER4_RESP_FUNC BENCH_TIMER_POST
+#define TIMER5_RESP_FUNC BENCH_TIMER_POST
+#define TIMER6_RESP_FUNC BENCH_TIMER_POST
+#define TIMER7_RESP_FUNC BENCH_TIMER_POST
+#define TIMER8_RESP_FUNC BENCH_TIMER_POST
+#define TIMER9_RESP_FUNC BENCH_TIMER_POST
+#define TIMER10_RESP_FUNC BENCH_TIMER_POST
+#define TIMER11_RESP_FUNC BENCH_TIMER_POST
+#define TIMER12_RESP_FUNC BENCH_TIMER_POST
+#define TIMER13_RESP_FUNC BENCH_TIMER_POST
+#define TIMER14_RESP_FUNC BENCH_TIMER_POST
+#define TIMER15_RESP_FUNC BENCH_TIMER_POST
+#define TIMER16_RESP_FUNC BENCH_TIMER_POST
+#define TIMER17_RESP_FUNC BENCH_TIMER_POST
+#define TIMER18_RESP_FUNC BENCH_TIMER_POST
+#define TIMER19_RESP_FUNC BENCH_TIMER_POST
+#define TIMER20_RESP_FUNC BENCH_TIMER_POST
+#define TIMER21_RESP_FUNC BENCH_TIMER_POST
+#define TIMER22_RESP_FUNC BENCH_TIMER_POST
+#define TIMER23_RESP_FUNC BENCH_TIMER_POST
+#define TIMER24_RESP_FUNC BENCH_TIMER_POST
+#define TIMER25_RESP_FUNC BENCH_TIMER_POST
+#define TIMER26_RESP_FUNC BENCH_TIMER_POST
+#define TIMER27_RESP_FUNC BENCH_TIMER_POST
+#define TIMER28_RESP_FUNC BENCH_TIMER_POST
+#define TIMER29_RESP_FUNC BENCH_TIMER_POST
+#define TIMER30_RESP_FUNC BENCH_TIMER_POST
+#define TIMER31_RESP_FUNC BENCH_TIMER_POST
+#define TIMER32_RESP_FUNC BENCH_TIMER_POST
+#define TIMER33_RESP_FUNC BENCH_TIMER_POST
+#define TIMER34_RESP_FUNC BENCH_TIMER_POST
+#define TIMER35_RESP_FUNC BENCH_TIMER_POST
+#define TIMER36_RESP_FUNC BENCH_TIMER_POST
+#define TIMER37_RESP_FUNC BENCH_TIMER_POST
+#define TIMER38_RESP_FUNC BENCH_TIMER_POST
+#define TIMER39_RESP_FUNC BENCH_TIMER_POST
+#define TIMER40_RESP_FUNC BENCH_TIMER_POST
+#define TIMER41_RESP_FUNC BENCH_TIMER_POST
+#define TIMER42_RESP_FUNC BENCH_TIMER_POST
+#define TIMER43_RESP_FUNC BENCH_TIMER_POST
+#define TIMER44_RESP_FUNC BENCH_TIMER_POST
+#define TIMER45_RESP_FUNC BENCH_TIMER_POST
+#define TIMER46_RESP_FUNC BENCH_TIMER_POST
+#define TIMER47_RESP_FUNC BENCH_TIMER_POST
+#define TIMER48_RESP_FUNC BENCH_TIMER_POST
+#define TIMER49_RESP_FUNC BENCH_TIMER_POST
+#define TIMER50_RESP_FUNC BENCH_TIMER_POST
+#define TIMER51_RESP_FUNC BENCH_TIMER_POST
+#define TIMER52_RESP_FUNC BENCH_TIMER_POST
+#define TIMER53_RESP_FUNC BENCH_TIMER_POST
+#define TIMER54_RESP_FUNC BENCH_TIMER_POST
+#define TIMER55_RESP_FUNC BENCH_TIMER_POST
+#define TIMER56_RESP_FUNC BENCH_TIMER_POST
+#define TIMER57_RESP_FUNC BENCH_TIMER_POST
+#define TIMER58_RESP_FUNC BENCH_TIMER_POST
+#define TIMER59_RESP_FUNC BENCH_TIMER_POST
+#define TIMER60_RESP_FUNC BENCH_TIMER_POST
+#define TIMER61_RESP_FUNC BENCH_TIMER_POST
+#define TIMER62_RESP_FUNC BENCH_TIMER_POST
+#define TIMER63_RESP_FUNC BENCH_TIMER_POST
+
+#endif /* BenchConfig_H */
@@ -0,0 +1,253 @@
+/****************************************************************************
+ Module
+     BenchDispatch.c
+ Description
+     Host benchmark for the ES_Run dispatch loop. Millions of synthetic
+     events are posted through ES_PostToService to BENCH_NUM_SERVICES dummy
+     services and dispatched by the real ES_Run.
+ Notes
+     usage: BenchDispatch [NumEvents [BurstSize]]
+
+     The event generator is the framework's only event checker, so it runs
+     whenever ES_Run finds all of the queues empty. Each pass it posts a
+     burst of BurstSize events, round robin over the services (by default
+     enough to fill every queue). When the last event has been dispatched the
+     service returns ES_ERROR, which makes ES_Run return.
+
+     The first run measures throughput with no time stamps taken. The second
+     run stamps every post and reports the percentiles of the post to
+     dispatch latency.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 18:45 adl      prints the queue statistics when they are kept
+ 10/17/26 10:40 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "BenchServices.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_EVENTS 4000000UL
+// one post time stamp per possible EventParam value
+#define STAMP_RING_SIZE 65536UL
+
+/*---------------------------- Module Functions ---------------------------*/
+static void RunOnce( boolean TakeStamps );
+#if ES_QUEUE_STATS
+static void PrintQueueStats( void );
+#endif
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumEvents = DEFAULT_NUM_EVENTS;
+static uint32_t BurstSize = NUM_SERVICES * BENCH_QUEUE_SIZE;
+
+static uint32_t Posted;
+static uint32_t Dispatched;
+static uint32_t Dropped;
+
+static boolean Stamping;
+static uint64_t PostStamp[STAMP_RING_SIZE];
+static uint32_t *pLatency;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  uint64_t Start;
+  uint64_t Elapsed;
+  unsigned long CriticalStart;
+
+  if ( argc > 1 )
+    NumEvents = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    BurstSize = (uint32_t)strtoul( argv[2], NULL, 0 );
+  if ( (NumEvents == 0) || (BurstSize == 0) ) {
+    printf( "usage: %s [NumEvents [BurstSize]]\n", argv[0] );
+    return 1;
+  }
+  pLatency = malloc( NumEvents * sizeof(pLatency[0]) );
+  if ( pLatency == NULL ) {
+    printf( "could not allocate %lu latency samples\n",
+            (unsigned long)NumEvents );
+    return 1;
+  }
+
+  if ( ES_Initialize( ES_Timer_RATE_2MS ) != Success ) {
+    printf( "ES_Initialize failed\n" );
+    return 1;
+  }
+  printf( "ES_Run dispatch: %lu events, %d services, queue size %d, "
+          "burst %lu\n", (unsigned long)NumEvents, NUM_SERVICES,
+          BENCH_QUEUE_SIZE, (unsigned long)BurstSize );
+
+  // throughput, no per event time stamps
+  CriticalStart = ES_Port_CriticalCount;
+  Start = Bench_NowNs();
+  RunOnce( False );
+  Elapsed = Bench_NowNs() - Start;
+  printf( "throughput               %.0f events/s  (%.1f ns/event, "
+          "%.2f critical regions/event)\n",
+          (double)Dispatched * 1e9 / (double)Elapsed,
+          (double)Elapsed / (double)Dispatched,
+          (double)(ES_Port_CriticalCount - CriticalStart) /
+                                                      (double)Dispatched );
+  if ( Dropped != 0 )
+    printf( "dropped posts            %lu\n", (unsigned long)Dropped );
+
+  // latency from ES_PostToService to the service's run function
+  RunOnce( True );
+  Bench_ReportPercentiles( "post to dispatch", pLatency, Dispatched, "ns" );
+#if ES_QUEUE_STATS
+  PrintQueueStats();
+#endif
+
+  free( pLatency );
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   BenchServiceInit
+ Parameters
+   uint8_t : the priority of this service
+ Returns
+   boolean, always True
+ Description
+   dummy service init, nothing to set up
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 10:52
+****************************************************************************/
+boolean BenchServiceInit( uint8_t Priority )
+{
+  (void)Priority;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   BenchServiceRun
+ Parameters
+   ES_Event : the event to process
+ Returns
+   ES_Event, ES_NO_EVENT until the last event of the run, ES_ERROR then
+ Description
+   dummy service, counts the event and records its latency when stamping
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 10:55
+****************************************************************************/
+ES_Event BenchServiceRun( ES_Event ThisEvent )
+{
+  ES_Event ReturnEvent;
+
+  if ( Stamping == True )
+    pLatency[Dispatched] =
+                    (uint32_t)(Bench_NowNs() - PostStamp[ThisEvent.EventParam]);
+  Dispatched++;
+
+  ReturnEvent.EventType = (Dispatched == NumEvents) ? ES_ERROR : ES_NO_EVENT;
+  ReturnEvent.EventParam = 0;
+  return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+   BenchCheckEvents
+ Parameters
+   None
+ Returns
+   boolean : True if any events were posted
+ Description
+   the event generator, posts the next burst round robin over the services
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 11:02
+****************************************************************************/
+boolean BenchCheckEvents( void )
+{
+  ES_Event ThisEvent;
+  uint32_t i;
+
+  ThisEvent.EventType = ES_TIMEOUT;
+  for ( i = 0; (i < BurstSize) && (Posted < NumEvents); i++ ) {
+    ThisEvent.EventParam = (uint16_t)Posted;
+    if ( Stamping == True )
+      PostStamp[ThisEvent.EventParam] = Bench_NowNs();
+    if ( ES_PostToService( (uint8_t)(Posted % NUM_SERVICES), ThisEvent )
+                                                                 != True ) {
+      Dropped++;
+      break; // that queue is full, let ES_Run drain it
+    }
+    Posted++;
+  }
+  return (i != 0);
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   RunOnce
+ Parameters
+   boolean TakeStamps : True to record the latency of every event
+ Returns
+   None
+ Description
+   dispatches NumEvents events through ES_Run
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 11:10
+****************************************************************************/
+static void RunOnce( boolean TakeStamps )
+{
+  Posted = 0;
+  Dispatched = 0;
+  Dropped = 0;
+  Stamping = TakeStamps;
+#if ES_QUEUE_STATS
+  ES_ClearAllQueueStats();
+#endif
+  if ( ES_Run() != FailedRun )
+    printf( "ES_Run returned unexpectedly\n" );
+}
+
+#if ES_QUEUE_STATS
+/****************************************************************************
+ Function
+   PrintQueueStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   prints the statistics of each service's queue for the last run
+ Notes
+   nothing ticks the timers here, so the waits are always 0
+ Author
+   Alex Loo, 10/17/26, 18:47
+****************************************************************************/
+static void PrintQueueStats( void )
+{
+  ES_QueueStats_t Stats;
+  uint8_t i;
+
+  printf( "serv  size  high      posts  drops\n" );
+  for ( i = 0; i < NUM_SERVICES; i++ ) {
+    ES_QueryServiceQueue( i, &Stats );
+    printf( "%4u  %4u  %4u %10lu %6u\n", i, Stats.QueueSize, Stats.HighWater,
+            (unsigned long)Stats.Posts, Stats.Drops );
+  }
+}
+#endif
+/*------------------------------ End of file ------------------------------*/
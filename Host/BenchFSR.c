@@ -0,0 +1,226 @@
+/****************************************************************************
+ Module
+     BenchFSR.c
+ Description
+     Host benchmark for the FSR query scheduler in FSR.c, talking to the
+     FSRSim stand-in for the field controller
+ Notes
+     usage: BenchFSR [NumQueries [ErrorPercent]]
+
+     Each of the 6 queries is kept asked, as the field state service does:
+     as soon as its answer comes in it is asked again, due back within the
+     deadline of its class. Time is the simulated RTI (2.048 mS a tick), so
+     the throughput is what the FSR link would carry, not host speed. Per
+     class it reports the ticks from FSR_Query to ES_FSR_RESULT and how many
+     answers missed their deadline. Every answer is checked against the
+     value FSRSim gave, and no byte may go out sooner than the FSR allows.
+     The load is more than the link carries, so the lower classes and any
+     late queries show what the scheduler put first.
+
+     With bytes garbled, some tries fail and are tried again; a query that
+     runs out of tries ends in ES_FSR_ERROR, counted as failed. At 100%
+     the FSR is dead: every query must fail, and none may take longer than
+     every query's tries in turn could (MAX_QUERY_TICKS).
+
+     BenchFSR_pipeline is the same with FSR_PIPELINE set.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:30 adl      the answers come to FSR_POST_FUNC, see BenchConfig.h
+ 10/18/26 00:40 adl      ES_FSR_ERROR, FSR_QueryStats, up to 100% garbled
+ 10/18/26 00:05 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Timers.h"
+#include "ES_Port.h"
+#include "FSR.h"
+#include "FSRSim.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_QUERIES 20000UL
+#define NUM_CLASSES 3
+#define TICK_MS 2.048
+// give up if the FSR stops answering
+#define MAX_TICKS_PER_QUERY 1000UL
+// the longest a try can take: the wait for the FSR to sync, a byte timeout,
+// the gap, a byte timeout; and so the longest a query can wait for every
+// query's tries ahead of it
+#define MAX_TRY_TICKS (27 + 3 + 2 + 3)
+#define MAX_QUERY_TICKS (FSR_NUM_QUERIES * FSR_MAX_TRIES * MAX_TRY_TICKS)
+
+#if FSR_PIPELINE
+#define PIPELINE_NAME ", pipelined"
+#else
+#define PIPELINE_NAME ""
+#endif
+
+/*---------------------------- Module Functions ---------------------------*/
+boolean BenchFSRResult( ES_Event ThisEvent );
+static void AskAll( void );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumQueries = DEFAULT_NUM_QUERIES;
+
+// class of each query, and the deadline given to each class
+static unsigned char const Class[FSR_NUM_QUERIES] = { 2, 1, 1, 1, 1, 0 };
+static uint16_t const ClassDeadline[NUM_CLASSES] = { 10, 50, 100 };
+static char const * const ClassName[NUM_CLASSES] =
+                                  { "wall angle", "bin counts", "balls in play" };
+
+static boolean Asking[FSR_NUM_QUERIES];
+static uint16_t AskTime[FSR_NUM_QUERIES];
+
+static uint32_t Answers;
+static uint32_t Failures;
+static uint32_t WrongAnswers;
+static uint32_t ClassAnswers[NUM_CLASSES];
+static uint32_t ClassFailures[NUM_CLASSES];
+static uint32_t ClassTicks[NUM_CLASSES];
+static uint16_t ClassMaxTicks[NUM_CLASSES];
+static uint32_t ClassLate[NUM_CLASSES];
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  unsigned int ErrorPercent = 0;
+  uint32_t Ticks = 0;
+  FSR_Stats_t Stats;
+  unsigned char i;
+
+  if ( argc > 1 )
+    NumQueries = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    ErrorPercent = (unsigned int)strtoul( argv[2], NULL, 0 );
+  if ( (NumQueries == 0) || (ErrorPercent > 100) ) {
+    printf( "usage: %s [NumQueries [ErrorPercent]], ErrorPercent up to 100\n",
+            argv[0] );
+    return 1;
+  }
+
+  ES_Timer_Init( ES_Timer_RATE_2MS );
+  SPI_Init();
+  for ( i = 0; i < FSR_NUM_QUERIES; i++ )
+    FSRSim_Value[i] = (unsigned int)(rand() % 100);
+  FSRSim_Value[FSR_WALL_ANGLE] = 2 * (unsigned int)(rand() % 180);
+  FSRSim_Init( ErrorPercent );
+
+  while ( (Answers + Failures < NumQueries) &&
+          (Ticks < NumQueries * MAX_TICKS_PER_QUERY) ) {
+    AskAll();
+    ES_Port_Tick();
+    Ticks++;
+  }
+
+  FSR_QueryStats( &Stats );
+  printf( "FSR queries%s: %lu answers, %lu failed in %lu ticks, "
+          "%u%% of bytes garbled\n", PIPELINE_NAME, (unsigned long)Answers,
+          (unsigned long)Failures, (unsigned long)Ticks, ErrorPercent );
+  printf( "throughput      %.1f queries/s, %.2f bytes/query\n",
+          (double)Answers * 1000.0 / ((double)Ticks * TICK_MS),
+          (Answers != 0) ? (double)FSRSim_Bytes / (double)Answers : 0.0 );
+  printf( "class           deadline  answers  mean ticks  max ticks  late"
+          "  failed\n" );
+  for ( i = 0; i < NUM_CLASSES; i++ ) {
+    printf( "%-14s  %8u  %7lu  %10.1f  %9u  %4lu  %6lu\n", ClassName[i],
+            ClassDeadline[i], (unsigned long)ClassAnswers[i],
+            (ClassAnswers[i] != 0) ? (double)ClassTicks[i] / ClassAnswers[i]
+                                   : 0.0,
+            ClassMaxTicks[i], (unsigned long)ClassLate[i],
+            (unsigned long)ClassFailures[i] );
+  }
+  printf( "retries %u, no sync %u, out of range %u, no reply %u, "
+          "longest %u ticks (bound %u)\n", Stats.Retries, Stats.SyncFailures,
+          Stats.OutOfRange, Stats.NoReply, Stats.LongestTicks,
+          MAX_QUERY_TICKS );
+  if ( (Answers + Failures < NumQueries) || (WrongAnswers != 0) ||
+       (FSRSim_TooSoon != 0) || (Stats.LongestTicks > MAX_QUERY_TICKS) ||
+       ((ErrorPercent == 100) && (Answers != 0)) ||
+       ((ErrorPercent == 0) && (Failures != 0)) ) {
+    printf( "FAIL: %lu wrong answers, %lu bytes too soon%s\n",
+            (unsigned long)WrongAnswers, (unsigned long)FSRSim_TooSoon,
+            (Answers + Failures < NumQueries) ? ", the FSR stopped answering"
+                                               : "" );
+    return 1;
+  }
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   BenchFSRResult
+ Parameters
+   ES_Event : ES_FSR_RESULT or ES_FSR_ERROR
+ Returns
+   boolean, always True
+ Description
+   the post function for every query, checks the answer and times it
+ Notes
+   runs from the (simulated) SPI interrupt
+ Author
+   Alex Loo, 10/18/26, 00:10
+****************************************************************************/
+boolean BenchFSRResult( ES_Event ThisEvent )
+{
+  FSR_Query_t Query = FSR_RESULT_QUERY( ThisEvent.EventParam );
+  uint16_t Ticks;
+  unsigned char ThisClass;
+
+  if ( ((ThisEvent.EventType != ES_FSR_RESULT) &&
+        (ThisEvent.EventType != ES_FSR_ERROR)) ||
+       (Query >= FSR_NUM_QUERIES) || (Asking[Query] != True) ) {
+    WrongAnswers++;
+    return True;
+  }
+  Asking[Query] = False;
+  ThisClass = Class[Query];
+  if ( ThisEvent.EventType == ES_FSR_ERROR ) {
+    ClassFailures[ThisClass]++;
+    Failures++;
+    return True;
+  }
+  if ( FSR_RESULT_VALUE( ThisEvent.EventParam ) != FSRSim_Value[Query] )
+    WrongAnswers++;
+  Ticks = (uint16_t)(ES_Timer_GetTime() - AskTime[Query]);
+  ClassAnswers[ThisClass]++;
+  ClassTicks[ThisClass] += Ticks;
+  if ( Ticks > ClassMaxTicks[ThisClass] )
+    ClassMaxTicks[ThisClass] = Ticks;
+  if ( Ticks > ClassDeadline[ThisClass] )
+    ClassLate[ThisClass]++;
+  Answers++;
+  return True;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   AskAll
+ Parameters
+   None
+ Returns
+   None
+ Description
+   asks every query that is not already being asked
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 00:12
+****************************************************************************/
+static void AskAll( void )
+{
+  unsigned char i;
+
+  for ( i = 0; i < FSR_NUM_QUERIES; i++ ) {
+    if ( (Asking[i] != True) &&
+         (FSR_Query( (FSR_Query_t)i, ClassDeadline[Class[i]] ) == True) ) {
+      Asking[i] = True;
+      AskTime[i] = ES_Timer_GetTime();
+    }
+  }
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Module
+     BenchQueue.c
+ Description
+     Host benchmark comparing the cost of ES_EnQueueFIFO and ES_DeQueue on
+     ordinary (modulo indexed) queues and power of 2 (mask indexed) queues
+ Notes
+     usage: BenchQueue [NumOps]
+
+     For each queue size the queue is kept half full while NumOps events are
+     pushed through it (1 EnQueue then 1 DeQueue), so the indices wrap all
+     the time. The figures are TSC cycles (or ns where there is no TSC) per
+     EnQueue/DeQueue pair, the best of several passes to keep scheduling
+     noise out of them.
+
+     On the host the divide overlaps with the rest of the work, so the gap
+     is smaller than on the S12, where the modulo is a call to the runtime
+     library's divide and the mask is a single ANDB.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 14:40 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Queue.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_OPS 10000000UL
+#define NUM_PASSES 5
+// largest queue measured, plus the queue header
+#define MAX_BLOCK_SIZE (64+1)
+
+/*---------------------------- Module Functions ---------------------------*/
+static double MeasureQueue( uint8_t QueueSize, boolean Pow2 );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumOps = DEFAULT_NUM_OPS;
+static ES_Event Block[MAX_BLOCK_SIZE];
+
+static uint8_t const QueueSizes[] = { 4, 8, 16, 32, 64 };
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  double Modulo;
+  double Mask;
+  uint8_t i;
+
+  if ( argc > 1 )
+    NumOps = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( NumOps == 0 ) {
+    printf( "usage: %s [NumOps]\n", argv[0] );
+    return 1;
+  }
+
+  printf( "ES_Queue: %lu EnQueue/DeQueue pairs per pass, best of %d passes,"
+          " %s per pair\n", (unsigned long)NumOps, NUM_PASSES,
+          Bench_CycleUnits() );
+  printf( "size    modulo      mask\n" );
+  for ( i = 0; i < sizeof(QueueSizes); i++ ) {
+    Modulo = MeasureQueue( QueueSizes[i], False );
+    Mask = MeasureQueue( QueueSizes[i], True );
+    printf( "%4u  %8.1f  %8.1f\n", QueueSizes[i], Modulo, Mask );
+  }
+  return 0;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   MeasureQueue
+ Parameters
+   uint8_t QueueSize : number of entries in the queue
+   boolean Pow2 : True for a mask indexed queue
+ Returns
+   double : cost of 1 EnQueue plus 1 DeQueue
+ Description
+   keeps the queue half full while NumOps events go through it
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 14:48
+****************************************************************************/
+static double MeasureQueue( uint8_t QueueSize, boolean Pow2 )
+{
+  ES_Event ThisEvent;
+  uint64_t Start;
+  uint64_t Elapsed;
+  uint64_t Best = ~(uint64_t)0;
+  uint32_t Done;
+  uint8_t Pass;
+  uint8_t i;
+
+  if ( Pow2 == True )
+    ES_InitQueuePow2( Block, (unsigned char)(QueueSize + 1) );
+  else
+    ES_InitQueue( Block, (unsigned char)(QueueSize + 1) );
+  ThisEvent.EventType = ES_TIMEOUT;
+  ThisEvent.EventParam = 0;
+  for ( i = 0; i < QueueSize / 2; i++ )
+    ES_EnQueueFIFO( Block, ThisEvent );
+
+  for ( Pass = 0; Pass < NUM_PASSES; Pass++ ) {
+    Start = Bench_Cycles();
+    for ( Done = 0; Done < NumOps; Done++ ) {
+      ES_EnQueueFIFO( Block, ThisEvent );
+      ES_DeQueue( Block, &ThisEvent );
+    }
+    Elapsed = Bench_Cycles() - Start;
+    if ( Elapsed < Best )
+      Best = Elapsed;
+  }
+  return (double)Best / (double)NumOps;
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,38 @@
+/****************************************************************************
+ Module
+     BenchServices.h
+ Description
+     prototypes for the dummy services and event checker that every host
+     benchmark provides. BenchConfig.h routes all of the framework's services
+     and its event checker list to these.
+ Notes
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:30 adl      BenchFSRResult
+ 10/18/26 02:40 adl      BenchKeyPost
+ 10/17/26 20:35 adl      BenchTimerPost
+ 10/17/26 10:20 adl      started coding
+*****************************************************************************/
+#ifndef BenchServices_H
+#define BenchServices_H
+
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+boolean BenchServiceInit( uint8_t Priority );
+ES_Event BenchServiceRun( ES_Event ThisEvent );
+boolean BenchCheckEvents( void );
+
+// the timers' post function, only BenchTimers has one (BENCH_TIMER_POST)
+boolean BenchTimerPost( ES_Event ThisEvent );
+
+// the key ring's post function, only BenchTermio has one (BENCH_KEY_POST)
+boolean BenchKeyPost( ES_Event ThisEvent );
+
+// the FSR's post function, only BenchFSR has one (FSR_POST_FUNC)
+boolean BenchFSRResult( ES_Event ThisEvent );
+
+#endif /* BenchServices_H */
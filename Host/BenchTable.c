@@ -0,0 +1,431 @@
+/****************************************************************************
+ Module
+     BenchTable.c
+ Description
+     Host check of the table driven state machines: the Scoring machine
+     run from ScoringSM_Table.h by ES_StateTable_Run, against the same
+     machine as it was with switches, kept in ScoringSM_Switch.c
+ Notes
+     usage: BenchTable [NumEvents [Rounds [Seed]]]
+
+     The stream is drawn at random from the events the machine takes, with
+     the parameters it looks at: each of its timers, each beacon (or none)
+     front and rear, the bumpers and the tape. Each step also says what
+     GetBeaconFront reports. Now and then the machine is left and started
+     again on a new target bin, as MasterMachine does, and it is whenever it
+     returns ES_BALL_BIN_EMPTY.
+
+     First the two are run side by side, a step at a time: after each step
+     both must be in the same state, have returned the same event, and have
+     made the same calls to the drivers and timers, with the same
+     arguments, in the same order (the stand-ins below hash them). Every
+     state must be visited, or the check shows little. Then each runs the
+     whole stream, Rounds times in turn, and the best time of each is
+     reported. These are host times; they say nothing of the dispatch time
+     or code size on the S12, which have not been measured.
+
+     The machines print, through StartScoringSM; stdout goes to /dev/null
+     while they run.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 15:40 adl      the switches are a checked-in copy again
+ 10/18/26 15:20 adl      host times only
+ 10/18/26 13:55 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Timers.h"
+#include "ScoringSM.h"
+#include "MotorDriver.h"
+#include "BinControl.h"
+#include "BeaconDetection.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_EVENTS 1000000UL
+#define DEFAULT_ROUNDS 5
+#define NUM_STATES (FindingRightBeacon + 1)
+// a step that leaves the machine and starts it again
+#define RESTART ES_NO_EVENT
+// 1 step in this many is a RESTART
+#define RESTART_ODDS 1000
+
+/*---------------------------- Module Types -------------------------------*/
+typedef struct {
+  ES_Event Event;         // or RESTART
+  unsigned char Front;    // what GetBeaconFront reports
+  unsigned char Bin;      // what PickScoringBin picks, on a restart
+} Step_t;
+
+typedef struct {
+  const char *Name;
+  void (*Start)( ES_Event );
+  ES_Event (*Run)( ES_Event );
+  ScoringState_t (*Query)( void );
+} Machine_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+void StartScoringSM_Switch( ES_Event );
+ES_Event RunScoringSM_Switch( ES_Event );
+ScoringState_t QueryScoringSM_Switch( void );
+
+static void MakeSteps( Step_t *pSteps, uint32_t NumSteps, uint32_t Seed );
+static ES_Event RunStep( const Machine_t *pMachine, const Step_t *pStep );
+static void StartMachine( const Machine_t *pMachine, unsigned char Bin );
+static uint32_t Check( const Step_t *pSteps, uint32_t NumSteps );
+static uint64_t Time( const Machine_t *pMachine, const Step_t *pSteps,
+                      uint32_t NumSteps );
+static void Note( uint32_t Call, uint32_t Arg );
+static uint32_t Random( uint32_t *pSeed, uint32_t Range );
+
+/*---------------------------- Module Variables ---------------------------*/
+static const Machine_t Machines[2] = {
+  { "switch", StartScoringSM_Switch, RunScoringSM_Switch,
+    QueryScoringSM_Switch },
+  { "table", StartScoringSM, RunScoringSM, QueryScoringSM }
+};
+
+// the timers the machine starts, and so the timeouts it may get
+static const uint16_t Timers[] = {
+  MOTION_TIMER, SHUFFLE_TIMER, SHUFFLE_STEP_TIMER, GO_TO_BACKUP_SEARCH_TIMER,
+  BEACON_NOD_TIMER, UNLOADING_DELAY_TIMER, UNLOADING_BUMP_TIMER
+};
+
+// the events a stream draws from, with ES_TIMEOUT as likely as the rest
+// together, as it is in a match
+static const ES_EventTyp_t Events[] = {
+  ES_TIMEOUT, ES_TIMEOUT, ES_TIMEOUT, ES_TIMEOUT, ES_TIMEOUT, ES_TIMEOUT,
+  ES_BEACON_FRONT, ES_BEACON_REAR, ES_FRONT_BUMPED, ES_REAR_BUMPED,
+  ES_LEFT_TAPE_DETECTED, ES_RIGHT_TAPE_DETECTED
+};
+
+ES_TimerHandle_t AppTimer[NUM_APP_TIMERS];
+
+// what the stand-ins report, and the hash of the calls made to them
+static unsigned char Front;
+static unsigned char TargetBin;
+static uint32_t FineTime;
+static uint32_t Digest;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  uint32_t NumEvents = DEFAULT_NUM_EVENTS;
+  unsigned int Rounds = DEFAULT_ROUNDS;
+  uint32_t Seed = 1;
+  uint64_t Best[2] = { 0, 0 };
+  uint64_t Ns;
+  uint32_t Failures;
+  Step_t *pSteps;
+  int Saved, Null;
+  unsigned int r, m;
+
+  if ( argc > 1 )
+    NumEvents = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    Rounds = (unsigned int)strtoul( argv[2], NULL, 0 );
+  if ( argc > 3 )
+    Seed = (uint32_t)strtoul( argv[3], NULL, 0 );
+  if ( (NumEvents == 0) || (Rounds == 0) ) {
+    printf( "usage: %s [NumEvents [Rounds [Seed]]]\n", argv[0] );
+    return 1;
+  }
+  pSteps = malloc( sizeof(Step_t) * NumEvents );
+  if ( pSteps == NULL ) {
+    printf( "FAIL: no memory for %lu events\n", (unsigned long)NumEvents );
+    return 1;
+  }
+  for ( m = 0; m < NUM_APP_TIMERS; m++ )
+    AppTimer[m] = (ES_TimerHandle_t)m;
+  MakeSteps( pSteps, NumEvents, Seed );
+
+  fflush( stdout );
+  Saved = dup( STDOUT_FILENO );
+  Null = open( "/dev/null", O_WRONLY );
+  if ( (Saved < 0) || (Null < 0) ) {
+    printf( "FAIL: cannot send stdout to /dev/null\n" );
+    return 1;
+  }
+  dup2( Null, STDOUT_FILENO );
+  Failures = Check( pSteps, NumEvents );
+  for ( r = 0; (Failures == 0) && (r < Rounds); r++ ) {
+    for ( m = 0; m < ARRAY_SIZE( Machines ); m++ ) {
+      Ns = Time( &Machines[m], pSteps, NumEvents );
+      if ( (r == 0) || (Ns < Best[m]) )
+        Best[m] = Ns;
+    }
+  }
+  fflush( stdout );
+  dup2( Saved, STDOUT_FILENO );
+  close( Null );
+  close( Saved );
+  free( pSteps );
+
+  if ( Failures != 0 )
+    return 1;
+  printf( "Scoring machine, %lu events from seed %lu: the same after every "
+          "event, best of %u rounds\n", (unsigned long)NumEvents,
+          (unsigned long)Seed, Rounds );
+  for ( m = 0; m < ARRAY_SIZE( Machines ); m++ )
+    printf( "%-8s %6.1f ns/event, %5.2f of the switch\n", Machines[m].Name,
+            (double)Best[m] / NumEvents, (double)Best[m] / Best[0] );
+  return 0;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   MakeSteps
+ Parameters
+   Step_t * pSteps : where to put the steps
+   uint32_t NumSteps : how many
+   uint32_t Seed : the stream's seed
+ Returns
+   None
+ Description
+   draws the stream, see the module notes
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 14:00
+****************************************************************************/
+static void MakeSteps( Step_t *pSteps, uint32_t NumSteps, uint32_t Seed )
+{
+  uint32_t i;
+
+  for ( i = 0; i < NumSteps; i++ ) {
+    pSteps[i].Front = (unsigned char)Random( &Seed, 5 );
+    pSteps[i].Bin = (unsigned char)(1 + Random( &Seed, 4 ));
+    if ( Random( &Seed, RESTART_ODDS ) == 0 ) {
+      pSteps[i].Event.EventType = RESTART;
+      pSteps[i].Event.EventParam = 0;
+      continue;
+    }
+    pSteps[i].Event.EventType = Events[Random( &Seed, ARRAY_SIZE( Events ) )];
+    switch ( pSteps[i].Event.EventType ) {
+      case ES_TIMEOUT:
+        pSteps[i].Event.EventParam = Timers[Random( &Seed,
+                                                    ARRAY_SIZE( Timers ) )];
+        break;
+      case ES_BEACON_FRONT:
+      case ES_BEACON_REAR:
+        pSteps[i].Event.EventParam = (uint16_t)Random( &Seed, 5 );
+        break;
+      default:
+        pSteps[i].Event.EventParam = 0;
+        break;
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   RunStep
+ Parameters
+   const Machine_t * pMachine : the machine to run
+   const Step_t * pStep : the step
+ Returns
+   ES_Event, what the machine returned, or ES_NO_EVENT for a restart
+ Description
+   runs 1 step through the machine, with the stand-ins reporting what the
+   step says; starts the machine again after ES_BALL_BIN_EMPTY
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 14:00
+****************************************************************************/
+static ES_Event RunStep( const Machine_t *pMachine, const Step_t *pStep )
+{
+  ES_Event ReturnEvent = pStep->Event;
+
+  Front = pStep->Front;
+  if ( pStep->Event.EventType == RESTART ) {
+    StartMachine( pMachine, pStep->Bin );
+    return ReturnEvent;
+  }
+  ReturnEvent = pMachine->Run( pStep->Event );
+  if ( ReturnEvent.EventType == ES_BALL_BIN_EMPTY )
+    StartMachine( pMachine, pStep->Bin );
+  return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+   StartMachine
+ Parameters
+   const Machine_t * pMachine : the machine
+   unsigned char NewBin : the target bin PickScoringBin is to pick
+ Returns
+   None
+ Description
+   leaves the machine's state, as MasterMachine does on leaving Scoring,
+   and starts it again
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 14:00
+****************************************************************************/
+static void StartMachine( const Machine_t *pMachine, unsigned char NewBin )
+{
+  ES_Event ThisEvent;
+
+  ThisEvent.EventParam = 0;
+  ThisEvent.EventType = ES_EXIT;
+  pMachine->Run( ThisEvent );
+  TargetBin = NewBin;
+  ThisEvent.EventType = ES_ENTRY;
+  pMachine->Start( ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   Check
+ Parameters
+   const Step_t * pSteps : the stream
+   uint32_t NumSteps : its length
+ Returns
+   uint32_t, the number of failures, 0 if the machines are the same
+ Description
+   runs the two side by side, a step at a time, and compares them after
+   each, see the module notes
+ Notes
+   reports on stderr, as stdout goes to /dev/null
+ Author
+   Alex Loo, 10/18/26, 14:05
+****************************************************************************/
+static uint32_t Check( const Step_t *pSteps, uint32_t NumSteps )
+{
+  uint32_t Visits[NUM_STATES] = { 0 };
+  ES_Event Returned[2];
+  ScoringState_t State[2];
+  uint32_t Calls[2];
+  uint32_t Failures = 0;
+  uint32_t i;
+  unsigned int m;
+
+  for ( m = 0; m < ARRAY_SIZE( Machines ); m++ )
+    StartMachine( &Machines[m], pSteps[0].Bin );
+  for ( i = 0; (i < NumSteps) && (Failures == 0); i++ ) {
+    for ( m = 0; m < ARRAY_SIZE( Machines ); m++ ) {
+      Digest = 2166136261UL;
+      FineTime = i * 1000UL;
+      Returned[m] = RunStep( &Machines[m], &pSteps[i] );
+      State[m] = Machines[m].Query();
+      Calls[m] = Digest;
+    }
+    Visits[State[1]]++;
+    if ( (State[0] != State[1]) ||
+         (Returned[0].EventType != Returned[1].EventType) ||
+         (Returned[0].EventParam != Returned[1].EventParam) ||
+         (Calls[0] != Calls[1]) ) {
+      fprintf( stderr, "FAIL: event %lu (%u, %u): switch to state %u "
+               "returning %u, table to state %u returning %u, calls %s\n",
+               (unsigned long)i, (unsigned int)pSteps[i].Event.EventType,
+               (unsigned int)pSteps[i].Event.EventParam,
+               (unsigned int)State[0], (unsigned int)Returned[0].EventType,
+               (unsigned int)State[1], (unsigned int)Returned[1].EventType,
+               (Calls[0] == Calls[1]) ? "the same" : "not the same" );
+      Failures++;
+    }
+  }
+  for ( m = 0; (Failures == 0) && (m < NUM_STATES); m++ ) {
+    if ( Visits[m] == 0 ) {
+      fprintf( stderr, "FAIL: state %u never visited\n", m );
+      Failures++;
+    }
+  }
+  return Failures;
+}
+
+/****************************************************************************
+ Function
+   Time
+ Parameters
+   const Machine_t * pMachine : the machine
+   const Step_t * pSteps : the stream
+   uint32_t NumSteps : its length
+ Returns
+   uint64_t, the nS the machine took over the stream
+ Description
+   starts the machine, then runs the whole stream through it
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 14:05
+****************************************************************************/
+static uint64_t Time( const Machine_t *pMachine, const Step_t *pSteps,
+                      uint32_t NumSteps )
+{
+  uint64_t Start;
+  uint32_t i;
+
+  StartMachine( pMachine, pSteps[0].Bin );
+  Start = Bench_NowNs();
+  for ( i = 0; i < NumSteps; i++ )
+    RunStep( pMachine, &pSteps[i] );
+  return Bench_NowNs() - Start;
+}
+
+/****************************************************************************
+ Function
+   Note
+ Parameters
+   uint32_t Call : which stand-in was called
+   uint32_t Arg : its argument
+ Returns
+   None
+ Description
+   adds a call to the hash of the calls (FNV-1a, a word at a time)
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 14:10
+****************************************************************************/
+static void Note( uint32_t Call, uint32_t Arg )
+{
+  Digest = (Digest ^ ((Call << 24) | Arg)) * 16777619UL;
+}
+
+static uint32_t Random( uint32_t *pSeed, uint32_t Range )
+{
+  *pSeed = *pSeed * 1664525UL + 1013904223UL;
+  return (*pSeed >> 8) % Range;
+}
+
+/*---------------------------- Stand-ins ----------------------------------*/
+// MotorDriver.h, BinControl.h, ES_Timers.h: each call is noted
+void GoForward( unsigned char Speed ) { Note( 1, Speed ); }
+void GoBackward( unsigned char Speed ) { Note( 2, Speed ); }
+void TurnLeft( void ) { Note( 3, 0 ); }
+void TurnLeftSpeedSelect( unsigned char Speed ) { Note( 4, Speed ); }
+void TurnRight( void ) { Note( 5, 0 ); }
+void TurnRightSpeedSelect( unsigned char Speed ) { Note( 6, Speed ); }
+void FullStop( void ) { Note( 7, 0 ); }
+void FanControl( char On ) { Note( 8, (uint32_t)(unsigned char)On ); }
+
+ES_TimerReturn_t ES_Timer_InitTimer( unsigned char Num, unsigned int NewTime )
+{
+  Note( 9, Num );
+  Note( 10, NewTime );
+  return ES_Timer_OK;
+}
+
+// the beacon sweep's times: a little later each time it is asked
+uint32_t ES_Timer_GetFineTime( void )
+{
+  FineTime += 3 * 1024;
+  return FineTime;
+}
+
+// BeaconDetection.h and ScoringMode.h: from the step
+unsigned char GetBeaconFront( void ) { return Front; }
+unsigned char PickScoringBin( void ) { return TargetBin; }
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,458 @@
+/****************************************************************************
+ Module
+     BenchTermio.c
+ Description
+     Host benchmark for the console in termio.c, run against the SCISim
+     stand-in for SCI0 with a pty on the other end
+ Notes
+     usage: BenchTermio [Seconds [Baud]]
+
+     A main loop does a fixed piece of work and then sends a 40 character
+     line, pass after pass, for Seconds in each of 2 ways:
+       blocking  the way TERMIO_PutChar used to: wait for TDRE and write
+                 each character to the port in turn
+       ring      TERMIO_Write, which takes the line into the transmit ring
+                 or, if there is no room for all of it, skips it; with a
+                 log record from ES_Log_Write after each line sent
+     and reports the bytes per second that came out of the pty and the time
+     each pass of the main loop took, which in the blocking loop is mostly
+     spent waiting on the port. On the host the blocking loop also falls
+     short of the line rate: each character waits for the main loop to see
+     TDRE, and the port's thread is not woken on time as an ISR would be.
+
+     A reader thread on the pty checks what comes out: the text must be the
+     lines, in order, and every log record whole, with its check right and
+     never broken into by text.
+
+     Last, keys typed into the pty must be posted through the key ring
+     (BENCH_KEY_POST) as ES_NEW_KEY, in order, and not pile up in the
+     receive ring that TERMIO_GetChar reads.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 14:20 adl      keys through the key ring only
+ 10/18/26 03:15 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termio.h>
+#include <unistd.h>
+#include "ES_Configure.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "ES_ISRRing.h"
+#include "ES_Log.h"
+#include "Console.h"
+#include "SCISim.h"
+#include "BenchServices.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_SECONDS 2
+#define DEFAULT_BAUD 115200UL
+#define LINE_LENGTH 40
+// the fixed work in each pass of the main loop
+#define WORK_LOOPS 2000
+#define MAX_SAMPLES (1UL << 20)
+// how long to wait for the port and the reader to finish
+#define DRAIN_NS 2000000000ULL
+#define KEYS "the quick brown fox"
+// keys typed at once, fewer than the receive and key rings hold, since the
+// port may deliver them all in 1 burst
+#define KEYS_AT_ONCE 8
+
+/*---------------------------- Module Functions ---------------------------*/
+static void RunLoop( boolean Blocking, unsigned int Seconds, uint32_t Baud );
+static void Work( void );
+static void PutBlocking( const char *pLine );
+static boolean WaitForPort( void );
+static void CheckKeys( int Slave );
+static void *ReadPty( void *pArg );
+static void TakeByte( uint8_t Byte );
+static void Fail( const char *pWhat );
+
+/*---------------------------- Module Variables ---------------------------*/
+static char const Line[LINE_LENGTH + 1] =
+                  "0123456789 abcdefghijklmnopqrstuvwxyz.\r\n";
+static uint32_t *pSamples;
+static volatile uint32_t WorkSink;
+static uint32_t Failures;
+
+// the reader: bytes seen, where it is in the text and in a record
+static int Slave;
+static volatile int Reading;
+static volatile uint32_t BytesRead;
+static uint32_t TextBytes;
+static uint32_t Records;
+static uint8_t Record[ES_LOG_RECORD_SIZE];
+static uint8_t Place;
+
+// keys posted through the key ring
+static char Posted[sizeof(KEYS)];
+static uint8_t NumPosted;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  unsigned int Seconds = DEFAULT_SECONDS;
+  uint32_t Baud = DEFAULT_BAUD;
+  pthread_t Reader;
+
+  if ( argc > 1 )
+    Seconds = (unsigned int)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    Baud = (uint32_t)strtoul( argv[2], NULL, 0 );
+  if ( (Seconds == 0) || (Baud < 300) || (Baud > 1000000) ) {
+    printf( "usage: %s [Seconds [Baud]], Baud 300 to 1000000\n", argv[0] );
+    return 1;
+  }
+  pSamples = malloc( MAX_SAMPLES * sizeof(pSamples[0]) );
+  if ( pSamples == NULL )
+    return 1;
+
+  ES_Timer_Init( ES_Timer_RATE_2MS );
+  ES_ISRRing_Init();
+  ES_Log_Init();
+  TERMIO_Init();
+  Slave = SCISim_Start( Baud );
+  if ( Slave < 0 ) {
+    printf( "no pty for the port\n" );
+    return 1;
+  }
+  Reading = 1;
+  pthread_create( &Reader, NULL, ReadPty, NULL );
+
+  printf( "console at %lu baud (%lu bytes/s), %u S a loop, %s\n",
+          (unsigned long)Baud, (unsigned long)(Baud / 10), Seconds,
+          "pass times in nS" );
+  RunLoop( True, Seconds, Baud );
+  RunLoop( False, Seconds, Baud );
+  CheckKeys( Slave );
+
+  __atomic_store_n( &Reading, 0, __ATOMIC_SEQ_CST );
+  pthread_join( Reader, NULL );
+  SCISim_Stop();
+  close( Slave );
+  free( pSamples );
+  if ( Failures != 0 ) {
+    printf( "FAIL: %lu mismatches\n", (unsigned long)Failures );
+    return 1;
+  }
+  printf( "PASS\n" );
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   BenchKeyPost
+ Parameters
+   ES_Event : the key, from the key ring
+ Returns
+   boolean, always True
+ Description
+   post function for the key ring, keeps the keys
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 03:18
+****************************************************************************/
+boolean BenchKeyPost( ES_Event ThisEvent )
+{
+  if ( ThisEvent.EventType != ES_NEW_KEY )
+    Fail( "key ring posted something other than ES_NEW_KEY" );
+  else if ( NumPosted < sizeof(Posted) - 1 )
+    Posted[NumPosted++] = (char)ThisEvent.EventParam;
+  return True;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   RunLoop
+ Parameters
+   boolean Blocking : True to send the old way, False through the ring
+   unsigned int Seconds : how long to run
+   uint32_t Baud : the port's baud rate, for the share of it used
+ Returns
+   None
+ Description
+   runs the main loop, waits for everything sent to come out of the pty,
+   and reports
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 03:20
+****************************************************************************/
+static void RunLoop( boolean Blocking, unsigned int Seconds, uint32_t Baud )
+{
+  uint64_t Start;
+  uint64_t End;
+  uint64_t PassStart;
+  uint64_t Now;
+  uint32_t NumSamples = 0;
+  uint32_t Lines = 0;
+  uint32_t Skipped = 0;
+  uint32_t RecordsBefore = Records;
+  uint32_t BytesBefore = __atomic_load_n( &BytesRead, __ATOMIC_SEQ_CST );
+  uint16_t DropsBefore = ES_Log_QueryDrops();
+  uint32_t Bytes;
+  uint16_t Logged = 0;
+  double Elapsed;
+
+  Start = Bench_NowNs();
+  End = Start + (uint64_t)Seconds * 1000000000ULL;
+  PassStart = Start;
+  do {
+    Work();
+    if ( Blocking == True ) {
+      PutBlocking( Line );
+      Lines++;
+    } else if ( TERMIO_TxRoom() >= LINE_LENGTH ) {
+      TERMIO_Write( Line, LINE_LENGTH );
+      Lines++;
+      ES_Log_Write( ES_LOG_KIND_NOTE, 0, 0, 1, (uint16_t)Lines );
+      Logged++;
+    } else {
+      Skipped++;
+    }
+    Now = Bench_NowNs();
+    pSamples[NumSamples++] = (uint32_t)(Now - PassStart);
+    PassStart = Now;
+  } while ( (Now < End) && (NumSamples < MAX_SAMPLES) );
+  Elapsed = (double)(Now - Start) / 1e9;
+
+  if ( WaitForPort() == False )
+    Fail( "port never finished sending" );
+  Bytes = __atomic_load_n( &BytesRead, __ATOMIC_SEQ_CST ) - BytesBefore;
+  printf( "%s: %lu passes, %lu lines sent, %lu skipped, %lu log records "
+          "(%u dropped)\n", (Blocking == True) ? "blocking" : "ring",
+          (unsigned long)NumSamples, (unsigned long)Lines,
+          (unsigned long)Skipped, (unsigned long)(Records - RecordsBefore),
+          (uint16_t)(ES_Log_QueryDrops() - DropsBefore) );
+  printf( "  %.0f bytes/s out of the pty, %.0f%% of the line\n",
+          Bytes / Elapsed, 100.0 * Bytes / Elapsed / (Baud / 10.0) );
+  Bench_ReportPercentiles( "  pass time", pSamples, NumSamples, "nS" );
+  if ( (uint16_t)(Records - RecordsBefore) !=
+       (uint16_t)(Logged - (ES_Log_QueryDrops() - DropsBefore)) )
+    Fail( "log records lost and not counted" );
+}
+
+/****************************************************************************
+ Function
+   Work
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the main loop's fixed piece of work
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 03:25
+****************************************************************************/
+static void Work( void )
+{
+  uint32_t Sum = WorkSink;
+  unsigned int i;
+
+  for ( i = 0; i < WORK_LOOPS; i++ )
+    Sum = Sum * 1103515245UL + 12345;
+  WorkSink = Sum;
+}
+
+/****************************************************************************
+ Function
+   PutBlocking
+ Parameters
+   const char * pLine : the line to send
+ Returns
+   None
+ Description
+   the old TERMIO_PutChar, a character at a time: wait for TDRE, write
+ Notes
+   the transmit interrupt stays off, so nothing else writes the port
+ Author
+   Alex Loo, 10/18/26, 03:27
+****************************************************************************/
+static void PutBlocking( const char *pLine )
+{
+  while ( *pLine != '\0' ) {
+    while ( SCISim_TxReady() == False )
+    {}; /* wait for the port */
+    SCISim_Write( (uint8_t)*pLine++ );
+  }
+}
+
+/****************************************************************************
+ Function
+   WaitForPort
+ Parameters
+   None
+ Returns
+   boolean : False if it took longer than DRAIN_NS
+ Description
+   waits for the port to send the rings out and for the reader to see it all
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 03:29
+****************************************************************************/
+static boolean WaitForPort( void )
+{
+  uint64_t GiveUp = Bench_NowNs() + DRAIN_NS;
+
+  while ( Bench_NowNs() < GiveUp ) {
+    if ( (__atomic_load_n( &ES_Port_SCI0TxOn, __ATOMIC_SEQ_CST ) == 0) &&
+         (SCISim_TxReady() == True) &&
+         (__atomic_load_n( &BytesRead, __ATOMIC_SEQ_CST ) ==
+          __atomic_load_n( &SCISim_TxBytes, __ATOMIC_SEQ_CST )) )
+      return True;
+    usleep( 1000 );
+  }
+  return False;
+}
+
+/****************************************************************************
+ Function
+   CheckKeys
+ Parameters
+   int Slave : the pty's slave, the keyboard
+ Returns
+   None
+ Description
+   types KEYS into the pty and checks that they come out through the key
+   ring, in order, with none left in the receive ring or counted lost
+ Notes
+   types KEYS_AT_ONCE keys at a time, waiting for each lot to come through.
+   KEYS is longer than the receive ring, so keys that also went into it
+   would show up as lost
+
+ Author
+   Alex Loo, 10/18/26, 03:32
+****************************************************************************/
+static void CheckKeys( int Slave )
+{
+  uint8_t NumTyped = 0;
+  uint8_t Typing;
+  uint64_t GiveUp = Bench_NowNs() + DRAIN_NS;
+
+  while ( (NumTyped < sizeof(KEYS) - 1) && (Bench_NowNs() < GiveUp) ) {
+    Typing = sizeof(KEYS) - 1 - NumTyped;
+    if ( Typing > KEYS_AT_ONCE )
+      Typing = KEYS_AT_ONCE;
+    if ( write( Slave, KEYS + NumTyped, Typing ) != Typing ) {
+      Fail( "could not type into the pty" );
+      return;
+    }
+    NumTyped += Typing;
+    while ( (NumPosted < NumTyped) && (Bench_NowNs() < GiveUp) )
+      ES_ISRRing_Drain();
+  }
+  Posted[NumPosted] = '\0';
+  printf( "keys typed \"%s\": posted \"%s\", %u lost\n",
+          KEYS, Posted, TERMIO_QueryRxDrops() );
+  if ( (kbhit() != 0) || (TERMIO_QueryRxDrops() != 0) )
+    Fail( "keys posted through the key ring also went to the receive ring" );
+  if ( strcmp( Posted, KEYS ) != 0 )
+    Fail( "keys posted differ from the keys typed" );
+}
+
+/****************************************************************************
+ Function
+   ReadPty
+ Parameters
+   void * pArg : unused
+ Returns
+   void * : NULL
+ Description
+   the reader thread: takes everything that comes out of the pty
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 03:36
+****************************************************************************/
+static void *ReadPty( void *pArg )
+{
+  struct pollfd Poll;
+  uint8_t Buffer[256];
+  ssize_t Got;
+  ssize_t i;
+
+  (void)pArg;
+  Poll.fd = Slave;
+  Poll.events = POLLIN;
+  while ( __atomic_load_n( &Reading, __ATOMIC_SEQ_CST ) ) {
+    if ( poll( &Poll, 1, 10 ) <= 0 )
+      continue;
+    Got = read( Slave, Buffer, sizeof(Buffer) );
+    for ( i = 0; i < Got; i++ )
+      TakeByte( Buffer[i] );
+    if ( Got > 0 )
+      __atomic_fetch_add( &BytesRead, (uint32_t)Got, __ATOMIC_SEQ_CST );
+  }
+  return NULL;
+}
+
+/****************************************************************************
+ Function
+   TakeByte
+ Parameters
+   uint8_t Byte : a byte out of the pty
+ Returns
+   None
+ Description
+   checks a byte of a log record or of the text
+ Notes
+   a record starts with ES_LOG_SYNC, which is not in the text
+ Author
+   Alex Loo, 10/18/26, 03:40
+****************************************************************************/
+static void TakeByte( uint8_t Byte )
+{
+  uint8_t Check = 0;
+  uint8_t i;
+
+  if ( (Place == 0) && (Byte != ES_LOG_SYNC) ) {
+    if ( Byte != (uint8_t)Line[TextBytes % LINE_LENGTH] )
+      Fail( "text out of order or broken into" );
+    TextBytes++;
+    return;
+  }
+  Record[Place++] = Byte;
+  if ( Place < ES_LOG_RECORD_SIZE )
+    return;
+  Place = 0;
+  for ( i = 1; i < ES_LOG_RECORD_SIZE; i++ )
+    Check += Record[i];
+  if ( Check != 0 )
+    Fail( "log record broken" );
+  Records++;
+}
+
+/****************************************************************************
+ Function
+   Fail
+ Parameters
+   const char * pWhat : what went wrong
+ Returns
+   None
+ Description
+   counts a failure, printing the first few
+ Notes
+   called from both threads, only ever in a test that is failing
+ Author
+   Alex Loo, 10/18/26, 03:42
+****************************************************************************/
+static void Fail( const char *pWhat )
+{
+  if ( __atomic_fetch_add( &Failures, 1, __ATOMIC_SEQ_CST ) < 10 )
+    printf( "%s\n", pWhat );
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,348 @@
+/****************************************************************************
+ Module
+     BenchTimers.c
+ Description
+     Host benchmark for the cost of the timer RTI (ES_Timer_RTI_Resp) with 1
+     to 64 timers running
+ Notes
+     usage: BenchTimers [NumTicks]
+
+     For each number of running timers it reports, per RTI tick with no
+     timer expiring:
+       list  ES_Timer_RTI_Resp, which looks only at the head of the sorted
+             list of running timers
+       scan  the old RTI walk, which decremented every running timer on
+             every tick (kept here, widened to 64 timers, for comparison)
+     and the cost of restarting 1 of the running timers with
+     ES_Timer_InitTimer, which is where the sorted list does its work:
+       restart  to times spread over the others, so it lands anywhere
+       arm last to the longest time, so it walks past every other running
+                timer, the longest LinkTimer keeps interrupts off
+
+     Figures are TSC cycles (or ns where there is no TSC), the best of
+     several passes.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:50 adl      arm last, the worst case of LinkTimer
+ 10/17/26 20:45 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Timers.h"
+#include "ES_Port.h"
+#include "BenchServices.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_TICKS 20000UL
+#define NUM_PASSES 5
+#define MAX_TIMERS 64
+// long enough that nothing expires while the ticks are measured
+#define LONG_TIME 60000U
+
+/*---------------------------- Module Functions ---------------------------*/
+static double MeasureListTick( uint8_t NumTimers );
+static double MeasureScanTick( uint8_t NumTimers );
+static double MeasureRestart( uint8_t NumTimers );
+static double MeasureArmLast( uint8_t NumTimers );
+static void StartAll( uint8_t NumTimers );
+static void StopAll( void );
+static void ScanTick( void );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumTicks = DEFAULT_NUM_TICKS;
+static uint32_t Expired;
+
+// the old RTI's state: a count per timer and a running bit per timer
+static uint16_t ScanTimers[MAX_TIMERS];
+static uint64_t ScanActive;
+
+static uint8_t const TimerCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  uint8_t i;
+
+  if ( argc > 1 )
+    NumTicks = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( (NumTicks == 0) || (NumTicks >= LONG_TIME - MAX_TIMERS) ) {
+    printf( "usage: %s [NumTicks], NumTicks below %u\n", argv[0],
+            LONG_TIME - MAX_TIMERS );
+    return 1;
+  }
+
+  ES_Timer_Init( ES_Timer_RATE_2MS );
+  printf( "timer RTI: %lu ticks per pass, best of %d passes, %s\n",
+          (unsigned long)NumTicks, NUM_PASSES, Bench_CycleUnits() );
+  printf( "timers   list tick   scan tick   restart  arm last\n" );
+  for ( i = 0; i < sizeof(TimerCounts); i++ ) {
+    printf( "%6u  %10.1f  %10.1f  %8.1f  %8.1f\n", TimerCounts[i],
+            MeasureListTick( TimerCounts[i] ),
+            MeasureScanTick( TimerCounts[i] ),
+            MeasureRestart( TimerCounts[i] ),
+            MeasureArmLast( TimerCounts[i] ) );
+  }
+  if ( Expired != 0 ) {
+    printf( "%lu timers expired during the measurements\n",
+            (unsigned long)Expired );
+    return 1;
+  }
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   BenchTimerPost
+ Parameters
+   ES_Event : the timeout event
+ Returns
+   boolean, always True
+ Description
+   post function for all of the timers, counts the timeouts
+ Notes
+   none should arrive, the timers are all restarted before they run out
+ Author
+   Alex Loo, 10/17/26, 20:50
+****************************************************************************/
+boolean BenchTimerPost( ES_Event ThisEvent )
+{
+  (void)ThisEvent;
+  Expired++;
+  return True;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   MeasureListTick
+ Parameters
+   uint8_t NumTimers : number of timers to have running
+ Returns
+   double : cost of 1 RTI tick
+ Description
+   runs NumTicks RTI ticks with NumTimers timers running
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 20:55
+****************************************************************************/
+static double MeasureListTick( uint8_t NumTimers )
+{
+  uint64_t Start;
+  uint64_t Elapsed;
+  uint64_t Best = ~(uint64_t)0;
+  uint32_t Tick;
+  uint8_t Pass;
+
+  for ( Pass = 0; Pass < NUM_PASSES; Pass++ ) {
+    StartAll( NumTimers );
+    Start = Bench_Cycles();
+    for ( Tick = 0; Tick < NumTicks; Tick++ )
+      ES_Port_Tick();
+    Elapsed = Bench_Cycles() - Start;
+    if ( Elapsed < Best )
+      Best = Elapsed;
+  }
+  StopAll();
+  return (double)Best / (double)NumTicks;
+}
+
+/****************************************************************************
+ Function
+   MeasureScanTick
+ Parameters
+   uint8_t NumTimers : number of timers to have running
+ Returns
+   double : cost of 1 tick of the old RTI
+ Description
+   as MeasureListTick, for the old walk over every running timer
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 20:58
+****************************************************************************/
+static double MeasureScanTick( uint8_t NumTimers )
+{
+  uint64_t Start;
+  uint64_t Elapsed;
+  uint64_t Best = ~(uint64_t)0;
+  uint32_t Tick;
+  uint8_t Pass;
+  uint8_t i;
+
+  for ( Pass = 0; Pass < NUM_PASSES; Pass++ ) {
+    ScanActive = 0;
+    for ( i = 0; i < NumTimers; i++ ) {
+      ScanTimers[i] = (uint16_t)(LONG_TIME - i);
+      ScanActive |= (uint64_t)1 << i;
+    }
+    Start = Bench_Cycles();
+    for ( Tick = 0; Tick < NumTicks; Tick++ )
+      ScanTick();
+    Elapsed = Bench_Cycles() - Start;
+    if ( Elapsed < Best )
+      Best = Elapsed;
+  }
+  return (double)Best / (double)NumTicks;
+}
+
+/****************************************************************************
+ Function
+   MeasureRestart
+ Parameters
+   uint8_t NumTimers : number of timers to have running
+ Returns
+   double : cost of 1 ES_Timer_InitTimer on a running timer
+ Description
+   restarts the running timers, 1 after another, with times spread over
+   the rest so that each lands at a different place in the list
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 21:00
+****************************************************************************/
+static double MeasureRestart( uint8_t NumTimers )
+{
+  uint64_t Start;
+  uint64_t Elapsed;
+  uint64_t Best = ~(uint64_t)0;
+  uint32_t Done;
+  uint8_t Pass;
+
+  for ( Pass = 0; Pass < NUM_PASSES; Pass++ ) {
+    StartAll( NumTimers );
+    Start = Bench_Cycles();
+    for ( Done = 0; Done < NumTicks; Done++ )
+      ES_Timer_InitTimer( (unsigned char)(Done % NumTimers),
+                          LONG_TIME - (Done * 7) % MAX_TIMERS );
+    Elapsed = Bench_Cycles() - Start;
+    if ( Elapsed < Best )
+      Best = Elapsed;
+  }
+  StopAll();
+  return (double)Best / (double)NumTicks;
+}
+
+/****************************************************************************
+ Function
+   MeasureArmLast
+ Parameters
+   uint8_t NumTimers : number of timers to have running
+ Returns
+   double : cost of 1 ES_Timer_InitTimer that goes to the end of the list
+ Description
+   restarts the last running timer with the longest time of any, so that
+   LinkTimer walks past all of the others each time
+ Notes
+   the others are due no later (see StartAll), and a timer goes behind
+   those due on the same tick
+ Author
+   Alex Loo, 10/18/26, 16:50
+****************************************************************************/
+static double MeasureArmLast( uint8_t NumTimers )
+{
+  uint64_t Start;
+  uint64_t Elapsed;
+  uint64_t Best = ~(uint64_t)0;
+  uint32_t Done;
+  uint8_t Pass;
+
+  for ( Pass = 0; Pass < NUM_PASSES; Pass++ ) {
+    StartAll( NumTimers );
+    Start = Bench_Cycles();
+    for ( Done = 0; Done < NumTicks; Done++ )
+      ES_Timer_InitTimer( (unsigned char)(NumTimers - 1), LONG_TIME );
+    Elapsed = Bench_Cycles() - Start;
+    if ( Elapsed < Best )
+      Best = Elapsed;
+  }
+  StopAll();
+  return (double)Best / (double)NumTicks;
+}
+
+/****************************************************************************
+ Function
+   StartAll
+ Parameters
+   uint8_t NumTimers : number of timers to start
+ Returns
+   None
+ Description
+   starts timers 0 to NumTimers-1, each with a slightly different time
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 21:02
+****************************************************************************/
+static void StartAll( uint8_t NumTimers )
+{
+  uint8_t i;
+
+  StopAll();
+  for ( i = 0; i < NumTimers; i++ )
+    ES_Timer_InitTimer( i, LONG_TIME - i );
+}
+
+/****************************************************************************
+ Function
+   StopAll
+ Parameters
+   None
+ Returns
+   None
+ Description
+   stops every timer
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 21:03
+****************************************************************************/
+static void StopAll( void )
+{
+  uint8_t i;
+
+  for ( i = 0; i < MAX_TIMERS; i++ )
+    ES_Timer_StopTimer( i );
+}
+
+/****************************************************************************
+ Function
+   ScanTick
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the old ES_Timer_RTI_Resp: finds each running timer from the MSB down
+   and decrements it, posting when it reaches 0
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 21:05
+****************************************************************************/
+static void ScanTick( void )
+{
+  uint64_t NeedsProcessing = ScanActive;
+  uint64_t Mask;
+  uint8_t Num;
+  ES_Event NewEvent;
+
+  while ( NeedsProcessing != 0 ) {
+    Num = (uint8_t)(63 - __builtin_clzll( NeedsProcessing ));
+    Mask = (uint64_t)1 << Num;
+    if ( --ScanTimers[Num] == 0 ) {
+      NewEvent.EventType = ES_TIMEOUT;
+      NewEvent.EventParam = Num;
+      BenchTimerPost( NewEvent );
+      ScanActive &= ~Mask;
+    }
+    NeedsProcessing &= ~Mask;
+  }
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,141 @@
+/****************************************************************************
+ Module
+     BenchUtil.c
+ Description
+     timing and reporting helpers shared by the host benchmarks
+ Notes
+     Bench_Cycles reads the time stamp counter on x86 and falls back on the
+     monotonic clock in ns everywhere else.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 14:44 adl      added Bench_CycleUnits
+ 10/17/26 10:02 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "BenchUtil.h"
+
+/*---------------------------- Module Functions ---------------------------*/
+static int CompareSamples( const void *pA, const void *pB );
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   Bench_NowNs
+ Parameters
+   None
+ Returns
+   uint64_t : the monotonic clock in ns
+ Description
+   wall clock time stamp for throughput and latency measurements
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 10:05
+****************************************************************************/
+uint64_t Bench_NowNs( void )
+{
+  struct timespec Now;
+  clock_gettime( CLOCK_MONOTONIC, &Now );
+  return (uint64_t)Now.tv_sec * 1000000000ULL + (uint64_t)Now.tv_nsec;
+}
+
+/****************************************************************************
+ Function
+   Bench_Cycles
+ Parameters
+   None
+ Returns
+   uint64_t : the CPU time stamp counter (ns where there is none)
+ Description
+   cheap time stamp for timing short stretches of code
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 10:07
+****************************************************************************/
+uint64_t Bench_Cycles( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return Bench_NowNs();
+#endif
+}
+
+/****************************************************************************
+ Function
+   Bench_CycleUnits
+ Parameters
+   None
+ Returns
+   const char * : the units that Bench_Cycles counts in
+ Description
+   for labelling reports
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 14:44
+****************************************************************************/
+const char *Bench_CycleUnits( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return "TSC cycles";
+#else
+  return "ns";
+#endif
+}
+
+/****************************************************************************
+ Function
+   Bench_ReportPercentiles
+ Parameters
+   const char *Name : label for the line printed
+   uint32_t *pSamples : the samples, sorted in place
+   uint32_t NumSamples : how many samples there are
+   const char *Units : units of the samples
+ Returns
+   None
+ Description
+   prints min, p50, p90, p99, p99.9 and max of a set of samples
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 10:11
+****************************************************************************/
+void Bench_ReportPercentiles( const char *Name, uint32_t *pSamples,
+                              uint32_t NumSamples, const char *Units )
+{
+  if ( NumSamples == 0 ) {
+    printf( "%-24s no samples\n", Name );
+    return;
+  }
+  qsort( pSamples, NumSamples, sizeof(pSamples[0]), CompareSamples );
+  printf( "%-24s min %u  p50 %u  p90 %u  p99 %u  p99.9 %u  max %u %s\n",
+          Name,
+          pSamples[0],
+          pSamples[(uint64_t)NumSamples * 50 / 100],
+          pSamples[(uint64_t)NumSamples * 90 / 100],
+          pSamples[(uint64_t)NumSamples * 99 / 100],
+          pSamples[(uint64_t)NumSamples * 999 / 1000],
+          pSamples[NumSamples - 1],
+          Units );
+}
+
+//*********************************
+// private functions
+//*********************************
+static int CompareSamples( const void *pA, const void *pB )
+{
+  uint32_t A = *(const uint32_t *)pA;
+  uint32_t B = *(const uint32_t *)pB;
+  return (A > B) - (A < B);
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,26 @@
+/****************************************************************************
+ Module
+     BenchUtil.h
+ Description
+     header file for the timing and reporting helpers shared by the host
+     benchmarks
+ Notes
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 14:44 adl      added Bench_CycleUnits
+ 10/17/26 10:02 adl      started coding
+*****************************************************************************/
+#ifndef BenchUtil_H
+#define BenchUtil_H
+
+#include <stdint.h>
+
+uint64_t Bench_NowNs( void );
+uint64_t Bench_Cycles( void );
+const char *Bench_CycleUnits( void );
+void Bench_ReportPercentiles( const char *Name, uint32_t *pSamples,
+                              uint32_t NumSamples, const char *Units );
+
+#endif /* BenchUtil_H */
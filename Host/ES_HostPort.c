@@ -0,0 +1,215 @@
+/****************************************************************************
+ Module
+     ES_HostPort.c
+ Description
+     Linux host side of the port layer in ES_Port.h. Lets the framework core
+     (ES_Framework.c, ES_Queue.c, ES_Timers.c ...) build and run on a PC so
+     that we can benchmark and test it.
+ Notes
+     There are no interrupts here. The RTI is simulated by calling
+     ES_Port_Tick, so whoever drives the host build decides how fast
+     framework time passes.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 02:05 adl      the transmit interrupt enable is SCI0's, shared with
+                         termio.c; kbhit moved to HostConsole.c
+ 10/18/26 01:20 adl      simulated transmit interrupt for the deferred log
+ 10/17/26 22:20 adl      simulated free running counter for the fine timebase
+ 10/17/26 09:30 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// counts of the free running counter in 1 RTI period (2.048 ms)
+#define FREE_RUNNING_PER_TICK (2048U * ES_PORT_FINE_PER_US)
+
+/*---------------------------- Module Functions ---------------------------*/
+// the RTI response routine from ES_Timers.c, it is an ISR on the target so
+// it has no public prototype
+void ES_Timer_RTI_Resp( void );
+
+/*---------------------------- Module Variables ---------------------------*/
+// number of times EnterCritical has been called
+unsigned long ES_Port_CriticalCount;
+
+// the rate ES_Timer_Init asked for, kept only for reference
+static unsigned char RTIRate;
+
+// the simulated TIM0 counter and its overflow flag
+static uint16_t FreeRunning;
+static int FreeRunningWrapped;
+
+// the simulated SCI0 transmit interrupt enable
+volatile int ES_Port_SCI0TxOn;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   ES_Port_InitRTI
+ Parameters
+   unsigned char Rate : the RTICTL value ES_Timer_Init asked for
+ Returns
+   None
+ Description
+   stands in for programming the RTI, there is no hardware to set up
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 09:34
+****************************************************************************/
+void ES_Port_InitRTI( unsigned char Rate )
+{
+  RTIRate = Rate;
+}
+
+/****************************************************************************
+ Function
+   ES_Port_Tick
+ Parameters
+   None
+ Returns
+   None
+ Description
+   runs the RTI response once, as the RTI interrupt would on the target,
+   after moving the free running counter on by the same time
+ Notes
+   call this from the thread that runs ES_Run
+ Author
+   Alex Loo, 10/17/26, 09:36
+****************************************************************************/
+void ES_Port_Tick( void )
+{
+  ES_Port_AdvanceFreeRunning( FREE_RUNNING_PER_TICK );
+  if ( FreeRunningWrapped )
+    ES_Port_FreeRunningISR();
+  ES_Timer_RTI_Resp();
+}
+
+/****************************************************************************
+ Function
+   ES_Port_ReadFreeRunning
+ Parameters
+   None
+ Returns
+   unsigned int : the simulated TIM0 counter
+ Description
+   stands in for reading TIM0_TCNT
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 22:22
+****************************************************************************/
+unsigned int ES_Port_ReadFreeRunning( void )
+{
+  return FreeRunning;
+}
+
+/****************************************************************************
+ Function
+   ES_Port_FreeRunningWrapped
+ Parameters
+   None
+ Returns
+   int : non zero while a wrap of the counter waits for its ISR
+ Description
+   stands in for testing TOF in TIM0_TFLG2
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 22:23
+****************************************************************************/
+int ES_Port_FreeRunningWrapped( void )
+{
+  return FreeRunningWrapped;
+}
+
+/****************************************************************************
+ Function
+   ES_Port_AdvanceFreeRunning
+ Parameters
+   unsigned int Counts : how far to move the counter on
+ Returns
+   None
+ Description
+   moves the simulated counter on, setting the overflow flag if it wraps
+ Notes
+   does not run the overflow ISR, see ES_Port_FreeRunningISR
+ Author
+   Alex Loo, 10/17/26, 22:24
+****************************************************************************/
+void ES_Port_AdvanceFreeRunning( unsigned int Counts )
+{
+  uint16_t Before = FreeRunning;
+
+  FreeRunning = (uint16_t)(FreeRunning + Counts);
+  if ( FreeRunning < Before )
+    FreeRunningWrapped = 1;
+}
+
+/****************************************************************************
+ Function
+   ES_Port_FreeRunningISR
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the overflow ISR: counts the wrap in the fine timebase and clears the
+   flag, as the TIM0 overflow ISR does on the target
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 22:25
+****************************************************************************/
+void ES_Port_FreeRunningISR( void )
+{
+  ES_Timer_FineOverflow();
+  FreeRunningWrapped = 0;
+}
+
+/****************************************************************************
+ Function
+   ES_Port_StartSCI0Tx
+ Parameters
+   None
+ Returns
+   None
+ Description
+   turns on the simulated SCI0 transmit interrupt
+ Notes
+   sequentially consistent, so that an ISR thread that turns it off and
+   then looks for more to send cannot miss a writer's bytes
+ Author
+   Alex Loo, 10/18/26, 01:22
+****************************************************************************/
+void ES_Port_StartSCI0Tx( void )
+{
+  __atomic_store_n( &ES_Port_SCI0TxOn, 1, __ATOMIC_SEQ_CST );
+}
+
+/****************************************************************************
+ Function
+   ES_Port_StopSCI0Tx
+ Parameters
+   None
+ Returns
+   None
+ Description
+   turns off the simulated SCI0 transmit interrupt
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 01:23
+****************************************************************************/
+void ES_Port_StopSCI0Tx( void )
+{
+  __atomic_store_n( &ES_Port_SCI0TxOn, 0, __ATOMIC_SEQ_CST );
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
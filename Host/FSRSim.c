@@ -0,0 +1,163 @@
+/****************************************************************************
+ Module
+     FSRSim.c
+ Description
+     Host stand-in for the SPI port and the field controller (FSR) on the
+     other end of it. FSR.c, built with ES_HOST_BUILD, writes each byte with
+     FSRSim_Write and reads the FSR's byte back with FSRSim_Read.
+ Notes
+     The model of the FSR: a transfer returns the byte that the FSR loaded
+     after the last one. After a command (QUERY_WALL to QUERY_BALL) it loads
+     the answer; after anything else, or once 52 mS pass with no byte, it
+     loads the sync byte 0xFD. So a query is command (back comes 0xFD) then
+     SEND_DATA (back comes the answer), and a command in the data slot
+     clocks out the last answer while it starts the next query, which is
+     what FSR_PIPELINE counts on.
+
+     Answers are coded as the FSR codes them: balls in play + 0x80, balls
+     in a bin + 1, and the wall angle / 2 + 1. ErrorPercent of the bytes
+     come back as 0xFF, which is neither the sync byte nor any answer.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 23:50 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdlib.h>
+#include "FSRSim.h"
+#include "ES_Timers.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define FIRST_COMMAND 0xF8   // QUERY_WALL
+#define LAST_COMMAND  0xFD   // QUERY_BALL
+#define SYNC_BYTE     0xFD
+#define GARBLED       0xFF
+// the FSR goes back to sync after this long with no byte (52 mS)
+#define RESET_TICKS   26
+// and needs this long between bytes (4 mS)
+#define MIN_GAP_TICKS 2
+
+/*---------------------------- Module Functions ---------------------------*/
+static unsigned char Encode( FSR_Query_t Query );
+
+/*---------------------------- Module Variables ---------------------------*/
+unsigned int FSRSim_Value[FSR_NUM_QUERIES];
+uint32_t FSRSim_Bytes;
+uint32_t FSRSim_Errors;
+uint32_t FSRSim_TooSoon;
+
+static unsigned int ErrorRate;
+static unsigned char Loaded = SYNC_BYTE;
+static unsigned char Received;
+static uint16_t LastByteTime;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   FSRSim_Init
+ Parameters
+   unsigned int ErrorPercent : how many bytes in 100 to garble
+ Returns
+   None
+ Description
+   puts the FSR back to sync and clears the counts
+ Notes
+   set FSRSim_Value before the first query
+ Author
+   Alex Loo, 10/17/26, 23:52
+****************************************************************************/
+void FSRSim_Init( unsigned int ErrorPercent )
+{
+  ErrorRate = ErrorPercent;
+  Loaded = SYNC_BYTE;
+  LastByteTime = ES_Timer_GetTime() - RESET_TICKS - 1;
+  FSRSim_Bytes = 0;
+  FSRSim_Errors = 0;
+  FSRSim_TooSoon = 0;
+}
+
+/****************************************************************************
+ Function
+   FSRSim_Write
+ Parameters
+   unsigned char Byte : the byte the master sends
+ Returns
+   None
+ Description
+   one SPI transfer: the FSR's loaded byte comes back (see FSRSim_Read)
+   and it loads its next one from Byte
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 23:54
+****************************************************************************/
+void FSRSim_Write( unsigned char Byte )
+{
+  uint16_t Now = ES_Timer_GetTime();
+  uint16_t Gap = (uint16_t)(Now - LastByteTime);
+
+  if ( Gap > RESET_TICKS )
+    Loaded = SYNC_BYTE;
+  else if ( Gap < MIN_GAP_TICKS )
+    FSRSim_TooSoon++;
+  LastByteTime = Now;
+  FSRSim_Bytes++;
+
+  Received = Loaded;
+  if ( (ErrorRate != 0) && ((unsigned int)(rand() % 100) < ErrorRate) ) {
+    Received = GARBLED;
+    FSRSim_Errors++;
+  }
+
+  if ( (Byte >= FIRST_COMMAND) && (Byte <= LAST_COMMAND) )
+    Loaded = Encode( (FSR_Query_t)(LAST_COMMAND - Byte) );
+  else
+    Loaded = SYNC_BYTE;
+}
+
+/****************************************************************************
+ Function
+   FSRSim_Read
+ Parameters
+   None
+ Returns
+   unsigned char : the byte that came back in the last transfer
+ Description
+   stands in for reading SPIDR
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 23:55
+****************************************************************************/
+unsigned char FSRSim_Read( void )
+{
+  return Received;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   Encode
+ Parameters
+   FSR_Query_t Query : the query, from its command byte
+ Returns
+   unsigned char : the answer as the FSR sends it
+ Description
+   codes FSRSim_Value for the query
+ Notes
+   the commands run from QUERY_BALL (0xFD) down to QUERY_WALL (0xF8) in
+   FSR_Query_t order
+ Author
+   Alex Loo, 10/17/26, 23:57
+****************************************************************************/
+static unsigned char Encode( FSR_Query_t Query )
+{
+  if ( Query == FSR_BALLS_IN_PLAY )
+    return (unsigned char)(FSRSim_Value[Query] + 0x80);
+  if ( Query == FSR_WALL_ANGLE )
+    return (unsigned char)(FSRSim_Value[Query] / 2 + 1);
+  return (unsigned char)(FSRSim_Value[Query] + 1);
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,32 @@
+/****************************************************************************
+ Module
+     FSRSim.h
+ Description
+     the host stand-in for the SPI port and the field controller (FSR) on
+     the other end of it, for FSR.c built with ES_HOST_BUILD
+ Notes
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 23:50 adl      started coding
+*****************************************************************************/
+#ifndef FSRSim_H
+#define FSRSim_H
+
+#include "ES_Types.h"
+#include "FSR.h"
+
+// the FSR's answer to each query, as FSR_RESULT_VALUE gives it back
+extern unsigned int FSRSim_Value[FSR_NUM_QUERIES];
+
+// what the FSR has seen
+extern uint32_t FSRSim_Bytes;     // bytes transferred
+extern uint32_t FSRSim_Errors;    // bytes garbled on purpose
+extern uint32_t FSRSim_TooSoon;   // bytes sent less than 4 mS after the last
+
+void FSRSim_Init( unsigned int ErrorPercent );
+void FSRSim_Write( unsigned char Byte );
+unsigned char FSRSim_Read( void );
+
+#endif /* FSRSim_H */
@@ -0,0 +1,38 @@
+/****************************************************************************
+ Module
+     HostConsole.c
+ Description
+     The console for host programs built without termio.c: there is no
+     terminal attached, so no key is ever waiting.
+ Notes
+     Programs that run termio.c against Host/SCISim.c link termio.c in place
+     of this file.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 02:05 adl      moved out of ES_HostPort.c
+ 10/17/26 09:30 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <termio.h>
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   kbhit
+ Parameters
+   None
+ Returns
+   int : always 0, there is no terminal attached to the host build
+ Description
+   host version of the termio.c function polled by CheckSystemEvents
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 09:40
+****************************************************************************/
+int kbhit( void )
+{
+  return 0;
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,737 @@
+/****************************************************************************
+ Module
+     Replay.c
+ Description
+     Plays a match back from the robot's log: every event that was posted
+     to MasterMachine and FieldState goes through RunMasterMachine and
+     RunFieldState again, in the order it was posted, with no drivers, and
+     the replay's state transitions are checked against the log's. Reports
+     the first one that differs.
+ Notes
+     usage: Replay [-v] LogFile...
+       -v              every record, as it is replayed
+
+     A log file is a console capture from the robot built with ES_RECORD
+     (or from SimMatch_record -r): the deferred log's records, with any
+     printf text between them, which is skipped. The POST records are the
+     replay's input and the ENTRY and EXIT records are what it must do.
+
+     What the machines read other than their events comes from the log
+     too. The field state is the FSR's answers, which are posts to
+     FieldState. GetBeaconFront and GetBeaconRear give the last beacon
+     posted from each sensor, and the beacon StartMasterMachine waits for
+     is in a NOTE_START_BEACON note. The side comes from SideID.c as on the
+     robot. Time is moved on to each record's time before it is replayed,
+     with the RTI, so the timers run as they did; what they post is in the
+     log already, so the replay drops it, as it does every post that the
+     machines make.
+
+     A post that the queue dropped is not replayed, nor is one that a later
+     post of its type replaced in the queue (COALESCE_EVENT_LIST). Each
+     event runs when it is posted: ES_Run, given events for both services
+     at once, runs FieldState's first, which the log cannot show. A post
+     missing from the log (the log's ring was full) shows as a gap in the
+     post counts and is reported with any divergence after it.
+
+     Each file is replayed in a process of its own, so each one starts
+     from the statics as the program loaded them. The machines' printf
+     output goes nowhere. Returns 0 if every file replays the same, 1 if
+     one diverges and 2 if one cannot be read, so it can drive a
+     git bisect run.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 12:00 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Timers.h"
+#include "ES_Port.h"
+#include "ES_Log.h"
+#include "TimingConstants.h"
+#include "MasterMachine.h"
+#include "FieldState.h"
+#include "SideID.h"
+#include "AppNames.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_RECORDS 200000UL
+#define MAX_TRANSITIONS 50000UL
+// the posts shown before a divergence
+#define HISTORY 6
+#define TICKS_PER_SECOND (1 _SECONDS_TIMER)
+// the services replayed
+#define MASTER_SERVICE 0
+#define FIELD_STATE_SERVICE 1
+
+/*---------------------------- Module Types -------------------------------*/
+typedef struct {
+  uint32_t Time;       // ticks since reset, unwrapped
+  uint8_t Kind;        // ES_LogKind_t
+  uint8_t Source;
+  uint8_t State;
+  uint8_t Code;
+  uint16_t Param;
+} Record_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static int ReplayFile( const char *pName );
+static boolean ReadLog( const char *pName );
+static void FindReplaced( void );
+static boolean Compare( uint32_t i, const Record_t *pRecord );
+static void RunPost( uint32_t i, const Record_t *pRecord );
+static void MoveTimeTo( uint32_t Time );
+static void Diverged( uint32_t i, const Record_t *pRecord,
+                      const Record_t *pReplayed );
+static void PrintRecord( uint32_t i, const Record_t *pRecord );
+static const char *KindName( uint8_t Kind );
+
+/*---------------------------- Module Variables ---------------------------*/
+static boolean Verbose;
+static const char *pFileName;
+// where reports go; stdout is the machines', and goes nowhere
+static FILE *pReport;
+
+// the log, and for each record whether it is a post not to replay
+static Record_t *pRecords;
+static boolean *pSkip;
+static uint32_t NumRecords;
+static uint8_t StartBeacon;
+static uint32_t LostPosts;
+
+// the transitions the replay has made, and how many of them the log has
+// matched
+static Record_t *pReplayed;
+static uint32_t NumReplayed;
+static uint32_t NumMatched;
+
+// what the stand-ins give the machines
+static boolean Starting;
+static uint8_t FrontBeacon;
+static uint8_t RearBeacon;
+
+// the latest posts replayed, for the report of a divergence
+static uint32_t History[HISTORY];
+static uint32_t NumHistory;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  int Worst = 0;
+  int Status;
+  int Arg = 1;
+  pid_t Child;
+
+  if ( (Arg < argc) && (strcmp( argv[Arg], "-v" ) == 0) ) {
+    Verbose = True;
+    Arg++;
+  }
+  if ( Arg >= argc ) {
+    printf( "usage: %s [-v] LogFile...\n", argv[0] );
+    return 2;
+  }
+  for ( ; Arg < argc; Arg++ ) {
+    fflush( stdout );
+    Child = fork();
+    if ( Child < 0 ) {
+      perror( "fork" );
+      return 2;
+    }
+    if ( Child == 0 ) {
+      Status = ReplayFile( argv[Arg] );
+      fflush( NULL );
+      _exit( Status );
+    }
+    if ( (waitpid( Child, &Status, 0 ) != Child) ||
+         (WIFEXITED( Status ) == 0) ) {
+      printf( "%s: the replay crashed\n", argv[Arg] );
+      Status = 2;
+    } else {
+      Status = WEXITSTATUS( Status );
+    }
+    if ( Status > Worst )
+      Worst = Status;
+  }
+  return Worst;
+}
+
+/*---------------------------- Stand-ins ----------------------------------*/
+// MotorDriver.h, QuickSense.h, BinControl.h and SPI: the robot's outputs do
+// nothing here
+void MotorDriver_Init( void ) {}
+void GoForward( unsigned char Speed ) { (void)Speed; }
+void GoBackward( unsigned char Speed ) { (void)Speed; }
+void TurnLeft( void ) {}
+void TurnLeftSpeedSelect( unsigned char Speed ) { (void)Speed; }
+void TurnRight( void ) {}
+void TurnRightSpeedSelect( unsigned char Speed ) { (void)Speed; }
+void FullStop( void ) {}
+void QS_Initialize( void ) {}
+unsigned char QS_QueryBallCount( void ) { return 0; }
+void InitFan( void ) {}
+void FanControl( char On ) { (void)On; }
+void SPI_Init( void ) {}
+// the team LEDs that SideID.c drives
+volatile unsigned char PTP;
+volatile unsigned char DDRP;
+
+/****************************************************************************
+ Function
+   GetBeaconFront
+ Parameters
+   None
+ Returns
+   unsigned char, the beacon the front sensor last saw, 0 for none
+ Description
+   BeaconDetection.h's, from the beacon events in the log, or while
+   StartMasterMachine waits, the beacon it found
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 12:05
+****************************************************************************/
+unsigned char GetBeaconFront( void )
+{
+  return (Starting == True) ? StartBeacon : FrontBeacon;
+}
+
+/****************************************************************************
+ Function
+   GetBeaconRear
+ Parameters
+   None
+ Returns
+   unsigned char, the beacon the rear sensor last saw, 0 for none
+ Description
+   BeaconDetection.h's, from the beacon events in the log
+ Notes
+   StartMasterMachine looks here only if the front has none, and
+   GetBeaconFront gives it the beacon it found
+ Author
+   Alex Loo, 10/18/26, 12:05
+****************************************************************************/
+unsigned char GetBeaconRear( void )
+{
+  return RearBeacon;
+}
+
+/****************************************************************************
+ Function
+   FSR_Query
+ Parameters
+   FSR_Query_t Query : the query
+   uint16_t Deadline : ticks to answer in
+ Returns
+   boolean, True
+ Description
+   FSR.h's: the answers are in the log, so there is no need to ask
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 12:06
+****************************************************************************/
+boolean FSR_Query( FSR_Query_t Query, uint16_t Deadline )
+{
+  (void)Query;
+  (void)Deadline;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_PostToService
+ Parameters
+   uint8_t Which : the service
+   ES_Event ThisEvent : the event
+ Returns
+   boolean, True
+ Description
+   ES_Framework.c's: every post that reached a service is in the log, and
+   is replayed from there, so this one is dropped
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 12:07
+****************************************************************************/
+boolean ES_PostToService( uint8_t Which, ES_Event ThisEvent )
+{
+  (void)Which;
+  (void)ThisEvent;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_Log_Write
+ Parameters
+   ES_LogKind_t Kind : what the record says
+   uint8_t Source : which machine wrote it
+   uint8_t State : the state it was in
+   uint8_t Code : the event type, or for a note what it is about
+   uint16_t Param : the event parameter, or the note's value
+ Returns
+   None
+ Description
+   ES_Log.c's: keeps the replay's entries and exits, to check against the
+   log's
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 12:08
+****************************************************************************/
+void ES_Log_Write( ES_LogKind_t Kind, uint8_t Source, uint8_t State,
+                   uint8_t Code, uint16_t Param )
+{
+  Record_t *pNew;
+
+  if ( ((Kind != ES_LOG_KIND_ENTRY) && (Kind != ES_LOG_KIND_EXIT)) ||
+       (NumReplayed >= MAX_TRANSITIONS) )
+    return;
+  pNew = &pReplayed[NumReplayed++];
+  pNew->Time = ES_Timer_GetTime32();
+  pNew->Kind = (uint8_t)Kind;
+  pNew->Source = Source;
+  pNew->State = State;
+  pNew->Code = Code;
+  pNew->Param = Param;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   ReplayFile
+ Parameters
+   const char * pName : the log file
+ Returns
+   int, 0 if the replay made the log's transitions, 1 if not, 2 if the
+   file could not be replayed
+ Description
+   replays a log, from the start of the machines, and reports
+ Notes
+   runs in a process of its own, see the module notes
+ Author
+   Alex Loo, 10/18/26, 12:10
+****************************************************************************/
+static int ReplayFile( const char *pName )
+{
+  const Record_t *pRecord;
+  uint64_t Start;
+  uint32_t Posts = 0;
+  uint32_t Skipped = 0;
+  uint32_t Transitions = 0;
+  uint32_t i;
+  int Null;
+
+  pFileName = pName;
+  pReport = fdopen( dup( STDOUT_FILENO ), "w" );
+  Null = open( "/dev/null", O_WRONLY );
+  if ( (pReport == NULL) || (Null < 0) ) {
+    perror( pName );
+    return 2;
+  }
+  dup2( Null, STDOUT_FILENO );
+  if ( ReadLog( pName ) == False )
+    return 2;
+  FindReplaced();
+
+  Start = Bench_NowNs();
+  // what ES_Initialize does for these services, from a reset
+  ES_Timer_Init( ES_Timer_RATE_2MS );
+  Starting = True;
+  InitMasterMachine( MASTER_SERVICE );
+  Starting = False;
+  InitFieldState( FIELD_STATE_SERVICE );
+
+  for ( i = 0; i < NumRecords; i++ ) {
+    pRecord = &pRecords[i];
+    MoveTimeTo( pRecord->Time );
+    if ( Verbose == True )
+      PrintRecord( i, pRecord );
+    if ( pRecord->Kind == ES_LOG_KIND_POST ) {
+      Posts++;
+      if ( pSkip[i] == True )
+        Skipped++;
+      else
+        RunPost( i, pRecord );
+    } else if ( (pRecord->Kind == ES_LOG_KIND_ENTRY) ||
+                (pRecord->Kind == ES_LOG_KIND_EXIT) ) {
+      Transitions++;
+      if ( Compare( i, pRecord ) == False )
+        return 1;
+    }
+  }
+  fprintf( pReport, "%s: %lu posts (%lu not run), %lu entries and exits, "
+           "%.1f s, replayed in %.2f mS: the same", pName,
+           (unsigned long)Posts, (unsigned long)Skipped,
+           (unsigned long)Transitions,
+           (double)pRecords[NumRecords - 1].Time / TICKS_PER_SECOND,
+           (Bench_NowNs() - Start) / 1e6 );
+  if ( NumReplayed > NumMatched )
+    fprintf( pReport, ", and %lu more after the end of the log",
+             (unsigned long)(NumReplayed - NumMatched) );
+  if ( LostPosts != 0 )
+    fprintf( pReport, ", %lu posts missing from the log",
+             (unsigned long)LostPosts );
+  fprintf( pReport, "\n" );
+  fflush( pReport );
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   ReadLog
+ Parameters
+   const char * pName : the log file
+ Returns
+   boolean, False if it cannot be read or has no records
+ Description
+   picks the records out of the capture, unwraps their times, finds the
+   beacon StartMasterMachine found and counts the posts missing
+ Notes
+   a record is ES_LOG_SYNC and ES_LOG_RECORD_SIZE - 1 bytes that sum to 0;
+   printf text is ASCII and cannot hold ES_LOG_SYNC, and only comes
+   between records. Times are 16 bit ticks, so records must come no more
+   than 65535 ticks apart, which a match's do
+ Author
+   Alex Loo, 10/18/26, 12:15
+****************************************************************************/
+static boolean ReadLog( const char *pName )
+{
+  FILE *pIn = fopen( pName, "rb" );
+  uint8_t Bytes[ES_LOG_RECORD_SIZE];
+  uint8_t Check;
+  uint8_t NextPost = 0;
+  uint16_t Last = 0;
+  uint32_t Time = 0;
+  Record_t *pRecord;
+  boolean AnyPosts = False;
+  boolean FoundBeacon = False;
+  size_t Have = 0;
+  size_t i;
+  int Byte;
+
+  pRecords = malloc( MAX_RECORDS * sizeof(Record_t) );
+  pSkip = calloc( MAX_RECORDS, sizeof(boolean) );
+  pReplayed = malloc( MAX_TRANSITIONS * sizeof(Record_t) );
+  if ( (pIn == NULL) || (pRecords == NULL) || (pSkip == NULL) ||
+       (pReplayed == NULL) ) {
+    perror( pName );
+    return False;
+  }
+  while ( ((Byte = fgetc( pIn )) != EOF) && (NumRecords < MAX_RECORDS) ) {
+    if ( (Have == 0) && (Byte != ES_LOG_SYNC) )
+      continue;
+    Bytes[Have++] = (uint8_t)Byte;
+    if ( Have < ES_LOG_RECORD_SIZE )
+      continue;
+    for ( Check = 0, i = 1; i < ES_LOG_RECORD_SIZE; i++ )
+      Check += Bytes[i];
+    if ( Check != 0 ) {
+      // not a record: look for one from the next byte
+      for ( i = 1; (i < Have) && (Bytes[i] != ES_LOG_SYNC); i++ )
+        ;
+      memmove( Bytes, &Bytes[i], Have - i );
+      Have -= i;
+      continue;
+    }
+    Have = 0;
+    pRecord = &pRecords[NumRecords];
+    Time += (uint16_t)(((uint16_t)Bytes[1] << 8 | Bytes[2]) - Last);
+    Last = (uint16_t)((uint16_t)Bytes[1] << 8 | Bytes[2]);
+    pRecord->Time = Time;
+    pRecord->Kind = Bytes[3];
+    pRecord->Source = Bytes[4];
+    pRecord->State = Bytes[5];
+    pRecord->Code = Bytes[6];
+    pRecord->Param = (uint16_t)((uint16_t)Bytes[7] << 8 | Bytes[8]);
+    if ( pRecord->Kind == ES_LOG_KIND_POST ) {
+      if ( (AnyPosts == True) && (pRecord->State != NextPost) )
+        LostPosts += (uint8_t)(pRecord->State - NextPost);
+      AnyPosts = True;
+      NextPost = (uint8_t)(pRecord->State + 1);
+    } else if ( (pRecord->Kind == ES_LOG_KIND_NOTE) &&
+                (pRecord->Source == LOG_MASTER) &&
+                (pRecord->Code == NOTE_START_BEACON) &&
+                (FoundBeacon == False) ) {
+      StartBeacon = (uint8_t)pRecord->Param;
+      FoundBeacon = True;
+    }
+    NumRecords++;
+  }
+  fclose( pIn );
+  if ( (NumRecords == 0) || (AnyPosts == False) ) {
+    fprintf( pReport, "%s: no posts in the log, was it built with "
+             "ES_RECORD?\n", pName );
+    return False;
+  }
+  if ( FoundBeacon == False ) {
+    fprintf( pReport, "%s: no NOTE_START_BEACON, the log does not start at "
+             "reset\n", pName );
+    return False;
+  }
+  return True;
+}
+
+/****************************************************************************
+ Function
+   FindReplaced
+ Parameters
+   None
+ Returns
+   None
+ Description
+   marks the posts not to replay: those the queue dropped, and those that
+   a later post of the same type took out of the queue before they ran
+ Notes
+   with latest value wins posting a queue holds at most 1 event of such a
+   type, so the one replaced is the latest still queued before it
+ Author
+   Alex Loo, 10/18/26, 12:20
+****************************************************************************/
+static void FindReplaced( void )
+{
+  const Record_t *pRecord;
+  uint32_t i;
+  uint32_t j;
+
+  for ( i = 0; i < NumRecords; i++ ) {
+    pRecord = &pRecords[i];
+    if ( pRecord->Kind != ES_LOG_KIND_POST )
+      continue;
+    if ( (pRecord->Source & ES_LOG_POST_DROPPED) != 0 ) {
+      pSkip[i] = True;
+      continue;
+    }
+    if ( (pRecord->Source & ES_LOG_POST_REPLACED) == 0 )
+      continue;
+    for ( j = i; j-- > 0; ) {
+      if ( (pRecords[j].Kind == ES_LOG_KIND_POST) && (pSkip[j] == False) &&
+           (ES_LOG_POST_SERVICE( pRecords[j].Source ) ==
+            ES_LOG_POST_SERVICE( pRecord->Source )) &&
+           (pRecords[j].Code == pRecord->Code) ) {
+        pSkip[j] = True;
+        break;
+      }
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   Compare
+ Parameters
+   uint32_t i : the record's place in the log
+   const Record_t * pRecord : an ENTRY or EXIT record
+ Returns
+   boolean, False if the replay did something else
+ Description
+   checks the log's next transition against the replay's
+ Notes
+   every event that led to it has been replayed, as it was posted first
+ Author
+   Alex Loo, 10/18/26, 12:22
+****************************************************************************/
+static boolean Compare( uint32_t i, const Record_t *pRecord )
+{
+  const Record_t *pMine;
+
+  if ( NumMatched == NumReplayed ) {
+    Diverged( i, pRecord, NULL );
+    return False;
+  }
+  pMine = &pReplayed[NumMatched];
+  if ( (pMine->Kind != pRecord->Kind) || (pMine->Source != pRecord->Source) ||
+       (pMine->State != pRecord->State) ) {
+    Diverged( i, pRecord, pMine );
+    return False;
+  }
+  NumMatched++;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   RunPost
+ Parameters
+   uint32_t i : the record's place in the log
+   const Record_t * pRecord : a POST record to replay
+ Returns
+   None
+ Description
+   runs the event through its service, after noting any beacon it reports
+ Notes
+   BeaconDetection.c sets what GetBeacon* return as it posts the event
+ Author
+   Alex Loo, 10/18/26, 12:24
+****************************************************************************/
+static void RunPost( uint32_t i, const Record_t *pRecord )
+{
+  ES_Event ThisEvent;
+
+  ThisEvent.EventType = (ES_EventTyp_t)pRecord->Code;
+  ThisEvent.EventParam = pRecord->Param;
+  History[NumHistory++ % HISTORY] = i;
+  switch ( ES_LOG_POST_SERVICE( pRecord->Source ) ) {
+    case MASTER_SERVICE:
+      if ( ThisEvent.EventType == ES_BEACON_FRONT )
+        FrontBeacon = (uint8_t)ThisEvent.EventParam;
+      else if ( ThisEvent.EventType == ES_BEACON_REAR )
+        RearBeacon = (uint8_t)ThisEvent.EventParam;
+      RunMasterMachine( ThisEvent );
+      break;
+    case FIELD_STATE_SERVICE:
+      RunFieldState( ThisEvent );
+      break;
+    default:
+      break;
+  }
+}
+
+/****************************************************************************
+ Function
+   MoveTimeTo
+ Parameters
+   uint32_t Time : ticks since reset
+ Returns
+   None
+ Description
+   ticks the RTI up to Time
+ Notes
+   the timers post as they expire, and ES_PostToService drops what they
+   post
+ Author
+   Alex Loo, 10/18/26, 12:26
+****************************************************************************/
+static void MoveTimeTo( uint32_t Time )
+{
+  while ( (int32_t)(Time - ES_Timer_GetTime32()) > 0 )
+    ES_Port_Tick();
+}
+
+/****************************************************************************
+ Function
+   Diverged
+ Parameters
+   uint32_t i : the record's place in the log
+   const Record_t * pRecord : the log's transition
+   const Record_t * pMine : the replay's, or NULL if it made none
+ Returns
+   None
+ Description
+   reports the divergence, and the posts that led up to it
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 12:28
+****************************************************************************/
+static void Diverged( uint32_t i, const Record_t *pRecord,
+                      const Record_t *pMine )
+{
+  uint32_t h;
+
+  fprintf( pReport, "%s: diverged at record %lu, %.3f s: the log has %s %s "
+           "%s, ", pFileName, (unsigned long)i,
+           (double)pRecord->Time / TICKS_PER_SECOND,
+           AppNames_Machine( pRecord->Source ), KindName( pRecord->Kind ),
+           AppNames_State( pRecord->Source, pRecord->State ) );
+  if ( pMine == NULL )
+    fprintf( pReport, "the replay nothing more\n" );
+  else
+    fprintf( pReport, "the replay %s %s %s\n",
+             AppNames_Machine( pMine->Source ), KindName( pMine->Kind ),
+             AppNames_State( pMine->Source, pMine->State ) );
+  fprintf( pReport, "  %lu transitions matched before it; the latest posts "
+           "replayed:\n", (unsigned long)NumMatched );
+  for ( h = (NumHistory > HISTORY) ? NumHistory - HISTORY : 0;
+        h < NumHistory; h++ )
+    PrintRecord( History[h % HISTORY], &pRecords[History[h % HISTORY]] );
+  if ( LostPosts != 0 )
+    fprintf( pReport, "  %lu posts are missing from the log, the replay "
+             "may differ for want of them\n", (unsigned long)LostPosts );
+  fflush( pReport );
+}
+
+/****************************************************************************
+ Function
+   PrintRecord
+ Parameters
+   uint32_t i : the record's place in the log
+   const Record_t * pRecord : the record
+ Returns
+   None
+ Description
+   a line for a record, with names, for -v and for a divergence
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 12:30
+****************************************************************************/
+static void PrintRecord( uint32_t i, const Record_t *pRecord )
+{
+  fprintf( pReport, "  %7lu %9.3f s  %-5s ", (unsigned long)i,
+           (double)pRecord->Time / TICKS_PER_SECOND,
+           KindName( pRecord->Kind ) );
+  switch ( pRecord->Kind ) {
+    case ES_LOG_KIND_POST:
+      fprintf( pReport, "service %u %s %u%s%s\n",
+               ES_LOG_POST_SERVICE( pRecord->Source ),
+               AppNames_Event( pRecord->Code ), pRecord->Param,
+               (pRecord->Source & ES_LOG_POST_DROPPED) ? " (dropped)" : "",
+               (pRecord->Source & ES_LOG_POST_REPLACED) ? " (replaced one)" :
+                                                          "" );
+      break;
+    case ES_LOG_KIND_ENTRY:
+    case ES_LOG_KIND_EXIT:
+      fprintf( pReport, "%s %s\n", AppNames_Machine( pRecord->Source ),
+               AppNames_State( pRecord->Source, pRecord->State ) );
+      break;
+    default:
+      fprintf( pReport, "%s %s %u %u\n", AppNames_Machine( pRecord->Source ),
+               AppNames_State( pRecord->Source, pRecord->State ),
+               pRecord->Code, pRecord->Param );
+      break;
+  }
+}
+
+/****************************************************************************
+ Function
+   KindName
+ Parameters
+   uint8_t Kind : a record's ES_LogKind_t
+ Returns
+   const char *, a word for it
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 12:31
+****************************************************************************/
+static const char *KindName( uint8_t Kind )
+{
+  switch ( Kind ) {
+    case ES_LOG_KIND_NOTE:
+      return "note";
+    case ES_LOG_KIND_ENTRY:
+      return "entry";
+    case ES_LOG_KIND_EXIT:
+      return "exit";
+    case ES_LOG_KIND_EVENT:
+      return "event";
+    case ES_LOG_KIND_POST:
+      return "post";
+    default:
+      return "?";
+  }
+}
+/*------------------------------ End of file ------------------------------*/
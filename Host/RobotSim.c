@@ -0,0 +1,623 @@
+/****************************************************************************
+ Module
+     RobotSim.c
+ Description
+     Host stand-in for the robot's electronics, for SimMatch. It takes the
+     place of MotorDriver.c, QuickSense.c, BeaconDetection.c and
+     BinControl.c, with the same functions, against the field model in
+     ArenaSim.c, and runs their interrupt service routines from
+     RobotSim_Tick, once a tick, for the edges the field model's sensors
+     made in that tick.
+ Notes
+     The ISRs do what the firmware's do: the same debounce, the same state
+     gates, the same tests on the beacon period and the same posts to the
+     same ISR rings, with the time of each edge in counts of the fine
+     timebase, as the input captures would have it. The beacons' edges come
+     a little early or late, and the no-beacon output compare every 20 mS.
+
+     Where the firmware is wrong this models what it means to do, so that
+     the state machines can be tuned against the robot as it should be:
+       - MotorDriver.c's TurnRight and TurnRightSpeedSelect set the same
+         direction bits as TurnLeft; here they turn right, unless
+         RobotSim_TurnRightAsWritten is set.
+     QS_Initialize leaves the tape sensors' interrupts off, and so does this
+     unless RobotSim_TapeInterrupts is set. The first beacon period is
+     measured from power up, as the firmware's is from its timers' start,
+     POWER_UP_TIME before ES_Initialize.
+
+     PTP and DDRP, the team LEDs that SideID.c drives, are defined here for
+     include/mc9s12e128.h.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 14:40 adl      a lost beacon goes through the sensor's own ring
+ 10/18/26 10:55 adl      BeaconDetection.c's rear ISR is fixed, not modelled
+ 10/18/26 09:10 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stddef.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ISRRing.h"
+#include "ES_Timers.h"
+#include "TimingConstants.h"
+#include "MotorDriver.h"
+#include "QuickSense.h"
+#include "BeaconDetection.h"
+#include "BinControl.h"
+#include "MasterMachine.h"
+#include "ScoringSM.h"
+#include "DefendingSM.h"
+#include "ArenaSim.h"
+#include "RobotSim.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// as QuickSense.c and BeaconDetection.c have them
+#define DEBOUNCE_INTERVAL (100L * (unsigned long)(1 _MS_))
+#define PERIOD_NOBEACON (22L * (unsigned long)(1 _MS_))
+#define PERIOD_OC_CHECKBEACON (20 _MS_)
+// how far a beacon's edge may be from its time, either way
+#define BEACON_JITTER (200 _US_)
+// how long the robot takes from power up, when the capture timers start
+// from 0, to QS_Initialize, which ES_Initialize calls at fine time 0
+#define POWER_UP_TIME (100 _MS_)
+// the most edges 1 tick can bring: 1 from each beacon, 2 output compares
+#define MAX_EDGES 8
+
+/*---------------------------- Module Types -------------------------------*/
+// the input captures and output compare that RobotSim_Tick runs
+typedef enum { FRONT_BEACON_EDGE, REAR_BEACON_EDGE, NO_BEACON_CHECK } Edge_t;
+
+typedef struct {
+  Edge_t Which;
+  uint32_t Time;
+} EdgeAt_t;
+
+// a beacon sensor's ISR's state
+typedef struct {
+  unsigned char Seen;
+  uint32_t LastTime;
+  uint32_t LastPeriod;
+} BeaconSensor_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void SetWheels( int Left, int Right );
+static void BeaconEdge( BeaconSensor_t *pSensor, uint32_t Time, boolean Gate,
+                        uint8_t Ring, ES_EventTyp_t EventType );
+static void CheckNoBeacon( uint32_t Time );
+static void SwitchEdge( uint32_t *pLastEdge, uint32_t Time, boolean Gate,
+                        uint8_t Ring, ES_EventTyp_t EventType );
+static void AddEdge( Edge_t Which, uint32_t Time );
+
+/*---------------------------- Module Variables ---------------------------*/
+volatile unsigned char PTP;
+volatile unsigned char DDRP;
+
+void (*RobotSim_WaitHook)( void );
+boolean RobotSim_TapeInterrupts;
+boolean RobotSim_TurnRightAsWritten;
+
+// the ball counter
+static unsigned char BallsCollected;
+
+// the beacon sensors, and when each beacon's next edge and the next output
+// compare come
+static BeaconSensor_t Front;
+static BeaconSensor_t Rear;
+static uint32_t NextBeaconEdge[4];
+static uint32_t NextCheck;
+static boolean BeaconsRunning;
+
+// the bumpers and tape sensors: each one's last edge, and what it saw last
+// tick
+static uint32_t LastEdge[4];
+static ArenaSensors_t Last;
+
+// the edges of this tick, in time order
+static EdgeAt_t Edges[MAX_EDGES];
+static unsigned char NumEdges;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   RobotSim_Tick
+ Parameters
+   None
+ Returns
+   None
+ Description
+   runs the ISRs for what the sensors did since the last tick: the beacon
+   captures and the no-beacon compare in time order, then the bumpers and
+   tape sensors that closed, and counts the balls
+ Notes
+   call after ES_Port_Tick and Arena_Step
+ Author
+   Alex Loo, 10/18/26, 09:15
+****************************************************************************/
+void RobotSim_Tick( void )
+{
+  uint32_t Now = ES_Timer_GetFineTime();
+  uint32_t Jitter;
+  ArenaSensors_t Sensors;
+  unsigned char Beacon;
+  unsigned char i;
+
+  Arena_Sense( &Sensors );
+  if ( BeaconsRunning == True ) {
+    NumEdges = 0;
+    for ( Beacon = 1; Beacon <= 4; Beacon++ ) {
+      while ( (int32_t)(NextBeaconEdge[Beacon - 1] - Now) <= 0 ) {
+        Jitter = NextBeaconEdge[Beacon - 1] - BEACON_JITTER +
+                 Arena_Random() % (2 * BEACON_JITTER);
+        if ( Sensors.FrontBeacon == Beacon )
+          AddEdge( FRONT_BEACON_EDGE, Jitter );
+        if ( Sensors.RearBeacon == Beacon )
+          AddEdge( REAR_BEACON_EDGE, Jitter );
+        NextBeaconEdge[Beacon - 1] +=
+            (uint32_t)(PERIOD_1 - 2 * (Beacon - 1)) * (1 _MS_);
+      }
+    }
+    while ( (int32_t)(NextCheck - Now) <= 0 ) {
+      AddEdge( NO_BEACON_CHECK, NextCheck );
+      NextCheck += PERIOD_OC_CHECKBEACON;
+    }
+    for ( i = 0; i < NumEdges; i++ ) {
+      switch ( Edges[i].Which ) {
+        case FRONT_BEACON_EDGE:
+          BeaconEdge( &Front, Edges[i].Time,
+                      ((QueryScoringSM() == AligningFrontBeacon) ||
+                       (QueryScoringSM() == FindingLeftBeacon) ||
+                       (QueryScoringSM() == FindingRightBeacon) ||
+                       (QueryMasterMachine() == PreGame)) ? True : False,
+                      FRONT_BEACON_RING, ES_BEACON_FRONT );
+          break;
+        case REAR_BEACON_EDGE:
+          BeaconEdge( &Rear, Edges[i].Time,
+                      ((QueryScoringSM() == AligningRearBeacon) ||
+                       (QueryMasterMachine() == PreGame) ||
+                       (QueryDefendingSM() == Realigning)) ? True : False,
+                      REAR_BEACON_RING, ES_BEACON_REAR );
+          break;
+        case NO_BEACON_CHECK:
+          CheckNoBeacon( Edges[i].Time );
+          break;
+      }
+    }
+  }
+  // the bumpers and tape sensors interrupt as they close
+  if ( (Sensors.FrontBump == True) && (Last.FrontBump == False) )
+    SwitchEdge( &LastEdge[0], Now, True, FRONT_BUMPER_RING, ES_FRONT_BUMPED );
+  if ( (Sensors.RearBump == True) && (Last.RearBump == False) )
+    SwitchEdge( &LastEdge[1], Now, True, REAR_BUMPER_RING, ES_REAR_BUMPED );
+  if ( (RobotSim_TapeInterrupts == True) && (Sensors.LeftTape == True) &&
+       (Last.LeftTape == False) )
+    SwitchEdge( &LastEdge[2], Now,
+                (QueryMasterMachine() == Defending) ? True : False,
+                LEFT_TAPE_RING, ES_LEFT_TAPE_DETECTED );
+  if ( (RobotSim_TapeInterrupts == True) && (Sensors.RightTape == True) &&
+       (Last.RightTape == False) )
+    SwitchEdge( &LastEdge[3], Now,
+                (QueryMasterMachine() == Defending) ? True : False,
+                RIGHT_TAPE_RING, ES_RIGHT_TAPE_DETECTED );
+  BallsCollected = Sensors.Collected;
+  Last = Sensors;
+}
+
+/****************************************************************************
+ Function
+   MotorDriver_Init
+ Parameters
+   None
+ Returns
+   None
+ Description
+   stops the motors
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:20
+****************************************************************************/
+void MotorDriver_Init( void )
+{
+  SetWheels( 0, 0 );
+}
+
+/****************************************************************************
+ Function
+   GoForward, GoBackward, TurnLeft, TurnLeftSpeedSelect, TurnRight,
+   TurnRightSpeedSelect, FullStop
+ Parameters
+   unsigned char Speed : 0 to 100 %, for those that take one
+ Returns
+   None
+ Description
+   MotorDriver.c's motions, as wheel speeds for the field model
+ Notes
+   the turns spin the robot on the spot, one wheel forward and the other
+   back
+ Author
+   Alex Loo, 10/18/26, 09:21
+****************************************************************************/
+void GoForward( unsigned char Speed )
+{
+  SetWheels( Speed, Speed );
+}
+
+void GoBackward( unsigned char Speed )
+{
+  SetWheels( -(int)Speed, -(int)Speed );
+}
+
+void TurnLeft( void )
+{
+  SetWheels( -100, 100 );
+}
+
+void TurnLeftSpeedSelect( unsigned char Speed )
+{
+  SetWheels( -(int)Speed, Speed );
+}
+
+void TurnRight( void )
+{
+  if ( RobotSim_TurnRightAsWritten == True ) {
+    TurnLeft();
+  } else {
+    SetWheels( 100, -100 );
+  }
+}
+
+void TurnRightSpeedSelect( unsigned char Speed )
+{
+  if ( RobotSim_TurnRightAsWritten == True ) {
+    TurnLeftSpeedSelect( Speed );
+  } else {
+    SetWheels( Speed, -(int)Speed );
+  }
+}
+
+void FullStop( void )
+{
+  SetWheels( 0, 0 );
+}
+
+/****************************************************************************
+ Function
+   QS_Initialize
+ Parameters
+   None
+ Returns
+   None
+ Description
+   starts the sensors, with nothing seen yet, and beacon detection, as
+   QuickSense.c's does
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:23
+****************************************************************************/
+void QS_Initialize( void )
+{
+  unsigned char i;
+
+  BallsCollected = 0;
+  for ( i = 0; i < 4; i++ )
+    LastEdge[i] = 0;
+  Arena_Sense( &Last );
+  BeaconDetection_Init();
+}
+
+/****************************************************************************
+ Function
+   QS_QueryBallCount
+ Parameters
+   None
+ Returns
+   unsigned char : the balls the ball counter has seen
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:24
+****************************************************************************/
+unsigned char QS_QueryBallCount( void )
+{
+  return BallsCollected;
+}
+
+/****************************************************************************
+ Function
+   QS_QueryTIM0Overflow, QS_QueryTIM1Overflow
+ Parameters
+   None
+ Returns
+   unsigned int : the overflows of the timer
+ Description
+   both timers count with the fine timebase
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:25
+****************************************************************************/
+unsigned int QS_QueryTIM0Overflow( void )
+{
+  return (unsigned int)(ES_Timer_GetFineTime() >> 16);
+}
+
+unsigned int QS_QueryTIM1Overflow( void )
+{
+  return (unsigned int)(ES_Timer_GetFineTime() >> 16);
+}
+
+/****************************************************************************
+ Function
+   BeaconDetection_Init
+ Parameters
+   None
+ Returns
+   None
+ Description
+   starts the beacon captures, and the no-beacon compare 20 mS from now
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:26
+****************************************************************************/
+void BeaconDetection_Init( void )
+{
+  uint32_t Now = ES_Timer_GetFineTime();
+  unsigned char Beacon;
+
+  for ( Beacon = 1; Beacon <= 4; Beacon++ )
+    NextBeaconEdge[Beacon - 1] = Now + Arena_BeaconPhase( Beacon );
+  NextCheck = Now + PERIOD_OC_CHECKBEACON;
+  Front.Seen = 0;
+  Front.LastTime = (uint32_t)0 - POWER_UP_TIME;
+  Front.LastPeriod = 0;
+  Rear = Front;
+  BeaconsRunning = True;
+}
+
+/****************************************************************************
+ Function
+   GetBeaconRear
+ Parameters
+   None
+ Returns
+   unsigned char : the beacon the rear sensor sees, 0 for none
+ Description
+   as BeaconDetection.c's, but while neither sensor has seen a beacon it
+   first calls RobotSim_WaitHook, so that time passes while
+   StartMasterMachine waits
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:27
+****************************************************************************/
+unsigned char GetBeaconRear( void )
+{
+  if ( (RobotSim_WaitHook != NULL) && (Front.Seen == 0) && (Rear.Seen == 0) )
+    RobotSim_WaitHook();
+  return Rear.Seen;
+}
+
+/****************************************************************************
+ Function
+   GetBeaconFront
+ Parameters
+   None
+ Returns
+   unsigned char : the beacon the front sensor sees, 0 for none
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:28
+****************************************************************************/
+unsigned char GetBeaconFront( void )
+{
+  return Front.Seen;
+}
+
+/****************************************************************************
+ Function
+   InitFan
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the fan starts off
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:29
+****************************************************************************/
+void InitFan( void )
+{
+  Arena_SetFan( False );
+}
+
+/****************************************************************************
+ Function
+   FanControl
+ Parameters
+   char Control : 1 for on, anything else for off
+ Returns
+   None
+ Description
+   as BinControl.c's
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:30
+****************************************************************************/
+void FanControl( char Control )
+{
+  Arena_SetFan( (Control == 1) ? True : False );
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   SetWheels
+ Parameters
+   int Left, int Right : -100 to 100 %
+ Returns
+   None
+ Description
+   hands the wheel speeds to the field model
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:31
+****************************************************************************/
+static void SetWheels( int Left, int Right )
+{
+  Arena_SetWheels( Left, Right );
+}
+
+/****************************************************************************
+ Function
+   BeaconEdge
+ Parameters
+   BeaconSensor_t * pSensor : the sensor's state
+   uint32_t Time : when the edge came, in fine counts
+   boolean Gate : True if the state machines want this sensor's beacons
+   uint8_t Ring : the ISR ring to post to
+   ES_EventTyp_t EventType : ES_BEACON_FRONT or ES_BEACON_REAR
+ Returns
+   None
+ Description
+   BeaconDetection.c's ResponseToIC5 and ResponseToIC6: a period of 1 of
+   the beacons, or 1 mS under it, that differs from the last period posts
+   that beacon if it is not the one already seen
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:33
+****************************************************************************/
+static void BeaconEdge( BeaconSensor_t *pSensor, uint32_t Time, boolean Gate,
+                        uint8_t Ring, ES_EventTyp_t EventType )
+{
+  uint32_t Period = (Time - pSensor->LastTime) / (1 _MS_);
+  unsigned char Beacon;
+  uint32_t BeaconPeriod;
+  ES_Event ThisEvent;
+
+  pSensor->LastTime = Time;
+  if ( (Period != pSensor->LastPeriod) && (Gate == True) ) {
+    for ( Beacon = 1; Beacon <= 4; Beacon++ ) {
+      BeaconPeriod = (uint32_t)(PERIOD_1 - 2 * (Beacon - 1));
+      if ( (pSensor->Seen != Beacon) &&
+           ((Period == BeaconPeriod) || (Period == BeaconPeriod - 1)) ) {
+        ThisEvent.EventType = EventType;
+        ThisEvent.EventParam = Beacon;
+        ES_ISRRing_Post( Ring, ThisEvent );
+        pSensor->Seen = Beacon;
+        break;
+      }
+    }
+    pSensor->LastPeriod = Period;
+  }
+}
+
+/****************************************************************************
+ Function
+   CheckNoBeacon
+ Parameters
+   uint32_t Time : when the compare came, in fine counts
+ Returns
+   None
+ Description
+   BeaconDetection.c's CheckNoBeacon: a sensor with no edge for 22 mS
+   posts beacon 0
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:35
+****************************************************************************/
+static void CheckNoBeacon( uint32_t Time )
+{
+  ES_Event ThisEvent;
+
+  if ( (Front.Seen != 0) && ((Time - Front.LastTime) > PERIOD_NOBEACON) ) {
+    ThisEvent.EventType = ES_BEACON_FRONT;
+    ThisEvent.EventParam = 0;
+    ES_ISRRing_Post( FRONT_BEACON_RING, ThisEvent );
+    Front.Seen = 0;
+  }
+  if ( (Rear.Seen != 0) && ((Time - Rear.LastTime) > PERIOD_NOBEACON) ) {
+    ThisEvent.EventType = ES_BEACON_REAR;
+    ThisEvent.EventParam = 0;
+    ES_ISRRing_Post( REAR_BEACON_RING, ThisEvent );
+    Rear.Seen = 0;
+  }
+}
+
+/****************************************************************************
+ Function
+   SwitchEdge
+ Parameters
+   uint32_t * pLastEdge : the time of the input's last edge
+   uint32_t Time : when this edge came, in fine counts
+   boolean Gate : True if the firmware posts for it in this state
+   uint8_t Ring : the ISR ring to post to
+   ES_EventTyp_t EventType : the event to post
+ Returns
+   None
+ Description
+   QuickSense.c's bumper and tape ISRs: an edge more than 100 mS after the
+   last posts, with the time in seconds
+ Notes
+   the last edge moves on whether or not this one posts, as in the firmware
+ Author
+   Alex Loo, 10/18/26, 09:37
+****************************************************************************/
+static void SwitchEdge( uint32_t *pLastEdge, uint32_t Time, boolean Gate,
+                        uint8_t Ring, ES_EventTyp_t EventType )
+{
+  ES_Event ThisEvent;
+
+  if ( ((Time - *pLastEdge) > DEBOUNCE_INTERVAL) && (Gate == True) ) {
+    ThisEvent.EventType = EventType;
+    ThisEvent.EventParam = (uint16_t)(Time / (1 _SEC_));
+    ES_ISRRing_Post( Ring, ThisEvent );
+  }
+  *pLastEdge = Time;
+}
+
+/****************************************************************************
+ Function
+   AddEdge
+ Parameters
+   Edge_t Which : the ISR to run
+   uint32_t Time : when, in fine counts
+ Returns
+   None
+ Description
+   puts an edge into this tick's list, in time order
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:38
+****************************************************************************/
+static void AddEdge( Edge_t Which, uint32_t Time )
+{
+  unsigned char i = NumEdges;
+
+  if ( NumEdges >= MAX_EDGES )
+    return;
+  while ( (i > 0) && ((int32_t)(Edges[i - 1].Time - Time) > 0) ) {
+    Edges[i] = Edges[i - 1];
+    i--;
+  }
+  Edges[i].Which = Which;
+  Edges[i].Time = Time;
+  NumEdges++;
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,36 @@
+/****************************************************************************
+ Module
+     RobotSim.h
+ Description
+     the host stand-in for the robot's electronics, for SimMatch: the motor
+     driver, the interrupt driven sensors (QuickSense), beacon detection and
+     the fan, all against the field model in ArenaSim.c
+ Notes
+     RobotSim.c defines the functions of MotorDriver.h, QuickSense.h,
+     BeaconDetection.h and BinControl.h in place of the firmware's modules
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 09:10 adl      started coding
+*****************************************************************************/
+#ifndef RobotSim_H
+#define RobotSim_H
+
+#include "ES_Types.h"
+
+// called from GetBeaconRear while no beacon has been seen, so that the
+// world moves on under StartMasterMachine's wait for a beacon; NULL once
+// ES_Run is going
+extern void (*RobotSim_WaitHook)( void );
+
+// True to enable the tape sensors' interrupts, which QS_Initialize leaves
+// off
+extern boolean RobotSim_TapeInterrupts;
+
+// True to have TurnRight and TurnRightSpeedSelect set the same direction
+// bits as TurnLeft, as MotorDriver.c does
+extern boolean RobotSim_TurnRightAsWritten;
+
+void RobotSim_Tick( void );
+
+#endif /* RobotSim_H */
@@ -0,0 +1,318 @@
+/****************************************************************************
+ Module
+     SCISim.c
+ Description
+     Host stand-in for SCI0. termio.c, built with ES_HOST_BUILD, reads the
+     status bits with SCISim_TxReady and SCISim_RxReady and the data
+     register with SCISim_Write and SCISim_Read. The other end of the port is
+     a pty: what is sent comes out of the pty's slave, whatever is written to
+     the slave is received.
+ Notes
+     A thread stands in for the shift registers and the interrupt. Once per
+     character time (10 bits at the baud rate) it sends the byte in the
+     transmit data register, if there is one, takes in the next byte from
+     the pty if the receive data register is empty, and then runs
+     TERMIO_SCI0ISR if RDRF is set, or TDRE is set with the transmit
+     interrupt on (ES_Port_SCI0TxOn). So the ISR runs at the rate it would on
+     the S12, but alongside the main loop rather than in place of it.
+
+     SCISim_Start returns the pty's slave, in raw mode, for the caller to
+     read and write.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 02:45 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "ES_Port.h"
+#include "Console.h"
+#include "SCISim.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define NS_PER_S 1000000000L
+// bits per character: start, 8 data, stop
+#define BITS_PER_CHAR 10
+// character times the thread may make up at once after sleeping too long
+#define MAX_BEHIND 32
+
+/*---------------------------- Module Functions ---------------------------*/
+static void *PortThread( void *pArg );
+static void RunSlot( void );
+static void AddNs( struct timespec *pTime, long Ns );
+
+/*---------------------------- Module Variables ---------------------------*/
+volatile uint32_t SCISim_TxBytes;
+volatile uint32_t SCISim_RxBytes;
+
+static int Master = -1;
+static pthread_t Thread;
+static volatile int Running;
+static long CharNs;
+
+// the registers: TDRE and RDRF, and the 2 data registers behind SCI0DRL
+static volatile int Tdre = 1;
+static volatile int Rdrf;
+static volatile uint8_t TxData;
+static volatile uint8_t RxData;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   SCISim_Start
+ Parameters
+   uint32_t Baud : the baud rate to run the port at
+ Returns
+   int : the pty's slave, open and in raw mode, or -1 on error
+ Description
+   opens a pty for the other end of the port and starts the port's thread
+ Notes
+   call TERMIO_Init first
+ Author
+   Alex Loo, 10/18/26, 02:48
+****************************************************************************/
+int SCISim_Start( uint32_t Baud )
+{
+  struct termios Settings;
+  int Slave;
+
+  Master = posix_openpt( O_RDWR | O_NOCTTY );
+  if ( (Master < 0) || (grantpt( Master ) != 0) ||
+       (unlockpt( Master ) != 0) )
+    return -1;
+  Slave = open( ptsname( Master ), O_RDWR | O_NOCTTY );
+  if ( Slave < 0 )
+    return -1;
+  tcgetattr( Slave, &Settings );
+  cfmakeraw( &Settings );
+  tcsetattr( Slave, TCSANOW, &Settings );
+  fcntl( Master, F_SETFL, fcntl( Master, F_GETFL ) | O_NONBLOCK );
+
+  CharNs = (long)(((int64_t)NS_PER_S * BITS_PER_CHAR) / Baud);
+  Tdre = 1;
+  Rdrf = 0;
+  SCISim_TxBytes = 0;
+  SCISim_RxBytes = 0;
+  Running = 1;
+  if ( pthread_create( &Thread, NULL, PortThread, NULL ) != 0 )
+    return -1;
+  return Slave;
+}
+
+/****************************************************************************
+ Function
+   SCISim_Stop
+ Parameters
+   None
+ Returns
+   None
+ Description
+   stops the port's thread and closes the pty's master
+ Notes
+   the caller closes the slave
+ Author
+   Alex Loo, 10/18/26, 02:52
+****************************************************************************/
+void SCISim_Stop( void )
+{
+  __atomic_store_n( &Running, 0, __ATOMIC_SEQ_CST );
+  pthread_join( Thread, NULL );
+  close( Master );
+  Master = -1;
+}
+
+/****************************************************************************
+ Function
+   SCISim_TxReady
+ Parameters
+   None
+ Returns
+   boolean : True if the transmit data register is empty (TDRE)
+ Description
+   SCI0SR1 & _S12_TDRE
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 02:54
+****************************************************************************/
+boolean SCISim_TxReady( void )
+{
+  return __atomic_load_n( &Tdre, __ATOMIC_ACQUIRE ) ? True : False;
+}
+
+/****************************************************************************
+ Function
+   SCISim_RxReady
+ Parameters
+   None
+ Returns
+   boolean : True if a byte has been received (RDRF)
+ Description
+   SCI0SR1 & _S12_RDRF
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 02:55
+****************************************************************************/
+boolean SCISim_RxReady( void )
+{
+  return __atomic_load_n( &Rdrf, __ATOMIC_ACQUIRE ) ? True : False;
+}
+
+/****************************************************************************
+ Function
+   SCISim_Write
+ Parameters
+   uint8_t Byte : the byte to send
+ Returns
+   None
+ Description
+   SCI0DRL = Byte, clears TDRE
+ Notes
+   only when TDRE is set, as on the S12
+ Author
+   Alex Loo, 10/18/26, 02:56
+****************************************************************************/
+void SCISim_Write( uint8_t Byte )
+{
+  TxData = Byte;
+  __atomic_store_n( &Tdre, 0, __ATOMIC_RELEASE );
+}
+
+/****************************************************************************
+ Function
+   SCISim_Read
+ Parameters
+   None
+ Returns
+   uint8_t : the byte received
+ Description
+   reads SCI0DRL, clears RDRF
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 02:57
+****************************************************************************/
+uint8_t SCISim_Read( void )
+{
+  uint8_t Byte = RxData;
+
+  __atomic_store_n( &Rdrf, 0, __ATOMIC_RELEASE );
+  return Byte;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   PortThread
+ Parameters
+   void * pArg : unused
+ Returns
+   void * : NULL
+ Description
+   the shift registers and the interrupt, 1 character time at a time
+ Notes
+   the host wakes the thread late now and then; it runs the character
+   times it missed, up to MAX_BEHIND, at once, so the port keeps its rate
+ Author
+   Alex Loo, 10/18/26, 03:00
+****************************************************************************/
+static void *PortThread( void *pArg )
+{
+  struct timespec Next;
+  struct timespec Now;
+  int64_t Behind;
+
+  (void)pArg;
+  clock_gettime( CLOCK_MONOTONIC, &Next );
+  while ( __atomic_load_n( &Running, __ATOMIC_SEQ_CST ) ) {
+    AddNs( &Next, CharNs );
+    clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &Next, NULL );
+    clock_gettime( CLOCK_MONOTONIC, &Now );
+    Behind = (int64_t)(Now.tv_sec - Next.tv_sec) * NS_PER_S +
+             (Now.tv_nsec - Next.tv_nsec);
+    if ( Behind > MAX_BEHIND * CharNs ) {
+      Next = Now;
+      Behind = 0;
+    }
+    for ( ; Behind >= CharNs; Behind -= CharNs ) {
+      RunSlot();
+      AddNs( &Next, CharNs );
+    }
+    RunSlot();
+  }
+  return NULL;
+}
+
+/****************************************************************************
+ Function
+   RunSlot
+ Parameters
+   None
+ Returns
+   None
+ Description
+   1 character time of the port: sends the transmit data register, takes
+   in a byte, runs the ISR
+ Notes
+   a byte the pty will not take yet (nobody reading the slave) stays in the
+   transmit data register, as if the far end held off the port
+ Author
+   Alex Loo, 10/18/26, 03:02
+****************************************************************************/
+static void RunSlot( void )
+{
+  uint8_t Byte;
+
+  if ( __atomic_load_n( &Tdre, __ATOMIC_ACQUIRE ) == 0 ) {
+    Byte = TxData;
+    if ( write( Master, &Byte, 1 ) == 1 ) {
+      __atomic_fetch_add( &SCISim_TxBytes, 1, __ATOMIC_RELAXED );
+      __atomic_store_n( &Tdre, 1, __ATOMIC_RELEASE );
+    }
+  }
+  if ( (__atomic_load_n( &Rdrf, __ATOMIC_ACQUIRE ) == 0) &&
+       (read( Master, &Byte, 1 ) == 1) ) {
+    RxData = Byte;
+    __atomic_fetch_add( &SCISim_RxBytes, 1, __ATOMIC_RELAXED );
+    __atomic_store_n( &Rdrf, 1, __ATOMIC_RELEASE );
+  }
+  if ( SCISim_RxReady() ||
+       (SCISim_TxReady() &&
+        __atomic_load_n( &ES_Port_SCI0TxOn, __ATOMIC_SEQ_CST )) )
+    TERMIO_SCI0ISR();
+}
+
+/****************************************************************************
+ Function
+   AddNs
+ Parameters
+   struct timespec * pTime : the time to move on
+   long Ns : by how many nS, less than 1 S
+ Returns
+   None
+ Description
+   adds Ns to *pTime
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 03:04
+****************************************************************************/
+static void AddNs( struct timespec *pTime, long Ns )
+{
+  pTime->tv_nsec += Ns;
+  if ( pTime->tv_nsec >= NS_PER_S ) {
+    pTime->tv_nsec -= NS_PER_S;
+    pTime->tv_sec++;
+  }
+}
+/*------------------------------ End of file ------------------------------*/
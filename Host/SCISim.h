@@ -0,0 +1,32 @@
+/****************************************************************************
+ Module
+     SCISim.h
+ Description
+     the host stand-in for SCI0, with a pty on the other end of it, for
+     termio.c built with ES_HOST_BUILD
+ Notes
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 02:45 adl      started coding
+*****************************************************************************/
+#ifndef SCISim_H
+#define SCISim_H
+
+#include "ES_Types.h"
+
+// what has gone through the port
+extern volatile uint32_t SCISim_TxBytes;   // bytes sent to the pty
+extern volatile uint32_t SCISim_RxBytes;   // bytes taken from the pty
+
+int  SCISim_Start( uint32_t Baud );
+void SCISim_Stop( void );
+
+// the status and data registers, for termio.c
+boolean SCISim_TxReady( void );
+boolean SCISim_RxReady( void );
+void SCISim_Write( uint8_t Byte );
+uint8_t SCISim_Read( void );
+
+#endif /* SCISim_H */
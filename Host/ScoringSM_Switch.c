@@ -0,0 +1,963 @@
+/****************************************************************************
+ Module
+     ScoringSM_Switch.c
+ Description
+     the Scoring machine as ScoringSM.c was before it ran from its table,
+     with a switch on the state and another on the event, for BenchTable to
+     check ScoringSM_Table.h against and time it against
+ Notes
+     Only BenchTable builds this. Its public functions are renamed below so
+     that it links with ScoringSM.c; it has its own ScoringSM_t. Left as it
+     was apart from the renames and its printfs, so a change to
+     ScoringSM_Spec.h that changes what the machine does must be made here
+     too, or BenchTable, which make test runs, fails.
+     Kept here rather than taken out of git, so that it survives a rebase
+     or a squashed merge.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 15:40 adl      back from git to a checked-in copy, make test checks it
+ 10/18/26 13:50 adl      copied from ScoringSM.c before it went to a table
+*****************************************************************************/
+#define StartScoringSM StartScoringSM_Switch
+#define RunScoringSM RunScoringSM_Switch
+#define QueryScoringSM QueryScoringSM_Switch
+#define QueryTargetBin QueryTargetBin_Switch
+
+// its narration goes nowhere, as the table's machine does not narrate its
+// transitions, so that BenchTable times what the two do alike
+#include <stdio.h>
+#define printf(...) ((void)0)
+
+/*----------------------------- Include Files -----------------------------*/
+/* include header files for this state machine as well as any machines at the
+   next lower level in the hierarchy that are sub-machines to this machine
+*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Trace.h"
+#include "ScoringSM.h"
+
+// Module Headers
+#include "MotorDriver.h"
+#include "TimingConstants.h"
+#include "FSR.h"
+#include "SideID.h"
+#include "BinControl.h"
+#include "ScoringMode.h" // helper functions for use during scoring mode
+#include "BeaconDetection.h"
+
+#include <stdio.h>
+#include "ES_Log.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_APPROACH_PASSES 2
+
+#define BEACON_NOD
+#define BACKUP_SEARCH
+
+/*---------------------------- Module Functions ---------------------------*/
+/* prototypes for private functions for this machine.They should be functions
+   relevant to the behavior of this state machine
+*/
+static ES_Event DuringAligningRearBeacon(ES_Event);
+static ES_Event DuringAligningFrontBeacon(ES_ME_(ScoringSM_t) ES_Event);
+static ES_Event DuringDrivingForward_Clearance(ES_Event);
+static ES_Event DuringDrivingForward_Alignment(ES_Event);
+static ES_Event DuringBackingUp(ES_Event);
+static ES_Event DuringUnloading(ES_Event);
+static ES_Event DuringShuffling(ES_ME_(ScoringSM_t) ES_Event);
+static ES_Event DuringFindingLeftBeacon(ES_ME_(ScoringSM_t) ES_Event ThisEvent);
+static ES_Event DuringFindingRightBeacon(ES_ME_(ScoringSM_t) ES_Event ThisEvent);
+static ES_Event DuringBisectingAngle(ES_ME_(ScoringSM_t) ES_Event ThisEvent);
+
+/*---------------------------- Module Variables ---------------------------*/
+// everybody needs a state variable, you may need others as well. They are
+// in a ScoringSM_t: with ES_INSTANCES each function is passed the one to use
+// as Me, without it this is the only one
+#if !ES_INSTANCES
+static ScoringSM_t TheScoringSM = SCORING_SM_INIT;
+#define Me (&TheScoringSM)
+#endif
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+     QueryScoringSM
+
+ Parameters
+     None
+
+ Returns
+     GatheringState_t The current state of the Gathering state machine
+
+ Description
+     returns the current state of the Gathering state machine
+ Notes
+
+ Author
+     J. Edward Carryer, 10/23/11, 19:21
+****************************************************************************/
+ScoringState_t QueryScoringSM ( ES_ME(const ScoringSM_t) )
+{
+   return(Me->CurrentState);
+}
+
+/****************************************************************************
+Function
+     	StartScoringSM
+
+Parameters
+     	CurrentEvent
+
+Returns
+		None
+		
+Description
+     	Starts the scoring state machine
+Notes
+
+Author
+     J. Edward Carryer, 10/23/11, 19:21
+****************************************************************************/
+void StartScoringSM ( ES_ME_(ScoringSM_t) ES_Event CurrentEvent )
+{
+	// Create a local variable to allow debugger to display CurrentEvent
+	ES_Event LocalEvent = CurrentEvent;
+	
+	printf("\r\nRunning StartScoringSM.");
+	Me->CurrentState = AligningRearBeacon;
+	// Run entry function for scoring state machine
+	// Determine which bin to score on
+	printf("\r\nAbout to determine target bin.");
+   Me->TargetBin = PickScoringBin(ES_WITH(&Me->Mode));
+   printf("\r\nTarget bin determined.");
+   
+   
+   /*printf("\r\nBalls in Bin 1: %u", Get_BallsInBin(1));
+   printf("\r\nBalls in Bin 2: %u", Get_BallsInBin(2));
+   printf("\r\nBalls in Bin 3: %u", Get_BallsInBin(3));
+   printf("\r\nBalls in Bin 4: %u", Get_BallsInBin(4));*/
+
+   printf("\r\nTarget Bin is: %u", Me->TargetBin);
+	
+	
+	// Determine opposite bin from target bin
+	switch(Me->TargetBin)
+	{
+	   case 1:
+	      Me->OppositeBin = 3;
+	      Me->RightBin = 4;
+	      Me->LeftBin = 2;
+	   break;
+	   
+	   case 2:
+	      Me->OppositeBin = 4;
+	      Me->RightBin = 1;
+	      Me->LeftBin = 3;
+	   break;
+	   
+	   case 3:
+	      Me->OppositeBin = 1;
+	      Me->RightBin = 2;
+	      Me->LeftBin = 4;
+	   break;
+	   
+	   case 4:
+	      Me->OppositeBin = 2;
+	      Me->RightBin = 3;
+	      Me->LeftBin = 1;
+	   break;
+	}
+	printf("\r\nStarting Scoring SM.");
+	RunScoringSM(ES_WITH_(Me) LocalEvent);	
+}
+
+/****************************************************************************
+ Function
+    RunScoringSM
+
+ Parameters
+   ES_Event : the event to process
+
+ Returns
+   ES_Event, ES_NO_EVENT if no error ES_ERROR otherwise
+
+ Description
+   add your description here
+ Notes
+   uses nested switch/case to implement the machine.
+ Author
+   J. Edward Carryer, 01/15/12, 15:23
+****************************************************************************/
+ES_Event RunScoringSM(ES_ME_(ScoringSM_t) ES_Event ThisEvent)
+{
+   boolean MakeTransition = False; // are we making a state transition?
+  	ScoringState_t NextState = Me->CurrentState;
+  	ES_Event ReturnEvent = ThisEvent; // Assume we are not consuming event
+  	  	
+  	ES_LogEvent(LOG_SCORING, Me->CurrentState, ThisEvent);
+  	switch (Me->CurrentState)
+  	{
+  	   case AligningRearBeacon:
+     	   //printf("\r\nIn the AligningRearBeacon state.");
+     	   // Execute the during function for aligning rear beacon
+     	   // Entry and exit functions are processed here
+     	   ThisEvent = DuringAligningRearBeacon(ThisEvent);
+     	   
+     	   // Process events
+     	   // Check if there is an event to respond to
+     	   if (ThisEvent.EventType != ES_NO_EVENT)
+     	   {
+     	      // Switch on event types
+     	      switch(ThisEvent.EventType)
+     	      {
+     	         case ES_BEACON_REAR:
+        	         if (ThisEvent.EventParam == Me->TargetBin)
+        	         {
+        	            //printf("\r\nFound the beacon on the rear. Going to BackingUp.");
+        	            // We have the rear aligned with where we want to score
+        	            NextState = BackingUp; // determine what the next state will be
+        	            MakeTransition = True; // mark that we are making a transition
+        	            ReturnEvent.EventType = ES_NO_EVENT; // consume the event 
+        	         }
+     	         break; // end rear beacon event
+     	         
+     	         case ES_TIMEOUT:
+     	            if (ThisEvent.EventParam == BEACON_NOD_TIMER)
+     	            {
+     	               // Switch directions, this was to limit full circles while searching
+     	               TurnLeftSpeedSelect(BEACON_SEARCH_TURN_SPEED);  
+     	            }     	            
+     	         break;
+     	         
+     	      } // End event type switch 
+     	   } // End guard against no event
+  	   break; // End AligningRearBeaconState
+  	   
+  	   case AligningFrontBeacon:
+     	   // Execute the during function for aligning rear beacon
+     	   // Entry and exit functions are processed here
+     	   ThisEvent = DuringAligningFrontBeacon(ES_WITH_(Me) ThisEvent);
+     	   
+     	   // Process events
+     	   // Check if there is an event to respond to
+     	   if (ThisEvent.EventType != ES_NO_EVENT)
+     	   {
+     	      // Switch on event types
+     	      switch(ThisEvent.EventType)
+     	      {
+     	         case ES_BEACON_FRONT:
+     	            if (ThisEvent.EventParam == Me->OppositeBin)
+     	            {
+     	               //printf("\r\nFound the beacon on the front. Going to DrivingForward_Alignment.");
+     	               // We have the rear aligned with the bin across the field
+     	               NextState = DrivingForward_Alignment;// determine what the next state will be
+     	               MakeTransition = True; // mark that we are making a transition
+     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	               
+     	               // Set the timer length based on which pass this is
+     	               if (Me->ApproachPass == (MAX_APPROACH_PASSES-2))
+     	               {
+     	                  // This is the first pass
+     	                  ES_Timer_InitTimer(AppTimer[MOTION_TIMER], FIRST_FWD_ALIGN_INTERVAL);
+     	               }
+     	               else if (Me->ApproachPass == (MAX_APPROACH_PASSES-1))
+     	               {
+     	                  // This is the second pass
+     	                  ES_Timer_InitTimer(AppTimer[MOTION_TIMER], SECOND_FWD_ALIGN_INTERVAL);
+     	               }
+     	            }
+     	         break;
+     	         
+     	         case ES_TIMEOUT:
+     	            if (ThisEvent.EventParam == BEACON_NOD_TIMER)
+     	            {
+     	               // Switch directions, this was to limit full circles while searching
+     	               TurnLeftSpeedSelect(BEACON_SEARCH_TURN_SPEED);  
+     	            }
+     	            
+     	            else if (ThisEvent.EventParam == GO_TO_BACKUP_SEARCH_TIMER)
+     	            {
+     	               // Could not find the beacon, go to backup alignment method
+     	               printf("\r\nCould not find the opposite beacon. Go to bisecting.");
+     	               NextState = FindingLeftBeacon; // go to the state where we're looking for left beacon
+     	               MakeTransition = True; // mark that we are making a transition
+     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	            }     	            
+     	         break;
+     	         
+     	      } // End event type switch 
+     	   } // End guard against no event
+  	   break; // End AligningFrontBeaconState
+  	   
+  	   case DrivingForward_Clearance:
+     	   // Execute the during function for aligning rear beacon
+     	   // Entry and exit functions are processed here
+     	   ThisEvent = DuringDrivingForward_Clearance(ThisEvent);
+     	   
+     	   // Process events
+     	   // Check if there is an event to respond to
+     	   if (ThisEvent.EventType != ES_NO_EVENT)
+     	   {
+     	      // Switch on event types
+     	      switch(ThisEvent.EventType)
+     	      {
+     	         case ES_TIMEOUT:
+     	            if (ThisEvent.EventParam == MOTION_TIMER)
+     	            {
+     	               printf("\r\nEnough clearance has been achieved. Looking for front beacon.");
+     	               // Sufficienct clearance has been achieved
+     	               NextState = AligningFrontBeacon;// determine what the next state will be
+     	               MakeTransition = True; // mark that we are making a transition
+     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event 
+     	            }
+     	         break;
+     	         
+     	      } // End event type switch 
+     	   } // End guard against no event
+  	   break; // End DrivingForward100 State
+  	   
+  	   case DrivingForward_Alignment:
+     	   // Execute the during function for aligning rear beacon
+     	   // Entry and exit functions are processed here
+     	   ThisEvent = DuringDrivingForward_Alignment(ThisEvent);
+     	   
+     	   // Process events
+     	   // Check if there is an event to respond to
+     	   if (ThisEvent.EventType != ES_NO_EVENT)
+     	   {
+     	      // Switch on event types
+     	      switch(ThisEvent.EventType)
+     	      {       	         
+     	         case ES_TIMEOUT:
+                  if (ThisEvent.EventParam == MOTION_TIMER)
+                  {
+                     printf("\r\nAlignment period ended. Look for rear beacon.");
+                     // Alignment driving interval has been reached
+                     NextState = AligningRearBeacon;// determine what the next state will be
+  	                  MakeTransition = True; // mark that we are making a transition
+  	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event  
+                  } 	         
+     	         break;
+     	         
+     	         case ES_FRONT_BUMPED:
+     	            printf("\r\nHit something in front while aligning. Look for rear beacon.");
+     	            // We hit something as we were driving forward
+     	            NextState = AligningRearBeacon;// determine what the next state will be
+  	               MakeTransition = True; // mark that we are making a transition
+  	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	         break;
+     	         
+     	         /*
+     	         case ES_BEACON_FRONT:
+     	            if (ThisEvent.EventParam == 0)
+     	            {
+     	               printf("\r\nWe lost the front beacon.");
+     	               // We lost the beacon, let's look for it again
+     	               NextState = AligningFrontBeacon; // determine what the next state will be
+     	               MakeTransition = True; // mark that we are making a transition
+     	               ReturnEvent.EventType = ES_NO_EVENT; // consume event
+     	               // decrement the alignment pass counter since we're going back into aligning state
+     	               Me->ApproachPass--; 
+     	            }
+     	         break;
+     	         */
+     	      } // End event type switch 
+     	   } // End guard against no event
+  	   break; // End DrivingForward_Alignment State
+  	   
+  	   case BackingUp:
+     	   // Execute the during function for aligning rear beacon
+     	   // Entry and exit functions are processed here
+     	   ThisEvent = DuringBackingUp(ThisEvent);
+     	   
+     	   // Process events
+     	   // Check if there is an event to respond to
+     	   if (ThisEvent.EventType != ES_NO_EVENT)
+     	   {
+     	      // Switch on event types
+     	      switch(ThisEvent.EventType)
+     	      {
+     	         case ES_LEFT_TAPE_DETECTED:
+     	            printf("\r\nFound tape while heading to target bin, slow down.");
+     	            // Tape detected, take caution
+     	            GoBackward(CAUTION_SPEED); // set backward speed to caution speed
+     	            ES_Timer_InitTimer(AppTimer[MOTION_TIMER], CAUTION_INTERVAL);
+     	            ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	         break;
+     	         
+     	         case ES_RIGHT_TAPE_DETECTED:
+     	            printf("\r\nFound tape while heading to target bin, slow down.");
+     	            // Tape detected, take caution
+     	            GoBackward(CAUTION_SPEED); // set backward speed caution speed
+     	            ES_Timer_InitTimer(AppTimer[MOTION_TIMER], CAUTION_INTERVAL);
+     	            ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	         break;
+     	         
+     	         case ES_TIMEOUT:
+     	            if(ThisEvent.EventParam == MOTION_TIMER)
+     	            {
+     	               printf("\r\nCaution period expired. Go at 100");
+     	               // The caution period expired without hitting a wall
+     	               // Let's go ludicrous speed
+     	               GoBackward(100);
+     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	            }
+     	         break;
+     	         
+     	         case ES_REAR_BUMPED:
+     	            // The rear bumper was hit, determine if making another pass or parking
+     	            if (Me->ApproachPass == MAX_APPROACH_PASSES)
+     	            {
+     	               printf("\r\nRear bumper hit on last approach. Dump balls.");
+     	               // Approach sequence complete, go park
+     	               NextState = Unloading;// determine what the next state will be
+  	                  MakeTransition = True; // mark that we are making a transition
+  	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+  	                  FanControl(0); // turn off fan
+     	            }
+     	            else
+     	            {
+     	               // Make another pass if we don't see the opposite beacon on the front
+     	               if (GetBeaconFront() != Me->OppositeBin)
+     	               {
+        	               printf("\r\nRear bumper hit on preliminary approach. Make another pass.");
+        	               // Approach sequence is not complete, make another pass
+        	               NextState = DrivingForward_Clearance;// determine what the next state will be
+     	                  MakeTransition = True; // mark that we are making a transition
+     	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	               }
+     	               else
+     	               {
+     	                  // We see the opposite bin in our front beacon, we are aligned
+     	                  printf("\r\nOpposite beacon seen in front on preliminary approach. Dump balls.");
+        	               // Approach sequence complete, go park
+        	               NextState = Unloading;// determine what the next state will be
+     	                  MakeTransition = True; // mark that we are making a transition
+     	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	                  FanControl(0); // turn off fan
+     	               }
+     	            }
+     	         break;
+     	         
+     	         /*
+     	         case ES_BEACON_REAR:
+     	            if (ThisEvent.EventParam == 0)
+     	            {
+     	               printf("\r\nWe lost the rear beacon.");
+     	               // We lost the beacon, let's look for it again
+     	               NextState = AligningRearBeacon; // set next state to looking for rear beacon
+     	               MakeTransition = True; // mark that we are making a transition
+     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+     	            }
+     	         break;
+     	         */
+     	         
+     	      } // End event type switch 
+     	   } // End guard against no event
+  	   break; // End DrivingForward100 State
+  	   
+  	   case Unloading:
+     	   // Execute the during function for aligning rear beacon
+     	   // Entry and exit functions are processed here
+     	   ThisEvent = DuringUnloading(ThisEvent);
+     	   
+     	   // Process events
+     	   // Check if there is an event to respond to
+     	   if (ThisEvent.EventType != ES_NO_EVENT)
+     	   {
+     	      // Switch on event types
+     	      switch(ThisEvent.EventType)
+     	      {
+     	         case ES_TIMEOUT:
+     	            switch (ThisEvent.EventParam)
+     	            {
+     	               
+     	               case MOTION_TIMER:
+        	               printf("\r\nRobot has rammed the bin and door should be open. Start shuffling.");
+           	            // Time to do the shuffle
+           	            NextState = Shuffling;// determine what the next state will be
+                        MakeTransition = True; // mark that we are making a transition
+                        ReturnEvent.EventType = ES_NO_EVENT; // consume the event  
+     	               break;
+     	               
+     	               case UNLOADING_DELAY_TIMER:
+        	               printf("\r\nFans spun down. Start moving forward.");
+        	               // Go forward then back up into the wall to help open the door
+        	               GoForward(100); // move the bot forward
+        	               // Set timer for length of forward pulse
+        	               ES_Timer_InitTimer(AppTimer[UNLOADING_BUMP_TIMER], FORWARD_BUMP_INTERVAL);
+     	               break;
+     	               
+     	               case UNLOADING_BUMP_TIMER:
+     	                  // The bot went far enough forward, now go back.
+     	                  printf("\r\nThe bot has completed forward path, now head back.");
+     	                  GoBackward(100);     	                  
+     	               break;
+     	            } // end time out type switch     	            
+     	         break;
+     	         
+     	         case ES_REAR_BUMPED:
+     	            // The rear bumper has been pressed. Time to stop the bot
+     	            printf("\r\nRear bumped. Stop the bot.");
+     	            FullStop(); // stop the bot
+     	            
+     	            // Set timer for delay from rear ramming to shuffling
+            	   ES_Timer_InitTimer(AppTimer[MOTION_TIMER], UNLOAD_INTERVAL);
+     	         break;
+     	         
+     	      } // End event type switch 
+     	   } // End guard against no event
+  	   break; // End Unloading State
+  	   
+  	   case Shuffling:
+     	   // Execute the during function for aligning rear beacon
+     	   // Entry and exit functions are processed here
+     	   ThisEvent = DuringShuffling(ES_WITH_(Me) ThisEvent);
+     	   
+     	   // Process events
+     	   // Check if there is an event to respond to
+     	   if (ThisEvent.EventType != ES_NO_EVENT)
+     	   {
+     	      // Switch on event types
+     	      switch(ThisEvent.EventType)
+     	      {
+     	         case ES_TIMEOUT:
+     	            // Check if this is a change direction or end shuffle time out
+     	            switch (ThisEvent.EventParam)
+     	            {
+     	               case SHUFFLE_TIMER:
+     	                  printf("\r\nDone shuffling.");
+     	                  // Time to stop shuffling
+     	                  // Create an event to exit the scoring SM
+     	                  ReturnEvent.EventType = ES_BALL_BIN_EMPTY; // signal to the NHSM that we are done               
+     	               break;
+     	               
+     	               case SHUFFLE_STEP_TIMER:
+     	                  printf("\r\nChange shuffle direction.");
+     	                  // Change the direction of the shuffle
+     	                  switch (Me->ShuffleDirection)
+     	                  {
+     	                     case Left:
+     	                        TurnLeft(); // turn left 
+     	                        Me->ShuffleDirection = Right; // update direction for next time
+     	                        printf("\r\nShuffle left.");
+     	                     break;
+     	                     
+     	                     case Right:
+     	                        TurnRight(); // turn right
+     	                        Me->ShuffleDirection = Left; // update direction for next time
+     	                        printf("\r\nShuffle right.");
+     	                     break;
+     	                  }
+     	                  // Set shuffle step timer
+  	                     ES_Timer_InitTimer(AppTimer[SHUFFLE_STEP_TIMER], SHUFFLE_STEP_INTERVAL);
+     	               break;
+     	            }
+     	         break;     	              	         
+     	      } // End event type switch 
+     	   } // End guard against no event
+  	   break; // End Shuffling State
+  	   
+  	   case FindingLeftBeacon:
+         
+         // Execute the during function for FindingLeftBeacon state
+         // Entry and exit functions are processed here
+         ThisEvent = DuringFindingLeftBeacon(ES_WITH_(Me) ThisEvent);
+         
+         // Process events
+         // Check if there is an event to respond to     	            
+         if (ThisEvent.EventType != ES_NO_EVENT)
+         {
+            // Switch on event types
+            switch (ThisEvent.EventType)
+            {
+               case ES_BEACON_FRONT:
+                  if (ThisEvent.EventParam == Me->LeftBin)
+                  {
+                     // We have found the left beacon
+                     NextState = FindingRightBeacon; // set next state to look for right beacon
+                     MakeTransition = True; // indicate that we are making a transition
+                     ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+                  }
+               break;
+            }
+         } // End guard on no event
+      break; // end finding left beacon state
+     	         
+      case FindingRightBeacon:
+         
+         // Execute the during function for FindingLeftBeacon state
+         // Entry and exit functions are processed here
+         ThisEvent = DuringFindingRightBeacon(ES_WITH_(Me) ThisEvent);
+         
+         //Process events
+         // Check if there is an event to respond to     	            
+         if (ThisEvent.EventType != ES_NO_EVENT)
+         {
+            // Switch on event types
+            switch (ThisEvent.EventType)
+            {
+               case ES_BEACON_FRONT:
+                  if (ThisEvent.EventParam == Me->RightBin)
+                  {
+                     // We have found the right beacon
+                     NextState = BisectingAngle; // set next state to look for right beacon
+                     MakeTransition = True; // indicate that we are making a transition
+                     ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+                  }
+               break;     	                  
+            }
+         } // End guard on no event
+      break; // End Finding right beacon state
+      
+      case BisectingAngle:
+         
+         // Execute the during function for FindingLeftBeacon state
+         // Entry and exit functions are processed here
+         ThisEvent = DuringBisectingAngle(ES_WITH_(Me) ThisEvent);
+         
+         //Process events
+         // Check if there is an event to respond to     	            
+         if (ThisEvent.EventType != ES_NO_EVENT)
+         {
+            // Switch on event types
+            switch (ThisEvent.EventType)
+            {
+               case ES_TIMEOUT:
+                  if(ThisEvent.EventParam == MOTION_TIMER)
+                  {
+                     // The bot has rotated back enough to bisect the angle
+                     NextState = DrivingForward_Alignment; // set the next state to forward align
+                     MakeTransition = True; // indicate that we are making a transition
+                     ReturnEvent.EventType = ES_NO_EVENT; // consume the event
+                    
+                    
+                    // March 4th, Hannah 
+                     // Set the timer length based on which pass this is
+     	               if (Me->ApproachPass == (MAX_APPROACH_PASSES-1))
+     	               {
+     	                  // This is the first pass
+     	                  ES_Timer_InitTimer(AppTimer[MOTION_TIMER], FIRST_FWD_ALIGN_INTERVAL);
+     	               }
+     	               else if (Me->ApproachPass == (MAX_APPROACH_PASSES))
+     	               {
+     	                  // This is the second pass
+     	                  ES_Timer_InitTimer(AppTimer[MOTION_TIMER], SECOND_FWD_ALIGN_INTERVAL);
+     	               }
+                     
+                  }
+               break;
+            }
+         } // End guard on no event           
+      break; // end bisecting angle state
+     	         
+  	    
+  	} // End switch on current state
+  	
+  	// If we are making a state transition
+  	if (MakeTransition == True)
+  	{
+  		// Execute exit function for current state
+  		ThisEvent.EventType = ES_EXIT;
+  		RunScoringSM(ES_WITH_(Me) ThisEvent);
+  		
+  		ES_TraceState(LOG_SCORING, Me->CurrentState, NextState);
+  		Me->CurrentState = NextState; // Update state variable
+  		
+  		// Execute entry function for the new state
+  		ThisEvent.EventType = ES_ENTRY;
+  		RunScoringSM(ES_WITH_(Me) ThisEvent);
+  	}
+  	
+  	return ReturnEvent;
+}
+
+/***************************************************************************
+private functions
+***************************************************************************/
+static ES_Event DuringAligningRearBeacon(ES_Event ThisEvent)
+{
+	if (ThisEvent.EventType == ES_ENTRY)
+	{
+	   //printf("\r\n\nENTERING the AligningRearBeacon state.");
+	   // Process ES_ENTRY event
+	   // Turn right while looking for beacons
+	   TurnRight();
+	   
+	   #ifdef BEACON_NOD
+	   // Set timer for opposite swing to get off the current beacon
+	   ES_Timer_InitTimer(AppTimer[BEACON_NOD_TIMER], BEACON_NOD_INTERVAL);
+	   #endif
+
+	}
+	else if (ThisEvent.EventType == ES_EXIT)
+	{
+		//printf("\r\n\nEXITING the AligningRearBeacon state.");
+		// Process exit event
+		// Stop the robot
+		FullStop();
+	}
+	else
+	{
+	   // Perform during functions  
+	   // No during functions for this state
+	}
+	return ThisEvent; // do not remap event   
+}
+
+static ES_Event DuringAligningFrontBeacon(ES_ME_(ScoringSM_t) ES_Event ThisEvent)
+{
+	if (ThisEvent.EventType == ES_ENTRY)
+	{
+	   //printf("\r\n\nENTERING the AligningFrontBeacon state.");
+	   // Process ES_ENTRY event
+      // Turn right while looking for beacons
+	   TurnRight();
+	   
+	   #ifdef BEACON_NOD
+	   // Set timer for opposite swing to get off the current beacon
+	   ES_Timer_InitTimer(AppTimer[BEACON_NOD_TIMER], BEACON_NOD_INTERVAL);
+	   #endif
+	   
+	   #ifdef BACKUP_SEARCH
+	   // Set timer for abandoning the search for the front beacon
+	   ES_Timer_InitTimer(AppTimer[GO_TO_BACKUP_SEARCH_TIMER], GO_TO_BACKUP_SEARCH_INTERVAL);
+	   #endif
+	}
+	else if (ThisEvent.EventType == ES_EXIT)
+	{
+		//printf("\r\n\nEXITING the AligningFrontBeacon state.");
+		// Process exit event
+		// Stop the robot
+		FullStop();
+		Me->ApproachPass++; // increment approach counter
+	}
+	else
+	{
+	   // Perform during functions
+	   // No during functions for this state  
+	}
+	return ThisEvent; // do not remap event   
+}
+
+static ES_Event DuringDrivingForward_Clearance(ES_Event ThisEvent)
+{
+	if (ThisEvent.EventType == ES_ENTRY)
+	{
+	   ES_LogEntry(LOG_SCORING, DrivingForward_Clearance);
+	   // Process ES_ENTRY event
+	   GoForward(100);
+	   
+	   // Set timer for clearance space
+	   ES_Timer_InitTimer(AppTimer[MOTION_TIMER], CLEARANCE_INTERVAL);
+	   printf("\r\nTimer SET for driving forward clearance.");
+
+	}
+	else if (ThisEvent.EventType == ES_EXIT)
+	{
+		ES_LogExit(LOG_SCORING, DrivingForward_Clearance);
+		// Process exit event
+		// Stop the robot
+		FullStop();
+	}
+	else
+	{
+	   // Perform during functions
+	   // No during functions for this state  
+	}
+	return ThisEvent; // do not remap event   
+}
+
+static ES_Event DuringDrivingForward_Alignment(ES_Event ThisEvent)
+{
+	if (ThisEvent.EventType == ES_ENTRY)
+	{
+	   ES_LogEntry(LOG_SCORING, DrivingForward_Alignment);
+	   // Process ES_ENTRY event
+	   GoForward(100);
+	}
+	else if (ThisEvent.EventType == ES_EXIT)
+	{
+		ES_LogExit(LOG_SCORING, DrivingForward_Alignment);
+		// Process exit event
+		// Stop the robot
+		FullStop();
+	}
+	else
+	{
+	   // Perform during functions
+	   // No during functions for this state  
+	}
+	return ThisEvent; // do not remap event   
+}
+
+static ES_Event DuringBackingUp(ES_Event ThisEvent)
+{
+	if (ThisEvent.EventType == ES_ENTRY)
+	{
+	   ES_LogEntry(LOG_SCORING, BackingUp);
+	   // Process ES_ENTRY event
+	   GoBackward(100);
+
+	}
+	else if (ThisEvent.EventType == ES_EXIT)
+	{
+		ES_LogExit(LOG_SCORING, BackingUp);
+		// Process exit event
+		// Stop the robot
+		FullStop();
+	}
+	else
+	{
+	   // Perform during functions
+	   // No during functions for this state  
+	}
+	return ThisEvent; // do not remap event   
+}
+
+static ES_Event DuringUnloading(ES_Event ThisEvent)
+{
+	if (ThisEvent.EventType == ES_ENTRY)
+	{
+	   ES_LogEntry(LOG_SCORING, Unloading);
+	   // Process ES_ENTRY event
+	   // Turn off motors and fans
+	   FullStop();
+	   FanControl(0);
+	   
+	   // Set timer to allow for fan spin down 
+	   ES_Timer_InitTimer(AppTimer[UNLOADING_DELAY_TIMER], FAN_SPIN_DOWN_TIMER);
+	}
+	else if (ThisEvent.EventType == ES_EXIT)
+	{
+		ES_LogExit(LOG_SCORING, Unloading);
+		// Process exit event
+		// No exit functions for this state
+	}
+	else
+	{
+	   // Perform during functions
+	   // No during functions for this state  
+	}
+	return ThisEvent; // do not remap event   
+}
+
+static ES_Event DuringShuffling(ES_ME_(ScoringSM_t) ES_Event ThisEvent)
+{
+	if (ThisEvent.EventType == ES_ENTRY)
+	{
+	   ES_LogEntry(LOG_SCORING, Shuffling);
+	   // Process ES_ENTRY event
+      // Commence shuffling
+      switch (Me->ShuffleDirection)
+      {
+         case Left:
+            TurnLeft(); // turn left 
+            Me->ShuffleDirection = Right; // update direction for next time
+            printf("\r\nShuffle left.");
+         break;
+         
+         case Right:
+            TurnRight(); // turn right
+            Me->ShuffleDirection = Left; // update direction for next time
+            printf("\r\nShuffle right.");
+         break;
+      }
+      
+      // Set shuffle step timer
+      ES_Timer_InitTimer(AppTimer[SHUFFLE_STEP_TIMER], SHUFFLE_STEP_INTERVAL);
+      // Set overall shuffle length timer
+      ES_Timer_InitTimer(AppTimer[SHUFFLE_TIMER], SHUFFLE_INTERVAL);
+      printf("\r\nShuffle timers have been set.");
+	}
+	else if (ThisEvent.EventType == ES_EXIT)
+	{
+		ES_LogExit(LOG_SCORING, Shuffling);
+		// Process exit event
+		// Stop the robot
+		FullStop();
+	}
+	else
+	{
+	   // Perform during functions  
+	}
+	return ThisEvent; // do not remap event   
+}
+
+static ES_Event DuringFindingLeftBeacon(ES_ME_(ScoringSM_t) ES_Event ThisEvent)
+{
+   if (ThisEvent.EventType == ES_ENTRY)
+   {
+      // Process the ES_ENTRY event
+      TurnLeft(); // make the bot spin left, looking for the left beacon
+   }
+   else if (ThisEvent.EventType == ES_EXIT)
+   {
+      // Process the ES_EXIT event
+      Me->TOSA_Left = ES_Timer_GetFineTime(); // get the time when the left bin signal is acquired
+      FullStop(); // stop the bot
+   }
+   else
+   {
+      // Process the during functions
+      // No during functions
+   }
+   return ThisEvent; // do not remap event
+}
+
+static ES_Event DuringFindingRightBeacon(ES_ME_(ScoringSM_t) ES_Event ThisEvent)
+{
+   if (ThisEvent.EventType == ES_ENTRY)
+   {
+      // Process the ES_ENTRY event
+      TurnRight(); // make the bot spin right, looking for the right beacon
+   }
+   else if (ThisEvent.EventType == ES_EXIT)
+   {
+      // Process the ES_EXIT event
+      Me->TOSA_Right = ES_Timer_GetFineTime(); // get the time when the right bin signal is acquired
+      FullStop(); // stop the bot
+   }
+   else
+   {
+      // Process the during functions
+      // No during functions
+   }
+   return ThisEvent; // do not remap event
+}
+
+static ES_Event DuringBisectingAngle(ES_ME_(ScoringSM_t) ES_Event ThisEvent)
+{
+   if (ThisEvent.EventType == ES_ENTRY)
+   {
+      // Process the ES_ENTRY event
+      // calculate the time betwe en the left and right beacons during sweep
+      uint16_t BisectTime =
+              (uint16_t)(((Me->TOSA_Right - Me->TOSA_Left)/2) /
+                         FINE_PER_TIMER_TICK);
+      TurnLeft(); // Spin the bot back to the left
+      
+      // Set the timer to stop at the bisection of the angle
+      ES_Timer_InitTimer(AppTimer[MOTION_TIMER], BisectTime);
+       
+   }
+   else if (ThisEvent.EventType == ES_EXIT)
+   {
+      // Process the ES_EXIT event
+      FullStop(); // stop the bot
+   }
+   else
+   {
+      // Process the during functions
+      // No during functions
+   }
+   return ThisEvent; // do not remap event
+}
+
+unsigned char QueryTargetBin(ES_ME(const ScoringSM_t))
+{
+   return Me->TargetBin;
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,105 @@
+/****************************************************************************
+ Module
+     SimConfig.h
+ Description
+     ES_HOST_CONFIG for the arena simulator, SimMatch. The application's own
+     services, timers, ISR rings, distribution lists and event checkers, as
+     ES_Configure.h has them, with the simulator's event checker in front
+     of the others to move virtual time on.
+ Notes
+     Keep this in step with the application section of ES_Configure.h. The
+     differences are the debugging aids, which change nothing that the
+     machines do and only slow the simulator down: no queue or checker
+     statistics, no deferred log, no trace and no profile. KEY_RING stays,
+     with nothing posting to it, so that ES_Run does not poll the console.
+
+     Built with SIM_RECORD 1 the log is on, at ES_LOG_STATES with ES_RECORD,
+     as the robot has it, for SimMatch -r to write and Replay to read.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:30 adl      FSR_RING, as in ES_Configure.h
+ 10/18/26 16:00 adl      the sensor rings name MasterMachine's service, as
+                         in ES_Configure.h
+ 10/18/26 14:40 adl      no NO_BEACON_RING, as in ES_Configure.h
+ 10/18/26 11:40 adl      SIM_RECORD
+ 10/18/26 08:15 adl      started coding
+*****************************************************************************/
+#ifndef SimConfig_H
+#define SimConfig_H
+
+#define MAX_NUM_SERVICES 8
+#define NUM_SERVICES 2
+#define ES_RUN_BATCH_SIZE 1
+#define ES_QUEUE_STATS 0
+
+#define SERV_0_HEADER "MasterMachine.h"
+#define SERV_0_INIT InitMasterMachine
+#define SERV_0_RUN RunMasterMachine
+#define SERV_0_QUEUE_SIZE 4
+#define SERV_0_QUEUE_POW2 1
+
+#define SERV_1_HEADER "FieldState.h"
+#define SERV_1_INIT InitFieldState
+#define SERV_1_RUN RunFieldState
+#define SERV_1_QUEUE_SIZE 4
+#define SERV_1_QUEUE_POW2 1
+
+#define POST_KEY_FUNC ES_PostAll
+
+#define NUM_DIST_LISTS 2
+#define DIST_LIST0 PostMasterMachine
+#define DIST_LIST1 PostMasterMachine
+
+// SimMatch_CheckEvents ticks the RTI and the arena every pass, the
+// application's checkers follow with their own periods and states
+#define EVENT_CHECK_HEADER "SimMatch.h"
+#define EVENT_CHECK_LIST SimMatch_CheckEvents, Check4Start, Wall_CheckEvents
+#define EVENT_CHECK_PERIODS 0, 30, 50
+#define EVENT_CHECK_STATE_FUNC QueryMasterMachine
+#define EVENT_CHECK_STATES ES_CHECK_ANY_STATE, ES_CHECK_IN(PreGame), \
+                           ES_CHECK_IN(Defending)
+#define ES_CHECK_ROUND_ROBIN 1
+#define ES_CHECK_STATS 0
+
+#define ES_NUM_TIMERS 16
+
+#define NUM_ISR_RINGS 8
+#define ISR_RING_SIZE 4
+#define ISR_RING0_SERVICE 0
+#define ISR_RING1_SERVICE 0
+#define ISR_RING2_SERVICE 0
+#define ISR_RING3_SERVICE 0
+#define ISR_RING4_SERVICE 0
+#define ISR_RING5_SERVICE 0
+#define ISR_RING6_POST_FUNC ES_PostKey
+#define ISR_RING7_SERVICE 1
+#define LEFT_TAPE_RING 0
+#define RIGHT_TAPE_RING 1
+#define FRONT_BUMPER_RING 2
+#define REAR_BUMPER_RING 3
+#define FRONT_BEACON_RING 4
+#define REAR_BEACON_RING 5
+#define KEY_RING 6
+#define FSR_RING 7
+
+#define COALESCE_EVENT_LIST ES_BEACON_FRONT, ES_BEACON_REAR, \
+                            ES_DANGERWALL_RIGHT, ES_DANGERWALL_LEFT, \
+                            ES_NO_DANGERWALL
+
+#if SIM_RECORD
+#define ES_LOG_LEVEL ES_LOG_STATES
+#define ES_RECORD 1
+#else
+#define ES_LOG_LEVEL ES_LOG_OFF
+#endif
+#define ES_LOG_SIZE 128
+#define LOG_MASTER 0
+#define LOG_GATHERING 1
+#define LOG_SCORING 2
+#define LOG_DEFENDING 3
+
+#define ES_TRACE 0
+#define ES_PROFILE 0
+
+#endif /* SimConfig_H */
@@ -0,0 +1,825 @@
+/****************************************************************************
+ Module
+     SimMatch.c
+ Description
+     The arena simulator: plays matches of the robot's own MasterMachine,
+     GatheringSM, ScoringSM and DefendingSM, unchanged, on the robot and
+     field models of RobotSim.c and ArenaSim.c, in virtual time, and reports
+     the spread of the scores, for the robot's settings or for each point
+     of a grid of them.
+ Notes
+     usage: SimMatch [NumMatches [Seed]] [-j Jobs] [-g Name=Values]...
+                     [-l] [-t] [-b] [-v Match] [-r Prefix]
+       -j Jobs         matches at once, 1 a core by default
+       -g Name=Values  sweep one of SimTune.h's names over a list of values
+                       and From:To:Step ranges, such as ANGLE_A=28:36:4 or
+                       PROCEED_TO_SCORING=60s,70s,80s; a value ending in s
+                       is in seconds, others in the firmware's units
+       -l              a line for each match
+       -t              with the tape sensors' interrupts on
+       -b              with TurnRight as MotorDriver.c has it
+       -v Match        with the firmware's output for that match, in the
+                       first configuration
+       -r Prefix       SimMatch_record only: the log of each match of the
+                       first configuration to Prefix<Match>.rec, for Replay
+
+     Each match runs in a process of its own, forked from here, so that it
+     starts from the statics as the program loaded them and whatever a
+     match does cannot leak into the next, nor into a match running at the
+     same time; it ends with its result in its job's slot of memory shared
+     with this process. Up to Jobs matches run at once. Match i is seeded
+     with Seed + i in every configuration, so each configuration meets the
+     same field, robot and start, and a match can be played again, alone,
+     with its seed and the same options.
+
+     A configuration is 1 value from each -g list; this process sets
+     SimTune_Value to it before the fork, and the state machines, built
+     with SIM_TUNE_HEADER, read it in place of the firmware's #defines.
+     With no -g, the configuration is the robot's own.
+
+     Time moves on only when SimMatch_Tick runs: from SimMatch_CheckEvents,
+     first in the event checker list, on each pass of ES_Run that finds no
+     event, and from GetBeaconRear while StartMasterMachine waits for a
+     beacon. Each tick is 1 RTI, then the field, then the robot's ISRs, so
+     that a match takes as long as the CPU needs to run its events and no
+     longer.
+
+     Built with SIM_RECORD (SimMatch_record) the firmware's log is on, as
+     the robot has it, and each tick sends as much of it as the SCI sends
+     in 2 mS at 115.2 kbaud: with -r to the match's file, as a console
+     capture would have it, otherwise nowhere.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 11:45 adl      the log sent at the SCI's rate, -r writes it to a file
+ 10/18/26 10:10 adl      parallel jobs, and grids of SimTune values
+ 10/18/26 09:50 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "TimingConstants.h"
+#include "MasterMachine.h"
+#include "SideID.h"
+#include "ArenaSim.h"
+#include "FSRSim.h"
+#include "RobotSim.h"
+#include "SimTune.h"
+#include "SimMatch.h"
+#include "BenchUtil.h"
+#include "ES_Log.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_MATCHES 1000UL
+#define MAX_JOBS 64
+// the most values for 1 name, and configurations in all
+#define MAX_VALUES 32
+#define MAX_CONFIGS 4096
+// for values given in seconds
+#define TICKS_PER_SECOND (1 _SECONDS_TIMER)
+// a match that takes longer than this, in wall clock seconds, is stuck
+#define WATCHDOG_TIME 10
+// the score histogram's bars, each BAR_WIDTH points wide
+#define NUM_BARS 12
+#define BAR_WIDTH 5
+#define BAR_LENGTH 50
+// scores are unsigned chars
+#define NUM_SCORES 256
+// the log bytes the SCI sends in a tick, 115.2 kbaud for 2 mS
+#define SCI_BYTES_PER_TICK 23
+
+/*---------------------------- Module Types -------------------------------*/
+typedef struct {
+  boolean Done;
+  // left StartMasterMachine's wait for a beacon
+  boolean Identified;
+  // the MasterMachine states it was in, 1 bit each, and the last
+  uint16_t StatesSeen;
+  uint8_t FinalState;
+  unsigned char Side;
+  ArenaResult_t Arena;
+} SimResult_t;
+
+// a match being played
+typedef struct {
+  pid_t Pid;
+  uint32_t Config;
+  uint32_t Match;
+} Job_t;
+
+// a -g name and its values
+typedef struct {
+  SimTune_t Tune;
+  unsigned char NumValues;
+  unsigned int Values[MAX_VALUES];
+} Axis_t;
+
+// the matches of a configuration
+typedef struct {
+  uint32_t Played;
+  uint32_t Failed;
+  uint32_t ScoreTotal;
+  uint32_t Scores[NUM_SCORES];
+  uint32_t NoBeacon;
+  uint32_t WrongSide;
+  uint32_t Reached[GameOver + 1];
+  uint32_t EndedOver;
+} Tally_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static boolean AddAxis( char *Arg );
+static boolean AddValue( Axis_t *pAxis, const char *Text );
+static boolean ParseValue( const char *Text, unsigned int *pValue );
+static void Configure( uint32_t Config );
+static void StartMatch( unsigned char Slot, uint32_t Config, uint32_t Match );
+static void FinishMatch( unsigned char Slot );
+static void PrintMatch( const Job_t *pJob, const SimResult_t *pResult );
+static void ReportOne( const Tally_t *pTally );
+static void ReportGrid( void );
+static void SendLog( unsigned int MaxBytes );
+static unsigned int Percentile( const Tally_t *pTally, unsigned int Percent );
+static unsigned int Percent( const Tally_t *pTally, uint32_t Count );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumMatches = DEFAULT_NUM_MATCHES;
+static uint32_t Seed = 1;
+static unsigned char NumJobs;
+static boolean Lines;
+static uint32_t Watched = 0xFFFFFFFFUL;
+// with -r, where each match's log goes, and in a child its file
+static const char *RecordPrefix;
+static FILE *pRecord;
+
+// the grid
+static Axis_t Axes[NUM_TUNES];
+static unsigned char NumAxes;
+static uint32_t NumConfigs = 1;
+
+// the matches being played, and each one's result, in memory shared with
+// the children; in a child, pResult is its own
+static Job_t Jobs[MAX_JOBS];
+static SimResult_t *pResults;
+static SimResult_t *pResult;
+
+// for each configuration
+static Tally_t *pTallies;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  uint32_t Next = 0;
+  uint32_t Failed = 0;
+  uint32_t Config;
+  uint64_t Start;
+  double Seconds;
+  unsigned char Running = 0;
+  unsigned char Positional = 0;
+  unsigned char Slot;
+  boolean Usage = False;
+  long Cores;
+  pid_t Pid;
+  int Arg;
+
+  Cores = sysconf( _SC_NPROCESSORS_ONLN );
+  NumJobs = (Cores < 1) ? 1 : (Cores > MAX_JOBS) ? MAX_JOBS :
+                                                   (unsigned char)Cores;
+  for ( Arg = 1; (Arg < argc) && (Usage == False); Arg++ ) {
+    if ( strcmp( argv[Arg], "-l" ) == 0 ) {
+      Lines = True;
+    } else if ( strcmp( argv[Arg], "-t" ) == 0 ) {
+      RobotSim_TapeInterrupts = True;
+    } else if ( strcmp( argv[Arg], "-b" ) == 0 ) {
+      RobotSim_TurnRightAsWritten = True;
+    } else if ( (strcmp( argv[Arg], "-v" ) == 0) && (Arg + 1 < argc) ) {
+      Watched = (uint32_t)strtoul( argv[++Arg], NULL, 0 );
+#if ES_RECORD
+    } else if ( (strcmp( argv[Arg], "-r" ) == 0) && (Arg + 1 < argc) ) {
+      RecordPrefix = argv[++Arg];
+#endif
+    } else if ( (strcmp( argv[Arg], "-j" ) == 0) && (Arg + 1 < argc) ) {
+      Cores = strtol( argv[++Arg], NULL, 0 );
+      if ( (Cores < 1) || (Cores > MAX_JOBS) )
+        Usage = True;
+      NumJobs = (unsigned char)Cores;
+    } else if ( (strcmp( argv[Arg], "-g" ) == 0) && (Arg + 1 < argc) ) {
+      if ( AddAxis( argv[++Arg] ) == False )
+        Usage = True;
+    } else if ( (argv[Arg][0] != '-') && (Positional == 0) ) {
+      NumMatches = (uint32_t)strtoul( argv[Arg], NULL, 0 );
+      Positional++;
+    } else if ( (argv[Arg][0] != '-') && (Positional == 1) ) {
+      Seed = (uint32_t)strtoul( argv[Arg], NULL, 0 );
+      Positional++;
+    } else {
+      Usage = True;
+    }
+  }
+  if ( (NumMatches == 0) || (Usage == True) ) {
+    printf( "usage: %s [NumMatches [Seed]] [-j Jobs] [-g Name=Values]... "
+            "[-l] [-t] [-b] [-v Match]%s\n", argv[0],
+            ES_RECORD ? " [-r Prefix]" : "" );
+    return 1;
+  }
+  pResults = mmap( NULL, MAX_JOBS * sizeof(SimResult_t),
+                   PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+  pTallies = calloc( NumConfigs, sizeof(Tally_t) );
+  if ( (pResults == MAP_FAILED) || (pTallies == NULL) ) {
+    perror( "SimMatch" );
+    return 1;
+  }
+
+  Start = Bench_NowNs();
+  while ( (Next < NumConfigs * NumMatches) || (Running != 0) ) {
+    if ( (Next < NumConfigs * NumMatches) && (Running < NumJobs) ) {
+      for ( Slot = 0; Jobs[Slot].Pid != 0; Slot++ )
+        ;
+      StartMatch( Slot, Next / NumMatches, Next % NumMatches );
+      Next++;
+      Running++;
+      continue;
+    }
+    Pid = wait( NULL );
+    if ( Pid < 0 ) {
+      perror( "wait" );
+      return 1;
+    }
+    for ( Slot = 0; (Slot < MAX_JOBS) && (Jobs[Slot].Pid != Pid); Slot++ )
+      ;
+    if ( Slot < MAX_JOBS ) {
+      FinishMatch( Slot );
+      Running--;
+    }
+  }
+  Seconds = (Bench_NowNs() - Start) / 1e9;
+
+  printf( "%lu matches from seed %lu", (unsigned long)NumMatches,
+          (unsigned long)Seed );
+  if ( NumConfigs > 1 )
+    printf( " in each of %lu configurations", (unsigned long)NumConfigs );
+  printf( " in %.2f s, %.0f matches a minute, %u at a time%s%s\n", Seconds,
+          NumConfigs * NumMatches * 60.0 / Seconds, NumJobs,
+          (RobotSim_TapeInterrupts == True) ? ", tape interrupts on" : "",
+          (RobotSim_TurnRightAsWritten == True) ? ", TurnRight as written" :
+                                                  "" );
+  if ( NumConfigs == 1 )
+    ReportOne( &pTallies[0] );
+  else
+    ReportGrid();
+  for ( Config = 0; Config < NumConfigs; Config++ )
+    Failed += pTallies[Config].Failed;
+  if ( Failed != 0 ) {
+    printf( "FAIL: %lu matches did not finish\n", (unsigned long)Failed );
+    return 1;
+  }
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   SimMatch_CheckEvents
+ Parameters
+   None
+ Returns
+   boolean, always False
+ Description
+   the first event checker: each pass of ES_Run that finds no event moves
+   time on a tick
+ Notes
+   ES_Run's first pass means StartMasterMachine has found a beacon, so the
+   wait hook is no longer wanted
+ Author
+   Alex Loo, 10/18/26, 09:55
+****************************************************************************/
+boolean SimMatch_CheckEvents( void )
+{
+  if ( RobotSim_WaitHook != NULL ) {
+    RobotSim_WaitHook = NULL;
+    pResult->Identified = True;
+  }
+  SimMatch_Tick();
+  return False;
+}
+
+/****************************************************************************
+ Function
+   SimMatch_Tick
+ Parameters
+   None
+ Returns
+   None
+ Description
+   1 tick of virtual time: the RTI, the field, and the robot's ISRs. At the
+   end of the match it keeps the result and ends the match's process.
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 09:57
+****************************************************************************/
+void SimMatch_Tick( void )
+{
+  ES_Port_Tick();
+  Arena_Step();
+  RobotSim_Tick();
+  pResult->StatesSeen |= (uint16_t)(1 << QueryMasterMachine());
+  SendLog( SCI_BYTES_PER_TICK );
+  if ( Arena_Over() == True ) {
+    SendLog( ~0U );
+    if ( pRecord != NULL )
+      fclose( pRecord );
+    Arena_Result( &pResult->Arena );
+    pResult->FinalState = (uint8_t)QueryMasterMachine();
+    pResult->Side = ID_QuerySide();
+    pResult->Done = True;
+    fflush( stdout );
+    _exit( 0 );
+  }
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   AddAxis
+ Parameters
+   char * Arg : a -g argument, Name=Values
+ Returns
+   boolean, False if it is not one
+ Description
+   adds a name and its values to the grid
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:12
+****************************************************************************/
+static boolean AddAxis( char *Arg )
+{
+  char *Values = strchr( Arg, '=' );
+  char *Value;
+  Axis_t *pAxis = &Axes[NumAxes];
+  int Tune;
+
+  if ( Values == NULL )
+    return False;
+  *Values++ = '\0';
+  Tune = SimTune_Find( Arg );
+  if ( Tune < 0 ) {
+    printf( "%s cannot be tuned\n", Arg );
+    return False;
+  }
+  pAxis->Tune = (SimTune_t)Tune;
+  pAxis->NumValues = 0;
+  for ( Value = strtok( Values, "," ); Value != NULL;
+        Value = strtok( NULL, "," ) )
+    if ( AddValue( pAxis, Value ) == False )
+      return False;
+  if ( (pAxis->NumValues == 0) ||
+       (NumConfigs * pAxis->NumValues > MAX_CONFIGS) )
+    return False;
+  NumConfigs *= pAxis->NumValues;
+  NumAxes++;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   AddValue
+ Parameters
+   Axis_t * pAxis : the name the value is for
+   const char * Text : a value, or a From:To:Step range
+ Returns
+   boolean, False if it does not read as one, or there are too many
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:14
+****************************************************************************/
+static boolean AddValue( Axis_t *pAxis, const char *Text )
+{
+  const char *Colon = strchr( Text, ':' );
+  char Part[32];
+  unsigned int From;
+  unsigned int To;
+  unsigned int Step;
+
+  if ( Colon == NULL ) {
+    if ( (ParseValue( Text, &From ) == False) ||
+         (pAxis->NumValues >= MAX_VALUES) )
+      return False;
+    pAxis->Values[pAxis->NumValues++] = From;
+    return True;
+  }
+  if ( sscanf( Text, "%31[^:]", Part ) != 1 )
+    return False;
+  if ( ParseValue( Part, &From ) == False )
+    return False;
+  Text = Colon + 1;
+  Colon = strchr( Text, ':' );
+  if ( (Colon == NULL) || (sscanf( Text, "%31[^:]", Part ) != 1) )
+    return False;
+  if ( (ParseValue( Part, &To ) == False) ||
+       (ParseValue( Colon + 1, &Step ) == False) || (Step == 0) )
+    return False;
+  for ( ; From <= To; From += Step ) {
+    if ( pAxis->NumValues >= MAX_VALUES )
+      return False;
+    pAxis->Values[pAxis->NumValues++] = From;
+  }
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ParseValue
+ Parameters
+   const char * Text : a number, or a number of seconds ending in s
+   unsigned int * pValue : where to put it
+ Returns
+   boolean, False if it does not read as one
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:15
+****************************************************************************/
+static boolean ParseValue( const char *Text, unsigned int *pValue )
+{
+  char *End;
+  double Value = strtod( Text, &End );
+
+  if ( (End == Text) || (Value < 0) )
+    return False;
+  if ( *End == 's' ) {
+    Value *= TICKS_PER_SECOND;
+    End++;
+  }
+  if ( (*End != '\0') || (Value > 65535) )
+    return False;
+  *pValue = (unsigned int)(Value + 0.5);
+  return True;
+}
+
+/****************************************************************************
+ Function
+   Configure
+ Parameters
+   uint32_t Config : the configuration, 0 to NumConfigs - 1
+ Returns
+   None
+ Description
+   puts the configuration's values into SimTune_Value, the first -g name
+   changing slowest
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:17
+****************************************************************************/
+static void Configure( uint32_t Config )
+{
+  unsigned char i = NumAxes;
+
+  while ( i-- > 0 ) {
+    SimTune_Value[Axes[i].Tune] = Axes[i].Values[Config % Axes[i].NumValues];
+    Config /= Axes[i].NumValues;
+  }
+}
+
+/****************************************************************************
+ Function
+   StartMatch
+ Parameters
+   unsigned char Slot : the job's slot, free
+   uint32_t Config : the configuration to play
+   uint32_t Match : which match, seeded with Seed + Match
+ Returns
+   None
+ Description
+   plays a match in a child process, which leaves its result in the slot
+ Notes
+   the child ends in SimMatch_Tick; a child that ends any other way, or is
+   stopped by the watchdog, leaves Done False
+ Author
+   Alex Loo, 10/18/26, 10:19
+****************************************************************************/
+static void StartMatch( unsigned char Slot, uint32_t Config, uint32_t Match )
+{
+  char Name[256];
+  pid_t Child;
+  int Null;
+
+  Configure( Config );
+  memset( &pResults[Slot], 0, sizeof(SimResult_t) );
+  fflush( stdout );
+  Child = fork();
+  if ( Child < 0 ) {
+    perror( "fork" );
+    exit( 1 );
+  }
+  if ( Child == 0 ) {
+    pResult = &pResults[Slot];
+    if ( (Config != 0) || (Match != Watched) ) {
+      Null = open( "/dev/null", O_WRONLY );
+      if ( Null >= 0 )
+        dup2( Null, STDOUT_FILENO );
+    }
+    if ( (RecordPrefix != NULL) && (Config == 0) ) {
+      snprintf( Name, sizeof(Name), "%s%lu.rec", RecordPrefix,
+                (unsigned long)Match );
+      pRecord = fopen( Name, "wb" );
+      if ( pRecord == NULL ) {
+        perror( Name );
+        _exit( 2 );
+      }
+    }
+    alarm( WATCHDOG_TIME );
+    Arena_Init( Seed + Match );
+    FSRSim_Init( 0 );
+    RobotSim_WaitHook = SimMatch_Tick;
+    if ( ES_Initialize( ES_Timer_RATE_2MS ) == Success )
+      ES_Run();
+    _exit( 2 );
+  }
+  Jobs[Slot].Pid = Child;
+  Jobs[Slot].Config = Config;
+  Jobs[Slot].Match = Match;
+}
+
+/****************************************************************************
+ Function
+   FinishMatch
+ Parameters
+   unsigned char Slot : the job that has ended
+ Returns
+   None
+ Description
+   counts the match's result into its configuration's, and frees the slot
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:21
+****************************************************************************/
+static void FinishMatch( unsigned char Slot )
+{
+  const SimResult_t *pDone = &pResults[Slot];
+  Tally_t *pTally = &pTallies[Jobs[Slot].Config];
+  unsigned char State;
+
+  pTally->Played++;
+  if ( pDone->Done == False ) {
+    printf( "config %lu match %lu (seed %lu) did not finish\n",
+            (unsigned long)Jobs[Slot].Config, (unsigned long)Jobs[Slot].Match,
+            (unsigned long)(Seed + Jobs[Slot].Match) );
+    pTally->Failed++;
+  } else {
+    // the firmware leaves its last line open
+    if ( (Jobs[Slot].Config == 0) && (Jobs[Slot].Match == Watched) )
+      printf( "\n" );
+    if ( (Lines == True) ||
+         ((Jobs[Slot].Config == 0) && (Jobs[Slot].Match == Watched)) )
+      PrintMatch( &Jobs[Slot], pDone );
+    pTally->ScoreTotal += pDone->Arena.Score;
+    pTally->Scores[pDone->Arena.Score]++;
+    if ( pDone->Identified == False )
+      pTally->NoBeacon++;
+    else if ( pDone->Side != pDone->Arena.Team )
+      pTally->WrongSide++;
+    for ( State = 0; State <= GameOver; State++ )
+      if ( pDone->StatesSeen & (1 << State) )
+        pTally->Reached[State]++;
+    if ( pDone->FinalState == GameOver )
+      pTally->EndedOver++;
+  }
+  Jobs[Slot].Pid = 0;
+}
+
+/****************************************************************************
+ Function
+   PrintMatch
+ Parameters
+   const Job_t * pJob : the match just played
+   const SimResult_t * pResult : and its result
+ Returns
+   None
+ Description
+   a line for the match: the team, the score, the balls, the wall and the
+   states it reached
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:02
+****************************************************************************/
+static void PrintMatch( const Job_t *pJob, const SimResult_t *pResult )
+{
+  if ( NumConfigs > 1 )
+    printf( "config %lu ", (unsigned long)pJob->Config );
+  printf( "match %lu seed %lu: %s, side %s, score %u, collected %u, "
+          "unloaded %u, bins 0x%X, wall %u, states 0x%03X, final %u\n",
+          (unsigned long)pJob->Match, (unsigned long)(Seed + pJob->Match),
+          (pResult->Arena.Team == RED_TEAM) ? "red" : "blue",
+          (pResult->Identified == False) ? "none" :
+          (pResult->Side == RED_TEAM) ? "red" : "blue",
+          pResult->Arena.Score, pResult->Arena.Collected,
+          pResult->Arena.Unloaded, pResult->Arena.OurBins,
+          pResult->Arena.WallAngle, pResult->StatesSeen,
+          pResult->FinalState );
+}
+
+/****************************************************************************
+ Function
+   ReportOne
+ Parameters
+   const Tally_t * pTally : the only configuration
+ Returns
+   None
+ Description
+   the scores in full, with a histogram, and how the matches went
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:23
+****************************************************************************/
+static void ReportOne( const Tally_t *pTally )
+{
+  uint32_t Finished = pTally->Played - pTally->Failed;
+  uint32_t Bars[NUM_BARS] = { 0 };
+  unsigned int Score;
+  unsigned char i;
+
+  if ( Finished == 0 )
+    return;
+  for ( Score = 0; Score < NUM_SCORES; Score++ ) {
+    i = (unsigned char)(Score / BAR_WIDTH);
+    Bars[(i < NUM_BARS) ? i : NUM_BARS - 1] += pTally->Scores[Score];
+  }
+  printf( "score: mean %.2f, min %u, p10 %u, median %u, p90 %u, max %u\n",
+          (double)pTally->ScoreTotal / Finished, Percentile( pTally, 0 ),
+          Percentile( pTally, 10 ), Percentile( pTally, 50 ),
+          Percentile( pTally, 90 ), Percentile( pTally, 100 ) );
+  for ( i = 0; i < NUM_BARS; i++ ) {
+    if ( i < NUM_BARS - 1 )
+      printf( "  %2u-%-3u", i * BAR_WIDTH, i * BAR_WIDTH + BAR_WIDTH - 1 );
+    else
+      printf( "  %2u+   ", i * BAR_WIDTH );
+    printf( "%6lu %s\n", (unsigned long)Bars[i],
+            &"##################################################"
+             [BAR_LENGTH - Bars[i] * BAR_LENGTH / Finished] );
+  }
+  printf( "no beacon %u%%, wrong side %u%%; reached Gathering %u%%, "
+          "Scoring %u%%, Defending %u%%; ended in GameOver %u%%\n",
+          Percent( pTally, pTally->NoBeacon ),
+          Percent( pTally, pTally->WrongSide ),
+          Percent( pTally, pTally->Reached[Gathering] ),
+          Percent( pTally, pTally->Reached[Scoring] ),
+          Percent( pTally, pTally->Reached[Defending] ),
+          Percent( pTally, pTally->EndedOver ) );
+}
+
+/****************************************************************************
+ Function
+   ReportGrid
+ Parameters
+   None
+ Returns
+   None
+ Description
+   a row for each configuration: its values, its scores, and how often it
+   reached Defending; then the configuration with the best mean
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:25
+****************************************************************************/
+static void ReportGrid( void )
+{
+  const Tally_t *pTally;
+  uint32_t Config;
+  uint32_t Best = 0;
+  double Mean;
+  double BestMean = -1;
+  unsigned char i;
+
+  printf( "config" );
+  for ( i = 0; i < NumAxes; i++ )
+    printf( " %*s", (int)strlen( SimTune_Name[Axes[i].Tune] ),
+            SimTune_Name[Axes[i].Tune] );
+  printf( "   mean  p10  p50  p90  max  Def%%\n" );
+  for ( Config = 0; Config < NumConfigs; Config++ ) {
+    pTally = &pTallies[Config];
+    Configure( Config );
+    printf( "%6lu", (unsigned long)Config );
+    for ( i = 0; i < NumAxes; i++ )
+      printf( " %*u", (int)strlen( SimTune_Name[Axes[i].Tune] ),
+              SimTune_Value[Axes[i].Tune] );
+    Mean = (pTally->Played > pTally->Failed) ?
+           (double)pTally->ScoreTotal / (pTally->Played - pTally->Failed) : 0;
+    printf( " %6.2f %4u %4u %4u %4u %4u%s\n", Mean,
+            Percentile( pTally, 10 ), Percentile( pTally, 50 ),
+            Percentile( pTally, 90 ), Percentile( pTally, 100 ),
+            Percent( pTally, pTally->Reached[Defending] ),
+            (pTally->Failed != 0) ? "  (some did not finish)" : "" );
+    if ( Mean > BestMean ) {
+      BestMean = Mean;
+      Best = Config;
+    }
+  }
+  Configure( Best );
+  printf( "best mean %.2f, config %lu:", BestMean, (unsigned long)Best );
+  for ( i = 0; i < NumAxes; i++ )
+    printf( " %s=%u", SimTune_Name[Axes[i].Tune],
+            SimTune_Value[Axes[i].Tune] );
+  printf( "\n" );
+}
+
+/****************************************************************************
+ Function
+   Percentile
+ Parameters
+   const Tally_t * pTally : a configuration
+   unsigned int Percent : 0 to 100
+ Returns
+   unsigned int : the least score that at least Percent % of its matches
+                  are at or under, 0 the lowest score, 100 the highest
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:27
+****************************************************************************/
+static unsigned int Percentile( const Tally_t *pTally, unsigned int Percent )
+{
+  uint32_t Finished = pTally->Played - pTally->Failed;
+  uint32_t Wanted = (uint32_t)(((uint64_t)Finished * Percent + 99) / 100);
+  uint32_t Count = 0;
+  unsigned int Score;
+
+  if ( Wanted == 0 )
+    Wanted = 1;
+  for ( Score = 0; Score < NUM_SCORES - 1; Score++ ) {
+    Count += pTally->Scores[Score];
+    if ( Count >= Wanted )
+      break;
+  }
+  return Score;
+}
+
+/****************************************************************************
+ Function
+   Percent
+ Parameters
+   const Tally_t * pTally : a configuration
+   uint32_t Count : some of its matches
+ Returns
+   unsigned int : as a percentage of its matches that finished
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:03
+****************************************************************************/
+static unsigned int Percent( const Tally_t *pTally, uint32_t Count )
+{
+  uint32_t Finished = pTally->Played - pTally->Failed;
+
+  if ( Finished == 0 )
+    return 0;
+  return (unsigned int)((Count * 100UL + Finished / 2) / Finished);
+}
+
+/****************************************************************************
+ Function
+   SendLog
+ Parameters
+   unsigned int MaxBytes : the most to send
+ Returns
+   None
+ Description
+   does what the SCI0 ISR does with the firmware's log, into the match's
+   -r file if it has one
+ Notes
+   without SIM_RECORD the log is off and there is nothing to send
+ Author
+   Alex Loo, 10/18/26, 11:48
+****************************************************************************/
+static void SendLog( unsigned int MaxBytes )
+{
+  uint8_t Byte;
+
+  while ( (MaxBytes-- > 0) && (ES_Log_NextByte( &Byte ) == True) )
+    if ( pRecord != NULL )
+      fputc( Byte, pRecord );
+}
+/*------------------------------ End of file ------------------------------*/
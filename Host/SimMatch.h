@@ -0,0 +1,24 @@
+/****************************************************************************
+ Module
+     SimMatch.h
+ Description
+     the arena simulator's event checker, for SimConfig.h's
+     EVENT_CHECK_HEADER, with the application's event checkers
+ Notes
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 09:45 adl      started coding
+*****************************************************************************/
+#ifndef SimMatch_H
+#define SimMatch_H
+
+#include "ES_Types.h"
+// Check4Start, Wall_CheckEvents and QueryMasterMachine
+#include "EventCheckersWrapper.h"
+
+boolean SimMatch_CheckEvents( void );
+void SimMatch_Tick( void );
+
+#endif /* SimMatch_H */
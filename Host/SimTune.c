@@ -0,0 +1,61 @@
+/****************************************************************************
+ Module
+     SimTune.c
+ Description
+     The values of the constants that SimMatch sweeps, see SimTune.h
+ Notes
+     Built with SIM_TUNE_DEFAULTS, so that TimingConstants.h and
+     ScoringMode.h give their own values here, and SimTune_Value starts
+     with the robot's settings.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 10:08 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#define SIM_TUNE_DEFAULTS
+#include <string.h>
+#include "ES_Configure.h"
+#include "TimingConstants.h"
+#include "ScoringMode.h"
+#include "SimTune.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define FIRMWARE_VALUES { PROCEED_TO_SCORING, CAUTIONSPEED_INTERVAL, \
+                          TURN_EVADE_INTERVAL, ANGLE_A, ANGLE_B, ANGLE_C, \
+                          ANGLE_D, ANGLE_E, ANGLE_F, ANGLE_G, ANGLE_H }
+
+/*---------------------------- Module Variables ---------------------------*/
+unsigned int SimTune_Value[NUM_TUNES] = FIRMWARE_VALUES;
+const unsigned int SimTune_Default[NUM_TUNES] = FIRMWARE_VALUES;
+const char * const SimTune_Name[NUM_TUNES] = {
+  "PROCEED_TO_SCORING", "CAUTIONSPEED_INTERVAL", "TURN_EVADE_INTERVAL",
+  "ANGLE_A", "ANGLE_B", "ANGLE_C", "ANGLE_D", "ANGLE_E", "ANGLE_F",
+  "ANGLE_G", "ANGLE_H"
+};
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   SimTune_Find
+ Parameters
+   const char * Name : the name of one of the #defines
+ Returns
+   int : its SimTune_t, -1 if it is not one that can be tuned
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 10:09
+****************************************************************************/
+int SimTune_Find( const char *Name )
+{
+  int i;
+
+  for ( i = 0; i < NUM_TUNES; i++ )
+    if ( strcmp( Name, SimTune_Name[i] ) == 0 )
+      return i;
+  return -1;
+}
+/*------------------------------ End of file ------------------------------*/
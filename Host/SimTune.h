@@ -0,0 +1,58 @@
+/****************************************************************************
+ Module
+     SimTune.h
+ Description
+     SIM_TUNE_HEADER for SimMatch: the constants in TimingConstants.h and
+     ScoringMode.h that SimMatch sweeps, as variables
+ Notes
+     Each name below takes the place of the firmware's #define of it, so
+     that the state machines, compiled once, run with whatever values
+     SimMatch puts in SimTune_Value before a match. SimTune.c, which
+     defines SIM_TUNE_DEFAULTS, sees the firmware's own values.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 10:08 adl      started coding
+*****************************************************************************/
+#ifndef SimTune_H
+#define SimTune_H
+
+typedef enum {
+  TUNE_PROCEED_TO_SCORING,
+  TUNE_CAUTIONSPEED_INTERVAL,
+  TUNE_TURN_EVADE_INTERVAL,
+  TUNE_ANGLE_A,
+  TUNE_ANGLE_B,
+  TUNE_ANGLE_C,
+  TUNE_ANGLE_D,
+  TUNE_ANGLE_E,
+  TUNE_ANGLE_F,
+  TUNE_ANGLE_G,
+  TUNE_ANGLE_H,
+  NUM_TUNES
+} SimTune_t;
+
+// the values in use, in the firmware's units: timer ticks for the
+// intervals, degrees for the angles
+extern unsigned int SimTune_Value[NUM_TUNES];
+// the firmware's values, and the names of the #defines
+extern const unsigned int SimTune_Default[NUM_TUNES];
+extern const char * const SimTune_Name[NUM_TUNES];
+
+int SimTune_Find( const char *Name );
+
+#ifndef SIM_TUNE_DEFAULTS
+#define PROCEED_TO_SCORING (SimTune_Value[TUNE_PROCEED_TO_SCORING])
+#define CAUTIONSPEED_INTERVAL (SimTune_Value[TUNE_CAUTIONSPEED_INTERVAL])
+#define TURN_EVADE_INTERVAL (SimTune_Value[TUNE_TURN_EVADE_INTERVAL])
+#define ANGLE_A (SimTune_Value[TUNE_ANGLE_A])
+#define ANGLE_B (SimTune_Value[TUNE_ANGLE_B])
+#define ANGLE_C (SimTune_Value[TUNE_ANGLE_C])
+#define ANGLE_D (SimTune_Value[TUNE_ANGLE_D])
+#define ANGLE_E (SimTune_Value[TUNE_ANGLE_E])
+#define ANGLE_F (SimTune_Value[TUNE_ANGLE_F])
+#define ANGLE_G (SimTune_Value[TUNE_ANGLE_G])
+#define ANGLE_H (SimTune_Value[TUNE_ANGLE_H])
+#endif
+
+#endif /* SimTune_H */
@@ -0,0 +1,129 @@
+/****************************************************************************
+ Module
+     StressConfig.h
+ Description
+     ES_HOST_CONFIG for the host stress tests. 2 services with small queues,
+     so that the ISR rings back up behind them, and 4 ISR rings, 2 feeding
+     each service. Ring 0 names its service, the others post through
+     StressPostLow and StressPostHigh, so both ways of handing on are run.
+ Notes
+     STRESS_RING_SIZE, STRESS_BATCH_SIZE, STRESS_QUEUE_STATS and
+     STRESS_LOG_LEVEL may be set from the command line. TestCoalesce uses it
+     too, for the COALESCE_EVENT_LIST, which the stress tests never post,
+     and TestLog for the log level and the LOG_ sources. STRESS_TRACE turns
+     on the event trace, for TestTrace, and STRESS_PROFILE the dispatch
+     profile, for TestProfile. STRESS_CHECK_SCHEDULE swaps in TestCheckEvents'
+     4 event checkers, with periods and state masks, and counts of their
+     calls; STRESS_CHECK_ROUND_ROBIN then starts each pass after the last
+     checker to find an event.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:00 adl      ring 0 names its service
+ 10/18/26 07:55 adl      STRESS_CHECK_ROUND_ROBIN
+ 10/18/26 07:15 adl      STRESS_CHECK_SCHEDULE
+ 10/18/26 06:33 adl      STRESS_PROFILE
+ 10/18/26 04:38 adl      STRESS_TRACE
+ 10/18/26 01:40 adl      STRESS_LOG_LEVEL, ES_LOG_SIZE and the LOG_ sources
+ 10/17/26 19:30 adl      COALESCE_EVENT_LIST and STRESS_QUEUE_STATS
+ 10/17/26 17:30 adl      STRESS_BATCH_SIZE
+ 10/17/26 16:20 adl      started coding
+*****************************************************************************/
+#ifndef StressConfig_H
+#define StressConfig_H
+
+#ifndef STRESS_RING_SIZE
+#define STRESS_RING_SIZE 8
+#endif
+
+#ifndef STRESS_BATCH_SIZE
+#define STRESS_BATCH_SIZE 1
+#endif
+
+#ifndef STRESS_QUEUE_STATS
+#define STRESS_QUEUE_STATS 0
+#endif
+
+#ifndef STRESS_LOG_LEVEL
+#define STRESS_LOG_LEVEL ES_LOG_EVENTS
+#endif
+
+#ifndef STRESS_TRACE
+#define STRESS_TRACE 0
+#endif
+
+#ifndef STRESS_PROFILE
+#define STRESS_PROFILE 0
+#endif
+
+#ifndef STRESS_CHECK_SCHEDULE
+#define STRESS_CHECK_SCHEDULE 0
+#endif
+
+#ifndef STRESS_CHECK_ROUND_ROBIN
+#define STRESS_CHECK_ROUND_ROBIN 0
+#endif
+
+#define MAX_NUM_SERVICES 8
+#define NUM_SERVICES 2
+#define ES_RUN_BATCH_SIZE STRESS_BATCH_SIZE
+#define ES_QUEUE_STATS STRESS_QUEUE_STATS
+
+#define SERV_0_HEADER "StressServices.h"
+#define SERV_0_INIT StressServiceInit
+#define SERV_0_RUN StressServiceRun
+#define SERV_0_QUEUE_SIZE 4
+#define SERV_0_QUEUE_POW2 1
+
+#define SERV_1_HEADER "StressServices.h"
+#define SERV_1_INIT StressServiceInit
+#define SERV_1_RUN StressServiceRun
+#define SERV_1_QUEUE_SIZE 4
+#define SERV_1_QUEUE_POW2 1
+
+#define POST_KEY_FUNC ES_PostAll
+
+#define NUM_DIST_LISTS 0
+
+#define NUM_ISR_RINGS 4
+#define ISR_RING_SIZE STRESS_RING_SIZE
+#define ISR_RING0_SERVICE 0
+#define ISR_RING1_POST_FUNC StressPostLow
+#define ISR_RING2_POST_FUNC StressPostHigh
+#define ISR_RING3_POST_FUNC StressPostHigh
+
+#define COALESCE_EVENT_LIST ES_BEACON_FRONT, ES_DANGERWALL_RIGHT
+
+#define ES_LOG_LEVEL STRESS_LOG_LEVEL
+#define ES_LOG_SIZE 64
+#define LOG_MASTER 0
+
+#define ES_TRACE STRESS_TRACE
+#define ES_TRACE_SIZE 64
+
+#define ES_PROFILE STRESS_PROFILE
+
+#define EVENT_CHECK_HEADER "StressServices.h"
+#if STRESS_CHECK_SCHEDULE
+#define EVENT_CHECK_LIST StressCheckEvents, StressCheck1, StressCheck2, \
+                         StressCheck3
+#define EVENT_CHECK_PERIODS 1, 3, 7, 20
+#define EVENT_CHECK_STATE_FUNC StressQueryState
+#define EVENT_CHECK_STATES ES_CHECK_ANY_STATE, ES_CHECK_IN(1), \
+                           ES_CHECK_IN(0) | ES_CHECK_IN(2), ES_CHECK_IN(2)
+#define ES_CHECK_ROUND_ROBIN STRESS_CHECK_ROUND_ROBIN
+#define ES_CHECK_STATS 1
+#else
+#define EVENT_CHECK_LIST StressCheckEvents
+#endif
+
+#define TIMER0_RESP_FUNC TIMER_UNUSED
+#define TIMER1_RESP_FUNC TIMER_UNUSED
+#define TIMER2_RESP_FUNC TIMER_UNUSED
+#define TIMER3_RESP_FUNC TIMER_UNUSED
+#define TIMER4_RESP_FUNC TIMER_UNUSED
+#define TIMER5_RESP_FUNC TIMER_UNUSED
+#define TIMER6_RESP_FUNC TIMER_UNUSED
+#define TIMER7_RESP_FUNC TIMER_UNUSED
+
+#endif /* StressConfig_H */
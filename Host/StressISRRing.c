@@ -0,0 +1,284 @@
+/****************************************************************************
+ Module
+     StressISRRing.c
+ Description
+     Host stress test for the ISR rings (ES_ISRRing.c). One thread per ring
+     stands in for that ring's ISR and posts as fast as it can, while the
+     main thread runs the real ES_Run, which empties the rings into 2
+     services with 4 entry queues.
+ Notes
+     usage: StressISRRing [EventsPerRing]
+
+     Each event carries its ring number in the top 2 bits of EventParam and
+     a sequence number in the other 14. A post that finds its ring full is
+     retried until it goes in, so every event must be dispatched exactly
+     once, and in order within its ring. The test fails if any event is
+     lost, repeated, out of order or delivered to the wrong service, or if
+     the ring drop counts do not match the full rings the threads saw.
+
+     Build it with -fsanitize=thread (make StressISRRing_tsan) to have the
+     ring accesses checked for data races as well.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 16:30 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ISRRing.h"
+#include "ES_Port.h"
+#include "StressServices.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_EVENTS_PER_RING 250000UL
+#define RING_SHIFT 14
+#define SEQ_MASK ((1U << RING_SHIFT) - 1)
+// rings 0 and 1 feed service 0, rings 2 and 3 feed service 1
+#define FIRST_HIGH_RING 2
+
+/*---------------------------- Module Functions ---------------------------*/
+static void *ISRThread( void *pArg );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t EventsPerRing = DEFAULT_EVENTS_PER_RING;
+
+// written by the ISR threads
+static uint32_t FullRings[NUM_ISR_RINGS];
+static uint32_t ThreadsDone;
+static uint32_t StartGate;
+
+// written by ES_Run's thread
+static uint32_t Received[NUM_ISR_RINGS];
+static uint32_t TotalReceived;
+static uint32_t OrderErrors;
+static uint32_t RoutingErrors;
+static uint32_t LastProgress;
+static boolean Stalled;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  pthread_t Threads[NUM_ISR_RINGS];
+  uintptr_t Ring;
+  uint64_t Start;
+  uint64_t Elapsed;
+  unsigned long CriticalStart;
+  boolean Passed = True;
+
+  if ( argc > 1 )
+    EventsPerRing = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( EventsPerRing == 0 ) {
+    printf( "usage: %s [EventsPerRing]\n", argv[0] );
+    return 1;
+  }
+  if ( ES_Initialize( ES_Timer_RATE_2MS ) != Success ) {
+    printf( "ES_Initialize failed\n" );
+    return 1;
+  }
+  printf( "ISR rings: %d threads, %lu events each, ring size %d\n",
+          NUM_ISR_RINGS, (unsigned long)EventsPerRing, ISR_RING_SIZE );
+
+  for ( Ring = 0; Ring < NUM_ISR_RINGS; Ring++ ) {
+    if ( pthread_create( &Threads[Ring], NULL, ISRThread, (void *)Ring )
+                                                                     != 0 ) {
+      printf( "could not start thread %lu\n", (unsigned long)Ring );
+      return 1;
+    }
+  }
+  CriticalStart = ES_Port_CriticalCount;
+  Start = Bench_NowNs();
+  __atomic_store_n( &StartGate, 1, __ATOMIC_RELEASE );
+  if ( ES_Run() != FailedRun )
+    printf( "ES_Run returned unexpectedly\n" );
+  Elapsed = Bench_NowNs() - Start;
+  for ( Ring = 0; Ring < NUM_ISR_RINGS; Ring++ )
+    pthread_join( Threads[Ring], NULL );
+
+  printf( "ring   received  full ring  drops\n" );
+  for ( Ring = 0; Ring < NUM_ISR_RINGS; Ring++ ) {
+    printf( "%4lu %10lu %10lu %6u\n", (unsigned long)Ring,
+            (unsigned long)Received[Ring], (unsigned long)FullRings[Ring],
+            ES_ISRRing_QueryDrops( (uint8_t)Ring ) );
+    if ( (Received[Ring] != EventsPerRing) ||
+         (ES_ISRRing_QueryDrops( (uint8_t)Ring ) != (uint16_t)FullRings[Ring]) )
+      Passed = False;
+  }
+  printf( "order errors %lu, routing errors %lu%s\n",
+          (unsigned long)OrderErrors, (unsigned long)RoutingErrors,
+          (Stalled == True) ? ", STALLED" : "" );
+  printf( "%.0f events/s through ES_Run, %.2f critical regions/event "
+          "(all on the ES_Run side)\n",
+          (double)TotalReceived * 1e9 / (double)Elapsed,
+          (double)(ES_Port_CriticalCount - CriticalStart) /
+                                                    (double)TotalReceived );
+  if ( (OrderErrors != 0) || (RoutingErrors != 0) || (Stalled == True) )
+    Passed = False;
+  printf( "%s\n", (Passed == True) ? "PASS" : "FAIL" );
+  return (Passed == True) ? 0 : 1;
+}
+
+/****************************************************************************
+ Function
+   StressServiceInit
+ Parameters
+   uint8_t : the priority of this service
+ Returns
+   boolean, always True
+ Description
+   nothing to set up
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 16:34
+****************************************************************************/
+boolean StressServiceInit( uint8_t Priority )
+{
+  (void)Priority;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   StressServiceRun
+ Parameters
+   ES_Event : the event to process
+ Returns
+   ES_Event, ES_ERROR to stop ES_Run once every event has arrived (or the
+   test has stalled), ES_NO_EVENT otherwise
+ Description
+   checks that the event is the next one in sequence from its ring
+ Notes
+   both services share this run function
+ Author
+   Alex Loo, 10/17/26, 16:38
+****************************************************************************/
+ES_Event StressServiceRun( ES_Event ThisEvent )
+{
+  ES_Event ReturnEvent;
+  uint8_t Ring;
+
+  ReturnEvent.EventType = ES_NO_EVENT;
+  ReturnEvent.EventParam = 0;
+  if ( ThisEvent.EventType == ES_ERROR ) { // posted by a stalled checker
+    ReturnEvent.EventType = ES_ERROR;
+    return ReturnEvent;
+  }
+  Ring = (uint8_t)(ThisEvent.EventParam >> RING_SHIFT);
+  if ( (ThisEvent.EventParam & SEQ_MASK) != (Received[Ring] & SEQ_MASK) )
+    OrderErrors++;
+  Received[Ring]++;
+  TotalReceived++;
+  if ( TotalReceived == EventsPerRing * NUM_ISR_RINGS )
+    ReturnEvent.EventType = ES_ERROR;
+  return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+   StressPostLow, StressPostHigh
+ Parameters
+   ES_Event : the event to post
+ Returns
+   boolean : False if the service's queue was full
+ Description
+   post functions for the rings, check that the event came from a ring
+   that is routed to this service and post it
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 16:41
+****************************************************************************/
+boolean StressPostLow( ES_Event ThisEvent )
+{
+  if ( (ThisEvent.EventParam >> RING_SHIFT) >= FIRST_HIGH_RING )
+    RoutingErrors++;
+  return ES_PostToService( 0, ThisEvent );
+}
+
+boolean StressPostHigh( ES_Event ThisEvent )
+{
+  if ( (ThisEvent.EventParam >> RING_SHIFT) < FIRST_HIGH_RING )
+    RoutingErrors++;
+  return ES_PostToService( 1, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   StressCheckEvents
+ Parameters
+   None
+ Returns
+   boolean : True if it posted the event that stops a stalled test
+ Description
+   ES_Run only gets here with every queue empty and the rings just emptied.
+   Once all the threads have finished, 2 visits in a row with no events
+   dispatched in between mean that some events can never arrive.
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 16:45
+****************************************************************************/
+boolean StressCheckEvents( void )
+{
+  ES_Event ThisEvent;
+
+  if ( __atomic_load_n( &ThreadsDone, __ATOMIC_ACQUIRE ) != NUM_ISR_RINGS ) {
+    LastProgress = TotalReceived;
+    sched_yield(); // nothing to do until the threads post some more
+    return False;
+  }
+  if ( TotalReceived != LastProgress ) {
+    LastProgress = TotalReceived;
+    return False;
+  }
+  Stalled = True;
+  ThisEvent.EventType = ES_ERROR;
+  ThisEvent.EventParam = 0;
+  return ES_PostToService( 0, ThisEvent );
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   ISRThread
+ Parameters
+   void * : the ring number
+ Returns
+   void *, always NULL
+ Description
+   the stand in for 1 ISR, posts EventsPerRing events to its ring, retrying
+   each one until the ring has room for it
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 16:50
+****************************************************************************/
+static void *ISRThread( void *pArg )
+{
+  uint8_t Ring = (uint8_t)(uintptr_t)pArg;
+  ES_Event ThisEvent;
+  uint32_t Seq;
+
+  while ( __atomic_load_n( &StartGate, __ATOMIC_ACQUIRE ) == 0 )
+    sched_yield(); // start together with ES_Run
+  ThisEvent.EventType = ES_TIMEOUT;
+  for ( Seq = 0; Seq < EventsPerRing; Seq++ ) {
+    ThisEvent.EventParam = (uint16_t)(((uint16_t)Ring << RING_SHIFT) |
+                                      (Seq & SEQ_MASK));
+    while ( ES_ISRRing_Post( Ring, ThisEvent ) != True ) {
+      FullRings[Ring]++;
+      sched_yield(); // let ES_Run in, there may be only 1 CPU
+    }
+  }
+  __atomic_add_fetch( &ThreadsDone, 1, __ATOMIC_RELEASE );
+  return NULL;
+}
+/*------------------------------ End of file ------------------------------*/
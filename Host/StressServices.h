@@ -0,0 +1,34 @@
+/****************************************************************************
+ Module
+     StressServices.h
+ Description
+     prototypes for the services, post functions and event checker of the
+     host stress tests. StressConfig.h routes the framework to these.
+ Notes
+
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 07:15 adl      the checkers for STRESS_CHECK_SCHEDULE
+ 10/17/26 16:20 adl      started coding
+*****************************************************************************/
+#ifndef StressServices_H
+#define StressServices_H
+
+#include "ES_Configure.h"
+#include "ES_Types.h"
+#include "ES_Events.h"
+
+boolean StressServiceInit( uint8_t Priority );
+ES_Event StressServiceRun( ES_Event ThisEvent );
+boolean StressPostLow( ES_Event ThisEvent );
+boolean StressPostHigh( ES_Event ThisEvent );
+boolean StressCheckEvents( void );
+#if STRESS_CHECK_SCHEDULE
+boolean StressCheck1( void );
+boolean StressCheck2( void );
+boolean StressCheck3( void );
+uint8_t StressQueryState( void );
+#endif
+
+#endif /* StressServices_H */
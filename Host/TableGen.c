@@ -0,0 +1,639 @@
+/****************************************************************************
+ Module
+     TableGen.c
+ Description
+     Writes a state machine's transition table, <Machine>_Table.h, for
+     ES_StateTable.c, from its declarative description in <Machine>_Spec.h,
+     and checks the description
+ Notes
+     usage: TableGen Machine > Machine_Table.h
+            TableGen              lists the machines
+
+     The specs are compiled in, with the headers that name the states,
+     events and timers, so the compiler checks every name in them and the
+     table gets their values. The functions a spec names are only written
+     into the table by name.
+
+     The checks, any of which stops the table being written:
+       the states must be the values 0 to the number of states - 1, once
+       each, as the dispatch array is indexed by them
+       every state must be reachable from the initial state
+       no row may follow one that takes every event it would (same state
+       and event, no guard, and any parameter or the same one)
+       ES_ENTRY and ES_EXIT are not for rows: they run the states' entry and
+       exit functions
+     What each state passes up, the events and timeouts that the machine
+     handles in some state but not in that one, goes into the table's
+     header comment, so that a change to it shows in a diff.
+
+     The table is written with CRLF line ends, as the firmware's files are.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 13:10 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_Events.h"
+#include "ES_StateTable.h"
+#include "TimingConstants.h"
+#include "GatheringSM.h"
+#include "ScoringSM.h"
+#include "DefendingSM.h"
+#include "GatheringSM_Spec.h"
+#include "ScoringSM_Spec.h"
+#include "DefendingSM_Spec.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// the dispatch array holds 1 + the row index in a uint8_t
+#define MAX_ROWS 254
+#define MAX_STATES 254
+#define MAX_EVENTS 255
+// the most functions a spec can name, and (event, parameter) pairs it takes
+#define MAX_NAMES 128
+#define MAX_KEYS 64
+
+/*---------------------------- Module Types -------------------------------*/
+typedef struct {
+  unsigned int Value;
+  const char *pName;
+  const char *pEntry;
+  const char *pExit;
+} SpecState_t;
+
+typedef struct {
+  unsigned int State;
+  unsigned int Event;
+  unsigned int Param;
+  unsigned int Next;
+  unsigned int Returns;
+  const char *pState;
+  const char *pEvent;
+  const char *pParam;
+  const char *pGuard;
+  const char *pAction;
+  const char *pNext;
+  const char *pReturns;
+} SpecRow_t;
+
+typedef struct {
+  const char *pName;
+  const char *pSource;
+  unsigned int Initial;
+  const SpecState_t *pStates;
+  size_t NumStates;
+  const SpecRow_t *pRows;
+  size_t NumRows;
+} Spec_t;
+
+// an event the machine takes somewhere, with the parameter it takes it
+// with, or ES_ANY_PARAM
+typedef struct {
+  unsigned int Event;
+  unsigned int Param;
+  const char *pEvent;
+  const char *pParam;
+} Key_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static boolean Check( const Spec_t *pSpec );
+static boolean Fail( const Spec_t *pSpec, const char *pFormat, ... );
+static const SpecState_t *FindState( const Spec_t *pSpec, unsigned int Value );
+static void SortRows( const Spec_t *pSpec, const SpecRow_t **ppSorted );
+static void Write( const Spec_t *pSpec );
+static void WritePassedUp( const Spec_t *pSpec );
+static void WriteFunctions( const Spec_t *pSpec );
+static void AddName( const char **ppNames, size_t *pNum, const char *pName );
+static void Line( const char *pFormat, ... );
+
+/*---------------------------- Module Variables ---------------------------*/
+#define SPEC_MACHINE(Source, Initial) #Source, Initial
+#define SPEC_STATE(State, Entry, Exit) { State, #State, #Entry, #Exit },
+#define SPEC_ROW(State, Event, Param, Guard, Action, Next, Returns) \
+  { State, Event, Param, Next, Returns, #State, #Event, #Param, #Guard, \
+    #Action, #Next, #Returns },
+
+static const SpecState_t GatheringStates[] = {
+  GATHERING_SM_STATES(SPEC_STATE)
+};
+static const SpecRow_t GatheringRows[] = {
+  GATHERING_SM_ROWS(SPEC_ROW)
+};
+static const SpecState_t ScoringStates[] = {
+  SCORING_SM_STATES(SPEC_STATE)
+};
+static const SpecRow_t ScoringRows[] = {
+  SCORING_SM_ROWS(SPEC_ROW)
+};
+static const SpecState_t DefendingStates[] = {
+  DEFENDING_SM_STATES(SPEC_STATE)
+};
+static const SpecRow_t DefendingRows[] = {
+  DEFENDING_SM_ROWS(SPEC_ROW)
+};
+
+static const Spec_t Specs[] = {
+  { "GatheringSM", GATHERING_SM_MACHINE(SPEC_MACHINE), GatheringStates,
+    ARRAY_SIZE(GatheringStates), GatheringRows, ARRAY_SIZE(GatheringRows) },
+  { "ScoringSM", SCORING_SM_MACHINE(SPEC_MACHINE), ScoringStates,
+    ARRAY_SIZE(ScoringStates), ScoringRows, ARRAY_SIZE(ScoringRows) },
+  { "DefendingSM", DEFENDING_SM_MACHINE(SPEC_MACHINE), DefendingStates,
+    ARRAY_SIZE(DefendingStates), DefendingRows, ARRAY_SIZE(DefendingRows) }
+};
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  size_t i;
+
+  if ( argc != 2 ) {
+    fprintf( stderr, "usage: %s Machine > Machine_Table.h\nmachines:",
+             argv[0] );
+    for ( i = 0; i < ARRAY_SIZE(Specs); i++ )
+      fprintf( stderr, " %s", Specs[i].pName );
+    fprintf( stderr, "\n" );
+    return 2;
+  }
+  for ( i = 0; i < ARRAY_SIZE(Specs); i++ ) {
+    if ( strcmp( argv[1], Specs[i].pName ) == 0 ) {
+      if ( Check( &Specs[i] ) == False )
+        return 1;
+      Write( &Specs[i] );
+      return 0;
+    }
+  }
+  fprintf( stderr, "%s: no spec for %s\n", argv[0], argv[1] );
+  return 2;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   Check
+ Parameters
+   const Spec_t * pSpec : the machine's spec
+ Returns
+   boolean, False if the table cannot be written, having said why
+ Description
+   the checks in the module notes
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 13:15
+****************************************************************************/
+static boolean Check( const Spec_t *pSpec )
+{
+  boolean Reached[MAX_STATES];
+  const SpecRow_t *pRow;
+  const SpecRow_t *pEarlier;
+  boolean More;
+  boolean Ok;
+  size_t i;
+  size_t j;
+
+  if ( (pSpec->NumStates > MAX_STATES) || (pSpec->NumRows > MAX_ROWS) )
+    return Fail( pSpec, "more than %u states or %u rows", MAX_STATES,
+                 MAX_ROWS );
+  for ( i = 0; i < pSpec->NumStates; i++ ) {
+    if ( pSpec->pStates[i].Value >= pSpec->NumStates )
+      return Fail( pSpec, "state %s is %u, with %u states they must be 0 to "
+                   "%u", pSpec->pStates[i].pName, pSpec->pStates[i].Value,
+                   (unsigned int)pSpec->NumStates,
+                   (unsigned int)pSpec->NumStates - 1 );
+    for ( j = 0; j < i; j++ )
+      if ( pSpec->pStates[j].Value == pSpec->pStates[i].Value )
+        return Fail( pSpec, "%s and %s are the same state",
+                     pSpec->pStates[j].pName, pSpec->pStates[i].pName );
+  }
+  if ( FindState( pSpec, pSpec->Initial ) == NULL )
+    return Fail( pSpec, "the initial state is not one of its states" );
+
+  for ( i = 0; i < pSpec->NumRows; i++ ) {
+    pRow = &pSpec->pRows[i];
+    if ( FindState( pSpec, pRow->State ) == NULL )
+      return Fail( pSpec, "%s is not one of its states", pRow->pState );
+    if ( (pRow->Next != ES_SAME_STATE) &&
+         (FindState( pSpec, pRow->Next ) == NULL) )
+      return Fail( pSpec, "%s is not one of its states", pRow->pNext );
+    if ( (pRow->Event == ES_ENTRY) || (pRow->Event == ES_EXIT) )
+      return Fail( pSpec, "%s %s: entries and exits are the STATE's "
+                   "functions", pRow->pState, pRow->pEvent );
+    if ( (pRow->Event >= MAX_EVENTS) || (pRow->Returns > ES_PASS_EVENT) )
+      return Fail( pSpec, "%s %s: the event types must fit a uint8_t",
+                   pRow->pState, pRow->pEvent );
+    for ( j = 0; j < i; j++ ) {
+      pEarlier = &pSpec->pRows[j];
+      if ( (pEarlier->State == pRow->State) &&
+           (pEarlier->Event == pRow->Event) &&
+           (strcmp( pEarlier->pGuard, "NULL" ) == 0) &&
+           ((pEarlier->Param == ES_ANY_PARAM) ||
+            (pEarlier->Param == pRow->Param)) )
+        return Fail( pSpec, "%s %s %s is never taken, the row for %s before "
+                     "it takes every event it would", pRow->pState,
+                     pRow->pEvent, pRow->pParam, pEarlier->pParam );
+    }
+  }
+
+  // every state reachable from the initial one
+  memset( Reached, 0, sizeof(Reached) );
+  Reached[pSpec->Initial] = True;
+  do {
+    More = False;
+    for ( i = 0; i < pSpec->NumRows; i++ ) {
+      pRow = &pSpec->pRows[i];
+      if ( (Reached[pRow->State] == True) && (pRow->Next != ES_SAME_STATE) &&
+           (Reached[pRow->Next] == False) ) {
+        Reached[pRow->Next] = True;
+        More = True;
+      }
+    }
+  } while ( More == True );
+  // say every one that is not, a missing row can cut off several
+  Ok = True;
+  for ( i = 0; i < pSpec->NumStates; i++ )
+    if ( Reached[pSpec->pStates[i].Value] == False )
+      Ok = Fail( pSpec, "%s cannot be reached from the initial state",
+                   pSpec->pStates[i].pName );
+  return Ok;
+}
+
+/****************************************************************************
+ Function
+   Fail
+ Parameters
+   const Spec_t * pSpec : the machine's spec
+   const char * pFormat, ... : what is wrong, as for printf
+ Returns
+   boolean, False
+ Description
+   says what is wrong with the spec
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 13:16
+****************************************************************************/
+static boolean Fail( const Spec_t *pSpec, const char *pFormat, ... )
+{
+  va_list Args;
+
+  fprintf( stderr, "%s_Spec.h: ", pSpec->pName );
+  va_start( Args, pFormat );
+  vfprintf( stderr, pFormat, Args );
+  va_end( Args );
+  fprintf( stderr, "\n" );
+  return False;
+}
+
+/****************************************************************************
+ Function
+   FindState
+ Parameters
+   const Spec_t * pSpec : the machine's spec
+   unsigned int Value : a state's value
+ Returns
+   const SpecState_t *, the state, or NULL if the spec has none of that
+   value
+ Description
+
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 13:17
+****************************************************************************/
+static const SpecState_t *FindState( const Spec_t *pSpec, unsigned int Value )
+{
+  size_t i;
+
+  for ( i = 0; i < pSpec->NumStates; i++ )
+    if ( pSpec->pStates[i].Value == Value )
+      return &pSpec->pStates[i];
+  return NULL;
+}
+
+/****************************************************************************
+ Function
+   SortRows
+ Parameters
+   const Spec_t * pSpec : the machine's spec
+   const SpecRow_t ** ppSorted : where to put the rows, NumRows of them
+ Returns
+   None
+ Description
+   puts the rows in the table's order: by state, then by event, and in the
+   spec's order for the same state and event
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 13:18
+****************************************************************************/
+static void SortRows( const Spec_t *pSpec, const SpecRow_t **ppSorted )
+{
+  unsigned int State;
+  unsigned int Event;
+  size_t Num = 0;
+  size_t i;
+
+  for ( State = 0; State < pSpec->NumStates; State++ )
+    for ( Event = 0; Event < MAX_EVENTS; Event++ )
+      for ( i = 0; i < pSpec->NumRows; i++ )
+        if ( (pSpec->pRows[i].State == State) &&
+             (pSpec->pRows[i].Event == Event) )
+          ppSorted[Num++] = &pSpec->pRows[i];
+}
+
+/****************************************************************************
+ Function
+   Write
+ Parameters
+   const Spec_t * pSpec : the machine's spec, checked
+ Returns
+   None
+ Description
+   writes <Machine>_Table.h to stdout, and a line about it to stderr
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 13:20
+****************************************************************************/
+static void Write( const Spec_t *pSpec )
+{
+  const SpecRow_t *Sorted[MAX_ROWS];
+  const SpecRow_t *pRow;
+  const SpecState_t *pState;
+  unsigned char Dispatch[MAX_STATES][MAX_EVENTS];
+  unsigned int NumEvents = 0;
+  unsigned int State;
+  unsigned int Event;
+  char Entries[MAX_EVENTS * 4 + 1];
+  size_t i;
+
+  SortRows( pSpec, Sorted );
+  memset( Dispatch, 0, sizeof(Dispatch) );
+  for ( i = pSpec->NumRows; i-- > 0; )
+    Dispatch[Sorted[i]->State][Sorted[i]->Event] = (unsigned char)(i + 1);
+  for ( i = 0; i < pSpec->NumRows; i++ )
+    if ( Sorted[i]->Event >= NumEvents )
+      NumEvents = Sorted[i]->Event + 1;
+
+  Line( "/****************************************************************"
+        "************" );
+  Line( " Module" );
+  Line( "     %s_Table.h", pSpec->pName );
+  Line( " Description" );
+  Line( "     %s's transition table, for ES_StateTable_Run", pSpec->pName );
+  Line( " Notes" );
+  Line( "     Written by Host/TableGen from %s_Spec.h, do not edit. Change the",
+        pSpec->pName );
+  Line( "     spec and run make -C Host tables." );
+  Line( "" );
+  WritePassedUp( pSpec );
+  Line( "*****************************************************************"
+        "************/" );
+  WriteFunctions( pSpec );
+
+  Line( "" );
+  Line( "// the rows, by state and event, in the order they are tried" );
+  Line( "static const ES_StateTableRow_t %s_Rows[%u] = {", pSpec->pName,
+        (unsigned int)pSpec->NumRows );
+  for ( i = 0; i < pSpec->NumRows; i++ ) {
+    pRow = Sorted[i];
+    Line( "   /* %2u %s %s %s */", (unsigned int)i, pRow->pState,
+          pRow->pEvent, pRow->pParam );
+    Line( "   { %s, %s, %s, %s, %s, %u }%s", pRow->pGuard, pRow->pAction,
+          pRow->pParam, pRow->pNext, pRow->pReturns,
+          ((i + 1 == pSpec->NumRows) || (Sorted[i + 1]->State != pRow->State) ||
+           (Sorted[i + 1]->Event != pRow->Event)) ? 1U : 0U,
+          (i + 1 < pSpec->NumRows) ? "," : "" );
+  }
+  Line( "};" );
+
+  Line( "" );
+  Line( "// for each state, 1 + the index of its first row for each event "
+        "type" );
+  Line( "static const uint8_t %s_Dispatch[%u][%u] = {", pSpec->pName,
+        (unsigned int)pSpec->NumStates, NumEvents );
+  for ( State = 0; State < pSpec->NumStates; State++ ) {
+    Entries[0] = '\0';
+    for ( Event = 0; Event < NumEvents; Event++ )
+      sprintf( Entries + strlen( Entries ), "%s%u",
+               (Event == 0) ? "" : ", ", Dispatch[State][Event] );
+    Line( "   /* %s */", FindState( pSpec, State )->pName );
+    Line( "   { %s }%s", Entries,
+          (State + 1 < pSpec->NumStates) ? "," : "" );
+  }
+  Line( "};" );
+
+  Line( "" );
+  Line( "// each state's entry and exit" );
+  Line( "static const ES_StateTableState_t %s_States[%u] = {", pSpec->pName,
+        (unsigned int)pSpec->NumStates );
+  for ( State = 0; State < pSpec->NumStates; State++ ) {
+    pState = FindState( pSpec, State );
+    Line( "   { %s, %s }%s /* %s */", pState->pEntry, pState->pExit,
+          (State + 1 < pSpec->NumStates) ? "," : " ", pState->pName );
+  }
+  Line( "};" );
+
+  Line( "" );
+  Line( "static const ES_StateTable_t %s_Table = {", pSpec->pName );
+  Line( "   &%s_Dispatch[0][0], %s_Rows, %s_States, %u, %s", pSpec->pName,
+        pSpec->pName, pSpec->pName, NumEvents, pSpec->pSource );
+  Line( "};" );
+
+  fprintf( stderr, "%s: %u states, %u rows, %u event types, %u dispatch "
+           "bytes\n", pSpec->pName, (unsigned int)pSpec->NumStates,
+           (unsigned int)pSpec->NumRows, NumEvents,
+           (unsigned int)pSpec->NumStates * NumEvents );
+}
+
+/****************************************************************************
+ Function
+   WritePassedUp
+ Parameters
+   const Spec_t * pSpec : the machine's spec
+ Returns
+   None
+ Description
+   writes, for each state, the events and timeouts that the machine takes
+   in some state but that this one passes up
+ Notes
+   an event that a state takes only if a guard agrees counts as taken
+ Author
+   Alex Loo, 10/18/26, 13:25
+****************************************************************************/
+static void WritePassedUp( const Spec_t *pSpec )
+{
+  Key_t Keys[MAX_KEYS];
+  Key_t Key;
+  const SpecRow_t *pRow;
+  size_t NumKeys = 0;
+  char Text[80];
+  boolean Taken;
+  boolean Any;
+  unsigned int LastEvent = 0;
+  unsigned int State;
+  size_t i;
+  size_t k;
+
+  for ( i = 0; i < pSpec->NumRows; i++ ) {
+    pRow = &pSpec->pRows[i];
+    for ( k = 0; k < NumKeys; k++ )
+      if ( (Keys[k].Event == pRow->Event) && (Keys[k].Param == pRow->Param) )
+        break;
+    if ( (k == NumKeys) && (NumKeys < MAX_KEYS) ) {
+      Keys[NumKeys].Event = pRow->Event;
+      Keys[NumKeys].Param = pRow->Param;
+      Keys[NumKeys].pEvent = pRow->pEvent;
+      Keys[NumKeys].pParam = pRow->pParam;
+      NumKeys++;
+    }
+  }
+  // each event's parameters together, in the order the events first come
+  for ( i = 1; i < NumKeys; i++ ) {
+    for ( k = i; (k > 0) && (Keys[k - 1].Event != Keys[i].Event); k-- )
+      ;
+    if ( k > 0 ) {
+      Key = Keys[i];
+      memmove( &Keys[k + 1], &Keys[k], (i - k) * sizeof(Key_t) );
+      Keys[k] = Key;
+    }
+  }
+
+  Line( "     Passed up, to the machine above, by each state: the events it "
+        "does" );
+  Line( "     not take that the machine takes in another state" );
+  for ( State = 0; State < pSpec->NumStates; State++ ) {
+    Line( "       %s:", FindState( pSpec, State )->pName );
+    Text[0] = '\0';
+    Any = False;
+    for ( k = 0; k < NumKeys; k++ ) {
+      Taken = False;
+      for ( i = 0; i < pSpec->NumRows; i++ ) {
+        pRow = &pSpec->pRows[i];
+        if ( (pRow->State == State) && (pRow->Event == Keys[k].Event) &&
+             ((pRow->Param == ES_ANY_PARAM) ||
+              (Keys[k].Param == ES_ANY_PARAM) ||
+              (pRow->Param == Keys[k].Param)) )
+          Taken = True;
+      }
+      if ( Taken == True )
+        continue;
+      // a line for each event, its timeouts together
+      if ( (Text[0] != '\0') &&
+           ((Keys[k].Event != LastEvent) ||
+            (strlen( Text ) + strlen( Keys[k].pParam ) > 60)) ) {
+        Line( "%s", Text );
+        Text[0] = '\0';
+      }
+      if ( Text[0] == '\0' )
+        sprintf( Text, "         %s", Keys[k].pEvent );
+      if ( Keys[k].Param != ES_ANY_PARAM )
+        sprintf( Text + strlen( Text ), " %s", Keys[k].pParam );
+      LastEvent = Keys[k].Event;
+      Any = True;
+    }
+    if ( Text[0] != '\0' )
+      Line( "%s", Text );
+    if ( Any == False )
+      Line( "         none" );
+  }
+}
+
+/****************************************************************************
+ Function
+   WriteFunctions
+ Parameters
+   const Spec_t * pSpec : the machine's spec
+ Returns
+   None
+ Description
+   writes the declarations of the functions the table names, each once
+ Notes
+   the machine defines them, after including its table
+ Author
+   Alex Loo, 10/18/26, 13:28
+****************************************************************************/
+static void WriteFunctions( const Spec_t *pSpec )
+{
+  const char *Guards[MAX_NAMES];
+  const char *Actions[MAX_NAMES];
+  size_t NumGuards = 0;
+  size_t NumActions = 0;
+  size_t i;
+
+  for ( i = 0; i < pSpec->NumRows; i++ ) {
+    AddName( Guards, &NumGuards, pSpec->pRows[i].pGuard );
+    AddName( Actions, &NumActions, pSpec->pRows[i].pAction );
+  }
+  for ( i = 0; i < pSpec->NumStates; i++ ) {
+    AddName( Actions, &NumActions, pSpec->pStates[i].pEntry );
+    AddName( Actions, &NumActions, pSpec->pStates[i].pExit );
+  }
+  Line( "" );
+  Line( "// the guards, actions, entries and exits, in %s.c", pSpec->pName );
+  for ( i = 0; i < NumGuards; i++ )
+    Line( "static ES_StateTableGuard_t %s;", Guards[i] );
+  for ( i = 0; i < NumActions; i++ )
+    Line( "static ES_StateTableAction_t %s;", Actions[i] );
+}
+
+/****************************************************************************
+ Function
+   AddName
+ Parameters
+   const char ** ppNames : the names so far
+   size_t * pNum : how many there are
+   const char * pName : a function's name, or "NULL"
+ Returns
+   None
+ Description
+   adds the name to the list if it is not NULL and not on it already
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 13:29
+****************************************************************************/
+static void AddName( const char **ppNames, size_t *pNum, const char *pName )
+{
+  size_t i;
+
+  if ( strcmp( pName, "NULL" ) == 0 )
+    return;
+  for ( i = 0; i < *pNum; i++ )
+    if ( strcmp( ppNames[i], pName ) == 0 )
+      return;
+  if ( *pNum < MAX_NAMES )
+    ppNames[(*pNum)++] = pName;
+}
+
+/****************************************************************************
+ Function
+   Line
+ Parameters
+   const char * pFormat, ... : the line, as for printf
+ Returns
+   None
+ Description
+   writes a line of the table, with a CRLF
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 13:30
+****************************************************************************/
+static void Line( const char *pFormat, ... )
+{
+  va_list Args;
+
+  va_start( Args, pFormat );
+  vprintf( pFormat, Args );
+  va_end( Args );
+  printf( "\r\n" );
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,341 @@
+/****************************************************************************
+ Module
+     TestCheckEvents.c
+ Description
+     Host test for the event checker periods, state masks, round robin and
+     counts in ES_CheckEvents.c
+ Notes
+     usage: TestCheckEvents [NumTicks [Seed]]
+
+     Built with STRESS_CHECK_SCHEDULE, so that StressConfig.h lists 4
+     checkers: every tick in any state, every 3 ticks in state 1, every 7
+     ticks in states 0 and 2, and every 20 ticks in state 2. The state moves
+     at random among 0 to 3 (3 wants only the first checker), each tick has
+     1 to 4 passes of ES_CheckUserEvents, and each checker that is called
+     finds an event 1 time in 4, the first 3 times in 4. The checkers called
+     on each pass must be those that a full walk of the list would call: the
+     ones that are due and wanted, in order, up to the first that finds an
+     event. The counts from ES_QueryCheckStats must match the test's own.
+
+     It also reports, for each checker, the most passes in a row that it
+     was due and wanted but not called, because one before it found an
+     event. TestCheckEvents_rr is built with STRESS_CHECK_ROUND_ROBIN, where
+     the walk starts after the last checker to find an event; there that
+     must be fewer passes than there are checkers.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 08:00 adl      round robin and the counts
+ 10/18/26 07:20 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_General.h"
+#include "ES_CheckEvents.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "StressServices.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_TICKS 100000UL
+#define NUM_CHECKERS 4
+#define NUM_STATES 4
+#define MAX_PASSES 4
+// the state changes 1 tick in STATE_CHANGE, a checker finds an event 1
+// call in FIND_ONE, the first checker FIND_BUSY calls in FIND_ONE
+#define STATE_CHANGE 16
+#define FIND_ONE 4
+#define FIND_BUSY 3
+
+/*---------------------------- Module Functions ---------------------------*/
+static boolean Check( uint8_t Which );
+static uint8_t Expected( uint32_t Now, boolean *pFound );
+static void CheckStats( void );
+static uint32_t Random( uint32_t Range );
+
+/*---------------------------- Module Variables ---------------------------*/
+// as EVENT_CHECK_PERIODS and EVENT_CHECK_STATES in StressConfig.h
+static uint16_t const Periods[NUM_CHECKERS] = { 1, 3, 7, 20 };
+static uint8_t const Wanted[NUM_CHECKERS] = { 0x0F, 0x02, 0x05, 0x04 };
+
+static uint32_t NumTicks = DEFAULT_NUM_TICKS;
+static uint32_t Seed = 1;
+static uint32_t Failures;
+
+static uint8_t State;
+// the checkers called this pass, and those that will find an event
+static uint8_t Called;
+static uint8_t Finds;
+static uint32_t Calls[NUM_CHECKERS];
+static uint32_t Fires[NUM_CHECKERS];
+// when the model has each checker next due, and where its walk starts
+static uint32_t ModelDue[NUM_CHECKERS];
+static uint8_t ModelFirst;
+// passes in a row that each checker has been due and wanted but not
+// called, and the most of them
+static uint32_t Skipped[NUM_CHECKERS];
+static uint32_t MaxSkipped[NUM_CHECKERS];
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  uint32_t Tick;
+  uint32_t Passes = 0;
+  uint32_t Now;
+  uint8_t Pass;
+  uint8_t Want;
+  uint8_t i;
+  boolean WantFound;
+  boolean Found;
+
+  if ( argc > 1 )
+    NumTicks = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    Seed = (uint32_t)strtoul( argv[2], NULL, 0 );
+  if ( NumTicks == 0 ) {
+    printf( "usage: %s [NumTicks [Seed]]\n", argv[0] );
+    return 1;
+  }
+
+  ES_Timer_Init( ES_Timer_RATE_2MS );
+  for ( Tick = 0; Tick < NumTicks; Tick++ ) {
+    if ( Random( STATE_CHANGE ) == 0 )
+      State = (uint8_t)Random( NUM_STATES );
+    for ( Pass = 1 + (uint8_t)Random( MAX_PASSES ); Pass != 0; Pass-- ) {
+      Now = ES_Timer_GetTime32();
+      Finds = 0;
+      for ( i = 0; i < NUM_CHECKERS; i++ )
+        if ( Random( FIND_ONE ) < ((i == 0) ? FIND_BUSY : 1) )
+          Finds |= (uint8_t)(1 << i);
+      Want = Expected( Now, &WantFound );
+      Called = 0;
+      Found = ES_CheckUserEvents();
+      if ( (Called != Want) || (Found != WantFound) ) {
+        if ( Failures < 10 )
+          printf( "tick %lu state %u: called 0x%X found %u, expected 0x%X "
+                  "found %u\n", (unsigned long)Now, State, Called, Found,
+                  Want, WantFound );
+        Failures++;
+      }
+      Passes++;
+    }
+    ES_Port_Tick();
+  }
+
+  printf( "%lu passes over %lu ticks, checker calls:", (unsigned long)Passes,
+          (unsigned long)NumTicks );
+  for ( i = 0; i < NUM_CHECKERS; i++ )
+    printf( " %lu", (unsigned long)Calls[i] );
+  printf( " (%lu without periods or states)\n",
+          (unsigned long)(Passes * NUM_CHECKERS) );
+  printf( "most passes in a row due but not called:" );
+  for ( i = 0; i < NUM_CHECKERS; i++ ) {
+    printf( " %lu", (unsigned long)MaxSkipped[i] );
+    if ( (ES_CHECK_ROUND_ROBIN != 0) && (MaxSkipped[i] >= NUM_CHECKERS) )
+      Failures++;
+  }
+  printf( "\n" );
+  CheckStats();
+  if ( Failures != 0 ) {
+    printf( "FAIL: %lu mismatches\n", (unsigned long)Failures );
+    return 1;
+  }
+  printf( "PASS\n" );
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   StressCheckEvents, StressCheck1, StressCheck2, StressCheck3
+ Parameters
+   None
+ Returns
+   boolean, True if the checker is to find an event this pass
+ Description
+   the 4 checkers in EVENT_CHECK_LIST
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 07:22
+****************************************************************************/
+boolean StressCheckEvents( void )
+{
+  return Check( 0 );
+}
+
+boolean StressCheck1( void )
+{
+  return Check( 1 );
+}
+
+boolean StressCheck2( void )
+{
+  return Check( 2 );
+}
+
+boolean StressCheck3( void )
+{
+  return Check( 3 );
+}
+
+/****************************************************************************
+ Function
+   StressQueryState
+ Parameters
+   None
+ Returns
+   uint8_t, the state the test has set
+ Description
+   EVENT_CHECK_STATE_FUNC
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 07:23
+****************************************************************************/
+uint8_t StressQueryState( void )
+{
+  return State;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   Check
+ Parameters
+   uint8_t Which : the checker called
+ Returns
+   boolean, True if it is to find an event this pass
+ Description
+   notes the call; a checker called twice in 1 pass is a failure
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 07:24
+****************************************************************************/
+static boolean Check( uint8_t Which )
+{
+  if ( (Called & (1 << Which)) != 0 ) {
+    printf( "checker %u called twice in a pass\n", Which );
+    Failures++;
+  }
+  Called |= (uint8_t)(1 << Which);
+  Calls[Which]++;
+  if ( (Finds & (1 << Which)) == 0 )
+    return False;
+  Fires[Which]++;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   Expected
+ Parameters
+   uint32_t Now : the tick of this pass
+   boolean * pFound : set to whether a checker will find an event
+ Returns
+   uint8_t, the checkers that this pass should call
+ Description
+   the model: walks every checker, calling the ones due and wanted in the
+   current state until one finds an event, and moves their due times on
+ Notes
+   with round robin the walk starts at ModelFirst and wraps, and the next
+   walk starts after the checker that found an event
+ Author
+   Alex Loo, 10/18/26, 07:26
+****************************************************************************/
+static uint8_t Expected( uint32_t Now, boolean *pFound )
+{
+  uint8_t Want = 0;
+  uint8_t i = (ES_CHECK_ROUND_ROBIN != 0) ? ModelFirst : 0;
+  uint8_t n;
+  boolean Due;
+
+  *pFound = False;
+  for ( n = 0; n < NUM_CHECKERS; n++, i = (uint8_t)((i + 1) % NUM_CHECKERS) ) {
+    Due = ( ((Wanted[i] & (1 << State)) != 0) &&
+            ((int32_t)(Now - ModelDue[i]) >= 0) ) ? True : False;
+    if ( Due == False ) {
+      Skipped[i] = 0;
+    } else if ( *pFound == True ) {
+      if ( ++Skipped[i] > MaxSkipped[i] )
+        MaxSkipped[i] = Skipped[i];
+    } else {
+      Skipped[i] = 0;
+      Want |= (uint8_t)(1 << i);
+      ModelDue[i] = Now + Periods[i];
+      if ( (Finds & (1 << i)) != 0 ) {
+        *pFound = True;
+        ModelFirst = (uint8_t)((i + 1) % NUM_CHECKERS);
+      }
+    }
+  }
+  return Want;
+}
+
+/****************************************************************************
+ Function
+   CheckStats
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the counts from ES_QueryCheckStats must match the test's, there must be
+   none past the last checker, and ES_ClearCheckStats must zero them
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 08:05
+****************************************************************************/
+static void CheckStats( void )
+{
+  ES_CheckStats_t Stats;
+  uint8_t i;
+
+  for ( i = 0; i < NUM_CHECKERS; i++ ) {
+    if ( (ES_QueryCheckStats( i, &Stats ) != True) ||
+         (Stats.Calls != Calls[i]) || (Stats.Fires != Fires[i]) ) {
+      printf( "checker %u: %lu calls %lu events, expected %lu and %lu\n", i,
+              (unsigned long)Stats.Calls, (unsigned long)Stats.Fires,
+              (unsigned long)Calls[i], (unsigned long)Fires[i] );
+      Failures++;
+    }
+  }
+  if ( ES_QueryCheckStats( NUM_CHECKERS, &Stats ) != False ) {
+    printf( "counts for a checker past the end of the list\n" );
+    Failures++;
+  }
+  ES_ClearCheckStats();
+  for ( i = 0; i < NUM_CHECKERS; i++ ) {
+    ES_QueryCheckStats( i, &Stats );
+    if ( (Stats.Calls != 0) || (Stats.Fires != 0) ) {
+      printf( "checker %u: counts not cleared\n", i );
+      Failures++;
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   Random
+ Parameters
+   uint32_t Range : 1 more than the largest number wanted
+ Returns
+   uint32_t, from 0 to Range-1
+ Description
+   a small LCG, so that a run can be repeated from its seed
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 07:28
+****************************************************************************/
+static uint32_t Random( uint32_t Range )
+{
+  Seed = Seed * 1664525UL + 1013904223UL;
+  return (Seed >> 8) % Range;
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,335 @@
+/****************************************************************************
+ Module
+     TestCoalesce.c
+ Description
+     Host test for latest value wins posting (COALESCE_EVENT_LIST in
+     StressConfig.h) in ES_Queue.c
+ Notes
+     usage: TestCoalesce [NumOps [Seed]]
+
+     Runs a fixed case, then NumOps random posts and dequeues on a modulo
+     indexed queue and on a power of 2 queue. Each queue is checked, step by
+     step, against a model of the rule: a latest value wins event takes its
+     pending twin out of the queue and goes in at the end. Every other event
+     gets a sequence number in EventParam, and those must come out in the
+     order they went in, with none lost apart from posts to a full queue.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/17/26 19:35 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Queue.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_OPS 1000000UL
+#define MAX_ENTRIES 8
+#define BATCH_SIZE 3
+
+/*---------------------------- Module Functions ---------------------------*/
+static void TestFixedCase( void );
+static void TestRandom( unsigned char Entries, boolean Pow2 );
+static void InitQueue( unsigned char Entries, boolean Pow2 );
+static void ModelPost( ES_Event ThisEvent );
+static void CheckOut( ES_Event ThisEvent );
+static void Fail( const char *pWhat );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumOps = DEFAULT_NUM_OPS;
+
+static ES_Event Block[ES_QUEUE_BLOCK_SIZE(MAX_ENTRIES)];
+static uint8_t QueueSize;
+
+// the model of the queue, oldest first
+static ES_Event Model[MAX_ENTRIES];
+static uint8_t ModelEntries;
+
+// sequence numbers of the ordinary events
+static uint16_t NextSeq;
+static uint16_t LastSeq;
+static uint32_t Delivered;
+static uint32_t Failures;
+static uint32_t Replaced;
+static uint32_t Dropped;
+
+// the first 2 are latest value wins, the rest are not
+static ES_EventTyp_t const Types[] = { ES_BEACON_FRONT, ES_DANGERWALL_RIGHT,
+                                       ES_TIMEOUT, ES_NEW_KEY, ES_FRONT_BUMPED };
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  if ( argc > 1 )
+    NumOps = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    srand( (unsigned)strtoul( argv[2], NULL, 0 ) );
+  if ( NumOps == 0 ) {
+    printf( "usage: %s [NumOps [Seed]]\n", argv[0] );
+    return 1;
+  }
+
+  TestFixedCase();
+  TestRandom( 5, False );
+  TestRandom( 4, True );
+
+  if ( Failures != 0 ) {
+    printf( "FAIL: %lu mismatches\n", (unsigned long)Failures );
+    return 1;
+  }
+  printf( "PASS\n" );
+  return 0;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   TestFixedCase
+ Parameters
+   None
+ Returns
+   None
+ Description
+   a full queue with a beacon reading in the middle takes a newer reading,
+   which comes out last
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 19:40
+****************************************************************************/
+static void TestFixedCase( void )
+{
+  ES_Event ThisEvent;
+  ES_Event const In[] = { {ES_TIMEOUT, 0}, {ES_BEACON_FRONT, 1},
+                          {ES_NEW_KEY, 2}, {ES_FRONT_BUMPED, 3} };
+  ES_Event const Out[] = { {ES_TIMEOUT, 0}, {ES_NEW_KEY, 2},
+                           {ES_FRONT_BUMPED, 3}, {ES_BEACON_FRONT, 0} };
+  uint8_t i;
+
+  InitQueue( 4, True );
+  for ( i = 0; i < 4; i++ )
+    ES_EnQueueFIFO( Block, In[i] );
+  ThisEvent.EventType = ES_BEACON_FRONT;
+  ThisEvent.EventParam = 0; // beacon lost
+  if ( ES_EnQueueFIFO( Block, ThisEvent ) != True )
+    Fail( "latest reading refused by a full queue" );
+  ThisEvent.EventType = ES_TIMEOUT;
+  if ( ES_EnQueueFIFO( Block, ThisEvent ) != False )
+    Fail( "ordinary event taken by a full queue" );
+  for ( i = 0; i < 4; i++ ) {
+    ES_DeQueue( Block, &ThisEvent );
+    if ( (ThisEvent.EventType != Out[i].EventType) ||
+         (ThisEvent.EventParam != Out[i].EventParam) )
+      Fail( "fixed case out of order" );
+  }
+  if ( ES_IsQueueEmpty( Block ) != True )
+    Fail( "fixed case left events behind" );
+}
+
+/****************************************************************************
+ Function
+   TestRandom
+ Parameters
+   unsigned char Entries : size of the queue
+   boolean Pow2 : True for a mask indexed queue
+ Returns
+   None
+ Description
+   random posts and dequeues (1 at a time and in batches), checking each
+   one against the model
+ Notes
+   posts run a little ahead of dequeues, so the queue spends a good part of
+   the time full
+ Author
+   Alex Loo, 10/17/26, 19:45
+****************************************************************************/
+static void TestRandom( unsigned char Entries, boolean Pow2 )
+{
+  ES_Event ThisEvent;
+  ES_Event Batch[BATCH_SIZE];
+  uint8_t NumLeft;
+  uint8_t NumTaken;
+  uint32_t Op;
+  uint8_t i;
+  int Dice;
+
+  InitQueue( Entries, Pow2 );
+  for ( Op = 0; Op < NumOps; Op++ ) {
+    Dice = rand() % 16;
+    if ( Dice < 9 ) {
+      ThisEvent.EventType = Types[rand() % sizeof(Types)/sizeof(Types[0])];
+      if ( (ThisEvent.EventType == Types[0]) ||
+           (ThisEvent.EventType == Types[1]) )
+        ThisEvent.EventParam = (uint16_t)rand();
+      else
+        ThisEvent.EventParam = NextSeq++;
+      ModelPost( ThisEvent );
+    }else if ( Dice < 14 ) {
+      NumLeft = ES_DeQueue( Block, &ThisEvent );
+      if ( ModelEntries != 0 )
+        CheckOut( ThisEvent );
+      else if ( ThisEvent.EventType != ES_NO_EVENT )
+        Fail( "event from an empty queue" );
+      if ( NumLeft != ModelEntries )
+        Fail( "wrong number of entries left" );
+    }else {
+      NumTaken = ES_DeQueueBatch( Block, Batch, BATCH_SIZE, &NumLeft );
+      if ( NumTaken != ((ModelEntries < BATCH_SIZE) ? ModelEntries
+                                                    : BATCH_SIZE) )
+        Fail( "wrong batch size" );
+      for ( i = 0; i < NumTaken; i++ )
+        CheckOut( Batch[i] );
+      if ( NumLeft != ModelEntries )
+        Fail( "wrong number of entries left" );
+    }
+  }
+  while ( ModelEntries != 0 ) {
+    ES_DeQueue( Block, &ThisEvent );
+    CheckOut( ThisEvent );
+  }
+  if ( (uint16_t)(Delivered + Dropped) != NextSeq )
+    Fail( "ordinary events lost" );
+  printf( "%s queue of %u: %lu ops, %lu replaced, %lu dropped\n",
+          (Pow2 == True) ? "mask" : "modulo", QueueSize,
+          (unsigned long)NumOps, (unsigned long)Replaced,
+          (unsigned long)Dropped );
+}
+
+/****************************************************************************
+ Function
+   InitQueue
+ Parameters
+   unsigned char Entries : size of the queue
+   boolean Pow2 : True for a mask indexed queue
+ Returns
+   None
+ Description
+   sets up the queue under test and empties the model
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 19:48
+****************************************************************************/
+static void InitQueue( unsigned char Entries, boolean Pow2 )
+{
+  unsigned char BlockSize = (unsigned char)ES_QUEUE_BLOCK_SIZE(Entries);
+
+  if ( Pow2 == True )
+    QueueSize = ES_InitQueuePow2( Block, BlockSize );
+  else
+    QueueSize = ES_InitQueue( Block, BlockSize );
+  if ( QueueSize != Entries )
+    Fail( "queue is the wrong size" );
+  ModelEntries = 0;
+  NextSeq = 0;
+  LastSeq = 0xFFFF;
+  Delivered = 0;
+  Replaced = 0;
+  Dropped = 0;
+}
+
+/****************************************************************************
+ Function
+   ModelPost
+ Parameters
+   ES_Event ThisEvent : the event to post
+ Returns
+   None
+ Description
+   posts the event to the queue and to the model, and checks that both
+   took it or both refused it
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 19:52
+****************************************************************************/
+static void ModelPost( ES_Event ThisEvent )
+{
+  boolean Expected = True;
+  boolean Latest;
+  uint8_t i;
+
+  Latest = (ThisEvent.EventType == Types[0]) ||
+           (ThisEvent.EventType == Types[1]);
+  for ( i = 0; (Latest == True) && (i < ModelEntries); i++ ) {
+    if ( Model[i].EventType == ThisEvent.EventType )
+      break;
+  }
+  if ( (Latest == True) && (i < ModelEntries) ) {
+    for ( ; i + 1 < ModelEntries; i++ )
+      Model[i] = Model[i + 1];
+    Model[ModelEntries - 1] = ThisEvent;
+    Replaced++;
+  }else if ( ModelEntries < QueueSize ) {
+    Model[ModelEntries++] = ThisEvent;
+  }else {
+    Expected = False;
+    if ( Latest == False )
+      Dropped++;
+  }
+  if ( ES_EnQueueFIFO( Block, ThisEvent ) != Expected )
+    Fail( "post result differs from the model" );
+}
+
+/****************************************************************************
+ Function
+   CheckOut
+ Parameters
+   ES_Event ThisEvent : an event taken from the queue
+ Returns
+   None
+ Description
+   checks the event against the oldest in the model, and an ordinary event
+   against the next sequence number, then takes it out of the model
+ Notes
+   a dropped ordinary event leaves a gap in the sequence numbers, so they
+   only have to go up
+ Author
+   Alex Loo, 10/17/26, 19:55
+****************************************************************************/
+static void CheckOut( ES_Event ThisEvent )
+{
+  uint8_t i;
+
+  if ( (ModelEntries == 0) ||
+       (ThisEvent.EventType != Model[0].EventType) ||
+       (ThisEvent.EventParam != Model[0].EventParam) )
+    Fail( "event differs from the model" );
+  if ( (ThisEvent.EventType != Types[0]) &&
+       (ThisEvent.EventType != Types[1]) ) {
+    // the sequence numbers wrap, but never get more than a queue apart
+    if ( (uint16_t)(ThisEvent.EventParam - LastSeq - 1) >= 0x8000 )
+      Fail( "ordinary events out of order" );
+    LastSeq = ThisEvent.EventParam;
+    Delivered++;
+  }
+  for ( i = 0; i + 1 < ModelEntries; i++ )
+    Model[i] = Model[i + 1];
+  if ( ModelEntries != 0 )
+    ModelEntries--;
+}
+
+/****************************************************************************
+ Function
+   Fail
+ Parameters
+   const char * pWhat : what went wrong
+ Returns
+   None
+ Description
+   reports the first few failures and counts them all
+ Notes
+
+ Author
+   Alex Loo, 10/17/26, 19:58
+****************************************************************************/
+static void Fail( const char *pWhat )
+{
+  if ( Failures++ < 10 )
+    printf( "FAIL: %s\n", pWhat );
+}
+/*------------------------------ End of file ------------------------------*/
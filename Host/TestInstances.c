@@ -0,0 +1,445 @@
+/****************************************************************************
+ Module
+     TestInstances.c
+ Description
+     Host test for the application's state machines built with
+     ES_INSTANCES: several robots, each a MasterMachine_t with its own
+     sub-machines, run side by side in one program
+ Notes
+     usage: TestInstances [NumEvents [NumRobots [Seed]]]
+
+     Each robot has its own stream of events, drawn at random from those
+     the machines take (no END_GAME_TIMER, so that a robot does not sit in
+     GameOver), and its own field: the side, the wall angle and the bin
+     counts that the stand-ins below report are drawn from the same stream
+     before each event. After each event Wall_CheckEvents is called on the
+     robot in Defending, as ES_CheckUserEvents would, and the event it
+     posts, if any, is run next. Every robot's states after each event are
+     kept.
+
+     Each robot is first run alone, then all of them again, interleaved in
+     a random order. Each robot's states must be the same both times, which
+     they would not be if the machines shared any variable. The robots must
+     also not all have the same states, or the test shows nothing.
+
+     The robot's electronics and the FSR are stand-ins here that answer from
+     the field of the robot being run. The framework's timers are shared,
+     and never run: timeouts come from the event streams.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 11:00 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Timers.h"
+#include "MasterMachine.h"
+#include "DefendingMode.h"
+#include "FieldState.h"
+#include "SideID.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_EVENTS 20000UL
+#define DEFAULT_NUM_ROBOTS 8
+#define MAX_ROBOTS 64
+
+/*---------------------------- Module Types -------------------------------*/
+// what the stand-ins report to the robot being run, and where its
+// streams are
+typedef struct {
+  MasterMachine_t Machine;
+  uint32_t EventSeed;
+  uint32_t Done;
+  unsigned char Side;
+  unsigned int WallAngle;
+  unsigned int BallsInBin[4];
+  uint32_t *pStates;
+} Robot_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void StartRobot( Robot_t *pRobot, uint32_t RobotSeed );
+static void StepRobot( Robot_t *pRobot );
+static void RunEvent( Robot_t *pRobot, ES_Event ThisEvent );
+static uint32_t States( Robot_t *pRobot );
+static uint32_t Random( uint32_t *pSeed, uint32_t Range );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumEvents = DEFAULT_NUM_EVENTS;
+static unsigned int NumRobots = DEFAULT_NUM_ROBOTS;
+static uint32_t Seed = 1;
+
+static Robot_t Robots[MAX_ROBOTS];
+// each robot's states after each event, alone and interleaved
+static uint32_t *pAlone;
+static uint32_t *pTogether;
+
+// the robot being run, whose field the stand-ins report, and the event
+// that Wall_CheckEvents posted
+static Robot_t *pNow;
+static boolean Posted;
+static ES_Event PostedEvent;
+
+// the events that a stream draws from
+static const ES_EventTyp_t Events[] = {
+  ES_GAME_START, ES_TIMEOUT, ES_TIMEOUT, ES_TIMEOUT, ES_LEFT_TAPE_DETECTED,
+  ES_RIGHT_TAPE_DETECTED, ES_FRONT_BUMPED, ES_REAR_BUMPED, ES_BEACON_FRONT,
+  ES_BEACON_REAR, ES_BALL_BIN_EMPTY, ES_DANGERWALL_RIGHT,
+  ES_DANGERWALL_LEFT, ES_NO_DANGERWALL
+};
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  const MasterMachine_t Fresh = MASTER_MACHINE_INIT;
+  uint32_t Failures = 0;
+  uint32_t Differ = 0;
+  uint32_t Left;
+  uint32_t Reached = 0;
+  uint32_t i;
+  unsigned int r;
+  int Console;
+  int Null;
+
+  if ( argc > 1 )
+    NumEvents = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    NumRobots = (unsigned int)strtoul( argv[2], NULL, 0 );
+  if ( argc > 3 )
+    Seed = (uint32_t)strtoul( argv[3], NULL, 0 );
+  if ( (NumEvents == 0) || (NumRobots < 2) || (NumRobots > MAX_ROBOTS) ) {
+    printf( "usage: %s [NumEvents [NumRobots (2 to %u) [Seed]]]\n", argv[0],
+            MAX_ROBOTS );
+    return 1;
+  }
+  pAlone = malloc( sizeof(uint32_t) * NumEvents * NumRobots );
+  pTogether = malloc( sizeof(uint32_t) * NumEvents * NumRobots );
+  if ( (pAlone == NULL) || (pTogether == NULL) ) {
+    printf( "out of memory\n" );
+    return 1;
+  }
+
+  // the machines print as they go, which is of no interest here
+  fflush( stdout );
+  Console = dup( STDOUT_FILENO );
+  Null = open( "/dev/null", O_WRONLY );
+  if ( Null >= 0 )
+    dup2( Null, STDOUT_FILENO );
+
+  // InitMasterMachine takes the timers and starts the drivers, no robot
+  ES_Timer_Init( ES_Timer_RATE_2MS );
+  InitMasterMachine( 0 );
+
+  // each robot alone
+  for ( r = 0; r < NumRobots; r++ ) {
+    Robots[r].Machine = Fresh;
+    Robots[r].pStates = &pAlone[r * NumEvents];
+    StartRobot( &Robots[r], Seed + r );
+    while ( Robots[r].Done < NumEvents )
+      StepRobot( &Robots[r] );
+  }
+
+  // all of them, an event at a time from a robot picked at random
+  for ( r = 0; r < NumRobots; r++ ) {
+    Robots[r].Machine = Fresh;
+    Robots[r].pStates = &pTogether[r * NumEvents];
+    StartRobot( &Robots[r], Seed + r );
+  }
+  for ( Left = NumEvents * NumRobots; Left != 0; Left-- ) {
+    do {
+      r = (unsigned int)Random( &Seed, NumRobots );
+    } while ( Robots[r].Done == NumEvents );
+    StepRobot( &Robots[r] );
+  }
+
+  fflush( stdout );
+  dup2( Console, STDOUT_FILENO );
+
+  for ( r = 0; r < NumRobots; r++ ) {
+    for ( i = 0; i < NumEvents; i++ ) {
+      if ( pAlone[r * NumEvents + i] != pTogether[r * NumEvents + i] ) {
+        printf( "robot %u event %lu: states 0x%08lX, alone 0x%08lX\n", r,
+                (unsigned long)i,
+                (unsigned long)pTogether[r * NumEvents + i],
+                (unsigned long)pAlone[r * NumEvents + i] );
+        Failures++;
+        break;
+      }
+    }
+    for ( i = 0; i < NumEvents; i++ ) {
+      if ( (pAlone[r * NumEvents + i] >> 24) == Defending ) {
+        Reached++;
+        break;
+      }
+    }
+    if ( (r != 0) && (memcmp( &pAlone[r * NumEvents], pAlone,
+                              sizeof(uint32_t) * NumEvents ) != 0) )
+      Differ++;
+  }
+
+  printf( "%u robots, %lu events each: %u reached Defending, %lu not the "
+          "same as robot 0\n", NumRobots, (unsigned long)NumEvents,
+          (unsigned int)Reached, (unsigned long)Differ );
+  if ( Differ == 0 ) {
+    printf( "FAIL: the robots' streams do not tell them apart\n" );
+    return 1;
+  }
+  if ( Failures != 0 ) {
+    printf( "FAIL: %lu robots changed when run together\n",
+            (unsigned long)Failures );
+    return 1;
+  }
+  printf( "PASS\n" );
+  return 0;
+}
+
+/*---------------------------- Stand-ins ----------------------------------*/
+// MotorDriver.h, QuickSense.h, BinControl.h, FSR.h and SideID.h: the
+// robot's electronics do nothing here
+void MotorDriver_Init( void ) {}
+void GoForward( unsigned char Speed ) { (void)Speed; }
+void GoBackward( unsigned char Speed ) { (void)Speed; }
+void TurnLeft( void ) {}
+void TurnLeftSpeedSelect( unsigned char Speed ) { (void)Speed; }
+void TurnRight( void ) {}
+void TurnRightSpeedSelect( unsigned char Speed ) { (void)Speed; }
+void FullStop( void ) {}
+void QS_Initialize( void ) {}
+unsigned char QS_QueryBallCount( void ) { return 0; }
+void InitFan( void ) {}
+void FanControl( char On ) { (void)On; }
+void SPI_Init( void ) {}
+void ID_Initialize( void ) {}
+void ID_IdentifySide( unsigned char Beacon ) { (void)Beacon; }
+void ID_AllLights( void ) {}
+
+// BeaconDetection.h: StartMasterMachine waits for a beacon, here is one
+unsigned char GetBeaconFront( void ) { return BS_BEACON1; }
+unsigned char GetBeaconRear( void ) { return 0; }
+
+/****************************************************************************
+ Function
+   ID_QuerySide
+ Parameters
+   None
+ Returns
+   unsigned char, the side of the robot being run
+ Description
+   SideID.h's, from the robot's field
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:05
+****************************************************************************/
+unsigned char ID_QuerySide( void )
+{
+  return pNow->Side;
+}
+
+/****************************************************************************
+ Function
+   QueryFieldState
+ Parameters
+   FSR_Query_t Query : the answer wanted
+   unsigned int * pValue : where to put the answer
+   uint16_t * pAge : where to put its age, or NULL
+ Returns
+   boolean, True
+ Description
+   FieldState.h's, a fresh answer from the field of the robot being run
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:05
+****************************************************************************/
+boolean QueryFieldState( FSR_Query_t Query, unsigned int *pValue,
+                         uint16_t *pAge )
+{
+  if ( Query == FSR_WALL_ANGLE )
+    *pValue = pNow->WallAngle;
+  else if ( Query >= FSR_BALLS_IN_BIN1 )
+    *pValue = pNow->BallsInBin[Query - FSR_BALLS_IN_BIN1];
+  else
+    *pValue = 1;
+  if ( pAge != NULL )
+    *pAge = 0;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   ES_PostToService
+ Parameters
+   uint8_t Which : the service, 0 for MasterMachine
+   ES_Event ThisEvent : the event
+ Returns
+   boolean, True
+ Description
+   ES_Framework.c's, which keeps the event that Wall_CheckEvents posts to
+   MasterMachine for StepRobot to run
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:05
+****************************************************************************/
+boolean ES_PostToService( uint8_t Which, ES_Event ThisEvent )
+{
+  (void)Which;
+  Posted = True;
+  PostedEvent = ThisEvent;
+  return True;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   StartRobot
+ Parameters
+   Robot_t * pRobot : the robot, with a fresh MasterMachine_t
+   uint32_t RobotSeed : the start of its event stream
+ Returns
+   None
+ Description
+   seeds the robot's stream, draws its side and starts its MasterMachine
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:08
+****************************************************************************/
+static void StartRobot( Robot_t *pRobot, uint32_t RobotSeed )
+{
+  ES_Event ThisEvent;
+
+  pRobot->EventSeed = RobotSeed;
+  pRobot->Done = 0;
+  pRobot->Side = (Random( &pRobot->EventSeed, 2 ) == 0) ? RED_TEAM : BLUE_TEAM;
+  pRobot->WallAngle = 0;
+  memset( pRobot->BallsInBin, 0, sizeof(pRobot->BallsInBin) );
+  pNow = pRobot;
+  ThisEvent.EventType = ES_ENTRY;
+  ThisEvent.EventParam = 0;
+  StartMasterMachine( &pRobot->Machine, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   StepRobot
+ Parameters
+   Robot_t * pRobot : the robot
+ Returns
+   None
+ Description
+   draws the robot's field and next event, runs the event, then
+   Wall_CheckEvents and the event it posts, and keeps the states
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:10
+****************************************************************************/
+static void StepRobot( Robot_t *pRobot )
+{
+  ES_Event ThisEvent;
+  uint32_t *pSeed = &pRobot->EventSeed;
+  uint8_t i;
+
+  pNow = pRobot;
+  pRobot->WallAngle = (unsigned int)Random( pSeed, 360 );
+  for ( i = 0; i < 4; i++ )
+    pRobot->BallsInBin[i] = (unsigned int)Random( pSeed, 8 );
+
+  ThisEvent.EventType = Events[Random( pSeed, ARRAY_SIZE(Events) )];
+  ThisEvent.EventParam = 0;
+  if ( ThisEvent.EventType == ES_TIMEOUT )
+    ThisEvent.EventParam = 1 + (uint16_t)Random( pSeed, NUM_APP_TIMERS - 1 );
+  else if ( (ThisEvent.EventType == ES_BEACON_FRONT) ||
+            (ThisEvent.EventType == ES_BEACON_REAR) )
+    ThisEvent.EventParam = (uint16_t)Random( pSeed, 5 );
+  RunEvent( pRobot, ThisEvent );
+
+  if ( QueryMasterMachine( &pRobot->Machine ) == Defending ) {
+    Posted = False;
+    Wall_CheckEvents( &pRobot->Machine.Defending );
+    if ( Posted == True )
+      RunEvent( pRobot, PostedEvent );
+  }
+  pRobot->pStates[pRobot->Done++] = States( pRobot );
+}
+
+/****************************************************************************
+ Function
+   RunEvent
+ Parameters
+   Robot_t * pRobot : the robot
+   ES_Event ThisEvent : the event
+ Returns
+   None
+ Description
+   runs the event through the robot's MasterMachine
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:12
+****************************************************************************/
+static void RunEvent( Robot_t *pRobot, ES_Event ThisEvent )
+{
+  RunMasterMachine( &pRobot->Machine, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   States
+ Parameters
+   Robot_t * pRobot : the robot
+ Returns
+   uint32_t, its MasterMachine, Gathering, Scoring and Defending states,
+   4 bits each from the top, then the machines' turn directions, then the
+   target bin in the low 4 bits
+ Description
+   what is kept of each robot after each event
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:14
+****************************************************************************/
+static uint32_t States( Robot_t *pRobot )
+{
+  MasterMachine_t *pMachine = &pRobot->Machine;
+
+  return ((uint32_t)QueryMasterMachine( pMachine ) << 24) |
+         ((uint32_t)QueryGatheringSM( &pMachine->Gathering ) << 20) |
+         ((uint32_t)QueryScoringSM( &pMachine->Scoring ) << 16) |
+         ((uint32_t)QueryDefendingSM( &pMachine->Defending ) << 12) |
+         ((uint32_t)pMachine->Gathering.TurnDirection << 10) |
+         ((uint32_t)pMachine->Scoring.ShuffleDirection << 9) |
+         ((uint32_t)pMachine->Defending.TurnDirection << 8) |
+         QueryTargetBin( &pMachine->Scoring );
+}
+
+/****************************************************************************
+ Function
+   Random
+ Parameters
+   uint32_t * pSeed : the stream
+   uint32_t Range : 1 more than the largest number wanted
+ Returns
+   uint32_t, from 0 to Range-1
+ Description
+   a small LCG, so that a run can be repeated from its seed
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 11:15
+****************************************************************************/
+static uint32_t Random( uint32_t *pSeed, uint32_t Range )
+{
+  *pSeed = *pSeed * 1664525UL + 1013904223UL;
+  return (*pSeed >> 8) % Range;
+}
+/*------------------------------ End of file ------------------------------*/
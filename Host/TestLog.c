@@ -0,0 +1,330 @@
+/****************************************************************************
+ Module
+     TestLog.c
+ Description
+     Host test for the deferred log, ES_Log.c
+ Notes
+     usage: TestLog [NumOps [Seed]]
+
+     Writes records with the ES_Log* macros, at random, while a stand-in for
+     the SCI0 transmit interrupt takes random numbers of bytes from
+     ES_Log_NextByte in between, so the
+     log runs from empty to full and back. Every byte sent is decoded and
+     each record checked against a model of what went in: the sync byte,
+     the check, and the time, source, state, code and param, in order, with
+     none lost other than those ES_Log_QueryDrops counts. ES_Log_InRecord
+     must be True exactly when the decoder is part way through a record, and
+     the interrupt must be off once the log is empty.
+
+     The macros below ES_LOG_LEVEL must write nothing: TestLog is built at
+     ES_LOG_EVENTS, TestLog_states at ES_LOG_STATES, where ES_LogEvent
+     compiles out. It also reports the cost of logging 1 event and sending it.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 03:10 adl      ES_Log_NextByte, the SCI0 transmit interrupt
+ 10/18/26 01:40 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "ES_Log.h"
+#include "BenchUtil.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_OPS 1000000UL
+// more than the log holds, so the model can never overflow
+#define MODEL_SIZE 64
+#define NUM_TIMED 100000UL
+
+/*------------------------------ Module Types -----------------------------*/
+typedef struct {
+  uint16_t Time;
+  uint8_t Kind;
+  uint8_t Source;
+  uint8_t State;
+  uint8_t Code;
+  uint16_t Param;
+} Record_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void WriteOne( void );
+static void SendSome( unsigned int NumBytes );
+static void TxISR( void );
+static void TakeByte( unsigned char Byte );
+static void Fail( const char *pWhat );
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumOps = DEFAULT_NUM_OPS;
+
+// the records written and not yet decoded, oldest first
+static Record_t Model[MODEL_SIZE];
+static uint8_t ModelHead;
+static uint8_t ModelTail;
+
+// the decoder
+static uint8_t Bytes[ES_LOG_RECORD_SIZE];
+static uint8_t Place;
+static boolean Decoding = True;
+
+static uint32_t Written;
+static uint32_t Decoded;
+static uint32_t Skipped;
+static uint32_t Failures;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  uint64_t Start;
+  uint32_t i;
+  uint16_t Drops;
+  ES_Event ThisEvent;
+
+  if ( argc > 1 )
+    NumOps = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( argc > 2 )
+    srand( (unsigned)strtoul( argv[2], NULL, 0 ) );
+  if ( NumOps == 0 ) {
+    printf( "usage: %s [NumOps [Seed]]\n", argv[0] );
+    return 1;
+  }
+
+  ES_Timer_Init( ES_Timer_RATE_2MS );
+  ES_Log_Init();
+  for ( i = 0; i < NumOps; i++ ) {
+    switch ( rand() % 4 ) {
+      case 0:
+        ES_Port_Tick();
+        break;
+      case 1:
+        SendSome( (unsigned int)(rand() % 24) );
+        break;
+      default:
+        WriteOne();
+        break;
+    }
+  }
+  SendSome( ES_LOG_SIZE + 1 );
+  if ( ModelHead != ModelTail )
+    Fail( "records written and never sent" );
+  if ( ES_Port_SCI0TxOn != 0 )
+    Fail( "transmit interrupt left on with the log empty" );
+  Drops = ES_Log_QueryDrops();
+  if ( (uint16_t)(Written - Decoded) != Drops )
+    Fail( "records lost and not counted" );
+  printf( "log level %d, %d bytes: %lu records sent, %u dropped, "
+          "%lu compiled out\n", ES_LOG_LEVEL, ES_LOG_SIZE,
+          (unsigned long)Decoded, Drops, (unsigned long)Skipped );
+
+  // the cost of 1 event, logged and then sent byte by byte
+  Decoding = False;
+  ThisEvent.EventType = ES_TIMEOUT;
+  ThisEvent.EventParam = 0;
+  Start = Bench_Cycles();
+  for ( i = 0; i < NUM_TIMED; i++ ) {
+    ES_LogEvent( LOG_MASTER, 1, ThisEvent );
+    while ( ES_Port_SCI0TxOn != 0 )
+      TxISR();
+  }
+  printf( "ES_LogEvent and its ISR calls: %.1f %s per event\n",
+          (double)(Bench_Cycles() - Start) / NUM_TIMED, Bench_CycleUnits() );
+
+  if ( Failures != 0 ) {
+    printf( "FAIL: %lu mismatches\n", (unsigned long)Failures );
+    return 1;
+  }
+  printf( "PASS\n" );
+  return 0;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   WriteOne
+ Parameters
+   None
+ Returns
+   None
+ Description
+   writes 1 random record with one of the macros and adds it to the model,
+   unless the log dropped it or the macro is compiled out
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 01:45
+****************************************************************************/
+static void WriteOne( void )
+{
+  Record_t New;
+  ES_Event ThisEvent;
+  uint16_t DropsBefore = ES_Log_QueryDrops();
+  boolean Kept = True;
+
+  New.Time = ES_Timer_GetTime();
+  New.Source = (uint8_t)(rand() % 4);
+  New.State = (uint8_t)rand();
+  New.Code = 0;
+  New.Param = 0;
+  switch ( rand() % 4 ) {
+    case 0:
+      New.Kind = ES_LOG_KIND_NOTE;
+      New.State = 0;
+      New.Code = (uint8_t)rand();
+      New.Param = (uint16_t)rand();
+      ES_LogNote( New.Source, New.Code, New.Param );
+      break;
+    case 1:
+      New.Kind = ES_LOG_KIND_ENTRY;
+      New.Code = ES_ENTRY;
+      ES_LogEntry( New.Source, New.State );
+      break;
+    case 2:
+      New.Kind = ES_LOG_KIND_EXIT;
+      New.Code = ES_EXIT;
+      ES_LogExit( New.Source, New.State );
+      break;
+    default:
+      New.Kind = ES_LOG_KIND_EVENT;
+      ThisEvent.EventType = (ES_EventTyp_t)(rand() % (ES_FSR_ERROR + 1));
+      ThisEvent.EventParam = (uint16_t)rand();
+      New.Code = (uint8_t)ThisEvent.EventType;
+      New.Param = ThisEvent.EventParam;
+      ES_LogEvent( New.Source, New.State, ThisEvent );
+#if ES_LOG_LEVEL < ES_LOG_EVENTS
+      Kept = False;
+#endif
+      break;
+  }
+  if ( Kept == False ) {
+    Skipped++;
+    return;
+  }
+  Written++;
+  if ( ES_Log_QueryDrops() != DropsBefore )
+    return;
+  Model[ModelHead++ % MODEL_SIZE] = New;
+  // the log's whole records, and 1 part way out
+  if ( (uint8_t)(ModelHead - ModelTail) >
+       ES_LOG_SIZE / ES_LOG_RECORD_SIZE + 1 )
+    Fail( "log took more records than it has room for" );
+}
+
+/****************************************************************************
+ Function
+   SendSome
+ Parameters
+   unsigned int NumBytes : how many transmit interrupts to run
+ Returns
+   None
+ Description
+   runs the transmit ISR while its interrupt is on, up to NumBytes times,
+   checking ES_Log_InRecord after each
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 01:48
+****************************************************************************/
+static void SendSome( unsigned int NumBytes )
+{
+  while ( (NumBytes-- != 0) && (ES_Port_SCI0TxOn != 0) ) {
+    TxISR();
+    if ( ES_Log_InRecord() != ((Place != 0) ? True : False) )
+      Fail( "ES_Log_InRecord wrong" );
+  }
+}
+
+/****************************************************************************
+ Function
+   TxISR
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the log's part of the SCI0 transmit interrupt in termio.c: sends the
+   log's next byte, or turns the interrupt off once the log is empty
+ Notes
+   during the timing, with no decoder, the bytes are thrown away
+ Author
+   Alex Loo, 10/18/26, 03:12
+****************************************************************************/
+static void TxISR( void )
+{
+  uint8_t Byte;
+
+  if ( ES_Log_NextByte( &Byte ) == False )
+    ES_Port_StopSCI0Tx();
+  else if ( Decoding == True )
+    TakeByte( Byte );
+}
+
+/****************************************************************************
+ Function
+   TakeByte
+ Parameters
+   unsigned char Byte : a byte sent
+ Returns
+   None
+ Description
+   the decoder: collects a record and checks it against the model
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 01:52
+****************************************************************************/
+static void TakeByte( unsigned char Byte )
+{
+  Record_t *pWant;
+  uint8_t Check = 0;
+  uint8_t i;
+
+  if ( (Place == 0) && (Byte != ES_LOG_SYNC) ) {
+    Fail( "record without its sync byte" );
+    return;
+  }
+  Bytes[Place++] = Byte;
+  if ( Place < ES_LOG_RECORD_SIZE )
+    return;
+  Place = 0;
+  for ( i = 1; i < ES_LOG_RECORD_SIZE; i++ )
+    Check += Bytes[i];
+  if ( Check != 0 )
+    Fail( "bad check byte" );
+  if ( ModelHead == ModelTail ) {
+    Fail( "record sent that was never written" );
+    return;
+  }
+  pWant = &Model[ModelTail++ % MODEL_SIZE];
+  if ( (((uint16_t)Bytes[1] << 8 | Bytes[2]) != pWant->Time) ||
+       (Bytes[3] != pWant->Kind) || (Bytes[4] != pWant->Source) ||
+       (Bytes[5] != pWant->State) || (Bytes[6] != pWant->Code) ||
+       (((uint16_t)Bytes[7] << 8 | Bytes[8]) != pWant->Param) )
+    Fail( "record differs from what was written" );
+  Decoded++;
+}
+
+/****************************************************************************
+ Function
+   Fail
+ Parameters
+   const char * pWhat : what went wrong
+ Returns
+   None
+ Description
+   counts a failure, printing the first few
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 01:55
+****************************************************************************/
+static void Fail( const char *pWhat )
+{
+  if ( Failures++ < 10 )
+    printf( "after %lu records: %s\n", (unsigned long)Decoded, pWhat );
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,530 @@
+/****************************************************************************
+ Module
+     TestProfile.c
+ Description
+     Host test for the dispatch profile, ES_Profile.c, through the real
+     ES_Run
+ Notes
+     usage: TestProfile [NumPosts]
+
+     The event checker posts bursts of events, of several types, to 2
+     services, with the fine timebase moved on a random amount between the
+     posts; each run moves it on a random amount too, sometimes far enough
+     to reach the last histogram bin. The test keeps its own figures from
+     the post times and run times it chose, and the profile must match them
+     exactly: count, min, max and total of the run time and of the wait for
+     each service and each event type, and each service's histograms.
+     ES_BEACON_FRONT is coalesced (StressConfig.h), so its wait runs from
+     its latest post.
+
+     TestProfile_batch is the same with ES_Run taking 4 events at a time.
+     Service 0 posts to service 1 now and then, so that service 1 runs in
+     the middle of service 0's batches.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 06:35 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "ES_Profile.h"
+#include "StressServices.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_NUM_POSTS 20000UL
+#define MAX_POSTS 65535UL
+#define MAX_BURST 6
+// most of the waits and runs are short, 1 in LONG_ONE is long
+#define SHORT_COUNTS 2000
+#define LONG_COUNTS 400000UL
+#define LONG_ONE 16
+
+/*------------------------------ Module Types -----------------------------*/
+// the test's own figures, in the same form as ES_ProfileStat_t
+typedef struct {
+  uint32_t Count;
+  uint32_t Min;
+  uint32_t Max;
+  uint64_t Total;
+} Stat_t;
+
+typedef struct {
+  Stat_t Run;
+  Stat_t Wait;
+  uint32_t RunBins[ES_PROFILE_BINS];
+  uint32_t WaitBins[ES_PROFILE_BINS];
+} Model_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static boolean Post( uint8_t Service, ES_EventTyp_t EventType );
+static void Elapse( uint32_t Counts );
+static uint32_t Random( uint32_t Range );
+static uint32_t RandomTime( void );
+static void Add( Stat_t *pStat, uint32_t Time );
+static void Count( uint32_t *pBins, uint32_t Time );
+static void Compare( const char *pWhat, unsigned Which,
+                     const ES_ProfileStat_t *pGot, const Stat_t *pWant );
+static void CheckProfile( void );
+static void CheckClear( void );
+
+/*---------------------------- Module Variables ---------------------------*/
+static ES_EventTyp_t const Types[] = { ES_TIMEOUT, ES_FRONT_BUMPED,
+                                       ES_GAME_START, ES_BEACON_FRONT,
+                                       ES_BALL_BIN_EMPTY };
+
+static uint32_t NumPosts = DEFAULT_NUM_POSTS;
+static uint32_t Posts;
+static uint32_t Seed = 1;
+static uint32_t PostTime[MAX_POSTS + 1];
+static uint8_t PostedTo[MAX_POSTS + 1];
+static Model_t Services[NUM_SERVICES];
+static Model_t Events[ES_PROFILE_NUM_EVENTS];
+static uint32_t Failures;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  if ( argc > 1 )
+    NumPosts = (uint32_t)strtoul( argv[1], NULL, 0 );
+  if ( (NumPosts == 0) || (NumPosts >= MAX_POSTS) ) {
+    printf( "usage: %s [NumPosts], NumPosts below %lu\n", argv[0],
+            MAX_POSTS );
+    return 1;
+  }
+  if ( ES_Initialize( ES_Timer_RATE_2MS ) != Success ) {
+    printf( "ES_Initialize failed\n" );
+    return 1;
+  }
+  if ( ES_Run() != FailedRun )
+    printf( "ES_Run did not stop\n" );
+  CheckProfile();
+  ES_Profile_Print();
+  printf( "\n" );
+  CheckClear();
+
+  printf( "dispatch profile, batch %d: %lu posts\n", ES_RUN_BATCH_SIZE,
+          (unsigned long)Posts );
+  if ( Failures != 0 ) {
+    printf( "FAIL: %lu mismatches\n", (unsigned long)Failures );
+    return 1;
+  }
+  printf( "PASS\n" );
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   StressServiceInit
+ Parameters
+   uint8_t : the priority of this service
+ Returns
+   boolean, True
+ Description
+   nothing to set up
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:37
+****************************************************************************/
+boolean StressServiceInit( uint8_t Priority )
+{
+  (void)Priority;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   StressServiceRun
+ Parameters
+   ES_Event : the event to process, its post number in EventParam
+ Returns
+   ES_Event, ES_ERROR for the ES_ERROR that ends the test
+ Description
+   works out how long the event waited, then takes a random time to run,
+   and adds both to the test's figures
+ Notes
+   both services share it. 1 in 4 of service 0's runs posts to service 1
+ Author
+   Alex Loo, 10/18/26, 06:40
+****************************************************************************/
+ES_Event StressServiceRun( ES_Event ThisEvent )
+{
+  ES_Event ReturnEvent;
+  uint8_t Service = PostedTo[ThisEvent.EventParam];
+  uint32_t Wait = ES_Timer_GetFineTime() - PostTime[ThisEvent.EventParam];
+  uint32_t Run = RandomTime();
+
+  Elapse( Run );
+  Add( &Services[Service].Run, Run );
+  Add( &Services[Service].Wait, Wait );
+  Count( Services[Service].RunBins, Run );
+  Count( Services[Service].WaitBins, Wait );
+  Add( &Events[ThisEvent.EventType].Run, Run );
+  Add( &Events[ThisEvent.EventType].Wait, Wait );
+  if ( (Service == 0) && (Random( 4 ) == 0) && (Posts < NumPosts) )
+    Post( 1, ES_FRONT_BUMPED );
+
+  ReturnEvent.EventType = ES_NO_EVENT;
+  ReturnEvent.EventParam = 0;
+  if ( ThisEvent.EventType == ES_ERROR )
+    ReturnEvent.EventType = ES_ERROR;
+  return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+   StressPostLow
+ Parameters
+   ES_Event : the event to post
+ Returns
+   boolean, False if the post failed
+ Description
+   posts to service 0
+ Notes
+   StressConfig.h's ISR rings need it, nothing posts to them here
+ Author
+   Alex Loo, 10/18/26, 06:41
+****************************************************************************/
+boolean StressPostLow( ES_Event ThisEvent )
+{
+  return ES_PostToService( 0, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   StressPostHigh
+ Parameters
+   ES_Event : the event to post
+ Returns
+   boolean, False if the post failed
+ Description
+   posts to service 1
+ Notes
+   as StressPostLow
+ Author
+   Alex Loo, 10/18/26, 06:42
+****************************************************************************/
+boolean StressPostHigh( ES_Event ThisEvent )
+{
+  return ES_PostToService( 1, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   StressCheckEvents
+ Parameters
+   None
+ Returns
+   boolean, True if it posted
+ Description
+   a tick of the RTI and a burst of 1 to MAX_BURST posts, with time passing
+   between them; once NumPosts are done, ES_ERROR to stop ES_Run
+ Notes
+   each post goes to a random service
+ Author
+   Alex Loo, 10/18/26, 06:45
+****************************************************************************/
+boolean StressCheckEvents( void )
+{
+  uint32_t Burst = 1 + Random( MAX_BURST );
+
+  ES_Port_Tick();
+  if ( Posts > NumPosts )
+    return False;
+  while ( (Burst-- != 0) && (Posts < NumPosts) ) {
+    Post( (uint8_t)Random( NUM_SERVICES ),
+          Types[Random( sizeof(Types) / sizeof(Types[0]) )] );
+    Elapse( RandomTime() );
+  }
+  if ( (Posts == NumPosts) && (Post( 0, ES_ERROR ) == False) )
+    Posts--;            // the queue is full, try again next time
+  return True;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   Post
+ Parameters
+   uint8_t Service : the service to post to
+   ES_EventTyp_t EventType : the event to post
+ Returns
+   boolean, False if the post failed
+ Description
+   posts the next post number, noting when and to which service
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:46
+****************************************************************************/
+static boolean Post( uint8_t Service, ES_EventTyp_t EventType )
+{
+  ES_Event ThisEvent;
+
+  Posts++;
+  ThisEvent.EventType = EventType;
+  ThisEvent.EventParam = (uint16_t)Posts;
+  PostTime[Posts] = ES_Timer_GetFineTime();
+  PostedTo[Posts] = Service;
+  return ES_PostToService( Service, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   Elapse
+ Parameters
+   uint32_t Counts : fine counts to let pass
+ Returns
+   None
+ Description
+   moves the simulated free running counter on, running its overflow ISR
+   at each wrap
+ Notes
+   the timers do not tick, only ES_Port_Tick does that
+ Author
+   Alex Loo, 10/18/26, 06:48
+****************************************************************************/
+static void Elapse( uint32_t Counts )
+{
+  unsigned int Step;
+
+  while ( Counts != 0 ) {
+    Step = (Counts > 0x4000) ? 0x4000 : (unsigned int)Counts;
+    ES_Port_AdvanceFreeRunning( Step );
+    if ( ES_Port_FreeRunningWrapped() )
+      ES_Port_FreeRunningISR();
+    Counts -= Step;
+  }
+}
+
+/****************************************************************************
+ Function
+   Random
+ Parameters
+   uint32_t Range : how many values to pick from
+ Returns
+   uint32_t : 0 to Range - 1
+ Description
+   a linear congruential generator, the same every run
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:49
+****************************************************************************/
+static uint32_t Random( uint32_t Range )
+{
+  Seed = Seed * 1664525UL + 1013904223UL;
+  return (Seed >> 8) % Range;
+}
+
+/****************************************************************************
+ Function
+   RandomTime
+ Parameters
+   None
+ Returns
+   uint32_t : fine counts, usually under SHORT_COUNTS
+ Description
+   a time for a run or a gap between posts
+ Notes
+   1 in LONG_ONE is up to LONG_COUNTS, past the last histogram bin
+ Author
+   Alex Loo, 10/18/26, 06:50
+****************************************************************************/
+static uint32_t RandomTime( void )
+{
+  if ( Random( LONG_ONE ) == 0 )
+    return Random( LONG_COUNTS );
+  return Random( SHORT_COUNTS );
+}
+
+/****************************************************************************
+ Function
+   Add
+ Parameters
+   Stat_t * pStat : the test's figures
+   uint32_t Time : a run time or a wait
+ Returns
+   None
+ Description
+   counts it, keeps the min and max and adds it to the total
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:52
+****************************************************************************/
+static void Add( Stat_t *pStat, uint32_t Time )
+{
+  if ( (pStat->Count == 0) || (Time < pStat->Min) )
+    pStat->Min = Time;
+  if ( Time > pStat->Max )
+    pStat->Max = Time;
+  pStat->Count++;
+  pStat->Total += Time;
+}
+
+/****************************************************************************
+ Function
+   Count
+ Parameters
+   uint32_t * pBins : a histogram
+   uint32_t Time : a run time or a wait
+ Returns
+   None
+ Description
+   counts it in its bin, found from ES_Profile_BinStart
+ Notes
+   a search, not the profile's bit lookups, so the 2 can be compared
+ Author
+   Alex Loo, 10/18/26, 06:54
+****************************************************************************/
+static void Count( uint32_t *pBins, uint32_t Time )
+{
+  uint8_t Bin = ES_PROFILE_BINS - 1;
+
+  while ( ES_Profile_BinStart( Bin ) > Time )
+    Bin--;
+  pBins[Bin]++;
+}
+
+/****************************************************************************
+ Function
+   Compare
+ Parameters
+   const char * pWhat : what is being compared, for the message
+   unsigned Which : the service or event type
+   const ES_ProfileStat_t * pGot : the profile's figures
+   const Stat_t * pWant : the test's figures
+ Returns
+   None
+ Description
+   counts a failure for each figure that differs
+ Notes
+   the profile's total stops at 0xFFFFFFFF
+ Author
+   Alex Loo, 10/18/26, 06:56
+****************************************************************************/
+static void Compare( const char *pWhat, unsigned Which,
+                     const ES_ProfileStat_t *pGot, const Stat_t *pWant )
+{
+  uint64_t Total = (pWant->Total > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL
+                                                 : pWant->Total;
+
+  if ( (pGot->Count != pWant->Count) || (pGot->Total != Total) ||
+       ((pWant->Count != 0) &&
+        ((pGot->Min != pWant->Min) || (pGot->Max != pWant->Max))) ) {
+    if ( Failures < 10 )
+      printf( "%s %u: count %lu/%lu min %lu/%lu max %lu/%lu total "
+              "%lu/%llu\n", pWhat, Which, (unsigned long)pGot->Count,
+              (unsigned long)pWant->Count, (unsigned long)pGot->Min,
+              (unsigned long)pWant->Min, (unsigned long)pGot->Max,
+              (unsigned long)pWant->Max, (unsigned long)pGot->Total,
+              (unsigned long long)Total );
+    Failures++;
+  }
+}
+
+/****************************************************************************
+ Function
+   CheckProfile
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the profile of each service and event type against the test's figures
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 06:58
+****************************************************************************/
+static void CheckProfile( void )
+{
+  ES_ServiceProfile_t Serv;
+  ES_EventProfile_t Event;
+  uint8_t i;
+  uint8_t Bin;
+
+  for ( i = 0; i < NUM_SERVICES; i++ ) {
+    if ( ES_Profile_QueryService( i, &Serv ) == False ) {
+      printf( "no profile for service %u\n", i );
+      Failures++;
+      continue;
+    }
+    Compare( "service run", i, &Serv.Run, &Services[i].Run );
+    Compare( "service wait", i, &Serv.Wait, &Services[i].Wait );
+    for ( Bin = 0; Bin < ES_PROFILE_BINS; Bin++ ) {
+      if ( (Serv.RunBins[Bin] != Services[i].RunBins[Bin]) ||
+           (Serv.WaitBins[Bin] != Services[i].WaitBins[Bin]) ) {
+        printf( "service %u bin %u: run %u/%lu wait %u/%lu\n", i, Bin,
+                Serv.RunBins[Bin], (unsigned long)Services[i].RunBins[Bin],
+                Serv.WaitBins[Bin], (unsigned long)Services[i].WaitBins[Bin] );
+        Failures++;
+      }
+    }
+    if ( (Services[i].RunBins[ES_PROFILE_BINS - 1] == 0) ||
+         (Services[i].WaitBins[0] == 0) ) {
+      printf( "service %u: the histograms were not filled out\n", i );
+      Failures++;
+    }
+  }
+  for ( i = 0; i < ES_PROFILE_NUM_EVENTS; i++ ) {
+    ES_Profile_QueryEvent( (ES_EventTyp_t)i, &Event );
+    Compare( "event run", i, &Event.Run, &Events[i].Run );
+    Compare( "event wait", i, &Event.Wait, &Events[i].Wait );
+  }
+  if ( (ES_Profile_QueryService( NUM_SERVICES, &Serv ) == True) ||
+       (ES_Profile_QueryEvent( (ES_EventTyp_t)ES_PROFILE_NUM_EVENTS,
+                               &Event ) == True) ) {
+    printf( "profile of a service or event type that is not profiled\n" );
+    Failures++;
+  }
+}
+
+/****************************************************************************
+ Function
+   CheckClear
+ Parameters
+   None
+ Returns
+   None
+ Description
+   after ES_Profile_Clear every figure must be 0
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 07:00
+****************************************************************************/
+static void CheckClear( void )
+{
+  ES_ServiceProfile_t Serv;
+  ES_EventProfile_t Event;
+  Stat_t Zero = { 0, 0, 0, 0 };
+  uint8_t i;
+  uint8_t Bin;
+
+  ES_Profile_Clear();
+  for ( i = 0; i < NUM_SERVICES; i++ ) {
+    ES_Profile_QueryService( i, &Serv );
+    Compare( "cleared run", i, &Serv.Run, &Zero );
+    Compare( "cleared wait", i, &Serv.Wait, &Zero );
+    for ( Bin = 0; Bin < ES_PROFILE_BINS; Bin++ ) {
+      if ( (Serv.RunBins[Bin] != 0) || (Serv.WaitBins[Bin] != 0) ) {
+        printf( "service %u bin %u not cleared\n", i, Bin );
+        Failures++;
+      }
+    }
+  }
+  for ( i = 0; i < ES_PROFILE_NUM_EVENTS; i++ ) {
+    ES_Profile_QueryEvent( (ES_EventTyp_t)i, &Event );
+    Compare( "cleared event", i, &Event.Run, &Zero );
+  }
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,489 @@
+/****************************************************************************
+ Module
+     TestTrace.c
+ Description
+     Host test for the event trace, ES_Trace.c, through the real ES_Run
+ Notes
+     usage: TestTrace
+
+     2 services run a scripted set of events, the higher one posting to the
+     lower one as it runs and reporting state transitions, and a pool timer
+     expires part way through. Each run advances the fine timebase by a
+     known amount, as if it took that long. The trace must then hold, for
+     every event, its post, dequeue, start and end, in that order, for the
+     right service, with the queue depths right and the times never going
+     backwards; the timer's expiry before the post of its timeout; and the
+     state transitions inside the runs that made them.
+
+     Then it fills the ring several times over: ES_Trace_Copy must give the
+     latest ES_TRACE_SIZE records and ES_Trace_QueryTotal count them all.
+
+     Then it fills service 0's queue and posts through ISR ring 0, which
+     names the service: the ring keeps the event and tries it again, so
+     only the post made straight to the full queue may be traced as a
+     drop. A straight post made while the rings are being drained, as an
+     ISR's may be, is traced as a drop too; ring 2's post function makes
+     one, standing in for the ISR.
+
+     Last, it runs the script again and dumps the trace to stdout, for
+     TraceDecode (make test pipes 1 into the other).
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 16:00 adl      a straight post between the ring's tries is a drop
+ 10/18/26 15:00 adl      a post an ISR ring tries again is not a drop
+ 10/18/26 04:40 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Port.h"
+#include "ES_Timers.h"
+#include "ES_Trace.h"
+#include "ES_ISRRing.h"
+#include "StressServices.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_RECORDS 256
+// fine counts that a run of each service takes
+#define LOW_RUN_COUNTS 90
+#define HIGH_RUN_COUNTS 150
+#define TIMER_TICKS 3
+
+/*------------------------------ Module Types -----------------------------*/
+typedef struct {
+  uint8_t Service;
+  ES_EventTyp_t EventType;
+} Step_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void RunScript( void );
+static void CheckTrace( void );
+static void CheckOverwrite( void );
+static void CheckRingRetry( void );
+static void Fail( const char *pWhat );
+
+/*---------------------------- Module Variables ---------------------------*/
+// what the event checker posts, 1 step each time ES_Run is idle; the
+// service 1 ES_GAME_START runs post ES_FRONT_BUMPED to service 0
+static Step_t const Script[] = {
+  { 0, ES_LEFT_TAPE_DETECTED }, { 1, ES_GAME_START },
+  { 0, ES_RIGHT_TAPE_DETECTED }, { 0, ES_REAR_BUMPED },
+  { 1, ES_BALL_BIN_EMPTY }, { 1, ES_GAME_START },
+  { 0, ES_BEACON_REAR }, { 1, ES_NO_DANGERWALL }
+};
+
+static uint8_t NextStep;
+static uint8_t State;
+static boolean TimedOut;
+// StressPostHigh posts straight to service 0 instead, as an ISR would
+static boolean PostAsISR;
+static ES_TimerHandle_t Timer;
+static ES_TraceRecord_t Records[MAX_RECORDS];
+static uint32_t Failures;
+
+/*------------------------------ Module Code ------------------------------*/
+int main( void )
+{
+  RunScript();
+  CheckTrace();
+  CheckOverwrite();
+  CheckRingRetry();
+  // again, for the dump
+  RunScript();
+  if ( Failures != 0 ) {
+    printf( "FAIL: %lu mismatches\n", (unsigned long)Failures );
+    return 1;
+  }
+  printf( "PASS\n" );
+  ES_Trace_Dump();
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   StressServiceInit
+ Parameters
+   uint8_t : the priority of this service
+ Returns
+   boolean, True
+ Description
+   nothing to set up
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 04:42
+****************************************************************************/
+boolean StressServiceInit( uint8_t Priority )
+{
+  (void)Priority;
+  return True;
+}
+
+/****************************************************************************
+ Function
+   StressServiceRun
+ Parameters
+   ES_Event : the event to process
+ Returns
+   ES_Event, ES_ERROR for the ES_ERROR that ends the script
+ Description
+   takes a fixed time; ES_GAME_START posts ES_FRONT_BUMPED to service 0
+   and every service 1 event is a state transition
+ Notes
+   both services share it, the run time tells them apart in the trace
+ Author
+   Alex Loo, 10/18/26, 04:44
+****************************************************************************/
+ES_Event StressServiceRun( ES_Event ThisEvent )
+{
+  ES_Event ReturnEvent;
+  ES_Event NewEvent;
+
+  ReturnEvent.EventType = ES_NO_EVENT;
+  ReturnEvent.EventParam = 0;
+  if ( ThisEvent.EventType == ES_ERROR ) {
+    ReturnEvent.EventType = ES_ERROR;
+    return ReturnEvent;
+  }
+  if ( ThisEvent.EventParam == 1 ) {
+    ES_Port_AdvanceFreeRunning( HIGH_RUN_COUNTS );
+    ES_TraceState( 0, State, State + 1 );
+    State++;
+    if ( ThisEvent.EventType == ES_GAME_START ) {
+      NewEvent.EventType = ES_FRONT_BUMPED;
+      NewEvent.EventParam = 0;
+      ES_PostToService( 0, NewEvent );
+    }
+  } else {
+    ES_Port_AdvanceFreeRunning( LOW_RUN_COUNTS );
+    if ( ThisEvent.EventType == ES_TIMEOUT )
+      TimedOut = True;
+  }
+  return ReturnEvent;
+}
+
+/****************************************************************************
+ Function
+   StressPostLow
+ Parameters
+   ES_Event : the event to post
+ Returns
+   boolean, False if the post failed
+ Description
+   posts to service 0, for the timer
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 04:46
+****************************************************************************/
+boolean StressPostLow( ES_Event ThisEvent )
+{
+  return ES_PostToService( 0, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   StressPostHigh
+ Parameters
+   ES_Event : the event to post
+ Returns
+   boolean, False if the post failed
+ Description
+   posts to service 1, or with PostAsISR set, straight to service 0, as an
+   ISR that interrupts the drain would
+ Notes
+   StressConfig.h's ISR rings 2 and 3 post through it
+ Author
+   Alex Loo, 10/18/26, 04:47
+****************************************************************************/
+boolean StressPostHigh( ES_Event ThisEvent )
+{
+  if ( PostAsISR == True ) {
+    (void)ES_PostToService( 0, ThisEvent );
+    return True;
+  }
+  return ES_PostToService( 1, ThisEvent );
+}
+
+/****************************************************************************
+ Function
+   StressCheckEvents
+ Parameters
+   None
+ Returns
+   boolean, True if it posted
+ Description
+   a tick of the RTI and the next step of the script; once the script is
+   done and the timer has run out, ES_ERROR to stop ES_Run
+ Notes
+   starts the timer at the 4th step
+ Author
+   Alex Loo, 10/18/26, 04:48
+****************************************************************************/
+boolean StressCheckEvents( void )
+{
+  ES_Event ThisEvent;
+
+  ES_Port_Tick();
+  if ( NextStep < sizeof(Script) / sizeof(Script[0]) ) {
+    if ( NextStep == 3 )
+      ES_Timer_InitTimer( Timer, TIMER_TICKS );
+    ThisEvent.EventType = Script[NextStep].EventType;
+    ThisEvent.EventParam = Script[NextStep].Service;
+    ES_PostToService( Script[NextStep].Service, ThisEvent );
+    NextStep++;
+    return True;
+  }
+  if ( TimedOut == True ) {
+    ThisEvent.EventType = ES_ERROR;
+    ThisEvent.EventParam = 0;
+    ES_PostToService( 0, ThisEvent );
+    return True;
+  }
+  return False;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   RunScript
+ Parameters
+   None
+ Returns
+   None
+ Description
+   starts the framework afresh and runs the script through ES_Run
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 04:50
+****************************************************************************/
+static void RunScript( void )
+{
+  ES_Event TimeOut;
+
+  NextStep = 0;
+  State = 0;
+  TimedOut = False;
+  if ( ES_Initialize( ES_Timer_RATE_2MS ) != Success ) {
+    Fail( "ES_Initialize failed" );
+    return;
+  }
+  TimeOut.EventType = ES_TIMEOUT;
+  TimeOut.EventParam = 0;
+  Timer = ES_Timer_Alloc( StressPostLow, TimeOut );
+  if ( Timer == ES_TIMER_NO_HANDLE ) {
+    Fail( "no timer" );
+    return;
+  }
+  if ( ES_Run() != FailedRun )
+    Fail( "ES_Run did not stop" );
+  ES_Timer_Free( Timer );
+}
+
+/****************************************************************************
+ Function
+   CheckTrace
+ Parameters
+   None
+ Returns
+   None
+ Description
+   walks the trace of 1 run of the script, see the module notes
+ Notes
+   no service runs inside another here, so each start has its dequeue just
+   before it and its end just after it, apart from what it posts
+ Author
+   Alex Loo, 10/18/26, 04:53
+****************************************************************************/
+static void CheckTrace( void )
+{
+  uint16_t Num = ES_Trace_Copy( Records, MAX_RECORDS );
+  uint8_t Depth[NUM_SERVICES] = { 0 };
+  uint16_t Posts = 0, Runs = 0, Timers = 0, States = 0;
+  int Running = -1;             // the service whose run has started
+  int Taken = -1;               // the service just dequeued from
+  uint8_t TakenType = 0;
+  uint32_t StartTime = 0;
+  ES_TraceRecord_t *p;
+  uint16_t i;
+
+  if ( ES_Trace_QueryTotal() != Num )
+    Fail( "trace overwritten, raise the test's ES_TRACE_SIZE" );
+  for ( i = 0; i < Num; i++ ) {
+    p = &Records[i];
+    if ( (i != 0) && (p->Time < Records[i - 1].Time) )
+      Fail( "time went backwards" );
+    if ( (p->Kind != ES_TRACE_STATE) && (p->Kind != ES_TRACE_TIMER) &&
+         (p->Who >= NUM_SERVICES) ) {
+      Fail( "no such service" );
+      continue;
+    }
+    switch ( p->Kind ) {
+      case ES_TRACE_POST:
+        Posts++;
+        if ( p->Extra != ++Depth[p->Who] )
+          Fail( "post with the wrong queue depth" );
+        if ( (p->What == ES_TIMEOUT) &&
+             ((i == 0) || (Records[i - 1].Kind != ES_TRACE_TIMER)) )
+          Fail( "timeout posted without a timer record before it" );
+        break;
+      case ES_TRACE_DEQUEUE:
+        if ( (Depth[p->Who] == 0) || (p->Extra != --Depth[p->Who]) )
+          Fail( "dequeue with the wrong queue depth" );
+        Taken = p->Who;
+        TakenType = p->What;
+        break;
+      case ES_TRACE_START:
+        if ( (Taken != p->Who) || (TakenType != p->What) || (Running >= 0) )
+          Fail( "start without its dequeue" );
+        Running = p->Who;
+        StartTime = p->Time;
+        Taken = -1;
+        break;
+      case ES_TRACE_END:
+        if ( Running != p->Who ) {
+          Fail( "end without its start" );
+          break;
+        }
+        Runs++;
+        if ( (p->What != ES_ERROR) &&
+             (p->Time - StartTime != ((p->Who == 1) ? HIGH_RUN_COUNTS
+                                                    : LOW_RUN_COUNTS)) )
+          Fail( "run took the wrong time" );
+        Running = -1;
+        break;
+      case ES_TRACE_STATE:
+        States++;
+        if ( Running != 1 )
+          Fail( "state transition outside service 1" );
+        if ( p->What != (uint8_t)(p->Extra + 1) )
+          Fail( "state transition to the wrong state" );
+        break;
+      case ES_TRACE_TIMER:
+        Timers++;
+        break;
+      default:
+        Fail( "record of no known kind" );
+        break;
+    }
+  }
+  // the script, the 2 posts from ES_GAME_START, the timeout and ES_ERROR
+  if ( (Posts != 12) || (Runs != 12) || (Timers != 1) || (States != 4) )
+    Fail( "records missing" );
+  printf( "trace of 1 run: %u records, %u posts, %u runs, %u timers, "
+          "%u state transitions\n", Num, Posts, Runs, Timers, States );
+}
+
+/****************************************************************************
+ Function
+   CheckOverwrite
+ Parameters
+   None
+ Returns
+   None
+ Description
+   writes numbered records until the ring has filled several times over
+   and checks that the latest ES_TRACE_SIZE are the ones kept
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 04:58
+****************************************************************************/
+static void CheckOverwrite( void )
+{
+  uint32_t Before = ES_Trace_QueryTotal();
+  uint16_t Num;
+  uint16_t i;
+  uint16_t Written = 3 * ES_TRACE_SIZE + 5;
+
+  for ( i = 0; i < Written; i++ )
+    ES_Trace_Write( ES_TRACE_TIMER, (uint8_t)i, (uint8_t)(i >> 8), 0 );
+  if ( ES_Trace_QueryTotal() != Before + Written )
+    Fail( "records written not counted" );
+  Num = ES_Trace_Copy( Records, MAX_RECORDS );
+  if ( Num != ES_TRACE_SIZE )
+    Fail( "full ring does not hold ES_TRACE_SIZE records" );
+  for ( i = 0; i < Num; i++ ) {
+    if ( (uint16_t)(Records[i].Who | Records[i].What << 8) !=
+         Written - Num + i )
+      Fail( "ring kept the wrong records" );
+  }
+  Num = ES_Trace_Copy( Records, 4 );
+  if ( (Num != 4) || (Records[3].Who != (uint8_t)(Written - 1)) )
+    Fail( "ES_Trace_Copy of the latest few" );
+}
+
+/****************************************************************************
+ Function
+   CheckRingRetry
+ Parameters
+   None
+ Returns
+   None
+ Description
+   fills service 0's queue, then posts to it straight, through ISR ring 0,
+   and from a stand-in ISR while the rings drain, and checks that only the
+   ring's post is not traced as a drop
+ Notes
+   the ring's event is still waiting afterwards; RunScript starts afresh
+ Author
+   Alex Loo, 10/18/26, 15:05
+****************************************************************************/
+static void CheckRingRetry( void )
+{
+  ES_Event ThisEvent;
+  uint16_t Num;
+  uint16_t Drops = 0;
+  uint16_t i;
+
+  if ( ES_Initialize( ES_Timer_RATE_2MS ) != Success ) {
+    Fail( "ES_Initialize failed" );
+    return;
+  }
+  ThisEvent.EventType = ES_LEFT_TAPE_DETECTED;
+  ThisEvent.EventParam = 0;
+  while ( ES_PostToService( 0, ThisEvent ) == True )
+    ; // the last one is dropped
+  if ( (ES_ISRRing_Post( 0, ThisEvent ) != True) ||
+       (ES_ISRRing_Post( 2, ThisEvent ) != True) )
+    Fail( "ISR ring full" );
+  PostAsISR = True;
+  for ( i = 0; i < 3; i++ )
+    ES_ISRRing_Drain();
+  PostAsISR = False;
+  Num = ES_Trace_Copy( Records, MAX_RECORDS );
+  for ( i = 0; i < Num; i++ ) {
+    if ( Records[i].Kind == ES_TRACE_DROP )
+      Drops++;
+  }
+  if ( Drops != 2 )
+    Fail( "a post that an ISR ring tries again traced as a drop, or an "
+          "ISR's post while the rings drain not traced" );
+}
+
+/****************************************************************************
+ Function
+   Fail
+ Parameters
+   const char * pWhat : what went wrong
+ Returns
+   None
+ Description
+   counts a failure, printing the first few
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 05:00
+****************************************************************************/
+static void Fail( const char *pWhat )
+{
+  if ( Failures++ < 10 )
+    printf( "%s\n", pWhat );
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,615 @@
+/****************************************************************************
+ Module
+     TraceDecode.c
+ Description
+     Host decoder for the event trace (ES_Trace.c): turns the dumps in a
+     console capture into Chrome trace event JSON, for chrome://tracing or
+     ui.perfetto.dev
+ Notes
+     usage: TraceDecode [CaptureFile] > Trace.json
+
+     Reads the capture (stdin without a file), picks out the #TRACE, #T and
+     #END lines of each dump and ignores everything else. Dumps follow on
+     from each other in time; where the ring overwrote records before a
+     dump, a "lost" marker says how many.
+
+     The timeline has a track per service, with a slice per event it ran
+     (the event's name, its parameter and how long it waited in the queue
+     as args) and a counter of its queue depth; a track per state machine
+     with a slice per state it was in; and a track of timer expiries. The
+     names come from the application's ES_Configure.h and the machines'
+     headers, so it is built without ES_HOST_CONFIG.
+
+     A summary per service goes to stderr. It returns 1 on a malformed
+     capture or one without a dump.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 11:50 adl      the names are in AppNames.c, shared with Replay
+ 10/18/26 05:50 adl      a time a little before the last is not a wrap
+ 10/18/26 05:45 adl      a coalesced post moves its event to the back
+ 10/18/26 05:05 adl      started coding
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ES_Configure.h"
+#include "ES_Trace.h"
+#include "AppNames.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_LINE 256
+#define MAX_SERVICES 64
+#define MAX_MACHINES 256
+// the most events a service's queue can hold, and then some
+#define MAX_PENDING 256
+#define TRACE_VERSION 1
+// tracks: services are 0 up, then these
+#define MACHINE_TID 100
+#define TIMER_TID 400
+#define LOST_TID 401
+
+/*------------------------------ Module Types -----------------------------*/
+typedef struct {
+  boolean Seen;
+  boolean Running;
+  uint64_t StartTime;
+  uint8_t Event;
+  uint8_t Param;
+  int64_t Wait;               // of the event running, -1 if not known
+  uint64_t Pending[MAX_PENDING];   // post times, oldest first
+  uint8_t PendingType[MAX_PENDING];
+  uint16_t PendingHead;
+  uint16_t NumPending;
+  // for the summary
+  uint32_t Runs;
+  uint64_t RunTotal;
+  uint64_t RunMax;
+  uint32_t Waits;
+  uint64_t WaitTotal;
+  uint64_t WaitMax;
+  uint8_t MaxDepth;
+  uint32_t Drops;
+  uint32_t Coalesced;
+} Service_t;
+
+typedef struct {
+  boolean Seen;
+  uint8_t State;
+  uint64_t Since;
+} Machine_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static boolean DecodeRecord( const char *pHex );
+static void Post( uint8_t Who, uint8_t What, uint8_t Depth );
+static void DeQueue( uint8_t Who, uint8_t Depth );
+static void Start( uint8_t Who, uint8_t What, uint8_t Param );
+static void End( uint8_t Who );
+static void ChangeState( uint8_t Who, uint8_t New, uint8_t Old );
+static void Counter( uint8_t Who, uint8_t Depth );
+static void BeginEvent( void );
+static void FinishTracks( void );
+static void Summarize( void );
+static double Microseconds( uint64_t Time );
+
+/*---------------------------- Module Variables ---------------------------*/
+static Service_t Services[MAX_SERVICES];
+static Machine_t Machines[MAX_MACHINES];
+
+static unsigned FinePerUs;
+// the time of the latest record, unwrapped from the 32 bit fine time
+static uint64_t Now;
+static uint64_t FirstTime;
+static uint32_t LastTime;
+static boolean AnyRecords;
+static uint32_t NumRecords;
+static uint32_t NumTimers;
+static uint32_t NumEvents;      // written to the JSON, for the commas
+
+/*------------------------------ Module Code ------------------------------*/
+int main( int argc, char *argv[] )
+{
+  FILE *pIn = stdin;
+  char Line[MAX_LINE];
+  char *pLine;
+  uint32_t LineNum = 0;
+  uint32_t NumDumps = 0;
+  boolean InDump = False;
+  unsigned Version, Fine, Held;
+  unsigned long Written;
+  uint32_t Got = 0;
+
+  if ( argc > 2 ) {
+    fprintf( stderr, "usage: %s [CaptureFile] > Trace.json\n", argv[0] );
+    return 1;
+  }
+  if ( (argc == 2) && ((pIn = fopen( argv[1], "r" )) == NULL) ) {
+    perror( argv[1] );
+    return 1;
+  }
+
+  printf( "{\"traceEvents\":[\n" );
+  while ( fgets( Line, sizeof(Line), pIn ) != NULL ) {
+    LineNum++;
+    Line[strcspn( Line, "\r\n" )] = '\0';
+    // other console output may run into the start of a dump line
+    if ( ((pLine = strstr( Line, "#TRACE " )) == NULL) &&
+         ((pLine = strstr( Line, "#T " )) == NULL) &&
+         ((pLine = strstr( Line, "#END" )) == NULL) )
+      continue;
+    if ( strncmp( pLine, "#TRACE ", 7 ) == 0 ) {
+      if ( (sscanf( pLine, "#TRACE %u %u %u %lu", &Version, &Fine, &Held,
+                    &Written ) != 4) || (Version != TRACE_VERSION) ||
+           (Fine == 0) || ((FinePerUs != 0) && (Fine != FinePerUs)) ||
+           (Written < Held) ) {
+        fprintf( stderr, "line %lu: bad dump header\n",
+                 (unsigned long)LineNum );
+        return 1;
+      }
+      if ( InDump == True ) {
+        fprintf( stderr, "line %lu: dump inside a dump\n",
+                 (unsigned long)LineNum );
+        return 1;
+      }
+      FinePerUs = Fine;
+      InDump = True;
+      Got = 0;
+      NumDumps++;
+      if ( Written > Held ) {
+        BeginEvent();
+        printf( "{\"name\":\"lost %lu records\",\"ph\":\"i\",\"s\":\"g\","
+                "\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                Written - Held, LOST_TID, Microseconds( Now ) );
+      }
+    } else if ( strncmp( pLine, "#T ", 3 ) == 0 ) {
+      if ( (InDump == False) || (Got == Held) ||
+           (DecodeRecord( pLine + 3 ) == False) ) {
+        fprintf( stderr, "line %lu: bad record\n", (unsigned long)LineNum );
+        return 1;
+      }
+      Got++;
+    } else {
+      if ( (InDump == False) || (Got != Held) ) {
+        fprintf( stderr, "line %lu: dump ends with %lu of %u records\n",
+                 (unsigned long)LineNum, (unsigned long)Got, Held );
+        return 1;
+      }
+      InDump = False;
+    }
+  }
+  if ( InDump == True ) {
+    fprintf( stderr, "capture ends inside a dump\n" );
+    return 1;
+  }
+  if ( NumDumps == 0 ) {
+    fprintf( stderr, "no trace dump in the capture\n" );
+    return 1;
+  }
+  FinishTracks();
+  printf( "\n],\"displayTimeUnit\":\"ns\"}\n" );
+  fprintf( stderr, "%lu dumps, %lu records, %.3f mS\n",
+           (unsigned long)NumDumps, (unsigned long)NumRecords,
+           Microseconds( Now ) / 1000.0 );
+  Summarize();
+  return 0;
+}
+
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   DecodeRecord
+ Parameters
+   const char * pHex : the record, 16 hex digits
+ Returns
+   boolean, False if it is not a record
+ Description
+   unwraps its time and hands it on by kind
+ Notes
+   the 32 bit fine time wraps every 23 minutes (ES_PORT_FINE_PER_US 3), so
+   dumps further apart than that lose their place on the timeline. A record
+   written by an ISR can carry a time a little later than the record after
+   it (see ES_Trace.c), so time may step back that far
+ Author
+   Alex Loo, 10/18/26, 05:10
+****************************************************************************/
+static boolean DecodeRecord( const char *pHex )
+{
+  unsigned long Time;
+  unsigned Kind, Who, What, Extra;
+  int Used = 0;
+
+  if ( (sscanf( pHex, "%8lx%2x%2x%2x%2x%n", &Time, &Kind, &Who, &What,
+                &Extra, &Used ) != 5) || (Used != 16) )
+    return False;
+  if ( AnyRecords == True )
+    Now += (int64_t)(int32_t)((uint32_t)Time - LastTime);
+  else
+    Now = FirstTime = (uint32_t)Time;
+  AnyRecords = True;
+  LastTime = (uint32_t)Time;
+  NumRecords++;
+
+  if ( (Kind <= ES_TRACE_END) && (Who >= MAX_SERVICES) )
+    return False;
+  switch ( Kind ) {
+    case ES_TRACE_POST:
+      Post( (uint8_t)Who, (uint8_t)What, (uint8_t)Extra );
+      break;
+    case ES_TRACE_DROP:
+      Services[Who].Seen = True;
+      Services[Who].Drops++;
+      BeginEvent();
+      printf( "{\"name\":\"drop %s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,"
+              "\"tid\":%u,\"ts\":%.3f}", AppNames_Event( (uint8_t)What ), Who,
+              Microseconds( Now ) );
+      break;
+    case ES_TRACE_DEQUEUE:
+      DeQueue( (uint8_t)Who, (uint8_t)Extra );
+      break;
+    case ES_TRACE_START:
+      Start( (uint8_t)Who, (uint8_t)What, (uint8_t)Extra );
+      break;
+    case ES_TRACE_END:
+      End( (uint8_t)Who );
+      break;
+    case ES_TRACE_STATE:
+      ChangeState( (uint8_t)Who, (uint8_t)What, (uint8_t)Extra );
+      break;
+    case ES_TRACE_TIMER:
+      NumTimers++;
+      BeginEvent();
+      printf( "{\"name\":\"timer %u\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,"
+              "\"tid\":%d,\"ts\":%.3f}", Who, TIMER_TID,
+              Microseconds( Now ) );
+      break;
+    default:
+      return False;
+  }
+  return True;
+}
+
+/****************************************************************************
+ Function
+   Post
+ Parameters
+   uint8_t Who : the service posted to
+   uint8_t What : the event type
+   uint8_t Depth : events in its queue after the post
+ Returns
+   None
+ Description
+   notes when the event went into the queue, for its wait
+ Notes
+   a coalesced post (COALESCE_EVENT_LIST) took out the pending event of its
+   type and went on the back of the queue, so the depth does not grow and
+   the wait runs from the latest post
+ Author
+   Alex Loo, 10/18/26, 05:14
+****************************************************************************/
+static void Post( uint8_t Who, uint8_t What, uint8_t Depth )
+{
+  Service_t *pServ = &Services[Who];
+  uint16_t Index = 0;
+  uint16_t i;
+
+  pServ->Seen = True;
+  if ( (pServ->NumPending != 0) && (Depth <= pServ->NumPending) ) {
+    pServ->Coalesced++;
+    // take out the one it replaced, or the oldest if the trace missed it
+    for ( i = 0; i < pServ->NumPending; i++ ) {
+      Index = (uint16_t)((pServ->PendingHead + i) % MAX_PENDING);
+      if ( pServ->PendingType[Index] == What )
+        break;
+    }
+    if ( i == pServ->NumPending )
+      i = 0;
+    for ( i++; i < pServ->NumPending; i++ ) {
+      Index = (uint16_t)((pServ->PendingHead + i - 1) % MAX_PENDING);
+      pServ->Pending[Index] = pServ->Pending[(Index + 1) % MAX_PENDING];
+      pServ->PendingType[Index] = pServ->PendingType[(Index + 1) % MAX_PENDING];
+    }
+    pServ->NumPending--;
+  }
+  if ( pServ->NumPending < MAX_PENDING ) {
+    Index = (uint16_t)((pServ->PendingHead + pServ->NumPending) % MAX_PENDING);
+    pServ->Pending[Index] = Now;
+    pServ->PendingType[Index] = What;
+    pServ->NumPending++;
+  }
+  if ( Depth > pServ->MaxDepth )
+    pServ->MaxDepth = Depth;
+  Counter( Who, Depth );
+}
+
+/****************************************************************************
+ Function
+   DeQueue
+ Parameters
+   uint8_t Who : the service
+   uint8_t Depth : events left in its queue
+ Returns
+   None
+ Description
+   takes the oldest post off the service's pending list; its wait goes with
+   the START that follows
+ Notes
+   events posted before the oldest record in the trace have no post time,
+   and their wait is not known
+ Author
+   Alex Loo, 10/18/26, 05:17
+****************************************************************************/
+static void DeQueue( uint8_t Who, uint8_t Depth )
+{
+  Service_t *pServ = &Services[Who];
+
+  pServ->Seen = True;
+  // posts the trace missed leave the list short; the oldest are the ones
+  // missing, so only the newest Depth + 1 posts are known
+  pServ->Wait = -1;
+  if ( pServ->NumPending == Depth + 1 ) {
+    pServ->Wait = (int64_t)(Now - pServ->Pending[pServ->PendingHead]);
+    pServ->PendingHead = (uint16_t)((pServ->PendingHead + 1) % MAX_PENDING);
+    pServ->NumPending--;
+  } else if ( pServ->NumPending > Depth ) {
+    pServ->PendingHead = (uint16_t)((pServ->PendingHead + pServ->NumPending -
+                                     Depth) % MAX_PENDING);
+    pServ->NumPending = Depth;
+  }
+  Counter( Who, Depth );
+}
+
+/****************************************************************************
+ Function
+   Start
+ Parameters
+   uint8_t Who : the service
+   uint8_t What : the event type
+   uint8_t Param : the low byte of the event parameter
+ Returns
+   None
+ Description
+   the service's run function is running on the event
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 05:20
+****************************************************************************/
+static void Start( uint8_t Who, uint8_t What, uint8_t Param )
+{
+  Service_t *pServ = &Services[Who];
+
+  pServ->Seen = True;
+  pServ->Running = True;
+  pServ->StartTime = Now;
+  pServ->Event = What;
+  pServ->Param = Param;
+}
+
+/****************************************************************************
+ Function
+   End
+ Parameters
+   uint8_t Who : the service
+ Returns
+   None
+ Description
+   writes the slice for the run that has ended
+ Notes
+   an END with no START (the dump began part way into the run) is skipped
+ Author
+   Alex Loo, 10/18/26, 05:22
+****************************************************************************/
+static void End( uint8_t Who )
+{
+  Service_t *pServ = &Services[Who];
+  uint64_t Took;
+
+  if ( pServ->Running == False )
+    return;
+  pServ->Running = False;
+  Took = Now - pServ->StartTime;
+  pServ->Runs++;
+  pServ->RunTotal += Took;
+  if ( Took > pServ->RunMax )
+    pServ->RunMax = Took;
+  BeginEvent();
+  printf( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+          "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"param\":%u",
+          AppNames_Event( pServ->Event ), Who, Microseconds( pServ->StartTime ),
+          Microseconds( Took ), pServ->Param );
+  if ( pServ->Wait >= 0 ) {
+    pServ->Waits++;
+    pServ->WaitTotal += (uint64_t)pServ->Wait;
+    if ( (uint64_t)pServ->Wait > pServ->WaitMax )
+      pServ->WaitMax = (uint64_t)pServ->Wait;
+    printf( ",\"wait_us\":%.3f", Microseconds( (uint64_t)pServ->Wait ) );
+  }
+  printf( "}}" );
+}
+
+/****************************************************************************
+ Function
+   ChangeState
+ Parameters
+   uint8_t Who : the machine, its LOG_ source
+   uint8_t New : the state it went to
+   uint8_t Old : the state it left
+ Returns
+   None
+ Description
+   writes the slice for the state left
+ Notes
+   the first transition of a machine in the trace starts its slice at the
+   time of the first record
+ Author
+   Alex Loo, 10/18/26, 05:25
+****************************************************************************/
+static void ChangeState( uint8_t Who, uint8_t New, uint8_t Old )
+{
+  Machine_t *pMach = &Machines[Who];
+
+  if ( pMach->Seen == False ) {
+    pMach->Seen = True;
+    pMach->Since = FirstTime;
+  }
+  BeginEvent();
+  printf( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+          "\"ts\":%.3f,\"dur\":%.3f}", AppNames_State( Who, Old ), MACHINE_TID + Who,
+          Microseconds( pMach->Since ), Microseconds( Now - pMach->Since ) );
+  pMach->State = New;
+  pMach->Since = Now;
+}
+
+/****************************************************************************
+ Function
+   Counter
+ Parameters
+   uint8_t Who : the service
+   uint8_t Depth : events in its queue
+ Returns
+   None
+ Description
+   writes the depth of the service's queue to its counter
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 05:27
+****************************************************************************/
+static void Counter( uint8_t Who, uint8_t Depth )
+{
+  BeginEvent();
+  printf( "{\"name\":\"queue %u\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+          "\"args\":{\"depth\":%u}}", Who, Microseconds( Now ), Depth );
+}
+
+/****************************************************************************
+ Function
+   BeginEvent
+ Parameters
+   None
+ Returns
+   None
+ Description
+   the comma between JSON events
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 05:28
+****************************************************************************/
+static void BeginEvent( void )
+{
+  if ( NumEvents++ != 0 )
+    printf( ",\n" );
+}
+
+/****************************************************************************
+ Function
+   FinishTracks
+ Parameters
+   None
+ Returns
+   None
+ Description
+   ends each machine's last state, and any run, at the last record, and
+   names the tracks
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 05:30
+****************************************************************************/
+static void FinishTracks( void )
+{
+  unsigned i;
+
+  BeginEvent();
+  printf( "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"ES_Run\"}}" );
+  for ( i = 0; i < MAX_SERVICES; i++ ) {
+    if ( Services[i].Seen == False )
+      continue;
+    End( (uint8_t)i );
+    BeginEvent();
+    printf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"name\":\"service %u\"}}", i, i );
+  }
+  for ( i = 0; i < MAX_MACHINES; i++ ) {
+    if ( Machines[i].Seen == False )
+      continue;
+    BeginEvent();
+    printf( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+            "\"ts\":%.3f,\"dur\":%.3f}",
+            AppNames_State( (uint8_t)i, Machines[i].State ), MACHINE_TID + i,
+            Microseconds( Machines[i].Since ),
+            Microseconds( Now - Machines[i].Since ) );
+    BeginEvent();
+    printf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"name\":\"%s\"}}", MACHINE_TID + i,
+            AppNames_Machine( (uint8_t)i ) );
+  }
+  if ( NumTimers != 0 ) {
+    BeginEvent();
+    printf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"timers\"}}", TIMER_TID );
+  }
+}
+
+/****************************************************************************
+ Function
+   Summarize
+ Parameters
+   None
+ Returns
+   None
+ Description
+   prints, for each service, its runs and how long they took, how long its
+   events waited, its deepest queue, and its coalesced and dropped posts
+ Notes
+   to stderr, stdout is the JSON
+ Author
+   Alex Loo, 10/18/26, 05:33
+****************************************************************************/
+static void Summarize( void )
+{
+  Service_t *pServ;
+  unsigned i;
+
+  fprintf( stderr, "service  runs  run uS mean/max    wait uS mean/max"
+           "  depth  coalesced  drops\n" );
+  for ( i = 0; i < MAX_SERVICES; i++ ) {
+    pServ = &Services[i];
+    if ( pServ->Seen == False )
+      continue;
+    fprintf( stderr, "%7u %5lu  %8.1f %8.1f   %8.1f %8.1f  %5u  %9lu  %5lu\n",
+             i, (unsigned long)pServ->Runs,
+             (pServ->Runs != 0) ?
+               Microseconds( pServ->RunTotal ) / pServ->Runs : 0.0,
+             Microseconds( pServ->RunMax ),
+             (pServ->Waits != 0) ?
+               Microseconds( pServ->WaitTotal ) / pServ->Waits : 0.0,
+             Microseconds( pServ->WaitMax ), pServ->MaxDepth,
+             (unsigned long)pServ->Coalesced, (unsigned long)pServ->Drops );
+  }
+}
+
+/****************************************************************************
+ Function
+   Microseconds
+ Parameters
+   uint64_t Time : fine time counts
+ Returns
+   double : the same in microseconds
+ Description
+   for the JSON, whose times are microseconds
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 05:38
+****************************************************************************/
+static double Microseconds( uint64_t Time )
+{
+  return (double)Time / (double)FinePerUs;
+}
+/*------------------------------ End of file ------------------------------*/
@@ -0,0 +1,5 @@
+/****************************************************************************
+ Host stand-in for <Bin_Const.h>. The file is in the repo, where the angle
+ brackets do not look on the host.
+ ****************************************************************************/
+#include "../../Bin_Const.h"
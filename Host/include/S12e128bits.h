@@ -0,0 +1,6 @@
+/****************************************************************************
+ Host stand-in for <S12e128bits.h>, for the application modules that the
+ arena simulator (../SimMatch.c) builds as they are. They only need the
+ BITnHI masks from it.
+ ****************************************************************************/
+#include <bitdefs.h>
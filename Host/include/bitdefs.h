@@ -0,0 +1,5 @@
+/****************************************************************************
+ Host stand-in for <bitdefs.h>. The file in the repo is BITDEFS.H, which a
+ case sensitive file system will not find under this name.
+ ****************************************************************************/
+#include "../../BITDEFS.H"
@@ -0,0 +1,12 @@
+/****************************************************************************
+ Host stand-in for the CodeWarrior <hidef.h>, for the application modules
+ that the arena simulator (../SimMatch.c) builds as they are. There are no
+ interrupts to turn on or off on the host.
+ ****************************************************************************/
+#ifndef HIDEF_H
+#define HIDEF_H
+
+#define EnableInterrupts
+#define DisableInterrupts
+
+#endif /* HIDEF_H */
@@ -0,0 +1,13 @@
+/****************************************************************************
+ Host stand-in for the CodeWarrior <mc9s12e128.h>, for the application
+ modules that the arena simulator (../SimMatch.c) builds as they are. Only
+ the registers those modules touch are here; ../RobotSim.c defines them.
+ ****************************************************************************/
+#ifndef MC9S12E128_H
+#define MC9S12E128_H
+
+// port P, the team LEDs (SideID.c)
+extern volatile unsigned char PTP;
+extern volatile unsigned char DDRP;
+
+#endif /* MC9S12E128_H */
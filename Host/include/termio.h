@@ -0,0 +1,14 @@
+/****************************************************************************
+ Host stand-in for the CodeWarrior <termio.h>. The S12 version is implemented
+ in termio.c, which host programs build against SCISim.c; the others link
+ HostConsole.c for kbhit
+ ****************************************************************************/
+#ifndef TERMIO_H
+#define TERMIO_H
+
+char TERMIO_GetChar(void);
+void TERMIO_PutChar(char ch);
+void TERMIO_Init(void);
+int kbhit(void);
+
+#endif /* TERMIO_H */
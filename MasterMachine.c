@@ -14,6 +14,11 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 11:35 adl     logs the beacon found at start, for the replay
+ 10/18/26 10:50 adl     variables in a MasterMachine_t, see ES_Instance.h
+ 10/18/26 04:35 adl     state transitions go to the event trace
+ 10/18/26 01:35 adl     events, entries and exits go to the deferred log
+ 10/17/26 21:55 adl     takes the application's timers from the timer pool
  02/24/12 13:30 adl     Began tailoring of template to be our MasterMachine
  01/15/12 11:12 jec      revisions for Gen2 framework
  11/07/11 11:26 jec      made the queue static
@@ -30,6 +35,7 @@
 
 #include "ES_Configure.h"
 #include "ES_Framework.h"
+#include "ES_Trace.h"
 #include "ES_PostList.h"
 
 // Includes for statemachines
@@ -48,7 +54,7 @@
 #include "BinControl.h"
 #include "DefendingMode.h"
 
-#include "EventPrinter.h"
+#include "ES_Log.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 //#define DEBUG
@@ -57,19 +63,26 @@
 /* prototypes for private functions for this machine.They should be functions
    relevant to the behavior of this state machine
 */
-static ES_Event DuringGatheringState(ES_Event ThisEvent);
-static ES_Event DuringScoring (ES_Event ThisEvent);
-static ES_Event DuringDefending (ES_Event ThisEvent);
+static ES_Event DuringGatheringState(ES_ME_(MasterMachine_t) ES_Event ThisEvent);
+static ES_Event DuringScoring (ES_ME_(MasterMachine_t) ES_Event ThisEvent);
+static ES_Event DuringDefending (ES_ME_(MasterMachine_t) ES_Event ThisEvent);
 static ES_Event DuringGameOver (ES_Event ThisEvent);
 
 /*---------------------------- Module Variables ---------------------------*/
-// everybody needs a state variable, you may need others as well.
-// type of state variable should match htat of enum in header file
-static MasterMachineState_t CurrentState;
+// everybody needs a state variable, you may need others as well. They are
+// in a MasterMachine_t: with ES_INSTANCES each function is passed the one to
+// use as Me, without it this is the only one
+#if !ES_INSTANCES
+static MasterMachine_t TheMasterMachine = MASTER_MACHINE_INIT;
+#define Me (&TheMasterMachine)
+#endif
 
 // with the introduction of Gen2, we need a module level Priority var as well
 static uint8_t MyPriority;
 
+// the handles of the application's timers, see TimingConstants.h
+ES_TimerHandle_t AppTimer[NUM_APP_TIMERS];
+
 
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
@@ -86,6 +99,8 @@ static uint8_t MyPriority;
      Saves away the priority, sets up the initial transition and does any 
      other required initialization for this state machine
  Notes
+     also takes the application's timers from the timer pool. With
+     ES_INSTANCES each robot's MasterMachine_t is started by its owner
 
  Author
      J. Edward Carryer, 10/23/11, 18:55
@@ -93,9 +108,24 @@ static uint8_t MyPriority;
 boolean InitMasterMachine ( uint8_t Priority )
 {
   ES_Event ThisEvent;
+  unsigned char i;
 
   MyPriority = Priority;
   
+  // Take a timer from the pool for each of the application's timers. Each
+  // posts ES_TIMEOUT to us with its AppTimer_t name as the parameter
+  ThisEvent.EventType = ES_TIMEOUT;
+  for (i = 0; i < NUM_APP_TIMERS; i++)
+  {
+     ThisEvent.EventParam = i;
+     AppTimer[i] = ES_Timer_Alloc(PostMasterMachine, ThisEvent);
+     if (AppTimer[i] == ES_TIMER_NO_HANDLE)
+     {
+        printf("\r\nOut of timers, raise ES_NUM_TIMERS.");
+        return False;
+     }
+  }
+  
   // Initialize the MotorDriver module
    MotorDriver_Init();
    // Initialize the interrupt based sensor module
@@ -111,9 +141,11 @@ boolean InitMasterMachine ( uint8_t Priority )
    
    printf("\r\nModule initialization sequence complete.");
    
+#if !ES_INSTANCES
    ThisEvent.EventType = ES_ENTRY;
    // Start the MasterMachine state machine
    StartMasterMachine(ThisEvent);
+#endif
    
    return True;
 }
@@ -157,7 +189,7 @@ boolean PostMasterMachine( ES_Event ThisEvent )
  Author
    Alex Loo, 02/24/12, 18:07
 ****************************************************************************/
-void StartMasterMachine (ES_Event CurrentEvent)
+void StartMasterMachine ( ES_ME_(MasterMachine_t) ES_Event CurrentEvent)
 {
    unsigned char BeaconSeen = 0;
    // Local variable to allow the debugger to see the value of CurrentEvent
@@ -166,9 +198,14 @@ void StartMasterMachine (ES_Event CurrentEvent)
    // Turn the fans on
    FanControl(1);
    
+   #if ES_INSTANCES
+   // The defending machine defends the bin that the scoring machine picked
+   Me->Defending.Scoring = &Me->Scoring;
+   #endif
+   
    #ifndef DEBUG
    // MasterMachine SM always starts in PreGame mode
-   CurrentState = PreGame;
+   Me->CurrentState = PreGame;
    
    // Run entry function for state PreGame
    // Find a beacon on either front or back
@@ -184,9 +221,11 @@ void StartMasterMachine (ES_Event CurrentEvent)
    } while (BeaconSeen == 0);
    printf("\r\nFound beacon %u on our side.", BeaconSeen);
    #endif
+   // The beacon is read here, not posted, so the replay needs it logged
+   ES_LogNote(LOG_MASTER, NOTE_START_BEACON, BeaconSeen);
    
    #ifdef DEBUG
-   CurrentState = PreGame;
+   Me->CurrentState = PreGame;
    BeaconSeen = 1;
    #endif
    
@@ -195,9 +234,9 @@ void StartMasterMachine (ES_Event CurrentEvent)
    ID_IdentifySide(BeaconSeen);
 
    printf("\r\nMasterMachine SM start sequence complete.");
-      printf("\r\n\nENTERING the PreGame state.");
+      ES_LogEntry(LOG_MASTER, PreGame);
    // Run the MasterMachine SM
-   RunMasterMachine(LocalEvent); // use LocalEvent to avoid unused variable warnings   
+   RunMasterMachine(ES_WITH_(Me) LocalEvent); // use LocalEvent to avoid unused variable warnings   
 }
 
 /****************************************************************************
@@ -217,35 +256,33 @@ void StartMasterMachine (ES_Event CurrentEvent)
  Author
    J. Edward Carryer, 01/15/12, 15:23
 ****************************************************************************/
-ES_Event RunMasterMachine( ES_Event ThisEvent )
+ES_Event RunMasterMachine( ES_ME_(MasterMachine_t) ES_Event ThisEvent )
 {
-   static uint16_t LastTime = 0;
    uint16_t CurrentTime;
    unsigned char BallsInBin = 0;
    boolean MakeTransition = False; // are we making a state transition?
-   MasterMachineState_t NextState = CurrentState;
+   MasterMachineState_t NextState = Me->CurrentState;
    // Top level state machine should always return no event in the absence of an error
    ES_Event ReturnEvent;
    ReturnEvent.EventType = ES_NO_EVENT;
    
    
-   // Test section for printing the balls collected every few seconds
+   // Test section for logging the balls collected every few seconds
    CurrentTime = ES_Timer_GetTime();
-   if(CurrentTime - LastTime > 2 _SECONDS_TIMER)
+   if(CurrentTime - Me->LastBallLogTime > 2 _SECONDS_TIMER)
    {
       BallsInBin = QS_QueryBallCount();
-      printf("\r\n\nBalls in bin = %u\n\n", BallsInBin);      
-      LastTime = CurrentTime; // update last time
+      ES_LogNote(LOG_MASTER, NOTE_BALLS_IN_BIN, BallsInBin);
+      Me->LastBallLogTime = CurrentTime; // update last time
    }
    // End test section
    
    
-   EventPrinter(ThisEvent);
+   ES_LogEvent(LOG_MASTER, Me->CurrentState, ThisEvent);
    // Begin switch on states of the MasterMachine
-   switch (CurrentState)
+   switch (Me->CurrentState)
    {
       case PreGame:
-         printf("\r\nIn the PreGame state.");
          // This is a flat state before the game starts. It is only waiting for a non-
          // zero response from the FSR for balls present
          if (ThisEvent.EventType == ES_GAME_START)
@@ -264,19 +301,16 @@ ES_Event RunMasterMachine( ES_Event ThisEvent )
             
             // Set timers for game tracking
             // Set timer indicating that the game is over
-            ES_Timer_SetTimer(END_GAME_TIMER, LENGTH_OF_GAME);
-            ES_Timer_StartTimer(END_GAME_TIMER);
+            ES_Timer_InitTimer(AppTimer[END_GAME_TIMER], LENGTH_OF_GAME);
             // Set timer to advance to the scoring mode
-            ES_Timer_SetTimer(GO_TO_SCORING_TIMER, PROCEED_TO_SCORING);
-            ES_Timer_StartTimer(GO_TO_SCORING_TIMER); 
+            ES_Timer_InitTimer(AppTimer[GO_TO_SCORING_TIMER], PROCEED_TO_SCORING); 
          }
          break;
       
       case Gathering:
-         printf("\r\nIn the Gathering state.");
          // Run during function for the Gathering state. Entry and Exits are processed 
          // here
-         ThisEvent = DuringGatheringState(ThisEvent);
+         ThisEvent = DuringGatheringState(ES_WITH_(Me) ThisEvent);
          
          // Process any events 
          if (ThisEvent.EventType != ES_NO_EVENT)
@@ -303,10 +337,9 @@ ES_Event RunMasterMachine( ES_Event ThisEvent )
       break; // End Gathering state
       
       case Scoring:
-         printf("\r\nIn the Scoring state.");
       	// Run during function for the Gathering state. Entry and Exits are 
       	// processed here
-      	ThisEvent = DuringScoring(ThisEvent);
+      	ThisEvent = DuringScoring(ES_WITH_(Me) ThisEvent);
       	
       	// Process any events
       	if (ThisEvent.EventType != ES_NO_EVENT)
@@ -333,10 +366,9 @@ ES_Event RunMasterMachine( ES_Event ThisEvent )
       break;
       
       case Defending:
-         printf("\r\nIn the Defending state.");
          // Run during function for the Gathering state. Entry and Exits are 
       	// processed here
-      	ThisEvent = DuringDefending(ThisEvent);
+      	ThisEvent = DuringDefending(ES_WITH_(Me) ThisEvent);
       	
       	// Process any events
       	if (ThisEvent.EventType != ES_NO_EVENT)
@@ -357,7 +389,6 @@ ES_Event RunMasterMachine( ES_Event ThisEvent )
       break;
       
       case GameOver:
-         printf("\r\nIn the GameOver state.");
          ThisEvent = DuringGameOver(ThisEvent);
          
          // No other actions in this state
@@ -370,13 +401,14 @@ ES_Event RunMasterMachine( ES_Event ThisEvent )
    {
    	// Execute exit function for current state
    	ThisEvent.EventType = ES_EXIT;
-   	RunMasterMachine(ThisEvent);
+   	RunMasterMachine(ES_WITH_(Me) ThisEvent);
    	
-   	CurrentState = NextState; // Update the state variable
+   	ES_TraceState(LOG_MASTER, Me->CurrentState, NextState);
+   	Me->CurrentState = NextState; // Update the state variable
    	
    	// Execute the entry function for the new state
    	ThisEvent.EventType = ES_ENTRY;
-   	RunMasterMachine(ThisEvent);
+   	RunMasterMachine(ES_WITH_(Me) ThisEvent);
    }
   	return ReturnEvent;
 }
@@ -398,9 +430,9 @@ ES_Event RunMasterMachine( ES_Event ThisEvent )
  Author
      J. Edward Carryer, 10/23/11, 19:21
 ****************************************************************************/
-MasterMachineState_t QueryMasterMachine ( void )
+MasterMachineState_t QueryMasterMachine ( ES_ME(const MasterMachine_t) )
 {
-   return(CurrentState);
+   return(Me->CurrentState);
 }
 
 /***************************************************************************
@@ -425,7 +457,7 @@ MasterMachineState_t QueryMasterMachine ( void )
  Author
      Alex Loo, 2/25/2012/ 18:00
 ****************************************************************************/
-static ES_Event DuringGatheringState(ES_Event ThisEvent)
+static ES_Event DuringGatheringState(ES_ME_(MasterMachine_t) ES_Event ThisEvent)
 {
    // Local variable for debugger
    ES_Event NewEvent = ThisEvent;
@@ -433,26 +465,26 @@ static ES_Event DuringGatheringState(ES_Event ThisEvent)
    // Process ES_ENTRY and ES_EXIT events
    if (ThisEvent.EventType == ES_ENTRY)
    {
-      printf("\r\n\nENTERING the Gathering state.");
+      ES_LogEntry(LOG_MASTER, Gathering);
       // Run any start functions required for the statemachine
-      StartGatheringSM(ThisEvent);
+      StartGatheringSM(ES_WITH_(&Me->Gathering) ThisEvent);
    }
    else if (ThisEvent.EventType == ES_EXIT)
    {
-      printf("\r\n\nEXITING the Gathering state.");
+      ES_LogExit(LOG_MASTER, Gathering);
       // Have lower level machines clean up on exit
-      NewEvent = RunGatheringSM(ThisEvent);
+      NewEvent = RunGatheringSM(ES_WITH_(&Me->Gathering) ThisEvent);
    }
    else
    {
       // Run the during function for this state
       // Run the lower level state machine
-      NewEvent = RunGatheringSM(ThisEvent);
+      NewEvent = RunGatheringSM(ES_WITH_(&Me->Gathering) ThisEvent);
    }
    return NewEvent;  
 }
 
-static ES_Event DuringScoring (ES_Event ThisEvent)
+static ES_Event DuringScoring (ES_ME_(MasterMachine_t) ES_Event ThisEvent)
 {
    // Local variable for debugger
    ES_Event NewEvent = ThisEvent;
@@ -460,27 +492,27 @@ static ES_Event DuringScoring (ES_Event ThisEvent)
    // Process ES_ENTRY and ES_EXIT events
    if (ThisEvent.EventType == ES_ENTRY)
    {
-      printf("\r\n\nENTERING the Scoring state.");
+      ES_LogEntry(LOG_MASTER, Scoring);
       // Run any start functions required for this state machine
-      StartScoringSM(ThisEvent);
+      StartScoringSM(ES_WITH_(&Me->Scoring) ThisEvent);
    }
    else if (ThisEvent.EventType == ES_EXIT)
    {
-      printf("\r\n\nEXITING the Scoring state.");
+      ES_LogExit(LOG_MASTER, Scoring);
       // Have lower level machines clean up on exit
-      NewEvent = RunScoringSM(ThisEvent);
+      NewEvent = RunScoringSM(ES_WITH_(&Me->Scoring) ThisEvent);
       // No exit functions for Scoring state
    }
    else 
    {
       // No during function for this state
       // Run the lower level state machine
-      NewEvent = RunScoringSM(ThisEvent);
+      NewEvent = RunScoringSM(ES_WITH_(&Me->Scoring) ThisEvent);
    }
    return NewEvent;	
 }
 
-static ES_Event DuringDefending (ES_Event ThisEvent)
+static ES_Event DuringDefending (ES_ME_(MasterMachine_t) ES_Event ThisEvent)
 {
    // Local variable for debugger
    ES_Event NewEvent = ThisEvent;
@@ -488,15 +520,15 @@ static ES_Event DuringDefending (ES_Event ThisEvent)
    // Process ES_ENTRY and ES_EXIT events
    if (ThisEvent.EventType == ES_ENTRY)
    {
-      printf("\r\n\nENTERING the Defending state.");
+      ES_LogEntry(LOG_MASTER, Defending);
       // Run any start fucntions required for this state machine
-      StartDefendingSM(ThisEvent);      
+      StartDefendingSM(ES_WITH_(&Me->Defending) ThisEvent);      
    }
    else if (ThisEvent.EventType == ES_EXIT)
    {
-      printf("\r\n\nEXITING the Defending state.");
+      ES_LogExit(LOG_MASTER, Defending);
       // Have lower level machines clean up on exit
-      NewEvent = RunDefendingSM(ThisEvent);
+      NewEvent = RunDefendingSM(ES_WITH_(&Me->Defending) ThisEvent);
       
       // Run exit functions for Defending state
       FullStop(); // shut down wheels
@@ -507,7 +539,7 @@ static ES_Event DuringDefending (ES_Event ThisEvent)
       // No during function for this state
       // Run the lower level state machine
       //printf("\r\nRunning RundefendingSM as part of the state's during function.");
-      NewEvent = RunDefendingSM(ThisEvent);  
+      NewEvent = RunDefendingSM(ES_WITH_(&Me->Defending) ThisEvent);  
    }
    return NewEvent; 	
 }
@@ -520,7 +552,11 @@ static ES_Event DuringGameOver (ES_Event ThisEvent)
    // Process ES_ENTRY and ES_EXIT events
    if (ThisEvent.EventType == ES_ENTRY)
    {
-      printf("\r\n\nENTERING the GameOver state.");
+      ES_LogEntry(LOG_MASTER, GameOver);
+#if ES_TRACE
+      // the match is over, dump the trace of its last moments
+      ES_RequestTraceDump();
+#endif
       // Shut down all motors
       FullStop(); // shut down wheels
       //FanControl(0);// shut down fans
@@ -531,7 +567,7 @@ static ES_Event DuringGameOver (ES_Event ThisEvent)
    }
    else if (ThisEvent.EventType == ES_EXIT)
    {
-      printf("\r\n\nEXITING the GameOver state.");
+      ES_LogExit(LOG_MASTER, GameOver);
    }
    else
    {
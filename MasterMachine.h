@@ -11,6 +11,12 @@
 // Event Definitions
 #include "ES_Configure.h"
 #include "ES_Types.h"
+#include "ES_Instance.h"
+#if ES_INSTANCES
+#include "GatheringSM.h"
+#include "ScoringSM.h"
+#include "DefendingSM.h"
+#endif
 
 // typedefs for the states
 // State definitions for use with the query function
@@ -23,14 +29,41 @@ typedef enum { InitPState, UnlockWaiting, _1UnlockPress,
                Defending,
                GameOver} MasterMachineState_t ;
 
+// the variables of one robot's MasterMachine, see ES_Instance.h. With
+// ES_INSTANCES each robot's sub-machines are in it too, without it each
+// sub-machine has its own only instance
+typedef struct
+{
+   MasterMachineState_t CurrentState;
+   uint16_t LastBallLogTime;  // when the balls collected were last logged
+#if ES_INSTANCES
+   GatheringSM_t Gathering;
+   ScoringSM_t Scoring;
+   DefendingSM_t Defending;
+#endif
+} MasterMachine_t;
+
+#if ES_INSTANCES
+#define MASTER_MACHINE_INIT { InitPState, 0, GATHERING_SM_INIT, \
+                              SCORING_SM_INIT, DEFENDING_SM_INIT }
+#else
+#define MASTER_MACHINE_INIT { InitPState, 0 }
+#endif
+
+// codes for this machine's log notes (LOG_MASTER). Host/Replay reads the
+// beacon that StartMasterMachine found from NOTE_START_BEACON.
+// NOTE_GAME_START is Check4Start's, with the balls in play at the start
+#define NOTE_BALLS_IN_BIN 1
+#define NOTE_START_BEACON 2
+#define NOTE_GAME_START 3
 
 // Public Function Prototypes
 
 boolean InitMasterMachine ( uint8_t);
 boolean PostMasterMachine( ES_Event);
-void StartMasterMachine(ES_Event);
-ES_Event RunMasterMachine( ES_Event);
-MasterMachineState_t QueryMasterMachine ( void );
+void StartMasterMachine( ES_ME_(MasterMachine_t) ES_Event);
+ES_Event RunMasterMachine( ES_ME_(MasterMachine_t) ES_Event);
+MasterMachineState_t QueryMasterMachine ( ES_ME(const MasterMachine_t) );
 
 
 #endif /* MasterMachine_H */
@@ -14,12 +14,15 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/17/26 22:30 adl  Timer 0 overflows also counted for ES_Timer_GetFineTime
+ 10/17/26 16:05 adl  ISRs post through their ISR rings
  02/21/12 14:53 adl  First pass
 ****************************************************************************/
 
 // Includes ******************************************************
 #include "ES_Configure.h"  /* get the typedefs for the components of an event*/
 #include "ES_Framework.h"
+#include "ES_ISRRing.h"     /* posting from the ISRs */
 #include <hidef.h>         /* common defines and macros */
 #include <mc9s12e128.h>     /* derivative information */
 #include <S12e128bits.h>    /* bit definitions  */
@@ -198,6 +201,7 @@ void interrupt _Vec_tim0ovf TIM0_OverFlowCounter(void)
 {
 	//DisableInterrupts;
 	TIM0_uOverFlows++; // Increment timer overflow counter
+	ES_Timer_FineOverflow(); // and the fine timebase's, before TOF clears
 	TIM0_TFLG2 = _S12_TOF; // Clear the timer overflow flag
 	//EnableInterrupts;
 	//printf("\r\nTimer 0 has overflowed.");
@@ -257,7 +261,7 @@ void interrupt _Vec_tim0ch5 FoundTape_Left(void)
 		ES_Event ThisEvent; // Create an event
 		ThisEvent.EventType = ES_LEFT_TAPE_DETECTED; // Save the current event type
 		ThisEvent.EventParam = (uint16_t)(TimeOfCurrentEdge/(1 _SEC_)); // Pass input compare of the current event
-		PostMasterMachine(ThisEvent); // Post the event to post list 00
+		ES_ISRRing_Post(LEFT_TAPE_RING, ThisEvent); // Post the event to the ISR ring
 	}
 	TimeOfLastEdge = TimeOfCurrentEdge; // Update the last time, in clock ticks
 	//printf("\r\nLEFT tape interrupt has triggered.");
@@ -292,7 +296,7 @@ void interrupt _Vec_tim0ch6 FoundTape_Right(void)
 		ES_Event ThisEvent; // Create an event
 		ThisEvent.EventType = ES_RIGHT_TAPE_DETECTED; // Save the current event type
 		ThisEvent.EventParam = (uint16_t)(TimeOfCurrentEdge/(1 _SEC_)); // Pass input compare of the current event
-		PostMasterMachine(ThisEvent); // Post the event to post list 00
+		ES_ISRRing_Post(RIGHT_TAPE_RING, ThisEvent); // Post the event to the ISR ring
 	}
 	TimeOfLastEdge = TimeOfCurrentEdge; // Update the last time, in clock ticks
 	//printf("\r\nRIGHT tape interrupt has triggered.");
@@ -327,7 +331,7 @@ void interrupt _Vec_tim0ch7 Bumper_Front(void)
 		ES_Event ThisEvent; // Create an event
 		ThisEvent.EventType = ES_FRONT_BUMPED; // Save the current event type
 		ThisEvent.EventParam = (uint16_t)(TimeOfCurrentEdge/(1 _SEC_)); // Pass input compare of the current event
-		PostMasterMachine(ThisEvent); // Post the event to post list 00
+		ES_ISRRing_Post(FRONT_BUMPER_RING, ThisEvent); // Post the event to the ISR ring
 	}
 	TimeOfLastEdge = TimeOfCurrentEdge; // Update the last time, in clock ticks
 	//printf("\r\nFRONT bumper interrupt has triggered.");
@@ -363,7 +367,7 @@ void interrupt _Vec_tim1ch4 Bumper_Rear(void)
 		ES_Event ThisEvent; // Create an event
 		ThisEvent.EventType = ES_REAR_BUMPED; // Save the current event type
 		ThisEvent.EventParam = (uint16_t)(TimeOfCurrentEdge/(1 _SEC_));; // Pass input compare of the current event
-		PostMasterMachine(ThisEvent); // Post the event to post list 00	
+		ES_ISRRing_Post(REAR_BUMPER_RING, ThisEvent); // Post the event to the ISR ring	
 	}
 
 	TimeOfLastEdge = TimeOfCurrentEdge; // Update the last time, in clock ticks
@@ -7,6 +7,9 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 14:35 adl  no bin is taken as open before the FSR reports the wall
+ 10/18/26 10:40 adl  bins in a ScoringMode_t, see ES_Instance.h
+ 10/17/26 23:45 adl  wall angle and bin counts read from FieldState
  02/21/12 14:53 adl  First pass
 ****************************************************************************/
 
@@ -21,7 +24,7 @@
 #include "ES_PostList.h"	/* prototypes for posting events */
 #include "TimingConstants.h"
 #include "ScoringMode.h"
-#include "FSR.h"
+#include "FieldState.h"
 #include "SideID.h"
 
 // Module Defines ************************************************
@@ -30,8 +33,12 @@
 // Module Private Functions **************************************
 
 // Module Variables **********************************************
-// Define variables which determine if a bin is available
-static Bin Bins[4] = { {1,0,Blocked,False},{2,0,Blocked,False},{3,0,Blocked,False},{4,0,Blocked,False} };
+// Define variables which determine if a bin is available. With ES_INSTANCES
+// each function is passed the ScoringMode_t to use as Me
+#if !ES_INSTANCES
+static ScoringMode_t TheScoringMode = SCORING_MODE_INIT;
+#define Me (&TheScoringMode)
+#endif
 
 // Module Code ***************************************************
 
@@ -48,16 +55,26 @@ Returns
 Description
      	Determines which bins are available based on the wall angle
 Notes
+     	Until the FSR has reported the wall angle the bins keep the
+     	availability they had, Blocked at the start, so PickScoringBin goes
+     	on the ball counts alone
 
 Author
      Alex Loo, 2/26/2012, hours no longer hold meaning
 ****************************************************************************/
-void BinsAvailable (void)
+void BinsAvailable ( ES_ME(ScoringMode_t) )
 {
    // Variables local to the function: WallAngle, TeamColor
-   unsigned int WallAngle = Get_WallAngle();
+   unsigned int WallAngle = 0;
    unsigned char TeamColor = ID_QuerySide();
    
+   // Read the wall angle, as the FSR last reported it
+   if (QueryFieldState(FSR_WALL_ANGLE, &WallAngle, NULL) != True)
+   {
+      // No answer yet, so no angle to go on
+      return;
+   }
+   
    // Go through different regions of wall angle
    //If region between A and H
    if ((WallAngle > ANGLE_H) || (WallAngle < ANGLE_A))
@@ -66,15 +83,15 @@ void BinsAvailable (void)
       if (TeamColor == BLUE_TEAM)
       {
          // Bins #2 and #3 are available and unobstructed
-         Bins[1].BinAvailable = Full;
-         Bins[2].BinAvailable = Full;  
+         Me->Bins[1].BinAvailable = Full;
+         Me->Bins[2].BinAvailable = Full;  
       }
       //Else red team
       else
       {
          // Bins #1 and #4 are available and unobstructed
-         Bins[0].BinAvailable = Full;
-         Bins[3].BinAvailable = Full;   
+         Me->Bins[0].BinAvailable = Full;
+         Me->Bins[3].BinAvailable = Full;   
       }  //Endif 
    }
    //Else if region between A and B
@@ -84,18 +101,18 @@ void BinsAvailable (void)
       if (TeamColor == BLUE_TEAM)
       {  
          // Bin 3 is available and unobstructed
-         Bins[2].BinAvailable = Full;
+         Me->Bins[2].BinAvailable = Full;
       }
       //Else red team
       else
       {
          // Bin #1 is available and unobstructed
-         Bins[0].BinAvailable = Full;   
+         Me->Bins[0].BinAvailable = Full;   
       }  //Endif  \
       
       // Bins #2 and #4 are available but obstructed to both sides
-      Bins[1].BinAvailable = Partial;
-      Bins[3].BinAvailable = Partial;
+      Me->Bins[1].BinAvailable = Partial;
+      Me->Bins[3].BinAvailable = Partial;
    } 
    //Else if region between B and C
    else if ((WallAngle > ANGLE_B) && (WallAngle < ANGLE_C))
@@ -104,15 +121,15 @@ void BinsAvailable (void)
       if (TeamColor == BLUE_TEAM)
       {
          // Bins #3 and #4 are available and unobstructed
-         Bins[2].BinAvailable = Full;
-         Bins[3].BinAvailable = Full;
+         Me->Bins[2].BinAvailable = Full;
+         Me->Bins[3].BinAvailable = Full;
       }
       //Else red team
       else
       {
          // Bins #1 and #2 are available and unobstructed
-         Bins[0].BinAvailable = Full;
-         Bins[1].BinAvailable = Full;
+         Me->Bins[0].BinAvailable = Full;
+         Me->Bins[1].BinAvailable = Full;
       }  //Endif     
    } 
    //Else if region between C and D
@@ -122,18 +139,18 @@ void BinsAvailable (void)
       if (TeamColor == BLUE_TEAM)
       {  
          // Bin 4 is available and unobstructed
-         Bins[3].BinAvailable = Full;
+         Me->Bins[3].BinAvailable = Full;
       }
       //Else red team
       else
       {
          // Bin #2 is available and unobstructed
-         Bins[1].BinAvailable = Full;
+         Me->Bins[1].BinAvailable = Full;
       }  //Endif
       
       // Bins #1 and #3 are available but obstructed to both sides
-     Bins[0].BinAvailable = Partial;
-     Bins[2].BinAvailable = Partial;
+     Me->Bins[0].BinAvailable = Partial;
+     Me->Bins[2].BinAvailable = Partial;
    }
    //Else if region between D and E
    else if ((WallAngle > ANGLE_D) && (WallAngle < ANGLE_E))
@@ -142,15 +159,15 @@ void BinsAvailable (void)
       if (TeamColor == RED_TEAM)
       {
          // Bins #2 and #3 are available and unobstructed
-         Bins[1].BinAvailable = Full;
-         Bins[2].BinAvailable = Full; 
+         Me->Bins[1].BinAvailable = Full;
+         Me->Bins[2].BinAvailable = Full; 
       }
       //Else blue team
       else
       {
          // Bins #1 and #4 are available and unobstructed
-         Bins[0].BinAvailable = Full;
-         Bins[3].BinAvailable = Full;   
+         Me->Bins[0].BinAvailable = Full;
+         Me->Bins[3].BinAvailable = Full;   
       }  //Endif    
    }
    //Else if region between E and F
@@ -160,17 +177,17 @@ void BinsAvailable (void)
       if (TeamColor == RED_TEAM)
       {  
          // Bin 3 is available and unobstructed
-         Bins[2].BinAvailable = Full;
+         Me->Bins[2].BinAvailable = Full;
       }
       //Else blue team
       else
       {
          // Bin #1 is available and unobstructed
-         Bins[0].BinAvailable = Full; 
+         Me->Bins[0].BinAvailable = Full; 
       }  //Endif
       // Bins #2 and #4 are available but obstructed to both sides
-      Bins[1].BinAvailable = Partial;
-      Bins[3].BinAvailable = Partial;   
+      Me->Bins[1].BinAvailable = Partial;
+      Me->Bins[3].BinAvailable = Partial;   
    }
    //Else if region between F and G
    else if ((WallAngle > ANGLE_F) && (WallAngle < ANGLE_G))
@@ -179,15 +196,15 @@ void BinsAvailable (void)
       if (TeamColor == RED_TEAM)
       {
          // Bins #3 and #4 are available and unobstructed
-         Bins[2].BinAvailable = Full;
-         Bins[3].BinAvailable = Full;
+         Me->Bins[2].BinAvailable = Full;
+         Me->Bins[3].BinAvailable = Full;
       }
       //Else blue team
       else
       {
          //bins 1 and 2 are abailable and unobstructed
-         Bins[0].BinAvailable = Full;
-         Bins[1].BinAvailable = Full;            
+         Me->Bins[0].BinAvailable = Full;
+         Me->Bins[1].BinAvailable = Full;            
       }  //Endif 
    }
    // Else region between G and H
@@ -197,17 +214,17 @@ void BinsAvailable (void)
       if (TeamColor == RED_TEAM)
       {  
          // Bin 4 is available and unobstructed
-         Bins[3].BinAvailable = Full;
+         Me->Bins[3].BinAvailable = Full;
       }
       //Else blue team
       else
       {
          // Bin #2 is available and unobstructed
-         Bins[1].BinAvailable = Full;  
+         Me->Bins[1].BinAvailable = Full;  
       }  //Endif
       // Bins #1 and #3 are available but obstructed to both sides
-      Bins[0].BinAvailable = Partial;
-      Bins[2].BinAvailable = Partial;  
+      Me->Bins[0].BinAvailable = Partial;
+      Me->Bins[2].BinAvailable = Partial;  
    } //Endif
 }  //End of BinsAvailable
 
@@ -228,7 +245,7 @@ Notes
 Author
      Alex Loo, 2/26/2012, hours no longer hold meaning
 ****************************************************************************/
-unsigned char PickScoringBin(void)
+unsigned char PickScoringBin( ES_ME(ScoringMode_t) )
 {
    //Local Variables: i,j,k and reference
    unsigned char i;
@@ -237,22 +254,29 @@ unsigned char PickScoringBin(void)
    Bin reference;
    
    // Run BinsAvailable to get the availabilities of the bins
-   BinsAvailable();
+   BinsAvailable(ES_WITH(Me));
    
-   // First assign the numbers of balls to the bins
+   // First assign the numbers of balls to the bins, as the FSR last
+   // reported them (a bin it has not reported keeps its last count)
    for (i = 0; i <4; i++)
    {
-      Bins[i].BallsInBin = Get_BallsInBin(i+1);
+      unsigned int BallsInBin;
+      
+      if (QueryFieldState((FSR_Query_t)(FSR_BALLS_IN_BIN1 + i), &BallsInBin,
+                          NULL) == True)
+      {
+         Me->Bins[i].BallsInBin = (unsigned char)BallsInBin;
+      }
    }
 
    // Then order depending on the status of the bin        
    for (i = 0; i <4; i++)
    {
-      if (Bins[i].BinAvailable == Full)
+      if (Me->Bins[i].BinAvailable == Full)
       {
-         reference = Bins[j];
-         Bins[j] = Bins[i];
-         Bins[i] = reference;
+         reference = Me->Bins[j];
+         Me->Bins[j] = Me->Bins[i];
+         Me->Bins[i] = reference;
          j++;
       } 
    }
@@ -262,13 +286,13 @@ unsigned char PickScoringBin(void)
    // Fully available bins
    for (i = 0; i <j; i++)
    {
-      reference = Bins[i];
+      reference = Me->Bins[i];
       for (k = i; k <j; k++)
       {
-         if (Bins[k].BallsInBin > Bins[i].BallsInBin)
+         if (Me->Bins[k].BallsInBin > Me->Bins[i].BallsInBin)
          {
-            Bins[i] = Bins[k];
-            Bins[k] = reference;
+            Me->Bins[i] = Me->Bins[k];
+            Me->Bins[k] = reference;
             continue;
          }
       } 
@@ -277,18 +301,18 @@ unsigned char PickScoringBin(void)
    // Partially available bins
    for (i = j; i <4; i++)
    {
-      reference = Bins[i];
+      reference = Me->Bins[i];
       for (k = i; k <4; k++)
       {
-         if (Bins[k].BallsInBin > Bins[i].BallsInBin)
+         if (Me->Bins[k].BallsInBin > Me->Bins[i].BallsInBin)
          {
-            Bins[i] = Bins[k];
-            Bins[k] = reference;
+            Me->Bins[i] = Me->Bins[k];
+            Me->Bins[k] = reference;
             continue;
          }
       } 
    }
    
    // Return the ID of the first Bin in the list (best scoring chance)
-	return Bins[0].ID;
+	return Me->Bins[0].ID;
 }  //End of PickScoringBin
\ No newline at end of file
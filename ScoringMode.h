@@ -7,6 +7,8 @@ Description
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 10:40 adl  bins in a ScoringMode_t, see ES_Instance.h
+ 10/18/26 10:05 adl  SIM_TUNE_HEADER can take the place of the angles
  02/21/12 14:53 adl  First pass
 ****************************************************************************/
 
@@ -16,8 +18,15 @@ Description
 // Event Definitions
 #include "ES_Configure.h"
 #include "ES_Types.h"
+#include "ES_Instance.h"
+
+// A host build that tunes the angles at run time names its header here
+#ifdef SIM_TUNE_HEADER
+#include SIM_TUNE_HEADER
+#endif
 
 // Define the angles bounding each bin
+#ifndef ANGLE_A
 #define ANGLE_A 32
 #define ANGLE_B 58
 #define ANGLE_C 122
@@ -26,6 +35,7 @@ Description
 #define ANGLE_F 238
 #define ANGLE_G 302
 #define ANGLE_H 328
+#endif
 
 #define MIN_ANGLE 0
 #define MAX_ANGLE 360
@@ -39,10 +49,18 @@ typedef struct Bin_t{
    boolean PartialBin; // is wall partiall in bin zone   
 } Bin;
 
+// the bins, as one scoring machine last ranked them
+typedef struct
+{
+   Bin Bins[4];
+} ScoringMode_t;
+
+#define SCORING_MODE_INIT { { {1,0,Blocked,False},{2,0,Blocked,False}, \
+                              {3,0,Blocked,False},{4,0,Blocked,False} } }
 
 // Public Function Prototypes
-void BinsAvailable (void);
-unsigned char PickScoringBin (void);
+void BinsAvailable ( ES_ME(ScoringMode_t) );
+unsigned char PickScoringBin ( ES_ME(ScoringMode_t) );
 
 
 #endif /* SCORINGMODE_H */
\ No newline at end of file
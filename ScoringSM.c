@@ -14,6 +14,12 @@
  History
  When           Who     What/Why
  -------------- ---     --------
+ 10/18/26 13:35 adl     run from ScoringSM_Table.h, see ScoringSM_Spec.h
+ 10/18/26 10:40 adl     variables in a ScoringSM_t, see ES_Instance.h
+ 10/18/26 04:35 adl     state transitions go to the event trace
+ 10/18/26 01:35 adl     events, entries and exits go to the deferred log
+ 10/17/26 22:40 adl     beacon sweep timed with the fine timebase
+ 10/17/26 21:55 adl     timers restarted with ES_Timer_InitTimer on their pool handle
  02/26/12 12:58 adl     Tailoring to be a scoring mode FSM
  01/15/12 11:12 jec      revisions for Gen2 framework
  11/07/11 11:26 jec      made the queue static
@@ -26,6 +32,7 @@
 */
 #include "ES_Configure.h"
 #include "ES_Framework.h"
+#include "ES_Trace.h"
 #include "ScoringSM.h"
 
 // Module Headers
@@ -38,7 +45,8 @@
 #include "BeaconDetection.h"
 
 #include <stdio.h>
-#include "EventPrinter.h"
+#include "ES_Log.h"
+#include "ES_StateTable.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 #define MAX_APPROACH_PASSES 2
@@ -47,37 +55,19 @@
 #define BACKUP_SEARCH
 
 /*---------------------------- Module Functions ---------------------------*/
-/* prototypes for private functions for this machine.They should be functions
-   relevant to the behavior of this state machine
+/* prototypes for private functions for this machine. The guards, actions,
+   entries and exits that the table names are declared in ScoringSM_Table.h
 */
-static ES_Event DuringAligningRearBeacon(ES_Event);
-static ES_Event DuringAligningFrontBeacon(ES_Event);
-static ES_Event DuringDrivingForward_Clearance(ES_Event);
-static ES_Event DuringDrivingForward_Alignment(ES_Event);
-static ES_Event DuringBackingUp(ES_Event);
-static ES_Event DuringUnloading(ES_Event);
-static ES_Event DuringShuffling(ES_Event);
-static ES_Event DuringFindingLeftBeacon(ES_Event ThisEvent);
-static ES_Event DuringFindingRightBeacon(ES_Event ThisEvent);
-static ES_Event DuringBisectingAngle(ES_Event ThisEvent);
+#include "ScoringSM_Table.h"
 
 /*---------------------------- Module Variables ---------------------------*/
-// everybody needs a state variable, you may need others as well.
-// type of state variable should match htat of enum in header file
-static ScoringState_t CurrentState;
-
-// Define variables which determine which bin is the target
-static unsigned char TargetBin = 2;
-static unsigned char OppositeBin = 3;
-static unsigned char RightBin = 0;
-static unsigned char LeftBin = 0;
-
-// Variables for storing time of acquisition for the two side beacons
-static uint16_t TOSA_Left = 0;
-static uint16_t TOSA_Right = 0;
-
-static unsigned char ApproachPass = 0;
-static TurnDirection_t ShuffleDirection = Left;
+// everybody needs a state variable, you may need others as well. They are
+// in a ScoringSM_t: with ES_INSTANCES each function is passed the one to use
+// as Me, without it this is the only one
+#if !ES_INSTANCES
+static ScoringSM_t TheScoringSM = SCORING_SM_INIT;
+#define Me (&TheScoringSM)
+#endif
 
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
@@ -88,18 +78,18 @@ static TurnDirection_t ShuffleDirection = Left;
      None
 
  Returns
-     GatheringState_t The current state of the Gathering state machine
+     ScoringState_t The current state of the Scoring state machine
 
  Description
-     returns the current state of the Gathering state machine
+     returns the current state of the Scoring state machine
  Notes
 
  Author
      J. Edward Carryer, 10/23/11, 19:21
 ****************************************************************************/
-ScoringState_t QueryScoringSM ( void )
+ScoringState_t QueryScoringSM ( ES_ME(const ScoringSM_t) )
 {
-   return(CurrentState);
+   return((ScoringState_t)Me->CurrentState);
 }
 
 /****************************************************************************
@@ -119,17 +109,17 @@ Notes
 Author
      J. Edward Carryer, 10/23/11, 19:21
 ****************************************************************************/
-void StartScoringSM ( ES_Event CurrentEvent )
+void StartScoringSM ( ES_ME_(ScoringSM_t) ES_Event CurrentEvent )
 {
 	// Create a local variable to allow debugger to display CurrentEvent
 	ES_Event LocalEvent = CurrentEvent;
 	
 	printf("\r\nRunning StartScoringSM.");
-	CurrentState = AligningRearBeacon;
+	Me->CurrentState = AligningRearBeacon;
 	// Run entry function for scoring state machine
 	// Determine which bin to score on
 	printf("\r\nAbout to determine target bin.");
-   TargetBin = PickScoringBin();
+   Me->TargetBin = PickScoringBin(ES_WITH(&Me->Mode));
    printf("\r\nTarget bin determined.");
    
    
@@ -138,38 +128,38 @@ void StartScoringSM ( ES_Event CurrentEvent )
    printf("\r\nBalls in Bin 3: %u", Get_BallsInBin(3));
    printf("\r\nBalls in Bin 4: %u", Get_BallsInBin(4));*/
 
-   printf("\r\nTarget Bin is: %u", TargetBin);
+   printf("\r\nTarget Bin is: %u", Me->TargetBin);
 	
 	
 	// Determine opposite bin from target bin
-	switch(TargetBin)
+	switch(Me->TargetBin)
 	{
 	   case 1:
-	      OppositeBin = 3;
-	      RightBin = 4;
-	      LeftBin = 2;
+	      Me->OppositeBin = 3;
+	      Me->RightBin = 4;
+	      Me->LeftBin = 2;
 	   break;
 	   
 	   case 2:
-	      OppositeBin = 4;
-	      RightBin = 1;
-	      LeftBin = 3;
+	      Me->OppositeBin = 4;
+	      Me->RightBin = 1;
+	      Me->LeftBin = 3;
 	   break;
 	   
 	   case 3:
-	      OppositeBin = 1;
-	      RightBin = 2;
-	      LeftBin = 4;
+	      Me->OppositeBin = 1;
+	      Me->RightBin = 2;
+	      Me->LeftBin = 4;
 	   break;
 	   
 	   case 4:
-	      OppositeBin = 2;
-	      RightBin = 3;
-	      LeftBin = 1;
+	      Me->OppositeBin = 2;
+	      Me->RightBin = 3;
+	      Me->LeftBin = 1;
 	   break;
 	}
 	printf("\r\nStarting Scoring SM.");
-	RunScoringSM(LocalEvent);	
+	RunScoringSM(ES_WITH_(Me) LocalEvent);	
 }
 
 /****************************************************************************
@@ -180,820 +170,307 @@ void StartScoringSM ( ES_Event CurrentEvent )
    ES_Event : the event to process
 
  Returns
-   ES_Event, ES_NO_EVENT if no error ES_ERROR otherwise
+   ES_Event, ES_NO_EVENT if the event was consumed, else the event passed up
+   (ES_BALL_BIN_EMPTY when the shuffle is done)
 
  Description
-   add your description here
+   runs the event through the machine's table
  Notes
-   uses nested switch/case to implement the machine.
+   the states and transitions are in ScoringSM_Spec.h, from which
+   Host/TableGen writes ScoringSM_Table.h; the functions they name are below
  Author
    J. Edward Carryer, 01/15/12, 15:23
 ****************************************************************************/
-ES_Event RunScoringSM(ES_Event ThisEvent)
-{
-   boolean MakeTransition = False; // are we making a state transition?
-  	ScoringState_t NextState = CurrentState;
-  	ES_Event ReturnEvent = ThisEvent; // Assume we are not consuming event
-  	  	
-  	EventPrinter(ThisEvent);
-  	switch (CurrentState)
-  	{
-  	   case AligningRearBeacon:
-     	   //printf("\r\nIn the AligningRearBeacon state.");
-     	   // Execute the during function for aligning rear beacon
-     	   // Entry and exit functions are processed here
-     	   ThisEvent = DuringAligningRearBeacon(ThisEvent);
-     	   
-     	   // Process events
-     	   // Check if there is an event to respond to
-     	   if (ThisEvent.EventType != ES_NO_EVENT)
-     	   {
-     	      // Switch on event types
-     	      switch(ThisEvent.EventType)
-     	      {
-     	         case ES_BEACON_REAR:
-        	         if (ThisEvent.EventParam == TargetBin)
-        	         {
-        	            //printf("\r\nFound the beacon on the rear. Going to BackingUp.");
-        	            // We have the rear aligned with where we want to score
-        	            NextState = BackingUp; // determine what the next state will be
-        	            MakeTransition = True; // mark that we are making a transition
-        	            ReturnEvent.EventType = ES_NO_EVENT; // consume the event 
-        	         }
-     	         break; // end rear beacon event
-     	         
-     	         case ES_TIMEOUT:
-     	            if (ThisEvent.EventParam == BEACON_NOD_TIMER)
-     	            {
-     	               // Switch directions, this was to limit full circles while searching
-     	               TurnLeftSpeedSelect(BEACON_SEARCH_TURN_SPEED);  
-     	            }     	            
-     	         break;
-     	         
-     	      } // End event type switch 
-     	   } // End guard against no event
-  	   break; // End AligningRearBeaconState
-  	   
-  	   case AligningFrontBeacon:
-     	   printf("\r\nIn the AligningFrontBeacon state.");
-     	   // Execute the during function for aligning rear beacon
-     	   // Entry and exit functions are processed here
-     	   ThisEvent = DuringAligningFrontBeacon(ThisEvent);
-     	   
-     	   // Process events
-     	   // Check if there is an event to respond to
-     	   if (ThisEvent.EventType != ES_NO_EVENT)
-     	   {
-     	      // Switch on event types
-     	      switch(ThisEvent.EventType)
-     	      {
-     	         case ES_BEACON_FRONT:
-     	            if (ThisEvent.EventParam == OppositeBin)
-     	            {
-     	               //printf("\r\nFound the beacon on the front. Going to DrivingForward_Alignment.");
-     	               // We have the rear aligned with the bin across the field
-     	               NextState = DrivingForward_Alignment;// determine what the next state will be
-     	               MakeTransition = True; // mark that we are making a transition
-     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	               
-     	               // Set the timer length based on which pass this is
-     	               if (ApproachPass == (MAX_APPROACH_PASSES-2))
-     	               {
-     	                  // This is the first pass
-     	                  ES_Timer_StopTimer(MOTION_TIMER);
-     	                  ES_Timer_SetTimer(MOTION_TIMER, FIRST_FWD_ALIGN_INTERVAL);   
-     	               }
-     	               else if (ApproachPass == (MAX_APPROACH_PASSES-1))
-     	               {
-     	                  // This is the second pass
-     	                  ES_Timer_StopTimer(MOTION_TIMER);
-     	                  ES_Timer_SetTimer(MOTION_TIMER, SECOND_FWD_ALIGN_INTERVAL);
-     	               }
-     	               ES_Timer_StartTimer(MOTION_TIMER); // Start timer
-     	            }
-     	         break;
-     	         
-     	         case ES_TIMEOUT:
-     	            if (ThisEvent.EventParam == BEACON_NOD_TIMER)
-     	            {
-     	               // Switch directions, this was to limit full circles while searching
-     	               TurnLeftSpeedSelect(BEACON_SEARCH_TURN_SPEED);  
-     	            }
-     	            
-     	            else if (ThisEvent.EventParam == GO_TO_BACKUP_SEARCH_TIMER)
-     	            {
-     	               // Could not find the beacon, go to backup alignment method
-     	               printf("\r\nCould not find the opposite beacon. Go to bisecting.");
-     	               NextState = FindingLeftBeacon; // go to the state where we're looking for left beacon
-     	               MakeTransition = True; // mark that we are making a transition
-     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	            }     	            
-     	         break;
-     	         
-     	      } // End event type switch 
-     	   } // End guard against no event
-  	   break; // End AligningFrontBeaconState
-  	   
-  	   case DrivingForward_Clearance:
-     	   printf("\r\nIn the DrivingForward_Clearance state.");
-     	   // Execute the during function for aligning rear beacon
-     	   // Entry and exit functions are processed here
-     	   ThisEvent = DuringDrivingForward_Clearance(ThisEvent);
-     	   
-     	   // Process events
-     	   // Check if there is an event to respond to
-     	   if (ThisEvent.EventType != ES_NO_EVENT)
-     	   {
-     	      // Switch on event types
-     	      switch(ThisEvent.EventType)
-     	      {
-     	         case ES_TIMEOUT:
-     	            if (ThisEvent.EventParam == MOTION_TIMER)
-     	            {
-     	               printf("\r\nEnough clearance has been achieved. Looking for front beacon.");
-     	               // Sufficienct clearance has been achieved
-     	               NextState = AligningFrontBeacon;// determine what the next state will be
-     	               MakeTransition = True; // mark that we are making a transition
-     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event 
-     	            }
-     	         break;
-     	         
-     	      } // End event type switch 
-     	   } // End guard against no event
-  	   break; // End DrivingForward100 State
-  	   
-  	   case DrivingForward_Alignment:
-     	   printf("\r\nIn the DrivingForward_Alignment state.");
-     	   // Execute the during function for aligning rear beacon
-     	   // Entry and exit functions are processed here
-     	   ThisEvent = DuringDrivingForward_Alignment(ThisEvent);
-     	   
-     	   // Process events
-     	   // Check if there is an event to respond to
-     	   if (ThisEvent.EventType != ES_NO_EVENT)
-     	   {
-     	      // Switch on event types
-     	      switch(ThisEvent.EventType)
-     	      {       	         
-     	         case ES_TIMEOUT:
-                  if (ThisEvent.EventParam == MOTION_TIMER)
-                  {
-                     printf("\r\nAlignment period ended. Look for rear beacon.");
-                     // Alignment driving interval has been reached
-                     NextState = AligningRearBeacon;// determine what the next state will be
-  	                  MakeTransition = True; // mark that we are making a transition
-  	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event  
-                  } 	         
-     	         break;
-     	         
-     	         case ES_FRONT_BUMPED:
-     	            printf("\r\nHit something in front while aligning. Look for rear beacon.");
-     	            // We hit something as we were driving forward
-     	            NextState = AligningRearBeacon;// determine what the next state will be
-  	               MakeTransition = True; // mark that we are making a transition
-  	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	         break;
-     	         
-     	         /*
-     	         case ES_BEACON_FRONT:
-     	            if (ThisEvent.EventParam == 0)
-     	            {
-     	               printf("\r\nWe lost the front beacon.");
-     	               // We lost the beacon, let's look for it again
-     	               NextState = AligningFrontBeacon; // determine what the next state will be
-     	               MakeTransition = True; // mark that we are making a transition
-     	               ReturnEvent.EventType = ES_NO_EVENT; // consume event
-     	               // decrement the alignment pass counter since we're going back into aligning state
-     	               ApproachPass--; 
-     	            }
-     	         break;
-     	         */
-     	      } // End event type switch 
-     	   } // End guard against no event
-  	   break; // End DrivingForward_Alignment State
-  	   
-  	   case BackingUp:
-     	   printf("\r\nIn the BackingUp state.");
-     	   // Execute the during function for aligning rear beacon
-     	   // Entry and exit functions are processed here
-     	   ThisEvent = DuringBackingUp(ThisEvent);
-     	   
-     	   // Process events
-     	   // Check if there is an event to respond to
-     	   if (ThisEvent.EventType != ES_NO_EVENT)
-     	   {
-     	      // Switch on event types
-     	      switch(ThisEvent.EventType)
-     	      {
-     	         case ES_LEFT_TAPE_DETECTED:
-     	            printf("\r\nFound tape while heading to target bin, slow down.");
-     	            // Tape detected, take caution
-     	            GoBackward(CAUTION_SPEED); // set backward speed to caution speed
-     	            ES_Timer_StopTimer(MOTION_TIMER);
-     	            ES_Timer_SetTimer(MOTION_TIMER, CAUTION_INTERVAL);
-     	            ES_Timer_StartTimer(MOTION_TIMER);
-     	            ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	         break;
-     	         
-     	         case ES_RIGHT_TAPE_DETECTED:
-     	            printf("\r\nFound tape while heading to target bin, slow down.");
-     	            // Tape detected, take caution
-     	            GoBackward(CAUTION_SPEED); // set backward speed caution speed
-     	            ES_Timer_StopTimer(MOTION_TIMER);
-     	            ES_Timer_SetTimer(MOTION_TIMER, CAUTION_INTERVAL);
-     	            ES_Timer_StartTimer(MOTION_TIMER);
-     	            ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	         break;
-     	         
-     	         case ES_TIMEOUT:
-     	            if(ThisEvent.EventParam == MOTION_TIMER)
-     	            {
-     	               printf("\r\nCaution period expired. Go at 100");
-     	               // The caution period expired without hitting a wall
-     	               // Let's go ludicrous speed
-     	               GoBackward(100);
-     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	            }
-     	         break;
-     	         
-     	         case ES_REAR_BUMPED:
-     	            // The rear bumper was hit, determine if making another pass or parking
-     	            if (ApproachPass == MAX_APPROACH_PASSES)
-     	            {
-     	               printf("\r\nRear bumper hit on last approach. Dump balls.");
-     	               // Approach sequence complete, go park
-     	               NextState = Unloading;// determine what the next state will be
-  	                  MakeTransition = True; // mark that we are making a transition
-  	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-  	                  FanControl(0); // turn off fan
-     	            }
-     	            else
-     	            {
-     	               // Make another pass if we don't see the opposite beacon on the front
-     	               if (GetBeaconFront() != OppositeBin)
-     	               {
-        	               printf("\r\nRear bumper hit on preliminary approach. Make another pass.");
-        	               // Approach sequence is not complete, make another pass
-        	               NextState = DrivingForward_Clearance;// determine what the next state will be
-     	                  MakeTransition = True; // mark that we are making a transition
-     	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	               }
-     	               else
-     	               {
-     	                  // We see the opposite bin in our front beacon, we are aligned
-     	                  printf("\r\nOpposite beacon seen in front on preliminary approach. Dump balls.");
-        	               // Approach sequence complete, go park
-        	               NextState = Unloading;// determine what the next state will be
-     	                  MakeTransition = True; // mark that we are making a transition
-     	                  ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	                  FanControl(0); // turn off fan
-     	               }
-     	            }
-     	         break;
-     	         
-     	         /*
-     	         case ES_BEACON_REAR:
-     	            if (ThisEvent.EventParam == 0)
-     	            {
-     	               printf("\r\nWe lost the rear beacon.");
-     	               // We lost the beacon, let's look for it again
-     	               NextState = AligningRearBeacon; // set next state to looking for rear beacon
-     	               MakeTransition = True; // mark that we are making a transition
-     	               ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-     	            }
-     	         break;
-     	         */
-     	         
-     	      } // End event type switch 
-     	   } // End guard against no event
-  	   break; // End DrivingForward100 State
-  	   
-  	   case Unloading:
-     	   printf("\r\nIn the Unloading state.");
-     	   // Execute the during function for aligning rear beacon
-     	   // Entry and exit functions are processed here
-     	   ThisEvent = DuringUnloading(ThisEvent);
-     	   
-     	   // Process events
-     	   // Check if there is an event to respond to
-     	   if (ThisEvent.EventType != ES_NO_EVENT)
-     	   {
-     	      // Switch on event types
-     	      switch(ThisEvent.EventType)
-     	      {
-     	         case ES_TIMEOUT:
-     	            switch (ThisEvent.EventParam)
-     	            {
-     	               
-     	               case MOTION_TIMER:
-        	               printf("\r\nRobot has rammed the bin and door should be open. Start shuffling.");
-           	            // Time to do the shuffle
-           	            NextState = Shuffling;// determine what the next state will be
-                        MakeTransition = True; // mark that we are making a transition
-                        ReturnEvent.EventType = ES_NO_EVENT; // consume the event  
-     	               break;
-     	               
-     	               case UNLOADING_DELAY_TIMER:
-        	               printf("\r\nFans spun down. Start moving forward.");
-        	               // Go forward then back up into the wall to help open the door
-        	               GoForward(100); // move the bot forward
-        	               // Set timer for length of forward pulse
-        	               ES_Timer_StopTimer(UNLOADING_BUMP_TIMER);
-        	               ES_Timer_SetTimer(UNLOADING_BUMP_TIMER, FORWARD_BUMP_INTERVAL);
-        	               ES_Timer_StartTimer(UNLOADING_BUMP_TIMER);
-     	               break;
-     	               
-     	               case UNLOADING_BUMP_TIMER:
-     	                  // The bot went far enough forward, now go back.
-     	                  printf("\r\nThe bot has completed forward path, now head back.");
-     	                  GoBackward(100);     	                  
-     	               break;
-     	            } // end time out type switch     	            
-     	         break;
-     	         
-     	         case ES_REAR_BUMPED:
-     	            // The rear bumper has been pressed. Time to stop the bot
-     	            printf("\r\nRear bumped. Stop the bot.");
-     	            FullStop(); // stop the bot
-     	            
-     	            // Set timer for delay from rear ramming to shuffling
-            	   ES_Timer_StopTimer(MOTION_TIMER);
-            	   ES_Timer_SetTimer(MOTION_TIMER, UNLOAD_INTERVAL);
-            	   ES_Timer_StartTimer(MOTION_TIMER);
-     	         break;
-     	         
-     	      } // End event type switch 
-     	   } // End guard against no event
-  	   break; // End Unloading State
-  	   
-  	   case Shuffling:
-     	   printf("\r\nIn the Shuffling state.");
-     	   // Execute the during function for aligning rear beacon
-     	   // Entry and exit functions are processed here
-     	   ThisEvent = DuringShuffling(ThisEvent);
-     	   
-     	   // Process events
-     	   // Check if there is an event to respond to
-     	   if (ThisEvent.EventType != ES_NO_EVENT)
-     	   {
-     	      // Switch on event types
-     	      switch(ThisEvent.EventType)
-     	      {
-     	         case ES_TIMEOUT:
-     	            // Check if this is a change direction or end shuffle time out
-     	            switch (ThisEvent.EventParam)
-     	            {
-     	               case SHUFFLE_TIMER:
-     	                  printf("\r\nDone shuffling.");
-     	                  // Time to stop shuffling
-     	                  // Create an event to exit the scoring SM
-     	                  ReturnEvent.EventType = ES_BALL_BIN_EMPTY; // signal to the NHSM that we are done               
-     	               break;
-     	               
-     	               case SHUFFLE_STEP_TIMER:
-     	                  printf("\r\nChange shuffle direction.");
-     	                  // Change the direction of the shuffle
-     	                  switch (ShuffleDirection)
-     	                  {
-     	                     case Left:
-     	                        TurnLeft(); // turn left 
-     	                        ShuffleDirection = Right; // update direction for next time
-     	                        printf("\r\nShuffle left.");
-     	                     break;
-     	                     
-     	                     case Right:
-     	                        TurnRight(); // turn right
-     	                        ShuffleDirection = Left; // update direction for next time
-     	                        printf("\r\nShuffle right.");
-     	                     break;
-     	                  }
-     	                  // Set shuffle step timer
-  	                     ES_Timer_StopTimer(SHUFFLE_STEP_TIMER);
-  	                     ES_Timer_SetTimer(SHUFFLE_STEP_TIMER, SHUFFLE_STEP_INTERVAL);
-  	                     ES_Timer_StartTimer(SHUFFLE_STEP_TIMER);
-     	               break;
-     	            }
-     	         break;     	              	         
-     	      } // End event type switch 
-     	   } // End guard against no event
-  	   break; // End Shuffling State
-  	   
-  	   case FindingLeftBeacon:
-         printf("\r\nIn the FindingLeftBeacon state.");
-         
-         // Execute the during function for FindingLeftBeacon state
-         // Entry and exit functions are processed here
-         ThisEvent = DuringFindingLeftBeacon(ThisEvent);
-         
-         // Process events
-         // Check if there is an event to respond to     	            
-         if (ThisEvent.EventType != ES_NO_EVENT)
-         {
-            // Switch on event types
-            switch (ThisEvent.EventType)
-            {
-               case ES_BEACON_FRONT:
-                  if (ThisEvent.EventParam == LeftBin)
-                  {
-                     // We have found the left beacon
-                     NextState = FindingRightBeacon; // set next state to look for right beacon
-                     MakeTransition = True; // indicate that we are making a transition
-                     ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-                  }
-               break;
-            }
-         } // End guard on no event
-      break; // end finding left beacon state
-     	         
-      case FindingRightBeacon:
-         printf("\r\nIn the FindingRightBeacon state.");
-         
-         // Execute the during function for FindingLeftBeacon state
-         // Entry and exit functions are processed here
-         ThisEvent = DuringFindingRightBeacon(ThisEvent);
-         
-         //Process events
-         // Check if there is an event to respond to     	            
-         if (ThisEvent.EventType != ES_NO_EVENT)
-         {
-            // Switch on event types
-            switch (ThisEvent.EventType)
-            {
-               case ES_BEACON_FRONT:
-                  if (ThisEvent.EventParam == RightBin)
-                  {
-                     // We have found the right beacon
-                     NextState = BisectingAngle; // set next state to look for right beacon
-                     MakeTransition = True; // indicate that we are making a transition
-                     ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-                  }
-               break;     	                  
-            }
-         } // End guard on no event
-      break; // End Finding right beacon state
-      
-      case BisectingAngle:
-         printf("\r\nIn the BisectingAngle state.");
-         
-         // Execute the during function for FindingLeftBeacon state
-         // Entry and exit functions are processed here
-         ThisEvent = DuringBisectingAngle(ThisEvent);
-         
-         //Process events
-         // Check if there is an event to respond to     	            
-         if (ThisEvent.EventType != ES_NO_EVENT)
-         {
-            // Switch on event types
-            switch (ThisEvent.EventType)
-            {
-               case ES_TIMEOUT:
-                  if(ThisEvent.EventParam == MOTION_TIMER)
-                  {
-                     // The bot has rotated back enough to bisect the angle
-                     NextState = DrivingForward_Alignment; // set the next state to forward align
-                     MakeTransition = True; // indicate that we are making a transition
-                     ReturnEvent.EventType = ES_NO_EVENT; // consume the event
-                    
-                    
-                    // March 4th, Hannah 
-                     // Set the timer length based on which pass this is
-     	               if (ApproachPass == (MAX_APPROACH_PASSES-1))
-     	               {
-     	                  // This is the first pass
-     	                  ES_Timer_StopTimer(MOTION_TIMER);
-     	                  ES_Timer_SetTimer(MOTION_TIMER, FIRST_FWD_ALIGN_INTERVAL);   
-     	               }
-     	               else if (ApproachPass == (MAX_APPROACH_PASSES))
-     	               {
-     	                  // This is the second pass
-     	                  ES_Timer_StopTimer(MOTION_TIMER);
-     	                  ES_Timer_SetTimer(MOTION_TIMER, SECOND_FWD_ALIGN_INTERVAL);
-     	               }
-     	               ES_Timer_StartTimer(MOTION_TIMER); // Start timer
-                     
-                  }
-               break;
-            }
-         } // End guard on no event           
-      break; // end bisecting angle state
-     	         
-  	    
-  	} // End switch on current state
-  	
-  	// If we are making a state transition
-  	if (MakeTransition == True)
-  	{
-  		// Execute exit function for current state
-  		ThisEvent.EventType = ES_EXIT;
-  		RunScoringSM(ThisEvent);
-  		
-  		CurrentState = NextState; // Update state variable
-  		
-  		// Execute entry function for the new state
-  		ThisEvent.EventType = ES_ENTRY;
-  		RunScoringSM(ThisEvent);
-  	}
-  	
-  	return ReturnEvent;
+ES_Event RunScoringSM(ES_ME_(ScoringSM_t) ES_Event ThisEvent)
+{
+   return ES_StateTable_Run(&ScoringSM_Table, &Me->CurrentState,
+                            ES_TABLE_WITH(Me), ThisEvent);
+}
+
+unsigned char QueryTargetBin(ES_ME(const ScoringSM_t))
+{
+   return Me->TargetBin;
 }
 
 /***************************************************************************
 private functions
 ***************************************************************************/
-static ES_Event DuringAligningRearBeacon(ES_Event ThisEvent)
+/*----------------------------- Guards ------------------------------------*/
+static boolean IsTargetBin(void *pThis, ES_Event ThisEvent)
 {
-	if (ThisEvent.EventType == ES_ENTRY)
-	{
-	   //printf("\r\n\nENTERING the AligningRearBeacon state.");
-	   // Process ES_ENTRY event
-	   // Turn right while looking for beacons
-	   TurnRight();
-	   
-	   #ifdef BEACON_NOD
-	   // Set timer for opposite swing to get off the current beacon
-	   ES_Timer_StopTimer(BEACON_NOD_TIMER);
-	   ES_Timer_SetTimer(BEACON_NOD_TIMER, BEACON_NOD_INTERVAL);
-	   ES_Timer_StartTimer(BEACON_NOD_TIMER);
-	   #endif
+   ES_TABLE_ME(ScoringSM_t)
+   return (boolean)(ThisEvent.EventParam == Me->TargetBin);
+}
 
-	}
-	else if (ThisEvent.EventType == ES_EXIT)
-	{
-		//printf("\r\n\nEXITING the AligningRearBeacon state.");
-		// Process exit event
-		// Stop the robot
-		FullStop();
-	}
-	else
-	{
-	   // Perform during functions  
-	   // No during functions for this state
-	}
-	return ThisEvent; // do not remap event   
+static boolean IsOppositeBin(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   return (boolean)(ThisEvent.EventParam == Me->OppositeBin);
 }
 
-static ES_Event DuringAligningFrontBeacon(ES_Event ThisEvent)
+static boolean IsLeftBin(void *pThis, ES_Event ThisEvent)
 {
-	if (ThisEvent.EventType == ES_ENTRY)
-	{
-	   //printf("\r\n\nENTERING the AligningFrontBeacon state.");
-	   // Process ES_ENTRY event
-      // Turn right while looking for beacons
-	   TurnRight();
-	   
-	   #ifdef BEACON_NOD
-	   // Set timer for opposite swing to get off the current beacon
-	   ES_Timer_StopTimer(BEACON_NOD_TIMER);
-	   ES_Timer_SetTimer(BEACON_NOD_TIMER, BEACON_NOD_INTERVAL);
-	   ES_Timer_StartTimer(BEACON_NOD_TIMER);
-	   #endif
-	   
-	   #ifdef BACKUP_SEARCH
-	   // Set timer for abandoning the search for the front beacon
-	   ES_Timer_StopTimer(GO_TO_BACKUP_SEARCH_TIMER);
-	   ES_Timer_SetTimer(GO_TO_BACKUP_SEARCH_TIMER, GO_TO_BACKUP_SEARCH_INTERVAL);
-	   ES_Timer_StartTimer(GO_TO_BACKUP_SEARCH_TIMER);
-	   #endif
-	}
-	else if (ThisEvent.EventType == ES_EXIT)
-	{
-		//printf("\r\n\nEXITING the AligningFrontBeacon state.");
-		// Process exit event
-		// Stop the robot
-		FullStop();
-		ApproachPass++; // increment approach counter
-	}
-	else
-	{
-	   // Perform during functions
-	   // No during functions for this state  
-	}
-	return ThisEvent; // do not remap event   
+   ES_TABLE_ME(ScoringSM_t)
+   return (boolean)(ThisEvent.EventParam == Me->LeftBin);
 }
 
-static ES_Event DuringDrivingForward_Clearance(ES_Event ThisEvent)
+static boolean IsRightBin(void *pThis, ES_Event ThisEvent)
 {
-	if (ThisEvent.EventType == ES_ENTRY)
-	{
-	   printf("\r\n\nENTERING the DrivingForward_Clearance state.");
-	   // Process ES_ENTRY event
-	   GoForward(100);
-	   
-	   // Set timer for clearance space
-	   ES_Timer_StopTimer(MOTION_TIMER);
-	   ES_Timer_SetTimer(MOTION_TIMER, CLEARANCE_INTERVAL);
-	   ES_Timer_StartTimer(MOTION_TIMER);
-	   printf("\r\nTimer SET for driving forward clearance.");
+   ES_TABLE_ME(ScoringSM_t)
+   return (boolean)(ThisEvent.EventParam == Me->RightBin);
+}
 
-	}
-	else if (ThisEvent.EventType == ES_EXIT)
-	{
-		printf("\r\n\nEXITING the DrivingForward_Clearance state.");
-		// Process exit event
-		// Stop the robot
-		FullStop();
-	}
-	else
-	{
-	   // Perform during functions
-	   // No during functions for this state  
-	}
-	return ThisEvent; // do not remap event   
+// the rear bumper was hit on the last approach
+static boolean IsLastPass(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   return (boolean)(Me->ApproachPass == MAX_APPROACH_PASSES);
 }
 
-static ES_Event DuringDrivingForward_Alignment(ES_Event ThisEvent)
+// make another pass if we don't see the opposite beacon on the front
+static boolean IsOppositeNotInFront(void *pThis, ES_Event ThisEvent)
 {
-	if (ThisEvent.EventType == ES_ENTRY)
-	{
-	   printf("\r\n\nENTERING the DrivingForward_Alignment state.");
-	   // Process ES_ENTRY event
-	   GoForward(100);
-	}
-	else if (ThisEvent.EventType == ES_EXIT)
-	{
-		printf("\r\n\nEXITING the DrivingForward_Alignment state.");
-		// Process exit event
-		// Stop the robot
-		FullStop();
-	}
-	else
-	{
-	   // Perform during functions
-	   // No during functions for this state  
-	}
-	return ThisEvent; // do not remap event   
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   return (boolean)(GetBeaconFront() != Me->OppositeBin);
 }
 
-static ES_Event DuringBackingUp(ES_Event ThisEvent)
+/*----------------------------- Actions -----------------------------------*/
+static void Stop(void *pThis, ES_Event ThisEvent)
 {
-	if (ThisEvent.EventType == ES_ENTRY)
-	{
-	   printf("\r\n\nENTERING the BackingUp state.");
-	   // Process ES_ENTRY event
-	   GoBackward(100);
+   (void)pThis;
+   (void)ThisEvent;
+   FullStop(); // stop the robot
+}
 
-	}
-	else if (ThisEvent.EventType == ES_EXIT)
-	{
-		printf("\r\n\nEXITING the BackingUp state.");
-		// Process exit event
-		// Stop the robot
-		FullStop();
-	}
-	else
-	{
-	   // Perform during functions
-	   // No during functions for this state  
-	}
-	return ThisEvent; // do not remap event   
+static void DriveForward(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   GoForward(100);
 }
 
-static ES_Event DuringUnloading(ES_Event ThisEvent)
+static void DriveBackward(void *pThis, ES_Event ThisEvent)
 {
-	if (ThisEvent.EventType == ES_ENTRY)
-	{
-	   printf("\r\n\nENTERING the Unloading state.");
-	   // Process ES_ENTRY event
-	   // Turn off motors and fans
-	   FullStop();
-	   FanControl(0);
-	   
-	   // Set timer to allow for fan spin down 
-	   ES_Timer_StopTimer(UNLOADING_DELAY_TIMER);
-	   ES_Timer_SetTimer(UNLOADING_DELAY_TIMER, FAN_SPIN_DOWN_TIMER);
-	   ES_Timer_StartTimer(UNLOADING_DELAY_TIMER);
-	}
-	else if (ThisEvent.EventType == ES_EXIT)
-	{
-		printf("\r\n\nEXITING the Unloading state.");
-		// Process exit event
-		// No exit functions for this state
-	}
-	else
-	{
-	   // Perform during functions
-	   // No during functions for this state  
-	}
-	return ThisEvent; // do not remap event   
+   (void)pThis;
+   (void)ThisEvent;
+   // the caution period expired without hitting a wall, or the bot went
+   // far enough forward while unloading: go back at 100
+   GoBackward(100);
 }
 
-static ES_Event DuringShuffling(ES_Event ThisEvent)
+static void SpinLeft(void *pThis, ES_Event ThisEvent)
 {
-	if (ThisEvent.EventType == ES_ENTRY)
-	{
-	   printf("\r\n\nENTERING the Shuffling state.");
-	   // Process ES_ENTRY event
-      // Commence shuffling
-      switch (ShuffleDirection)
-      {
-         case Left:
-            TurnLeft(); // turn left 
-            ShuffleDirection = Right; // update direction for next time
-            printf("\r\nShuffle left.");
-         break;
-         
-         case Right:
-            TurnRight(); // turn right
-            ShuffleDirection = Left; // update direction for next time
-            printf("\r\nShuffle right.");
-         break;
-      }
-      
-      // Set shuffle step timer
-      ES_Timer_StopTimer(SHUFFLE_STEP_TIMER);
-      ES_Timer_SetTimer(SHUFFLE_STEP_TIMER, SHUFFLE_STEP_INTERVAL);
-      ES_Timer_StartTimer(SHUFFLE_STEP_TIMER);
-      // Set overall shuffle length timer
-      ES_Timer_StopTimer(SHUFFLE_TIMER);
-      ES_Timer_SetTimer(SHUFFLE_TIMER, SHUFFLE_INTERVAL);
-      ES_Timer_StartTimer(SHUFFLE_TIMER);
-      printf("\r\nShuffle timers have been set.");
-	}
-	else if (ThisEvent.EventType == ES_EXIT)
-	{
-		printf("\r\n\nEXITING the Shuffling state.");
-		// Process exit event
-		// Stop the robot
-		FullStop();
-	}
-	else
-	{
-	   // Perform during functions  
-	}
-	return ThisEvent; // do not remap event   
+   (void)pThis;
+   (void)ThisEvent;
+   TurnLeft(); // spin left, looking for the left beacon
 }
 
-static ES_Event DuringFindingLeftBeacon(ES_Event ThisEvent)
+static void SpinRight(void *pThis, ES_Event ThisEvent)
 {
-   if (ThisEvent.EventType == ES_ENTRY)
-   {
-      // Process the ES_ENTRY event
-      TurnLeft(); // make the bot spin left, looking for the left beacon
-   }
-   else if (ThisEvent.EventType == ES_EXIT)
-   {
-      // Process the ES_EXIT event
-      TOSA_Left = ES_Timer_GetTime(); // get the time when the left bin signal is acquired
-      FullStop(); // stop the bot
-   }
-   else
-   {
-      // Process the during functions
-      // No during functions
-   }
-   return ThisEvent; // do not remap event
+   (void)pThis;
+   (void)ThisEvent;
+   TurnRight(); // spin right, looking for the right beacon
 }
 
-static ES_Event DuringFindingRightBeacon(ES_Event ThisEvent)
+// switch directions, this was to limit full circles while searching
+static void NodLeft(void *pThis, ES_Event ThisEvent)
 {
-   if (ThisEvent.EventType == ES_ENTRY)
-   {
-      // Process the ES_ENTRY event
-      TurnRight(); // make the bot spin right, looking for the right beacon
-   }
-   else if (ThisEvent.EventType == ES_EXIT)
+   (void)pThis;
+   (void)ThisEvent;
+   TurnLeftSpeedSelect(BEACON_SEARCH_TURN_SPEED);
+}
+
+static void EnterAligningRearBeacon(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   // Turn right while looking for beacons
+   TurnRight();
+
+   #ifdef BEACON_NOD
+   // Set timer for opposite swing to get off the current beacon
+   ES_Timer_InitTimer(AppTimer[BEACON_NOD_TIMER], BEACON_NOD_INTERVAL);
+   #endif
+}
+
+static void EnterAligningFrontBeacon(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   // Turn right while looking for beacons
+   TurnRight();
+
+   #ifdef BEACON_NOD
+   // Set timer for opposite swing to get off the current beacon
+   ES_Timer_InitTimer(AppTimer[BEACON_NOD_TIMER], BEACON_NOD_INTERVAL);
+   #endif
+
+   #ifdef BACKUP_SEARCH
+   // Set timer for abandoning the search for the front beacon
+   ES_Timer_InitTimer(AppTimer[GO_TO_BACKUP_SEARCH_TIMER], GO_TO_BACKUP_SEARCH_INTERVAL);
+   #endif
+}
+
+static void ExitAligningFrontBeacon(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   FullStop(); // stop the robot
+   Me->ApproachPass++; // increment approach counter
+}
+
+// the front is aligned with the bin across the field: set the timer length
+// based on which pass this is
+static void StartAlignTimer(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   if (Me->ApproachPass == (MAX_APPROACH_PASSES-2))
    {
-      // Process the ES_EXIT event
-      TOSA_Right = ES_Timer_GetTime(); // get the time when the right bin signal is acquired
-      FullStop(); // stop the bot
+      // This is the first pass
+      ES_Timer_InitTimer(AppTimer[MOTION_TIMER], FIRST_FWD_ALIGN_INTERVAL);
    }
-   else
+   else if (Me->ApproachPass == (MAX_APPROACH_PASSES-1))
    {
-      // Process the during functions
-      // No during functions
+      // This is the second pass
+      ES_Timer_InitTimer(AppTimer[MOTION_TIMER], SECOND_FWD_ALIGN_INTERVAL);
    }
-   return ThisEvent; // do not remap event
 }
 
-static ES_Event DuringBisectingAngle(ES_Event ThisEvent)
+static void EnterDrivingForward_Clearance(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   GoForward(100);
+
+   // Set timer for clearance space
+   ES_Timer_InitTimer(AppTimer[MOTION_TIMER], CLEARANCE_INTERVAL);
+}
+
+// tape detected while heading to the target bin, take caution
+static void SlowDown(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   GoBackward(CAUTION_SPEED); // set backward speed to caution speed
+   ES_Timer_InitTimer(AppTimer[MOTION_TIMER], CAUTION_INTERVAL);
+}
+
+static void FanOff(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   FanControl(0); // turn off fan
+}
+
+static void EnterUnloading(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   // Turn off motors and fans
+   FullStop();
+   FanControl(0);
+
+   // Set timer to allow for fan spin down
+   ES_Timer_InitTimer(AppTimer[UNLOADING_DELAY_TIMER], FAN_SPIN_DOWN_TIMER);
+}
+
+// fans spun down: go forward, then back up into the wall to help open the
+// door
+static void BumpForward(void *pThis, ES_Event ThisEvent)
+{
+   (void)pThis;
+   (void)ThisEvent;
+   GoForward(100); // move the bot forward
+   // Set timer for length of forward pulse
+   ES_Timer_InitTimer(AppTimer[UNLOADING_BUMP_TIMER], FORWARD_BUMP_INTERVAL);
+}
+
+static void StopToUnload(void *pThis, ES_Event ThisEvent)
 {
-   if (ThisEvent.EventType == ES_ENTRY)
+   (void)pThis;
+   (void)ThisEvent;
+   FullStop(); // stop the bot
+
+   // Set timer for delay from rear ramming to shuffling
+   ES_Timer_InitTimer(AppTimer[MOTION_TIMER], UNLOAD_INTERVAL);
+}
+
+// change the direction of the shuffle
+static void ShuffleStep(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   switch (Me->ShuffleDirection)
    {
-      // Process the ES_ENTRY event
-      // calculate the time betwe en the left and right beacons during sweep
-      uint16_t BisectTime = (TOSA_Right - TOSA_Left)/2;
-      TurnLeft(); // Spin the bot back to the left
-      
-      // Set the timer to stop at the bisection of the angle
-      ES_Timer_StopTimer(MOTION_TIMER);
-      ES_Timer_SetTimer(MOTION_TIMER, BisectTime);
-      ES_Timer_StartTimer(MOTION_TIMER);
-       
+      case Left:
+         TurnLeft(); // turn left
+         Me->ShuffleDirection = Right; // update direction for next time
+      break;
+
+      case Right:
+         TurnRight(); // turn right
+         Me->ShuffleDirection = Left; // update direction for next time
+      break;
    }
-   else if (ThisEvent.EventType == ES_EXIT)
+   // Set shuffle step timer
+   ES_Timer_InitTimer(AppTimer[SHUFFLE_STEP_TIMER], SHUFFLE_STEP_INTERVAL);
+}
+
+static void EnterShuffling(void *pThis, ES_Event ThisEvent)
+{
+   // Commence shuffling
+   ShuffleStep(pThis, ThisEvent);
+   // Set overall shuffle length timer
+   ES_Timer_InitTimer(AppTimer[SHUFFLE_TIMER], SHUFFLE_INTERVAL);
+}
+
+static void ExitFindingLeftBeacon(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   Me->TOSA_Left = ES_Timer_GetFineTime(); // get the time when the left bin signal is acquired
+   FullStop(); // stop the bot
+}
+
+static void ExitFindingRightBeacon(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   Me->TOSA_Right = ES_Timer_GetFineTime(); // get the time when the right bin signal is acquired
+   FullStop(); // stop the bot
+}
+
+static void EnterBisectingAngle(void *pThis, ES_Event ThisEvent)
+{
+   uint16_t BisectTime;
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   // calculate the time between the left and right beacons during sweep
+   BisectTime = (uint16_t)(((Me->TOSA_Right - Me->TOSA_Left)/2) /
+                           FINE_PER_TIMER_TICK);
+   TurnLeft(); // Spin the bot back to the left
+
+   // Set the timer to stop at the bisection of the angle
+   ES_Timer_InitTimer(AppTimer[MOTION_TIMER], BisectTime);
+}
+
+// the bot has rotated back enough to bisect the angle: set the timer length
+// based on which pass this is
+static void StartBisectedAlignTimer(void *pThis, ES_Event ThisEvent)
+{
+   ES_TABLE_ME(ScoringSM_t)
+   (void)ThisEvent;
+   if (Me->ApproachPass == (MAX_APPROACH_PASSES-1))
    {
-      // Process the ES_EXIT event
-      FullStop(); // stop the bot
+      // This is the first pass
+      ES_Timer_InitTimer(AppTimer[MOTION_TIMER], FIRST_FWD_ALIGN_INTERVAL);
    }
-   else
+   else if (Me->ApproachPass == (MAX_APPROACH_PASSES))
    {
-      // Process the during functions
-      // No during functions
+      // This is the second pass
+      ES_Timer_InitTimer(AppTimer[MOTION_TIMER], SECOND_FWD_ALIGN_INTERVAL);
    }
-   return ThisEvent; // do not remap event
 }
-
-unsigned char QueryTargetBin(void)
-{
-   return TargetBin;
-}
\ No newline at end of file
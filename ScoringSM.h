@@ -11,6 +11,9 @@
 // Event Definitions
 #include "ES_Configure.h"
 #include "ES_Types.h"
+#include "ES_Instance.h"
+#include "TimingConstants.h"
+#include "ScoringMode.h"
 
 // typedefs for the states
 // State definitions for use with the query function
@@ -19,13 +22,40 @@ typedef enum { AligningFrontBeacon, AligningRearBeacon,
                DrivingForward_Alignment, Unloading,
                Shuffling, BisectingAngle,
                FindingLeftBeacon, FindingRightBeacon} ScoringState_t ;
+
+// the variables of one Scoring machine, see ES_Instance.h
+typedef struct
+{
+   uint8_t CurrentState;   // a ScoringState_t, run by ES_StateTable_Run
+   // the bin that is the target, and the ones opposite it and to each side
+   unsigned char TargetBin;
+   unsigned char OppositeBin;
+   unsigned char RightBin;
+   unsigned char LeftBin;
+   // the times of acquisition of the 2 side beacons, from
+   // ES_Timer_GetFineTime (3 per us)
+   uint32_t TOSA_Left;
+   uint32_t TOSA_Right;
+   unsigned char ApproachPass;
+   TurnDirection_t ShuffleDirection;
+#if ES_INSTANCES
+   ScoringMode_t Mode;  // the bins that PickScoringBin ranks
+#endif
+} ScoringSM_t;
+
+#if ES_INSTANCES
+#define SCORING_SM_INIT { AligningFrontBeacon, 2, 3, 0, 0, 0, 0, 0, Left, \
+                          SCORING_MODE_INIT }
+#else
+#define SCORING_SM_INIT { AligningFrontBeacon, 2, 3, 0, 0, 0, 0, 0, Left }
+#endif
               
 // Public Function Prototypes
 // boolean InitGatheringSM ( uint8_t);
 //boolean PostScoringSM( ES_Event);
-void StartScoringSM(ES_Event);
-ES_Event RunScoringSM( ES_Event);
-ScoringState_t QueryScoringSM ( void );
-unsigned char QueryTargetBin(void);
+void StartScoringSM( ES_ME_(ScoringSM_t) ES_Event);
+ES_Event RunScoringSM( ES_ME_(ScoringSM_t) ES_Event);
+ScoringState_t QueryScoringSM ( ES_ME(const ScoringSM_t) );
+unsigned char QueryTargetBin( ES_ME(const ScoringSM_t) );
 
 #endif /* ScoringSM_H */
\ No newline at end of file
@@ -0,0 +1,104 @@
+/****************************************************************************
+ Module
+     ScoringSM_Spec.h
+ Description
+     the Scoring machine's states and transitions, from which Host/TableGen
+     writes ScoringSM_Table.h
+ Notes
+     Only Host/TableGen includes this. After changing it, run
+     make -C Host tables (any host build does) to write the table again.
+
+     MACHINE( Source, Initial )
+        the machine's LOG_ source, and the state StartScoringSM enters
+     STATE( State, Entry, Exit )
+        every state, with the functions run on entering and leaving it
+        (NULL for none)
+     ON( State, Event, Param, Guard, Action, Next, Returns )
+        in State, an Event with that Param (or any, ES_ANY_PARAM) for which
+        Guard (NULL for always) returns True runs Action (NULL for none),
+        goes to Next (ES_SAME_STATE to stay, with no exit or entry) and has
+        RunScoringSM return an event of type Returns (ES_NO_EVENT to consume
+        it, ES_PASS_EVENT to pass it up as it came). Rows for the same State
+        and Event are tried in the order they are here.
+     The functions are in ScoringSM.c.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 13:00 adl      started coding, from the switches in ScoringSM.c
+*****************************************************************************/
+#ifndef ScoringSM_Spec_H
+#define ScoringSM_Spec_H
+
+#define SCORING_SM_MACHINE(MACHINE) \
+   MACHINE( LOG_SCORING, AligningRearBeacon )
+
+#define SCORING_SM_STATES(STATE) \
+   STATE( AligningFrontBeacon, EnterAligningFrontBeacon, \
+          ExitAligningFrontBeacon ) \
+   STATE( AligningRearBeacon, EnterAligningRearBeacon, Stop ) \
+   STATE( BackingUp, DriveBackward, Stop ) \
+   STATE( DrivingForward_Clearance, EnterDrivingForward_Clearance, Stop ) \
+   STATE( DrivingForward_Alignment, DriveForward, Stop ) \
+   STATE( Unloading, EnterUnloading, NULL ) \
+   STATE( Shuffling, EnterShuffling, Stop ) \
+   STATE( BisectingAngle, EnterBisectingAngle, Stop ) \
+   STATE( FindingLeftBeacon, SpinLeft, ExitFindingLeftBeacon ) \
+   STATE( FindingRightBeacon, SpinRight, ExitFindingRightBeacon )
+
+#define SCORING_SM_ROWS(ON) \
+   /* turn until the rear sees the target bin, then back up to it */ \
+   ON( AligningRearBeacon, ES_BEACON_REAR, ES_ANY_PARAM, IsTargetBin, NULL, \
+       BackingUp, ES_NO_EVENT ) \
+   ON( AligningRearBeacon, ES_TIMEOUT, BEACON_NOD_TIMER, NULL, NodLeft, \
+       ES_SAME_STATE, ES_PASS_EVENT ) \
+   /* turn until the front sees the bin across the field, or give up and */ \
+   /* bisect the angle between the bins to each side */ \
+   ON( AligningFrontBeacon, ES_BEACON_FRONT, ES_ANY_PARAM, IsOppositeBin, \
+       StartAlignTimer, DrivingForward_Alignment, ES_NO_EVENT ) \
+   ON( AligningFrontBeacon, ES_TIMEOUT, BEACON_NOD_TIMER, NULL, NodLeft, \
+       ES_SAME_STATE, ES_PASS_EVENT ) \
+   ON( AligningFrontBeacon, ES_TIMEOUT, GO_TO_BACKUP_SEARCH_TIMER, NULL, \
+       NULL, FindingLeftBeacon, ES_NO_EVENT ) \
+   ON( DrivingForward_Clearance, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, \
+       AligningFrontBeacon, ES_NO_EVENT ) \
+   ON( DrivingForward_Alignment, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, \
+       AligningRearBeacon, ES_NO_EVENT ) \
+   ON( DrivingForward_Alignment, ES_FRONT_BUMPED, ES_ANY_PARAM, NULL, NULL, \
+       AligningRearBeacon, ES_NO_EVENT ) \
+   /* slow down over the tape, then unload after the last pass, or if */ \
+   /* the front already sees the bin across the field */ \
+   ON( BackingUp, ES_LEFT_TAPE_DETECTED, ES_ANY_PARAM, NULL, SlowDown, \
+       ES_SAME_STATE, ES_NO_EVENT ) \
+   ON( BackingUp, ES_RIGHT_TAPE_DETECTED, ES_ANY_PARAM, NULL, SlowDown, \
+       ES_SAME_STATE, ES_NO_EVENT ) \
+   ON( BackingUp, ES_TIMEOUT, MOTION_TIMER, NULL, DriveBackward, \
+       ES_SAME_STATE, ES_NO_EVENT ) \
+   ON( BackingUp, ES_REAR_BUMPED, ES_ANY_PARAM, IsLastPass, FanOff, \
+       Unloading, ES_NO_EVENT ) \
+   ON( BackingUp, ES_REAR_BUMPED, ES_ANY_PARAM, IsOppositeNotInFront, NULL, \
+       DrivingForward_Clearance, ES_NO_EVENT ) \
+   ON( BackingUp, ES_REAR_BUMPED, ES_ANY_PARAM, NULL, FanOff, Unloading, \
+       ES_NO_EVENT ) \
+   /* let the fans spin down, bump the bin to open its door, shuffle */ \
+   ON( Unloading, ES_TIMEOUT, MOTION_TIMER, NULL, NULL, Shuffling, \
+       ES_NO_EVENT ) \
+   ON( Unloading, ES_TIMEOUT, UNLOADING_DELAY_TIMER, NULL, BumpForward, \
+       ES_SAME_STATE, ES_PASS_EVENT ) \
+   ON( Unloading, ES_TIMEOUT, UNLOADING_BUMP_TIMER, NULL, DriveBackward, \
+       ES_SAME_STATE, ES_PASS_EVENT ) \
+   ON( Unloading, ES_REAR_BUMPED, ES_ANY_PARAM, NULL, StopToUnload, \
+       ES_SAME_STATE, ES_PASS_EVENT ) \
+   ON( Shuffling, ES_TIMEOUT, SHUFFLE_TIMER, NULL, NULL, ES_SAME_STATE, \
+       ES_BALL_BIN_EMPTY ) \
+   ON( Shuffling, ES_TIMEOUT, SHUFFLE_STEP_TIMER, NULL, ShuffleStep, \
+       ES_SAME_STATE, ES_PASS_EVENT ) \
+   /* the search for the bin across the field gave up: find the bins to */ \
+   /* each side, then turn back half way */ \
+   ON( FindingLeftBeacon, ES_BEACON_FRONT, ES_ANY_PARAM, IsLeftBin, NULL, \
+       FindingRightBeacon, ES_NO_EVENT ) \
+   ON( FindingRightBeacon, ES_BEACON_FRONT, ES_ANY_PARAM, IsRightBin, NULL, \
+       BisectingAngle, ES_NO_EVENT ) \
+   ON( BisectingAngle, ES_TIMEOUT, MOTION_TIMER, NULL, StartBisectedAlignTimer, \
+       DrivingForward_Alignment, ES_NO_EVENT )
+
+#endif /* ScoringSM_Spec_H */
@@ -0,0 +1,239 @@
+/****************************************************************************
+ Module
+     ScoringSM_Table.h
+ Description
+     ScoringSM's transition table, for ES_StateTable_Run
+ Notes
+     Written by Host/TableGen from ScoringSM_Spec.h, do not edit. Change the
+     spec and run make -C Host tables.
+
+     Passed up, to the machine above, by each state: the events it does
+     not take that the machine takes in another state
+       AligningFrontBeacon:
+         ES_BEACON_REAR
+         ES_TIMEOUT MOTION_TIMER UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+       AligningRearBeacon:
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER MOTION_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_BEACON_FRONT
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+       BackingUp:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_BEACON_FRONT
+         ES_FRONT_BUMPED
+       DrivingForward_Clearance:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_BEACON_FRONT
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+       DrivingForward_Alignment:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_BEACON_FRONT
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+       Unloading:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_BEACON_FRONT
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+       Shuffling:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER MOTION_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER
+         ES_BEACON_FRONT
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+       BisectingAngle:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_BEACON_FRONT
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+       FindingLeftBeacon:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER MOTION_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+       FindingRightBeacon:
+         ES_BEACON_REAR
+         ES_TIMEOUT BEACON_NOD_TIMER
+         ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER MOTION_TIMER
+         ES_TIMEOUT UNLOADING_DELAY_TIMER
+         ES_TIMEOUT UNLOADING_BUMP_TIMER SHUFFLE_TIMER
+         ES_TIMEOUT SHUFFLE_STEP_TIMER
+         ES_FRONT_BUMPED
+         ES_LEFT_TAPE_DETECTED
+         ES_RIGHT_TAPE_DETECTED
+         ES_REAR_BUMPED
+*****************************************************************************/
+
+// the guards, actions, entries and exits, in ScoringSM.c
+static ES_StateTableGuard_t IsTargetBin;
+static ES_StateTableGuard_t IsOppositeBin;
+static ES_StateTableGuard_t IsLastPass;
+static ES_StateTableGuard_t IsOppositeNotInFront;
+static ES_StateTableGuard_t IsLeftBin;
+static ES_StateTableGuard_t IsRightBin;
+static ES_StateTableAction_t NodLeft;
+static ES_StateTableAction_t StartAlignTimer;
+static ES_StateTableAction_t SlowDown;
+static ES_StateTableAction_t DriveBackward;
+static ES_StateTableAction_t FanOff;
+static ES_StateTableAction_t BumpForward;
+static ES_StateTableAction_t StopToUnload;
+static ES_StateTableAction_t ShuffleStep;
+static ES_StateTableAction_t StartBisectedAlignTimer;
+static ES_StateTableAction_t EnterAligningFrontBeacon;
+static ES_StateTableAction_t ExitAligningFrontBeacon;
+static ES_StateTableAction_t EnterAligningRearBeacon;
+static ES_StateTableAction_t Stop;
+static ES_StateTableAction_t EnterDrivingForward_Clearance;
+static ES_StateTableAction_t DriveForward;
+static ES_StateTableAction_t EnterUnloading;
+static ES_StateTableAction_t EnterShuffling;
+static ES_StateTableAction_t EnterBisectingAngle;
+static ES_StateTableAction_t SpinLeft;
+static ES_StateTableAction_t ExitFindingLeftBeacon;
+static ES_StateTableAction_t SpinRight;
+static ES_StateTableAction_t ExitFindingRightBeacon;
+
+// the rows, by state and event, in the order they are tried
+static const ES_StateTableRow_t ScoringSM_Rows[23] = {
+   /*  0 AligningFrontBeacon ES_TIMEOUT BEACON_NOD_TIMER */
+   { NULL, NodLeft, BEACON_NOD_TIMER, ES_SAME_STATE, ES_PASS_EVENT, 0 },
+   /*  1 AligningFrontBeacon ES_TIMEOUT GO_TO_BACKUP_SEARCH_TIMER */
+   { NULL, NULL, GO_TO_BACKUP_SEARCH_TIMER, FindingLeftBeacon, ES_NO_EVENT, 1 },
+   /*  2 AligningFrontBeacon ES_BEACON_FRONT ES_ANY_PARAM */
+   { IsOppositeBin, StartAlignTimer, ES_ANY_PARAM, DrivingForward_Alignment, ES_NO_EVENT, 1 },
+   /*  3 AligningRearBeacon ES_TIMEOUT BEACON_NOD_TIMER */
+   { NULL, NodLeft, BEACON_NOD_TIMER, ES_SAME_STATE, ES_PASS_EVENT, 1 },
+   /*  4 AligningRearBeacon ES_BEACON_REAR ES_ANY_PARAM */
+   { IsTargetBin, NULL, ES_ANY_PARAM, BackingUp, ES_NO_EVENT, 1 },
+   /*  5 BackingUp ES_TIMEOUT MOTION_TIMER */
+   { NULL, DriveBackward, MOTION_TIMER, ES_SAME_STATE, ES_NO_EVENT, 1 },
+   /*  6 BackingUp ES_LEFT_TAPE_DETECTED ES_ANY_PARAM */
+   { NULL, SlowDown, ES_ANY_PARAM, ES_SAME_STATE, ES_NO_EVENT, 1 },
+   /*  7 BackingUp ES_RIGHT_TAPE_DETECTED ES_ANY_PARAM */
+   { NULL, SlowDown, ES_ANY_PARAM, ES_SAME_STATE, ES_NO_EVENT, 1 },
+   /*  8 BackingUp ES_REAR_BUMPED ES_ANY_PARAM */
+   { IsLastPass, FanOff, ES_ANY_PARAM, Unloading, ES_NO_EVENT, 0 },
+   /*  9 BackingUp ES_REAR_BUMPED ES_ANY_PARAM */
+   { IsOppositeNotInFront, NULL, ES_ANY_PARAM, DrivingForward_Clearance, ES_NO_EVENT, 0 },
+   /* 10 BackingUp ES_REAR_BUMPED ES_ANY_PARAM */
+   { NULL, FanOff, ES_ANY_PARAM, Unloading, ES_NO_EVENT, 1 },
+   /* 11 DrivingForward_Clearance ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, AligningFrontBeacon, ES_NO_EVENT, 1 },
+   /* 12 DrivingForward_Alignment ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, AligningRearBeacon, ES_NO_EVENT, 1 },
+   /* 13 DrivingForward_Alignment ES_FRONT_BUMPED ES_ANY_PARAM */
+   { NULL, NULL, ES_ANY_PARAM, AligningRearBeacon, ES_NO_EVENT, 1 },
+   /* 14 Unloading ES_TIMEOUT MOTION_TIMER */
+   { NULL, NULL, MOTION_TIMER, Shuffling, ES_NO_EVENT, 0 },
+   /* 15 Unloading ES_TIMEOUT UNLOADING_DELAY_TIMER */
+   { NULL, BumpForward, UNLOADING_DELAY_TIMER, ES_SAME_STATE, ES_PASS_EVENT, 0 },
+   /* 16 Unloading ES_TIMEOUT UNLOADING_BUMP_TIMER */
+   { NULL, DriveBackward, UNLOADING_BUMP_TIMER, ES_SAME_STATE, ES_PASS_EVENT, 1 },
+   /* 17 Unloading ES_REAR_BUMPED ES_ANY_PARAM */
+   { NULL, StopToUnload, ES_ANY_PARAM, ES_SAME_STATE, ES_PASS_EVENT, 1 },
+   /* 18 Shuffling ES_TIMEOUT SHUFFLE_TIMER */
+   { NULL, NULL, SHUFFLE_TIMER, ES_SAME_STATE, ES_BALL_BIN_EMPTY, 0 },
+   /* 19 Shuffling ES_TIMEOUT SHUFFLE_STEP_TIMER */
+   { NULL, ShuffleStep, SHUFFLE_STEP_TIMER, ES_SAME_STATE, ES_PASS_EVENT, 1 },
+   /* 20 BisectingAngle ES_TIMEOUT MOTION_TIMER */
+   { NULL, StartBisectedAlignTimer, MOTION_TIMER, DrivingForward_Alignment, ES_NO_EVENT, 1 },
+   /* 21 FindingLeftBeacon ES_BEACON_FRONT ES_ANY_PARAM */
+   { IsLeftBin, NULL, ES_ANY_PARAM, FindingRightBeacon, ES_NO_EVENT, 1 },
+   /* 22 FindingRightBeacon ES_BEACON_FRONT ES_ANY_PARAM */
+   { IsRightBin, NULL, ES_ANY_PARAM, BisectingAngle, ES_NO_EVENT, 1 }
+};
+
+// for each state, 1 + the index of its first row for each event type
+static const uint8_t ScoringSM_Dispatch[10][14] = {
+   /* AligningFrontBeacon */
+   { 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 3, 0 },
+   /* AligningRearBeacon */
+   { 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 5 },
+   /* BackingUp */
+   { 0, 0, 0, 0, 6, 0, 0, 7, 8, 0, 9, 0, 0, 0 },
+   /* DrivingForward_Clearance */
+   { 0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+   /* DrivingForward_Alignment */
+   { 0, 0, 0, 0, 13, 0, 0, 0, 0, 14, 0, 0, 0, 0 },
+   /* Unloading */
+   { 0, 0, 0, 0, 15, 0, 0, 0, 0, 0, 18, 0, 0, 0 },
+   /* Shuffling */
+   { 0, 0, 0, 0, 19, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+   /* BisectingAngle */
+   { 0, 0, 0, 0, 21, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+   /* FindingLeftBeacon */
+   { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 22, 0 },
+   /* FindingRightBeacon */
+   { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0 }
+};
+
+// each state's entry and exit
+static const ES_StateTableState_t ScoringSM_States[10] = {
+   { EnterAligningFrontBeacon, ExitAligningFrontBeacon }, /* AligningFrontBeacon */
+   { EnterAligningRearBeacon, Stop }, /* AligningRearBeacon */
+   { DriveBackward, Stop }, /* BackingUp */
+   { EnterDrivingForward_Clearance, Stop }, /* DrivingForward_Clearance */
+   { DriveForward, Stop }, /* DrivingForward_Alignment */
+   { EnterUnloading, NULL }, /* Unloading */
+   { EnterShuffling, Stop }, /* Shuffling */
+   { EnterBisectingAngle, Stop }, /* BisectingAngle */
+   { SpinLeft, ExitFindingLeftBeacon }, /* FindingLeftBeacon */
+   { SpinRight, ExitFindingRightBeacon }  /* FindingRightBeacon */
+};
+
+static const ES_StateTable_t ScoringSM_Table = {
+   &ScoringSM_Dispatch[0][0], ScoringSM_Rows, ScoringSM_States, 14, LOG_SCORING
+};
@@ -4,10 +4,12 @@
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 14:20 adl  TERMIO_Init before the first output
  02/06/12 19:13 kfn  Changed for Lab8 use
 ****************************************************************************/
 // Includes ****************************************************************/
 #include <stdio.h>
+#include <termio.h>
 #include "ES_Configure.h"
 #include "ES_Framework.h"
 #include "ES_Timers.h"
@@ -20,6 +22,9 @@ void main( void)
     //Local variable: ES_Return_t ErrorType
     ES_Return_t ErrorType;
 
+    // Set up SCI0 and the console rings before anything is printed
+    TERMIO_Init();
+
     puts("\n\rStarting Team 16 HIPPOS State Machine.");
     puts("\n\rUsing E128 as well as ES framework logic.");
 
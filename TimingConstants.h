@@ -6,12 +6,25 @@ Description
  History
  When           Who	What/Why
  -------------- ---	--------
+ 10/18/26 10:05 adl	SIM_TUNE_HEADER, for the host simulator to sweep some of
+                        these
+ 10/17/26 22:35 adl	FINE_PER_TIMER_TICK
+ 10/17/26 21:50 adl	timers named by an enum and taken from the timer pool, so
+                        no 2 can share a number
  02/26/12 01:49 adl	First pass
 ****************************************************************************/
 
 #ifndef TIMINGCONSTANTS_H
 #define TIMINGCONSTANTS_H
 
+#include "ES_Timers.h"
+
+// A host build that tunes some of the values below at run time names its
+// header here, which defines them ahead of the #ifndefs
+#ifdef SIM_TUNE_HEADER
+#include SIM_TUNE_HEADER
+#endif
+
 // Define clock pulses in a second when using a 2MS timer rate
 #define _SECONDS_TIMER *488
 #define _HALF_SECONDS_TIMER *244
@@ -22,6 +35,10 @@ Description
 #define _MS_ *3000 // 3 clock ticks per us
 #define _SEC_ *3000000 // 3 clock ticks per us
 
+// ES_Timer_GetFineTime counts per 2.048 ms timer tick, to turn a fine time
+// into a time for ES_Timer_InitTimer
+#define FINE_PER_TIMER_TICK (2048UL _US_)
+
 // Times for turns
 #define DEGREE90_INTERVAL 300
 #define DEGREE30_INTERVAL (unsigned int)(DEGREE90_INTERVAL/3)
@@ -31,21 +48,42 @@ Description
 #define CAUTION_SPEED 75
 #define BEACON_SEARCH_TURN_SPEED 75
 
-// Defines for the different timers
+// The different timers. InitMasterMachine takes a timer from the pool for each
+// one (AppTimer[] holds the handles), and its timeout arrives at
+// MasterMachine as ES_TIMEOUT with the name below as the EventParam.
+// Start or restart one with ES_Timer_InitTimer(AppTimer[MOTION_TIMER], Time)
+typedef enum { END_GAME_TIMER,
+               GO_TO_SCORING_TIMER,
+               MOTION_TIMER,
+               SHUFFLE_TIMER,
+               SHUFFLE_STEP_TIMER,
+               GO_TO_BACKUP_SEARCH_TIMER,
+               BEACON_NOD_TIMER,
+               WALL_BUMP_TIMER,
+               UNLOADING_DELAY_TIMER,
+               UNLOADING_BUMP_TIMER,
+               ANTIJAM_TIMER,
+               NUM_APP_TIMERS } AppTimer_t;
+
+extern ES_TimerHandle_t AppTimer[NUM_APP_TIMERS];
+
 // End of game timer
-#define END_GAME_TIMER 0
 #define LENGTH_OF_GAME (120 _SECONDS_TIMER)
 
 // Go to scoring timer
-#define GO_TO_SCORING_TIMER 1
+#ifndef PROCEED_TO_SCORING
 #define PROCEED_TO_SCORING (75 _SECONDS_TIMER)
+#endif
 
 // Timer for different motions
-#define MOTION_TIMER 2
 // Gathering SM
+#ifndef CAUTIONSPEED_INTERVAL
 #define CAUTIONSPEED_INTERVAL (2 _SECONDS_TIMER) // how long to slow down for when tape seen
+#endif
 #define BACKUP_INTERVAL (1 _QUARTER_SECONDS_TIMER) // how long to backup for when bumper is hit
+#ifndef TURN_EVADE_INTERVAL
 #define TURN_EVADE_INTERVAL (DEGREE30_INTERVAL*2)
+#endif
 
 // Scoring SM
 #define FIRST_FWD_ALIGN_INTERVAL 3 _HALF_SECONDS_TIMER // for aligning the first pass with the opposite beacon
@@ -59,35 +97,27 @@ Description
 #define RESET_INTERVAL 7 _QUARTER_SECONDS_TIMER
 
 // Timer for how long to shuffle
-#define SHUFFLE_TIMER 3
 #define SHUFFLE_INTERVAL (5) _SECONDS_TIMER
 
 // Timer for each shuffle step
-#define SHUFFLE_STEP_TIMER 4
 #define SHUFFLE_STEP_INTERVAL 1 _QUARTER_SECONDS_TIMER
 // 122 ticks at 2.048mS is 0.25s
 
 // Timer for going to backup search method 
-#define GO_TO_BACKUP_SEARCH_TIMER 5
 #define GO_TO_BACKUP_SEARCH_INTERVAL 6*DEGREE90_INTERVAL
 
 // Timer for doing a "nod" while looking for the beacon
-#define BEACON_NOD_TIMER 6
 #define BEACON_NOD_INTERVAL 1 _QUARTER_SECONDS_TIMER // time to get off beacon before swinging the other way
 
 // Timer for pushing the wall in Gathering mode
-#define WALL_BUMP_TIMER 6
 #define WALL_BUMP_INTERVAL 50 // 100 ms
 
 // Timer for forward then back motion
-#define UNLOADING_DELAY_TIMER 5
 #define FAN_SPIN_DOWN_TIMER (1 _HALF_SECONDS_TIMER) // how long to wait after last approach and going forward for bumping
 
-#define UNLOADING_BUMP_TIMER 6
 #define FORWARD_BUMP_INTERVAL 4 _QUARTER_SECONDS_TIMER // how far to separate before ramming the wall backward
 
 // Timer for preventing jamming when backing into our target bin
-#define ANTIJAM_TIMER 7
 #define ANTIJAM_INTERVAL 8 _SECONDS_TIMER // How long to back up for until we try to go for a secondary bin
 
 // Turn direction for evasive maneuvers
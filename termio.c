@@ -1,36 +1,433 @@
+/****************************************************************************
+ Module
+     termio.c
+ Description
+     The console on SCI0, under printf and getchar. Characters to send go
+     into a transmit ring and characters received into a receive ring; the
+     SCI0 interrupt moves them, so neither side waits on the port a
+     character at a time.
+ Notes
+     TERMIO_Write takes what fits in the transmit ring and never waits.
+     TERMIO_PutChar, under printf, waits only while the ring is full. With
+     interrupts masked (before ES_Initialize turns them on, or inside a
+     critical region) the ISR cannot make room, so it sends the oldest byte
+     itself as soon as TDRE is set.
+
+     The transmit side of the ISR also sends the deferred log (ES_Log.c):
+     text goes out between log records, never inside one. While both have
+     bytes waiting they take turns, a record and then up to TERMIO_TEXT_TURN
+     characters, so neither can keep the other off the port. Whoever adds
+     bytes turns the transmit interrupt on (ES_Port_StartSCI0Tx), and the
+     ISR turns it off when there is nothing left in either.
+
+     Each key received goes into the receive ring, for kbhit and
+     TERMIO_GetChar. With KEY_RING defined it is instead posted from the
+     ISR as ES_NEW_KEY, so ES_Run does not poll for keys, and the receive
+     ring stays empty.
+
+     Each ring index is written from one side only (the transmit ring's
+     Head by the writers, Tail by the ISR; the other way round for the
+     receive ring), as for the ISR rings. On the host, Host/SCISim.c stands
+     in for SCI0 and runs the ISR from a thread.
+ History
+ When           Who     What/Why
+ -------------- ---     --------
+ 10/18/26 14:20 adl      TERMIO_PutChar polls with interrupts masked, keys
+                         through KEY_RING skip the receive ring
+ 10/18/26 02:15 adl      transmit and receive rings run by the SCI0 interrupt,
+                         TERMIO_Write, keys posted from the ISR, host build
+                         against Host/SCISim.c
+ 10/18/26 01:35 adl      printf between the records of the deferred log
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
 #include <termio.h>
+#ifndef ES_HOST_BUILD
 #include <mc9s12e128.h>     /* derivative information */
 #include <s12sci.h>
+#include "S12eVec.h"
+#else
+#include "SCISim.h"         /* SCI0 and a pty behind it */
+#endif
+#include "ES_Configure.h"
+#include "ES_Port.h"
+#include "ES_Events.h"
+#include "ES_ISRRing.h"
+#include "ES_Log.h"
+#include "Console.h"
 
-char TERMIO_GetChar(void) {
-  /* receives character from the terminal channel */
-    while (!(SCI0SR1 & _S12_RDRF))
-    {}; /* wait for input */
-    return SCI0DRL;
+/*----------------------------- Module Defines ----------------------------*/
+// ring sizes, powers of 2 no larger than 128
+#ifndef TERMIO_TX_SIZE
+#define TERMIO_TX_SIZE 64
+#endif
+#ifndef TERMIO_RX_SIZE
+#define TERMIO_RX_SIZE 16
+#endif
+#if (TERMIO_TX_SIZE > 128) || (TERMIO_TX_SIZE & (TERMIO_TX_SIZE-1)) || \
+    (TERMIO_RX_SIZE > 128) || (TERMIO_RX_SIZE & (TERMIO_RX_SIZE-1))
+#error TERMIO_TX_SIZE and TERMIO_RX_SIZE must be powers of 2, up to 128
+#endif
+#define TX_MASK (TERMIO_TX_SIZE-1)
+
+// characters of text sent between log records while both are waiting,
+// the same as a record for an even share of the port
+#ifndef TERMIO_TEXT_TURN
+#define TERMIO_TEXT_TURN ES_LOG_RECORD_SIZE
+#endif
+#define RX_MASK (TERMIO_RX_SIZE-1)
+
+// SCI0 itself; on the host SCISim runs the ISR when a byte is due
+#ifndef ES_HOST_BUILD
+#define SCI0_VECTOR interrupt _Vec_sci0
+#define TxIntOn()     ((SCI0CR2 & _S12_TIE) != 0)
+#define TxReady()     ((SCI0SR1 & _S12_TDRE) != 0)
+#define RxReady()     ((SCI0SR1 & _S12_RDRF) != 0)
+#define WriteTx(Byte) { SCI0DRL = (Byte); }
+#define ReadRx()      (SCI0DRL)
+#else
+#define SCI0_VECTOR
+#define TxIntOn()     (__atomic_load_n(&ES_Port_SCI0TxOn, __ATOMIC_SEQ_CST) != 0)
+#define TxReady()     SCISim_TxReady()
+#define RxReady()     SCISim_RxReady()
+#define WriteTx(Byte) SCISim_Write(Byte)
+#define ReadRx()      SCISim_Read()
+#endif
+
+/*---------------------------- Module Functions ---------------------------*/
+static boolean NextTxByte( uint8_t *pByte );
+static boolean NextTextByte( uint8_t *pByte );
+static void TakeRxByte( uint8_t Byte );
+static void SendPolled( void );
+
+/*---------------------------- Module Variables ---------------------------*/
+static char TxRing[TERMIO_TX_SIZE];
+static volatile uint8_t TxHead;   // next to fill, written by the writers
+static volatile uint8_t TxTail;   // next to send, written by the ISR
+static uint8_t TextTurn;          // text still to send before the log's turn
+
+static char RxRing[TERMIO_RX_SIZE];
+static volatile uint8_t RxHead;   // next to fill, written by the ISR
+static volatile uint8_t RxTail;   // next to read, written by the readers
+static uint16_t RxDrops;          // keys lost to a full receive ring
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   TERMIO_Init
+ Parameters
+   None
+ Returns
+   None
+ Description
+   empties the rings, sets the baud rate to 115.2 kbaud and turns on the
+   transmitter, the receiver and the receive interrupt
+ Notes
+   the transmit interrupt stays off until there is something to send
+ Author
+   Alex Loo, 10/18/26, 02:20
+****************************************************************************/
+void TERMIO_Init(void) {
+    TxHead = TxTail = 0;
+    TextTurn = 0;
+    RxHead = RxTail = 0;
+    RxDrops = 0;
+#ifndef ES_HOST_BUILD
+    SCI0BD = 13;
+    SCI0CR2 = (_S12_TE | _S12_RE | _S12_RIE);
+#endif
+}
+
+/****************************************************************************
+ Function
+   TERMIO_Write
+ Parameters
+   const char * pData : the characters to send
+   uint8_t Length : how many
+ Returns
+   uint8_t : how many fitted in the transmit ring, from the front of pData
+ Description
+   queues characters to send without waiting
+ Notes
+   not for use from an ISR
+ Author
+   Alex Loo, 10/18/26, 02:22
+****************************************************************************/
+uint8_t TERMIO_Write(const char *pData, uint8_t Length) {
+    uint8_t Head = TxHead; // only the writers write Head
+    uint8_t Room = (uint8_t)(TERMIO_TX_SIZE -
+                             (uint8_t)(Head - ES_Port_LoadAcquire(TxTail)));
+    uint8_t i;
+
+    if (Length > Room)
+        Length = Room;
+    if (Length == 0)
+        return 0;
+    for (i = 0; i < Length; i++)
+        TxRing[(uint8_t)(Head + i) & TX_MASK] = pData[i];
+    // the characters must be in place before the ISR can see the new Head
+    ES_Port_StoreRelease(TxHead, (uint8_t)(Head + Length));
+    ES_Port_StartSCI0Tx();
+    return Length;
 }
 
+/****************************************************************************
+ Function
+   TERMIO_TxRoom
+ Parameters
+   None
+ Returns
+   uint8_t : how many characters TERMIO_Write would take now
+ Description
+   lets a writer send a whole line or nothing
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 02:24
+****************************************************************************/
+uint8_t TERMIO_TxRoom(void) {
+    return (uint8_t)(TERMIO_TX_SIZE -
+                     (uint8_t)(TxHead - ES_Port_LoadAcquire(TxTail)));
+}
+
+/****************************************************************************
+ Function
+   TERMIO_PutChar
+ Parameters
+   char ch : the character to send
+ Returns
+   None
+ Description
+   queues a character to send, for printf
+ Notes
+   waits only while the transmit ring is full. With interrupts masked the
+   ISR cannot empty it, so we send a byte by polling instead
+ Author
+   Alex Loo, 10/18/26, 02:25
+****************************************************************************/
 void TERMIO_PutChar(char ch) {
-  /* sends a character to the terminal channel */
-    while (!(SCI0SR1 & _S12_TDRE))
-    {};  /* wait for output buffer empty */
-    SCI0DRL = ch;
+    uint8_t CCR;
+
+    while (TERMIO_Write(&ch, 1) == 0) { /* wait for room */
+        ES_Port_ReadCCR(CCR);
+        if ((CCR & ES_PORT_CCR_I) != 0)
+            SendPolled();
+    }
 }
 
-void TERMIO_Init(void) {
-  /* initializes the communication channel */
-/* set baud rate to 115.2 kbaud and turn on Rx and Tx */
+/****************************************************************************
+ Function
+   TERMIO_GetChar
+ Parameters
+   None
+ Returns
+   char : the oldest character received
+ Description
+   takes a character from the receive ring, for getchar
+ Notes
+   waits for one if the ring is empty
+ Author
+   Alex Loo, 10/18/26, 02:26
+****************************************************************************/
+char TERMIO_GetChar(void) {
+    uint8_t Tail = RxTail; // only the readers write Tail
+    char ch;
 
-        SCI0BD = 13;
-        SCI0CR2 = (_S12_TE | _S12_RE);
+    while (Tail == ES_Port_LoadAcquire(RxHead))
+    {}; /* wait for input */
+    ch = RxRing[Tail & RX_MASK];
+    ES_Port_StoreRelease(RxTail, (uint8_t)(Tail + 1));
+    return ch;
 }
 
+/****************************************************************************
+ Function
+   kbhit
+ Parameters
+   None
+ Returns
+   int : 1 if a character is waiting in the receive ring
+ Description
+   checks for a character from the terminal channel
+ Notes
+
+ Author
+   Alex Loo, 10/18/26, 02:27
+****************************************************************************/
 int kbhit(void) {
-  /* checks for a character from the terminal channel */
-    if (SCI0SR1 & _S12_RDRF)
-            return 1;
+    if (RxTail != ES_Port_LoadAcquire(RxHead))
+        return 1;
     else
-            return 0;
+        return 0;
+}
+
+/****************************************************************************
+ Function
+   TERMIO_QueryRxDrops
+ Parameters
+   None
+ Returns
+   uint16_t : keys lost because nobody read the receive ring
+ Description
+   for sizing TERMIO_RX_SIZE
+ Notes
+   always 0 with KEY_RING, where keys do not go into the receive ring;
+   the key ring counts its own drops
+ Author
+   Alex Loo, 10/18/26, 02:28
+****************************************************************************/
+uint16_t TERMIO_QueryRxDrops(void) {
+    return RxDrops;
+}
+
+/****************************************************************************
+ Function
+   TERMIO_SCI0ISR
+ Parameters
+   None
+ Returns
+   None
+ Description
+   takes in a received character, and sends the next character or log
+   byte when the transmit data register is empty
+ Notes
+   turns the transmit interrupt off when there is nothing to send. It then
+   looks once more: on the S12 nothing can have been added in between, but
+   on the host a writer thread may have, and turned the interrupt on just
+   before we turned it off
+ Author
+   Alex Loo, 10/18/26, 02:30
+****************************************************************************/
+void SCI0_VECTOR TERMIO_SCI0ISR(void) {
+    uint8_t Byte;
+
+    if (RxReady()) {
+        Byte = ReadRx(); /* reading the data clears RDRF */
+        TakeRxByte(Byte);
+    }
+    if (TxIntOn() && TxReady()) {
+        if (NextTxByte(&Byte) == False) {
+            ES_Port_StopSCI0Tx();
+            if (NextTxByte(&Byte) == False)
+                return;
+            ES_Port_StartSCI0Tx();
+        }
+        WriteTx(Byte);
+    }
+}
 
+//*********************************
+// private functions
+//*********************************
+/****************************************************************************
+ Function
+   NextTxByte
+ Parameters
+   uint8_t * pByte : where to put the byte
+ Returns
+   boolean : False if there is nothing to send
+ Description
+   picks the next byte to send: the rest of a log record that has started,
+   otherwise a new record when it is the log's turn, otherwise text, and
+   whichever has something when the other has nothing
+ Notes
+   called from the ISR, or with interrupts masked from SendPolled
+ Author
+   Alex Loo, 10/18/26, 02:33
+****************************************************************************/
+static boolean NextTxByte(uint8_t *pByte) {
+    if (ES_Log_InRecord() == True)
+        return ES_Log_NextByte(pByte);
+    if ((TextTurn == 0) && (ES_Log_NextByte(pByte) == True)) {
+        TextTurn = TERMIO_TEXT_TURN;
+        return True;
+    }
+    if (NextTextByte(pByte) == True) {
+        if (TextTurn != 0)
+            TextTurn--;
+        return True;
+    }
+    return ES_Log_NextByte(pByte);
 }
 
+/****************************************************************************
+ Function
+   NextTextByte
+ Parameters
+   uint8_t * pByte : where to put the character
+ Returns
+   boolean : False if the transmit ring is empty
+ Description
+   takes the oldest character from the transmit ring
+ Notes
+   called through NextTxByte only
+ Author
+   Alex Loo, 10/18/26, 02:34
+****************************************************************************/
+static boolean NextTextByte(uint8_t *pByte) {
+    uint8_t Tail = TxTail; // only the ISR writes Tail
+
+    if (Tail == ES_Port_LoadAcquire(TxHead))
+        return False;
+    *pByte = (uint8_t)TxRing[Tail & TX_MASK];
+    // the character must be read out before a writer can see it freed
+    ES_Port_StoreRelease(TxTail, (uint8_t)(Tail + 1));
+    return True;
+}
+
+/****************************************************************************
+ Function
+   TakeRxByte
+ Parameters
+   uint8_t Byte : the character received
+ Returns
+   None
+ Description
+   with KEY_RING, posts the character as ES_NEW_KEY, otherwise puts it in
+   the receive ring
+ Notes
+   called from the ISR only
+ Author
+   Alex Loo, 10/18/26, 02:35
+****************************************************************************/
+static void TakeRxByte(uint8_t Byte) {
+#ifdef KEY_RING
+    ES_Event ThisEvent;
+
+    ThisEvent.EventType = ES_NEW_KEY;
+    ThisEvent.EventParam = Byte;
+    ES_ISRRing_Post(KEY_RING, ThisEvent);
+#else
+    uint8_t Head = RxHead; // only the ISR writes Head
 
+    if ((uint8_t)(Head - ES_Port_LoadAcquire(RxTail)) >= TERMIO_RX_SIZE) {
+        RxDrops++;
+        return;
+    }
+    RxRing[Head & RX_MASK] = (char)Byte;
+    ES_Port_StoreRelease(RxHead, (uint8_t)(Head + 1));
+#endif
+}
+
+/****************************************************************************
+ Function
+   SendPolled
+ Parameters
+   None
+ Returns
+   None
+ Description
+   waits for TDRE and sends the next byte, in place of the ISR
+ Notes
+   only with interrupts masked, when the ISR cannot run
+ Author
+   Alex Loo, 10/18/26, 14:20
+****************************************************************************/
+static void SendPolled(void) {
+    uint8_t Byte;
+
+    while (!TxReady())
+    {}; /* wait for the port */
+    if (NextTxByte(&Byte) == True)
+        WriteTx(Byte);
+}
+/*------------------------------ End of file ------------------------------*/